@@ -0,0 +1,448 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// bmqbench.m.cpp                                                     -*-C++-*-
+
+// bmqbench
+#include <m_bmqbench_broker.h>
+#include <m_bmqbench_runner.h>
+
+// BMQ
+#include <bmqt_uri.h>
+
+// MWC
+#include <mwcu_memoutstream.h>
+#include <mwcu_printutil.h>
+#include <mwcu_tempdirectory.h>
+
+// BDE
+#include <balcl_commandline.h>
+#include <ball_loggermanager.h>
+#include <ball_loggermanagerconfiguration.h>
+#include <ball_severity.h>
+#include <ball_streamobserver.h>
+#include <bdlt_currenttime.h>
+#include <bdlt_datetime.h>
+#include <bsl_fstream.h>
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+#include <bslma_default.h>
+#include <bslma_managedptr.h>
+#include <bsls_timeutil.h>
+#include <bsls_types.h>
+
+// SYSTEM
+#if defined(BSLS_PLATFORM_OS_UNIX)
+#include <signal.h>
+#endif
+
+using namespace BloombergLP;
+using namespace m_bmqbench;
+
+namespace {
+
+// ================
+// struct Arguments
+// ================
+
+/// Command line arguments of the benchmark.
+struct Arguments {
+    // PUBLIC DATA
+    bsl::string              d_broker;
+    int                      d_port;
+    bsl::string              d_workDir;
+    bsl::vector<bsl::string> d_storages;
+    bsl::vector<int>         d_messageSizes;
+    bsl::vector<int>         d_batchSizes;
+    bsl::vector<int>         d_fanouts;
+    int                      d_numProducers;
+    bsls::Types::Int64       d_numMessages;
+    int                      d_window;
+    int                      d_timeoutSeconds;
+    bsl::string              d_output;
+};
+
+/// Scenario and result of one run of the benchmark.
+struct Run {
+    // PUBLIC DATA
+    Scenario       d_scenario;
+    ScenarioResult d_result;
+};
+
+// FUNCTIONS
+
+/// On UNIX only, ignore the SIGPIPE signal.
+void ignoreSigpipe()
+{
+#ifdef BSLS_PLATFORM_OS_UNIX
+    struct sigaction sa;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags   = 0;
+    sa.sa_handler = SIG_IGN;
+    if (0 != sigaction(SIGPIPE, &sa, NULL)) {
+        bsl::cerr << "Failed to ignore SIGPIPE!"
+                  << "\n";
+    }
+#endif
+}
+
+/// Load into the specified `arguments` the command line arguments in the
+/// specified `argv` of the specified `argc` size, and the scenarios they
+/// describe into the specified `scenarios`.  Return true on success, or
+/// false if the arguments are invalid or the help was requested.
+bool parseArgs(Arguments*             arguments,
+               bsl::vector<Scenario>* scenarios,
+               int                    argc,
+               const char*            argv[])
+{
+    arguments->d_port           = 30200;
+    arguments->d_numProducers   = 1;
+    arguments->d_numMessages    = 100000;
+    arguments->d_window         = 10000;
+    arguments->d_timeoutSeconds = 120;
+    arguments->d_output         = "bmqbench.json";
+
+    bool showHelp = false;
+
+    balcl::OptionInfo specTable[] = {
+        {"b|broker",
+         "uri",
+         "URI of an already running broker to benchmark, instead of starting "
+         "one in the process (it must define the benchmark domains)",
+         balcl::TypeInfo(&arguments->d_broker),
+         balcl::OccurrenceInfo::e_OPTIONAL},
+        {"p|port",
+         "port",
+         "port of the broker started in the process",
+         balcl::TypeInfo(&arguments->d_port),
+         balcl::OccurrenceInfo(arguments->d_port)},
+        {"w|workdir",
+         "dir",
+         "directory of the configuration and the storage of the broker "
+         "started in the process (a temporary directory if not specified)",
+         balcl::TypeInfo(&arguments->d_workDir),
+         balcl::OccurrenceInfo::e_OPTIONAL},
+        {"s|storage",
+         "storage",
+         "storage of the domains to benchmark ([inMemory, fileBacked]), may "
+         "be repeated (default: both)",
+         balcl::TypeInfo(&arguments->d_storages),
+         balcl::OccurrenceInfo::e_OPTIONAL},
+        {"m|msgsize",
+         "size",
+         "payload size, in bytes, of the messages, may be repeated (default: "
+         "64, 1024 and 65536)",
+         balcl::TypeInfo(&arguments->d_messageSizes),
+         balcl::OccurrenceInfo::e_OPTIONAL},
+        {"e|batchsize",
+         "size",
+         "number of messages per posted event, may be repeated (default: 1 "
+         "and 32)",
+         balcl::TypeInfo(&arguments->d_batchSizes),
+         balcl::OccurrenceInfo::e_OPTIONAL},
+        {"f|fanout",
+         "fanout",
+         "number of consumers, each with its own app id, may be repeated "
+         "(default: 1 and 3)",
+         balcl::TypeInfo(&arguments->d_fanouts),
+         balcl::OccurrenceInfo::e_OPTIONAL},
+        {"producers",
+         "count",
+         "number of producers",
+         balcl::TypeInfo(&arguments->d_numProducers),
+         balcl::OccurrenceInfo(arguments->d_numProducers)},
+        {"n|messages",
+         "count",
+         "number of messages posted by each scenario",
+         balcl::TypeInfo(&arguments->d_numMessages),
+         balcl::OccurrenceInfo(arguments->d_numMessages)},
+        {"window",
+         "count",
+         "maximum number of messages posted but not yet received",
+         balcl::TypeInfo(&arguments->d_window),
+         balcl::OccurrenceInfo(arguments->d_window)},
+        {"timeout",
+         "seconds",
+         "maximum duration of each scenario",
+         balcl::TypeInfo(&arguments->d_timeoutSeconds),
+         balcl::OccurrenceInfo(arguments->d_timeoutSeconds)},
+        {"o|output",
+         "report.json",
+         "where to generate the JSON report",
+         balcl::TypeInfo(&arguments->d_output),
+         balcl::OccurrenceInfo(arguments->d_output)},
+        {"h|help",
+         "help",
+         "show the help message",
+         balcl::TypeInfo(&showHelp),
+         balcl::OccurrenceInfo::e_OPTIONAL}};
+
+    balcl::CommandLine commandLine(specTable);
+    if (commandLine.parse(argc, argv) != 0 || showHelp) {
+        commandLine.printUsage();
+        return false;  // RETURN
+    }
+
+    if (arguments->d_storages.empty()) {
+        arguments->d_storages.push_back(
+            StorageMode::toAscii(StorageMode::e_IN_MEMORY));
+        arguments->d_storages.push_back(
+            StorageMode::toAscii(StorageMode::e_FILE_BACKED));
+    }
+    if (arguments->d_messageSizes.empty()) {
+        arguments->d_messageSizes.push_back(64);
+        arguments->d_messageSizes.push_back(1024);
+        arguments->d_messageSizes.push_back(65536);
+    }
+    if (arguments->d_batchSizes.empty()) {
+        arguments->d_batchSizes.push_back(1);
+        arguments->d_batchSizes.push_back(32);
+    }
+    if (arguments->d_fanouts.empty()) {
+        arguments->d_fanouts.push_back(1);
+        arguments->d_fanouts.push_back(3);
+    }
+
+    // Validation
+    const int k_MIN_MESSAGE_SIZE = sizeof(bsls::Types::Int64);
+
+    bool isValid = arguments->d_numProducers > 0 &&
+                   arguments->d_numMessages > 0 && arguments->d_window > 0 &&
+                   arguments->d_timeoutSeconds > 0;
+    for (size_t i = 0; i < arguments->d_messageSizes.size(); ++i) {
+        isValid = isValid &&
+                  arguments->d_messageSizes[i] >= k_MIN_MESSAGE_SIZE;
+    }
+    for (size_t i = 0; i < arguments->d_batchSizes.size(); ++i) {
+        isValid = isValid && arguments->d_batchSizes[i] > 0;
+    }
+    for (size_t i = 0; i < arguments->d_fanouts.size(); ++i) {
+        isValid = isValid && arguments->d_fanouts[i] > 0;
+    }
+    if (!isValid) {
+        bsl::cerr << "Invalid arguments: the counts must be positive, and the "
+                  << "message sizes at least " << k_MIN_MESSAGE_SIZE
+                  << " bytes\n";
+        return false;  // RETURN
+    }
+
+    // Scenarios
+    for (size_t s = 0; s < arguments->d_storages.size(); ++s) {
+        Scenario scenario;
+        if (!StorageMode::fromAscii(&scenario.d_storage,
+                                    arguments->d_storages[s])) {
+            bsl::cerr << "Invalid storage: '" << arguments->d_storages[s]
+                      << "'\n";
+            return false;  // RETURN
+        }
+
+        scenario.d_numProducers = arguments->d_numProducers;
+        scenario.d_numMessages  = arguments->d_numMessages;
+        scenario.d_window       = arguments->d_window;
+
+        for (size_t f = 0; f < arguments->d_fanouts.size(); ++f) {
+            scenario.d_fanout = arguments->d_fanouts[f];
+            for (size_t m = 0; m < arguments->d_messageSizes.size(); ++m) {
+                scenario.d_messageSize = arguments->d_messageSizes[m];
+                for (size_t b = 0; b < arguments->d_batchSizes.size(); ++b) {
+                    scenario.d_batchSize = arguments->d_batchSizes[b];
+                    scenarios->push_back(scenario);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/// Print to the specified `stream` a summary of the specified `run`.
+void printRun(bsl::ostream& stream, const Run& run)
+{
+    const Scenario&       scenario = run.d_scenario;
+    const ScenarioResult& result   = run.d_result;
+
+    stream << "["
+           << Broker::domainName(scenario.d_storage, scenario.d_fanout)
+           << ", msgSize: " << scenario.d_messageSize
+           << ", batchSize: " << scenario.d_batchSize << "] "
+           << mwcu::PrintUtil::prettyNumber(
+                  static_cast<bsls::Types::Int64>(result.d_messagesPerSecond))
+           << " msgs/s, "
+           << mwcu::PrintUtil::prettyBytes(
+                  static_cast<bsls::Types::Int64>(result.d_bytesPerSecond))
+           << "/s, latency p50: "
+           << mwcu::PrintUtil::prettyTimeInterval(result.d_latencyP50Ns)
+           << ", p99: "
+           << mwcu::PrintUtil::prettyTimeInterval(result.d_latencyP99Ns)
+           << ", p99.9: "
+           << mwcu::PrintUtil::prettyTimeInterval(result.d_latencyP999Ns)
+           << ", max: "
+           << mwcu::PrintUtil::prettyTimeInterval(result.d_latencyMaxNs)
+           << (result.d_timedOut ? " (TIMED OUT)" : "") << "\n";
+}
+
+/// Write to the specified `stream` the JSON report of the specified `runs`
+/// against the broker at the specified `brokerUri`, started in the process
+/// if the specified `isInProcess` is true.
+void printReport(bsl::ostream&           stream,
+                 const bsl::string&      brokerUri,
+                 bool                    isInProcess,
+                 const bsl::vector<Run>& runs)
+{
+    stream << "{\n"
+           << "  \"broker\": \"" << brokerUri << "\",\n"
+           << "  \"inProcess\": " << (isInProcess ? "true" : "false")
+           << ",\n"
+           << "  \"timestamp\": \"" << bdlt::CurrentTime::utc() << "\",\n"
+           << "  \"results\": [";
+
+    for (size_t i = 0; i < runs.size(); ++i) {
+        const Scenario&       scenario = runs[i].d_scenario;
+        const ScenarioResult& result   = runs[i].d_result;
+
+        stream << (i == 0 ? "\n" : ",\n") << "    {\n"
+               << "      \"storage\": \""
+               << StorageMode::toAscii(scenario.d_storage) << "\",\n"
+               << "      \"domain\": \""
+               << Broker::domainName(scenario.d_storage, scenario.d_fanout)
+               << "\",\n"
+               << "      \"messageSize\": " << scenario.d_messageSize
+               << ",\n"
+               << "      \"batchSize\": " << scenario.d_batchSize << ",\n"
+               << "      \"fanout\": " << scenario.d_fanout << ",\n"
+               << "      \"producers\": " << scenario.d_numProducers
+               << ",\n"
+               << "      \"window\": " << scenario.d_window << ",\n"
+               << "      \"posted\": " << result.d_numPosted << ",\n"
+               << "      \"received\": " << result.d_numReceived << ",\n"
+               << "      \"durationNs\": " << result.d_durationNs << ",\n"
+               << "      \"messagesPerSecond\": "
+               << static_cast<bsls::Types::Int64>(result.d_messagesPerSecond)
+               << ",\n"
+               << "      \"bytesPerSecond\": "
+               << static_cast<bsls::Types::Int64>(result.d_bytesPerSecond)
+               << ",\n"
+               << "      \"latencyNs\": {\n"
+               << "        \"p50\": " << result.d_latencyP50Ns << ",\n"
+               << "        \"p99\": " << result.d_latencyP99Ns << ",\n"
+               << "        \"p999\": " << result.d_latencyP999Ns << ",\n"
+               << "        \"max\": " << result.d_latencyMaxNs << "\n"
+               << "      },\n"
+               << "      \"timedOut\": "
+               << (result.d_timedOut ? "true" : "false") << "\n"
+               << "    }";
+    }
+
+    stream << "\n  ]\n"
+           << "}\n";
+}
+
+}  // close unnamed namespace
+
+// ====
+// main
+// ====
+
+int main(int argc, const char* argv[])
+{
+    ignoreSigpipe();
+
+    // Make TimeUtil thread-safe by calling initialize
+    bsls::TimeUtil::initialize();
+
+    // Prepare the UriParser regexp
+    bmqt::UriParser::initialize();
+
+    bslma::Allocator* allocator = bslma::Default::allocator();
+
+    Arguments             arguments;
+    bsl::vector<Scenario> scenarios(allocator);
+    if (!parseArgs(&arguments, &scenarios, argc, argv)) {
+        return 1;  // RETURN
+    }
+
+    // Only warnings and errors are logged, to keep the benchmark quiet.
+    ball::StreamObserver             observer(&bsl::cout);
+    ball::LoggerManagerConfiguration configuration;
+    configuration.setDefaultThresholdLevelsIfValid(ball::Severity::e_WARN);
+    ball::LoggerManagerScopedGuard guard(&observer, configuration);
+
+    mwcu::TempDirectory       tempDirectory(allocator);
+    bslma::ManagedPtr<Broker> broker;
+    bsl::string               brokerUri(arguments.d_broker, allocator);
+    const bool                isInProcess = brokerUri.empty();
+    if (isInProcess) {
+        const bsl::string& workDir = arguments.d_workDir.empty()
+                                         ? tempDirectory.path()
+                                         : arguments.d_workDir;
+
+        broker.load(new (*allocator) Broker(workDir,
+                                            arguments.d_port,
+                                            arguments.d_fanouts,
+                                            allocator),
+                    allocator);
+
+        mwcu::MemOutStream error(allocator);
+        if (broker->start(error) != 0) {
+            bsl::cerr << error.str() << "\n";
+            return 2;  // RETURN
+        }
+
+        brokerUri = broker->uri();
+    }
+
+    bsl::cout << "Running " << scenarios.size() << " scenarios against "
+              << brokerUri << (isInProcess ? " (in process)" : "") << "\n";
+
+    Runner           runner(brokerUri, allocator);
+    bsl::vector<Run> runs(allocator);
+    int              rc = 0;
+    for (size_t i = 0; i < scenarios.size(); ++i) {
+        Run run;
+        run.d_scenario = scenarios[i];
+
+        mwcu::MemOutStream error(allocator);
+        if (runner.run(&run.d_result,
+                       error,
+                       run.d_scenario,
+                       arguments.d_timeoutSeconds) != 0) {
+            bsl::cerr << "Scenario " << i << " failed: " << error.str()
+                      << "\n";
+            rc = 3;
+            break;  // BREAK
+        }
+
+        printRun(bsl::cout, run);
+        runs.push_back(run);
+    }
+
+    if (broker) {
+        broker->stop();
+    }
+
+    bsl::ofstream output(arguments.d_output.c_str());
+    if (!output) {
+        bsl::cerr << "Unable to generate the report, failed to open '"
+                  << arguments.d_output << "'\n";
+        return 4;  // RETURN
+    }
+    printReport(output, brokerUri, isInProcess, runs);
+    output.close();
+
+    bsl::cout << "Report generated at: " << arguments.d_output << "\n";
+
+    return rc;
+}
@@ -0,0 +1,536 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// m_bmqbench_broker.cpp                                              -*-C++-*-
+#include <m_bmqbench_broker.h>
+
+// MQB
+#include <mqbcfg_brokerconfig.h>
+
+// MWC
+#include <mwcu_memoutstream.h>
+
+// BDE
+#include <baljsn_decoder.h>
+#include <baljsn_decoderoptions.h>
+#include <bdlsb_fixedmeminstreambuf.h>
+#include <bdls_filesystemutil.h>
+#include <bdls_pathutil.h>
+#include <bsl_fstream.h>
+#include <bsl_ostream.h>
+#include <bsls_assert.h>
+#include <bsls_systemclocktype.h>
+
+namespace BloombergLP {
+namespace m_bmqbench {
+
+namespace {
+
+// CONSTANTS
+
+/// Name of the cluster of the broker.
+const char k_CLUSTER_NAME[] = "bench";
+
+/// Limit, in bytes and in messages, of the benchmark domains and queues.
+const bsls::Types::Int64 k_LIMIT_BYTES    = 64LL * 1024 * 1024 * 1024;
+const bsls::Types::Int64 k_LIMIT_MESSAGES = 100 * 1000 * 1000;
+
+// FUNCTIONS
+
+/// Write the specified `content` to the file at the specified `path`.
+/// Return 0 on success, or a non-zero value and populate the specified
+/// `errorDescription` otherwise.
+int writeFile(bsl::ostream&            errorDescription,
+              const bsl::string&       path,
+              const bslstl::StringRef& content)
+{
+    bsl::ofstream file(path.c_str());
+    file.write(content.data(), content.length());
+    file.close();
+
+    if (!file) {
+        errorDescription << "failed to write '" << path << "'";
+        return -1;  // RETURN
+    }
+
+    return 0;
+}
+
+/// Write to the specified `os` the configuration of the broker listening on
+/// the specified `port` and keeping its logs below the specified `workDir`.
+void printBrokerConfig(bsl::ostream&      os,
+                       int                port,
+                       const bsl::string& workDir)
+{
+    os << "{\n"
+          "    \"brokerInstanceName\": \"bench\",\n"
+          "    \"brokerVersion\": 999999,\n"
+          "    \"configVersion\": 999999,\n"
+          "    \"etcDir\": \"\",\n"
+          "    \"hostName\": \"localhost\",\n"
+          "    \"hostTags\": \"standalone\",\n"
+          "    \"hostDataCenter\": \"UNSPECIFIED\",\n"
+          "    \"isRunningOnDev\": false,\n"
+          "    \"logsObserverMaxSize\": 1000,\n"
+          "    \"dispatcherConfig\": {\n";
+
+    const char* k_DISPATCHER_TYPES[]      = {"sessions", "queues", "clusters"};
+    const int   k_DISPATCHER_PROCESSORS[] = {4, 8, 4};
+    for (int i = 0; i < 3; ++i) {
+        os << "        \"" << k_DISPATCHER_TYPES[i] << "\": {\n"
+           << "            \"numProcessors\": " << k_DISPATCHER_PROCESSORS[i]
+           << ",\n"
+           << "            \"processorConfig\": {\n"
+           << "                \"queueSizeLowWatermark\": 100000,\n"
+           << "                \"queueSizeHighWatermark\": 200000,\n"
+           << "                \"queueSize\": 500000\n"
+           << "            }\n"
+           << "        }" << (i < 2 ? ",\n" : "\n");
+    }
+
+    os << "    },\n"
+          "    \"stats\": {\n"
+          "        \"snapshotInterval\": 1,\n"
+          "        \"printer\": {\n"
+          "            \"printInterval\": 60,\n"
+          "            \"file\": \""
+       << workDir
+       << "/logs/stat.%T.%p\",\n"
+          "            \"maxAgeDays\": 1,\n"
+          "            \"rotateBytes\": 268435456,\n"
+          "            \"rotateDays\": 1\n"
+          "        }\n"
+          "    },\n"
+          "    \"networkInterfaces\": {\n"
+          "        \"heartbeats\": {\n"
+          "            \"client\": 0,\n"
+          "            \"downstreamBroker\": 10,\n"
+          "            \"upstreamBroker\": 10,\n"
+          "            \"clusterPeer\": 10\n"
+          "        },\n"
+          "        \"tcpInterface\": {\n"
+          "            \"name\": \"TCPInterface\",\n"
+          "            \"port\": "
+       << port
+       << ",\n"
+          "            \"ioThreads\": 4,\n"
+          "            \"maxConnections\": 10000,\n"
+          "            \"lowWatermark\": 4194304,\n"
+          "            \"highWatermark\": 1073741824,\n"
+          "            \"nodeLowWatermark\": 5242880,\n"
+          "            \"nodeHighWatermark\": 10485760,\n"
+          "            \"heartbeatIntervalMs\": 3000,\n"
+          "            \"useNtf\": false\n"
+          "        }\n"
+          "    },\n"
+          "    \"bmqconfConfig\": {\n"
+          "        \"cacheTTLSeconds\": 30\n"
+          "    }\n"
+          "}\n";
+}
+
+/// Write to the specified `os` the configuration of the single node cluster
+/// of the broker listening on the specified `port` and keeping its storage
+/// below the specified `workDir`.
+void printClustersConfig(bsl::ostream&      os,
+                         int                port,
+                         const bsl::string& workDir)
+{
+    os << "{\n"
+          "    \"myClusters\": [\n"
+          "        {\n"
+          "            \"name\": \""
+       << k_CLUSTER_NAME
+       << "\",\n"
+          "            \"clusterAttributes\": {\n"
+          "                \"isCSLModeEnabled\": true,\n"
+          "                \"isFSMWorkflow\": false\n"
+          "            },\n"
+          "            \"nodes\": [\n"
+          "                {\n"
+          "                    \"id\": 0,\n"
+          "                    \"dataCenter\": \"UNSPECIFIED\",\n"
+          "                    \"name\": \"localhost\",\n"
+          "                    \"transport\": {\n"
+          "                        \"tcp\": {\n"
+          "                            \"endpoint\": \"tcp://localhost:"
+       << port
+       << "\"\n"
+          "                        }\n"
+          "                    }\n"
+          "                }\n"
+          "            ],\n"
+          "            \"partitionConfig\": {\n"
+          "                \"name\": \""
+       << k_CLUSTER_NAME
+       << "\",\n"
+          "                \"flushAtShutdown\": true,\n"
+          "                \"location\": \""
+       << workDir
+       << "/storage\",\n"
+          "                \"maxArchivedFileSets\": 0,\n"
+          "                \"maxDataFileSize\": 4294967296,\n"
+          "                \"maxJournalFileSize\": 536870912,\n"
+          "                \"maxQlistFileSize\": 67108864,\n"
+          "                \"numPartitions\": 4,\n"
+          "                \"preallocate\": false,\n"
+          "                \"prefaultPages\": false,\n"
+          "                \"archiveLocation\": \""
+       << workDir
+       << "/storage/archive\",\n"
+          "                \"syncConfig\": {\n"
+          "                    \"fileChunkSize\": 0,\n"
+          "                    \"masterSyncMaxDurationMs\": 0,\n"
+          "                    \"maxAttemptsStorageSync\": 0,\n"
+          "                    \"partitionSyncDataReqTimeoutMs\": 0,\n"
+          "                    \"partitionSyncEventSize\": 0,\n"
+          "                    \"partitionSyncStateReqTimeoutMs\": 0,\n"
+          "                    \"startupRecoveryMaxDurationMs\": 0,\n"
+          "                    \"startupWaitDurationMs\": 0,\n"
+          "                    \"storageSyncReqTimeoutMs\": 0\n"
+          "                }\n"
+          "            },\n"
+          "            \"masterAssignment\": \"E_LEADER_IS_MASTER_ALL\",\n"
+          "            \"elector\": {\n"
+          "                \"electionResultTimeoutMs\": 4000,\n"
+          "                \"heartbeatBroadcastPeriodMs\": 2000,\n"
+          "                \"heartbeatCheckPeriodMs\": 1000,\n"
+          "                \"heartbeatMissCount\": 10,\n"
+          "                \"initialWaitTimeoutMs\": 8000,\n"
+          "                \"leaderSyncDelayMs\": 80000,\n"
+          "                \"maxRandomWaitTimeoutMs\": 3000,\n"
+          "                \"quorum\": 0\n"
+          "            },\n"
+          "            \"queueOperations\": {\n"
+          "                \"ackWindowSize\": 500,\n"
+          "                \"assignmentTimeoutMs\": 15000,\n"
+          "                \"closeTimeoutMs\": 300000,\n"
+          "                \"configureTimeoutMs\": 300000,\n"
+          "                \"consumptionMonitorPeriodMs\": 30000,\n"
+          "                \"keepaliveDurationMs\": 1800000,\n"
+          "                \"openTimeoutMs\": 300000,\n"
+          "                \"reopenMaxAttempts\": 10,\n"
+          "                \"reopenRetryIntervalMs\": 5000,\n"
+          "                \"reopenTimeoutMs\": 43200000,\n"
+          "                \"shutdownTimeoutMs\": 20000,\n"
+          "                \"stopTimeoutMs\": 10000\n"
+          "            },\n"
+          "            \"clusterMonitorConfig\": {\n"
+          "                \"maxTimeLeader\": 60,\n"
+          "                \"maxTimeMaster\": 120,\n"
+          "                \"maxTimeNode\": 120,\n"
+          "                \"maxTimeFailover\": 240,\n"
+          "                \"thresholdLeader\": 30,\n"
+          "                \"thresholdMaster\": 60,\n"
+          "                \"thresholdNode\": 60,\n"
+          "                \"thresholdFailover\": 120\n"
+          "            },\n"
+          "            \"messageThrottleConfig\": {\n"
+          "                \"lowThreshold\": 2,\n"
+          "                \"highThreshold\": 4,\n"
+          "                \"lowInterval\": 1000,\n"
+          "                \"highInterval\": 3000\n"
+          "            }\n"
+          "        }\n"
+          "    ],\n"
+          "    \"proxyClusters\": []\n"
+          "}\n";
+}
+
+/// Write to the specified `os` the configuration of the domain of the
+/// specified `storage` and `fanout`.
+void printDomainConfig(bsl::ostream& os, StorageMode::Enum storage, int fanout)
+{
+    os << "{\n"
+          "    \"definition\": {\n"
+          "        \"location\": \""
+       << k_CLUSTER_NAME
+       << "\",\n"
+          "        \"parameters\": {\n"
+          "            \"maxDeliveryAttempts\": 0,\n"
+          "            \"deduplicationTimeMs\": 300000,\n"
+          "            \"consistency\": {\n"
+          "                \"eventual\": {}\n"
+          "            },\n"
+          "            \"storage\": {\n"
+          "                \"config\": {\n"
+          "                    \""
+       << (storage == StorageMode::e_IN_MEMORY ? "inMemory" : "fileBacked")
+       << "\": {}\n"
+          "                },\n";
+
+    const char* k_LIMITS[] = {"domainLimits", "queueLimits"};
+    for (int i = 0; i < 2; ++i) {
+        os << "                \"" << k_LIMITS[i] << "\": {\n"
+           << "                    \"bytes\": " << k_LIMIT_BYTES << ",\n"
+           << "                    \"messages\": " << k_LIMIT_MESSAGES << ",\n"
+           << "                    \"bytesWatermarkRatio\": 0.8,\n"
+           << "                    \"messagesWatermarkRatio\": 0.8\n"
+           << "                }" << (i == 0 ? ",\n" : "\n");
+    }
+
+    os << "            },\n"
+          "            \"messageTtl\": 300,\n"
+          "            \"maxProducers\": 0,\n"
+          "            \"maxConsumers\": 0,\n"
+          "            \"maxQueues\": 0,\n"
+          "            \"maxIdleTime\": 0,\n"
+          "            \"mode\": {\n";
+
+    if (fanout == 1) {
+        os << "                \"priority\": {}\n";
+    }
+    else {
+        os << "                \"fanout\": {\n"
+              "                    \"appIDs\": [";
+        for (int i = 0; i < fanout; ++i) {
+            os << (i == 0 ? "" : ", ") << "\"" << Broker::appId(i) << "\"";
+        }
+        os << "]\n"
+              "                }\n";
+    }
+
+    os << "            }\n"
+          "        }\n"
+          "    }\n"
+          "}\n";
+}
+
+}  // close unnamed namespace
+
+// ------------------
+// struct StorageMode
+// ------------------
+
+const char* StorageMode::toAscii(StorageMode::Enum value)
+{
+    switch (value) {
+    case e_IN_MEMORY: return "inMemory";
+    case e_FILE_BACKED: return "fileBacked";
+    default: return "(* UNKNOWN *)";
+    }
+}
+
+bool StorageMode::fromAscii(StorageMode::Enum* out, const bsl::string& str)
+{
+    if (str == toAscii(e_IN_MEMORY)) {
+        *out = e_IN_MEMORY;
+        return true;  // RETURN
+    }
+
+    if (str == toAscii(e_FILE_BACKED)) {
+        *out = e_FILE_BACKED;
+        return true;  // RETURN
+    }
+
+    return false;
+}
+
+// ------------
+// class Broker
+// ------------
+
+// PRIVATE MANIPULATORS
+int Broker::writeConfig(bsl::ostream& errorDescription)
+{
+    bsl::string etcDir(d_workDir, d_allocator_p);
+    bdls::PathUtil::appendRaw(&etcDir, "etc");
+
+    bsl::string domainsDir(etcDir, d_allocator_p);
+    bdls::PathUtil::appendRaw(&domainsDir, "domains");
+
+    const char* k_DIRECTORIES[] = {"logs", "storage", "storage/archive"};
+    for (int i = 0; i < 3; ++i) {
+        bsl::string path(d_workDir, d_allocator_p);
+        bdls::PathUtil::appendRaw(&path, k_DIRECTORIES[i]);
+        if (bdls::FilesystemUtil::createDirectories(path, true) != 0) {
+            errorDescription << "failed to create '" << path << "'";
+            return -1;  // RETURN
+        }
+    }
+
+    if (bdls::FilesystemUtil::createDirectories(domainsDir, true) != 0) {
+        errorDescription << "failed to create '" << domainsDir << "'";
+        return -1;  // RETURN
+    }
+
+    // Clusters
+    mwcu::MemOutStream os(d_allocator_p);
+    printClustersConfig(os, d_port, d_workDir);
+    if (writeFile(errorDescription, etcDir + "/clusters.json", os.str()) !=
+        0) {
+        return -2;  // RETURN
+    }
+
+    // Domains
+    for (int storage = StorageMode::e_IN_MEMORY;
+         storage <= StorageMode::e_FILE_BACKED;
+         ++storage) {
+        for (size_t i = 0; i < d_fanouts.size(); ++i) {
+            const StorageMode::Enum mode = static_cast<StorageMode::Enum>(
+                storage);
+
+            os.reset();
+            printDomainConfig(os, mode, d_fanouts[i]);
+
+            const bsl::string path = domainsDir + "/" +
+                                     domainName(mode, d_fanouts[i]) + ".json";
+            if (writeFile(errorDescription, path, os.str()) != 0) {
+                return -3;  // RETURN
+            }
+        }
+    }
+
+    // Broker
+    os.reset();
+    printBrokerConfig(os, d_port, d_workDir);
+
+    baljsn::Decoder        decoder;
+    baljsn::DecoderOptions options;
+    options.setSkipUnknownElements(true);
+
+    bdlsb::FixedMemInStreamBuf streamBuf(os.str().data(), os.str().length());
+    if (decoder.decode(&streamBuf, &d_config, options) != 0) {
+        errorDescription << "failed to decode the broker configuration: "
+                         << decoder.loggedMessages();
+        return -4;  // RETURN
+    }
+
+    d_config.etcDir() = etcDir;
+
+    return 0;
+}
+
+// CLASS METHODS
+bsl::string Broker::domainName(StorageMode::Enum storage, int fanout)
+{
+    mwcu::MemOutStream os;
+    os << "bmq.bench."
+       << (storage == StorageMode::e_IN_MEMORY ? "mem" : "file");
+    if (fanout == 1) {
+        os << ".priority";
+    }
+    else {
+        os << ".fanout" << fanout;
+    }
+
+    return bsl::string(os.str().data(), os.str().length());
+}
+
+bsl::string Broker::appId(int index)
+{
+    mwcu::MemOutStream os;
+    os << "app" << index;
+    return bsl::string(os.str().data(), os.str().length());
+}
+
+// CREATORS
+Broker::Broker(const bsl::string&      workDir,
+               int                     port,
+               const bsl::vector<int>& fanouts,
+               bslma::Allocator*       allocator)
+: d_workDir(workDir, allocator)
+, d_port(port)
+, d_fanouts(fanouts, allocator)
+, d_config(allocator)
+, d_scheduler(bsls::SystemClockType::e_MONOTONIC, allocator)
+, d_application_mp()
+, d_allocator_p(allocator)
+{
+    // NOTHING
+}
+
+Broker::~Broker()
+{
+    stop();
+}
+
+// MANIPULATORS
+int Broker::start(bsl::ostream& errorDescription)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(!d_application_mp);
+
+    enum RcEnum {
+        // Value for the various RC error categories
+        rc_SUCCESS     = 0,
+        rc_CONFIG      = -1,
+        rc_SCHEDULER   = -2,
+        rc_APPLICATION = -3
+    };
+
+    mwcu::MemOutStream localError(d_allocator_p);
+
+    int rc = writeConfig(localError);
+    if (rc != 0) {
+        errorDescription << "Failed to write the broker configuration [rc: "
+                         << rc << ", error: " << localError.str() << "]";
+        return (rc * 10) + rc_CONFIG;  // RETURN
+    }
+
+    mqbcfg::BrokerConfig::set(d_config);
+
+    rc = d_scheduler.start();
+    if (rc != 0) {
+        errorDescription << "Failed to start the scheduler [rc: " << rc
+                         << "]";
+        return (rc * 10) + rc_SCHEDULER;  // RETURN
+    }
+
+    d_application_mp.load(new (*d_allocator_p)
+                              mqba::Application(&d_scheduler,
+                                                0,  // allocatorsStatContext
+                                                d_allocator_p),
+                          d_allocator_p);
+
+    rc = d_application_mp->start(localError);
+    if (rc != 0) {
+        errorDescription << "Failed to start the broker [rc: " << rc
+                         << ", error: " << localError.str() << "]";
+        d_application_mp->stop();
+        d_application_mp.reset();
+        d_scheduler.stop();
+        return (rc * 10) + rc_APPLICATION;  // RETURN
+    }
+
+    BALL_LOG_INFO << "Broker started [port: " << d_port
+                  << ", workDir: " << d_workDir << "]";
+
+    return rc_SUCCESS;
+}
+
+void Broker::stop()
+{
+    if (!d_application_mp) {
+        return;  // RETURN
+    }
+
+    d_application_mp->stop();
+    d_application_mp.reset();
+    d_scheduler.stop();
+
+    BALL_LOG_INFO << "Broker stopped";
+}
+
+// ACCESSORS
+bsl::string Broker::uri() const
+{
+    mwcu::MemOutStream os(d_allocator_p);
+    os << "tcp://localhost:" << d_port;
+    return bsl::string(os.str().data(), os.str().length(), d_allocator_p);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
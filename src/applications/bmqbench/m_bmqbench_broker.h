@@ -0,0 +1,186 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// m_bmqbench_broker.h                                                -*-C++-*-
+#ifndef INCLUDED_M_BMQBENCH_BROKER
+#define INCLUDED_M_BMQBENCH_BROKER
+
+//@PURPOSE: Provide a broker running in the process of the benchmark.
+//
+//@CLASSES:
+//  m_bmqbench::StorageMode: enum for the storage of the benchmark domains
+//  m_bmqbench::Broker     : in-process single node broker
+//
+//@DESCRIPTION: 'm_bmqbench::Broker' runs a 'mqba::Application' in the
+// current process, listening on a loopback TCP port, so that the benchmark
+// clients connect to it through the public 'bmqa' API exactly as they would to
+// a standalone broker.  The broker is a single node cluster named 'bench',
+// whose configuration is generated in an 'etc' directory below the work
+// directory supplied at construction, along with its storage.
+//
+/// Domains
+///-------
+// One domain is generated for each storage mode and each fanout the
+// benchmark needs, and is named by 'Broker::domainName'.  A domain with a
+// fanout of 1 is in priority mode, and a domain with a fanout of 'N > 1' is in
+// fanout mode with the 'N' app ids returned by 'Broker::appId'.  The limits of
+// the domains are high enough not to be reached by a benchmark.  A broker
+// started separately (for example a cluster) can be benchmarked as well, as
+// long as it defines the same domains, the generated configuration being
+// usable as a template.
+//
+/// Thread Safety
+///-------------
+// This component is not thread-safe.  Since the configuration of a broker is
+// process-wide, at most one 'Broker' can be started in a process, and only
+// once.
+
+// MQB
+#include <mqba_application.h>
+#include <mqbcfg_messages.h>
+
+// BDE
+#include <ball_log.h>
+#include <bdlmt_eventscheduler.h>
+#include <bsl_iosfwd.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+#include <bslma_allocator.h>
+#include <bslma_managedptr.h>
+#include <bslma_usesbslmaallocator.h>
+#include <bslmf_nestedtraitdeclaration.h>
+
+namespace BloombergLP {
+namespace m_bmqbench {
+
+// ==================
+// struct StorageMode
+// ==================
+
+/// Storage of the benchmark domains.
+struct StorageMode {
+    // TYPES
+    enum Enum { e_IN_MEMORY = 0, e_FILE_BACKED = 1 };
+
+    // CLASS METHODS
+
+    /// Return the non-modifiable string representation corresponding to
+    /// the specified enumeration `value`.
+    static const char* toAscii(StorageMode::Enum value);
+
+    /// Update the specified `out` with the enumerator whose string
+    /// representation is the specified `str`.  Return true on success, or
+    /// false, with no effect on `out`, if `str` does not match any
+    /// enumerator.
+    static bool fromAscii(StorageMode::Enum* out, const bsl::string& str);
+};
+
+// ============
+// class Broker
+// ============
+
+/// Single node broker running in the current process.
+class Broker {
+  private:
+    // CLASS-SCOPE CATEGORY
+    BALL_LOG_SET_CLASS_CATEGORY("BMQBENCH.BROKER");
+
+  private:
+    // DATA
+    bsl::string d_workDir;
+    // Directory holding the configuration and
+    // the storage of the broker
+
+    int d_port;
+    // TCP port the broker listens on
+
+    bsl::vector<int> d_fanouts;
+    // Fanouts of the domains to generate
+
+    mqbcfg::AppConfig d_config;
+    // Configuration of the broker, which must
+    // outlive the application
+
+    bdlmt::EventScheduler d_scheduler;
+    // Scheduler of the application
+
+    bslma::ManagedPtr<mqba::Application> d_application_mp;
+    // Application, if started
+
+    bslma::Allocator* d_allocator_p;
+    // Allocator to use
+
+  private:
+    // NOT IMPLEMENTED
+    Broker(const Broker&);
+    Broker& operator=(const Broker&);
+
+  private:
+    // PRIVATE MANIPULATORS
+
+    /// Write the configuration of the broker and of its domains below the
+    /// work directory, and load the broker configuration into
+    /// `d_config`.  Return 0 on success, or a non-zero value and populate
+    /// the specified `errorDescription` otherwise.
+    int writeConfig(bsl::ostream& errorDescription);
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(Broker, bslma::UsesBslmaAllocator)
+
+    // CLASS METHODS
+
+    /// Return the name of the benchmark domain of the specified `storage`
+    /// and `fanout`.
+    static bsl::string domainName(StorageMode::Enum storage, int fanout);
+
+    /// Return the app id of the specified `index` in a fanout domain.
+    static bsl::string appId(int index);
+
+    // CREATORS
+
+    /// Create a broker keeping its configuration and storage below the
+    /// specified `workDir`, listening on the specified `port`, and having a
+    /// domain of each storage mode for each of the specified `fanouts`.
+    /// Use the specified `allocator` to supply memory.
+    Broker(const bsl::string&      workDir,
+           int                     port,
+           const bsl::vector<int>& fanouts,
+           bslma::Allocator*       allocator);
+
+    /// Stop, if needed, and destroy this object.
+    ~Broker();
+
+    // MANIPULATORS
+
+    /// Start the broker.  Return 0 on success, or a non-zero value and
+    /// populate the specified `errorDescription` otherwise.  The behavior
+    /// is undefined if a broker has already been started in this process.
+    int start(bsl::ostream& errorDescription);
+
+    /// Stop the broker.  This method has no effect if the broker is not
+    /// started.
+    void stop();
+
+    // ACCESSORS
+
+    /// Return the URI the clients connect to the broker with.
+    bsl::string uri() const;
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
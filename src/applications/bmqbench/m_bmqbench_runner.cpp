@@ -0,0 +1,541 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// m_bmqbench_runner.cpp                                              -*-C++-*-
+#include <m_bmqbench_runner.h>
+
+// BMQ
+#include <bmqa_confirmeventbuilder.h>
+#include <bmqa_message.h>
+#include <bmqa_messageevent.h>
+#include <bmqa_messageeventbuilder.h>
+#include <bmqa_messageiterator.h>
+#include <bmqa_openqueuestatus.h>
+#include <bmqa_queueid.h>
+#include <bmqa_session.h>
+#include <bmqa_sessionevent.h>
+#include <bmqt_queueflags.h>
+#include <bmqt_queueoptions.h>
+#include <bmqt_resultcode.h>
+#include <bmqt_sessionoptions.h>
+#include <bmqt_uri.h>
+
+// MWC
+#include <mwcst_histogram.h>
+#include <mwcu_memoutstream.h>
+
+// BDE
+#include <ball_log.h>
+#include <bdlf_bind.h>
+#include <bdlt_timeunitratio.h>
+#include <bsl_algorithm.h>
+#include <bsl_cstring.h>
+#include <bsl_limits.h>
+#include <bsl_memory.h>
+#include <bsl_ostream.h>
+#include <bsl_vector.h>
+#include <bslma_managedptr.h>
+#include <bslmt_semaphore.h>
+#include <bslmt_threadgroup.h>
+#include <bslmt_threadutil.h>
+#include <bsls_assert.h>
+#include <bsls_atomic.h>
+#include <bsls_keyword.h>
+#include <bsls_systemtime.h>
+#include <bsls_timeinterval.h>
+#include <bsls_timeutil.h>
+
+namespace BloombergLP {
+namespace m_bmqbench {
+
+namespace {
+
+BALL_LOG_SET_NAMESPACE_CATEGORY("BMQBENCH.RUNNER");
+
+// CONSTANTS
+
+/// Size of the timestamp at the beginning of each message.
+const int k_TIMESTAMP_SIZE = sizeof(bsls::Types::Int64);
+
+/// Time, in microseconds, a producer waits before posting again when the
+/// window of the scenario is full or the session is over its bandwidth.
+const int k_PRODUCER_BACKOFF_US = 50;
+
+// ==============
+// struct Context
+// ==============
+
+/// State of a running scenario, shared by its producers and its consumers.
+struct Context {
+    // PUBLIC DATA
+    bsls::AtomicInt64 d_numPosted;
+    // Number of messages posted by all the
+    // producers
+
+    bsls::AtomicInt64 d_numReceived;
+    // Number of messages received by all the
+    // consumers
+
+    bsls::AtomicBool d_stop;
+    // Whether the producers must stop posting
+
+    mwcst::Histogram d_latencies;
+    // End-to-end latencies, in nanoseconds
+
+    bslmt::Semaphore d_doneSemaphore;
+    // Posted by each consumer when it has
+    // received all the messages
+
+    bsls::Types::Int64 d_numExpected;
+    // Number of messages each consumer is
+    // expected to receive
+
+    // CREATORS
+    Context(bsls::Types::Int64 numExpected, bslma::Allocator* allocator)
+    : d_numPosted(0)
+    , d_numReceived(0)
+    , d_stop(false)
+    , d_latencies(allocator)
+    , d_doneSemaphore(0)
+    , d_numExpected(numExpected)
+    {
+        d_latencies.init();
+    }
+};
+
+// FUNCTIONS
+
+/// Load into the specified `timestamp` the timestamp at the beginning of
+/// the payload of the specified `message`, using the specified `segments`
+/// as scratch space.  Return true on success, or false if the payload is
+/// too short.
+bool loadTimestamp(bsls::Types::Int64*             timestamp,
+                   bsl::vector<bslstl::StringRef>* segments,
+                   const bmqa::Message&            message)
+{
+    segments->clear();
+    if (message.getDataView(segments) != 0) {
+        return false;  // RETURN
+    }
+
+    // The timestamp may span several segments.
+    char buffer[k_TIMESTAMP_SIZE];
+    int  length = 0;
+    for (size_t i = 0; i < segments->size() && length < k_TIMESTAMP_SIZE;
+         ++i) {
+        const bslstl::StringRef& segment = (*segments)[i];
+        const int size = bsl::min(static_cast<int>(segment.length()),
+                                  k_TIMESTAMP_SIZE - length);
+        bsl::memcpy(buffer + length, segment.data(), size);
+        length += size;
+    }
+
+    if (length != k_TIMESTAMP_SIZE) {
+        return false;  // RETURN
+    }
+
+    bsl::memcpy(timestamp, buffer, k_TIMESTAMP_SIZE);
+    return true;
+}
+
+// =====================
+// class ConsumerHandler
+// =====================
+
+/// Event handler of a consumer session, recording the latency of each
+/// received message and confirming them.
+class ConsumerHandler : public bmqa::SessionEventHandler {
+  private:
+    // DATA
+    Context* d_context_p;
+    // State of the scenario
+
+    bmqa::Session* d_session_p;
+    // Session this handler is used by
+
+    bsls::Types::Int64 d_numReceived;
+    // Number of messages received by this
+    // consumer
+
+  public:
+    // CREATORS
+    explicit ConsumerHandler(Context* context)
+    : d_context_p(context)
+    , d_session_p(0)
+    , d_numReceived(0)
+    {
+        // NOTHING
+    }
+
+    // MANIPULATORS
+
+    /// Set the session this handler is used by to the specified `session`.
+    void setSession(bmqa::Session* session) { d_session_p = session; }
+
+    void onSessionEvent(const bmqa::SessionEvent& event) BSLS_KEYWORD_OVERRIDE
+    {
+        BALL_LOG_DEBUG << "Consumer session event: " << event;
+    }
+
+    void onMessageEvent(const bmqa::MessageEvent& event) BSLS_KEYWORD_OVERRIDE
+    {
+        const bsls::Types::Int64 now = bsls::TimeUtil::getTimer();
+
+        bsl::vector<bslstl::StringRef> segments;
+        bsls::Types::Int64             numMessages = 0;
+
+        bmqa::MessageIterator iterator = event.messageIterator();
+        while (iterator.nextMessage()) {
+            ++numMessages;
+
+            bsls::Types::Int64 sentTime;
+            if (loadTimestamp(&sentTime, &segments, iterator.message())) {
+                d_context_p->d_latencies.record(
+                    bsl::max(now - sentTime, bsls::Types::Int64(0)));
+            }
+        }
+
+        bmqa::ConfirmEventBuilder builder;
+        d_session_p->loadConfirmEventBuilder(&builder);
+        if (builder.addMessageConfirmations(event) != 0 ||
+            d_session_p->confirmMessages(&builder) != 0) {
+            BALL_LOG_WARN << "Failed to confirm " << numMessages
+                          << " messages";
+        }
+
+        d_context_p->d_numReceived.addRelaxed(numMessages);
+
+        const bsls::Types::Int64 previous = d_numReceived;
+        d_numReceived += numMessages;
+        if (previous < d_context_p->d_numExpected &&
+            d_numReceived >= d_context_p->d_numExpected) {
+            d_context_p->d_doneSemaphore.post();
+        }
+    }
+};
+
+/// Post the specified `numMessages` of the specified `scenario` to the
+/// specified `queueId` using the specified `session`, and update the
+/// specified `context`.
+void producerThread(Context*             context,
+                    bmqa::Session*       session,
+                    const bmqa::QueueId* queueId,
+                    const Scenario*      scenario,
+                    bsls::Types::Int64   numMessages)
+{
+    bsl::vector<char> payload(scenario->d_messageSize, 'x');
+
+    const bsls::Types::Int64 window = static_cast<bsls::Types::Int64>(
+                                          scenario->d_window) *
+                                      scenario->d_fanout;
+
+    bmqa::MessageEventBuilder builder;
+    bsls::Types::Int64        numPosted = 0;
+    while (numPosted < numMessages && !context->d_stop) {
+        const bsls::Types::Int64 numInFlight =
+            context->d_numPosted.loadRelaxed() * scenario->d_fanout -
+            context->d_numReceived.loadRelaxed();
+        if (numInFlight >= window) {
+            bslmt::ThreadUtil::microSleep(k_PRODUCER_BACKOFF_US);
+            continue;  // CONTINUE
+        }
+
+        const int batchSize = static_cast<int>(
+            bsl::min(static_cast<bsls::Types::Int64>(scenario->d_batchSize),
+                     numMessages - numPosted));
+
+        session->loadMessageEventBuilder(&builder);
+        for (int i = 0; i < batchSize; ++i) {
+            const bsls::Types::Int64 now = bsls::TimeUtil::getTimer();
+            bsl::memcpy(payload.data(), &now, k_TIMESTAMP_SIZE);
+
+            bmqa::Message& message = builder.startMessage();
+            message.setDataRef(payload.data(), payload.size());
+
+            const bmqt::EventBuilderResult::Enum rc = builder.packMessage(
+                *queueId);
+            if (rc != bmqt::EventBuilderResult::e_SUCCESS) {
+                BALL_LOG_ERROR << "Failed to pack a message [rc: " << rc
+                               << "]";
+                context->d_stop = true;
+                return;  // RETURN
+            }
+        }
+
+        int rc = session->post(builder.messageEvent());
+        while (rc == bmqt::PostResult::e_BW_LIMIT && !context->d_stop) {
+            bslmt::ThreadUtil::microSleep(k_PRODUCER_BACKOFF_US);
+            rc = session->post(builder.messageEvent());
+        }
+
+        if (rc != bmqt::PostResult::e_SUCCESS) {
+            if (!context->d_stop) {
+                BALL_LOG_ERROR << "Failed to post an event [rc: "
+                               << static_cast<bmqt::PostResult::Enum>(rc)
+                               << "]";
+                context->d_stop = true;
+            }
+            return;  // RETURN
+        }
+
+        numPosted += batchSize;
+        context->d_numPosted.addRelaxed(batchSize);
+    }
+}
+
+}  // close unnamed namespace
+
+// ---------------
+// struct Scenario
+// ---------------
+
+// CREATORS
+Scenario::Scenario()
+: d_storage(StorageMode::e_IN_MEMORY)
+, d_messageSize(1024)
+, d_batchSize(1)
+, d_fanout(1)
+, d_numProducers(1)
+, d_numMessages(100000)
+, d_window(10000)
+{
+    // NOTHING
+}
+
+// ---------------------
+// struct ScenarioResult
+// ---------------------
+
+// CREATORS
+ScenarioResult::ScenarioResult()
+: d_numPosted(0)
+, d_numReceived(0)
+, d_durationNs(0)
+, d_messagesPerSecond(0)
+, d_bytesPerSecond(0)
+, d_latencyP50Ns(0)
+, d_latencyP99Ns(0)
+, d_latencyP999Ns(0)
+, d_latencyMaxNs(0)
+, d_timedOut(false)
+{
+    // NOTHING
+}
+
+// ------------
+// class Runner
+// ------------
+
+// CREATORS
+Runner::Runner(const bsl::string& brokerUri, bslma::Allocator* allocator)
+: d_brokerUri(brokerUri, allocator)
+, d_scenarioId(0)
+, d_allocator_p(allocator)
+{
+    // NOTHING
+}
+
+// MANIPULATORS
+int Runner::run(ScenarioResult* result,
+                bsl::ostream&   errorDescription,
+                const Scenario& scenario,
+                int             timeoutSeconds)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(result);
+    BSLS_ASSERT_SAFE(k_TIMESTAMP_SIZE <= scenario.d_messageSize);
+    BSLS_ASSERT_SAFE(0 < scenario.d_batchSize);
+    BSLS_ASSERT_SAFE(0 < scenario.d_fanout);
+    BSLS_ASSERT_SAFE(0 < scenario.d_numProducers);
+    BSLS_ASSERT_SAFE(0 < scenario.d_window);
+
+    enum RcEnum {
+        // Value for the various RC error categories
+        rc_SUCCESS       = 0,
+        rc_SESSION_START = -1,
+        rc_OPEN_QUEUE    = -2,
+        rc_THREAD        = -3
+    };
+
+    typedef bsl::shared_ptr<bmqa::Session> SessionSp;
+
+    *result = ScenarioResult();
+
+    // The context must outlive the sessions, whose handlers refer to it.
+    Context context(scenario.d_numMessages, d_allocator_p);
+
+    bsl::vector<SessionSp>     consumers(d_allocator_p);
+    bsl::vector<SessionSp>     producers(d_allocator_p);
+    bsl::vector<bmqa::QueueId> queueIds(d_allocator_p);
+
+    mwcu::MemOutStream queueUri(d_allocator_p);
+    queueUri << "bmq://"
+             << Broker::domainName(scenario.d_storage, scenario.d_fanout)
+             << "/bench-" << d_scenarioId++;
+
+    bmqt::SessionOptions options(d_allocator_p);
+    options.setBrokerUri(d_brokerUri);
+
+    const bsls::Types::Int64 maxUnconfirmedBytes = bsl::min(
+        static_cast<bsls::Types::Int64>(scenario.d_window) *
+            scenario.d_messageSize,
+        static_cast<bsls::Types::Int64>(bsl::numeric_limits<int>::max()));
+
+    bmqt::QueueOptions queueOptions(d_allocator_p);
+    queueOptions.setMaxUnconfirmedMessages(scenario.d_window)
+        .setMaxUnconfirmedBytes(static_cast<int>(maxUnconfirmedBytes));
+
+    // Consumers
+    for (int i = 0; i < scenario.d_fanout; ++i) {
+        ConsumerHandler* handler = new (*d_allocator_p)
+            ConsumerHandler(&context);
+        bslma::ManagedPtr<bmqa::SessionEventHandler> handlerMp(handler,
+                                                               d_allocator_p);
+
+        SessionSp session(new (*d_allocator_p)
+                              bmqa::Session(handlerMp, options, d_allocator_p),
+                          d_allocator_p);
+        handler->setSession(session.get());
+        consumers.push_back(session);
+
+        int rc = session->start();
+        if (rc != 0) {
+            errorDescription << "Failed to start a consumer session [rc: "
+                             << static_cast<bmqt::GenericResult::Enum>(rc)
+                             << "]";
+            return rc_SESSION_START;  // RETURN
+        }
+
+        mwcu::MemOutStream uri(d_allocator_p);
+        uri << queueUri.str();
+        if (scenario.d_fanout > 1) {
+            uri << "?id=" << Broker::appId(i);
+        }
+
+        bmqa::QueueId               queueId(i, d_allocator_p);
+        const bmqa::OpenQueueStatus status = session->openQueueSync(
+            &queueId,
+            bmqt::Uri(uri.str(), d_allocator_p),
+            bmqt::QueueFlags::e_READ,
+            queueOptions);
+        if (status.result() != bmqt::OpenQueueResult::e_SUCCESS) {
+            errorDescription << "Failed to open '" << uri.str()
+                             << "' for reading: " << status;
+            return rc_OPEN_QUEUE;  // RETURN
+        }
+    }
+
+    // Producers
+    queueIds.reserve(scenario.d_numProducers);
+    for (int i = 0; i < scenario.d_numProducers; ++i) {
+        SessionSp session(new (*d_allocator_p)
+                              bmqa::Session(options, d_allocator_p),
+                          d_allocator_p);
+        producers.push_back(session);
+
+        int rc = session->start();
+        if (rc != 0) {
+            errorDescription << "Failed to start a producer session [rc: "
+                             << static_cast<bmqt::GenericResult::Enum>(rc)
+                             << "]";
+            return rc_SESSION_START;  // RETURN
+        }
+
+        queueIds.push_back(bmqa::QueueId(i, d_allocator_p));
+        const bmqa::OpenQueueStatus status = session->openQueueSync(
+            &queueIds.back(),
+            bmqt::Uri(queueUri.str(), d_allocator_p),
+            bmqt::QueueFlags::e_WRITE);
+        if (status.result() != bmqt::OpenQueueResult::e_SUCCESS) {
+            errorDescription << "Failed to open '" << queueUri.str()
+                             << "' for writing: " << status;
+            return rc_OPEN_QUEUE;  // RETURN
+        }
+    }
+
+    // Run
+    const bsls::Types::Int64 startTime = bsls::TimeUtil::getTimer();
+
+    bslmt::ThreadGroup threadGroup(d_allocator_p);
+    for (int i = 0; i < scenario.d_numProducers; ++i) {
+        // Spread the remainder of the messages over the first producers.
+        const bsls::Types::Int64 numMessages =
+            scenario.d_numMessages / scenario.d_numProducers +
+            (i < scenario.d_numMessages % scenario.d_numProducers ? 1 : 0);
+
+        int rc = threadGroup.addThread(bdlf::BindUtil::bind(&producerThread,
+                                                            &context,
+                                                            producers[i].get(),
+                                                            &queueIds[i],
+                                                            &scenario,
+                                                            numMessages));
+        if (rc != 0) {
+            context.d_stop = true;
+            threadGroup.joinAll();
+            errorDescription << "Failed to create a producer thread [rc: "
+                             << rc << "]";
+            return rc_THREAD;  // RETURN
+        }
+    }
+
+    const bsls::TimeInterval deadline =
+        bsls::SystemTime::nowRealtimeClock().addSeconds(timeoutSeconds);
+    for (int i = 0; i < scenario.d_fanout; ++i) {
+        if (context.d_doneSemaphore.timedWait(deadline) != 0) {
+            result->d_timedOut = true;
+            break;  // BREAK
+        }
+    }
+
+    const bsls::Types::Int64 endTime = bsls::TimeUtil::getTimer();
+
+    context.d_stop = true;
+    threadGroup.joinAll();
+
+    for (size_t i = 0; i < producers.size(); ++i) {
+        producers[i]->stop();
+    }
+    for (size_t i = 0; i < consumers.size(); ++i) {
+        consumers[i]->stop();
+    }
+
+    // Result
+    mwcst::Histogram::Buckets buckets(d_allocator_p);
+    context.d_latencies.loadBuckets(&buckets);
+
+    result->d_numPosted   = context.d_numPosted;
+    result->d_numReceived = context.d_numReceived;
+    result->d_durationNs  = endTime - startTime;
+    if (result->d_durationNs > 0) {
+        const double seconds = static_cast<double>(result->d_durationNs) /
+                               bdlt::TimeUnitRatio::k_NANOSECONDS_PER_SECOND;
+        result->d_messagesPerSecond = result->d_numPosted / seconds;
+        result->d_bytesPerSecond    = result->d_messagesPerSecond *
+                                   scenario.d_messageSize;
+    }
+    result->d_latencyP50Ns  = mwcst::Histogram::valueAtPercentile(buckets,
+                                                                 50.0);
+    result->d_latencyP99Ns  = mwcst::Histogram::valueAtPercentile(buckets,
+                                                                 99.0);
+    result->d_latencyP999Ns = mwcst::Histogram::valueAtPercentile(buckets,
+                                                                  99.9);
+    result->d_latencyMaxNs  = mwcst::Histogram::valueAtPercentile(buckets,
+                                                                 100.0);
+
+    return rc_SUCCESS;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
@@ -0,0 +1,192 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// m_bmqbench_runner.h                                                -*-C++-*-
+#ifndef INCLUDED_M_BMQBENCH_RUNNER
+#define INCLUDED_M_BMQBENCH_RUNNER
+
+//@PURPOSE: Provide a mechanism running a benchmark scenario against a broker.
+//
+//@CLASSES:
+//  m_bmqbench::Scenario      : parameters of a benchmark scenario
+//  m_bmqbench::ScenarioResult: throughput and latency of a scenario
+//  m_bmqbench::Runner        : runs scenarios against a broker
+//
+//@DESCRIPTION: 'm_bmqbench::Runner' runs a 'm_bmqbench::Scenario' against the
+// broker at the URI supplied at construction, and measures its throughput and
+// latency into a 'm_bmqbench::ScenarioResult'.
+//
+// Each scenario uses its own queue in the benchmark domain of its storage and
+// fanout (see 'm_bmqbench_broker').  One consumer session per app of the
+// domain reads the queue, and confirms each event it receives as a whole.
+// Then each producer session, from its own thread, posts its share of the
+// messages in events of the batch size of the scenario.  The producers stop
+// posting while the number of messages posted but not yet received by every
+// consumer exceeds the window of the scenario, so that the broker is measured
+// without accumulating an unbounded backlog.
+//
+// Every message starts with the time, as returned by
+// 'bsls::TimeUtil::getTimer', at which it was packed, and the consumers record
+// the difference with the time at which they receive it in a
+// 'mwcst::Histogram'.  Since the producers and the consumers run in the same
+// process, the latency is measured end-to-end, from the producer application
+// to the consumer application, through the broker.
+//
+/// Thread Safety
+///-------------
+// This component is not thread-safe.
+
+// BDE
+#include <bsl_iosfwd.h>
+#include <bsl_string.h>
+#include <bslma_allocator.h>
+#include <bslma_usesbslmaallocator.h>
+#include <bslmf_nestedtraitdeclaration.h>
+#include <bsls_types.h>
+
+// bmqbench
+#include <m_bmqbench_broker.h>
+
+namespace BloombergLP {
+namespace m_bmqbench {
+
+// ===============
+// struct Scenario
+// ===============
+
+/// Parameters of a benchmark scenario.
+struct Scenario {
+    // PUBLIC DATA
+    StorageMode::Enum d_storage;
+    // Storage of the domain of the queue
+
+    int d_messageSize;
+    // Size, in bytes, of the payload of each
+    // message
+
+    int d_batchSize;
+    // Number of messages per posted event
+
+    int d_fanout;
+    // Number of consumers, each reading all
+    // the messages with its own app id
+
+    int d_numProducers;
+    // Number of producer sessions
+
+    bsls::Types::Int64 d_numMessages;
+    // Total number of messages to post, split
+    // among the producers
+
+    int d_window;
+    // Maximum number of messages posted but
+    // not yet received by every consumer
+
+    // CREATORS
+
+    /// Create a scenario having default values.
+    Scenario();
+};
+
+// =====================
+// struct ScenarioResult
+// =====================
+
+/// Throughput and latency measured for a scenario.
+struct ScenarioResult {
+    // PUBLIC DATA
+    bsls::Types::Int64 d_numPosted;
+    // Number of messages posted
+
+    bsls::Types::Int64 d_numReceived;
+    // Number of messages received, by all the
+    // consumers
+
+    bsls::Types::Int64 d_durationNs;
+    // Time from the first post to the last
+    // reception
+
+    double d_messagesPerSecond;
+    // Number of messages posted per second
+
+    double d_bytesPerSecond;
+    // Number of payload bytes posted per second
+
+    bsls::Types::Int64 d_latencyP50Ns;
+    bsls::Types::Int64 d_latencyP99Ns;
+    bsls::Types::Int64 d_latencyP999Ns;
+    bsls::Types::Int64 d_latencyMaxNs;
+    // Percentiles of the end-to-end latency
+
+    bool d_timedOut;
+    // Whether some messages were not received
+    // in time
+
+    // CREATORS
+
+    /// Create a result having all its values set to 0.
+    ScenarioResult();
+};
+
+// ============
+// class Runner
+// ============
+
+/// Mechanism running benchmark scenarios against a broker.
+class Runner {
+  private:
+    // DATA
+    bsl::string d_brokerUri;
+    // URI of the broker
+
+    int d_scenarioId;
+    // Identifier of the queue of the next
+    // scenario
+
+    bslma::Allocator* d_allocator_p;
+    // Allocator to use
+
+  private:
+    // NOT IMPLEMENTED
+    Runner(const Runner&);
+    Runner& operator=(const Runner&);
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(Runner, bslma::UsesBslmaAllocator)
+
+    // CREATORS
+
+    /// Create a runner connecting to the broker at the specified
+    /// `brokerUri`.  Use the specified `allocator` to supply memory.
+    Runner(const bsl::string& brokerUri, bslma::Allocator* allocator);
+
+    // MANIPULATORS
+
+    /// Run the specified `scenario`, giving up waiting for the messages
+    /// after the specified `timeoutSeconds`, and load its measures into the
+    /// specified `result`.  Return 0 on success, or a non-zero value and
+    /// populate the specified `errorDescription` otherwise.  Note that a
+    /// scenario timing out is not a failure, but is flagged in `result`.
+    int run(ScenarioResult* result,
+            bsl::ostream&   errorDescription,
+            const Scenario& scenario,
+            int             timeoutSeconds);
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
@@ -229,6 +229,22 @@ static bool parseArgs(Parameters* parameters, int argc, const char* argv[])
          "interval to wait between each post",
          balcl::TypeInfo(&params.postInterval()),
          balcl::OccurrenceInfo(params.postInterval())},
+        {"openloop",
+         "openLoop",
+         "post at a constant rate, stamping messages with their intended "
+         "send time, so that stalls are accounted for in the latency",
+         balcl::TypeInfo(&params.openLoop()),
+         balcl::OccurrenceInfo::e_OPTIONAL},
+        {"producerthreads",
+         "producerThreads",
+         "number of threads posting, each at 'postrate' per 'postinterval'",
+         balcl::TypeInfo(&params.producerThreads()),
+         balcl::OccurrenceInfo(params.producerThreads())},
+        {"queues",
+         "numQueues",
+         "number of queues to open, named '<uri>-<index>' when more than one",
+         balcl::TypeInfo(&params.numQueues()),
+         balcl::OccurrenceInfo(params.numQueues())},
         {"v|verbosity",
          "verbosity",
          "verbosity ([silent, trace, debug, <info>, warning, error, fatal])",
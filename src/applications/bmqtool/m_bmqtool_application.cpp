@@ -55,12 +55,12 @@
 #include <bdlf_placeholder.h>
 #include <bdlt_currenttime.h>
 #include <bdlt_timeunitratio.h>
-#include <bsl_algorithm.h>
-#include <bsl_numeric.h>
+#include <bsl_fstream.h>
 #include <bsl_vector.h>
 #include <bslma_allocator.h>
 #include <bslma_managedptr.h>
 #include <bslmt_semaphore.h>
+#include <bslmt_threadutil.h>
 #include <bslmt_turnstile.h>
 #include <bsls_assert.h>
 #include <bsls_timeutil.h>
@@ -87,7 +87,17 @@ const int k_STAT_DUMP_INTERVAL = 1;
 // time), as computed by the configured frequency of message publishing.
 const int k_LATENCY_INTERVAL_MS = 5;
 
-// Id of the Queue (in non interactive mode)
+// Duration (in ns), after the first message with latency is received, during
+// which latencies are not accounted for in the latency report, so that the
+// initial warmup does not skew the results.
+const bsls::Types::Int64 k_LATENCY_WARMUP_NS =
+    30 * bdlt::TimeUnitRatio::k_NANOSECONDS_PER_SECOND;
+
+// How long (in us) should a producer wait before posting again an event
+// rejected because of the bandwidth limit, in open loop mode.
+const int k_BW_LIMIT_RETRY_INTERVAL_US = 100;
+
+// Id of the first Queue (in non interactive mode)
 const int k_QUEUEID_ID = 1;
 
 // Return the current time -in nanoseconds- using either the system time or the
@@ -108,34 +118,22 @@ bsls::Types::Int64 getNowAsNs(ParametersLatency::Value resolutionTimer)
     return 0;
 }
 
-/// Compute the `k`th percentile value of the specified `data` (data must be
-/// sorted).
-/// Formula:
-///  - compute the index (k percent * data size)
-///  - if index is not a whole number, round up to nearest whole number and
-///    return value at that index
-///  - if index it not a whole number, compute the average of the data at
-///    index and index + 1
-bsls::Types::Int64
-computePercentile(const bsl::vector<bsls::Types::Int64>& data, double k)
+/// Return the average of the values counted by the specified `buckets`,
+/// each value being approximated by the middle of its bucket, or 0 if
+/// `buckets` counts no value.
+double averageOf(const mwcst::Histogram::Buckets& buckets)
 {
-    // PRECONDITIONS
-    BSLS_ASSERT_SAFE(!data.empty());
-
-    // Special case (useless, but just to be complete)
-    if (bsl::abs(k) < bsl::numeric_limits<double>::epsilon()) {
-        return data[0];  // RETURN
+    double             sum   = 0;
+    bsls::Types::Int64 count = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        const int index = buckets[i].d_index;
+        sum += (mwcst::Histogram::bucketLowerBound(index) +
+                mwcst::Histogram::bucketUpperBound(index)) /
+               2.0 * buckets[i].d_count;
+        count += buckets[i].d_count;
     }
 
-    const int    index     = bsl::floor(k * data.size() / 100.0);
-    const double remainder = bsl::fmod(k * data.size(), 100.0);
-
-    if (bsl::abs(remainder) < bsl::numeric_limits<double>::epsilon()) {
-        return data[index - 1];  // RETURN
-    }
-    else {
-        return (data[index - 1] + data[index]) / 2;  // RETURN
-    }
+    return count == 0 ? 0 : sum / count;
 }
 
 }  // close unnamed namespace
@@ -428,7 +426,7 @@ void Application::printFinalStats()
 void Application::generateLatencyReport()
 {
     // PRECONDITIONS
-    BSLS_ASSERT_SAFE(!d_latencies.empty());
+    BSLS_ASSERT_SAFE(d_latencies.isInitialized());
     BSLS_ASSERT_SAFE(!d_parameters_p->latencyReportPath().empty());
 
     if (!(bmqt::QueueFlagsUtil::isReader(d_parameters_p->queueFlags()) &&
@@ -442,61 +440,66 @@ void Application::generateLatencyReport()
               << d_parameters_p->latencyReportPath() << ")\n"
               << "====================\n";
 
-    // 1. Remove the first 30s worth of data, to avoid initial warmup to
-    //    interfere and skew the results.  Since we know the frequency at which
-    //    messages are stamped with a timestamp (k_LATENCY_INTERVAL_MS), we can
-    //    easily do the reverse computation to compute how many metrics are in
-    //    30s.  Note that this assumes that the producer and consumer are using
-    //    the same build (the constant is used by the producer only, the
-    //    consumer just checks each message if it has a timestamp).  Also, note
-    //    that the 'k_LATENCY_INTERVAL_MS' represents the maximum sampling
-    //    rate, if the publisher is publishing very little (i.e. at less
-    //    frequently than one message per k_LATENCY_INTERVAL_MS, then all
-    //    messages will be stamped, but also we won't be having lots of
-    //    messages; therefore only delete if we have a large enough sample set.
-    const unsigned int k_toRemoveCount = 1000 / k_LATENCY_INTERVAL_MS * 30;
-    // Number of stamped messages in a 30s time interval
-
-    if (d_latencies.size() >= k_toRemoveCount * 2) {
-        bsl::list<bsls::Types::Int64>::iterator itEnd = d_latencies.begin();
-        bsl::advance(itEnd, k_toRemoveCount);
-        d_latencies.erase(d_latencies.begin(), itEnd);
+    // 1. Leave out the latencies measured during the first 30s, to avoid
+    //    initial warmup to interfere and skew the results, unless they are
+    //    more numerous than the ones measured after, in which case the run was
+    //    too short for the results to be representative anyway.
+    mwcst::Histogram::Buckets dataSet(d_allocator_p);
+    mwcst::Histogram::Buckets warmupDataSet(d_allocator_p);
+    d_latencies.loadBuckets(&dataSet);
+    d_warmupLatencies.loadBuckets(&warmupDataSet);
+
+    bsls::Types::Int64 populationSize       = 0;
+    bsls::Types::Int64 warmupPopulationSize = 0;
+    for (size_t i = 0; i < dataSet.size(); ++i) {
+        populationSize += dataSet[i].d_count;
     }
-    else {
-        bsl::cout << " **/!\\: Too few data points (" << d_latencies.size()
+    for (size_t i = 0; i < warmupDataSet.size(); ++i) {
+        warmupPopulationSize += warmupDataSet[i].d_count;
+    }
+
+    if (populationSize < warmupPopulationSize) {
+        mwcst::Histogram::merge(&dataSet, warmupDataSet);
+        populationSize += warmupPopulationSize;
+        bsl::cout << " **/!\\: Too few data points (" << populationSize
                   << "), the resulting statistics may not be representative."
                   << bsl::endl;
     }
 
-    // 2. Convert the list to a sorted vector: we use a list while collecting
-    //    data to avoid overhead of resizing the vector; but now convert to a
-    //    sorted vector to make it easier to compute some statistic metrics.
-    bsl::vector<bsls::Types::Int64> dataSet(d_latencies.begin(),
-                                            d_latencies.end());
-    bsl::sort(dataSet.begin(), dataSet.end());
-
-    // 3. Compute some interesting metrics
-    const bsls::Types::Int64 min = *bsl::min_element(dataSet.begin(),
-                                                     dataSet.end());
-    const bsls::Types::Int64 max = *bsl::max_element(dataSet.begin(),
-                                                     dataSet.end());
-
-    const bsls::Types::Int64 sum = bsl::accumulate(dataSet.begin(),
-                                                   dataSet.end(),
-                                                   0LL);
-    const double             avg = static_cast<double>(sum) / dataSet.size();
-
-    const bsls::Types::Int64 median = computePercentile(dataSet, 50.0);
-
-    const bsls::Types::Int64 p99 = computePercentile(dataSet, 99.0);
-    const bsls::Types::Int64 p98 = computePercentile(dataSet, 98.0);
-    const bsls::Types::Int64 p97 = computePercentile(dataSet, 97.0);
-    const bsls::Types::Int64 p96 = computePercentile(dataSet, 96.0);
-    const bsls::Types::Int64 p95 = computePercentile(dataSet, 95.0);
-
-    // 4. Print summary stats to stdout
+    if (populationSize == 0) {
+        bsl::cout << "  No latency was measured." << bsl::endl;
+        return;  // RETURN
+    }
+
+    // 2. Compute some interesting metrics.  Note that each value is only
+    //    known up to the precision of the bucket counting it.
+    const bsls::Types::Int64 min = mwcst::Histogram::bucketLowerBound(
+        dataSet.front().d_index);
+    const bsls::Types::Int64 max = mwcst::Histogram::bucketUpperBound(
+        dataSet.back().d_index);
+    const double             avg = averageOf(dataSet);
+
+    const bsls::Types::Int64 median =
+        mwcst::Histogram::valueAtPercentile(dataSet, 50.0);
+
+    const bsls::Types::Int64 p9999 =
+        mwcst::Histogram::valueAtPercentile(dataSet, 99.99);
+    const bsls::Types::Int64 p999 =
+        mwcst::Histogram::valueAtPercentile(dataSet, 99.9);
+    const bsls::Types::Int64 p99 =
+        mwcst::Histogram::valueAtPercentile(dataSet, 99.0);
+    const bsls::Types::Int64 p98 =
+        mwcst::Histogram::valueAtPercentile(dataSet, 98.0);
+    const bsls::Types::Int64 p97 =
+        mwcst::Histogram::valueAtPercentile(dataSet, 97.0);
+    const bsls::Types::Int64 p96 =
+        mwcst::Histogram::valueAtPercentile(dataSet, 96.0);
+    const bsls::Types::Int64 p95 =
+        mwcst::Histogram::valueAtPercentile(dataSet, 95.0);
+
+    // 3. Print summary stats to stdout
     bsl::cout
-        << "  Population size.: " << dataSet.size() << "\n"
+        << "  Population size.: " << populationSize << "\n"
         << "  min.............: " << mwcu::PrintUtil::prettyTimeInterval(min)
         << "\n"
         << "  avg.............: " << mwcu::PrintUtil::prettyTimeInterval(avg)
@@ -515,9 +518,13 @@ void Application::generateLatencyReport()
         << "\n"
         << "  99Percentile....: " << mwcu::PrintUtil::prettyTimeInterval(p99)
         << "\n"
+        << "  99.9Percentile..: " << mwcu::PrintUtil::prettyTimeInterval(p999)
+        << "\n"
+        << "  99.99Percentile.: "
+        << mwcu::PrintUtil::prettyTimeInterval(p9999) << "\n"
         << bsl::endl;
 
-    // 5. Generate the JSON report
+    // 4. Generate the JSON report
     bsl::ofstream output(d_parameters_p->latencyReportPath().c_str());
     if (!output) {
         bsl::cout << "Unable to generate latency report, failed to open '"
@@ -526,28 +533,30 @@ void Application::generateLatencyReport()
         return;  // RETURN
     }
     output << "{\n"
+           << "  \"populationSize\": " << populationSize << ",\n"
            << "  \"min\": " << min << ",\n"
            << "  \"avg\": " << avg << ",\n"
            << "  \"max\": " << max << ",\n"
            << "  \"median\": " << median << ",\n"
+           << "  \"99.99percentile\": " << p9999 << ",\n"
+           << "  \"99.9percentile\": " << p999 << ",\n"
            << "  \"99percentile\": " << p99 << ",\n"
            << "  \"98percentile\": " << p98 << ",\n"
            << "  \"97percentile\": " << p97 << ",\n"
            << "  \"96percentile\": " << p96 << ",\n"
            << "  \"95percentile\": " << p95 << ",\n"
-           << "  \"dataPoints\": [";
-    // Print the unsorted (i.e. in reporting order) data, so that if needed, we
-    // could see the evolution over time and maybe some pattern (for example
-    // initial latency being higher due to cache warmup, ...).
-    int                                           idx = 0;
-    bsl::list<bsls::Types::Int64>::const_iterator it  = d_latencies.begin();
-    while (it != d_latencies.end()) {
-        if (idx++ % 10 == 0) {
-            output << "\n    ";
-        }
-        output << *it;
-        if (++it != d_latencies.end()) {
-            output << ", ";
+           << "  \"histogram\": [";
+    // Print the non-empty buckets, so that the full distribution can be
+    // plotted or merged with the reports of other consumers.
+    for (size_t i = 0; i < dataSet.size(); ++i) {
+        const int index = dataSet[i].d_index;
+        output << "\n    { \"lowerBound\": "
+               << mwcst::Histogram::bucketLowerBound(index)
+               << ", \"upperBound\": "
+               << mwcst::Histogram::bucketUpperBound(index)
+               << ", \"count\": " << dataSet[i].d_count << " }";
+        if (i + 1 != dataSet.size()) {
+            output << ",";
         }
     }
     output << "\n  ]\n"
@@ -628,10 +637,7 @@ int Application::initialize()
 
         BALL_LOG_INFO << "Session started.";
 
-        d_session_mp->loadMessageEventBuilder(
-            &d_sessionContext_mp->d_eventBuilder);
-
-        // Open the queue if in AutoMode
+        // Open the queues if in AutoMode
         bmqt::QueueOptions queueOptions;
         queueOptions
             .setMaxUnconfirmedMessages(d_parameters_p->maxUnconfirmedMsgs())
@@ -644,15 +650,36 @@ int Application::initialize()
             return e_VALIDATE_SUBSCRIPTION_ERROR;  // RETURN
         }
 
-        bmqa::OpenQueueStatus result = d_session_mp->openQueueSync(
-            &d_sessionContext_mp->d_queueId,
-            d_parameters_p->queueUri(),
-            d_parameters_p->queueFlags(),
-            queueOptions);
-        if (!result) {
-            BALL_LOG_ERROR << "Error while opening queue: [result: " << result
-                           << "]";
-            return e_OPEN_QUEUE_ERROR;  // RETURN
+        // When asked for several queues, they are all named after the
+        // specified queue uri, suffixed with their index.
+        const int numQueues = d_parameters_p->numQueues();
+        for (int i = 0; i < numQueues; ++i) {
+            mwcu::MemOutStream uri;
+            uri << d_parameters_p->queueUri();
+            if (numQueues > 1) {
+                uri << "-" << i;
+            }
+
+            d_sessionContext_mp->d_queueIds.push_back(
+                bmqa::QueueId(k_QUEUEID_ID + i, d_allocator_p));
+            bmqa::OpenQueueStatus result = d_session_mp->openQueueSync(
+                &d_sessionContext_mp->d_queueIds.back(),
+                uri.str(),
+                d_parameters_p->queueFlags(),
+                queueOptions);
+            if (!result) {
+                BALL_LOG_ERROR << "Error while opening queue '" << uri.str()
+                               << "': [result: " << result << "]";
+                return e_OPEN_QUEUE_ERROR;  // RETURN
+            }
+        }
+
+        // Prepare the histograms of the latencies, if asked for a report
+        if (bmqt::QueueFlagsUtil::isReader(d_parameters_p->queueFlags()) &&
+            d_parameters_p->latency() != ParametersLatency::e_NONE &&
+            !d_parameters_p->latencyReportPath().empty()) {
+            d_latencies.init();
+            d_warmupLatencies.init();
         }
 
         // If in producer mode, prepare the blob that we will post over and
@@ -823,15 +850,30 @@ void Application::onMessageEvent(const bmqa::MessageEvent& event)
                         // remain decently representative of actual measures.
                         d_statContext_mp->reportValue(k_STAT_LAT, delta);
 
-                        // Keep each individual latency when requested to
-                        // generate a latency report.  Note that since only one
-                        // message every k_LATENCY_INTERVAL_MS time interval
-                        // has latency, this list will not grow out of control
-                        // when run during a 'decent' amount of time.  With a
-                        // default of 5ms, this implies 200 items per second,
-                        // or 120,000 for 10 minutes.
-                        if (!d_parameters_p->latencyReportPath().empty()) {
-                            d_latencies.push_back(delta);
+                        // Count each individual latency when requested to
+                        // generate a latency report.  The histograms having a
+                        // fixed size, every message can be stamped (as in open
+                        // loop mode) during any amount of time.
+                        if (d_latencies.isInitialized()) {
+                            bsls::Types::Int64 warmupEndNs =
+                                d_latencyWarmupEndNs;
+                            if (warmupEndNs == 0) {
+                                warmupEndNs = now + k_LATENCY_WARMUP_NS;
+                                const bsls::Types::Int64 previous =
+                                    d_latencyWarmupEndNs.testAndSwap(
+                                        0,
+                                        warmupEndNs);
+                                if (previous != 0) {
+                                    warmupEndNs = previous;
+                                }
+                            }
+
+                            if (now < warmupEndNs) {
+                                d_warmupLatencies.record(delta);
+                            }
+                            else {
+                                d_latencies.record(delta);
+                            }
                         }
                     }
                 }
@@ -886,20 +928,49 @@ void Application::onMessageEvent(const bmqa::MessageEvent& event)
     }
 }
 
-void Application::producerThread()
+void Application::producerThread(int threadIndex)
 {
     BSLS_ASSERT_SAFE(d_sessionContext_mp);
     BSLS_ASSERT_SAFE(d_session_mp);
 
-    bmqa::MessageEventBuilder& eventBuilder =
-        d_sessionContext_mp->d_eventBuilder;
-    bmqa::QueueId& queueId = d_sessionContext_mp->d_queueId;
+    const bsl::vector<bmqa::QueueId>& queueIds =
+        d_sessionContext_mp->d_queueIds;
+
+    // Each producer thread builds its events with its own builder, and stamps
+    // its own copy of the blob, sharing the payload buffers of 'd_blob'.
+    bmqa::MessageEventBuilder eventBuilder;
+    d_session_mp->loadMessageEventBuilder(&eventBuilder);
+
+    bdlbb::Blob blob(d_blob, d_allocator_p);
+
+    int msgUntilNextTimestamp = 0;
+    // Number of messages remaining to send until stamping one with latency
+    // (closed loop only).
 
     bslmt::Turnstile turnstile(1000.0);
     if (d_parameters_p->postInterval() != 0) {
         turnstile.reset(1000.0 / d_parameters_p->postInterval());
     }
 
+    // In open loop mode, the events are posted at a constant rate: the event
+    // number 'i' is meant to be posted 'i * periodNs' after the start, and is
+    // posted as soon as possible if that time is already past, so that a stall
+    // delays the following events instead of being silently absorbed by the
+    // pacing.  Its messages are stamped with that intended time, so that the
+    // latency measured by the consumer includes the time spent waiting to be
+    // posted (i.e., it does not suffer from coordinated omission).
+    const bool                     openLoop = d_parameters_p->openLoop();
+    const ParametersLatency::Value clock =
+        d_parameters_p->latency() != ParametersLatency::e_NONE
+            ? d_parameters_p->latency()
+            : ParametersLatency::e_HIRES;
+    const double periodNs = openLoop ? d_parameters_p->postInterval() *
+                                           bdlt::TimeUnitRatio::k_NS_PER_MS /
+                                           double(d_parameters_p->postRate())
+                                     : 0;
+    const bsls::Types::Int64 startTimeNs = getNowAsNs(clock);
+    bsls::Types::Int64       evtSeqId    = 0;  // number of events scheduled
+
     int msgSeqId = 0;  // number of messages posted since the beginning
 
     // If eventsCount == 0, this means unlimited posting, else we'll
@@ -922,6 +993,20 @@ void Application::producerThread()
         for (int evtId = 0;
              evtId < d_parameters_p->postRate() && remainingEvents != -1;
              ++evtId) {
+            const bsls::Types::Int64 evtIndex       = evtSeqId++;
+            bsls::Types::Int64       intendedTimeNs = 0;
+            if (openLoop) {
+                intendedTimeNs = startTimeNs +
+                                 static_cast<bsls::Types::Int64>(evtIndex *
+                                                                 periodNs);
+                const bsls::Types::Int64 aheadNs = intendedTimeNs -
+                                                   getNowAsNs(clock);
+                if (aheadNs > 0) {
+                    bslmt::ThreadUtil::sleep(
+                        bsls::TimeInterval().addNanoseconds(aheadNs));
+                }
+            }
+
             if (d_parameters_p->eventSize() == 0) {
                 // To get nice stats chart with round numbers in bench mode, we
                 // usually start with eventSize == 0; however posting Events
@@ -958,8 +1043,14 @@ void Application::producerThread()
                         ParametersLatency::e_NONE) {
                         bdlb::BigEndianInt64 timeNs;
 
-                        if (d_msgUntilNextTimestamp != 0) {
-                            --d_msgUntilNextTimestamp;
+                        if (openLoop) {
+                            // Stamp every message with the intended time,
+                            // which is free to compute.
+                            timeNs = bdlb::BigEndianInt64::make(
+                                intendedTimeNs);
+                        }
+                        else if (msgUntilNextTimestamp != 0) {
+                            --msgUntilNextTimestamp;
                             timeNs = bdlb::BigEndianInt64::make(0);
                         }
                         else {
@@ -973,9 +1064,9 @@ void Application::producerThread()
                                               d_parameters_p->postRate() *
                                               1000 /
                                               d_parameters_p->postInterval();
-                            d_msgUntilNextTimestamp = nbMsgPerSec *
-                                                      k_LATENCY_INTERVAL_MS /
-                                                      1000;
+                            msgUntilNextTimestamp = nbMsgPerSec *
+                                                    k_LATENCY_INTERVAL_MS /
+                                                    1000;
                         }
 
                         bdlbb::BlobBuffer buffer;
@@ -984,18 +1075,19 @@ void Application::producerThread()
                         bsl::memcpy(buffer.buffer().get(),
                                     &timeNs,
                                     sizeof(timeNs));
-                        d_blob.swapBufferRaw(0, &buffer);
+                        blob.swapBufferRaw(0, &buffer);
                     }
-                    msg.setDataRef(&d_blob);
+                    msg.setDataRef(&blob);
 
-                    length = d_blob.length();
+                    length = blob.length();
                 }
 
                 if (out.numProperties()) {
                     msg.setPropertiesRef(&out);
                 }
+                // Spread the events of the producer threads over the queues
                 bmqt::EventBuilderResult::Enum rc = eventBuilder.packMessage(
-                    queueId);
+                    queueIds[(threadIndex + evtIndex) % queueIds.size()]);
                 if (rc != 0) {
                     BALL_LOG_ERROR << "Failed to pack message [rc: " << rc
                                    << "]";
@@ -1018,6 +1110,14 @@ void Application::producerThread()
             }
 
             int rc = d_session_mp->post(messageEvent);
+            while (openLoop && rc == bmqt::PostResult::e_BW_LIMIT &&
+                   d_isRunning) {
+                // In open loop mode, an event is never dropped: the time
+                // spent waiting for bandwidth is part of the latency of its
+                // messages.
+                bslmt::ThreadUtil::microSleep(k_BW_LIMIT_RETRY_INTERVAL_US);
+                rc = d_session_mp->post(messageEvent);
+            }
 
             if (rc != 0) {
                 BALL_LOG_ERROR
@@ -1041,15 +1141,16 @@ void Application::producerThread()
             }
         }
 
-        if (d_parameters_p->postInterval() != 0) {
+        if (!openLoop && d_parameters_p->postInterval() != 0) {
             turnstile.waitTurn();
         }
     }
 
-    // Finished posting messages in auto mode?
+    // Finished posting messages in auto mode, from all the producer threads?
     // If shutDownGrace is set, signal to the main thread to exit.
     if (d_parameters_p->mode() == ParametersMode::e_AUTO &&
-        d_parameters_p->shutdownGrace() != 0) {
+        d_parameters_p->shutdownGrace() != 0 &&
+        --d_numRunningProducers == 0) {
         // We do not need to sleep the grace period, since it is done
         // by the main thread, in the stop() function.
         d_shutdownSemaphore_p->post();
@@ -1117,18 +1218,20 @@ Application::Application(Parameters*       parameters,
 : d_allocator_p(bslma::Default::allocator(allocator))
 , d_parameters_p(parameters)
 , d_shutdownSemaphore_p(shutdownSemaphore)
-, d_runningThread(bslmt::ThreadUtil::invalidHandle())
+, d_producerThreads(d_allocator_p)
+, d_numRunningProducers(0)
 , d_isConnected(false)
 , d_isRunning(false)
 , d_consoleObserver(d_allocator_p)
 , d_bufferFactory(4096, d_allocator_p)
 , d_timeBufferFactory(sizeof(bdlb::BigEndianInt64), d_allocator_p)
 , d_blob(&d_bufferFactory, d_allocator_p)
-, d_msgUntilNextTimestamp(0)
 , d_interactive(parameters, d_allocator_p)
 , d_storageInspector(d_allocator_p)
 , d_fileLogger(d_parameters_p->logFilePath(), d_allocator_p)
-, d_latencies(allocator)
+, d_latencies(d_allocator_p)
+, d_warmupLatencies(d_allocator_p)
+, d_latencyWarmupEndNs(0)
 , d_autoReadInProgress(false)
 , d_autoReadActivity(false)
 {
@@ -1141,7 +1244,7 @@ Application::~Application()
 }
 
 Application::SessionContext::SessionContext(bslma::Allocator* allocator)
-: d_queueId(k_QUEUEID_ID, allocator)
+: d_queueIds(allocator)
 {
     // NOTHING
 }
@@ -1194,11 +1297,16 @@ int Application::run()
         d_shutdownSemaphore_p->post();
     }
     else {
-        // Start the thread
+        // Start the producer threads
         if (bmqt::QueueFlagsUtil::isWriter(d_parameters_p->queueFlags())) {
-            rc = bslmt::ThreadUtil::create(
-                &d_runningThread,
-                bdlf::MemFnUtil::memFn(&Application::producerThread, this));
+            const int numThreads  = d_parameters_p->numProducerThreads();
+            d_numRunningProducers = numThreads;
+            for (int i = 0; i < numThreads && rc == 0; ++i) {
+                rc = d_producerThreads.addThread(
+                    bdlf::BindUtil::bind(&Application::producerThread,
+                                         this,
+                                         i));
+            }
         }
     }
 
@@ -1216,10 +1324,7 @@ void Application::stop()
     d_scheduler.cancelAllEventsAndWait();
     d_scheduler.stop();
 
-    if (d_runningThread != bslmt::ThreadUtil::invalidHandle()) {
-        bslmt::ThreadUtil::join(d_runningThread);
-        d_runningThread = bslmt::ThreadUtil::invalidHandle();
-    }
+    d_producerThreads.joinAll();
 
     // Disconnect from the broker
     if (d_parameters_p->mode() == ParametersMode::e_AUTO) {
@@ -1247,7 +1352,7 @@ void Application::stop()
         printFinalStats();
     }
 
-    if (!d_latencies.empty()) {
+    if (d_latencies.isInitialized()) {
         generateLatencyReport();
     }
 
@@ -35,11 +35,11 @@
 #include <mqbs_journalfileiterator.h>
 
 // BMQ
-#include <bmqa_messageeventbuilder.h>
 #include <bmqa_queueid.h>
 #include <bmqa_session.h>
 
 // MWC
+#include <mwcst_histogram.h>
 #include <mwcst_statcontext.h>
 #include <mwctsk_consoleobserver.h>
 
@@ -48,10 +48,10 @@
 #include <bdlbb_blob.h>
 #include <bdlbb_pooledblobbufferfactory.h>
 #include <bdlmt_eventscheduler.h>
-#include <bsl_list.h>
+#include <bsl_vector.h>
 #include <bslma_allocator.h>
 #include <bslma_managedptr.h>
-#include <bslmt_threadutil.h>
+#include <bslmt_threadgroup.h>
 #include <bsls_atomic.h>
 #include <bsls_types.h>
 
@@ -80,10 +80,8 @@ class Application : public bmqa::SessionEventHandler {
     /// This structure holds context created by `bmqa::Session`.
     /// It must be destructed before the `d_session_mp`.
     struct SessionContext {
-        bmqa::QueueId d_queueId;
-
-        bmqa::MessageEventBuilder d_eventBuilder;
-        // Message event builder.
+        bsl::vector<bmqa::QueueId> d_queueIds;
+        // Queues opened in auto mode.
 
         SessionContext(bslma::Allocator* d_allocator);
     };
@@ -100,10 +98,14 @@ class Application : public bmqa::SessionEventHandler {
     // Semaphore holding the main thread
     // alive
 
-    bslmt::ThreadUtil::Handle d_runningThread;
-    // Handle on the running thread
+    bslmt::ThreadGroup d_producerThreads;
+    // Threads posting the messages
     // (producer mode)
 
+    bsls::AtomicInt d_numRunningProducers;
+    // Number of producer threads which have
+    // not finished posting yet
+
     StatContextMP d_statContext_mp;
     // StatContext for msg/event stats
 
@@ -133,17 +135,14 @@ class Application : public bmqa::SessionEventHandler {
     // hold the timestamp information
 
     bdlbb::Blob d_blob;
-    // Blob to post
+    // Blob to post.  Each producer thread
+    // stamps its own copy of it.
 
     bslma::ManagedPtr<SessionContext> d_sessionContext_mp;
 
     bslma::ManagedPtr<bmqa::Session> d_session_mp;
     // Session with the BlazingMQ broker.
 
-    int d_msgUntilNextTimestamp;
-    // Number of messages remaining to send
-    // until stamping one with latency.
-
     Interactive d_interactive;
 
     StorageInspector d_storageInspector;
@@ -152,12 +151,24 @@ class Application : public bmqa::SessionEventHandler {
     // Logger to use in case events logging
     // to file has been enabled.
 
-    bsl::list<bsls::Types::Int64> d_latencies;
-    // List of all message latencies (in
-    // ns).  Only populated when requested
-    // to generate a latency report (with
+    mwcst::Histogram d_latencies;
+    // Histogram of the message latencies
+    // (in ns) after the warmup period.
+    // Only initialized when requested to
+    // generate a latency report (with
     // --latency-report).
 
+    mwcst::Histogram d_warmupLatencies;
+    // Histogram of the message latencies
+    // (in ns) during the warmup period,
+    // kept apart so as not to skew the
+    // report.
+
+    bsls::AtomicInt64 d_latencyWarmupEndNs;
+    // Time, on the latency clock, at which
+    // the warmup period ends, or 0 if no
+    // latency was measured yet.
+
     bsls::AtomicBool d_autoReadInProgress;
     // Auto-consume mode only.  True if a
     // message has already been seen.
@@ -213,8 +224,9 @@ class Application : public bmqa::SessionEventHandler {
     /// success.
     int initialize();
 
-    /// Thread to process the publish.
-    void producerThread();
+    /// Thread to process the publish, having the specified `threadIndex`
+    /// among the producer threads.
+    void producerThread(int threadIndex);
 
   public:
     // CLASS METHODS
@@ -4211,6 +4211,12 @@ const char
     CommandLineParameters::DEFAULT_INITIALIZER_SEQUENTIAL_MESSAGE_PATTERN[] =
         "";
 
+const bool CommandLineParameters::DEFAULT_INITIALIZER_OPEN_LOOP = false;
+
+const int CommandLineParameters::DEFAULT_INITIALIZER_PRODUCER_THREADS = 1;
+
+const int CommandLineParameters::DEFAULT_INITIALIZER_NUM_QUEUES = 1;
+
 const bdlat_AttributeInfo CommandLineParameters::ATTRIBUTE_INFO_ARRAY[] = {
     {ATTRIBUTE_ID_MODE,
      "mode",
@@ -4336,7 +4342,22 @@ const bdlat_AttributeInfo CommandLineParameters::ATTRIBUTE_INFO_ARRAY[] = {
      "subscriptions",
      sizeof("subscriptions") - 1,
      "",
-     bdlat_FormattingMode::e_DEFAULT}};
+     bdlat_FormattingMode::e_DEFAULT},
+    {ATTRIBUTE_ID_OPEN_LOOP,
+     "openLoop",
+     sizeof("openLoop") - 1,
+     "",
+     bdlat_FormattingMode::e_TEXT},
+    {ATTRIBUTE_ID_PRODUCER_THREADS,
+     "producerThreads",
+     sizeof("producerThreads") - 1,
+     "",
+     bdlat_FormattingMode::e_DEC},
+    {ATTRIBUTE_ID_NUM_QUEUES,
+     "numQueues",
+     sizeof("numQueues") - 1,
+     "",
+     bdlat_FormattingMode::e_DEC}};
 
 // CLASS METHODS
 
@@ -4408,6 +4429,12 @@ const bdlat_AttributeInfo* CommandLineParameters::lookupAttributeInfo(int id)
         return &ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_MESSAGE_PROPERTIES];
     case ATTRIBUTE_ID_SUBSCRIPTIONS:
         return &ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_SUBSCRIPTIONS];
+    case ATTRIBUTE_ID_OPEN_LOOP:
+        return &ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_OPEN_LOOP];
+    case ATTRIBUTE_ID_PRODUCER_THREADS:
+        return &ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_PRODUCER_THREADS];
+    case ATTRIBUTE_ID_NUM_QUEUES:
+        return &ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_NUM_QUEUES];
     default: return 0;
     }
 }
@@ -4437,10 +4464,13 @@ CommandLineParameters::CommandLineParameters(bslma::Allocator* basicAllocator)
 , d_postInterval(DEFAULT_INITIALIZER_POST_INTERVAL)
 , d_threads(DEFAULT_INITIALIZER_THREADS)
 , d_shutdownGrace(DEFAULT_INITIALIZER_SHUTDOWN_GRACE)
+, d_producerThreads(DEFAULT_INITIALIZER_PRODUCER_THREADS)
+, d_numQueues(DEFAULT_INITIALIZER_NUM_QUEUES)
 , d_dumpMsg(DEFAULT_INITIALIZER_DUMP_MSG)
 , d_confirmMsg(DEFAULT_INITIALIZER_CONFIRM_MSG)
 , d_memoryDebug(DEFAULT_INITIALIZER_MEMORY_DEBUG)
 , d_noSessionEventHandler(DEFAULT_INITIALIZER_NO_SESSION_EVENT_HANDLER)
+, d_openLoop(DEFAULT_INITIALIZER_OPEN_LOOP)
 {
 }
 
@@ -4469,10 +4499,13 @@ CommandLineParameters::CommandLineParameters(
 , d_postInterval(original.d_postInterval)
 , d_threads(original.d_threads)
 , d_shutdownGrace(original.d_shutdownGrace)
+, d_producerThreads(original.d_producerThreads)
+, d_numQueues(original.d_numQueues)
 , d_dumpMsg(original.d_dumpMsg)
 , d_confirmMsg(original.d_confirmMsg)
 , d_memoryDebug(original.d_memoryDebug)
 , d_noSessionEventHandler(original.d_noSessionEventHandler)
+, d_openLoop(original.d_openLoop)
 {
 }
 
@@ -4501,10 +4534,13 @@ CommandLineParameters::CommandLineParameters(
   d_postInterval(bsl::move(original.d_postInterval)),
   d_threads(bsl::move(original.d_threads)),
   d_shutdownGrace(bsl::move(original.d_shutdownGrace)),
+  d_producerThreads(bsl::move(original.d_producerThreads)),
+  d_numQueues(bsl::move(original.d_numQueues)),
   d_dumpMsg(bsl::move(original.d_dumpMsg)),
   d_confirmMsg(bsl::move(original.d_confirmMsg)),
   d_memoryDebug(bsl::move(original.d_memoryDebug)),
-  d_noSessionEventHandler(bsl::move(original.d_noSessionEventHandler))
+  d_noSessionEventHandler(bsl::move(original.d_noSessionEventHandler)),
+  d_openLoop(bsl::move(original.d_openLoop))
 {
 }
 
@@ -4532,10 +4568,13 @@ CommandLineParameters::CommandLineParameters(CommandLineParameters&& original,
 , d_postInterval(bsl::move(original.d_postInterval))
 , d_threads(bsl::move(original.d_threads))
 , d_shutdownGrace(bsl::move(original.d_shutdownGrace))
+, d_producerThreads(bsl::move(original.d_producerThreads))
+, d_numQueues(bsl::move(original.d_numQueues))
 , d_dumpMsg(bsl::move(original.d_dumpMsg))
 , d_confirmMsg(bsl::move(original.d_confirmMsg))
 , d_memoryDebug(bsl::move(original.d_memoryDebug))
 , d_noSessionEventHandler(bsl::move(original.d_noSessionEventHandler))
+, d_openLoop(bsl::move(original.d_openLoop))
 {
 }
 #endif
@@ -4575,6 +4614,9 @@ CommandLineParameters::operator=(const CommandLineParameters& rhs)
         d_sequentialMessagePattern = rhs.d_sequentialMessagePattern;
         d_messageProperties        = rhs.d_messageProperties;
         d_subscriptions            = rhs.d_subscriptions;
+        d_openLoop                 = rhs.d_openLoop;
+        d_producerThreads          = rhs.d_producerThreads;
+        d_numQueues                = rhs.d_numQueues;
     }
 
     return *this;
@@ -4611,6 +4653,9 @@ CommandLineParameters::operator=(CommandLineParameters&& rhs)
         d_sequentialMessagePattern = bsl::move(rhs.d_sequentialMessagePattern);
         d_messageProperties        = bsl::move(rhs.d_messageProperties);
         d_subscriptions            = bsl::move(rhs.d_subscriptions);
+        d_openLoop                 = bsl::move(rhs.d_openLoop);
+        d_producerThreads          = bsl::move(rhs.d_producerThreads);
+        d_numQueues                = bsl::move(rhs.d_numQueues);
     }
 
     return *this;
@@ -4645,6 +4690,9 @@ void CommandLineParameters::reset()
         DEFAULT_INITIALIZER_SEQUENTIAL_MESSAGE_PATTERN;
     bdlat_ValueTypeFunctions::reset(&d_messageProperties);
     bdlat_ValueTypeFunctions::reset(&d_subscriptions);
+    d_openLoop        = DEFAULT_INITIALIZER_OPEN_LOOP;
+    d_producerThreads = DEFAULT_INITIALIZER_PRODUCER_THREADS;
+    d_numQueues       = DEFAULT_INITIALIZER_NUM_QUEUES;
 }
 
 // ACCESSORS
@@ -4682,6 +4730,9 @@ bsl::ostream& CommandLineParameters::print(bsl::ostream& stream,
                            this->sequentialMessagePattern());
     printer.printAttribute("messageProperties", this->messageProperties());
     printer.printAttribute("subscriptions", this->subscriptions());
+    printer.printAttribute("openLoop", this->openLoop());
+    printer.printAttribute("producerThreads", this->producerThreads());
+    printer.printAttribute("numQueues", this->numQueues());
     printer.end();
     return stream;
 }
@@ -4721,10 +4721,13 @@ class CommandLineParameters {
     int                          d_postInterval;
     int                          d_threads;
     int                          d_shutdownGrace;
+    int                          d_producerThreads;
+    int                          d_numQueues;
     bool                         d_dumpMsg;
     bool                         d_confirmMsg;
     bool                         d_memoryDebug;
     bool                         d_noSessionEventHandler;
+    bool                         d_openLoop;
 
   public:
     // TYPES
@@ -4753,10 +4756,13 @@ class CommandLineParameters {
         ATTRIBUTE_ID_LOG                        = 21,
         ATTRIBUTE_ID_SEQUENTIAL_MESSAGE_PATTERN = 22,
         ATTRIBUTE_ID_MESSAGE_PROPERTIES         = 23,
-        ATTRIBUTE_ID_SUBSCRIPTIONS              = 24
+        ATTRIBUTE_ID_SUBSCRIPTIONS              = 24,
+        ATTRIBUTE_ID_OPEN_LOOP                  = 25,
+        ATTRIBUTE_ID_PRODUCER_THREADS           = 26,
+        ATTRIBUTE_ID_NUM_QUEUES                 = 27
     };
 
-    enum { NUM_ATTRIBUTES = 25 };
+    enum { NUM_ATTRIBUTES = 28 };
 
     enum {
         ATTRIBUTE_INDEX_MODE                       = 0,
@@ -4783,7 +4789,10 @@ class CommandLineParameters {
         ATTRIBUTE_INDEX_LOG                        = 21,
         ATTRIBUTE_INDEX_SEQUENTIAL_MESSAGE_PATTERN = 22,
         ATTRIBUTE_INDEX_MESSAGE_PROPERTIES         = 23,
-        ATTRIBUTE_INDEX_SUBSCRIPTIONS              = 24
+        ATTRIBUTE_INDEX_SUBSCRIPTIONS              = 24,
+        ATTRIBUTE_INDEX_OPEN_LOOP                  = 25,
+        ATTRIBUTE_INDEX_PRODUCER_THREADS           = 26,
+        ATTRIBUTE_INDEX_NUM_QUEUES                 = 27
     };
 
     // CONSTANTS
@@ -4835,6 +4844,12 @@ class CommandLineParameters {
 
     static const char DEFAULT_INITIALIZER_SEQUENTIAL_MESSAGE_PATTERN[];
 
+    static const bool DEFAULT_INITIALIZER_OPEN_LOOP;
+
+    static const int DEFAULT_INITIALIZER_PRODUCER_THREADS;
+
+    static const int DEFAULT_INITIALIZER_NUM_QUEUES;
+
     static const bdlat_AttributeInfo ATTRIBUTE_INFO_ARRAY[];
 
   public:
@@ -5030,6 +5045,18 @@ class CommandLineParameters {
     /// this object.
     bsl::vector<Subscription>& subscriptions();
 
+    /// Return a reference to the modifiable "OpenLoop" attribute of this
+    /// object.
+    bool& openLoop();
+
+    /// Return a reference to the modifiable "ProducerThreads" attribute of
+    /// this object.
+    int& producerThreads();
+
+    /// Return a reference to the modifiable "NumQueues" attribute of this
+    /// object.
+    int& numQueues();
+
     // ACCESSORS
 
     /// Format this object to the specified output `stream` at the
@@ -5173,6 +5200,15 @@ class CommandLineParameters {
     /// Return a reference to the non-modifiable "Subscriptions" attribute
     /// of this object.
     const bsl::vector<Subscription>& subscriptions() const;
+
+    /// Return the value of the "OpenLoop" attribute of this object.
+    bool openLoop() const;
+
+    /// Return the value of the "ProducerThreads" attribute of this object.
+    int producerThreads() const;
+
+    /// Return the value of the "NumQueues" attribute of this object.
+    int numQueues() const;
 };
 
 // FREE OPERATORS
@@ -9640,6 +9676,24 @@ int CommandLineParameters::manipulateAttributes(MANIPULATOR& manipulator)
         return ret;
     }
 
+    ret = manipulator(&d_openLoop,
+                      ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_OPEN_LOOP]);
+    if (ret) {
+        return ret;
+    }
+
+    ret = manipulator(&d_producerThreads,
+                      ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_PRODUCER_THREADS]);
+    if (ret) {
+        return ret;
+    }
+
+    ret = manipulator(&d_numQueues,
+                      ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_NUM_QUEUES]);
+    if (ret) {
+        return ret;
+    }
+
     return ret;
 }
 
@@ -9757,6 +9811,19 @@ int CommandLineParameters::manipulateAttribute(MANIPULATOR& manipulator,
             &d_subscriptions,
             ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_SUBSCRIPTIONS]);
     }
+    case ATTRIBUTE_ID_OPEN_LOOP: {
+        return manipulator(&d_openLoop,
+                           ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_OPEN_LOOP]);
+    }
+    case ATTRIBUTE_ID_PRODUCER_THREADS: {
+        return manipulator(
+            &d_producerThreads,
+            ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_PRODUCER_THREADS]);
+    }
+    case ATTRIBUTE_ID_NUM_QUEUES: {
+        return manipulator(&d_numQueues,
+                           ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_NUM_QUEUES]);
+    }
     default: return NOT_FOUND;
     }
 }
@@ -9902,6 +9969,21 @@ inline bsl::vector<Subscription>& CommandLineParameters::subscriptions()
     return d_subscriptions;
 }
 
+inline bool& CommandLineParameters::openLoop()
+{
+    return d_openLoop;
+}
+
+inline int& CommandLineParameters::producerThreads()
+{
+    return d_producerThreads;
+}
+
+inline int& CommandLineParameters::numQueues()
+{
+    return d_numQueues;
+}
+
 // ACCESSORS
 template <class ACCESSOR>
 int CommandLineParameters::accessAttributes(ACCESSOR& accessor) const
@@ -10052,6 +10134,24 @@ int CommandLineParameters::accessAttributes(ACCESSOR& accessor) const
         return ret;
     }
 
+    ret = accessor(d_openLoop,
+                   ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_OPEN_LOOP]);
+    if (ret) {
+        return ret;
+    }
+
+    ret = accessor(d_producerThreads,
+                   ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_PRODUCER_THREADS]);
+    if (ret) {
+        return ret;
+    }
+
+    ret = accessor(d_numQueues,
+                   ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_NUM_QUEUES]);
+    if (ret) {
+        return ret;
+    }
+
     return ret;
 }
 
@@ -10162,6 +10262,19 @@ int CommandLineParameters::accessAttribute(ACCESSOR& accessor, int id) const
         return accessor(d_subscriptions,
                         ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_SUBSCRIPTIONS]);
     }
+    case ATTRIBUTE_ID_OPEN_LOOP: {
+        return accessor(d_openLoop,
+                        ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_OPEN_LOOP]);
+    }
+    case ATTRIBUTE_ID_PRODUCER_THREADS: {
+        return accessor(
+            d_producerThreads,
+            ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_PRODUCER_THREADS]);
+    }
+    case ATTRIBUTE_ID_NUM_QUEUES: {
+        return accessor(d_numQueues,
+                        ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_NUM_QUEUES]);
+    }
     default: return NOT_FOUND;
     }
 }
@@ -10310,6 +10423,21 @@ CommandLineParameters::subscriptions() const
     return d_subscriptions;
 }
 
+inline bool CommandLineParameters::openLoop() const
+{
+    return d_openLoop;
+}
+
+inline int CommandLineParameters::producerThreads() const
+{
+    return d_producerThreads;
+}
+
+inline int CommandLineParameters::numQueues() const
+{
+    return d_numQueues;
+}
+
 template <typename HASH_ALGORITHM>
 void hashAppend(HASH_ALGORITHM&                         hashAlg,
                 const m_bmqtool::CommandLineParameters& object)
@@ -10342,6 +10470,9 @@ void hashAppend(HASH_ALGORITHM&                         hashAlg,
     hashAppend(hashAlg, object.sequentialMessagePattern());
     hashAppend(hashAlg, object.messageProperties());
     hashAppend(hashAlg, object.subscriptions());
+    hashAppend(hashAlg, object.openLoop());
+    hashAppend(hashAlg, object.producerThreads());
+    hashAppend(hashAlg, object.numQueues());
 }
 
 // --------------------
@@ -11657,7 +11788,10 @@ inline bool m_bmqtool::operator==(const m_bmqtool::CommandLineParameters& lhs,
            lhs.storage() == rhs.storage() && lhs.log() == rhs.log() &&
            lhs.sequentialMessagePattern() == rhs.sequentialMessagePattern() &&
            lhs.messageProperties() == rhs.messageProperties() &&
-           lhs.subscriptions() == rhs.subscriptions();
+           lhs.subscriptions() == rhs.subscriptions() &&
+           lhs.openLoop() == rhs.openLoop() &&
+           lhs.producerThreads() == rhs.producerThreads() &&
+           lhs.numQueues() == rhs.numQueues();
 }
 
 inline bool m_bmqtool::operator!=(const m_bmqtool::CommandLineParameters& lhs,
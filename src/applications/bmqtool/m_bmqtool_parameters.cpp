@@ -291,6 +291,9 @@ Parameters::print(bsl::ostream& stream, int level, int spacesPerLevel) const
     printer.printAttribute("msgSize", msgSize());
     printer.printAttribute("postRate", postRate());
     printer.printAttribute("postInterval", postInterval());
+    printer.printAttribute("openLoop", openLoop());
+    printer.printAttribute("numProducerThreads", numProducerThreads());
+    printer.printAttribute("numQueues", numQueues());
     printer.printAttribute("eventsCount", eventsCount());
     printer.printAttribute("maxUnconfirmedMsgs", maxUnconfirmedMsgs());
     printer.printAttribute("maxUnconfirmedBytes", maxUnconfirmedBytes());
@@ -393,6 +396,9 @@ bool Parameters::from(bsl::ostream&                stream,
     setMsgSize(params.msgSize());
     setPostInterval(params.postInterval());
     setPostRate(params.postRate());
+    setOpenLoop(params.openLoop());
+    setNumProducerThreads(params.producerThreads());
+    setNumQueues(params.numQueues());
     setEventsCount(eventsCount);
     setEventSize(params.eventSize());
     setMaxUnconfirmedMsgs(maxUnconfirmedMsgs);
@@ -433,6 +439,15 @@ bool Parameters::validate(bsl::string* error)
         ss << "NoSessionEventHandler is only to use in interactive or storage "
            << "mode\n";
     }
+    if (d_numProducerThreads < 1) {
+        ss << "The number of producer threads must be at least 1\n";
+    }
+    if (d_numQueues < 1) {
+        ss << "The number of queues must be at least 1\n";
+    }
+    if (d_openLoop && (d_postInterval <= 0 || d_postRate <= 0)) {
+        ss << "Open loop requires a positive postInterval and postRate\n";
+    }
 
     error->assign(ss.str().data(), ss.str().length());
     return error->empty();
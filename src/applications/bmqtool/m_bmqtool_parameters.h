@@ -226,6 +226,25 @@ class Parameters {
     // Interval to publish events (in ms)
     // Default: 1000
 
+    bool d_openLoop;
+    // Post at a constant rate, independent of
+    // the time taken by each post, and stamp
+    // each message with the time it was meant
+    // to be posted at rather than the time it
+    // actually was
+    // Default: false
+
+    int d_numProducerThreads;
+    // Number of threads posting, each at the
+    // rate given by 'd_postRate' and
+    // 'd_postInterval'
+    // Default: 1
+
+    int d_numQueues;
+    // Number of queues to open, named after
+    // 'd_queueUri' when more than one
+    // Default: 1
+
     int d_eventsCount;
     // if >= 0, number of events to post (in
     // producer mode) before stopping to produce;
@@ -287,6 +306,9 @@ class Parameters {
     Parameters& setMsgSize(int value);
     Parameters& setPostRate(int value);
     Parameters& setPostInterval(int value);
+    Parameters& setOpenLoop(bool value);
+    Parameters& setNumProducerThreads(int value);
+    Parameters& setNumQueues(int value);
     Parameters& setEventsCount(int value);
     Parameters& setMaxUnconfirmedMsgs(int value);
     Parameters& setMaxUnconfirmedBytes(int value);
@@ -348,6 +370,9 @@ class Parameters {
     int                                 msgSize() const;
     int                                 postRate() const;
     int                                 postInterval() const;
+    bool                                openLoop() const;
+    int                                 numProducerThreads() const;
+    int                                 numQueues() const;
     int                                 eventsCount() const;
     int                                 maxUnconfirmedMsgs() const;
     int                                 maxUnconfirmedBytes() const;
@@ -447,6 +472,24 @@ inline Parameters& Parameters::setPostInterval(int value)
     return *this;
 }
 
+inline Parameters& Parameters::setOpenLoop(bool value)
+{
+    d_openLoop = value;
+    return *this;
+}
+
+inline Parameters& Parameters::setNumProducerThreads(int value)
+{
+    d_numProducerThreads = value;
+    return *this;
+}
+
+inline Parameters& Parameters::setNumQueues(int value)
+{
+    d_numQueues = value;
+    return *this;
+}
+
 inline Parameters& Parameters::setEventsCount(int value)
 {
     d_eventsCount = value;
@@ -649,6 +692,21 @@ inline int Parameters::postInterval() const
     return d_postInterval;
 }
 
+inline bool Parameters::openLoop() const
+{
+    return d_openLoop;
+}
+
+inline int Parameters::numProducerThreads() const
+{
+    return d_numProducerThreads;
+}
+
+inline int Parameters::numQueues() const
+{
+    return d_numQueues;
+}
+
 inline int Parameters::eventsCount() const
 {
     return d_eventsCount;
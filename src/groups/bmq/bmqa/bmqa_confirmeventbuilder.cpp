@@ -18,8 +18,12 @@
 
 #include <bmqscm_version.h>
 // BMQ
+#include <bmqa_messageevent.h>
+#include <bmqimp_event.h>
 #include <bmqimp_queue.h>
 #include <bmqp_confirmeventbuilder.h>
+#include <bmqp_event.h>
+#include <bmqp_pushmessageiterator.h>
 
 // BDE
 #include <bsl_memory.h>
@@ -86,6 +90,88 @@ bmqt::EventBuilderResult::Enum ConfirmEventBuilder::addMessageConfirmation(
                                              cookie.messageGUID());
 }
 
+bmqt::EventBuilderResult::Enum ConfirmEventBuilder::addMessageConfirmations(
+    int*                                          numAppended,
+    const bsl::vector<MessageConfirmationCookie>& cookies)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT(d_impl.d_builder_p);
+    BSLS_ASSERT(numAppended);
+
+    *numAppended = 0;
+
+    const int initialCount = d_impl.d_builder_p->messageCount();
+    for (bsl::vector<MessageConfirmationCookie>::const_iterator cit =
+             cookies.begin();
+         cit != cookies.end();
+         ++cit) {
+        const bmqt::EventBuilderResult::Enum rc = addMessageConfirmation(
+            *cit);
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                rc != bmqt::EventBuilderResult::e_SUCCESS)) {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+            // Roll back the messages appended by this call.
+            d_impl.d_builder_p->truncate(initialCount);
+            return rc;  // RETURN
+        }
+    }
+
+    *numAppended = static_cast<int>(cookies.size());
+    return bmqt::EventBuilderResult::e_SUCCESS;
+}
+
+bmqt::EventBuilderResult::Enum
+ConfirmEventBuilder::addMessageConfirmations(const MessageEvent& event)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT(d_impl.d_builder_p);
+    BSLS_ASSERT(event.type() == bmqt::MessageEventType::e_PUSH);
+
+    const bsl::shared_ptr<bmqimp::Event>& eventSpRef =
+        reinterpret_cast<const bsl::shared_ptr<bmqimp::Event>&>(event);
+
+    // Ensure the whole event fits in the batch, so that the builder is left
+    // untouched if it doesn't.
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+            d_impl.d_builder_p->messageCount() +
+                eventSpRef->numCorrrelationIds() >
+            d_impl.d_builder_p->maxMessageCount())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return bmqt::EventBuilderResult::e_EVENT_TOO_BIG;  // RETURN
+    }
+
+    eventSpRef->resetIterators();
+    bmqp::PushMessageIterator* pushIt = eventSpRef->pushMessageIterator();
+
+    const int initialCount = d_impl.d_builder_p->messageCount();
+
+    while (pushIt->next() == 1) {
+        const bsl::shared_ptr<bmqimp::Queue> queue = eventSpRef->lookupQueue();
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!queue ||
+                                                  !queue->isOpened() ||
+                                                  queue->atMostOnce())) {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+            continue;  // CONTINUE
+        }
+
+        const bmqt::EventBuilderResult::Enum rc =
+            d_impl.d_builder_p->appendMessage(queue->id(),
+                                              queue->subQueueId(),
+                                              pushIt->header().messageGUID());
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                rc != bmqt::EventBuilderResult::e_SUCCESS)) {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+            // Roll back the messages appended by this call.
+            d_impl.d_builder_p->truncate(initialCount);
+            return rc;  // RETURN
+        }
+    }
+
+    return bmqt::EventBuilderResult::e_SUCCESS;
+}
+
 // ACCESSORS
 int ConfirmEventBuilder::messageCount() const
 {
@@ -89,6 +89,39 @@
 //       // will also reset the 'builder'.
 //..
 //
+/// Example 2 - Batch Confirmation
+///------------------------------
+// High-rate consumers which process all the messages of a 'MessageEvent' (or
+// a batch of cookies accumulated across events) before confirming them can
+// append all the corresponding CONFIRM messages in one call, instead of
+// invoking 'addMessageConfirmation' once per message.
+//..
+//   // Assuming that a 'bmqa::MessageEvent' of type PUSH is received, and all
+//   // of its messages have been processed.
+//
+//   bmqt::EventBuilderResult::Enum rc = builder.addMessageConfirmations(
+//                                                               messageEvent);
+//   if (rc == bmqt::EventBuilderResult::e_EVENT_TOO_BIG) {
+//       // Not enough room left in the batch for all the messages of the
+//       // event: send what has been built so far, and try again.
+//       // Error handling elided.
+//   }
+//
+//   // Alternatively, cookies may have been accumulated, for example by
+//   // worker threads which processed the messages asynchronously.
+//
+//   bsl::vector<bmqa::MessageConfirmationCookie> cookies;
+//       // Populating 'cookies' elided.
+//
+//   int numAppended = 0;
+//   rc = builder.addMessageConfirmations(&numAppended, cookies);
+//       // Error handling elided.  Upon failure, none of the cookies have
+//       // been appended to the builder.
+//
+//   int sendRc = session.confirmMessages(&builder);
+//       // Error handling elided.
+//..
+//
 /// Thread Safety
 ///-------------
 // This component is *NOT* thread safe.  If it is desired to create a batch of
@@ -102,6 +135,7 @@
 
 // BDE
 #include <bdlbb_blob.h>
+#include <bsl_vector.h>
 #include <bsls_alignedbuffer.h>
 
 namespace BloombergLP {
@@ -113,6 +147,9 @@ class ConfirmEventBuilder;
 
 namespace bmqa {
 
+// FORWARD DECLARATION
+class MessageEvent;
+
 // ==============================
 // struct ConfirmEventBuilderImpl
 // ==============================
@@ -190,6 +227,38 @@ class ConfirmEventBuilder {
     bmqt::EventBuilderResult::Enum
     addMessageConfirmation(const MessageConfirmationCookie& cookie);
 
+    /// Append a confirmation message for each of the specified `cookies`,
+    /// in order.  Load into the specified `numAppended` the number of
+    /// confirmation messages appended by this call, i.e. `cookies.size()`
+    /// on success and 0 on failure.  Return zero if all cookies were
+    /// appended, and the non-zero result of the first cookie which failed
+    /// to be appended otherwise, in which case this builder is left
+    /// unmodified.  Note that if `bmqt::EventBuilderResult::e_EVENT_TOO_BIG`
+    /// is returned, the batch built so far should be sent using
+    /// `bmqa::Session::confirmMessages` before appending `cookies` again.
+    /// Behavior is undefined unless this instance was obtained using
+    /// `bmqa::Session::loadConfirmEventBuilder`.
+    bmqt::EventBuilderResult::Enum addMessageConfirmations(
+        int*                                          numAppended,
+        const bsl::vector<MessageConfirmationCookie>& cookies);
+
+    /// Append a confirmation message for each of the messages contained in
+    /// the specified `event`.  Return zero on success, and a non-zero value
+    /// otherwise, in which case this builder is left unmodified.  If the
+    /// batch under construction does not have enough room left for all of
+    /// the messages in `event`, return
+    /// `bmqt::EventBuilderResult::e_EVENT_TOO_BIG`.  This is more efficient
+    /// than iterating over `event` and appending each message individually,
+    /// since no `bmqa::Message` nor `bmqa::MessageConfirmationCookie` is
+    /// created per message.  Note that
+    /// this invalidates (resets) any `MessageIterator` previously obtained
+    /// from `event`, and that messages of queues which are no longer opened
+    /// are skipped.  Behavior is undefined unless this instance was
+    /// obtained using `bmqa::Session::loadConfirmEventBuilder` and
+    /// `event.type()` is `bmqt::MessageEventType::e_PUSH`.
+    bmqt::EventBuilderResult::Enum
+    addMessageConfirmations(const MessageEvent& event);
+
     /// Reset the builder, effectively discarding the batch of confirmation
     /// messages under construction.
     void reset();
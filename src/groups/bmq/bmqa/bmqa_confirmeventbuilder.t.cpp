@@ -0,0 +1,302 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// bmqa_confirmeventbuilder.t.cpp                                     -*-C++-*-
+#include <bmqa_confirmeventbuilder.h>
+
+// BMQ
+#include <bmqa_message.h>
+#include <bmqa_messageevent.h>
+#include <bmqa_messageproperties.h>
+#include <bmqa_mocksession.h>
+#include <bmqa_queueid.h>
+#include <bmqimp_queue.h>
+#include <bmqp_protocol.h>
+#include <bmqt_correlationid.h>
+#include <bmqt_messageguid.h>
+#include <bmqt_resultcode.h>
+#include <bmqt_sessionoptions.h>
+
+// BDE
+#include <bdlbb_blob.h>
+#include <bdlbb_blobutil.h>
+#include <bdlbb_pooledblobbufferfactory.h>
+#include <bsl_memory.h>
+#include <bsl_vector.h>
+
+// TEST DRIVER
+#include <mwctst_testhelper.h>
+
+// CONVENIENCE
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                            TEST HELPERS UTILITY
+// ----------------------------------------------------------------------------
+namespace {
+
+typedef bsl::shared_ptr<bmqimp::Queue>& QueueImplPtr;
+
+/// Return the maximum number of CONFIRM messages of an event, computed
+/// independently from the builder.
+int maxMessageCount()
+{
+    return static_cast<int>((bmqp::EventHeader::k_MAX_SIZE_SOFT -
+                             sizeof(bmqp::EventHeader) -
+                             sizeof(bmqp::ConfirmHeader)) /
+                            sizeof(bmqp::ConfirmMessage));
+}
+
+/// Return a GUID unique to the specified `id`.
+bmqt::MessageGUID makeGUID(int id)
+{
+    unsigned char buffer[bmqt::MessageGUID::e_SIZE_BINARY] = {};
+    buffer[0] = static_cast<unsigned char>(id >> 8);
+    buffer[1] = static_cast<unsigned char>(id);
+
+    bmqt::MessageGUID guid;
+    guid.fromBinary(buffer);
+    return guid;
+}
+
+/// Mark the queue of the specified `queueId` as opened under the specified
+/// `id`.
+void openQueue(bmqa::QueueId* queueId, int id)
+{
+    QueueImplPtr implPtr = reinterpret_cast<QueueImplPtr>(*queueId);
+    implPtr->setState(bmqimp::QueueState::e_OPENED);
+    implPtr->setId(id);
+}
+
+/// Append to the specified `builder` the specified `numMessages` CONFIRM
+/// messages for the specified `queueId`.
+void fillBuilder(bmqa::ConfirmEventBuilder* builder,
+                 const bmqa::QueueId&       queueId,
+                 int                        numMessages)
+{
+    for (int i = 0; i < numMessages; ++i) {
+        const bmqt::EventBuilderResult::Enum rc =
+            builder->addMessageConfirmation(
+                bmqa::MessageConfirmationCookie(queueId, makeGUID(i)));
+        ASSERT_EQ_D(i, rc, bmqt::EventBuilderResult::e_SUCCESS);
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                                    TESTS
+// ----------------------------------------------------------------------------
+
+static void test1_breathingTest()
+{
+    s_ignoreCheckDefAlloc = true;
+    // Can't ensure no default memory is allocated because a default
+    // QueueId is instantiated and that uses the default allocator to
+    // allocate memory for an automatically generated CorrelationId.
+
+    mwctst::TestHelper::printTestName("BREATHING TEST");
+
+    bmqa::MockSession mockSession(bmqt::SessionOptions(s_allocator_p),
+                                  s_allocator_p);
+
+    bmqa::ConfirmEventBuilder obj;
+    mockSession.loadConfirmEventBuilder(&obj);
+    ASSERT_EQ(obj.messageCount(), 0);
+    ASSERT_EQ(obj.blob().length(), 0);
+}
+
+static void test2_addMessageConfirmations()
+// ------------------------------------------------------------------------
+// ADD MESSAGE CONFIRMATIONS
+//
+// Concerns:
+//   - All the cookies are appended on success.
+//   - If any cookie fails to be appended, the builder is left unmodified,
+//     whether the failure is due to an invalid queue or to the event being
+//     full, and even if some cookies were appended before the failure.
+//
+// Testing:
+//   addMessageConfirmations(int *, const bsl::vector<Cookie>&)
+// ------------------------------------------------------------------------
+{
+    s_ignoreCheckDefAlloc = true;
+    // Can't ensure no default memory is allocated because a default
+    // QueueId is instantiated and that uses the default allocator to
+    // allocate memory for an automatically generated CorrelationId.
+
+    mwctst::TestHelper::printTestName("ADD MESSAGE CONFIRMATIONS");
+
+    bmqa::MockSession mockSession(bmqt::SessionOptions(s_allocator_p),
+                                  s_allocator_p);
+
+    bmqa::QueueId openedQueueId(bmqt::CorrelationId(1), s_allocator_p);
+    bmqa::QueueId closedQueueId(bmqt::CorrelationId(2), s_allocator_p);
+    openQueue(&openedQueueId, 1);
+
+    bmqa::ConfirmEventBuilder obj;
+    mockSession.loadConfirmEventBuilder(&obj);
+
+    bsl::vector<bmqa::MessageConfirmationCookie> cookies(s_allocator_p);
+    for (int i = 0; i < 3; ++i) {
+        cookies.push_back(
+            bmqa::MessageConfirmationCookie(openedQueueId, makeGUID(i)));
+    }
+
+    {
+        PV("Success");
+
+        int numAppended = -1;
+        ASSERT_EQ(obj.addMessageConfirmations(&numAppended, cookies),
+                  bmqt::EventBuilderResult::e_SUCCESS);
+        ASSERT_EQ(numAppended, 3);
+        ASSERT_EQ(obj.messageCount(), 3);
+    }
+
+    {
+        PV("Rollback on invalid queue");
+
+        const int previousLength = obj.blob().length();
+
+        bsl::vector<bmqa::MessageConfirmationCookie> invalidCookies(
+            cookies,
+            s_allocator_p);
+        invalidCookies.push_back(
+            bmqa::MessageConfirmationCookie(closedQueueId, makeGUID(3)));
+
+        int numAppended = -1;
+        ASSERT_EQ(obj.addMessageConfirmations(&numAppended, invalidCookies),
+                  bmqt::EventBuilderResult::e_QUEUE_INVALID);
+        ASSERT_EQ(numAppended, 0);
+        ASSERT_EQ(obj.messageCount(), 3);
+        ASSERT_EQ(obj.blob().length(), previousLength);
+    }
+
+    {
+        PV("Rollback on full event");
+
+        obj.reset();
+        fillBuilder(&obj, openedQueueId, maxMessageCount() - 2);
+
+        const int previousLength = obj.blob().length();
+
+        int numAppended = -1;
+        ASSERT_EQ(obj.addMessageConfirmations(&numAppended, cookies),
+                  bmqt::EventBuilderResult::e_EVENT_TOO_BIG);
+        ASSERT_EQ(numAppended, 0);
+        ASSERT_EQ(obj.messageCount(), maxMessageCount() - 2);
+        ASSERT_EQ(obj.blob().length(), previousLength);
+
+        cookies.pop_back();
+        ASSERT_EQ(obj.addMessageConfirmations(&numAppended, cookies),
+                  bmqt::EventBuilderResult::e_SUCCESS);
+        ASSERT_EQ(numAppended, 2);
+        ASSERT_EQ(obj.messageCount(), maxMessageCount());
+    }
+}
+
+static void test3_addMessageConfirmationsFromEvent()
+// ------------------------------------------------------------------------
+// ADD MESSAGE CONFIRMATIONS FROM EVENT
+//
+// Concerns:
+//   - All the messages of the event are appended on success.
+//   - If the event does not fit in the batch, the builder is left
+//     unmodified.
+//
+// Testing:
+//   addMessageConfirmations(const MessageEvent&)
+// ------------------------------------------------------------------------
+{
+    s_ignoreCheckDefAlloc = true;
+    // Can't ensure no default memory is allocated because a default
+    // QueueId is instantiated and that uses the default allocator to
+    // allocate memory for an automatically generated CorrelationId.
+
+    mwctst::TestHelper::printTestName("ADD MESSAGE CONFIRMATIONS FROM EVENT");
+
+    bmqa::MockSession mockSession(bmqt::SessionOptions(s_allocator_p),
+                                  s_allocator_p);
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4 * 1024, s_allocator_p);
+
+    bmqa::QueueId queueId(bmqt::CorrelationId(1), s_allocator_p);
+    openQueue(&queueId, 1);
+
+    bdlbb::Blob payload(&bufferFactory, s_allocator_p);
+    bdlbb::BlobUtil::append(&payload, "hello", 6);
+
+    bmqa::MessageProperties properties;
+    mockSession.loadMessageProperties(&properties);
+
+    bsl::vector<bmqa::MockSessionUtil::PushMessageParams> pushMsgs(
+        s_allocator_p);
+    pushMsgs.emplace_back(payload, queueId, makeGUID(1), properties);
+    pushMsgs.emplace_back(payload, queueId, makeGUID(2), properties);
+
+    bmqa::MessageEvent event = bmqa::MockSessionUtil::createPushEvent(
+                                   pushMsgs,
+                                   &bufferFactory,
+                                   s_allocator_p)
+                                   .messageEvent();
+
+    bmqa::ConfirmEventBuilder obj;
+    mockSession.loadConfirmEventBuilder(&obj);
+
+    {
+        PV("Success");
+
+        ASSERT_EQ(obj.addMessageConfirmations(event),
+                  bmqt::EventBuilderResult::e_SUCCESS);
+        ASSERT_EQ(obj.messageCount(), 2);
+    }
+
+    {
+        PV("Event too big");
+
+        obj.reset();
+        fillBuilder(&obj, queueId, maxMessageCount() - 1);
+
+        const int previousLength = obj.blob().length();
+
+        ASSERT_EQ(obj.addMessageConfirmations(event),
+                  bmqt::EventBuilderResult::e_EVENT_TOO_BIG);
+        ASSERT_EQ(obj.messageCount(), maxMessageCount() - 1);
+        ASSERT_EQ(obj.blob().length(), previousLength);
+    }
+}
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    TEST_PROLOG(mwctst::TestHelper::e_DEFAULT);
+
+    switch (_testCase) {
+    case 0:
+    case 3: test3_addMessageConfirmationsFromEvent(); break;
+    case 2: test2_addMessageConfirmations(); break;
+    case 1: test1_breathingTest(); break;
+    default: {
+        cerr << "WARNING: CASE '" << _testCase << "' NOT FOUND." << endl;
+        s_testStatus = -1;
+    } break;
+    }
+
+    TEST_EPILOG(mwctst::TestHelper::e_CHECK_DEF_GBL_ALLOC);
+}
@@ -26,6 +26,8 @@
 #include <bmqp_eventutil.h>
 #include <bmqp_messageproperties.h>
 #include <bmqp_protocolutil.h>
+#include <bmqp_pushmessageiterator.h>
+#include <bmqp_putmessageiterator.h>
 #include <bmqp_queueid.h>
 #include <bmqt_resultcode.h>
 
@@ -35,6 +37,7 @@
 
 // BDE
 #include <bdlma_localsequentialallocator.h>
+#include <bsl_algorithm.h>
 #include <bsl_iostream.h>
 #include <bsl_ostream.h>
 #include <bsl_string.h>
@@ -42,6 +45,7 @@
 #include <bslma_default.h>
 #include <bslmf_assert.h>
 #include <bsls_assert.h>
+#include <bsls_performancehint.h>
 
 namespace BloombergLP {
 namespace bmqa {
@@ -60,6 +64,40 @@ BSLMF_ASSERT(Message::k_GROUP_ID_MAX_LENGTH ==
 }  // close unnamed namespace
 #endif
 
+namespace {
+
+/// Load into the specified `blob`, `position` and `length` respectively the
+/// blob holding the payload of the message currently pointed to by the
+/// specified `event`, the position of that payload in `blob`, and its
+/// length.  Return zero on success, and a non-zero value otherwise.  The
+/// behavior is undefined unless the raw event of `event` is a PUSH or a PUT
+/// event.
+int loadPayloadLocation(const bdlbb::Blob** blob,
+                        mwcu::BlobPosition* position,
+                        int*                length,
+                        bmqimp::Event*      event)
+{
+    const bmqp::Event& rawEvent = event->rawEvent();
+
+    if (rawEvent.isPushEvent()) {
+        const bmqp::PushMessageIterator* iter = event->pushMessageIterator();
+        *blob                                 = &iter->applicationData();
+        *length                               = iter->messagePayloadSize();
+        return iter->loadMessagePayloadPosition(position);  // RETURN
+    }
+    else if (rawEvent.isPutEvent()) {
+        const bmqp::PutMessageIterator* iter = event->putMessageIterator();
+        *blob                                = &iter->applicationData();
+        *length                              = iter->messagePayloadSize();
+        return iter->loadMessagePayloadPosition(position);  // RETURN
+    }
+
+    BSLS_ASSERT_OPT(false && "Invalid raw event type");
+    return -1;  // RETURN
+}
+
+}  // close unnamed namespace
+
 // CREATORS
 Message::Message()
 {
@@ -426,6 +464,114 @@ int Message::getData(bdlbb::Blob* blob) const
     }
 }
 
+int Message::getDataView(bsl::vector<bslstl::StringRef>* segments) const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(isInitialized());
+    BSLS_ASSERT_SAFE(segments);
+
+    enum RcEnum {
+        // Value for the various RC error categories
+        rc_SUCCESS      = 0,
+        rc_NO_PAYLOAD   = -1,
+        rc_INVALID_BLOB = -2
+    };
+
+    segments->clear();
+
+    const bdlbb::Blob* blob   = 0;
+    mwcu::BlobPosition position;
+    int                length = 0;
+
+    const int rc = loadPayloadLocation(&blob,
+                                       &position,
+                                       &length,
+                                       d_impl.d_event_p);
+    if (rc != 0) {
+        return rc * 10 + rc_NO_PAYLOAD;  // RETURN
+    }
+
+    int bufferIndex = position.buffer();
+    int offset      = position.byte();
+    while (length > 0) {
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(bufferIndex >=
+                                                  blob->numDataBuffers())) {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+            segments->clear();
+            return rc_INVALID_BLOB;  // RETURN
+        }
+
+        const int segmentLength = bsl::min(
+            mwcu::BlobUtil::bufferSize(*blob, bufferIndex) - offset,
+            length);
+        if (segmentLength > 0) {
+            segments->push_back(bslstl::StringRef(
+                blob->buffer(bufferIndex).data() + offset,
+                segmentLength));
+            length -= segmentLength;
+        }
+
+        ++bufferIndex;
+        offset = 0;
+    }
+
+    return rc_SUCCESS;
+}
+
+int Message::getContiguousData(bslstl::StringRef* data) const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(isInitialized());
+    BSLS_ASSERT_SAFE(data);
+
+    enum RcEnum {
+        // Value for the various RC error categories
+        rc_SUCCESS        = 0,
+        rc_NO_PAYLOAD     = -1,
+        rc_INVALID_BLOB   = -2,
+        rc_NOT_CONTIGUOUS = -3
+    };
+
+    const bdlbb::Blob* blob   = 0;
+    mwcu::BlobPosition position;
+    int                length = 0;
+
+    const int rc = loadPayloadLocation(&blob,
+                                       &position,
+                                       &length,
+                                       d_impl.d_event_p);
+    if (rc != 0) {
+        return rc * 10 + rc_NO_PAYLOAD;  // RETURN
+    }
+
+    if (length == 0) {
+        data->reset();
+        return rc_SUCCESS;  // RETURN
+    }
+
+    int bufferIndex = position.buffer();
+    int offset      = position.byte();
+    if (bufferIndex < blob->numDataBuffers() &&
+        offset == mwcu::BlobUtil::bufferSize(*blob, bufferIndex)) {
+        // Payload starts at the beginning of the next buffer.
+        ++bufferIndex;
+        offset = 0;
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(bufferIndex >=
+                                              blob->numDataBuffers())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return rc_INVALID_BLOB;  // RETURN
+    }
+
+    if (mwcu::BlobUtil::bufferSize(*blob, bufferIndex) - offset < length) {
+        return rc_NOT_CONTIGUOUS;  // RETURN
+    }
+
+    data->assign(blob->buffer(bufferIndex).data() + offset, length);
+    return rc_SUCCESS;
+}
+
 int Message::dataSize() const
 {
     // PRECONDITIONS
@@ -72,6 +72,7 @@
 #include <bsl_iosfwd.h>
 #include <bsl_memory.h>
 #include <bsl_string.h>
+#include <bsl_vector.h>
 #include <bslma_allocator.h>
 #include <bsls_annotation.h>
 
@@ -361,6 +362,33 @@ class Message {
     /// of invoking this method multiple times on a message.
     int getData(bdlbb::Blob* blob) const;
 
+    /// Load into the specified `segments` a read-only view over the payload
+    /// of the message, if any, as the ordered sequence of contiguous memory
+    /// segments holding it.  Return zero if the message has a payload and
+    /// non-zero value otherwise.  The behaviour is undefined unless this
+    /// instance represents a `PUT` or `PUSH` message.  Unlike `getData`, no
+    /// payload byte is copied and no blob buffer is created: `segments`
+    /// point directly into the buffers of the underlying event (or into
+    /// the decompressed payload if the message was compressed).  Note that
+    /// the segments are only valid for as long as this message is valid
+    /// (i.e., until the `bmqa::MessageIterator` from which it was obtained
+    /// is advanced), and that any previous content of `segments` is
+    /// discarded.  Also note that `segments` can be reused across messages
+    /// in order to avoid any memory allocation.
+    int getDataView(bsl::vector<bslstl::StringRef>* segments) const;
+
+    /// Load into the specified `data` a read-only view over the payload of
+    /// the message if the payload is held in a single contiguous memory
+    /// segment.  Return zero on success, and a non-zero value if the
+    /// payload could not be retrieved or if it spans multiple segments (in
+    /// which case `getDataView` or `getData` should be used instead).
+    /// The behaviour is undefined unless this instance represents a `PUT`
+    /// or `PUSH` message.  Note that no copy nor memory allocation is
+    /// performed, and that `data` is only valid for as long as this message
+    /// is valid.  This is typically useful for applications parsing the
+    /// payload in place.
+    int getContiguousData(bslstl::StringRef* data) const;
+
     /// Return the number of bytes in the payload.  The behaviour is
     /// undefined unless this instance represents a `PUT` or a `PUSH`
     /// message.  Note that for efficiency, application should fetch payload
@@ -24,6 +24,8 @@
 #include <bdlbb_blobutil.h>
 #include <bdlbb_pooledblobbufferfactory.h>
 #include <bsl_memory.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
 
 // BMQ
 #include <bmqa_event.h>
@@ -32,8 +34,10 @@
 #include <bmqimp_event.h>
 #include <bmqimp_queue.h>
 #include <bmqp_ackeventbuilder.h>
+#include <bmqp_compression.h>
 #include <bmqp_crc32c.h>
 #include <bmqp_event.h>
+#include <bmqp_messageproperties.h>
 #include <bmqp_messageguidgenerator.h>
 #include <bmqp_protocol.h>
 #include <bmqp_pusheventbuilder.h>
@@ -593,6 +597,174 @@ static void test4_subscriptionHandle()
     }
 }
 
+static void test5_dataView()
+// ------------------------------------------------------------------------
+// DATA VIEW
+//
+// Concerns:
+//   1. 'getDataView' returns segments which, once concatenated, are equal
+//      to the payload returned by 'getData', whether the payload lies in
+//      one or in multiple blob buffers.
+//   2. 'getContiguousData' succeeds if, and only if, the payload lies in a
+//      single blob buffer, and returns a view equal to the payload.
+//   3. The views cover the decompressed payload of a compressed message.
+//   4. The views exclude the message properties preceding the payload,
+//      whether the payload is compressed or not.
+//
+// Testing:
+//   int getDataView(bsl::vector<bslstl::StringRef>* segments) const;
+//   int getContiguousData(bslstl::StringRef* data) const;
+// ------------------------------------------------------------------------
+{
+    s_ignoreCheckDefAlloc = true;
+    // Can't ensure no default memory is allocated because a default
+    // QueueId is instantiated and that uses the default allocator to
+    // allocate memory for an automatically generated CorrelationId.
+
+    mwctst::TestHelper::printTestName("DATA VIEW");
+
+    typedef bsl::shared_ptr<bmqimp::Event> EventImplSp;
+
+    const char*             buffer     = "abcdefghijklmnopqrstuvwxyz";
+    const int               queueId    = 4321;
+    const unsigned int      subQueueId = 1234;
+    const bmqt::MessageGUID guid;
+
+    const bmqt::CompressionAlgorithmType::Enum k_NONE =
+        bmqt::CompressionAlgorithmType::e_NONE;
+    const bmqt::CompressionAlgorithmType::Enum k_ZLIB =
+        bmqt::CompressionAlgorithmType::e_ZLIB;
+
+    struct Test {
+        int                                  d_line;
+        int                                  d_bufferSize;
+        bmqt::CompressionAlgorithmType::Enum d_compressionType;
+        bool                                 d_hasProperties;
+        bool                                 d_isContiguous;
+    } k_DATA[] = {{L_, 4 * 1024, k_NONE, false, true},
+                  {L_, 8, k_NONE, false, false},
+                  {L_, 5, k_NONE, false, false},
+                  {L_, 4 * 1024, k_ZLIB, false, true},
+                  {L_, 8, k_ZLIB, false, false},
+                  {L_, 4 * 1024, k_NONE, true, true},
+                  {L_, 8, k_NONE, true, false},
+                  {L_, 4 * 1024, k_ZLIB, true, true},
+                  {L_, 8, k_ZLIB, true, false}};
+    // Buffer sizes smaller than the payload spread it over multiple blob
+    // buffers, at offsets which are not necessarily aligned on the start of
+    // a buffer.
+
+    const size_t k_NUM_DATA = sizeof(k_DATA) / sizeof(*k_DATA);
+
+    for (size_t idx = 0; idx < k_NUM_DATA; ++idx) {
+        const Test& test = k_DATA[idx];
+
+        PVV(test.d_line << ": bufferSize = " << test.d_bufferSize
+                        << ", compressionType = " << test.d_compressionType
+                        << ", hasProperties = " << test.d_hasProperties);
+
+        bdlbb::PooledBlobBufferFactory bufferFactory(test.d_bufferSize,
+                                                     s_allocator_p);
+        bmqa::Event                    event;
+
+        EventImplSp& implPtr = reinterpret_cast<EventImplSp&>(event);
+        implPtr = bsl::make_shared<bmqimp::Event>(&bufferFactory,
+                                                  s_allocator_p);
+
+        bdlbb::Blob data(&bufferFactory, s_allocator_p);
+        bdlbb::BlobUtil::append(&data, buffer, bsl::strlen(buffer));
+
+        bdlbb::Blob                 payload(&bufferFactory, s_allocator_p);
+        bmqp::MessagePropertiesInfo propertiesInfo;
+        bmqp::PushEventBuilder      peb(&bufferFactory, s_allocator_p);
+
+        if (test.d_hasProperties) {
+            // Message properties with a schema are not compressed, and
+            // precede the (possibly compressed) data.
+            propertiesInfo = bmqp::MessagePropertiesInfo(true, 1, false);
+
+            bmqp::MessageProperties properties(s_allocator_p);
+            properties.setPropertyAsString("x", "x");
+            properties.setPropertyAsInt32("y", 1);
+            bdlbb::BlobUtil::append(
+                &payload,
+                properties.streamOut(&bufferFactory, propertiesInfo));
+
+            bmqp::Protocol::SubQueueInfosArray subQueueInfos(s_allocator_p);
+            subQueueInfos.push_back(bmqp::SubQueueInfo(subQueueId));
+            ASSERT_EQ(peb.addSubQueueInfosOption(subQueueInfos),
+                      bmqt::EventBuilderResult::e_SUCCESS);
+
+            // For the SchemaLearner
+            bsl::shared_ptr<bmqimp::Queue> queue =
+                bsl::allocate_shared<bmqimp::Queue, bslma::Allocator>(
+                    s_allocator_p);
+            queue->setId(queueId);
+            implPtr->insertQueue(subQueueId, queue);
+        }
+
+        if (test.d_compressionType == k_NONE) {
+            bdlbb::BlobUtil::append(&payload, data);
+        }
+        else {
+            bdlbb::Blob compressed(&bufferFactory, s_allocator_p);
+            ASSERT_EQ(0,
+                      bmqp::Compression::compress(&compressed,
+                                                  &bufferFactory,
+                                                  test.d_compressionType,
+                                                  data,
+                                                  0,
+                                                  s_allocator_p));
+            bdlbb::BlobUtil::append(&payload, compressed);
+        }
+
+        bmqt::EventBuilderResult::Enum rc = peb.packMessage(
+            payload,
+            queueId,
+            guid,
+            0,  // flags
+            test.d_compressionType,
+            propertiesInfo);
+        ASSERT_EQ(rc, bmqt::EventBuilderResult::e_SUCCESS);
+
+        bmqp::Event bmqpEvent(&peb.blob(), s_allocator_p, true);
+        implPtr->configureAsMessageEvent(bmqpEvent);
+        implPtr->addCorrelationId(bmqt::CorrelationId());
+
+        bmqa::MessageEvent    pushMsgEvt = event.messageEvent();
+        bmqa::MessageIterator mIter      = pushMsgEvt.messageIterator();
+        ASSERT(mIter.nextMessage());
+        const bmqa::Message& message = mIter.message();
+
+        bdlbb::Blob received(&bufferFactory, s_allocator_p);
+        ASSERT_EQ(0, message.getData(&received));
+        ASSERT_EQ(0, bdlbb::BlobUtil::compare(received, data));
+
+        bsl::vector<bslstl::StringRef> segments(s_allocator_p);
+        ASSERT_EQ(0, message.getDataView(&segments));
+        ASSERT_EQ_D(test.d_line,
+                    test.d_isContiguous,
+                    segments.size() == 1U);
+
+        bsl::string viewed(s_allocator_p);
+        for (size_t i = 0; i < segments.size(); ++i) {
+            ASSERT_NE_D(test.d_line << ", segment " << i,
+                        0U,
+                        segments[i].length());
+            viewed.append(segments[i].data(), segments[i].length());
+        }
+        ASSERT_EQ_D(test.d_line, viewed, bsl::string(buffer, s_allocator_p));
+
+        bslstl::StringRef contiguous;
+        const int         contiguousRc = message.getContiguousData(
+            &contiguous);
+        ASSERT_EQ_D(test.d_line, test.d_isContiguous, contiguousRc == 0);
+        if (test.d_isContiguous) {
+            ASSERT_EQ_D(test.d_line, contiguous, bslstl::StringRef(buffer));
+        }
+    }
+}
+
 // ============================================================================
 //                                 MAIN PROGRAM
 // ----------------------------------------------------------------------------
@@ -607,6 +779,7 @@ int main(int argc, char* argv[])
     case 2: test2_validPushMessagePrint(); break;
     case 3: test3_messageProperties(); break;
     case 4: test4_subscriptionHandle(); break;
+    case 5: test5_dataView(); break;
     default: {
         cerr << "WARNING: CASE '" << _testCase << "' NOT FOUND." << endl;
         s_testStatus = -1;
@@ -206,6 +206,14 @@ struct SessionUtil {
         const bsl::shared_ptr<bmqimp::Event>& eventImpl,
         const CALLBACK&                       callback);
 
+    /// Invoked from the thread processing user events when all the
+    /// messages of an event posted with a completion callback have been
+    /// acknowledged, this method wraps the specified `eventImpl` ACK event
+    /// into a `MessageEvent` and invokes the specified `callback` with it.
+    static void
+    postCallbackWrapper(const bsl::shared_ptr<bmqimp::Event>& eventImpl,
+                        const Session::PostCallback&          callback);
+
     static bmqt::OpenQueueResult::Enum
     validateAndSetOpenQueueParameters(mwcu::MemOutStream* errorDescription,
                                       QueueId*            queueId,
@@ -259,7 +267,11 @@ int SessionUtil::createApplication(SessionImpl* sessionImpl)
         .append(";")
         .append(bmqp::MessagePropertiesFeatures::k_FIELD_NAME)
         .append(":")
-        .append(bmqp::MessagePropertiesFeatures::k_MESSAGE_PROPERTIES_EX);
+        .append(bmqp::MessagePropertiesFeatures::k_MESSAGE_PROPERTIES_EX)
+        .append(";")
+        .append(bmqp::AckFeatures::k_FIELD_NAME)
+        .append(":")
+        .append(bmqp::AckFeatures::k_CUMULATIVE);
 
     ci.protocolVersion() = bmqp::Protocol::k_VERSION;
     ci.sdkVersion()      = bmqscm::Version::versionAsInt();
@@ -425,6 +437,21 @@ void SessionUtil::operationResultSyncWrapper(
                                        OPERATION_RESULT_ENUM>(result, event);
 }
 
+void SessionUtil::postCallbackWrapper(
+    const bsl::shared_ptr<bmqimp::Event>& eventImpl,
+    const Session::PostCallback&          callback)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(eventImpl->type() == bmqimp::Event::EventType::e_MESSAGE);
+
+    MessageEvent                    event;
+    bsl::shared_ptr<bmqimp::Event>& implRef =
+        reinterpret_cast<bsl::shared_ptr<bmqimp::Event>&>(event);
+    implRef = eventImpl;
+
+    callback(event);
+}
+
 template <typename OPERATION_RESULT_TYPE,
           typename OPERATION_RESULT_ENUM,
           typename CALLBACK>
@@ -1510,6 +1537,35 @@ int Session::post(const MessageEvent& event)
         bsls::TimeInterval(k_CHANNEL_WRITE_TIMEOUT));
 }
 
+int Session::post(const MessageEvent& event, const PostCallback& callback)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT(callback && "non-empty 'callback' must be specified");
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+            !d_impl.d_application_mp ||
+            !d_impl.d_application_mp->isStarted())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return bmqt::GenericResult::e_NOT_CONNECTED;  // RETURN
+    }
+
+    const bsl::shared_ptr<bmqimp::Event>& eventSpRef =
+        reinterpret_cast<const bsl::shared_ptr<bmqimp::Event>&>(event);
+
+    BSLS_ASSERT_SAFE(0 != eventSpRef.get());
+
+    // Wrap the user-specified callback
+    const bmqimp::BrokerSession::EventCallback eventCallback =
+        bdlf::BindUtil::bind(&SessionUtil::postCallbackWrapper,
+                             bdlf::PlaceHolders::_1,  // eventImpl
+                             callback);
+
+    return d_impl.d_application_mp->brokerSession().post(
+        *(eventSpRef->rawEvent().blob()),
+        bsls::TimeInterval(k_CHANNEL_WRITE_TIMEOUT),
+        eventCallback);
+}
+
 int Session::confirmMessage(const MessageConfirmationCookie& cookie)
 {
     // Check there is a connection with broker. Return error if there is no
@@ -467,6 +467,29 @@
 //  // ... post more messages
 //..
 //
+// An event can also be posted along with a completion callback, which is
+// invoked once every message of the event requesting an acknowledgement
+// (i.e., packed with a correlationId) has been ACKed or NACKed.  The callback
+// receives a single ACK 'MessageEvent' aggregating the acknowledgements of
+// the posted messages, and those acknowledgements are *not* delivered to the
+// 'EventHandler' or 'nextEvent'.  This allows an application to pipeline
+// many posts without waiting on each of them, and to correlate completions
+// per event rather than per message.  The callback is executed by the thread
+// processing the events of the session (see the table below).
+//..
+//  void onPostCompleted(const bmqa::MessageEvent& ackEvent)
+//  {
+//      bmqa::MessageIterator it = ackEvent.messageIterator();
+//      while (it.nextMessage()) {
+//          if (it.message().ackStatus() != bmqt::AckResult::e_SUCCESS) {
+//              // ... handle the failure
+//          }
+//      }
+//  }
+//
+//  rc = session.post(builder.messageEvent(), &onPostCompleted);
+//..
+//
 /// Closing queues
 ///--------------
 // After an application no longer needs to produce or consume messages from a
@@ -516,6 +539,7 @@
 
 // BDE
 #include <ball_log.h>
+#include <bsl_functional.h>
 #include <bsl_memory.h>
 #include <bsl_string.h>
 #include <bslma_allocator.h>
@@ -649,6 +673,14 @@ class Session : public AbstractSession {
     /// providing the result and context of the requested operation.
     typedef AbstractSession::CloseQueueCallback CloseQueueCallback;
 
+    /// Invoked once all the messages of an event posted with a completion
+    /// callback have been acknowledged, `PostCallback` is an alias for a
+    /// callback function object (functor) that takes as an argument the
+    /// specified `ackEvent`, an ACK message event containing the
+    /// acknowledgements of all the messages of the posted event which
+    /// requested one.
+    typedef bsl::function<void(const MessageEvent& ackEvent)> PostCallback;
+
   private:
     // CLASS-SCOPE CATEGORY
     BALL_LOG_SET_CLASS_CATEGORY("BMQA.SESSION");
@@ -1049,6 +1081,20 @@ class Session : public AbstractSession {
     /// The behavior is undefined unless the session was started.
     int post(const MessageEvent& event) BSLS_KEYWORD_OVERRIDE;
 
+    /// Asynchronously post the specified `event` that must contain one or
+    /// more `Messages`, at least one of which requested an acknowledgement,
+    /// and invoke the specified `callback` with a single ACK event once all
+    /// such messages have been ACKed or NACKed (either by the broker, or
+    /// locally by the SDK, for example upon closing the queue).  The
+    /// acknowledgements delivered to `callback` are not delivered to the
+    /// event handler or through `nextEvent`.  The return value is one of
+    /// the values defined in the `bmqt::PostResult::Enum` enum; `callback`
+    /// is invoked only if zero is returned.  The `callback` is executed by
+    /// the event handler thread, or the thread calling `nextEvent`.  The
+    /// behavior is undefined unless the session was started.  Note that
+    /// this method is not part of the `AbstractSession` protocol.
+    int post(const MessageEvent& event, const PostCallback& callback);
+
     /// Asynchronously confirm the receipt of the specified `message`.  This
     /// indicates that the application is done processing the message and
     /// that the broker can safely discard it from the queue according to
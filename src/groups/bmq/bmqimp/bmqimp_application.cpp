@@ -19,6 +19,7 @@
 #include <bmqscm_version.h>
 // BMQ
 #include <bmqp_crc32c.h>
+#include <bmqp_messagetrace.h>
 #include <bmqp_protocolutil.h>
 #include <bmqt_resultcode.h>
 #include <bmqt_uri.h>
@@ -435,6 +436,13 @@ void Application::snapshotStats()
     // (and by the *MAIN* thread (in destructor))
 
     d_rootStatContext.snapshot();
+
+    // Drain the message traces at every snapshot rather than at every dump,
+    // so that they get exported before being overwritten in the buffer.
+    if (bmqp::MessageTraceUtil::samplingPeriod() != 0) {
+        d_messageTraceCollector.collect();
+    }
+
     if (d_nextStatDump > 0 && --d_nextStatDump == 0) {
         // NOTE: This is subject to the scheduler issue where it will try to
         //       catch-up after falling behind.
@@ -491,6 +499,12 @@ void Application::printStats(bool isFinal)
         mwcu::TableUtil::printTable(os, d_channelsTip);
     }
 
+    if (bmqp::MessageTraceUtil::samplingPeriod() != 0) {
+        os << "::::: Message Traces >>";
+        d_messageTraceCollector.collect();
+        d_messageTraceCollector.printLatencies(os);
+    }
+
     BALL_LOG_INFO << os.str();
 
     // We don't cleanup the stat context: we deleted the
@@ -610,6 +624,7 @@ Application::Application(
 , d_statSnaphotTimerHandle()
 , d_nextStatDump(-1)
 , d_lastAllocatorSnapshot(0)
+, d_messageTraceCollector(&d_allocator)
 {
     // NOTE:
     //   o The persistent session pool must live longer than the brokerSession
@@ -642,10 +657,18 @@ Application::Application(
         bmqp::Crc32c::initialize();
     }
 
-    // UriParser and ProtocolUtil initialization/shutdown are thread-safe and
-    // refcounted
+    // UriParser, ProtocolUtil and MessageTraceUtil initialization/shutdown
+    // are thread-safe and refcounted
     bmqt::UriParser::initialize();
     bmqp::ProtocolUtil::initialize();
+    bmqp::MessageTraceUtil::initialize();
+
+    // Tracing is process-wide, so a session not configuring it does not
+    // disable the tracing enabled by another one.
+    if (d_sessionOptions.messageTraceSamplingPeriod() != 0) {
+        bmqp::MessageTraceUtil::setSamplingPeriod(
+            d_sessionOptions.messageTraceSamplingPeriod());
+    }
 
     // Start the EventScheduler.  We do this here in constructor and not in
     // 'start()', because the 'finalizeCb', which is used to perform the final
@@ -695,7 +718,9 @@ Application::~Application()
 
     d_scheduler.stop();
 
-    // ProtocolUtil::shutdown is thread-safe and ref-counted
+    // ProtocolUtil and MessageTraceUtil shutdown are thread-safe and
+    // ref-counted
+    bmqp::MessageTraceUtil::shutdown();
     bmqp::ProtocolUtil::shutdown();
     bmqt::UriParser::shutdown();
 }
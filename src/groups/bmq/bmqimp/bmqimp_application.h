@@ -40,6 +40,7 @@
 #include <bmqimp_eventqueue.h>
 #include <bmqimp_negotiatedchannelfactory.h>
 #include <bmqp_ctrlmsg_messages.h>
+#include <bmqp_messagetrace.h>
 #include <bmqt_sessionoptions.h>
 
 // MWC
@@ -154,6 +155,10 @@ class Application {
     // the snapshot was performed on the
     // Counting Allocators context
 
+    bmqp::MessageTraceCollector d_messageTraceCollector;
+    // Exporter of the message trace records,
+    // drained at every stat snapshot
+
   private:
     // PRIVATE MANIPULATORS
     void onChannelDown(const bsl::string&   peerUri,
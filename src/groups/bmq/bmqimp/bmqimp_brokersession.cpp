@@ -45,6 +45,7 @@
 #include <mwcu_memoutstream.h>
 
 // BDE
+#include <bdlbb_blobutil.h>
 #include <bdld_datum.h>
 #include <bdlf_bind.h>
 #include <bdlf_placeholder.h>
@@ -86,6 +87,10 @@ const int k_EVENTQUEUE_INITIAL_CAPACITY = 10 * 1000;
 /// Initial capacity of the FSM event queue
 const int k_FSMQUEUE_INITIAL_CAPACITY = 1000;
 
+/// Maximum cumulated size of the PUT events coalesced by the FSM thread into
+/// a single channel write.
+const int k_MAX_COALESCED_PUT_SIZE = 1024 * 1024;  // 1 MB
+
 /// RequestManager group id for non buffered requests.
 /// The request is buffered if it is kept after CHANNEL_DOWN event, and is
 /// retransmitted once the channel restores.  The non buffered requests are
@@ -225,6 +230,25 @@ void makeDeconfigure(bmqp_ctrlmsg::ControlMessage* request)
     }
 }
 
+/// List of acknowledged messages GUIDs and their correlationIds.
+typedef bsl::vector<bsl::pair<bmqt::MessageGUID, bmqt::CorrelationId> >
+    AckedItems;
+
+/// Append to the specified `ackedItems` the specified `key` and the
+/// correlationId of the specified `qac`, and set the specified `removeItem`
+/// to true.  Return false, so that the iteration is not interrupted.
+bool collectAckedItem(
+    AckedItems*                                                 ackedItems,
+    bool*                                                       removeItem,
+    const bmqt::MessageGUID&                                    key,
+    const MessageCorrelationIdContainer::QueueAndCorrelationId& qac)
+{
+    ackedItems->push_back(bsl::make_pair(key, qac.d_correlationId));
+    *removeItem = true;
+
+    return false;
+}
+
 }  // close unnamed namespace
 
 // ------------
@@ -2920,6 +2944,22 @@ void BrokerSession::QueueFsm::handleQueueResume(
     }
 }
 
+// ----------------------------------
+// struct BrokerSession::PostContext
+// ----------------------------------
+
+BrokerSession::PostContext::PostContext(
+    const EventCallback&      callback,
+    bdlbb::BlobBufferFactory* bufferFactory,
+    bslma::Allocator*         allocator)
+: d_callback(bsl::allocator_arg, allocator, callback)
+, d_numPending(0)
+, d_ackBuilder(bufferFactory, allocator)
+, d_ackEvent()
+{
+    // NOTHING
+}
+
 // ----------------------------
 // class BrokerSession_Executor
 // ----------------------------
@@ -3032,12 +3072,24 @@ void BrokerSession::fsmThreadLoop()
     BALL_LOG_INFO << "FSM thread started "
                   << "[id: " << bslmt::ThreadUtil::selfIdAsUint64() << "]";
 
+    // Event popped from the queue while coalescing PUT events, to process
+    // at the next iteration
+    bsl::shared_ptr<Event> pendingEvent;
+    bool                   hasPendingEvent = false;
+
     while (true) {
         bsl::shared_ptr<Event> event;
 
-        const int rc = d_fsmEventQueue.popFront(&event);
-        BSLS_ASSERT_SAFE(rc == 0);
-        (void)rc;
+        if (hasPendingEvent) {
+            event.swap(pendingEvent);
+            hasPendingEvent = false;
+        }
+        else {
+            const int rc = d_fsmEventQueue.popFront(&event);
+            BSLS_ASSERT_SAFE(rc == 0);
+            (void)rc;
+        }
+
         if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!event)) {  // PoisonPill
             BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
             // Drain left over events (there should be none)
@@ -3052,7 +3104,13 @@ void BrokerSession::fsmThreadLoop()
         const Event::EventType::Enum eventType = event->type();
         switch (eventType) {
         case Event::EventType::e_RAW: {
-            processRawEvent(event->rawEvent());
+            // PUT events are coalesced with the ones following them
+            if (event->rawEvent().isPutEvent()) {
+                processPutEvents(&pendingEvent, &hasPendingEvent, event);
+            }
+            else {
+                processRawEvent(event->rawEvent());
+            }
         } break;
         case Event::EventType::e_REQUEST: {
             BSLS_ASSERT_SAFE(event->eventCallback() != 0);
@@ -3239,9 +3297,6 @@ void BrokerSession::processRawEvent(const bmqp::Event& event)
     else if (event.isAckEvent()) {
         processAckEvent(event);
     }
-    else if (event.isPutEvent()) {
-        processPutEvent(event);
-    }
     else if (event.isConfirmEvent()) {
         processConfirmEvent(event);
     }
@@ -3346,25 +3401,68 @@ void BrokerSession::enableMessageRetransmission(
                                                          sentTime);
 }
 
-void BrokerSession::processPutEvent(const bmqp::Event& event)
+void BrokerSession::processPutEvents(bsl::shared_ptr<Event>*       nextEvent,
+                                     bool*                         hasNext,
+                                     const bsl::shared_ptr<Event>& putEvent)
 {
     // executed by the FSM thread
 
     BSLS_ASSERT_SAFE(d_fsmThreadChecker.inSameThread());
+    BSLS_ASSERT_SAFE(nextEvent);
+    BSLS_ASSERT_SAFE(hasNext);
+    BSLS_ASSERT_SAFE(putEvent->rawEvent().isPutEvent());
+
+    // Drain the PUT events posted concurrently by other application threads
+    // which are already enqueued, so that they are written to the channel at
+    // once.  Stop at the first event of another kind, which will be processed
+    // next to preserve the ordering.
+    d_putEventsBatch.clear();
+    d_putEventsBatch.push_back(putEvent);
+
+    int batchSize = putEvent->rawEvent().blob()->length();
+    while (batchSize < k_MAX_COALESCED_PUT_SIZE) {
+        bsl::shared_ptr<Event> event;
+        if (d_fsmEventQueue.tryPopFront(&event) != 0) {
+            break;  // BREAK
+        }
+
+        if (!event || event->type() != Event::EventType::e_RAW ||
+            !event->rawEvent().isPutEvent()) {
+            nextEvent->swap(event);
+            *hasNext = true;
+            break;  // BREAK
+        }
+
+        batchSize += event->rawEvent().blob()->length();
+        d_putEventsBatch.push_back(event);
+    }
 
     bool readyToSend = isStarted() && (d_numPendingReopenQueues == 0);
 
     if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(readyToSend)) {
-        // Post the event.
-        bmqt::GenericResult::Enum res = writeOrBuffer(
-            *event.blob(),
-            d_sessionOptions.channelHighWatermark());
+        // Post the events.
+        bmqt::GenericResult::Enum res = bmqt::GenericResult::e_SUCCESS;
+        if (d_putEventsBatch.size() == 1) {
+            res = writeOrBuffer(*putEvent->rawEvent().blob(),
+                                d_sessionOptions.channelHighWatermark());
+        }
+        else {
+            // The blob buffers are shared, not copied.
+            bdlbb::Blob blob(d_bufferFactory_p, d_allocator_p);
+            for (size_t i = 0; i < d_putEventsBatch.size(); ++i) {
+                bdlbb::BlobUtil::append(
+                    &blob,
+                    *d_putEventsBatch[i]->rawEvent().blob());
+            }
+            res = writeOrBuffer(blob, d_sessionOptions.channelHighWatermark());
+        }
 
         if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
                 res != bmqt::GenericResult::e_SUCCESS)) {
             BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
 
-            BALL_LOG_ERROR << "Unable to post event [reason: 'NOT_CONNECTED']";
+            BALL_LOG_ERROR << "Unable to post " << d_putEventsBatch.size()
+                           << " event(s) [reason: 'NOT_CONNECTED']";
 
             // Channel is down. The blob hasn't been put into the extention
             // buffer. The messages will be put into the retransmitting buffer
@@ -3374,6 +3472,23 @@ void BrokerSession::processPutEvent(const bmqp::Event& event)
     }
 
     const bsls::TimeInterval sentTime = mwcsys::Time::nowMonotonicClock();
+    for (size_t i = 0; i < d_putEventsBatch.size(); ++i) {
+        enableRetransmission(d_putEventsBatch[i]->rawEvent(),
+                             readyToSend,
+                             sentTime);
+    }
+
+    d_putEventsBatch.clear();
+}
+
+void BrokerSession::enableRetransmission(const bmqp::Event&        event,
+                                         bool                      isSent,
+                                         const bsls::TimeInterval& sentTime)
+{
+    // executed by the FSM thread
+
+    BSLS_ASSERT_SAFE(d_fsmThreadChecker.inSameThread());
+
     bmqp::PutMessageIterator putIter(d_bufferFactory_p, d_allocator_p);
 
     // Get PUT iterator without decompression
@@ -3388,7 +3503,7 @@ void BrokerSession::processPutEvent(const bmqp::Event& event)
 
         // If the message has been sent and has no ACK_REQUESTED flag then it
         // shouldn't be retransmitted.
-        const bool noNeedToResend = readyToSend && !ackRequested;
+        const bool noNeedToResend = isSent && !ackRequested;
 
         if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(noNeedToResend)) {
             BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
@@ -3594,6 +3709,25 @@ void BrokerSession::processAckEvent(const bmqp::Event& event)
         return;  // RETURN
     }
 
+    bmqp::AckMessageIterator it;
+    event.loadAckMessageIterator(&it);
+
+    if (it.isValid() &&
+        (it.header().flags() & bmqp::AckHeaderFlags::e_CUMULATIVE)) {
+        // Each ACK message acknowledges a range of messages, which must be
+        // expanded.
+        expandAckEvent(event, true);
+        return;  // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(d_numPostedMessages > 0)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        // Some messages were posted with a completion callback, their ACKs
+        // must not be delivered in this event.
+        expandAckEvent(event, false);
+        return;  // RETURN
+    }
+
     bsl::shared_ptr<Event> queueEvent = createEvent();
     queueEvent->configureAsMessageEvent(event);
 
@@ -3602,8 +3736,6 @@ void BrokerSession::processAckEvent(const bmqp::Event& event)
     // 'internal correlationId' => 'user-provided correlationId' map, if
     // applicable (i.e., if internal correlationId is non-null)
 
-    bmqp::AckMessageIterator it;
-    event.loadAckMessageIterator(&it);
     int numAckMsgs = 0;
     while (it.next()) {
         ++numAckMsgs;
@@ -3653,6 +3785,114 @@ void BrokerSession::processAckEvent(const bmqp::Event& event)
                           numAckMsgs);
 }
 
+void BrokerSession::expandAckEvent(const bmqp::Event& event,
+                                   bool               isCumulative)
+{
+    // executed by the FSM thread
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(d_fsmThreadChecker.inSameThread());
+
+    // The ACKs which are not routed to a post context are re-encoded in a
+    // new event, so that the user ACK event has one message per
+    // acknowledged PUT and does not expose the others.
+    bmqp::AckEventBuilder  ackBuilder(d_bufferFactory_p, d_allocator_p);
+    bsl::shared_ptr<Event> ackEvent = createEvent();
+    AckedItems             ackedItems(d_allocator_p);
+
+    bmqp::AckMessageIterator it;
+    event.loadAckMessageIterator(&it);
+    while (it.next()) {
+        const bmqp::AckMessage& ackMsg = it.message();
+
+        // Lookup queue
+        const bsl::shared_ptr<Queue>& queue = d_queueManager.lookupQueue(
+            bmqp::QueueId(ackMsg.queueId()));
+        BSLS_ASSERT_SAFE(queue);
+
+        if (ackMsg.status() != 0) {
+            // Non-zero ack status. Log it.
+            MWCU_THROTTLEDACTION_THROTTLE(
+                d_throttledFailedAckMessages,
+                BALL_LOG_ERROR
+                    << "Failed ACK for queue '" << queue->uri()
+                    << "' [status: "
+                    << bmqp::ProtocolUtil::ackResultFromCode(ackMsg.status())
+                    << ", GUID: " << ackMsg.messageGUID() << "]";);
+        }
+
+        ackedItems.clear();
+        if (isCumulative) {
+            // Expand the ACK into all the messages pending acknowledgement
+            // on this queue, up to and including the acknowledged one.  Note
+            // that only the messages which were posted with the
+            // 'e_ACK_REQUESTED' flag are tracked, and thus expanded.
+            d_messageCorrelationIdContainer.iterateAndInvoke(
+                bmqp::QueueId(ackMsg.queueId()),
+                ackMsg.messageGUID(),
+                bdlf::BindUtil::bind(&collectAckedItem,
+                                     &ackedItems,
+                                     bdlf::PlaceHolders::_1,   // removeItem
+                                     bdlf::PlaceHolders::_2,   // key
+                                     bdlf::PlaceHolders::_3));  // qac
+        }
+        else {
+            bmqt::CorrelationId correlationId;
+            if (d_messageCorrelationIdContainer.remove(ackMsg.messageGUID(),
+                                                       &correlationId) != 0) {
+                // There is no correlationId associated with this GUID.
+                // Per contract, broker does not send ACKs where status is
+                // zero and correlationId is null.
+                BSLS_ASSERT_SAFE(0 != ackMsg.status());
+            }
+            ackedItems.push_back(
+                bsl::make_pair(ackMsg.messageGUID(), correlationId));
+        }
+
+        for (AckedItems::const_iterator citer = ackedItems.begin();
+             citer != ackedItems.end();
+             ++citer) {
+            if (completePostedMessage(citer->first,
+                                      ackMsg.status(),
+                                      citer->second,
+                                      queue)) {
+                continue;  // CONTINUE
+            }
+
+            bmqt::EventBuilderResult::Enum rc =
+                bmqp::ProtocolUtil::buildEvent(
+                    bdlf::BindUtil::bind(
+                        &bmqp::AckEventBuilder::appendMessage,
+                        &ackBuilder,
+                        ackMsg.status(),
+                        isCumulative ? bmqp::AckMessage::k_NULL_CORRELATION_ID
+                                     : ackMsg.correlationId(),
+                        citer->first,
+                        ackMsg.queueId()),
+                    bdlf::BindUtil::bind(&BrokerSession::transferAckEvent,
+                                         this,
+                                         &ackBuilder,
+                                         &ackEvent));
+            if (rc != bmqt::EventBuilderResult::e_SUCCESS) {
+                BALL_LOG_ERROR << "Failed to append ACK [rc: " << rc
+                               << ", GUID: " << citer->first
+                               << ", queueId: " << ackMsg.queueId() << "]";
+                continue;  // CONTINUE
+            }
+
+            // Keep track of user-provided CorrelationId (it may be unset)
+            ackEvent->addCorrelationId(citer->second);
+
+            // Insert queue into event
+            ackEvent->insertQueue(queue);
+        }
+    }
+
+    // Push the final ack event if there are any messages in the builder
+    if (ackBuilder.messageCount()) {
+        transferAckEvent(&ackBuilder, &ackEvent);
+    }
+}
+
 bmqt::OpenQueueResult::Enum
 BrokerSession::openQueueImp(const bsl::shared_ptr<Queue>&  queue,
                             bsls::TimeInterval             timeout,
@@ -4414,6 +4654,163 @@ void BrokerSession::transferAckEvent(bmqp::AckEventBuilder*  ackBuilder,
     *ackEvent = createEvent();
 }
 
+int BrokerSession::registerPostContext(const bmqp::Event&   event,
+                                       const EventCallback& callback)
+{
+    // executed by *ANY* thread
+
+    enum RcEnum {
+        // Value for the various RC error categories
+        rc_INVALID_EVENT  = -1,
+        rc_DUPLICATE_GUID = -2
+    };
+
+    bmqp::PutMessageIterator putIter(d_bufferFactory_p, d_allocator_p);
+    event.loadPutMessageIterator(&putIter);
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!putIter.isValid())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return rc_INVALID_EVENT;  // RETURN
+    }
+
+    bsl::shared_ptr<PostContext> context;
+    context.createInplace(d_allocator_p,
+                          callback,
+                          d_bufferFactory_p,
+                          d_allocator_p);
+    context->d_ackEvent = createEvent();
+
+    bsl::vector<bmqt::MessageGUID> guids(d_allocator_p);
+    int                            rc = 0;
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_postContextsLock);  // LOCK
+
+    while ((rc = putIter.next()) == 1) {
+        if (!bmqp::PutHeaderFlagUtil::isSet(
+                putIter.header().flags(),
+                bmqp::PutHeaderFlags::e_ACK_REQUESTED)) {
+            continue;  // CONTINUE
+        }
+
+        const bmqt::MessageGUID& guid = putIter.header().messageGUID();
+        if (!d_postContexts
+                 .insert(PostContextMap::value_type(guid, context))
+                 .second) {
+            rc = rc_DUPLICATE_GUID;
+            break;  // BREAK
+        }
+        guids.push_back(guid);
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(rc < 0)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        for (size_t i = 0; i < guids.size(); ++i) {
+            d_postContexts.erase(guids[i]);
+        }
+        return rc == rc_DUPLICATE_GUID ? rc_DUPLICATE_GUID
+                                       : rc_INVALID_EVENT;  // RETURN
+    }
+
+    context->d_numPending = static_cast<int>(guids.size());
+    d_numPostedMessages   = static_cast<int>(d_postContexts.size());
+
+    return context->d_numPending;
+}
+
+void BrokerSession::unregisterPostContext(const bmqp::Event& event)
+{
+    // executed by *ANY* thread
+
+    bmqp::PutMessageIterator putIter(d_bufferFactory_p, d_allocator_p);
+    event.loadPutMessageIterator(&putIter);
+    BSLS_ASSERT_SAFE(putIter.isValid());
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_postContextsLock);  // LOCK
+
+    while (putIter.next() == 1) {
+        d_postContexts.erase(putIter.header().messageGUID());
+    }
+
+    d_numPostedMessages = static_cast<int>(d_postContexts.size());
+}
+
+bool BrokerSession::completePostedMessage(
+    const bmqt::MessageGUID&      guid,
+    int                           ackStatus,
+    const bmqt::CorrelationId&    correlationId,
+    const bsl::shared_ptr<Queue>& queue)
+{
+    // executed by the FSM thread
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(d_fsmThreadChecker.inSameThread());
+    BSLS_ASSERT_SAFE(queue);
+
+    if (d_numPostedMessages == 0) {
+        return false;  // RETURN
+    }
+
+    bsl::shared_ptr<PostContext> context;
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_postContextsLock);  // LOCK
+
+        PostContextMap::iterator it = d_postContexts.find(guid);
+        if (it == d_postContexts.end()) {
+            return false;  // RETURN
+        }
+
+        context = it->second;
+        d_postContexts.erase(it);
+        d_numPostedMessages = static_cast<int>(d_postContexts.size());
+    }  // UNLOCK
+
+    BSLS_ASSERT_SAFE(context->d_numPending > 0);
+
+    // An ACK message is smaller than any PUT message, so the ACKs of a
+    // posted event always fit in a single ACK event.
+    bmqt::EventBuilderResult::Enum rc = context->d_ackBuilder.appendMessage(
+        ackStatus,
+        bmqp::AckMessage::k_NULL_CORRELATION_ID,
+        guid,
+        queue->id());
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+            rc != bmqt::EventBuilderResult::e_SUCCESS)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        BALL_LOG_ERROR << "Failed to append ACK to posted event "
+                       << "[rc: " << rc << ", GUID: " << guid
+                       << ", queue: " << queue->uri() << "]";
+    }
+    else {
+        // Keep track of user-provided CorrelationId (it may be unset)
+        context->d_ackEvent->addCorrelationId(correlationId);
+
+        // Insert queue into event
+        context->d_ackEvent->insertQueue(queue);
+    }
+
+    if (--context->d_numPending != 0) {
+        return true;  // RETURN
+    }
+
+    // All the messages of the posted event have been ACKed or NACKed, enqueue
+    // the aggregated ACK event so that the completion callback is invoked
+    // in place by the thread processing user events.
+    bmqp::Event event(&context->d_ackBuilder.blob(), d_allocator_p, true);
+    // clone = true
+    context->d_ackEvent->configureAsMessageEvent(event);
+    context->d_ackEvent->setEventCallback(context->d_callback);
+
+    BSLS_ASSERT_SAFE(context->d_ackBuilder.messageCount() ==
+                     context->d_ackEvent->numCorrrelationIds());
+
+    d_eventQueue.pushBack(context->d_ackEvent);
+
+    // Update stats
+    d_eventsStats.onEvent(EventsStatsEventType::e_ACK,
+                          event.blob()->length(),
+                          context->d_ackBuilder.messageCount());
+
+    return true;
+}
+
 void BrokerSession::cancel(const bsl::shared_ptr<Queue>&       queue,
                            bmqp_ctrlmsg::StatusCategory::Value status,
                            const bslstl::StringRef&            reason)
@@ -4544,6 +4941,18 @@ bool BrokerSession::cancelPendingMessageImp(
                                           : k_ACK_STATUS_UNKNOWN;
     }
 
+    bsl::shared_ptr<Queue> queue = queueSp;
+    if (!queue) {
+        // Lookup queue
+        queue = d_queueManager.lookupQueue(bmqp::QueueId(qac.d_queueId));
+        BSLS_ASSERT_SAFE(queue);
+    }
+
+    if (completePostedMessage(guid, ackStatus, qac.d_correlationId, queue)) {
+        // The NACK is delivered to the completion callback of the event.
+        return res;  // RETURN
+    }
+
     bmqt::EventBuilderResult::Enum rc = bmqp::ProtocolUtil::buildEvent(
         bdlf::BindUtil::bind(&bmqp::AckEventBuilder::appendMessage,
                              ackBuilder,
@@ -4566,12 +4975,6 @@ bool BrokerSession::cancelPendingMessageImp(
     (*ackEvent)->addCorrelationId(qac.d_correlationId);
 
     // Insert queue into event
-    bsl::shared_ptr<Queue> queue = queueSp;
-    if (!queue) {
-        // Lookup queue
-        queue = d_queueManager.lookupQueue(bmqp::QueueId(qac.d_queueId));
-        BSLS_ASSERT_SAFE(queue);
-    }
     (*ackEvent)->insertQueue(queue);
 
     return res;
@@ -5624,6 +6027,10 @@ BrokerSession::BrokerSession(
 , d_messageExpirationTimeoutHandle()
 , d_nextRequestGroupId(k_NON_BUFFERED_REQUEST_GROUP_ID)
 , d_queueRetransmissionTimeoutMap(allocator)
+, d_postContexts(allocator)
+, d_postContextsLock()
+, d_numPostedMessages(0)
+, d_putEventsBatch(allocator)
 {
     // PRECONDITIONS
     BSLS_ASSERT_SAFE(d_scheduler_p->clockType() ==
@@ -7117,6 +7524,47 @@ int BrokerSession::post(const bdlbb::Blob&        eventBlob,
     return bmqt::PostResult::e_SUCCESS;
 }
 
+int BrokerSession::post(const bdlbb::Blob&        eventBlob,
+                        const bsls::TimeInterval& timeout,
+                        const EventCallback&      callback)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT(callback && "non-empty 'callback' must be specified");
+
+    if (eventBlob.length() <= static_cast<int>(sizeof(bmqp::EventHeader))) {
+        return bmqt::PostResult::e_INVALID_ARGUMENT;  // RETURN
+    }
+
+    bmqp::Event event(&eventBlob, d_allocator_p);
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!event.isPutEvent())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        BALL_LOG_ERROR << "Unable to post event [reason: 'Not a PUT event']";
+        return bmqt::PostResult::e_INVALID_ARGUMENT;  // RETURN
+    }
+
+    // Register the context before posting, so that it is known to the FSM
+    // thread by the time the ACKs of the messages are received.
+    const int numRegistered = registerPostContext(event, callback);
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(numRegistered <= 0)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        BALL_LOG_ERROR << "Unable to post event with completion callback "
+                       << "[reason: '"
+                       << (numRegistered == 0 ? "No message requesting an ACK"
+                                              : "Invalid event")
+                       << "', rc: " << numRegistered << "]";
+        return bmqt::PostResult::e_INVALID_ARGUMENT;  // RETURN
+    }
+
+    const int rc = post(eventBlob, timeout);
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(rc !=
+                                              bmqt::PostResult::e_SUCCESS)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        unregisterPostContext(event);
+    }
+
+    return rc;
+}
+
 int BrokerSession::confirmMessage(const bsl::shared_ptr<bmqimp::Queue>& queue,
                                   const bmqt::MessageGUID&  messageId,
                                   const bsls::TimeInterval& timeout)
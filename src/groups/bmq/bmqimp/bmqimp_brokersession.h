@@ -362,6 +362,43 @@ class BrokerSession BSLS_CPP11_FINAL {
 
     typedef bsl::unordered_map<int, int> QueueRetransmissionTimeoutMap;
 
+    /// Context of an event posted with a completion callback, used to
+    /// aggregate the ACKs and NACKs of all the messages of that event which
+    /// requested an acknowledgement.  Once registered, a context is only
+    /// manipulated from the FSM thread.
+    struct PostContext {
+        // DATA
+        EventCallback d_callback;
+        // Callback to invoke with the
+        // aggregated ACK event
+
+        int d_numPending;
+        // Number of messages still waiting
+        // for an ACK or a NACK
+
+        bmqp::AckEventBuilder d_ackBuilder;
+        // Builder of the aggregated ACK
+        // event
+
+        bsl::shared_ptr<Event> d_ackEvent;
+        // Aggregated ACK event, holding the
+        // correlationIds and queues of the
+        // acknowledged messages
+
+        // CREATORS
+
+        /// Create a `PostContext` object invoking the specified `callback`
+        /// on completion, using the specified `bufferFactory` and
+        /// `allocator` to build the aggregated ACK event.
+        PostContext(const EventCallback&      callback,
+                    bdlbb::BlobBufferFactory* bufferFactory,
+                    bslma::Allocator*         allocator);
+    };
+
+    typedef bsl::unordered_map<bmqt::MessageGUID,
+                               bsl::shared_ptr<PostContext> >
+        PostContextMap;
+
     class SessionFsm {
       private:
         BrokerSession& d_session;
@@ -852,6 +889,28 @@ class BrokerSession BSLS_CPP11_FINAL {
     // retransmission timeout provided by
     // the broker
 
+    PostContextMap d_postContexts;
+    // Map of the GUIDs of the messages
+    // posted with a completion callback
+    // to their post context
+
+    bslmt::Mutex d_postContextsLock;
+    // Mutex for thread safe access to
+    // 'd_postContexts'
+
+    bsl::vector<bsl::shared_ptr<Event> > d_putEventsBatch;
+    // PUT events drained from the FSM
+    // event queue to be written to the
+    // channel at once.  Only used by the
+    // FSM thread, kept as a member to
+    // reuse its capacity.
+
+    bsls::AtomicInt d_numPostedMessages;
+    // Number of entries in
+    // 'd_postContexts', allowing the FSM
+    // thread to skip the lookup when
+    // empty
+
   private:
     // NOT IMPLEMENTED
     BrokerSession(const BrokerSession&);
@@ -941,9 +1000,23 @@ class BrokerSession BSLS_CPP11_FINAL {
     void enableMessageRetransmission(const bmqp::PutMessageIterator& putIter,
                                      const bsls::TimeInterval&       sentTime);
 
-    /// Process the put event represented by the specified `event`.  This
-    /// method gets called each time a new put event is poseted by the user.
-    void processPutEvent(const bmqp::Event& event);
+    /// Process the specified `putEvent` posted by the user, along with all
+    /// the PUT events immediately following it in the FSM event queue,
+    /// writing them to the channel at once.  If an event of another kind is
+    /// popped from the FSM event queue, load it into the specified
+    /// `nextEvent` and set the specified `hasNext` flag to true, so that it
+    /// is processed next.
+    void processPutEvents(bsl::shared_ptr<Event>*       nextEvent,
+                          bool*                         hasNext,
+                          const bsl::shared_ptr<Event>& putEvent);
+
+    /// Enable retransmission for the messages of the specified PUT `event`
+    /// written to the channel at the specified `sentTime`.  If the
+    /// specified `isSent` flag is true, messages which have not requested
+    /// an acknowledgement are skipped.
+    void enableRetransmission(const bmqp::Event&        event,
+                              bool                      isSent,
+                              const bsls::TimeInterval& sentTime);
 
     /// Process the confirm event represented by the specified `event`.
     /// This method gets called each time a new confirm event is poseted by
@@ -960,6 +1033,15 @@ class BrokerSession BSLS_CPP11_FINAL {
     /// broker) is available on the channel.
     void processAckEvent(const bmqp::Event& event);
 
+    /// Process the specified ACK `event` when it can't be delivered as is
+    /// to the user: if the specified `isCumulative` is true, each of its
+    /// messages acknowledges all the pending messages of its queue up to
+    /// and including the one it refers to, and is expanded into one ACK
+    /// per such message.  Route the ACKs of the messages posted with a
+    /// completion callback to their post context and deliver the other ones
+    /// in a regular ACK event.
+    void expandAckEvent(const bmqp::Event& event, bool isCumulative);
+
     /// Callback invoked in reply to a `disconnect` with the specified
     /// `context`.
     void onDisconnectResponse(const RequestManagerType::RequestSp& context);
@@ -1257,6 +1339,30 @@ class BrokerSession BSLS_CPP11_FINAL {
     void transferAckEvent(bmqp::AckEventBuilder*  ackBuilder,
                           bsl::shared_ptr<Event>* ackEvent);
 
+    /// Register a post context invoking the specified `callback` for all
+    /// messages of the specified PUT `event` which requested an
+    /// acknowledgement.  Return the number of registered messages, or a
+    /// negative value if the event is invalid or one of its GUIDs is
+    /// already registered, in which case nothing is registered.
+    int registerPostContext(const bmqp::Event&   event,
+                            const EventCallback& callback);
+
+    /// Remove from the post contexts all the messages of the specified PUT
+    /// `event`.  This is used when posting an event registered with
+    /// `registerPostContext` has failed.
+    void unregisterPostContext(const bmqp::Event& event);
+
+    /// Record the specified `ackStatus` and `correlationId` for the message
+    /// with the specified `guid` posted on the specified `queue` in its
+    /// post context, if any, and invoke the completion callback of that
+    /// context if this was the last pending message.  Return true if the
+    /// message belongs to a post context (and therefore must not be
+    /// delivered in a regular ACK event), and false otherwise.
+    bool completePostedMessage(const bmqt::MessageGUID&      guid,
+                               int                           ackStatus,
+                               const bmqt::CorrelationId&    correlationId,
+                               const bsl::shared_ptr<Queue>& queue);
+
     /// Invoked from the FSM thread as a handler to the user start request
     /// event, specified as `eventSp`.  This method starts the user event
     /// queue, sets the specified `status` and releases the specified
@@ -1570,6 +1676,21 @@ class BrokerSession BSLS_CPP11_FINAL {
 
     int post(const bdlbb::Blob& eventBlob, const bsls::TimeInterval& timeout);
 
+    /// Post the specified PUT `eventBlob` with the specified `timeout`, and
+    /// invoke the specified `callback` with a single ACK message event once
+    /// all the messages of `eventBlob` requesting an acknowledgement have
+    /// been ACKed or NACKed, by the broker or locally.  The callback is
+    /// invoked from the thread processing the events of the session (the
+    /// event handler thread or the thread calling `nextEvent`) and the ACKs
+    /// it receives are not delivered as regular ACK events.  Return one of
+    /// the values defined in the `bmqt::PostResult::Enum` enum; the
+    /// `callback` is not invoked if a non-zero value is returned.  Note
+    /// that `e_INVALID_ARGUMENT` is returned if none of the messages of
+    /// `eventBlob` requested an acknowledgement.
+    int post(const bdlbb::Blob&        eventBlob,
+             const bsls::TimeInterval& timeout,
+             const EventCallback&      callback);
+
     int confirmMessage(const bsl::shared_ptr<bmqimp::Queue>& queue,
                        const bmqt::MessageGUID&              messageId,
                        const bsls::TimeInterval&             timeout);
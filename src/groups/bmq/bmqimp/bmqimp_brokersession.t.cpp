@@ -44,15 +44,20 @@
 #include <mwcio_testchannel.h>
 #include <mwcsys_time.h>
 #include <mwcu_memoutstream.h>
+#include <mwcu_printutil.h>
 
 // BDE
+#include <bdlbb_blobutil.h>
 #include <bdlbb_pooledblobbufferfactory.h>
 #include <bdlcc_deque.h>
 #include <bdlf_memfn.h>
 #include <bdlmt_eventscheduler.h>
 #include <bdlmt_signaler.h>
+#include <bdlt_timeunitratio.h>
 #include <bsl_memory.h>
+#include <bsla_maybeunused.h>
 #include <bslma_managedptr.h>
+#include <bslmt_barrier.h>
 #include <bslmt_lockguard.h>
 #include <bslmt_mutex.h>
 #include <bslmt_semaphore.h>
@@ -62,10 +67,16 @@
 #include <bsls_platform.h>
 #include <bsls_systemclocktype.h>
 #include <bsls_systemtime.h>
+#include <bsls_timeutil.h>
 
 // TEST DRIVER
 #include <mwctst_testhelper.h>
 
+// BENCHMARKING LIBRARY
+#ifdef BSLS_PLATFORM_OS_LINUX
+#include <benchmark/benchmark.h>
+#endif
+
 // CONVENIENCE
 using namespace BloombergLP;
 using namespace bsl;
@@ -2785,6 +2796,113 @@ class DTTestTracer : public bmqpi::DTTracer {
     }
 };
 
+// ============================================================================
+//                          MULTI-THREADED POST UTILITIES
+// ----------------------------------------------------------------------------
+
+/// Post the specified `numEvents` PUT events, each containing one message
+/// for the queue with the specified `queueId`, to the specified `session`
+/// using the specified `bufferFactory`, after waiting on the specified
+/// `barrier`.  Increment the specified `numBytes` by the size of each
+/// posted event.
+static void postEvents(bmqimp::BrokerSession*    session,
+                       bdlbb::BlobBufferFactory* bufferFactory,
+                       int                       queueId,
+                       int                       numEvents,
+                       bslmt::Barrier*           barrier,
+                       bsls::AtomicInt64*        numBytes)
+{
+    const char* k_PAYLOAD     = "abcdefghijklmnopqrstuvwxyz";
+    const int   k_PAYLOAD_LEN = bsl::strlen(k_PAYLOAD);
+
+    // Each thread uses its own event blob, as an application thread would.
+    bmqp::PutEventBuilder builder(bufferFactory, s_allocator_p);
+    builder.startMessage();
+    builder.setMessagePayload(k_PAYLOAD, k_PAYLOAD_LEN)
+        .setMessageGUID(bmqp::MessageGUIDGenerator::testGUID());
+    BSLS_ASSERT_OPT(builder.packMessage(queueId) ==
+                    bmqt::EventBuilderResult::e_SUCCESS);
+
+    barrier->wait();
+
+    for (int i = 0; i < numEvents; ++i) {
+        const int rc = session->post(builder.blob(), bsls::TimeInterval(5));
+        BSLS_ASSERT_OPT(rc == bmqt::PostResult::e_SUCCESS);
+        (void)rc;
+        numBytes->addRelaxed(builder.blob().length());
+    }
+}
+
+/// Post the specified `numEventsPerThread` PUT events for the specified
+/// `queue` from each of the specified `numThreads` threads using the
+/// specified `session`, and wait until all of them are written to the test
+/// channel.  Verify each channel write is a sequence of complete PUT
+/// events.  Return the elapsed time in nanoseconds.
+static bsls::Types::Int64
+multiThreadedPost(TestSession*                          session,
+                  const bsl::shared_ptr<bmqimp::Queue>& queue,
+                  int                                   numThreads,
+                  int                                   numEventsPerThread)
+{
+    bsl::vector<bslmt::ThreadUtil::Handle> threads(numThreads, s_allocator_p);
+    bslmt::Barrier                         barrier(numThreads + 1);
+    bsls::AtomicInt64                      numBytes(0);
+
+    for (int i = 0; i < numThreads; ++i) {
+        const int rc = bslmt::ThreadUtil::create(
+            &threads[i],
+            bdlf::BindUtil::bind(&postEvents,
+                                 &session->session(),
+                                 &session->blobBufferFactory(),
+                                 queue->id(),
+                                 numEventsPerThread,
+                                 &barrier,
+                                 &numBytes));
+        BSLS_ASSERT_OPT(rc == 0);
+        (void)rc;
+    }
+
+    barrier.wait();
+    const bsls::Types::Int64 begin = bsls::TimeUtil::getTimer();
+
+    for (int i = 0; i < numThreads; ++i) {
+        bslmt::ThreadUtil::join(threads[i]);
+    }
+
+    // Wait for the FSM thread to write all the events to the channel.
+    bsls::Types::Int64 numWritten = 0;
+    while (numWritten < numBytes.load()) {
+        if (!session->channel().waitFor(1, false, bsls::TimeInterval(5))) {
+            ASSERT(false && "Timeout waiting for PUT events");
+            break;  // BREAK
+        }
+
+        mwcio::TestChannel::WriteCall wc = session->channel().popWriteCall();
+
+        // A write may contain several coalesced events.
+        int offset = 0;
+        while (offset < wc.d_blob.length()) {
+            bmqp::EventHeader header;
+            bdlbb::BlobUtil::copy(reinterpret_cast<char*>(&header),
+                                  wc.d_blob,
+                                  offset,
+                                  sizeof(header));
+            ASSERT_EQ(header.type(), bmqp::EventType::e_PUT);
+            ASSERT_GT(header.length(), 0);
+            if (header.length() <= 0) {
+                break;  // BREAK
+            }
+            offset += header.length();
+        }
+        ASSERT_EQ(offset, wc.d_blob.length());
+
+        numWritten += wc.d_blob.length();
+    }
+    ASSERT_EQ(numWritten, numBytes.load());
+
+    return bsls::TimeUtil::getTimer() - begin;
+}
+
 }  // close unnamed namespace
 
 // ============================================================================
@@ -10206,6 +10324,505 @@ static void test70_queueLateAsyncCanceledHybrid5()
                            bmqimp::QueueState::e_CLOSED);
 }
 
+static void test71_postWithCallback()
+// ------------------------------------------------------------------------
+// POST WITH CALLBACK TEST
+//
+// Concerns:
+//   1. Check that the ACKs of the messages of an event posted with a
+//      completion callback are aggregated and delivered to the callback
+//      once all of them are received, and not as regular ACK events.
+//   2. Check that the ACKs of other messages are still delivered as
+//      regular ACK events.
+//   3. Check that posting with a callback an event without any message
+//      requesting an ACK fails.
+//
+// Plan:
+//   1. Create bmqimp::BrokerSession test wrapper object
+//      and start the session with a test network channel.
+//   2. Open a queue for writing.
+//   3. Post with a callback a PUT event with two messages requesting an
+//      ACK, and post a third message without callback.
+//   4. Emulate the broker ACKs the first and the third messages, and
+//      verify only the third one is delivered as an ACK event.
+//   5. Emulate the broker ACKs the second message, and verify the
+//      callback is invoked with the two ACKs.
+//   6. Post with a callback a PUT event without ACK_REQUESTED flag and
+//      verify it is rejected.
+//   7. Stop the session.
+//
+// Testing manipulators:
+//   - post
+//   ----------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("POST WITH CALLBACK TEST");
+
+    const char* k_PAYLOAD     = "abcdefghijklmnopqrstuvwxyz";
+    const int   k_PAYLOAD_LEN = bsl::strlen(k_PAYLOAD);
+
+    const int k_ACK_STATUS_SUCCESS = bmqp::ProtocolUtil::ackResultToCode(
+        bmqt::AckResult::e_SUCCESS);
+
+    const bsls::TimeInterval       timeout = bsls::TimeInterval(5);
+    int                            phFlags = 0;
+    bmqt::SessionOptions           sessionOptions;
+    bmqt::QueueOptions             queueOptions;
+    bdlbb::PooledBlobBufferFactory bufferFactory(1024, s_allocator_p);
+    bmqp::PutEventBuilder     putEventBuilder(&bufferFactory, s_allocator_p);
+    bmqp::AckEventBuilder     ackEventBuilder(&bufferFactory, s_allocator_p);
+    bmqp::Event               rawEvent(s_allocator_p);
+    const bmqt::CorrelationId corrIdFirst(243);
+    const bmqt::CorrelationId corrIdSecond(987);
+    const bmqt::CorrelationId corrIdThird(591);
+    bdlmt::EventScheduler     scheduler(bsls::SystemClockType::e_MONOTONIC,
+                                    s_allocator_p);
+    TestClock                 testClock(scheduler);
+    bslmt::TimedSemaphore     callbackSem;
+    bsl::shared_ptr<bmqimp::Event> callbackEvent;
+
+    bmqt::MessageGUID guidFirst  = bmqp::MessageGUIDGenerator::testGUID();
+    bmqt::MessageGUID guidSecond = bmqp::MessageGUIDGenerator::testGUID();
+    bmqt::MessageGUID guidThird  = bmqp::MessageGUIDGenerator::testGUID();
+
+    const bmqimp::BrokerSession::EventCallback postCallback =
+        bdlf::BindUtil::bind(&eventHandler,
+                             &callbackEvent,
+                             bsl::ref(callbackSem),
+                             bdlf::PlaceHolders::_1);  // event
+
+    sessionOptions.setNumProcessingThreads(1);
+
+    TestSession obj(sessionOptions, testClock, s_allocator_p);
+
+    bsl::shared_ptr<bmqimp::Queue> pQueue =
+        obj.createQueue(k_URI, bmqt::QueueFlags::e_WRITE, queueOptions);
+
+    PVV_SAFE("Step 1. Start the session");
+    obj.startAndConnect();
+
+    PVV_SAFE("Step 2. Open the queue");
+    obj.openQueue(pQueue, timeout);
+
+    PVV_SAFE("Step 3. Post PUT events");
+    bmqp::PutHeaderFlagUtil::setFlag(&phFlags,
+                                     bmqp::PutHeaderFlags::e_ACK_REQUESTED);
+
+    bsl::shared_ptr<bmqimp::Event> putEvent = obj.session().createEvent();
+
+    bmqimp::MessageCorrelationIdContainer* idsContainer =
+        putEvent->messageCorrelationIdContainer();
+    const bmqp::QueueId qid(pQueue->id(), pQueue->subQueueId());
+
+    idsContainer->add(guidFirst, corrIdFirst, qid);
+    idsContainer->add(guidSecond, corrIdSecond, qid);
+    idsContainer->add(guidThird, corrIdThird, qid);
+
+    putEventBuilder.startMessage();
+    putEventBuilder.setMessageGUID(guidFirst)
+        .setMessagePayload(k_PAYLOAD, k_PAYLOAD_LEN)
+        .setFlags(phFlags);
+
+    bmqt::EventBuilderResult::Enum rc = putEventBuilder.packMessage(
+        pQueue->id());
+
+    ASSERT_EQ(rc, bmqt::EventBuilderResult::e_SUCCESS);
+
+    putEventBuilder.startMessage();
+    putEventBuilder.setMessageGUID(guidSecond)
+        .setMessagePayload(k_PAYLOAD, k_PAYLOAD_LEN)
+        .setFlags(phFlags);
+    rc = putEventBuilder.packMessage(pQueue->id());
+
+    ASSERT_EQ(rc, bmqt::EventBuilderResult::e_SUCCESS);
+
+    int res = obj.session().post(putEventBuilder.blob(),
+                                 timeout,
+                                 postCallback);
+
+    ASSERT_EQ(res, bmqt::PostResult::e_SUCCESS);
+
+    obj.getOutboundEvent(&rawEvent);
+    ASSERT(rawEvent.isPutEvent());
+
+    putEventBuilder.reset();
+    putEventBuilder.startMessage();
+    putEventBuilder.setMessageGUID(guidThird)
+        .setMessagePayload(k_PAYLOAD, k_PAYLOAD_LEN)
+        .setFlags(phFlags);
+    rc = putEventBuilder.packMessage(pQueue->id());
+
+    ASSERT_EQ(rc, bmqt::EventBuilderResult::e_SUCCESS);
+
+    res = obj.session().post(putEventBuilder.blob(), timeout);
+
+    ASSERT_EQ(res, bmqt::PostResult::e_SUCCESS);
+
+    rawEvent.clear();
+    obj.getOutboundEvent(&rawEvent);
+    ASSERT(rawEvent.isPutEvent());
+
+    PVV_SAFE("Step 4. ACK the first and the third messages");
+    ackEventBuilder.appendMessage(k_ACK_STATUS_SUCCESS,
+                                  bmqp::AckMessage::k_NULL_CORRELATION_ID,
+                                  guidFirst,
+                                  pQueue->id());
+    ackEventBuilder.appendMessage(k_ACK_STATUS_SUCCESS,
+                                  bmqp::AckMessage::k_NULL_CORRELATION_ID,
+                                  guidThird,
+                                  pQueue->id());
+
+    obj.session().processPacket(ackEventBuilder.blob());
+
+    bsl::shared_ptr<bmqimp::Event> ackEvent = obj.waitAckEvent();
+
+    ASSERT(ackEvent);
+
+    bmqp::AckMessageIterator* ackIter = ackEvent->ackMessageIterator();
+    ASSERT_EQ(1, ackIter->next());
+    ASSERT_EQ(guidThird, ackIter->message().messageGUID());
+    ASSERT_EQ(1, ackEvent->numCorrrelationIds());
+    ASSERT_EQ(corrIdThird, ackEvent->correlationId(0));
+    ASSERT_EQ(0, ackIter->next());
+
+    ASSERT_NE(0, callbackSem.tryWait());
+
+    PVV_SAFE("Step 5. ACK the second message");
+    ackEventBuilder.reset();
+    ackEventBuilder.appendMessage(k_ACK_STATUS_SUCCESS,
+                                  bmqp::AckMessage::k_NULL_CORRELATION_ID,
+                                  guidSecond,
+                                  pQueue->id());
+
+    obj.session().processPacket(ackEventBuilder.blob());
+
+    ASSERT_EQ(0,
+              callbackSem.timedWait(bsls::SystemTime::nowRealtimeClock() +
+                                    timeout));
+    ASSERT(callbackEvent);
+    ASSERT(callbackEvent->rawEvent().isAckEvent());
+
+    ackIter = callbackEvent->ackMessageIterator();
+    ASSERT_EQ(1, ackIter->next());
+    ASSERT_EQ(guidFirst, ackIter->message().messageGUID());
+    ASSERT_EQ(k_ACK_STATUS_SUCCESS, ackIter->message().status());
+    ASSERT_EQ(1, ackIter->next());
+    ASSERT_EQ(guidSecond, ackIter->message().messageGUID());
+    ASSERT_EQ(k_ACK_STATUS_SUCCESS, ackIter->message().status());
+    ASSERT_EQ(0, ackIter->next());
+    ASSERT_EQ(2, callbackEvent->numCorrrelationIds());
+    ASSERT_EQ(corrIdFirst, callbackEvent->correlationId(0));
+    ASSERT_EQ(corrIdSecond, callbackEvent->correlationId(1));
+
+    ASSERT(obj.checkNoEvent());
+
+    PVV_SAFE("Step 6. Post with callback an event without ACK request");
+    putEventBuilder.reset();
+    putEventBuilder.startMessage();
+    putEventBuilder
+        .setMessageGUID(bmqp::MessageGUIDGenerator::testGUID())
+        .setMessagePayload(k_PAYLOAD, k_PAYLOAD_LEN);
+    rc = putEventBuilder.packMessage(pQueue->id());
+
+    ASSERT_EQ(rc, bmqt::EventBuilderResult::e_SUCCESS);
+
+    res = obj.session().post(putEventBuilder.blob(), timeout, postCallback);
+
+    ASSERT_EQ(res, bmqt::PostResult::e_INVALID_ARGUMENT);
+
+    PVV_SAFE("Step 7. Stop the session");
+    obj.stopGracefully();
+}
+
+static void test72_multiThreadedPost()
+// ------------------------------------------------------------------------
+// MULTI-THREADED POST TEST
+//
+// Concerns:
+//   1. Check that PUT events posted concurrently from several threads are
+//      all written to the channel, possibly coalesced in a single write,
+//      without being interleaved or truncated.
+//
+// Plan:
+//   1. Create bmqimp::BrokerSession test wrapper object
+//      and start the session with a test network channel.
+//   2. Open a queue for writing.
+//   3. Post PUT events from several threads and verify all of them are
+//      written to the channel as complete PUT events.
+//   4. Stop the session.
+//
+// Testing manipulators:
+//   - post
+//   ----------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("MULTI-THREADED POST TEST");
+
+    const int                k_NUM_THREADS = 4;
+    const int                k_NUM_EVENTS  = 1000;
+    const bsls::TimeInterval timeout       = bsls::TimeInterval(5);
+    bmqt::SessionOptions     sessionOptions;
+    bmqt::QueueOptions       queueOptions;
+    bdlmt::EventScheduler    scheduler(bsls::SystemClockType::e_MONOTONIC,
+                                    s_allocator_p);
+
+    sessionOptions.setNumProcessingThreads(1);
+
+    TestSession obj(sessionOptions, scheduler, s_allocator_p);
+
+    bsl::shared_ptr<bmqimp::Queue> pQueue =
+        obj.createQueue(k_URI, bmqt::QueueFlags::e_WRITE, queueOptions);
+
+    PVV_SAFE("Step 1. Start the session");
+    obj.startAndConnect();
+
+    PVV_SAFE("Step 2. Open the queue");
+    obj.openQueue(pQueue, timeout);
+
+    PVV_SAFE("Step 3. Post PUT events from " << k_NUM_THREADS << " threads");
+    multiThreadedPost(&obj, pQueue, k_NUM_THREADS, k_NUM_EVENTS);
+
+    PVV_SAFE("Step 4. Stop the session");
+    obj.stopGracefully();
+}
+
+static void test73_cumulativeAck()
+// ------------------------------------------------------------------------
+// CUMULATIVE ACK TEST
+//
+// Concerns:
+//   1. Check that an ACK event with the 'e_CUMULATIVE' header flag is
+//      expanded into one ACK per message pending acknowledgement on the
+//      queue, up to and including the acknowledged message.
+//   2. Check that a cumulative ACK for an already acknowledged message
+//      does not generate any ACK event.
+//
+// Plan:
+//   1. Create bmqimp::BrokerSession test wrapper object
+//      and start the session with a test network channel.
+//   2. Open a queue for writing.
+//   3. Post three PUT messages requesting an ACK.
+//   4. Emulate the broker sends a cumulative ACK for the second message,
+//      and verify an ACK event for the first two messages is delivered.
+//   5. Emulate the broker sends a cumulative ACK for the third message,
+//      and verify an ACK event for the third message is delivered.
+//   6. Emulate the broker sends the same cumulative ACK again, and verify
+//      no event is delivered.
+//   7. Stop the session.
+//
+// Testing manipulators:
+//   - processPacket
+//   ----------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("CUMULATIVE ACK TEST");
+
+    const char* k_PAYLOAD     = "abcdefghijklmnopqrstuvwxyz";
+    const int   k_PAYLOAD_LEN = bsl::strlen(k_PAYLOAD);
+    const int   k_NUM_MSGS    = 3;
+
+    const int k_ACK_STATUS_SUCCESS = bmqp::ProtocolUtil::ackResultToCode(
+        bmqt::AckResult::e_SUCCESS);
+
+    const bsls::TimeInterval       timeout = bsls::TimeInterval(5);
+    int                            phFlags = 0;
+    bmqt::SessionOptions           sessionOptions;
+    bmqt::QueueOptions             queueOptions;
+    bdlbb::PooledBlobBufferFactory bufferFactory(1024, s_allocator_p);
+    bmqp::PutEventBuilder putEventBuilder(&bufferFactory, s_allocator_p);
+    bmqp::AckEventBuilder ackEventBuilder(&bufferFactory, s_allocator_p);
+    bmqp::Event           rawEvent(s_allocator_p);
+    bdlmt::EventScheduler scheduler(bsls::SystemClockType::e_MONOTONIC,
+                                    s_allocator_p);
+    TestClock             testClock(scheduler);
+
+    bmqt::MessageGUID   guids[k_NUM_MSGS];
+    bmqt::CorrelationId corrIds[k_NUM_MSGS];
+
+    sessionOptions.setNumProcessingThreads(1);
+
+    TestSession obj(sessionOptions, testClock, s_allocator_p);
+
+    bsl::shared_ptr<bmqimp::Queue> pQueue =
+        obj.createQueue(k_URI, bmqt::QueueFlags::e_WRITE, queueOptions);
+
+    PVV_SAFE("Step 1. Start the session");
+    obj.startAndConnect();
+
+    PVV_SAFE("Step 2. Open the queue");
+    obj.openQueue(pQueue, timeout);
+
+    PVV_SAFE("Step 3. Post PUT messages");
+    bmqp::PutHeaderFlagUtil::setFlag(&phFlags,
+                                     bmqp::PutHeaderFlags::e_ACK_REQUESTED);
+
+    bsl::shared_ptr<bmqimp::Event> putEvent = obj.session().createEvent();
+
+    bmqimp::MessageCorrelationIdContainer* idsContainer =
+        putEvent->messageCorrelationIdContainer();
+    const bmqp::QueueId qid(pQueue->id(), pQueue->subQueueId());
+
+    for (int i = 0; i < k_NUM_MSGS; ++i) {
+        guids[i]   = bmqp::MessageGUIDGenerator::testGUID();
+        corrIds[i] = bmqt::CorrelationId(100 + i);
+        idsContainer->add(guids[i], corrIds[i], qid);
+
+        putEventBuilder.reset();
+        putEventBuilder.startMessage();
+        putEventBuilder.setMessageGUID(guids[i])
+            .setMessagePayload(k_PAYLOAD, k_PAYLOAD_LEN)
+            .setFlags(phFlags);
+        ASSERT_EQ(putEventBuilder.packMessage(pQueue->id()),
+                  bmqt::EventBuilderResult::e_SUCCESS);
+
+        ASSERT_EQ(obj.session().post(putEventBuilder.blob(), timeout),
+                  bmqt::PostResult::e_SUCCESS);
+
+        rawEvent.clear();
+        obj.getOutboundEvent(&rawEvent);
+        ASSERT(rawEvent.isPutEvent());
+    }
+
+    PVV_SAFE("Step 4. Cumulative ACK for the second message");
+    ackEventBuilder.setFlags(bmqp::AckHeaderFlags::e_CUMULATIVE);
+    ackEventBuilder.appendMessage(k_ACK_STATUS_SUCCESS,
+                                  bmqp::AckMessage::k_NULL_CORRELATION_ID,
+                                  guids[1],
+                                  pQueue->id());
+
+    obj.session().processPacket(ackEventBuilder.blob());
+
+    bsl::shared_ptr<bmqimp::Event> ackEvent = obj.waitAckEvent();
+    ASSERT(ackEvent);
+
+    bmqp::AckMessageIterator* ackIter = ackEvent->ackMessageIterator();
+    ASSERT_EQ(0, ackIter->header().flags());
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_EQ_D(i, 1, ackIter->next());
+        ASSERT_EQ_D(i, guids[i], ackIter->message().messageGUID());
+        ASSERT_EQ_D(i, k_ACK_STATUS_SUCCESS, ackIter->message().status());
+        ASSERT_EQ_D(i, corrIds[i], ackEvent->correlationId(i));
+    }
+    ASSERT_EQ(0, ackIter->next());
+    ASSERT_EQ(2, ackEvent->numCorrrelationIds());
+
+    PVV_SAFE("Step 5. Cumulative ACK for the third message");
+    ackEventBuilder.reset();
+    ackEventBuilder.appendMessage(k_ACK_STATUS_SUCCESS,
+                                  bmqp::AckMessage::k_NULL_CORRELATION_ID,
+                                  guids[2],
+                                  pQueue->id());
+
+    obj.session().processPacket(ackEventBuilder.blob());
+
+    ackEvent = obj.waitAckEvent();
+    ASSERT(ackEvent);
+
+    ackIter = ackEvent->ackMessageIterator();
+    ASSERT_EQ(1, ackIter->next());
+    ASSERT_EQ(guids[2], ackIter->message().messageGUID());
+    ASSERT_EQ(0, ackIter->next());
+    ASSERT_EQ(1, ackEvent->numCorrrelationIds());
+    ASSERT_EQ(corrIds[2], ackEvent->correlationId(0));
+
+    PVV_SAFE("Step 6. Repeat the cumulative ACK for the third message");
+    obj.session().processPacket(ackEventBuilder.blob());
+
+    ASSERT(obj.checkNoEvent());
+
+    PVV_SAFE("Step 7. Stop the session");
+    obj.stopGracefully();
+}
+
+BSLA_MAYBE_UNUSED static void testN1_multiThreadedPostPerformance()
+// ------------------------------------------------------------------------
+// MULTI-THREADED POST PERFORMANCE
+//
+// Concerns:
+//   1. Measure how the throughput of the post path scales with the number
+//      of application threads posting to the same session.
+//
+// Plan:
+//   1. For 1 to 32 threads, post PUT events concurrently from all threads
+//      and wait for all of them to be written to the test channel.
+//   2. Print the throughput for each number of threads.
+//
+// Testing:
+//   Performance
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("MULTI-THREADED POST PERFORMANCE");
+
+    const int                k_NUM_EVENTS_PER_THREAD = 100000;
+    const bsls::TimeInterval timeout                 = bsls::TimeInterval(5);
+    bmqt::SessionOptions     sessionOptions;
+    bmqt::QueueOptions       queueOptions;
+    bdlmt::EventScheduler    scheduler(bsls::SystemClockType::e_MONOTONIC,
+                                    s_allocator_p);
+
+    sessionOptions.setNumProcessingThreads(1);
+
+    TestSession obj(sessionOptions, scheduler, s_allocator_p);
+
+    bsl::shared_ptr<bmqimp::Queue> pQueue =
+        obj.createQueue(k_URI, bmqt::QueueFlags::e_WRITE, queueOptions);
+
+    obj.startAndConnect();
+    obj.openQueue(pQueue, timeout);
+
+    for (int numThreads = 1; numThreads <= 32; numThreads *= 2) {
+        const bsls::Types::Int64 elapsed = multiThreadedPost(
+            &obj,
+            pQueue,
+            numThreads,
+            k_NUM_EVENTS_PER_THREAD);
+        const bsls::Types::Int64 numEvents = static_cast<bsls::Types::Int64>(
+                                                 numThreads) *
+                                             k_NUM_EVENTS_PER_THREAD;
+
+        cout << "Threads: " << numThreads << ", events: " << numEvents
+             << ", elapsed: " << mwcu::PrintUtil::prettyTimeInterval(elapsed)
+             << ", throughput: "
+             << mwcu::PrintUtil::prettyNumber(static_cast<bsls::Types::Int64>(
+                    numEvents * bdlt::TimeUnitRatio::k_NS_PER_S / elapsed))
+             << " events/s" << endl;
+    }
+
+    obj.stopGracefully();
+}
+
+// Begin benchmarking library tests (Linux only)
+#ifdef BSLS_PLATFORM_OS_LINUX
+static void testN1_multiThreadedPostPerformance_GoogleBenchmark(
+    benchmark::State& state)
+{
+    mwctst::TestHelper::printTestName("MULTI-THREADED POST PERFORMANCE");
+
+    const int                k_NUM_EVENTS_PER_THREAD = 10000;
+    const int                numThreads = static_cast<int>(state.range(0));
+    const bsls::TimeInterval timeout    = bsls::TimeInterval(5);
+    bmqt::SessionOptions     sessionOptions;
+    bmqt::QueueOptions       queueOptions;
+    bdlmt::EventScheduler    scheduler(bsls::SystemClockType::e_MONOTONIC,
+                                    s_allocator_p);
+
+    sessionOptions.setNumProcessingThreads(1);
+
+    TestSession obj(sessionOptions, scheduler, s_allocator_p);
+
+    bsl::shared_ptr<bmqimp::Queue> pQueue =
+        obj.createQueue(k_URI, bmqt::QueueFlags::e_WRITE, queueOptions);
+
+    obj.startAndConnect();
+    obj.openQueue(pQueue, timeout);
+
+    for (auto _ : state) {
+        multiThreadedPost(&obj, pQueue, numThreads, k_NUM_EVENTS_PER_THREAD);
+    }
+    state.SetItemsProcessed(state.iterations() * numThreads *
+                            k_NUM_EVENTS_PER_THREAD);
+
+    obj.stopGracefully();
+}
+#endif  // BSLS_PLATFORM_OS_LINUX
+
 // ============================================================================
 //                                 MAIN PROGRAM
 // ----------------------------------------------------------------------------
@@ -10221,6 +10838,9 @@ int main(int argc, char* argv[])
 
     switch (_testCase) {
     case 0:
+    case 73: test73_cumulativeAck(); break;
+    case 72: test72_multiThreadedPost(); break;
+    case 71: test71_postWithCallback(); break;
     case 70: test70_queueLateAsyncCanceledHybrid5(); break;
     case 69: test69_queueLateAsyncCanceledHybrid4(); break;
     case 68: test68_queueLateAsyncCanceledHybrid3(); break;
@@ -10291,12 +10911,26 @@ int main(int argc, char* argv[])
     case 3: test3_nullChannelTest(); break;
     case 2: test2_basicAccessorsTest(); break;
     case 1: test1_breathingTest(); break;
+    case -1:
+        MWC_BENCHMARK_WITH_ARGS(testN1_multiThreadedPostPerformance,
+                                RangeMultiplier(2)
+                                    ->Range(1, 32)
+                                    ->UseRealTime()
+                                    ->Unit(benchmark::kMillisecond));
+        break;
     default: {
         cerr << "WARNING: CASE '" << _testCase << "' NOT FOUND." << endl;
         s_testStatus = -1;
     } break;
     }
 
+#ifdef BSLS_PLATFORM_OS_LINUX
+    if (_testCase < 0) {
+        benchmark::Initialize(&argc, argv);
+        benchmark::RunSpecifiedBenchmarks();
+    }
+#endif
+
     mwcsys::Time::shutdown();
     bmqt::UriParser::shutdown();
     bmqp::ProtocolUtil::shutdown();
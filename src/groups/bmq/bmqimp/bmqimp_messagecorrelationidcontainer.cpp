@@ -252,12 +252,10 @@ bool MessageCorrelationIdContainer::iterateAndInvoke(const KeyIdsCb& callback)
     return true;
 }
 
-bool MessageCorrelationIdContainer::iterateAndInvoke(
+bool MessageCorrelationIdContainer::iterateAndInvokeLocked(
     const bsl::vector<bmqt::MessageGUID>& keys,
     const KeyIdsCb&                       callback)
 {
-    bsls::SpinLockGuard guard(&d_lock);  // LOCK
-
     for (size_t i = 0; i < keys.size(); ++i) {
         CorrelationIdsMap::const_iterator cit = d_correlationIds.find(keys[i]);
         if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(cit ==
@@ -278,6 +276,45 @@ bool MessageCorrelationIdContainer::iterateAndInvoke(
     return true;
 }
 
+bool MessageCorrelationIdContainer::iterateAndInvoke(
+    const bsl::vector<bmqt::MessageGUID>& keys,
+    const KeyIdsCb&                       callback)
+{
+    bsls::SpinLockGuard guard(&d_lock);  // LOCK
+
+    return iterateAndInvokeLocked(keys, callback);
+}
+
+bool MessageCorrelationIdContainer::iterateAndInvoke(
+    const bmqp::QueueId&     queueId,
+    const bmqt::MessageGUID& key,
+    const KeyIdsCb&          callback)
+{
+    bsls::SpinLockGuard guard(&d_lock);  // LOCK
+
+    QueueItemsMap::const_iterator qit = d_queueItems.find(queueId);
+    if (qit == d_queueItems.end() ||
+        qit->second.find(key) == qit->second.end()) {
+        // All the items up to 'key' have already been removed (e.g. NACKed
+        // locally on expiration, which happens in sent order).
+        return true;  // RETURN
+    }
+
+    // Collect the keys first, since invoking the 'callback' may remove the
+    // items from 'd_queueItems'.
+    bsl::vector<bmqt::MessageGUID> keys(d_allocator_p);
+    for (HandleAndExpirationTimeMap::const_iterator hit = qit->second.begin();
+         hit != qit->second.end();
+         ++hit) {
+        keys.push_back(hit->first);
+        if (hit->first == key) {
+            break;  // BREAK
+        }
+    }
+
+    return iterateAndInvokeLocked(keys, callback);
+}
+
 bsls::TimeInterval MessageCorrelationIdContainer::getExpiredIds(
     bsl::vector<bmqt::MessageGUID>*     keys,
     const bsl::unordered_map<int, int>& queueExpirationTimeoutMap,
@@ -174,6 +174,14 @@ class MessageCorrelationIdContainer {
     void removeQueueItem(const bmqp::QueueId&     queueId,
                          const bmqt::MessageGUID& itemGUID);
 
+    /// Iterate and invoke the specified `callback` on every item that has
+    /// a key listed in the specified `keys`.  Return true if the iteration
+    /// was not interrupted, false otherwise.  The caller must acquire the
+    /// `d_lock` before calling this method.
+    bool
+    iterateAndInvokeLocked(const bsl::vector<bmqt::MessageGUID>& keys,
+                           const KeyIdsCb&                       callback);
+
   private:
     // NOT IMPLEMENTED
     MessageCorrelationIdContainer(const MessageCorrelationIdContainer&)
@@ -236,6 +244,16 @@ class MessageCorrelationIdContainer {
     bool iterateAndInvoke(const bsl::vector<bmqt::MessageGUID>& keys,
                           const KeyIdsCb&                       callback);
 
+    /// Iterate, in the order they were sent, over the PUT messages with
+    /// `ACK_REQUESTED` flag of the queue with the specified `queueId` up to
+    /// and including the one having the specified `key`, and invoke the
+    /// specified `callback` on each of them.  Do nothing if no such message
+    /// has the `key`.  Return true if the iteration was not interrupted,
+    /// false otherwise.  This is used to expand a cumulative ACK.
+    bool iterateAndInvoke(const bmqp::QueueId&     queueId,
+                          const bmqt::MessageGUID& key,
+                          const KeyIdsCb&          callback);
+
     /// Fill the specified `keys` with keys of the items with the expiration
     /// time less or equal to the specified `expirationTime`.  The
     /// expiration time is calculated by adding the queue expiration timeout
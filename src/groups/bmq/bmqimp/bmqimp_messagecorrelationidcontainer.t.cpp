@@ -19,15 +19,18 @@
 // BMQ
 #include <bmqimp_queue.h>
 #include <bmqp_messageguidgenerator.h>
+#include <bmqp_protocol.h>
 #include <bmqt_correlationid.h>
 #include <bmqt_messageguid.h>
 
 // BDE
+#include <bdlbb_blob.h>
 #include <bdlf_bind.h>
 #include <bsl_functional.h>
 #include <bsl_unordered_map.h>
 #include <bsl_vector.h>
 #include <bslma_allocator.h>
+#include <bsls_timeinterval.h>
 
 // TEST DRIVER
 #include <mwctst_testhelper.h>
@@ -77,6 +80,43 @@ struct IterateAndInvokeHelper {
     }
 };
 
+/// Append the specified `handle` to the specified `handles` and set the
+/// specified `deleteVisitedItem` to `true`.  The specified `qac` is unused.
+static bool removeAndRecord(bsl::vector<bmqt::MessageGUID>* handles,
+                            bool*                           deleteVisitedItem,
+                            const bmqt::MessageGUID&        handle,
+                            const QAC&                      qac)
+{
+    (void)qac;
+
+    handles->push_back(handle);
+    *deleteVisitedItem = true;
+
+    return false;  // do not interrupt
+}
+
+/// Add to the specified `container` an item with the specified `guid` for
+/// the specified `queueId` and associate it with a PUT message with
+/// `ACK_REQUESTED` flag.
+static void addPut(bmqimp::MessageCorrelationIdContainer* container,
+                   const bmqt::MessageGUID&               guid,
+                   int                                    queueId)
+{
+    container->add(guid, bmqt::CorrelationId(queueId), bmqp::QueueId(queueId));
+
+    int flags = 0;
+    bmqp::PutHeaderFlagUtil::setFlag(&flags,
+                                     bmqp::PutHeaderFlags::e_ACK_REQUESTED);
+
+    bmqp::PutHeader header;
+    header.setMessageGUID(guid).setQueueId(queueId).setFlags(flags);
+
+    bdlbb::Blob appData(s_allocator_p);
+    container->associateMessageData(header,
+                                    appData,
+                                    bsls::TimeInterval(queueId));
+}
+
 // ============================================================================
 //                                    TESTS
 // ----------------------------------------------------------------------------
@@ -213,6 +253,69 @@ static void test3_associate()
     }
 }
 
+static void test4_iterateAndInvokeUpTo()
+{
+    mwctst::TestHelper::printTestName("ITERATE AND INVOKE UP TO");
+
+    bmqimp::MessageCorrelationIdContainer container(s_allocator_p);
+    bsl::vector<bmqt::MessageGUID>        handles(s_allocator_p);
+
+    bmqt::MessageGUID guid1 = bmqp::MessageGUIDGenerator::testGUID();
+    bmqt::MessageGUID guid2 = bmqp::MessageGUIDGenerator::testGUID();
+    bmqt::MessageGUID guid3 = bmqp::MessageGUIDGenerator::testGUID();
+    bmqt::MessageGUID guid4 = bmqp::MessageGUIDGenerator::testGUID();
+
+    Callback callback = bdlf::BindUtil::bind(&removeAndRecord,
+                                             &handles,
+                                             bdlf::PlaceHolders::_1,
+                                             bdlf::PlaceHolders::_2,
+                                             bdlf::PlaceHolders::_3);
+
+    // Insert into container: 3 PUTs for queue 1 interleaved with one PUT for
+    // queue 2.
+    addPut(&container, guid1, 1);
+    addPut(&container, guid2, 2);
+    addPut(&container, guid3, 1);
+    addPut(&container, guid4, 1);
+
+    ASSERT_EQ(container.numberOfPuts(), 4U);
+
+    {
+        PVV("Unknown key");
+        ASSERT(container.iterateAndInvoke(bmqp::QueueId(2), guid1, callback));
+        ASSERT(handles.empty());
+        ASSERT_EQ(container.size(), 4U);
+    }
+
+    {
+        PVV("Up to a key in the middle");
+        ASSERT(container.iterateAndInvoke(bmqp::QueueId(1), guid3, callback));
+        ASSERT_EQ(handles.size(), 2U);
+        ASSERT_EQ(handles[0], guid1);
+        ASSERT_EQ(handles[1], guid3);
+        ASSERT_EQ(container.size(), 2U);
+    }
+
+    {
+        PVV("Already removed key");
+        handles.clear();
+        ASSERT(container.iterateAndInvoke(bmqp::QueueId(1), guid1, callback));
+        ASSERT(handles.empty());
+        ASSERT_EQ(container.size(), 2U);
+    }
+
+    {
+        PVV("Up to the last key");
+        ASSERT(container.iterateAndInvoke(bmqp::QueueId(1), guid4, callback));
+        ASSERT_EQ(handles.size(), 1U);
+        ASSERT_EQ(handles[0], guid4);
+        ASSERT_EQ(container.size(), 1U);
+
+        bmqt::CorrelationId corrId;
+        ASSERT_EQ(container.find(&corrId, guid2), 0);
+    }
+}
+
 // ============================================================================
 //                                 MAIN PROGRAM
 // ----------------------------------------------------------------------------
@@ -223,6 +326,7 @@ int main(int argc, char* argv[])
 
     switch (_testCase) {
     case 0:
+    case 4: test4_iterateAndInvokeUpTo(); break;
     case 3: test3_associate(); break;
     case 2: test2_iterateAndInvoke(); break;
     case 1: test1_addFindRemove(); break;
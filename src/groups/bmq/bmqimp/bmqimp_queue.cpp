@@ -317,7 +317,7 @@ Queue::Queue(bslma::Allocator* allocator)
 , d_pendingConfigureId(k_INVALID_CONFIGURE_ID)
 , d_requestGroupId()
 , d_correlationId()
-, d_stats_mp(0)
+, d_stats_sp()
 , d_isSuspended(false)
 , d_isOldStyle(true)
 , d_isSuspendedWithBroker(false)
@@ -344,41 +344,54 @@ void Queue::registerStatContext(mwcst::StatContext* parentStatContext)
     BSLS_ASSERT_SAFE(d_uri.isValid() &&
                      "Can not call registerStatContext on an empty queue");
     // This method should only be called on a valid queue, with an URI
-    BSLS_ASSERT_SAFE(d_stats_mp == 0 && "Stats already initialized");
+    BSLS_ASSERT_SAFE(!d_stats_sp && "Stats already initialized");
     BSLS_ASSERT_SAFE(d_state == static_cast<int>(QueueState::e_OPENED) &&
                      "Queue must be opened before registerStatContext()");
 
     // Create subContext
     bdlma::LocalSequentialAllocator<2048> localAllocator(d_allocator_p);
 
-    d_stats_mp = parentStatContext->addSubcontext(
-        mwcst::StatContextConfiguration(d_uri.asString(), &localAllocator));
+    d_stats_sp = bsl::shared_ptr<mwcst::StatContext>(
+        parentStatContext->addSubcontext(
+            mwcst::StatContextConfiguration(d_uri.asString(),
+                                            &localAllocator)),
+        d_allocator_p);
 }
 
 void Queue::statUpdateOnMessage(int size, bool isOut)
 {
     // PRECONDITIONS
-    BSLS_ASSERT_SAFE(d_stats_mp.get() &&
+    BSLS_ASSERT_SAFE(d_stats_sp.get() &&
                      "registerStatContext() has not been called");
 
-    d_stats_mp->adjustValue((isOut ? k_STAT_OUT : k_STAT_IN), size);
+    statUpdateOnMessage(d_stats_sp.get(), size, isOut);
+}
+
+void Queue::statUpdateOnMessage(mwcst::StatContext* statContext,
+                                int                 size,
+                                bool                isOut)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(statContext);
+
+    statContext->adjustValue((isOut ? k_STAT_OUT : k_STAT_IN), size);
 }
 
 void Queue::statReportCompressionRatio(double ratio)
 {
     // PRECONDITIONS
-    BSLS_ASSERT_SAFE(d_stats_mp.get() &&
+    BSLS_ASSERT_SAFE(d_stats_sp.get() &&
                      "registerStatContext() has not been called");
     BSLS_ASSERT_SAFE(ratio > 0);
 
     const bsls::Types::Int64 value = static_cast<bsls::Types::Int64>(
         ratio * k_COMPRESSION_RATIO_PRECISION_FACTOR);
-    d_stats_mp->adjustValue(k_STAT_COMPRESSION_RATIO, value);
+    d_stats_sp->adjustValue(k_STAT_COMPRESSION_RATIO, value);
 }
 
 void Queue::clearStatContext()
 {
-    d_stats_mp.clear();
+    d_stats_sp.reset();
 }
 
 bsl::ostream&
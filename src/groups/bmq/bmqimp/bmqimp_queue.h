@@ -46,6 +46,7 @@
 
 // BDE
 #include <bsl_iosfwd.h>
+#include <bsl_memory.h>
 #include <bsl_optional.h>
 #include <bsl_string.h>
 #include <bslma_allocator.h>
@@ -227,11 +228,13 @@ class Queue {
     // User-specified correlation id of the
     // queue
 
-    bslma::ManagedPtr<mwcst::StatContext> d_stats_mp;
+    bsl::shared_ptr<mwcst::StatContext> d_stats_sp;
     // Stats context associated to this
     // queue.  Valid only if the queue is
     // open and 'registerStatContext()' has
-    // been called
+    // been called.  Shared so that a
+    // thread updating the stats keeps it
+    // alive while the queue is closed
 
     bsls::AtomicBool d_isSuspended;
     // Whether the queue is suspended.
@@ -316,13 +319,22 @@ class Queue {
     /// sent (if `isOut` is true).
     void statUpdateOnMessage(int size, bool isOut);
 
+    /// Update the specified `statContext`, associated to a queue, by
+    /// reporting a new message of the specified `size` was received (if the
+    /// specified `isOut` is false) or sent (if `isOut` is true).
+    static void statUpdateOnMessage(mwcst::StatContext* statContext,
+                                    int                 size,
+                                    bool                isOut);
+
     /// Update the stats of this queue by reporting a new message has been
     /// compressed with the specified compression `ratio`.
     void statReportCompressionRatio(double ratio);
 
     /// Clears the stat context associated to this queue (typically used
     /// when this queue is closed, after the session has been stopped to
-    /// reinitialize the state before a new start).
+    /// reinitialize the state before a new start).  Note that the stat
+    /// context is only destroyed once released by the threads holding it,
+    /// as obtained from `statContextSp`.
     void clearStatContext();
 
     // ACCESSORS
@@ -348,6 +360,7 @@ class Queue {
     bsl::optional<int>                         requestGroupId() const;
     const bmqp_ctrlmsg::QueueHandleParameters& handleParameters() const;
     const mwcst::StatContext*                  statContext() const;
+    const bsl::shared_ptr<mwcst::StatContext>& statContextSp() const;
     bool                                       isSuspended() const;
 
     /// Return the corresponding member of this object.
@@ -601,7 +614,12 @@ Queue::handleParameters() const
 
 inline const mwcst::StatContext* Queue::statContext() const
 {
-    return d_stats_mp.get();
+    return d_stats_sp.get();
+}
+
+inline const bsl::shared_ptr<mwcst::StatContext>& Queue::statContextSp() const
+{
+    return d_stats_sp;
 }
 
 inline bool Queue::isSuspended() const
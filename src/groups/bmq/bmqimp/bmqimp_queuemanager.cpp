@@ -18,6 +18,7 @@
 
 #include <bmqscm_version.h>
 // BMQ
+#include <bmqp_messagetrace.h>
 #include <bmqp_optionsview.h>
 #include <bmqp_protocol.h>
 #include <bmqt_queueflags.h>
@@ -353,6 +354,10 @@ int QueueManager::onPushEvent(QueueManager::EventInfos* eventInfos,
 
     while (
         BSLS_PERFORMANCEHINT_PREDICT_LIKELY((rc = msgIterator.next()) == 1)) {
+        bmqp::MessageTraceUtil::recordHop(
+            msgIterator.header().messageGUID(),
+            bmqp::MessageTraceHop::e_SDK_PUSH_IN);
+
         // Check options
         BSLS_ASSERT_SAFE(msgIterator.hasOptions());
 
@@ -428,27 +433,47 @@ int QueueManager::updateStatsOnPutEvent(
         ,
         rc_ITERATION_ERROR = -1  // An error was encountered while iterating
         ,
-        rc_INVALID_QUEUE = -2  // Queue not valid or not opened with write
-                               // flags
+        rc_INVALID_QUEUE = -2  // Queue not found, not valid or not opened
+                               // with write flags
     };
 
     *messageCount = 0;
 
-    bmqp::PutMessageIterator putIterator(iterator, d_allocator_p);
-    int                      rc = rc_SUCCESS;
-
-    bsls::SpinLockGuard guard(&d_queuesLock);  // d_queuesLock LOCKED
+    bmqp::PutMessageIterator            putIterator(iterator, d_allocator_p);
+    int                                 rc = rc_SUCCESS;
+    QueueSp                             queue;
+    bsl::shared_ptr<mwcst::StatContext> statContext;
 
     // Iterate over the messages to validate queues and update their associated
-    // stats.
+    // stats.  Note that this method is invoked concurrently by all the
+    // threads posting to the session, so the queue is only looked up (under
+    // the lock) when it differs from the one of the previous message: events
+    // usually contain many messages for the same queue, and stats are updated
+    // without holding the lock.  The stat context of the queue is obtained
+    // under the lock as well, and held until done, because the queue may be
+    // concurrently closed (see 'removeQueue'), which clears its stat context.
     while (
         BSLS_PERFORMANCEHINT_PREDICT_LIKELY((rc = putIterator.next()) == 1)) {
         // NOTE: We don't need to verify that queueId is valid (i.e.
-        //       '< d_numQueues') because we assert that looking up a queue
-        //       succeeds.
+        //       '< d_numQueues') because looking up a queue fails otherwise.
+        bmqp::MessageTraceUtil::recordHop(
+            putIterator.header().messageGUID(),
+            bmqp::MessageTraceHop::e_SDK_PUT);
+
         const bmqp::QueueId queueId(putIterator.header().queueId());
-        const QueueSp&      queue = lookupQueueLocked(queueId);
-        BSLS_ASSERT_SAFE(queue);
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                !queue || queue->id() != queueId.id())) {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+            bsls::SpinLockGuard guard(&d_queuesLock);  // d_queuesLock LOCKED
+            queue = lookupQueueLocked(queueId);
+            if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!queue)) {
+                BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+                // The queue was closed concurrently
+                return rc * 10 + rc_INVALID_QUEUE;  // RETURN
+            }
+            statContext = queue->statContextSp();
+        }
 
         // Check that the queue is writable and is valid, which means not only
         // the OPENED state but it also may be in PENDING or REOPENING states
@@ -462,8 +487,9 @@ int QueueManager::updateStatsOnPutEvent(
 
         // When executed as a part of unit test, queue stat context may be
         // not initialized
-        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(queue->statContext())) {
-            queue->statUpdateOnMessage(putIterator.applicationDataSize(),
+        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(statContext)) {
+            Queue::statUpdateOnMessage(statContext.get(),
+                                       putIterator.applicationDataSize(),
                                        true);
         }
 
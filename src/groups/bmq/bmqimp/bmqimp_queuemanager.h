@@ -324,8 +324,10 @@ class QueueManager {
     /// Update stats for the queue(s) corresponding to the messages pointed
     /// to by the specified `iterator` and populate the specified
     /// `messageCount` with the number of messages iterated.  Return 0 on
-    /// success, and non-zero on error.  The behavior is undefined unless
-    /// `iterator` is valid.
+    /// success, and non-zero on error, including if a queue is not found.
+    /// The behavior is undefined unless `iterator` is valid.  Note that this
+    /// method may be called concurrently with `removeQueue` and the
+    /// clearing of the stat context of the removed queue.
     int updateStatsOnPutEvent(int*                            messageCount,
                               const bmqp::PutMessageIterator& iterator);
 
@@ -29,8 +29,11 @@
 // BDE
 #include <bdlbb_blobutil.h>
 #include <bdlbb_pooledblobbufferfactory.h>
+#include <bdlf_bind.h>
 #include <bsl_string.h>
 #include <bsl_vector.h>
+#include <bslmt_barrier.h>
+#include <bslmt_threadutil.h>
 #include <bsls_assert.h>
 #include <bsls_types.h>
 
@@ -79,6 +82,20 @@ void enableQueueStat(bmqimp::QueueManager::QueueSp& queueSp)
     queueSp->registerStatContext(pStatContext);
 }
 
+/// Wait on the specified `barrier`, then update the stats of the specified
+/// `queueManager` with the PUT event pointed to by the specified `iterator`,
+/// and load the result into the specified `rc` and the number of messages
+/// iterated into the specified `messageCount`.
+void updateStatsOnPutEventThread(bmqimp::QueueManager*           queueManager,
+                                 const bmqp::PutMessageIterator* iterator,
+                                 bslmt::Barrier*                 barrier,
+                                 int*                            rc,
+                                 int*                            messageCount)
+{
+    barrier->wait();
+    *rc = queueManager->updateStatsOnPutEvent(messageCount, *iterator);
+}
+
 }  // close unnamed namespace
 
 // ============================================================================
@@ -716,8 +733,7 @@ static void test10_putStatsTest()
     rawEvent.loadPutMessageIterator(&msgIterator);
 
     // Fails due to no queues
-    ASSERT_SAFE_FAIL(
-        obj.updateStatsOnPutEvent(&eventMessageCount, msgIterator));
+    ASSERT_NE(obj.updateStatsOnPutEvent(&eventMessageCount, msgIterator), 0);
 
     // Add a queue with enabled statistics
     queueSp.createInplace(s_allocator_p, s_allocator_p);
@@ -740,6 +756,116 @@ static void test10_putStatsTest()
     ASSERT_EQ(eventMessageCount, 1);
 }
 
+static void test11_putStatsConcurrentCloseTest()
+// --------------------------------------------------------------------
+// PUT EVENT STATISTICS WITH CONCURRENT CLOSE TEST
+//
+// Concerns:
+//   Updating the stats of a PUT event from a posting thread while the
+//   queue is closed (removed and having its stat context cleared) from
+//   another thread neither accesses a destroyed stat context nor fails
+//   otherwise than by reporting an invalid queue.
+//
+// Plan:
+//   1) Create a bmqp::Event containing many PUT messages for a queue
+//   2) Repeatedly insert the queue with a new stat context, update the
+//      stats of the event from another thread, and concurrently remove
+//      the queue and clear its stat context
+//   3) Verify that each update either counted all the messages or
+//      failed, and that the stat context is released
+//
+// Testing:
+//   bmqimp::QueueManager::updateStatsOnPutEvent
+//   bmqimp::QueueManager::removeQueue
+//   bmqimp::Queue::clearStatContext
+// --------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName(
+        "PUT EVENT STATISTICS WITH CONCURRENT CLOSE");
+
+    const char k_URI[]          = "bmq://ts.trades.myapp/my.queue";
+    const char k_PAYLOAD[]      = "abcdefghijklmnopqrstuvwxyz";
+    const int  k_NUM_MESSAGES   = 1000;
+    const int  k_NUM_ITERATIONS = 100;
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(1024, s_allocator_p);
+    bmqp::PutEventBuilder          peb(&bufferFactory, s_allocator_p);
+    bmqt::Uri                      uri(k_URI, s_allocator_p);
+    bmqp::QueueId            queueId(bmqimp::Queue::k_INVALID_QUEUE_ID);
+    bmqp::PutMessageIterator msgIterator(&bufferFactory, s_allocator_p);
+    bsls::Types::Uint64      flags = 0;
+
+    bmqimp::QueueManager obj(s_allocator_p);
+    obj.generateQueueAndSubQueueId(&queueId, uri, flags);
+    bmqt::QueueFlagsUtil::setWriter(&flags);
+
+    for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+        peb.startMessage();
+        peb.setMessagePayload(k_PAYLOAD, sizeof(k_PAYLOAD) - 1);
+        BSLS_ASSERT_OPT(peb.packMessage(queueId.id()) ==
+                        bmqt::EventBuilderResult::e_SUCCESS);
+    }
+
+    bmqp::Event rawEvent(&peb.blob(), s_allocator_p);
+    BSLS_ASSERT_OPT(rawEvent.isPutEvent());
+    rawEvent.loadPutMessageIterator(&msgIterator);
+
+    // The parent of the stat contexts of the queue must outlive them
+    mwcst::StatContextConfiguration config("stats", s_allocator_p);
+    mwcst::StatContext              rootStatContext(config, s_allocator_p);
+    bmqimp::Stat                    queuesStats(s_allocator_p);
+    bmqimp::QueueStatsUtil::initializeStats(
+        &queuesStats,
+        &rootStatContext,
+        mwcst::StatValue::SnapshotLocation(0, 0),
+        mwcst::StatValue::SnapshotLocation(0, 1),
+        s_allocator_p);
+
+    for (int i = 0; i < k_NUM_ITERATIONS; ++i) {
+        bmqimp::QueueManager::QueueSp queueSp;
+        queueSp.createInplace(s_allocator_p, s_allocator_p);
+        (*queueSp)
+            .setUri(uri)
+            .setId(queueId.id())
+            .setSubQueueId(queueId.subId())
+            .setFlags(flags)
+            .setCorrelationId(bmqt::CorrelationId::autoValue())
+            .setState(bmqimp::QueueState::e_OPENED);
+        queueSp->registerStatContext(queuesStats.d_statContext_mp.get());
+        obj.insertQueue(queueSp);
+
+        bslmt::Barrier            barrier(2);
+        int                       rc           = -1;
+        int                       messageCount = 0;
+        bslmt::ThreadUtil::Handle handle;
+        ASSERT_EQ(0,
+                  bslmt::ThreadUtil::create(
+                      &handle,
+                      bdlf::BindUtil::bind(&updateStatsOnPutEventThread,
+                                           &obj,
+                                           &msgIterator,
+                                           &barrier,
+                                           &rc,
+                                           &messageCount)));
+
+        // Close the queue while its stats are being updated
+        barrier.wait();
+        ASSERT_EQ(obj.removeQueue(queueSp.get()), queueSp);
+        queueSp->clearStatContext();
+
+        bslmt::ThreadUtil::join(handle);
+
+        ASSERT_EQ(queueSp->statContext(),
+                  static_cast<const mwcst::StatContext*>(0));
+        if (rc == 0) {
+            ASSERT_EQ(messageCount, k_NUM_MESSAGES);
+        }
+        else {
+            ASSERT_LT(messageCount, k_NUM_MESSAGES);
+        }
+    }
+}
+
 }  // close unnamed namespace
 
 // ============================================================================
@@ -758,6 +884,7 @@ int main(int argc, char* argv[])
 
     switch (_testCase) {
     case 0:
+    case 11: test11_putStatsConcurrentCloseTest(); break;
     case 10: test10_putStatsTest(); break;
     case 9: test9_pushStatsTest(); break;
     case 8: test8_substreamCountTest(); break;
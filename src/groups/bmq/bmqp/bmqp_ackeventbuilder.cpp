@@ -39,6 +39,7 @@ AckEventBuilder::AckEventBuilder(bdlbb::BlobBufferFactory* bufferFactory,
                                  bslma::Allocator*         allocator)
 : d_blob(bufferFactory, allocator)
 , d_msgCount(0)
+, d_flags(0)
 {
     reset();
 }
@@ -66,7 +67,19 @@ void AckEventBuilder::reset()
     new (d_blob.buffer(0).data()) EventHeader(EventType::e_ACK);
 
     // AckHeader
-    new (d_blob.buffer(0).data() + sizeof(EventHeader)) AckHeader();
+    AckHeader* ackHeader = new (d_blob.buffer(0).data() + sizeof(EventHeader))
+        AckHeader();
+    ackHeader->setFlags(d_flags);
+}
+
+void AckEventBuilder::setFlags(unsigned char value)
+{
+    d_flags = value;
+
+    // Following is valid (see comment in reset).
+    AckHeader& ackHeader = *reinterpret_cast<AckHeader*>(
+        d_blob.buffer(0).data() + sizeof(EventHeader));
+    ackHeader.setFlags(value);
 }
 
 bmqt::EventBuilderResult::Enum
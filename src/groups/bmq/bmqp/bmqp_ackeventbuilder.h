@@ -89,6 +89,9 @@ class AckEventBuilder BSLS_CPP11_FINAL {
     int d_msgCount;              // number of messages currently in the
                                  // event
 
+    unsigned char d_flags;  // flags of the 'AckHeader' of the event, see
+                            // 'AckHeaderFlags'
+
   private:
     // NOT IMPLEMENTED
     AckEventBuilder(const AckEventBuilder&) BSLS_CPP11_DELETED;
@@ -115,6 +118,11 @@ class AckEventBuilder BSLS_CPP11_FINAL {
     /// content of the blob returned by the `blob()` method.
     void reset();
 
+    /// Set the flags of the `AckHeader` of the event being built to the
+    /// specified `value` (see `AckHeaderFlags`).  Note that the flags are
+    /// preserved across calls to `reset()`.
+    void setFlags(unsigned char value);
+
     /// Append an AckMessage for the specified `status`, `correlationId`,
     /// `guid` and `queueId` to the event being built.  Return 0 if the
     /// message was successfully added, or a non-zero code if it failed (due
@@ -129,6 +137,9 @@ class AckEventBuilder BSLS_CPP11_FINAL {
     /// Return the number of messages currently in the event being built.
     int messageCount() const;
 
+    /// Return the flags of the `AckHeader` of the event being built.
+    unsigned char flags() const;
+
     /// Return the maximum number of messages that can be added to this
     /// event, with respect to protocol limitations.
     int maxMessageCount() const;
@@ -156,6 +167,11 @@ inline int AckEventBuilder::messageCount() const
     return d_msgCount;
 }
 
+inline unsigned char AckEventBuilder::flags() const
+{
+    return d_flags;
+}
+
 inline int AckEventBuilder::maxMessageCount() const
 {
     static const int res = (EventHeader::k_MAX_SIZE_SOFT -
@@ -19,11 +19,13 @@
 // BMQ
 #include <bmqp_ackmessageiterator.h>
 #include <bmqp_event.h>
+#include <bmqp_protocolutil.h>
 #include <bmqt_messageguid.h>
 #include <bmqt_resultcode.h>
 
 // MWC
 #include <mwcu_memoutstream.h>
+#include <mwcu_printutil.h>
 
 // BDE
 #include <bdlb_guid.h>
@@ -32,12 +34,21 @@
 #include <bdlbb_blobutil.h>
 #include <bdlbb_pooledblobbufferfactory.h>
 #include <bdlf_bind.h>
+#include <bdlt_timeunitratio.h>
 #include <bsl_fstream.h>
 #include <bsl_vector.h>
+#include <bsls_assert.h>
+#include <bsls_timeutil.h>
+#include <bsls_types.h>
 
 // TEST DRIVER
 #include <mwctst_testhelper.h>
 
+// BENCHMARKING LIBRARY
+#ifdef BSLS_PLATFORM_OS_LINUX
+#include <benchmark/benchmark.h>
+#endif
+
 // CONVENIENCE
 using namespace BloombergLP;
 using namespace bsl;
@@ -128,6 +139,108 @@ static void verifyContent(const bmqp::AckEventBuilder& builder,
     ASSERT_EQ(iter.isValid(), false);
 }
 
+/// Numbers of messages of the ACK events built by the benchmarks.
+const int k_BENCH_NUM_MESSAGES[] = {1, 8, 64, 512, 4096};
+
+const int k_NUM_BENCH_NUM_MESSAGES = sizeof(k_BENCH_NUM_MESSAGES) /
+                                     sizeof(*k_BENCH_NUM_MESSAGES);
+
+/// Number of queues the messages of the ACK events built by the benchmarks
+/// are spread over.
+const int k_BENCH_NUM_QUEUES = 4;
+
+/// One message out of this many of the ACK events built by the benchmarks
+/// reports a failure, the others reporting a success.
+const int k_BENCH_FAILURE_PERIOD = 16;
+
+/// Load into the specified `guids` the specified `numMessages` distinct
+/// GUIDs, in the order of the PUT messages they acknowledge.
+void makeBenchGUIDs(bsl::vector<bmqt::MessageGUID>* guids, int numMessages)
+{
+    unsigned char buffer[bmqt::MessageGUID::e_SIZE_BINARY] = {0};
+
+    guids->resize(numMessages);
+    for (int i = 0; i < numMessages; ++i) {
+        buffer[0] = static_cast<unsigned char>(i >> 8);
+        buffer[1] = static_cast<unsigned char>(i);
+        (*guids)[i].fromBinary(buffer);
+    }
+}
+
+/// Build with the specified `builder` an ACK event acknowledging the
+/// messages having the specified `guids`, each with its own correlationId,
+/// the queues being assigned round robin, and one message out of
+/// `k_BENCH_FAILURE_PERIOD` reporting a failure.
+void buildBenchEvent(bmqp::AckEventBuilder*                builder,
+                     const bsl::vector<bmqt::MessageGUID>& guids)
+{
+    const int success = bmqp::ProtocolUtil::ackResultToCode(
+        bmqt::AckResult::e_SUCCESS);
+    const int failure = bmqp::ProtocolUtil::ackResultToCode(
+        bmqt::AckResult::e_LIMIT_MESSAGES);
+
+    builder->reset();
+    for (int i = 0; i < static_cast<int>(guids.size()); ++i) {
+        const int status = (i + 1) % k_BENCH_FAILURE_PERIOD == 0 ? failure
+                                                                   : success;
+        const bmqt::EventBuilderResult::Enum rc = builder->appendMessage(
+            status,
+            i,
+            guids[i],
+            i % k_BENCH_NUM_QUEUES);
+        BSLS_ASSERT_OPT(rc == bmqt::EventBuilderResult::e_SUCCESS);
+        (void)rc;
+    }
+}
+
+/// Iterate over the messages of the ACK event in the specified `blob`,
+/// decoding the status of each message as a producer does when notified of
+/// the result of its PUT.  Return the number of messages reporting a
+/// failure.
+int iterateBenchEvent(const bdlbb::Blob& blob)
+{
+    bmqp::Event              event(&blob, s_allocator_p);
+    bmqp::AckMessageIterator iterator;
+
+    event.loadAckMessageIterator(&iterator);
+
+    int numFailures = 0;
+    while (iterator.next() == 1) {
+        const bmqt::AckResult::Enum result =
+            bmqp::ProtocolUtil::ackResultFromCode(iterator.message().status());
+        if (result != bmqt::AckResult::e_SUCCESS) {
+            ++numFailures;
+        }
+    }
+
+    return numFailures;
+}
+
+/// Print the specified `totalTimeNs` taken by the specified `numIterations`
+/// on ACK events of the specified `numMessages` messages.
+void printBenchResult(int                numMessages,
+                      int                numIterations,
+                      bsls::Types::Int64 totalTimeNs)
+{
+    const bsls::Types::Int64 totalMessages =
+        static_cast<bsls::Types::Int64>(numIterations) * numMessages;
+    const bsls::Types::Int64 totalBytes =
+        totalMessages * static_cast<bsls::Types::Int64>(
+                            sizeof(bmqp::AckMessage));
+
+    cout << "ACKs: " << numMessages << " => "
+         << mwcu::PrintUtil::prettyTimeInterval(totalTimeNs / numIterations)
+         << " per event, "
+         << mwcu::PrintUtil::prettyNumber(totalMessages *
+                                          bdlt::TimeUnitRatio::k_NS_PER_S /
+                                          totalTimeNs)
+         << " ACKs per second, "
+         << mwcu::PrintUtil::prettyBytes(totalBytes *
+                                         bdlt::TimeUnitRatio::k_NS_PER_S /
+                                         totalTimeNs)
+         << " per second\n";
+}
+
 }  // close unnamed namespace
 
 // ============================================================================
@@ -241,6 +354,41 @@ static void test4_capacity()
     ASSERT(obj.eventSize() <= bmqp::EventHeader::k_MAX_SIZE_SOFT);
 }
 
+static void test5_flags()
+{
+    mwctst::TestHelper::printTestName("FLAGS");
+    // Verify that the header flags are written in the event and preserved
+    // across reset.
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(256, s_allocator_p);
+    bmqp::AckEventBuilder          obj(&bufferFactory, s_allocator_p);
+    bsl::vector<Data>              messages(s_allocator_p);
+
+    PVV("Verifying default flags");
+    ASSERT_EQ(obj.flags(), 0);
+
+    PVV("Setting the cumulative flag");
+    obj.setFlags(bmqp::AckHeaderFlags::e_CUMULATIVE);
+    ASSERT_EQ(obj.flags(), bmqp::AckHeaderFlags::e_CUMULATIVE);
+
+    for (int i = 0; i < 2; ++i) {
+        PVV("Appending messages");
+        messages.clear();
+        appendMessages(&obj, &messages, 3);
+        verifyContent(obj, messages);
+
+        PVV("Verifying header flags");
+        bmqp::Event              event(&obj.blob(), s_allocator_p);
+        bmqp::AckMessageIterator iter;
+        event.loadAckMessageIterator(&iter);
+        ASSERT_EQ(iter.isValid(), true);
+        ASSERT_EQ(iter.header().flags(), bmqp::AckHeaderFlags::e_CUMULATIVE);
+
+        PVV("Resetting the builder");
+        obj.reset();
+    }
+}
+
 static void testN1_decodeFromFile()
 // --------------------------------------------------------------------
 // DECODE FROM FILE
@@ -342,6 +490,170 @@ static void testN1_decodeFromFile()
     ASSERT_EQ(iter.isValid(), false);
 }
 
+BSLA_MAYBE_UNUSED
+static void testN2_buildEvent()
+// ------------------------------------------------------------------------
+// BENCHMARK: BUILD ACK EVENT
+//
+// Concerns:
+//   Test the throughput of building ACK events with
+//   'bmqp::AckEventBuilder', depending on the number of messages per
+//   event, each message acknowledging a distinct GUID with its own status
+//   and correlationId.
+//
+// Plan:
+//   - For each number of messages, time the build of a large number of
+//     events and report the average time per event, and the number of
+//     ACKs and bytes of ACK messages per second.
+//
+// Testing:
+//   Throughput of bmqp::AckEventBuilder::appendMessage()
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("BENCHMARK: BUILD ACK EVENT");
+
+    const int k_NUM_ITERS = 1000;
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::AckEventBuilder          builder(&bufferFactory, s_allocator_p);
+    bsl::vector<bmqt::MessageGUID> guids(s_allocator_p);
+
+    for (int n = 0; n < k_NUM_BENCH_NUM_MESSAGES; ++n) {
+        makeBenchGUIDs(&guids, k_BENCH_NUM_MESSAGES[n]);
+
+        // <time>
+        const bsls::Types::Int64 begin = bsls::TimeUtil::getTimer();
+        for (int i = 0; i < k_NUM_ITERS; ++i) {
+            buildBenchEvent(&builder, guids);
+        }
+        const bsls::Types::Int64 end = bsls::TimeUtil::getTimer();
+        // </time>
+
+        ASSERT_EQ(builder.messageCount(), k_BENCH_NUM_MESSAGES[n]);
+        printBenchResult(k_BENCH_NUM_MESSAGES[n], k_NUM_ITERS, end - begin);
+    }
+}
+
+BSLA_MAYBE_UNUSED
+static void testN2_iterateEvent()
+// ------------------------------------------------------------------------
+// BENCHMARK: ITERATE ACK EVENT
+//
+// Concerns:
+//   Test the throughput of iterating over ACK events with
+//   'bmqp::AckMessageIterator' and decoding the status of each message,
+//   depending on the number of messages per event.
+//
+// Plan:
+//   - For each number of messages, build an event and time a large number
+//     of iterations over it, and report the average time per event, and
+//     the number of ACKs and bytes of ACK messages per second.
+//
+// Testing:
+//   Throughput of bmqp::AckMessageIterator
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("BENCHMARK: ITERATE ACK EVENT");
+
+    const int k_NUM_ITERS = 1000;
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::AckEventBuilder          builder(&bufferFactory, s_allocator_p);
+    bsl::vector<bmqt::MessageGUID> guids(s_allocator_p);
+
+    for (int n = 0; n < k_NUM_BENCH_NUM_MESSAGES; ++n) {
+        makeBenchGUIDs(&guids, k_BENCH_NUM_MESSAGES[n]);
+        buildBenchEvent(&builder, guids);
+
+        int numFailures = 0;
+
+        // <time>
+        const bsls::Types::Int64 begin = bsls::TimeUtil::getTimer();
+        for (int i = 0; i < k_NUM_ITERS; ++i) {
+            numFailures = iterateBenchEvent(builder.blob());
+        }
+        const bsls::Types::Int64 end = bsls::TimeUtil::getTimer();
+        // </time>
+
+        ASSERT_EQ(numFailures,
+                  k_BENCH_NUM_MESSAGES[n] / k_BENCH_FAILURE_PERIOD);
+        printBenchResult(k_BENCH_NUM_MESSAGES[n], k_NUM_ITERS, end - begin);
+    }
+}
+
+// Begin Benchmarking Tests
+#ifdef BSLS_PLATFORM_OS_LINUX
+static void testN2_buildEvent_GoogleBenchmark(benchmark::State& state)
+// ------------------------------------------------------------------------
+// BENCHMARK: BUILD ACK EVENT
+//
+// Concerns:
+//   Test the throughput of building ACK events with
+//   'bmqp::AckEventBuilder', depending on the number of messages per
+//   event, provided as the argument of 'state'.
+//
+// Testing:
+//   Throughput of bmqp::AckEventBuilder::appendMessage()
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("GOOGLE BENCHMARK: BUILD ACK EVENT");
+
+    const int numMessages = static_cast<int>(state.range(0));
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::AckEventBuilder          builder(&bufferFactory, s_allocator_p);
+    bsl::vector<bmqt::MessageGUID> guids(s_allocator_p);
+
+    makeBenchGUIDs(&guids, numMessages);
+
+    // <time>
+    for (auto _ : state) {
+        buildBenchEvent(&builder, guids);
+    }
+    // </time>
+
+    state.SetItemsProcessed(state.iterations() * numMessages);
+    state.SetBytesProcessed(state.iterations() * numMessages *
+                            sizeof(bmqp::AckMessage));
+}
+
+static void testN2_iterateEvent_GoogleBenchmark(benchmark::State& state)
+// ------------------------------------------------------------------------
+// BENCHMARK: ITERATE ACK EVENT
+//
+// Concerns:
+//   Test the throughput of iterating over ACK events with
+//   'bmqp::AckMessageIterator' and decoding the status of each message,
+//   depending on the number of messages per event, provided as the
+//   argument of 'state'.
+//
+// Testing:
+//   Throughput of bmqp::AckMessageIterator
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("GOOGLE BENCHMARK: ITERATE ACK EVENT");
+
+    const int numMessages = static_cast<int>(state.range(0));
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::AckEventBuilder          builder(&bufferFactory, s_allocator_p);
+    bsl::vector<bmqt::MessageGUID> guids(s_allocator_p);
+
+    makeBenchGUIDs(&guids, numMessages);
+    buildBenchEvent(&builder, guids);
+
+    // <time>
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(iterateBenchEvent(builder.blob()));
+    }
+    // </time>
+
+    state.SetItemsProcessed(state.iterations() * numMessages);
+    state.SetBytesProcessed(state.iterations() * numMessages *
+                            sizeof(bmqp::AckMessage));
+}
+#endif  // BSLS_PLATFORM_OS_LINUX
+
 // ============================================================================
 //                                 MAIN PROGRAM
 // ----------------------------------------------------------------------------
@@ -352,16 +664,30 @@ int main(int argc, char* argv[])
 
     switch (_testCase) {
     case 0:
+    case 5: test5_flags(); break;
     case 4: test4_capacity(); break;
     case 3: test3_reset(); break;
     case 2: test2_multiMessage(); break;
     case 1: test1_breathingTest(); break;
     case -1: testN1_decodeFromFile(); break;
+    case -2:
+        MWC_BENCHMARK_WITH_ARGS(testN2_buildEvent,
+                                RangeMultiplier(8)->Range(1, 4096));
+        MWC_BENCHMARK_WITH_ARGS(testN2_iterateEvent,
+                                RangeMultiplier(8)->Range(1, 4096));
+        break;
     default: {
         cerr << "WARNING: CASE '" << _testCase << "' NOT FOUND." << endl;
         s_testStatus = -1;
     } break;
     }
 
+#ifdef BSLS_PLATFORM_OS_LINUX
+    if (_testCase < 0) {
+        benchmark::Initialize(&argc, argv);
+        benchmark::RunSpecifiedBenchmarks();
+    }
+#endif
+
     TEST_EPILOG(mwctst::TestHelper::e_CHECK_DEF_GBL_ALLOC);
 }
@@ -109,6 +109,17 @@ ConfirmEventBuilder::appendMessage(int                      queueId,
     return bmqt::EventBuilderResult::e_SUCCESS;
 }
 
+void ConfirmEventBuilder::truncate(int messageCount)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(0 <= messageCount && messageCount <= d_msgCount);
+
+    // Messages are fixed-size and follow the headers, see 'reset'.
+    d_blob.setLength(sizeof(EventHeader) + sizeof(ConfirmHeader) +
+                     messageCount * sizeof(ConfirmMessage));
+    d_msgCount = messageCount;
+}
+
 const bdlbb::Blob& ConfirmEventBuilder::blob() const
 {
     // PRECONDITIONS
@@ -123,6 +123,12 @@ class ConfirmEventBuilder {
     bmqt::EventBuilderResult::Enum
     appendMessage(int queueId, int subQueueId, const bmqt::MessageGUID& guid);
 
+    /// Remove from the event being built all the messages appended after
+    /// the first specified `messageCount` ones, so that a batch of appends
+    /// which failed midway can be rolled back.  The behavior is undefined
+    /// unless `0 <= messageCount <= messageCount()`.
+    void truncate(int messageCount);
+
     // ACCESSORS
 
     /// Return the number of messages currently in the event being built.
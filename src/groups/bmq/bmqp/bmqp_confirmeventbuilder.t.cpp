@@ -24,6 +24,7 @@
 
 // MWC
 #include <mwcu_memoutstream.h>
+#include <mwcu_printutil.h>
 
 // BDE
 #include <bdlb_guid.h>
@@ -32,12 +33,21 @@
 #include <bdlbb_blobutil.h>
 #include <bdlbb_pooledblobbufferfactory.h>
 #include <bdlf_bind.h>
+#include <bdlt_timeunitratio.h>
 #include <bsl_fstream.h>
 #include <bsl_vector.h>
+#include <bsls_assert.h>
+#include <bsls_timeutil.h>
+#include <bsls_types.h>
 
 // TEST DRIVER
 #include <mwctst_testhelper.h>
 
+// BENCHMARKING LIBRARY
+#ifdef BSLS_PLATFORM_OS_LINUX
+#include <benchmark/benchmark.h>
+#endif
+
 // CONVENIENCE
 using namespace BloombergLP;
 using namespace bsl;
@@ -125,6 +135,108 @@ static void verifyContent(const bmqp::ConfirmEventBuilder& builder,
     ASSERT_EQ(iter.isValid(), false);
 }
 
+/// Numbers of messages of the CONFIRM events built by the benchmarks.
+const int k_BENCH_NUM_MESSAGES[] = {1, 8, 64, 512, 4096};
+
+const int k_NUM_BENCH_NUM_MESSAGES = sizeof(k_BENCH_NUM_MESSAGES) /
+                                     sizeof(*k_BENCH_NUM_MESSAGES);
+
+/// Number of subscriptions, each identified by a queueId and a subQueueId,
+/// the messages of the CONFIRM events built by the benchmarks are spread
+/// over.
+const int k_BENCH_NUM_SUBSCRIPTIONS = 4;
+
+/// Number of consecutive messages of the CONFIRM events built by the
+/// benchmarks belonging to the same subscription, as a consumer confirms
+/// the messages of a PUSH event at once.
+const int k_BENCH_RUN_LENGTH = 8;
+
+/// Load into the specified `guids` the specified `numMessages` distinct
+/// GUIDs, in the order of the PUSH messages they confirm.
+void makeBenchGUIDs(bsl::vector<bmqt::MessageGUID>* guids, int numMessages)
+{
+    unsigned char buffer[bmqt::MessageGUID::e_SIZE_BINARY] = {0};
+
+    guids->resize(numMessages);
+    for (int i = 0; i < numMessages; ++i) {
+        buffer[0] = static_cast<unsigned char>(i >> 8);
+        buffer[1] = static_cast<unsigned char>(i);
+        (*guids)[i].fromBinary(buffer);
+    }
+}
+
+/// Build with the specified `builder` a CONFIRM event confirming the
+/// messages having the specified `guids`, by runs of `k_BENCH_RUN_LENGTH`
+/// messages of the same subscription.
+void buildBenchEvent(bmqp::ConfirmEventBuilder*            builder,
+                     const bsl::vector<bmqt::MessageGUID>& guids)
+{
+    builder->reset();
+    for (int i = 0; i < static_cast<int>(guids.size()); ++i) {
+        const int subscription = (i / k_BENCH_RUN_LENGTH) %
+                                 k_BENCH_NUM_SUBSCRIPTIONS;
+        const bmqt::EventBuilderResult::Enum rc = builder->appendMessage(
+            subscription,
+            subscription + 1,
+            guids[i]);
+        BSLS_ASSERT_OPT(rc == bmqt::EventBuilderResult::e_SUCCESS);
+        (void)rc;
+    }
+}
+
+/// Iterate over the messages of the CONFIRM event in the specified `blob`,
+/// reading the subscription of each message as the broker does to find the
+/// queue the message is confirmed on.  Return the number of runs of
+/// consecutive messages of the same subscription, i.e. the number of
+/// lookups of a queue a receiver caching the last one would perform.
+int iterateBenchEvent(const bdlbb::Blob& blob)
+{
+    bmqp::Event                  event(&blob, s_allocator_p);
+    bmqp::ConfirmMessageIterator iterator;
+
+    event.loadConfirmMessageIterator(&iterator);
+
+    int numRuns    = 0;
+    int queueId    = -1;
+    int subQueueId = -1;
+    while (iterator.next() == 1) {
+        const bmqp::ConfirmMessage& message = iterator.message();
+        if (message.queueId() != queueId ||
+            message.subQueueId() != subQueueId) {
+            queueId    = message.queueId();
+            subQueueId = message.subQueueId();
+            ++numRuns;
+        }
+    }
+
+    return numRuns;
+}
+
+/// Print the specified `totalTimeNs` taken by the specified `numIterations`
+/// on CONFIRM events of the specified `numMessages` messages.
+void printBenchResult(int                numMessages,
+                      int                numIterations,
+                      bsls::Types::Int64 totalTimeNs)
+{
+    const bsls::Types::Int64 totalMessages =
+        static_cast<bsls::Types::Int64>(numIterations) * numMessages;
+    const bsls::Types::Int64 totalBytes =
+        totalMessages * static_cast<bsls::Types::Int64>(
+                            sizeof(bmqp::ConfirmMessage));
+
+    cout << "CONFIRMs: " << numMessages << " => "
+         << mwcu::PrintUtil::prettyTimeInterval(totalTimeNs / numIterations)
+         << " per event, "
+         << mwcu::PrintUtil::prettyNumber(totalMessages *
+                                          bdlt::TimeUnitRatio::k_NS_PER_S /
+                                          totalTimeNs)
+         << " CONFIRMs per second, "
+         << mwcu::PrintUtil::prettyBytes(totalBytes *
+                                         bdlt::TimeUnitRatio::k_NS_PER_S /
+                                         totalTimeNs)
+         << " per second\n";
+}
+
 }  // close unnamed namespace
 
 // ============================================================================
@@ -239,6 +351,41 @@ static void test4_capacity()
     ASSERT(obj.eventSize() <= bmqp::EventHeader::k_MAX_SIZE_SOFT);
 }
 
+static void test5_truncate()
+{
+    mwctst::TestHelper::printTestName("TRUNCATE");
+    // Verify that truncating removes the messages appended last, and that
+    // messages can be appended afterwards.
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(256, s_allocator_p);
+    bmqp::ConfirmEventBuilder      obj(&bufferFactory, s_allocator_p);
+    bsl::vector<Data>              messages(s_allocator_p);
+
+    PV("Appending 5 messages");
+    appendMessages(&obj, &messages, 5);
+
+    PV("Truncating to 5 messages");
+    obj.truncate(5);
+    verifyContent(obj, messages);
+
+    PV("Truncating to 2 messages");
+    obj.truncate(2);
+    messages.resize(2);
+    verifyContent(obj, messages);
+
+    PV("Appending another message");
+    bsl::vector<Data> moreMessages(s_allocator_p);
+    appendMessages(&obj, &moreMessages, 1);
+    messages.push_back(moreMessages[0]);
+    verifyContent(obj, messages);
+
+    PV("Truncating to 0 messages");
+    obj.truncate(0);
+    ASSERT_EQ(obj.messageCount(), 0);
+    ASSERT_EQ(obj.eventSize(), 0);
+    ASSERT_EQ(obj.blob().length(), 0);
+}
+
 static void testN1_decodeFromFile()
 // --------------------------------------------------------------------
 // DECODE FROM FILE
@@ -344,6 +491,171 @@ static void testN1_decodeFromFile()
     ASSERT_EQ(iter.isValid(), false);
 }
 
+BSLA_MAYBE_UNUSED
+static void testN2_buildEvent()
+// ------------------------------------------------------------------------
+// BENCHMARK: BUILD CONFIRM EVENT
+//
+// Concerns:
+//   Test the throughput of building CONFIRM events with
+//   'bmqp::ConfirmEventBuilder', depending on the number of messages per
+//   event, the messages being confirmed by runs over a few subscriptions.
+//
+// Plan:
+//   - For each number of messages, time the build of a large number of
+//     events and report the average time per event, and the number of
+//     CONFIRMs and bytes of CONFIRM messages per second.
+//
+// Testing:
+//   Throughput of bmqp::ConfirmEventBuilder::appendMessage()
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("BENCHMARK: BUILD CONFIRM EVENT");
+
+    const int k_NUM_ITERS = 1000;
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::ConfirmEventBuilder      builder(&bufferFactory, s_allocator_p);
+    bsl::vector<bmqt::MessageGUID> guids(s_allocator_p);
+
+    for (int n = 0; n < k_NUM_BENCH_NUM_MESSAGES; ++n) {
+        makeBenchGUIDs(&guids, k_BENCH_NUM_MESSAGES[n]);
+
+        // <time>
+        const bsls::Types::Int64 begin = bsls::TimeUtil::getTimer();
+        for (int i = 0; i < k_NUM_ITERS; ++i) {
+            buildBenchEvent(&builder, guids);
+        }
+        const bsls::Types::Int64 end = bsls::TimeUtil::getTimer();
+        // </time>
+
+        ASSERT_EQ(builder.messageCount(), k_BENCH_NUM_MESSAGES[n]);
+        printBenchResult(k_BENCH_NUM_MESSAGES[n], k_NUM_ITERS, end - begin);
+    }
+}
+
+BSLA_MAYBE_UNUSED
+static void testN2_iterateEvent()
+// ------------------------------------------------------------------------
+// BENCHMARK: ITERATE CONFIRM EVENT
+//
+// Concerns:
+//   Test the throughput of iterating over CONFIRM events with
+//   'bmqp::ConfirmMessageIterator' and reading the subscription of each
+//   message, depending on the number of messages per event.
+//
+// Plan:
+//   - For each number of messages, build an event and time a large number
+//     of iterations over it, and report the average time per event, and
+//     the number of CONFIRMs and bytes of CONFIRM messages per second.
+//
+// Testing:
+//   Throughput of bmqp::ConfirmMessageIterator
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("BENCHMARK: ITERATE CONFIRM EVENT");
+
+    const int k_NUM_ITERS = 1000;
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::ConfirmEventBuilder      builder(&bufferFactory, s_allocator_p);
+    bsl::vector<bmqt::MessageGUID> guids(s_allocator_p);
+
+    for (int n = 0; n < k_NUM_BENCH_NUM_MESSAGES; ++n) {
+        makeBenchGUIDs(&guids, k_BENCH_NUM_MESSAGES[n]);
+        buildBenchEvent(&builder, guids);
+
+        int numRuns = 0;
+
+        // <time>
+        const bsls::Types::Int64 begin = bsls::TimeUtil::getTimer();
+        for (int i = 0; i < k_NUM_ITERS; ++i) {
+            numRuns = iterateBenchEvent(builder.blob());
+        }
+        const bsls::Types::Int64 end = bsls::TimeUtil::getTimer();
+        // </time>
+
+        ASSERT_EQ(numRuns,
+                  (k_BENCH_NUM_MESSAGES[n] + k_BENCH_RUN_LENGTH - 1) /
+                      k_BENCH_RUN_LENGTH);
+        printBenchResult(k_BENCH_NUM_MESSAGES[n], k_NUM_ITERS, end - begin);
+    }
+}
+
+// Begin Benchmarking Tests
+#ifdef BSLS_PLATFORM_OS_LINUX
+static void testN2_buildEvent_GoogleBenchmark(benchmark::State& state)
+// ------------------------------------------------------------------------
+// BENCHMARK: BUILD CONFIRM EVENT
+//
+// Concerns:
+//   Test the throughput of building CONFIRM events with
+//   'bmqp::ConfirmEventBuilder', depending on the number of messages per
+//   event, provided as the argument of 'state'.
+//
+// Testing:
+//   Throughput of bmqp::ConfirmEventBuilder::appendMessage()
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("GOOGLE BENCHMARK: BUILD CONFIRM EVENT");
+
+    const int numMessages = static_cast<int>(state.range(0));
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::ConfirmEventBuilder      builder(&bufferFactory, s_allocator_p);
+    bsl::vector<bmqt::MessageGUID> guids(s_allocator_p);
+
+    makeBenchGUIDs(&guids, numMessages);
+
+    // <time>
+    for (auto _ : state) {
+        buildBenchEvent(&builder, guids);
+    }
+    // </time>
+
+    state.SetItemsProcessed(state.iterations() * numMessages);
+    state.SetBytesProcessed(state.iterations() * numMessages *
+                            sizeof(bmqp::ConfirmMessage));
+}
+
+static void testN2_iterateEvent_GoogleBenchmark(benchmark::State& state)
+// ------------------------------------------------------------------------
+// BENCHMARK: ITERATE CONFIRM EVENT
+//
+// Concerns:
+//   Test the throughput of iterating over CONFIRM events with
+//   'bmqp::ConfirmMessageIterator' and reading the subscription of each
+//   message, depending on the number of messages per event, provided as
+//   the argument of 'state'.
+//
+// Testing:
+//   Throughput of bmqp::ConfirmMessageIterator
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName(
+        "GOOGLE BENCHMARK: ITERATE CONFIRM EVENT");
+
+    const int numMessages = static_cast<int>(state.range(0));
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::ConfirmEventBuilder      builder(&bufferFactory, s_allocator_p);
+    bsl::vector<bmqt::MessageGUID> guids(s_allocator_p);
+
+    makeBenchGUIDs(&guids, numMessages);
+    buildBenchEvent(&builder, guids);
+
+    // <time>
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(iterateBenchEvent(builder.blob()));
+    }
+    // </time>
+
+    state.SetItemsProcessed(state.iterations() * numMessages);
+    state.SetBytesProcessed(state.iterations() * numMessages *
+                            sizeof(bmqp::ConfirmMessage));
+}
+#endif  // BSLS_PLATFORM_OS_LINUX
+
 // ============================================================================
 //                                 MAIN PROGRAM
 // ----------------------------------------------------------------------------
@@ -354,16 +666,30 @@ int main(int argc, char* argv[])
 
     switch (_testCase) {
     case 0:
+    case 5: test5_truncate(); break;
     case 4: test4_capacity(); break;
     case 3: test3_reset(); break;
     case 2: test2_multiMessage(); break;
     case 1: test1_breathingTest(); break;
     case -1: testN1_decodeFromFile(); break;
+    case -2:
+        MWC_BENCHMARK_WITH_ARGS(testN2_buildEvent,
+                                RangeMultiplier(8)->Range(1, 4096));
+        MWC_BENCHMARK_WITH_ARGS(testN2_iterateEvent,
+                                RangeMultiplier(8)->Range(1, 4096));
+        break;
     default: {
         cerr << "WARNING: CASE '" << _testCase << "' NOT FOUND." << endl;
         s_testStatus = -1;
     } break;
     }
 
+#ifdef BSLS_PLATFORM_OS_LINUX
+    if (_testCase < 0) {
+        benchmark::Initialize(&argc, argv);
+        benchmark::RunSpecifiedBenchmarks();
+    }
+#endif
+
     TEST_EPILOG(mwctst::TestHelper::e_CHECK_DEF_GBL_ALLOC);
 }
@@ -184,6 +184,11 @@ class Event {
     /// behavior is undefined unless `isValid()` returns true.
     bool isReceiptEvent() const;
 
+    /// Return true if this event is a storage event whose content is
+    /// compressed (see `EventUtil::decompressStorageEvent`).  The behavior
+    /// is undefined unless `isValid()` returns true.
+    bool isCompressedStorageEvent() const;
+
     /// Load into the specified `message`, the decoded message contained in
     /// this event.  The behavior is undefined unless `isControlEvent()`
     /// returns true.  Return 0 on success, and a non-zero return code on
@@ -541,6 +546,16 @@ inline bool Event::isReceiptEvent() const
     return d_header->type() == EventType::e_REPLICATION_RECEIPT;
 }
 
+inline bool Event::isCompressedStorageEvent() const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(isValid());
+
+    return d_header->type() == EventType::e_STORAGE &&
+           EventHeaderUtil::storageEventCompressionType(*d_header) !=
+               bmqt::CompressionAlgorithmType::e_NONE;
+}
+
 template <class TYPE>
 int Event::loadControlEvent(TYPE* message) const
 {
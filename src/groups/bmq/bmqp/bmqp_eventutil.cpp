@@ -18,6 +18,7 @@
 
 #include <bmqscm_version.h>
 // BMQ
+#include <bmqp_compression.h>
 #include <bmqp_event.h>
 #include <bmqp_optionsview.h>
 #include <bmqp_protocol.h>
@@ -27,8 +28,11 @@
 
 // MWC
 #include <mwcc_array.h>
+#include <mwcu_blobobjectproxy.h>
+#include <mwcu_memoutstream.h>
 
 // BDE
+#include <bdlbb_blobutil.h>
 #include <bdlma_localsequentialallocator.h>
 #include <bsl_utility.h>
 #include <bsl_vector.h>
@@ -42,6 +46,51 @@ namespace bmqp {
 
 namespace {
 
+/// Load into the specified `header` the EventHeader of the specified
+/// storage `event`.  Return true if `event` starts with a well formed
+/// storage EventHeader, having no event level option, and false otherwise.
+bool loadStorageEventHeader(EventHeader* header, const bdlbb::Blob& event)
+{
+    mwcu::BlobObjectProxy<EventHeader> proxy(&event,
+                                             -EventHeader::k_MIN_HEADER_SIZE,
+                                             true,    // read
+                                             false);  // write
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!proxy.isSet())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return false;  // RETURN
+    }
+
+    const int headerSize = proxy->headerWords() * Protocol::k_WORD_SIZE;
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+            headerSize != static_cast<int>(sizeof(EventHeader)) ||
+            headerSize > event.length() ||
+            proxy->type() != EventType::e_STORAGE)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return false;  // RETURN
+    }
+
+    *header = *proxy;
+    return true;
+}
+
+/// Load into the specified `output` the specified `header`, updated to
+/// describe an event of the specified `contentLength` bytes following the
+/// header and whose content is compressed with the specified `algorithm`.
+void appendStorageEventHeader(
+    bdlbb::Blob*                         output,
+    const EventHeader&                   header,
+    int                                  contentLength,
+    bmqt::CompressionAlgorithmType::Enum algorithm)
+{
+    EventHeader eventHeader(header);
+    eventHeader.setLength(sizeof(EventHeader) + contentLength);
+    EventHeaderUtil::setStorageEventCompressionType(&eventHeader, algorithm);
+
+    bdlbb::BlobUtil::append(output,
+                            reinterpret_cast<const char*>(&eventHeader),
+                            sizeof(EventHeader));
+}
+
 BSLMF_ASSERT(OptionType::k_HIGHEST_SUPPORTED_TYPE ==
              OptionType::e_SUB_QUEUE_INFOS);
 // If we add new options (i.e. options other than SubQueueId), we simply
@@ -500,5 +549,127 @@ int EventUtil::flattenPushEvent(bsl::vector<EventUtilEventInfo>* eventInfos,
     return flattener.flattenPushEvent();
 }
 
+int EventUtil::compressStorageEvent(
+    bdlbb::Blob*                         output,
+    const bdlbb::Blob&                   event,
+    bmqt::CompressionAlgorithmType::Enum algorithm,
+    bdlbb::BlobBufferFactory*            bufferFactory,
+    bslma::Allocator*                    allocator)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(output);
+    BSLS_ASSERT_SAFE(algorithm != bmqt::CompressionAlgorithmType::e_NONE);
+    BSLS_ASSERT_SAFE(algorithm != bmqt::CompressionAlgorithmType::e_UNKNOWN);
+    BSLS_ASSERT_SAFE(bufferFactory);
+    BSLS_ASSERT_SAFE(allocator);
+
+    enum RcEnum {
+        // Value for the various RC error categories
+        rc_SUCCESS             = 0,
+        rc_INVALID_EVENT       = -1,
+        rc_ALREADY_COMPRESSED  = -2,
+        rc_COMPRESSION_FAILURE = -3
+    };
+
+    EventHeader header;
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+            !loadStorageEventHeader(&header, event))) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return rc_INVALID_EVENT;  // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+            EventHeaderUtil::storageEventCompressionType(header) !=
+            bmqt::CompressionAlgorithmType::e_NONE)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return rc_ALREADY_COMPRESSED;  // RETURN
+    }
+
+    // The whole content of the event (i.e. the batch of storage messages it
+    // carries) is compressed as a single frame, which gives the compression
+    // algorithm more redundancy to work with than individual messages.
+    // Appending from 'event' shares its buffers, no data is copied.
+    bdlbb::Blob content(bufferFactory, allocator);
+    bdlbb::BlobUtil::append(&content, event, sizeof(EventHeader));
+
+    bdlbb::Blob        compressed(bufferFactory, allocator);
+    mwcu::MemOutStream errorStream(allocator);
+    const int          rc = Compression::compress(&compressed,
+                                         bufferFactory,
+                                         algorithm,
+                                         content,
+                                         &errorStream,
+                                         allocator);
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(rc != 0)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return (rc * 10) + rc_COMPRESSION_FAILURE;  // RETURN
+    }
+
+    output->removeAll();
+    appendStorageEventHeader(output, header, compressed.length(), algorithm);
+    bdlbb::BlobUtil::append(output, compressed);
+
+    return rc_SUCCESS;
+}
+
+int EventUtil::decompressStorageEvent(bdlbb::Blob*              output,
+                                      const bdlbb::Blob&        event,
+                                      bdlbb::BlobBufferFactory* bufferFactory,
+                                      bslma::Allocator*         allocator)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(output);
+    BSLS_ASSERT_SAFE(bufferFactory);
+    BSLS_ASSERT_SAFE(allocator);
+
+    enum RcEnum {
+        // Value for the various RC error categories
+        rc_SUCCESS               = 0,
+        rc_INVALID_EVENT         = -1,
+        rc_NOT_COMPRESSED        = -2,
+        rc_DECOMPRESSION_FAILURE = -3
+    };
+
+    EventHeader header;
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+            !loadStorageEventHeader(&header, event))) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return rc_INVALID_EVENT;  // RETURN
+    }
+
+    const bmqt::CompressionAlgorithmType::Enum algorithm =
+        EventHeaderUtil::storageEventCompressionType(header);
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+            algorithm == bmqt::CompressionAlgorithmType::e_NONE)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return rc_NOT_COMPRESSED;  // RETURN
+    }
+
+    bdlbb::Blob content(bufferFactory, allocator);
+    bdlbb::BlobUtil::append(&content, event, sizeof(EventHeader));
+
+    bdlbb::Blob        decompressed(bufferFactory, allocator);
+    mwcu::MemOutStream errorStream(allocator);
+    const int          rc = Compression::decompress(&decompressed,
+                                           bufferFactory,
+                                           algorithm,
+                                           content,
+                                           &errorStream,
+                                           allocator);
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(rc != 0)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return (rc * 10) + rc_DECOMPRESSION_FAILURE;  // RETURN
+    }
+
+    output->removeAll();
+    appendStorageEventHeader(output,
+                             header,
+                             decompressed.length(),
+                             bmqt::CompressionAlgorithmType::e_NONE);
+    bdlbb::BlobUtil::append(output, decompressed);
+
+    return rc_SUCCESS;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
@@ -33,6 +33,7 @@
 
 #include <bmqp_protocol.h>
 #include <bmqp_queueid.h>
+#include <bmqt_compressionalgorithmtype.h>
 
 // BDE
 #include <bdlbb_blob.h>
@@ -130,6 +131,37 @@ struct EventUtil {
                                 const Event&                     event,
                                 bdlbb::BlobBufferFactory*        bufferFactory,
                                 bslma::Allocator*                allocator);
+
+    /// StorageEvent Utilities
+    ///----------------------
+
+    /// Load into the specified `output` the specified storage `event`, with
+    /// all of its content following the EventHeader compressed as a single
+    /// frame using the specified `algorithm`, and with its EventHeader
+    /// updated accordingly.  Use the specified `bufferFactory` and
+    /// `allocator` to supply data buffers and memory.  Return 0 on success,
+    /// or non-zero error code in case of failure, in which case `output` is
+    /// left in an unspecified state.  The behavior is undefined unless
+    /// `algorithm` is neither `e_NONE` nor `e_UNKNOWN`.  Note that `event`
+    /// is left untouched, so that it can still be sent as is to peers which
+    /// do not support compressed storage events.
+    static int
+    compressStorageEvent(bdlbb::Blob*                         output,
+                         const bdlbb::Blob&                   event,
+                         bmqt::CompressionAlgorithmType::Enum algorithm,
+                         bdlbb::BlobBufferFactory*            bufferFactory,
+                         bslma::Allocator*                    allocator);
+
+    /// Load into the specified `output` the uncompressed version of the
+    /// specified storage `event`, as produced by `compressStorageEvent`,
+    /// using the specified `bufferFactory` and `allocator` to supply data
+    /// buffers and memory.  Return 0 on success, or non-zero error code in
+    /// case of failure, in which case `output` is left in an unspecified
+    /// state.
+    static int decompressStorageEvent(bdlbb::Blob*              output,
+                                      const bdlbb::Blob&        event,
+                                      bdlbb::BlobBufferFactory* bufferFactory,
+                                      bslma::Allocator*         allocator);
 };
 
 // ============================================================================
@@ -24,6 +24,7 @@
 #include <bmqp_pusheventbuilder.h>
 #include <bmqp_pushmessageiterator.h>
 #include <bmqp_queueid.h>
+#include <bmqt_compressionalgorithmtype.h>
 #include <bmqt_messageguid.h>
 
 // BDE
@@ -807,6 +808,114 @@ static void test3_flattenWithMessageProperties()
     }
 }
 
+static void test4_compressStorageEvent()
+// ------------------------------------------------------------------------
+// COMPRESS STORAGE EVENT
+//
+// Concerns:
+//   - Compressing a storage event compresses its whole content, flags the
+//     compression algorithm in the EventHeader and leaves the original
+//     event untouched.
+//   - Decompressing the compressed event yields back the original event.
+//   - Only uncompressed storage events can be compressed, and only
+//     compressed storage events can be decompressed.
+//
+// Testing:
+//   EventUtil::compressStorageEvent
+//   EventUtil::decompressStorageEvent
+//   Event::isCompressedStorageEvent
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("COMPRESS STORAGE EVENT");
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(128, s_allocator_p);
+
+    // Build a storage event whose content is highly redundant
+    bdlbb::Blob       content(&bufferFactory, s_allocator_p);
+    int               contentLength = 0;
+    bmqp::EventHeader eventHeader(bmqp::EventType::e_STORAGE);
+    populateBlob(&content, &contentLength, 4096);
+    eventHeader.setLength(sizeof(bmqp::EventHeader) + contentLength);
+
+    bdlbb::Blob event(&bufferFactory, s_allocator_p);
+    bdlbb::BlobUtil::append(&event,
+                            reinterpret_cast<const char*>(&eventHeader),
+                            sizeof(bmqp::EventHeader));
+    bdlbb::BlobUtil::append(&event, content);
+
+    bdlbb::Blob eventCopy(&bufferFactory, s_allocator_p);
+    bdlbb::BlobUtil::append(&eventCopy, event);
+
+    PV("Compress");
+    bdlbb::Blob compressed(&bufferFactory, s_allocator_p);
+    int         rc = bmqp::EventUtil::compressStorageEvent(
+        &compressed,
+        event,
+        bmqt::CompressionAlgorithmType::e_ZLIB,
+        &bufferFactory,
+        s_allocator_p);
+    ASSERT_EQ(rc, 0);
+    ASSERT_LT(compressed.length(), event.length());
+    ASSERT_EQ(bdlbb::BlobUtil::compare(event, eventCopy), 0);
+
+    {
+        bmqp::Event compressedEvent(&compressed, s_allocator_p);
+        ASSERT(compressedEvent.isValid());
+        ASSERT(compressedEvent.isStorageEvent());
+        ASSERT(compressedEvent.isCompressedStorageEvent());
+        ASSERT(!bmqp::Event(&event, s_allocator_p).isCompressedStorageEvent());
+
+        const bmqp::EventHeader& header =
+            *reinterpret_cast<const bmqp::EventHeader*>(
+                compressed.buffer(0).data());
+        ASSERT_EQ(header.length(), compressed.length());
+        ASSERT_EQ(bmqp::EventHeaderUtil::storageEventCompressionType(header),
+                  bmqt::CompressionAlgorithmType::e_ZLIB);
+    }
+
+    PV("Decompress");
+    bdlbb::Blob decompressed(&bufferFactory, s_allocator_p);
+    rc = bmqp::EventUtil::decompressStorageEvent(&decompressed,
+                                                 compressed,
+                                                 &bufferFactory,
+                                                 s_allocator_p);
+    ASSERT_EQ(rc, 0);
+    ASSERT_EQ(bdlbb::BlobUtil::compare(decompressed, event), 0);
+
+    PV("Invalid inputs");
+    bdlbb::Blob output(&bufferFactory, s_allocator_p);
+
+    // Compressing an already compressed event
+    rc = bmqp::EventUtil::compressStorageEvent(
+        &output,
+        compressed,
+        bmqt::CompressionAlgorithmType::e_ZLIB,
+        &bufferFactory,
+        s_allocator_p);
+    ASSERT_NE(rc, 0);
+
+    // Decompressing an uncompressed event
+    rc = bmqp::EventUtil::decompressStorageEvent(&output,
+                                                 event,
+                                                 &bufferFactory,
+                                                 s_allocator_p);
+    ASSERT_NE(rc, 0);
+
+    // Compressing an event which is not a storage event
+    bmqp::EventHeader pushHeader(bmqp::EventType::e_PUSH);
+    bdlbb::Blob       pushEvent(&bufferFactory, s_allocator_p);
+    bdlbb::BlobUtil::append(&pushEvent,
+                            reinterpret_cast<const char*>(&pushHeader),
+                            sizeof(bmqp::EventHeader));
+    rc = bmqp::EventUtil::compressStorageEvent(
+        &output,
+        pushEvent,
+        bmqt::CompressionAlgorithmType::e_ZLIB,
+        &bufferFactory,
+        s_allocator_p);
+    ASSERT_NE(rc, 0);
+}
+
 // ============================================================================
 //                                 MAIN PROGRAM
 // ----------------------------------------------------------------------------
@@ -823,6 +932,7 @@ int main(int argc, char* argv[])
 
     switch (_testCase) {
     case 0:
+    case 4: test4_compressStorageEvent(); break;
     case 3: test3_flattenWithMessageProperties(); break;
     case 2: test2_flattenExplodesEvent(); break;
     case 1: test1_breathingTest(); break;
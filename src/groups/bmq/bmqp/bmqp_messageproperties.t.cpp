@@ -25,6 +25,7 @@
 // MWC
 #include <mwcu_blob.h>
 #include <mwcu_memoutstream.h>
+#include <mwcu_printutil.h>
 
 // BDE
 #include <bdlb_bigendian.h>
@@ -37,11 +38,18 @@
 #include <bsl_utility.h>
 #include <bsl_vector.h>
 #include <bslmf_assert.h>
+#include <bsls_assert.h>
+#include <bsls_timeutil.h>
 #include <bsls_types.h>
 
 // TEST DRIVER
 #include <mwctst_testhelper.h>
 
+// BENCHMARKING LIBRARY
+#ifdef BSLS_PLATFORM_OS_LINUX
+#include <benchmark/benchmark.h>
+#endif
+
 // CONVENIENCE
 using namespace BloombergLP;
 using namespace bsl;
@@ -445,6 +453,88 @@ void encode(bdlbb::Blob* blob, const PropertyMap& pmap)
     mpsh->setMessagePropertiesAreaWords(numWords);
 }
 
+/// Numbers of properties of the benchmarks.
+const int k_BENCH_NUM_PROPERTIES[] = {1, 4, 16, 64, 128};
+
+const int k_NUM_BENCH_NUM_PROPERTIES = sizeof(k_BENCH_NUM_PROPERTIES) /
+                                       sizeof(*k_BENCH_NUM_PROPERTIES);
+
+/// Name of the property the benchmarks overwrite to mark the properties as
+/// modified, so that `streamOut` does not return a cached blob.
+const char k_BENCH_DIRTY_PROPERTY[] = "benchDirty";
+
+/// Load into the specified `properties` the specified `numProperties`
+/// properties of various types, and load their wire representation, built
+/// using the specified `bufferFactory`, into the specified `wireRep`.
+void populateBenchProperties(bmqp::MessageProperties*  properties,
+                             bdlbb::Blob*              wireRep,
+                             bdlbb::BlobBufferFactory* bufferFactory,
+                             int                       numProperties)
+{
+    PropertyMap pmap(s_allocator_p);
+
+    properties->clear();
+    populateProperties(properties, &pmap, numProperties);
+
+    wireRep->removeAll();
+    bdlbb::BlobUtil::append(
+        wireRep,
+        properties->streamOut(bufferFactory,
+                              bmqp::MessagePropertiesInfo::makeNoSchema()));
+}
+
+/// Iterate over the specified `properties`, reading the value of each of
+/// them.  Return a checksum of the values.
+bsls::Types::Int64 readBenchProperties(
+    const bmqp::MessageProperties& properties)
+{
+    bsls::Types::Int64              checksum = 0;
+    bmqp::MessagePropertiesIterator iterator(&properties);
+
+    while (iterator.hasNext()) {
+        switch (iterator.type()) {
+        case bmqt::PropertyType::e_BOOL: {
+            checksum += iterator.getAsBool();
+        } break;  // BREAK
+        case bmqt::PropertyType::e_CHAR: {
+            checksum += iterator.getAsChar();
+        } break;  // BREAK
+        case bmqt::PropertyType::e_SHORT: {
+            checksum += iterator.getAsShort();
+        } break;  // BREAK
+        case bmqt::PropertyType::e_INT32: {
+            checksum += iterator.getAsInt32();
+        } break;  // BREAK
+        case bmqt::PropertyType::e_INT64: {
+            checksum += iterator.getAsInt64();
+        } break;  // BREAK
+        case bmqt::PropertyType::e_STRING: {
+            checksum += iterator.getAsString().length();
+        } break;  // BREAK
+        case bmqt::PropertyType::e_BINARY: {
+            checksum += iterator.getAsBinary().size();
+        } break;  // BREAK
+        case bmqt::PropertyType::e_UNDEFINED:
+        default: {
+            BSLS_ASSERT_OPT(false && "Unexpected property type");
+        } break;  // BREAK
+        }
+    }
+
+    return checksum;
+}
+
+/// Print the specified `totalTimeNs` taken by the specified `numIterations`
+/// on the specified `numProperties` properties.
+void printBenchResult(int                numProperties,
+                      int                numIterations,
+                      bsls::Types::Int64 totalTimeNs)
+{
+    cout << "properties: " << numProperties << " => "
+         << mwcu::PrintUtil::prettyTimeInterval(totalTimeNs / numIterations)
+         << " per iteration\n";
+}
+
 }  // close unnamed namespace
 
 // ============================================================================
@@ -1167,6 +1257,193 @@ static void test10_empty()
     ASSERT(!p.hasProperty("z"));
 }
 
+BSLA_MAYBE_UNUSED
+static void testN1_streamOut()
+// ------------------------------------------------------------------------
+// BENCHMARK: STREAM OUT
+//
+// Concerns:
+//   Test the performance of encoding message properties with
+//   'bmqp::MessageProperties::streamOut', depending on the number of
+//   properties.
+//
+// Plan:
+//   - For each number of properties, time a large number of encodings,
+//     overwriting a property before each of them so that the encoding is
+//     not cached, and report the average time per encoding.
+//
+// Testing:
+//   Performance of bmqp::MessageProperties::streamOut()
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("BENCHMARK: STREAM OUT");
+
+    const int k_NUM_ITERS = 10000;
+
+    bdlbb::PooledBlobBufferFactory    bufferFactory(4096, s_allocator_p);
+    bmqp::MessageProperties           properties(s_allocator_p);
+    bdlbb::Blob                       wireRep(&bufferFactory, s_allocator_p);
+    const bmqp::MessagePropertiesInfo info =
+        bmqp::MessagePropertiesInfo::makeNoSchema();
+    const bsl::string dirtyName(k_BENCH_DIRTY_PROPERTY, s_allocator_p);
+
+    for (int n = 0; n < k_NUM_BENCH_NUM_PROPERTIES; ++n) {
+        populateBenchProperties(&properties,
+                                &wireRep,
+                                &bufferFactory,
+                                k_BENCH_NUM_PROPERTIES[n]);
+        properties.setPropertyAsInt32(dirtyName, 0);
+
+        // <time>
+        const bsls::Types::Int64 begin = bsls::TimeUtil::getTimer();
+        for (int i = 0; i < k_NUM_ITERS; ++i) {
+            properties.setPropertyAsInt32(dirtyName, i);
+            properties.streamOut(&bufferFactory, info);
+        }
+        const bsls::Types::Int64 end = bsls::TimeUtil::getTimer();
+        // </time>
+
+        printBenchResult(k_BENCH_NUM_PROPERTIES[n], k_NUM_ITERS, end - begin);
+    }
+}
+
+BSLA_MAYBE_UNUSED
+static void testN1_streamInAndRead()
+// ------------------------------------------------------------------------
+// BENCHMARK: STREAM IN AND READ
+//
+// Concerns:
+//   Test the performance of decoding message properties with
+//   'bmqp::MessageProperties::streamIn' and reading all their values with
+//   'bmqp::MessagePropertiesIterator', depending on the number of
+//   properties.
+//
+// Plan:
+//   - For each number of properties, encode the properties once, then time
+//     a large number of decodings followed by reads of all the values, and
+//     report the average time per decoding.
+//
+// Testing:
+//   Performance of bmqp::MessageProperties::streamIn()
+//   Performance of bmqp::MessagePropertiesIterator
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("BENCHMARK: STREAM IN AND READ");
+
+    const int k_NUM_ITERS = 10000;
+
+    bdlbb::PooledBlobBufferFactory    bufferFactory(4096, s_allocator_p);
+    bmqp::MessageProperties           properties(s_allocator_p);
+    bdlbb::Blob                       wireRep(&bufferFactory, s_allocator_p);
+    const bmqp::MessagePropertiesInfo info =
+        bmqp::MessagePropertiesInfo::makeNoSchema();
+
+    for (int n = 0; n < k_NUM_BENCH_NUM_PROPERTIES; ++n) {
+        populateBenchProperties(&properties,
+                                &wireRep,
+                                &bufferFactory,
+                                k_BENCH_NUM_PROPERTIES[n]);
+
+        // <time>
+        const bsls::Types::Int64 begin = bsls::TimeUtil::getTimer();
+        for (int i = 0; i < k_NUM_ITERS; ++i) {
+            properties.streamIn(wireRep, info.isExtended());
+            readBenchProperties(properties);
+        }
+        const bsls::Types::Int64 end = bsls::TimeUtil::getTimer();
+        // </time>
+
+        printBenchResult(k_BENCH_NUM_PROPERTIES[n], k_NUM_ITERS, end - begin);
+    }
+}
+
+// Begin Benchmarking Tests
+#ifdef BSLS_PLATFORM_OS_LINUX
+static void testN1_streamOut_GoogleBenchmark(benchmark::State& state)
+// ------------------------------------------------------------------------
+// BENCHMARK: STREAM OUT
+//
+// Concerns:
+//   Test the performance of encoding message properties with
+//   'bmqp::MessageProperties::streamOut', depending on the number of
+//   properties, provided as the argument of 'state'.
+//
+// Testing:
+//   Performance of bmqp::MessageProperties::streamOut()
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("GOOGLE BENCHMARK: STREAM OUT");
+
+    const int numProperties = static_cast<int>(state.range(0));
+
+    bdlbb::PooledBlobBufferFactory    bufferFactory(4096, s_allocator_p);
+    bmqp::MessageProperties           properties(s_allocator_p);
+    bdlbb::Blob                       wireRep(&bufferFactory, s_allocator_p);
+    const bmqp::MessagePropertiesInfo info =
+        bmqp::MessagePropertiesInfo::makeNoSchema();
+    const bsl::string dirtyName(k_BENCH_DIRTY_PROPERTY, s_allocator_p);
+
+    populateBenchProperties(&properties,
+                            &wireRep,
+                            &bufferFactory,
+                            numProperties);
+    properties.setPropertyAsInt32(dirtyName, 0);
+
+    // <time>
+    int value = 0;
+    for (auto _ : state) {
+        properties.setPropertyAsInt32(dirtyName, ++value);
+        benchmark::DoNotOptimize(
+            properties.streamOut(&bufferFactory, info).length());
+    }
+    // </time>
+
+    state.SetItemsProcessed(state.iterations() * numProperties);
+    state.SetBytesProcessed(state.iterations() * wireRep.length());
+}
+
+static void testN1_streamInAndRead_GoogleBenchmark(benchmark::State& state)
+// ------------------------------------------------------------------------
+// BENCHMARK: STREAM IN AND READ
+//
+// Concerns:
+//   Test the performance of decoding message properties with
+//   'bmqp::MessageProperties::streamIn' and reading all their values with
+//   'bmqp::MessagePropertiesIterator', depending on the number of
+//   properties, provided as the argument of 'state'.
+//
+// Testing:
+//   Performance of bmqp::MessageProperties::streamIn()
+//   Performance of bmqp::MessagePropertiesIterator
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("GOOGLE BENCHMARK: STREAM IN AND READ");
+
+    const int numProperties = static_cast<int>(state.range(0));
+
+    bdlbb::PooledBlobBufferFactory    bufferFactory(4096, s_allocator_p);
+    bmqp::MessageProperties           properties(s_allocator_p);
+    bdlbb::Blob                       wireRep(&bufferFactory, s_allocator_p);
+    const bmqp::MessagePropertiesInfo info =
+        bmqp::MessagePropertiesInfo::makeNoSchema();
+
+    populateBenchProperties(&properties,
+                            &wireRep,
+                            &bufferFactory,
+                            numProperties);
+
+    // <time>
+    for (auto _ : state) {
+        properties.streamIn(wireRep, info.isExtended());
+        benchmark::DoNotOptimize(readBenchProperties(properties));
+    }
+    // </time>
+
+    state.SetItemsProcessed(state.iterations() * numProperties);
+    state.SetBytesProcessed(state.iterations() * wireRep.length());
+}
+#endif  // BSLS_PLATFORM_OS_LINUX
+
 // ============================================================================
 //                                 MAIN PROGRAM
 // ----------------------------------------------------------------------------
@@ -1189,12 +1466,25 @@ int main(int argc, char* argv[])
     case 3: test3_binaryPropertyTest(); break;
     case 2: test2_setPropertyTest(); break;
     case 1: test1_breathingTest(); break;
+    case -1:
+        MWC_BENCHMARK_WITH_ARGS(testN1_streamOut,
+                                RangeMultiplier(4)->Range(1, 128));
+        MWC_BENCHMARK_WITH_ARGS(testN1_streamInAndRead,
+                                RangeMultiplier(4)->Range(1, 128));
+        break;
     default: {
         cerr << "WARNING: CASE '" << _testCase << "' NOT FOUND." << endl;
         s_testStatus = -1;
     } break;
     }
 
+#ifdef BSLS_PLATFORM_OS_LINUX
+    if (_testCase < 0) {
+        benchmark::Initialize(&argc, argv);
+        benchmark::RunSpecifiedBenchmarks();
+    }
+#endif
+
     bmqp::ProtocolUtil::shutdown();
 
     TEST_EPILOG(mwctst::TestHelper::e_CHECK_GBL_ALLOC);
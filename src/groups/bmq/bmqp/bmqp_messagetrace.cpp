@@ -0,0 +1,429 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// bmqp_messagetrace.cpp                                              -*-C++-*-
+#include <bmqp_messagetrace.h>
+
+#include <bmqscm_version.h>
+// MWC
+#include <mwcu_printutil.h>
+
+// BDE
+#include <bdlb_bitutil.h>
+#include <bdlb_print.h>
+#include <bsl_algorithm.h>
+#include <bsl_cstdint.h>
+#include <bsl_ostream.h>
+#include <bslma_default.h>
+#include <bslmt_qlock.h>
+#include <bsls_assert.h>
+#include <bsls_atomic.h>
+#include <bsls_systemtime.h>
+
+namespace BloombergLP {
+namespace bmqp {
+
+namespace {
+
+// GLOBAL DATA
+
+/// Process-wide buffer of records, allocated the first time tracing is
+/// enabled.
+bsls::AtomicPointer<MessageTraceBuffer> g_buffer_p;
+
+/// Allocator of the process-wide buffer.
+bslma::Allocator* g_allocator_p = 0;
+
+/// Number of calls to `initialize` without a matching call to `shutdown`.
+int g_initialized = 0;
+
+/// Lock protecting the initialization and the allocation of the buffer.
+bslmt::QLock g_initLock = BSLMT_QLOCK_INITIALIZER;
+
+// FUNCTIONS
+
+/// Return true if the specified `lhs` record orders before the specified
+/// `rhs` record, by GUID then by timestamp.
+bool recordLess(const MessageTraceRecord& lhs, const MessageTraceRecord& rhs)
+{
+    if (lhs.d_guid != rhs.d_guid) {
+        return bmqt::MessageGUIDLess()(lhs.d_guid, rhs.d_guid);  // RETURN
+    }
+
+    return lhs.d_timestamp < rhs.d_timestamp;
+}
+
+}  // close unnamed namespace
+
+// ----------------------
+// struct MessageTraceHop
+// ----------------------
+
+bsl::ostream& MessageTraceHop::print(bsl::ostream&         stream,
+                                     MessageTraceHop::Enum value,
+                                     int                   level,
+                                     int                   spacesPerLevel)
+{
+    bdlb::Print::indent(stream, level, spacesPerLevel);
+    stream << MessageTraceHop::toAscii(value);
+
+    if (spacesPerLevel >= 0) {
+        stream << '\n';
+    }
+
+    return stream;
+}
+
+const char* MessageTraceHop::toAscii(MessageTraceHop::Enum value)
+{
+#define CASE(X)                                                               \
+    case e_##X: return #X;
+
+    switch (value) {
+        CASE(SDK_PUT)
+        CASE(BROKER_PUT_IN)
+        CASE(BROKER_PUT_OUT)
+        CASE(PRIMARY_STORED)
+        CASE(BROKER_PUSH_OUT)
+        CASE(SDK_PUSH_IN)
+    default: return "(* UNKNOWN *)";
+    }
+
+#undef CASE
+}
+
+// -------------------------
+// struct MessageTraceRecord
+// -------------------------
+
+// CREATORS
+MessageTraceRecord::MessageTraceRecord()
+: d_guid()
+, d_hop(MessageTraceHop::e_SDK_PUT)
+, d_timestamp(0)
+{
+    // NOTHING
+}
+
+MessageTraceRecord::MessageTraceRecord(const bmqt::MessageGUID& guid,
+                                       MessageTraceHop::Enum    hop,
+                                       bsls::Types::Int64       timestamp)
+: d_guid(guid)
+, d_hop(hop)
+, d_timestamp(timestamp)
+{
+    // NOTHING
+}
+
+// FREE OPERATORS
+bsl::ostream& operator<<(bsl::ostream&             stream,
+                         const MessageTraceRecord& value)
+{
+    return stream << "[guid: " << value.d_guid << ", hop: " << value.d_hop
+                  << ", timestamp: " << value.d_timestamp << "]";
+}
+
+// ------------------------
+// class MessageTraceBuffer
+// ------------------------
+
+// CREATORS
+MessageTraceBuffer::MessageTraceBuffer(int               capacity,
+                                       bslma::Allocator* allocator)
+: d_records(allocator)
+, d_sequences(allocator)
+, d_mask(0)
+, d_nextPosition(0)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(0 < capacity);
+
+    const bsls::Types::Uint64 size = bdlb::BitUtil::roundUpToBinaryPower(
+        static_cast<bsls::Types::Uint64>(capacity));
+    d_mask = size - 1;
+
+    d_records.resize(size);
+    d_sequences.resize(size);
+    for (size_t i = 0; i < d_sequences.size(); ++i) {
+        bsls::AtomicOperations::initUint64(&d_sequences[i], 0);
+    }
+}
+
+// MANIPULATORS
+void MessageTraceBuffer::record(const MessageTraceRecord& record)
+{
+    const bsls::Types::Uint64 position = d_nextPosition.addRelaxed(1) - 1;
+    AtomicSequence&           sequence = d_sequences[position & d_mask];
+
+    // Flag the record as being written, so that a concurrent reader skips
+    // it, then publish it under its position.
+    bsls::AtomicOperations::setUint64(&sequence, 0);
+    d_records[position & d_mask] = record;
+    bsls::AtomicOperations::setUint64Release(&sequence, position + 1);
+}
+
+// ACCESSORS
+bsls::Types::Uint64
+MessageTraceBuffer::loadRecords(bsl::vector<MessageTraceRecord>* records,
+                                bsls::Types::Uint64 position) const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(records);
+
+    const bsls::Types::Uint64 end   = d_nextPosition.loadAcquire();
+    bsls::Types::Uint64       begin = position;
+    if (end < begin || end - begin > d_mask + 1) {
+        // Some records were overwritten since 'position'.
+        begin = end > d_mask + 1 ? end - (d_mask + 1) : 0;
+    }
+
+    records->reserve(records->size() + static_cast<size_t>(end - begin));
+    for (bsls::Types::Uint64 i = begin; i < end; ++i) {
+        AtomicSequence& sequence = d_sequences[i & d_mask];
+        if (bsls::AtomicOperations::getUint64Acquire(&sequence) != i + 1) {
+            // Being written, or already overwritten
+            continue;  // CONTINUE
+        }
+
+        const MessageTraceRecord record = d_records[i & d_mask];
+
+        // The copy of the record must be complete before the sequence is
+        // checked again, which a plain or acquire load does not guarantee.
+        // A read-modify-write with release semantics does, without the
+        // acquire fence which is not available in C++03.
+
+        if (bsls::AtomicOperations::addUint64AcqRel(&sequence, 0) != i + 1) {
+            // Overwritten while being copied
+            continue;  // CONTINUE
+        }
+
+        records->push_back(record);
+    }
+
+    return end;
+}
+
+int MessageTraceBuffer::capacity() const
+{
+    return static_cast<int>(d_mask + 1);
+}
+
+// -----------------------
+// struct MessageTraceUtil
+// -----------------------
+
+// CLASS DATA
+bsls::AtomicInt MessageTraceUtil::s_samplingMask(-1);
+
+const int MessageTraceUtil::k_BUFFER_CAPACITY;
+
+// PRIVATE CLASS METHODS
+void MessageTraceUtil::recordHopImp(const bmqt::MessageGUID& guid,
+                                    MessageTraceHop::Enum    hop)
+{
+    MessageTraceBuffer* buffer = g_buffer_p.loadAcquire();
+    if (!buffer) {
+        return;  // RETURN
+    }
+
+    buffer->record(MessageTraceRecord(
+        guid,
+        hop,
+        bsls::SystemTime::nowRealtimeClock().totalNanoseconds()));
+}
+
+// CLASS METHODS
+void MessageTraceUtil::initialize(bslma::Allocator* allocator)
+{
+    bslmt::QLockGuard qlockGuard(&g_initLock);
+
+    if (++g_initialized > 1) {
+        return;  // RETURN
+    }
+
+    g_allocator_p = bslma::Default::globalAllocator(allocator);
+}
+
+void MessageTraceUtil::shutdown()
+{
+    bslmt::QLockGuard qlockGuard(&g_initLock);
+
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(g_initialized > 0 && "Not initialized");
+
+    if (--g_initialized != 0) {
+        return;  // RETURN
+    }
+
+    s_samplingMask = -1;
+
+    MessageTraceBuffer* buffer = g_buffer_p.swap(0);
+    if (buffer) {
+        g_allocator_p->deleteObject(buffer);
+    }
+    g_allocator_p = 0;
+}
+
+void MessageTraceUtil::setSamplingPeriod(int samplingPeriod)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(0 <= samplingPeriod);
+
+    bslmt::QLockGuard qlockGuard(&g_initLock);
+
+    BSLS_ASSERT_SAFE(g_initialized > 0 && "Not initialized");
+
+    if (samplingPeriod == 0) {
+        s_samplingMask = -1;
+        return;  // RETURN
+    }
+
+    if (!g_buffer_p.load()) {
+        g_buffer_p.storeRelease(new (*g_allocator_p)
+                                    MessageTraceBuffer(k_BUFFER_CAPACITY,
+                                                       g_allocator_p));
+    }
+
+    // Round the period down to a power of 2.
+    const int log2 = 31 - bdlb::BitUtil::numLeadingUnsetBits(
+                              static_cast<bsl::uint32_t>(samplingPeriod));
+    s_samplingMask = (1 << log2) - 1;
+}
+
+int MessageTraceUtil::samplingPeriod()
+{
+    const int mask = s_samplingMask.load();
+    return mask < 0 ? 0 : mask + 1;
+}
+
+bsls::Types::Uint64
+MessageTraceUtil::loadRecords(bsl::vector<MessageTraceRecord>* records,
+                              bsls::Types::Uint64              position)
+{
+    const MessageTraceBuffer* buffer = g_buffer_p.loadAcquire();
+    if (!buffer) {
+        return position;  // RETURN
+    }
+
+    return buffer->loadRecords(records, position);
+}
+
+void MessageTraceUtil::printLatencies(
+    bsl::ostream&                          stream,
+    const bsl::vector<MessageTraceRecord>& records)
+{
+    const int k_NUM_HOPS = MessageTraceHop::k_NUM_HOPS;
+
+    // Latencies between each two consecutive hops of a message, indexed by
+    // the hop before and the hop after.
+    bsls::Types::Int64 counts[k_NUM_HOPS][k_NUM_HOPS]    = {};
+    bsls::Types::Int64 totals[k_NUM_HOPS][k_NUM_HOPS]    = {};
+    bsls::Types::Int64 maxValues[k_NUM_HOPS][k_NUM_HOPS] = {};
+
+    bsl::vector<MessageTraceRecord> sorted(records, records.get_allocator());
+    bsl::sort(sorted.begin(), sorted.end(), &recordLess);
+
+    bool hasLatencies = false;
+    for (size_t i = 1; i < sorted.size(); ++i) {
+        const MessageTraceRecord& previous = sorted[i - 1];
+        const MessageTraceRecord& current  = sorted[i];
+        if (previous.d_guid != current.d_guid) {
+            continue;  // CONTINUE
+        }
+
+        const bsls::Types::Int64 latency = current.d_timestamp -
+                                           previous.d_timestamp;
+        const int                from    = previous.d_hop;
+        const int                to      = current.d_hop;
+
+        ++counts[from][to];
+        totals[from][to] += latency;
+        maxValues[from][to] = bsl::max(maxValues[from][to], latency);
+        hasLatencies        = true;
+    }
+
+    if (!hasLatencies) {
+        stream << "\n  No latency between traced hops\n";
+        return;  // RETURN
+    }
+
+    stream << "\n";
+    for (int from = 0; from < k_NUM_HOPS; ++from) {
+        for (int to = 0; to < k_NUM_HOPS; ++to) {
+            if (counts[from][to] == 0) {
+                continue;  // CONTINUE
+            }
+
+            stream << "  " << static_cast<MessageTraceHop::Enum>(from)
+                   << " -> " << static_cast<MessageTraceHop::Enum>(to)
+                   << ": " << counts[from][to] << " messages, avg: "
+                   << mwcu::PrintUtil::prettyTimeInterval(totals[from][to] /
+                                                          counts[from][to])
+                   << ", max: "
+                   << mwcu::PrintUtil::prettyTimeInterval(maxValues[from][to])
+                   << "\n";
+        }
+    }
+}
+
+// ---------------------------
+// class MessageTraceCollector
+// ---------------------------
+
+// CREATORS
+MessageTraceCollector::MessageTraceCollector(bslma::Allocator* allocator)
+: d_records(allocator)
+, d_position(0)
+{
+    // NOTHING
+}
+
+// MANIPULATORS
+int MessageTraceCollector::collect()
+{
+    const size_t previousSize = d_records.size();
+    d_position = MessageTraceUtil::loadRecords(&d_records, d_position);
+
+    const int numLoaded = static_cast<int>(d_records.size() - previousSize);
+    if (numLoaded == 0) {
+        return 0;  // RETURN
+    }
+
+    BALL_LOG_INFO_BLOCK
+    {
+        BALL_LOG_OUTPUT_STREAM << "Message trace records [count: "
+                               << numLoaded << "]:";
+        for (size_t i = previousSize; i < d_records.size(); ++i) {
+            BALL_LOG_OUTPUT_STREAM << "\n  " << d_records[i];
+        }
+    }
+
+    return numLoaded;
+}
+
+void MessageTraceCollector::printLatencies(bsl::ostream& stream)
+{
+    MessageTraceUtil::printLatencies(stream, d_records);
+    d_records.clear();
+}
+
+// ACCESSORS
+int MessageTraceCollector::numRecords() const
+{
+    return static_cast<int>(d_records.size());
+}
+
+}  // close package namespace
+}  // close enterprise namespace
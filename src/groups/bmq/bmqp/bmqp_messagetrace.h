@@ -0,0 +1,442 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// bmqp_messagetrace.h                                                -*-C++-*-
+#ifndef INCLUDED_BMQP_MESSAGETRACE
+#define INCLUDED_BMQP_MESSAGETRACE
+
+//@PURPOSE: Provide sampled tracing of messages across their hops.
+//
+//@CLASSES:
+//  bmqp::MessageTraceHop:    enumeration of the traced hops of a message
+//  bmqp::MessageTraceRecord: timestamp of a message at one of its hops
+//  bmqp::MessageTraceBuffer: lock-free ring buffer of trace records
+//  bmqp::MessageTraceUtil:   process-wide sampling and recording of traces
+//  bmqp::MessageTraceCollector: exporter of the process-wide trace records
+//
+//@SEE_ALSO:
+//  bmqt::MessageGUID
+//
+//@DESCRIPTION: This component provides the means to measure the latency of
+// individual messages at each of their hops, from the SDK posting a PUT, to
+// the brokers relaying and storing it, to the SDK receiving the corresponding
+// PUSH.  Only a sample of the messages is traced, so that tracing can be
+// enabled in production without affecting the messages which are not traced.
+//
+// A message is sampled based on a hash of its GUID, which is carried by the
+// PUT and PUSH messages at every hop: each process independently makes the
+// same sampling decision, without any additional header on the wire.  The
+// sampling period is a power of 2, so that processes configured with
+// different periods trace nested subsets of the messages.
+//
+// When a sampled message goes through a hop, 'bmqp::MessageTraceUtil' records
+// its GUID, the hop and the realtime clock in a process-wide
+// 'bmqp::MessageTraceBuffer'.  The buffer is a fixed-size ring, written to
+// without locking by the threads processing the messages, and read by a
+// single exporting thread, which loads the records written since its previous
+// read.  Records overwritten before being read are lost, so the buffer must
+// be read more often than it fills up.
+//
+// 'bmqp::MessageTraceCollector' is that exporting thread's side: it is meant
+// to drain the buffer at every stats snapshot, and logs each record it loads
+// to the 'BMQP.MESSAGETRACE' category, one record per line, with its GUID,
+// hop and timestamp.  Joining the records logged by each process on
+// the GUID yields the latency breakdown of a message across hosts, subject to
+// the skew of their clocks.  The collector also keeps the records it loads
+// until it prints the aggregated latencies of the messages, at every stats
+// print.
+//
+/// Thread Safety
+///-------------
+// 'bmqp::MessageTraceBuffer::record' and all the methods of
+// 'bmqp::MessageTraceUtil' are thread-safe.  'initialize' and 'shutdown' are
+// ref-counted, and must be called before and after any other method.
+//
+/// Usage
+///-----
+// A hop records the messages it processes:
+//..
+//  bmqp::MessageTraceUtil::recordHop(putHeader.messageGUID(),
+//                                    bmqp::MessageTraceHop::e_BROKER_PUT_IN);
+//..
+// And an exporter drains the records at every snapshot, and periodically
+// prints the latencies of the messages:
+//..
+//  d_collector.collect();  // at every snapshot
+//  // ...
+//  d_collector.printLatencies(stream);  // at every print
+//..
+
+// BMQ
+
+#include <bmqt_messageguid.h>
+
+// BDE
+#include <ball_log.h>
+#include <bsl_iosfwd.h>
+#include <bsl_vector.h>
+#include <bslh_hash.h>
+#include <bslma_allocator.h>
+#include <bsls_atomic.h>
+#include <bsls_atomicoperations.h>
+#include <bsls_cpp11.h>
+#include <bsls_performancehint.h>
+#include <bsls_types.h>
+
+namespace BloombergLP {
+namespace bmqp {
+
+// ======================
+// struct MessageTraceHop
+// ======================
+
+/// This struct defines the hops of a message at which it is traced.
+struct MessageTraceHop {
+    // TYPES
+    enum Enum {
+        e_SDK_PUT = 0  // PUT posted by the SDK
+        ,
+        e_BROKER_PUT_IN = 1  // PUT received by a broker from a client
+        ,
+        e_BROKER_PUT_OUT = 2  // PUT relayed upstream by a broker
+        ,
+        e_PRIMARY_STORED = 3  // PUT stored by the primary
+        ,
+        e_BROKER_PUSH_OUT = 4  // PUSH sent by a broker to a client
+        ,
+        e_SDK_PUSH_IN = 5  // PUSH received by the SDK
+    };
+
+    // CONSTANTS
+
+    /// Number of enumerators.
+    static const int k_NUM_HOPS = e_SDK_PUSH_IN + 1;
+
+    // CLASS METHODS
+
+    /// Write the string representation of the specified enumeration `value`
+    /// to the specified output `stream`, and return a reference to
+    /// `stream`.  Optionally specify an initial indentation `level`, whose
+    /// absolute value is incremented recursively for nested objects.  If
+    /// `level` is specified, optionally specify `spacesPerLevel`, whose
+    /// absolute value indicates the number of spaces per indentation level
+    /// for this and all of its nested objects.  If `level` is negative,
+    /// suppress indentation of the first line.  If `spacesPerLevel` is
+    /// negative, format the entire output on one line, suppressing all but
+    /// the initial indentation (as governed by `level`).  See `toAscii` for
+    /// what constitutes the string representation of a
+    /// `MessageTraceHop::Enum` value.
+    static bsl::ostream& print(bsl::ostream&         stream,
+                               MessageTraceHop::Enum value,
+                               int                   level          = 0,
+                               int                   spacesPerLevel = 4);
+
+    /// Return the non-modifiable string representation corresponding to the
+    /// specified enumeration `value`, if it exists, and a unique (error)
+    /// string otherwise.  The string representation of `value` matches its
+    /// corresponding enumerator name with the "e_" prefix elided.
+    static const char* toAscii(MessageTraceHop::Enum value);
+};
+
+// FREE OPERATORS
+
+/// Format the specified `value` to the specified output `stream` and return
+/// a reference to the modifiable `stream`.
+bsl::ostream& operator<<(bsl::ostream& stream, MessageTraceHop::Enum value);
+
+// =========================
+// struct MessageTraceRecord
+// =========================
+
+/// Timestamp of a message at one of its hops.
+struct MessageTraceRecord {
+    // PUBLIC DATA
+    bmqt::MessageGUID d_guid;
+    // GUID of the message.
+
+    MessageTraceHop::Enum d_hop;
+    // Hop of the message.
+
+    bsls::Types::Int64 d_timestamp;
+    // Time the message went through the hop, in
+    // nanoseconds since the epoch, as returned by
+    // the realtime clock.
+
+    // CREATORS
+
+    /// Create a record of an unset GUID at the first hop, with a timestamp
+    /// of 0.
+    MessageTraceRecord();
+
+    /// Create a record of the message having the specified `guid` going
+    /// through the specified `hop` at the specified `timestamp`.
+    MessageTraceRecord(const bmqt::MessageGUID& guid,
+                       MessageTraceHop::Enum    hop,
+                       bsls::Types::Int64       timestamp);
+};
+
+// FREE OPERATORS
+
+/// Format the specified `value` to the specified output `stream` and return
+/// a reference to the modifiable `stream`.
+bsl::ostream& operator<<(bsl::ostream&             stream,
+                         const MessageTraceRecord& value);
+
+// ========================
+// class MessageTraceBuffer
+// ========================
+
+/// Lock-free ring buffer of trace records, written to by any number of
+/// threads, and read by a single thread.
+class MessageTraceBuffer {
+  private:
+    // PRIVATE TYPES
+    typedef bsls::AtomicOperations::AtomicTypes::Uint64 AtomicSequence;
+
+    // DATA
+    bsl::vector<MessageTraceRecord> d_records;
+    // Records, indexed by their position modulo
+    // the capacity.
+
+    mutable bsl::vector<AtomicSequence> d_sequences;
+    // For each record, one plus its position if
+    // it was written, or 0 if it is being
+    // written.  Mutable because the reader
+    // re-reads them with a read-modify-write
+    // (see 'loadRecords').
+
+    bsls::Types::Uint64 d_mask;
+    // Capacity minus one.
+
+    bsls::AtomicUint64 d_nextPosition;
+    // Position of the next record to write.
+
+  private:
+    // NOT IMPLEMENTED
+    MessageTraceBuffer(const MessageTraceBuffer&) BSLS_CPP11_DELETED;
+    MessageTraceBuffer&
+    operator=(const MessageTraceBuffer&) BSLS_CPP11_DELETED;
+
+  public:
+    // CREATORS
+
+    /// Create a buffer holding the latest records written to it, up to the
+    /// specified `capacity` rounded up to a power of 2, using the specified
+    /// `allocator` for memory allocation.  The behavior is undefined unless
+    /// `0 < capacity`.
+    MessageTraceBuffer(int capacity, bslma::Allocator* allocator);
+
+    // MANIPULATORS
+
+    /// Write the specified `record` to this buffer, overwriting the oldest
+    /// record if the buffer is full.  Note that a record may be lost if it
+    /// is overwritten while being written, which requires as many
+    /// concurrent writes as the capacity of this buffer.
+    void record(const MessageTraceRecord& record);
+
+    // ACCESSORS
+
+    /// Append to the specified `records` the records written to this buffer
+    /// at or after the specified `position`, which haven't been overwritten
+    /// yet, and return the position following the last written record, to
+    /// be passed to the next call.  The records being written concurrently
+    /// are skipped.
+    bsls::Types::Uint64 loadRecords(bsl::vector<MessageTraceRecord>* records,
+                                    bsls::Types::Uint64 position) const;
+
+    /// Return the maximum number of records held by this buffer.
+    int capacity() const;
+};
+
+// =======================
+// struct MessageTraceUtil
+// =======================
+
+/// Process-wide sampling and recording of message traces.
+struct MessageTraceUtil {
+  private:
+    // CLASS DATA
+
+    /// Sampling period minus one, or -1 if tracing is disabled.
+    static bsls::AtomicInt s_samplingMask;
+
+  private:
+    // PRIVATE CLASS METHODS
+
+    /// Record that the message having the specified `guid` goes through the
+    /// specified `hop` now.
+    static void recordHopImp(const bmqt::MessageGUID& guid,
+                             MessageTraceHop::Enum    hop);
+
+  public:
+    // CONSTANTS
+
+    /// Number of records held by the process-wide buffer.
+    static const int k_BUFFER_CAPACITY = 64 * 1024;
+
+    // CLASS METHODS
+
+    /// Perform the one time initialization of the process-wide state of
+    /// tracing, which is disabled.  This method can be called multiple
+    /// times provided that for each call to `initialize` there is a
+    /// corresponding call to `shutdown`.  Use the optionally specified
+    /// `allocator` for any memory allocation, or the `global` allocator if
+    /// none is provided.
+    static void initialize(bslma::Allocator* allocator = 0);
+
+    /// Pendant operation of the `initialize` one.  The process-wide state
+    /// is destroyed by the call to `shutdown` matching the first call to
+    /// `initialize`.  The behavior is undefined if `shutdown` is called
+    /// without `initialize` first being called.
+    static void shutdown();
+
+    /// Trace one in the specified `samplingPeriod` messages, rounded down
+    /// to a power of 2, or disable tracing if `samplingPeriod` is 0.  The
+    /// buffer of records is allocated the first time tracing is enabled.
+    /// The behavior is undefined unless `0 <= samplingPeriod`.
+    static void setSamplingPeriod(int samplingPeriod);
+
+    /// Return the sampling period of the traced messages, or 0 if tracing
+    /// is disabled.
+    static int samplingPeriod();
+
+    /// Return true if the message having the specified `guid` is traced,
+    /// and false otherwise.
+    static bool isSampled(const bmqt::MessageGUID& guid);
+
+    /// Record that the message having the specified `guid` goes through the
+    /// specified `hop` now, if it is traced.
+    static void recordHop(const bmqt::MessageGUID& guid,
+                          MessageTraceHop::Enum    hop);
+
+    /// Append to the specified `records` the records of the process-wide
+    /// buffer written at or after the specified `position`, and return the
+    /// position to be passed to the next call.  Load nothing if tracing was
+    /// never enabled.
+    static bsls::Types::Uint64
+    loadRecords(bsl::vector<MessageTraceRecord>* records,
+                bsls::Types::Uint64              position);
+
+    /// Print to the specified `stream` the number, average and max of the
+    /// latencies between each two consecutive hops of the messages having
+    /// records in the specified `records`.
+    static void printLatencies(bsl::ostream&                          stream,
+                               const bsl::vector<MessageTraceRecord>& records);
+};
+
+// ===========================
+// class MessageTraceCollector
+// ===========================
+
+/// Exporter of the records of the process-wide buffer, read by a single
+/// thread.
+class MessageTraceCollector {
+  private:
+    // CLASS-SCOPE CATEGORY
+    BALL_LOG_SET_CLASS_CATEGORY("BMQP.MESSAGETRACE");
+
+  private:
+    // DATA
+    bsl::vector<MessageTraceRecord> d_records;
+    // Records collected since the latencies
+    // were last printed.
+
+    bsls::Types::Uint64 d_position;
+    // Position in the process-wide buffer to
+    // collect the next records from.
+
+  private:
+    // NOT IMPLEMENTED
+    MessageTraceCollector(const MessageTraceCollector&) BSLS_CPP11_DELETED;
+    MessageTraceCollector&
+    operator=(const MessageTraceCollector&) BSLS_CPP11_DELETED;
+
+  public:
+    // CREATORS
+
+    /// Create a collector starting at the oldest record of the process-wide
+    /// buffer, using the specified `allocator` for memory allocation.
+    explicit MessageTraceCollector(bslma::Allocator* allocator = 0);
+
+    // MANIPULATORS
+
+    /// Load the records written to the process-wide buffer since the
+    /// previous call, log them, one per line, to the `BMQP.MESSAGETRACE`
+    /// category at `INFO` severity, and keep them for the next call to
+    /// `printLatencies`.  Return the number of records loaded.  Note that
+    /// this method should be called often enough for the buffer not to
+    /// wrap around in between, eg at every stats snapshot.
+    int collect();
+
+    /// Print to the specified `stream` the latencies of the messages
+    /// having records collected since the previous call, as
+    /// `MessageTraceUtil::printLatencies` does, and forget these records.
+    void printLatencies(bsl::ostream& stream);
+
+    // ACCESSORS
+
+    /// Return the number of records collected since `printLatencies` was
+    /// last called.
+    int numRecords() const;
+};
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+// -----------------------
+// struct MessageTraceUtil
+// -----------------------
+
+inline bool MessageTraceUtil::isSampled(const bmqt::MessageGUID& guid)
+{
+    const int mask = s_samplingMask.loadRelaxed();
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(mask < 0)) {
+        return false;  // RETURN
+    }
+
+    // Mix the bits of the hash, so that the sampling doesn't depend on the
+    // fields of the GUID which vary the least.
+    const bsls::Types::Uint64 hash =
+        bslh::Hash<bmqt::MessageGUIDHashAlgo>()(guid) * 0x9E3779B97F4A7C15ULL;
+
+    return ((hash >> 32) & static_cast<bsls::Types::Uint64>(mask)) == 0;
+}
+
+inline void MessageTraceUtil::recordHop(const bmqt::MessageGUID& guid,
+                                        MessageTraceHop::Enum    hop)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(isSampled(guid))) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        recordHopImp(guid, hop);
+    }
+}
+
+}  // close package namespace
+
+// ----------------------
+// struct MessageTraceHop
+// ----------------------
+
+// FREE OPERATORS
+inline bsl::ostream& bmqp::operator<<(bsl::ostream&               stream,
+                                      bmqp::MessageTraceHop::Enum value)
+{
+    return bmqp::MessageTraceHop::print(stream, value, 0, -1);
+}
+
+}  // close enterprise namespace
+
+#endif
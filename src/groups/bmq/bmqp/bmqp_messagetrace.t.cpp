@@ -0,0 +1,414 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// bmqp_messagetrace.t.cpp                                            -*-C++-*-
+#include <bmqp_messagetrace.h>
+
+// BMQ
+#include <bmqt_messageguid.h>
+
+// MWC
+#include <mwcu_memoutstream.h>
+
+// BDE
+#include <bdlf_bind.h>
+#include <bsl_cstring.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+#include <bslmt_barrier.h>
+#include <bslmt_threadgroup.h>
+#include <bsls_types.h>
+
+// TEST DRIVER
+#include <mwctst_testhelper.h>
+
+// CONVENIENCE
+using namespace BloombergLP;
+using namespace bsl;
+
+namespace {
+
+// FUNCTIONS
+
+/// Return a GUID made of the specified `value`.
+bmqt::MessageGUID makeGUID(int value)
+{
+    unsigned char buffer[bmqt::MessageGUID::e_SIZE_BINARY] = {};
+    bsl::memcpy(buffer, &value, sizeof(value));
+
+    bmqt::MessageGUID guid;
+    guid.fromBinary(buffer);
+    return guid;
+}
+
+/// Wait on the specified `barrier`, then write to the specified `buffer`
+/// the specified `numRecords` records of GUIDs made of the specified
+/// `threadId`, at the hop of index `threadId`, with increasing timestamps.
+void writeRecords(bmqp::MessageTraceBuffer* buffer,
+                  bslmt::Barrier*           barrier,
+                  int                       threadId,
+                  int                       numRecords)
+{
+    barrier->wait();
+
+    const bmqt::MessageGUID guid = makeGUID(threadId);
+    for (int i = 0; i < numRecords; ++i) {
+        buffer->record(bmqp::MessageTraceRecord(
+            guid,
+            static_cast<bmqp::MessageTraceHop::Enum>(threadId),
+            i));
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                                    TESTS
+// ----------------------------------------------------------------------------
+
+static void test1_breathingTest()
+// ------------------------------------------------------------------------
+// BREATHING TEST
+//
+// Testing:
+//   Printing hops and records, and writing and loading records of a
+//   'bmqp::MessageTraceBuffer'.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("BREATHING TEST");
+
+    PV("Hops");
+    ASSERT_EQ(0,
+              bsl::strcmp("BROKER_PUT_IN",
+                          bmqp::MessageTraceHop::toAscii(
+                              bmqp::MessageTraceHop::e_BROKER_PUT_IN)));
+    ASSERT_EQ(0,
+              bsl::strcmp("(* UNKNOWN *)",
+                          bmqp::MessageTraceHop::toAscii(
+                              static_cast<bmqp::MessageTraceHop::Enum>(
+                                  bmqp::MessageTraceHop::k_NUM_HOPS))));
+
+    mwcu::MemOutStream stream(s_allocator_p);
+    stream << bmqp::MessageTraceHop::e_SDK_PUSH_IN;
+    ASSERT_EQ(stream.str(), "SDK_PUSH_IN");
+
+    PV("Buffer");
+    bmqp::MessageTraceBuffer obj(3, s_allocator_p);
+    ASSERT_EQ(obj.capacity(), 4);
+
+    bsl::vector<bmqp::MessageTraceRecord> records(s_allocator_p);
+    ASSERT_EQ(obj.loadRecords(&records, 0), 0U);
+    ASSERT(records.empty());
+
+    for (int i = 0; i < 3; ++i) {
+        obj.record(bmqp::MessageTraceRecord(makeGUID(i),
+                                            bmqp::MessageTraceHop::e_SDK_PUT,
+                                            i));
+    }
+
+    bsls::Types::Uint64 position = obj.loadRecords(&records, 0);
+    ASSERT_EQ(position, 3U);
+    ASSERT_EQ(records.size(), 3U);
+    for (size_t i = 0; i < records.size(); ++i) {
+        ASSERT_EQ_D(i, records[i].d_guid, makeGUID(static_cast<int>(i)));
+        ASSERT_EQ_D(i, records[i].d_timestamp, static_cast<int>(i));
+    }
+
+    PV("Load from a position");
+    records.clear();
+    obj.record(bmqp::MessageTraceRecord(makeGUID(3),
+                                        bmqp::MessageTraceHop::e_SDK_PUT,
+                                        3));
+    position = obj.loadRecords(&records, position);
+    ASSERT_EQ(position, 4U);
+    ASSERT_EQ(records.size(), 1U);
+    ASSERT_EQ(records[0].d_timestamp, 3);
+
+    PV("Overwritten records");
+
+    // Only the latest 4 of the 10 records written since the position are
+    // loaded.
+
+    records.clear();
+    for (int i = 4; i < 14; ++i) {
+        obj.record(bmqp::MessageTraceRecord(makeGUID(i),
+                                            bmqp::MessageTraceHop::e_SDK_PUT,
+                                            i));
+    }
+    position = obj.loadRecords(&records, position);
+    ASSERT_EQ(position, 14U);
+    ASSERT_EQ(records.size(), 4U);
+    ASSERT_EQ(records.front().d_timestamp, 10);
+    ASSERT_EQ(records.back().d_timestamp, 13);
+}
+
+static void test2_sampling()
+// ------------------------------------------------------------------------
+// SAMPLING
+//
+// Concerns:
+//   - No message is sampled, and nothing is recorded, while tracing is
+//     disabled.
+//   - The sampling period is rounded down to a power of 2, and about one
+//     in that many messages is sampled.
+//   - The messages sampled with a period are also sampled with any lower
+//     period.
+//   - The hops of the sampled messages are recorded in the process-wide
+//     buffer.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("SAMPLING");
+
+    bmqp::MessageTraceUtil::initialize(s_allocator_p);
+
+    const bmqt::MessageGUID guid = makeGUID(1);
+
+    bsl::vector<bmqp::MessageTraceRecord> records(s_allocator_p);
+
+    PV("Disabled");
+    ASSERT_EQ(bmqp::MessageTraceUtil::samplingPeriod(), 0);
+    ASSERT(!bmqp::MessageTraceUtil::isSampled(guid));
+    bmqp::MessageTraceUtil::recordHop(guid, bmqp::MessageTraceHop::e_SDK_PUT);
+    ASSERT_EQ(bmqp::MessageTraceUtil::loadRecords(&records, 0), 0U);
+    ASSERT(records.empty());
+
+    PV("Rounding of the sampling period");
+    bmqp::MessageTraceUtil::setSamplingPeriod(100);
+    ASSERT_EQ(bmqp::MessageTraceUtil::samplingPeriod(), 64);
+
+    PV("Sampling rate");
+    const int k_NUM_GUIDS = 64 * 1024;
+
+    bsl::vector<char> isSampledBy8(k_NUM_GUIDS, 0, s_allocator_p);
+    bmqp::MessageTraceUtil::setSamplingPeriod(8);
+    int numSampled = 0;
+    for (int i = 0; i < k_NUM_GUIDS; ++i) {
+        isSampledBy8[i] = bmqp::MessageTraceUtil::isSampled(makeGUID(i));
+        numSampled += isSampledBy8[i];
+    }
+    ASSERT_GT(numSampled, k_NUM_GUIDS / 8 * 9 / 10);
+    ASSERT_LT(numSampled, k_NUM_GUIDS / 8 * 11 / 10);
+
+    bmqp::MessageTraceUtil::setSamplingPeriod(2);
+    for (int i = 0; i < k_NUM_GUIDS; ++i) {
+        if (isSampledBy8[i]) {
+            ASSERT_D(i, bmqp::MessageTraceUtil::isSampled(makeGUID(i)));
+        }
+    }
+
+    PV("Recording");
+    bmqp::MessageTraceUtil::setSamplingPeriod(1);
+    ASSERT(bmqp::MessageTraceUtil::isSampled(guid));
+    bmqp::MessageTraceUtil::recordHop(guid, bmqp::MessageTraceHop::e_SDK_PUT);
+    bmqp::MessageTraceUtil::recordHop(guid,
+                                      bmqp::MessageTraceHop::e_SDK_PUSH_IN);
+
+    bsls::Types::Uint64 position =
+        bmqp::MessageTraceUtil::loadRecords(&records, 0);
+    ASSERT_EQ(position, 2U);
+    ASSERT_EQ(records.size(), 2U);
+    ASSERT_EQ(records[0].d_guid, guid);
+    ASSERT_EQ(records[0].d_hop, bmqp::MessageTraceHop::e_SDK_PUT);
+    ASSERT_EQ(records[1].d_hop, bmqp::MessageTraceHop::e_SDK_PUSH_IN);
+    ASSERT_LE(records[0].d_timestamp, records[1].d_timestamp);
+
+    PV("Disabling");
+    bmqp::MessageTraceUtil::setSamplingPeriod(0);
+    bmqp::MessageTraceUtil::recordHop(guid, bmqp::MessageTraceHop::e_SDK_PUT);
+    ASSERT_EQ(bmqp::MessageTraceUtil::loadRecords(&records, position),
+              position);
+
+    bmqp::MessageTraceUtil::shutdown();
+}
+
+static void test3_printLatencies()
+// ------------------------------------------------------------------------
+// PRINT LATENCIES
+//
+// Concerns:
+//   - The latencies between each two consecutive hops of a message are
+//     aggregated, regardless of the order of the records.
+//   - Messages having a single record have no latency.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("PRINT LATENCIES");
+
+    typedef bmqp::MessageTraceHop Hop;
+
+    bsl::vector<bmqp::MessageTraceRecord> records(s_allocator_p);
+
+    PV("No latency");
+    records.push_back(
+        bmqp::MessageTraceRecord(makeGUID(1), Hop::e_SDK_PUT, 1000));
+    {
+        mwcu::MemOutStream stream(s_allocator_p);
+        bmqp::MessageTraceUtil::printLatencies(stream, records);
+
+        const bsl::string output(stream.str(), s_allocator_p);
+        ASSERT_NE(output.find("No latency"), bsl::string::npos);
+    }
+
+    PV("Latencies");
+    records.push_back(
+        bmqp::MessageTraceRecord(makeGUID(2), Hop::e_BROKER_PUT_IN, 5000));
+    records.push_back(
+        bmqp::MessageTraceRecord(makeGUID(1), Hop::e_BROKER_PUT_IN, 2000));
+    records.push_back(
+        bmqp::MessageTraceRecord(makeGUID(2), Hop::e_SDK_PUT, 2000));
+    records.push_back(
+        bmqp::MessageTraceRecord(makeGUID(1), Hop::e_PRIMARY_STORED, 2500));
+    {
+        mwcu::MemOutStream stream(s_allocator_p);
+        bmqp::MessageTraceUtil::printLatencies(stream, records);
+        PV(stream.str());
+
+        const bsl::string output(stream.str(), s_allocator_p);
+        ASSERT_NE(output.find("SDK_PUT -> BROKER_PUT_IN: 2 messages"),
+                  bsl::string::npos);
+        ASSERT_NE(output.find("BROKER_PUT_IN -> PRIMARY_STORED: 1 messages"),
+                  bsl::string::npos);
+        ASSERT_EQ(output.find("SDK_PUT -> PRIMARY_STORED"), bsl::string::npos);
+    }
+}
+
+static void test4_concurrentWrites()
+// ------------------------------------------------------------------------
+// CONCURRENT WRITES
+//
+// Concerns:
+//   - Records written concurrently by multiple threads, while being read,
+//     are loaded whole.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("CONCURRENT WRITES");
+
+    const int k_NUM_THREADS = bmqp::MessageTraceHop::k_NUM_HOPS;
+    const int k_NUM_RECORDS = 100 * 1000;
+
+    bmqp::MessageTraceBuffer obj(1024, s_allocator_p);
+    bslmt::Barrier           barrier(k_NUM_THREADS + 1);
+    bslmt::ThreadGroup       threadGroup(s_allocator_p);
+
+    for (int i = 0; i < k_NUM_THREADS; ++i) {
+        const int rc = threadGroup.addThread(
+            bdlf::BindUtil::bindS(s_allocator_p,
+                                  &writeRecords,
+                                  &obj,
+                                  &barrier,
+                                  i,
+                                  k_NUM_RECORDS));
+        ASSERT_EQ_D(i, rc, 0);
+    }
+
+    barrier.wait();
+
+    bsl::vector<bmqp::MessageTraceRecord> records(s_allocator_p);
+    bsls::Types::Uint64                   position = 0;
+    bsls::Types::Uint64                   end      = static_cast<
+        bsls::Types::Uint64>(k_NUM_THREADS * k_NUM_RECORDS);
+    while (position != end) {
+        records.clear();
+        position = obj.loadRecords(&records, position);
+
+        for (size_t i = 0; i < records.size(); ++i) {
+            // The GUID of a record is made of the hop of the record.
+            ASSERT_EQ_D(i, records[i].d_guid, makeGUID(records[i].d_hop));
+            ASSERT_LT_D(i, records[i].d_timestamp, k_NUM_RECORDS);
+        }
+    }
+
+    threadGroup.joinAll();
+}
+
+static void test5_collector()
+// ------------------------------------------------------------------------
+// COLLECTOR
+//
+// Concerns:
+//   - Each call to 'collect' loads the records written to the process-wide
+//     buffer since the previous call, and only these.
+//   - The collected records are kept until their latencies are printed,
+//     and forgotten afterwards.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("COLLECTOR");
+
+    typedef bmqp::MessageTraceHop Hop;
+
+    bmqp::MessageTraceUtil::initialize(s_allocator_p);
+    bmqp::MessageTraceUtil::setSamplingPeriod(1);
+
+    bmqp::MessageTraceCollector obj(s_allocator_p);
+    ASSERT_EQ(obj.collect(), 0);
+    ASSERT_EQ(obj.numRecords(), 0);
+
+    PV("Collect");
+    bmqp::MessageTraceUtil::recordHop(makeGUID(1), Hop::e_SDK_PUT);
+    bmqp::MessageTraceUtil::recordHop(makeGUID(2), Hop::e_SDK_PUT);
+    bmqp::MessageTraceUtil::recordHop(makeGUID(1), Hop::e_BROKER_PUT_IN);
+    ASSERT_EQ(obj.collect(), 3);
+    ASSERT_EQ(obj.numRecords(), 3);
+    ASSERT_EQ(obj.collect(), 0);
+    ASSERT_EQ(obj.numRecords(), 3);
+
+    bmqp::MessageTraceUtil::recordHop(makeGUID(2), Hop::e_BROKER_PUT_IN);
+    ASSERT_EQ(obj.collect(), 1);
+    ASSERT_EQ(obj.numRecords(), 4);
+
+    PV("Print latencies");
+    {
+        mwcu::MemOutStream stream(s_allocator_p);
+        obj.printLatencies(stream);
+        PV(stream.str());
+
+        const bsl::string output(stream.str(), s_allocator_p);
+        ASSERT_NE(output.find("SDK_PUT -> BROKER_PUT_IN: 2 messages"),
+                  bsl::string::npos);
+    }
+    ASSERT_EQ(obj.numRecords(), 0);
+    {
+        mwcu::MemOutStream stream(s_allocator_p);
+        obj.printLatencies(stream);
+
+        const bsl::string output(stream.str(), s_allocator_p);
+        ASSERT_NE(output.find("No latency"), bsl::string::npos);
+    }
+
+    bmqp::MessageTraceUtil::shutdown();
+}
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    TEST_PROLOG(mwctst::TestHelper::e_DEFAULT);
+
+    switch (_testCase) {
+    case 0:
+    case 5: test5_collector(); break;
+    case 4: test4_concurrentWrites(); break;
+    case 3: test3_printLatencies(); break;
+    case 2: test2_sampling(); break;
+    case 1: test1_breathingTest(); break;
+    default: {
+        cerr << "WARNING: CASE '" << _testCase << "' NOT FOUND." << endl;
+        s_testStatus = -1;
+    } break;
+    }
+
+    TEST_EPILOG(mwctst::TestHelper::e_CHECK_DEF_GBL_ALLOC);
+}
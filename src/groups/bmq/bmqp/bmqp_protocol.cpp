@@ -264,6 +264,12 @@ const char HighAvailabilityFeatures::k_BROADCAST_TO_PROXIES[] =
     "BROADCAST_TO_PROXIES";
 const char HighAvailabilityFeatures::k_GRACEFUL_SHUTDOWN[] =
     "GRACEFUL_SHUTDOWN";
+const char HighAvailabilityFeatures::k_PARALLEL_RECOVERY[] =
+    "PARALLEL_RECOVERY";
+const char HighAvailabilityFeatures::k_INCREMENTAL_RECOVERY[] =
+    "INCREMENTAL_RECOVERY";
+const char HighAvailabilityFeatures::k_COMPRESSED_REPLICATION[] =
+    "COMPRESSED_REPLICATION";
 
 // --------------------------------
 // struct MessagePropertiesFeatures
@@ -273,6 +279,13 @@ const char MessagePropertiesFeatures::k_FIELD_NAME[] = "MPS";
 const char MessagePropertiesFeatures::k_MESSAGE_PROPERTIES_EX[] =
     "MESSAGE_PROPERTIES_EX";
 
+// ------------------
+// struct AckFeatures
+// ------------------
+
+const char AckFeatures::k_FIELD_NAME[] = "ACK";
+const char AckFeatures::k_CUMULATIVE[] = "CUMULATIVE";
+
 // -----------------
 // struct OptionType
 // -----------------
@@ -336,6 +349,11 @@ const int EventHeaderUtil::k_CONTROL_EVENT_ENCODING_MASK =
     bdlb::BitMaskUtil::one(EventHeaderUtil::k_CONTROL_EVENT_ENCODING_START_IDX,
                            EventHeaderUtil::k_CONTROL_EVENT_ENCODING_NUM_BITS);
 
+const int EventHeaderUtil::k_STORAGE_EVENT_COMPRESSION_MASK =
+    bdlb::BitMaskUtil::one(
+        EventHeaderUtil::k_STORAGE_EVENT_COMPRESSION_START_IDX,
+        EventHeaderUtil::k_STORAGE_EVENT_COMPRESSION_NUM_BITS);
+
 // -------------------
 // struct OptionHeader
 // -------------------
@@ -29,6 +29,8 @@
 //  bmqp::EncodingType   : Enum for types of encoding used for control message.
 //  bmqp::EncodingFeature: Field name of the encoding features and the list of
 //                         supported encoding features.
+//  bmqp::AckFeatures    : Field name and values of the acknowledgement
+//                         features.
 //  bmqp::OptionType     : Enum for types of options for PUT or PUSH messages.
 //  bmqp::EventHeader    : Header for a BlazingMQ event packet sent on the wire
 //  bmqp::EventHeaderUtil: Utility methods for 'bmqp::EventHeader'.
@@ -632,6 +634,17 @@ struct HighAvailabilityFeatures {
     static const char k_BROADCAST_TO_PROXIES[];
 
     static const char k_GRACEFUL_SHUTDOWN[];
+
+    /// Indicates that the node accepts the chunks of the different files
+    /// of a partition interleaved during partition sync.
+    static const char k_PARALLEL_RECOVERY[];
+
+    /// Indicates that the node accepts, during partition sync, a patch
+    /// starting at an older sync point than the one it requested.
+    static const char k_INCREMENTAL_RECOVERY[];
+
+    /// Indicates that the node accepts compressed storage events.
+    static const char k_COMPRESSED_REPLICATION[];
 };
 
 /// This struct defines feature names related to MessageProperties
@@ -643,6 +656,18 @@ struct MessagePropertiesFeatures {
     static const char k_MESSAGE_PROPERTIES_EX[];
 };
 
+/// This struct defines feature names related to acknowledgements
+struct AckFeatures {
+    /// Field name of the acknowledgement features
+    static const char k_FIELD_NAME[];
+
+    // CONSTANTS
+
+    /// The peer understands `ACK` events having the
+    /// `AckHeaderFlags::e_CUMULATIVE` flag set.
+    static const char k_CUMULATIVE[];
+};
+
 // =================
 // struct OptionType
 // =================
@@ -752,6 +777,12 @@ struct EventHeader {
     //      +---------------+
     //      |CODEC| Reserved|
     //
+    //: o StorageMessage: represent the compression algorithm used for the
+    //:   content of the event following the EventHeader
+    //      |0|1|2|3|4|5|6|7|
+    //      +---------------+
+    //      |CA   | Reserved|
+    //
     // NOTE: The HeaderWords allows to eventually put event level options
     //       (either by extending the EventHeader struct, or putting new struct
     //       after the EventHeader).  For now, this is left up for future
@@ -901,6 +932,10 @@ struct EventHeaderUtil {
     static const int k_CONTROL_EVENT_ENCODING_START_IDX = 5;
     static const int k_CONTROL_EVENT_ENCODING_MASK;
 
+    static const int k_STORAGE_EVENT_COMPRESSION_NUM_BITS  = 3;
+    static const int k_STORAGE_EVENT_COMPRESSION_START_IDX = 5;
+    static const int k_STORAGE_EVENT_COMPRESSION_MASK;
+
   public:
     // CLASS METHODS
 
@@ -913,6 +948,18 @@ struct EventHeaderUtil {
     /// appropriate bits in the specified `eventHeader`.
     static EncodingType::Enum
     controlEventEncodingType(const EventHeader& eventHeader);
+
+    /// Set the appropriate bits in the specified `eventHeader` to represent
+    /// the specified compression `algorithm` of the content of a storage
+    /// event.
+    static void setStorageEventCompressionType(
+        EventHeader*                         eventHeader,
+        bmqt::CompressionAlgorithmType::Enum algorithm);
+
+    /// Return the compression algorithm of the content of a storage event
+    /// represented by the appropriate bits in the specified `eventHeader`.
+    static bmqt::CompressionAlgorithmType::Enum
+    storageEventCompressionType(const EventHeader& eventHeader);
 };
 
 // ===================
@@ -1826,10 +1873,16 @@ struct AckHeader {
 
 /// This struct defines the meanings of each bits of the flags field of the
 /// `AckHeader` structure.
+///
+/// e_CUMULATIVE: each `AckMessage` of the event acknowledges, with its
+///               status, the message having its GUID as well as all the
+///               messages posted before it on the same queue and not yet
+///               acknowledged.  Only sent to a peer which advertised the
+///               `AckFeatures::k_CUMULATIVE` feature.
 struct AckHeaderFlags {
     // TYPES
     enum Enum {
-        e_UNUSED1 = (1 << 0),
+        e_CUMULATIVE = (1 << 0),
         e_UNUSED2 = (1 << 1),
         e_UNUSED3 = (1 << 2),
         e_UNUSED4 = (1 << 4),
@@ -3854,6 +3907,37 @@ EventHeaderUtil::controlEventEncodingType(const EventHeader& eventHeader)
     return static_cast<EncodingType::Enum>(encodingType);
 }
 
+inline void EventHeaderUtil::setStorageEventCompressionType(
+    EventHeader*                         eventHeader,
+    bmqt::CompressionAlgorithmType::Enum algorithm)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(eventHeader->type() == EventType::e_STORAGE);
+    BSLS_ASSERT_SAFE(algorithm != bmqt::CompressionAlgorithmType::e_UNKNOWN);
+
+    unsigned char typeSpecific = eventHeader->typeSpecific();
+
+    // Reset the bits for compression algorithm
+    typeSpecific &= ~k_STORAGE_EVENT_COMPRESSION_MASK;
+
+    // Set those bits to represent 'algorithm'
+    typeSpecific |= (algorithm << k_STORAGE_EVENT_COMPRESSION_START_IDX);
+
+    eventHeader->setTypeSpecific(typeSpecific);
+}
+
+inline bmqt::CompressionAlgorithmType::Enum
+EventHeaderUtil::storageEventCompressionType(const EventHeader& eventHeader)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(eventHeader.type() == EventType::e_STORAGE);
+
+    const unsigned char typeSpecific = eventHeader.typeSpecific();
+    const int algorithm = (typeSpecific & k_STORAGE_EVENT_COMPRESSION_MASK) >>
+                          k_STORAGE_EVENT_COMPRESSION_START_IDX;
+    return static_cast<bmqt::CompressionAlgorithmType::Enum>(algorithm);
+}
+
 // -------------------
 // struct OptionHeader
 // -------------------
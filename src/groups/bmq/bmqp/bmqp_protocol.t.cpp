@@ -1706,6 +1706,8 @@ static void test7_eventHeaderUtil()
 // Testing:
 //   EventHeaderUtil::setControlEventEncodingType
 //   EventHeaderUtil::controlEventEncodingType
+//   EventHeaderUtil::setStorageEventCompressionType
+//   EventHeaderUtil::storageEventCompressionType
 // --------------------------------------------------------------------
 {
     mwctst::TestHelper::printTestName("EVENT HEADER UTIL");
@@ -1741,6 +1743,44 @@ static void test7_eventHeaderUtil()
                 bmqp::EventHeaderUtil::controlEventEncodingType(eventHeader));
         }
     }
+
+    PV("Test bmqp::EventHeaderUtil setStorageEventCompressionType");
+    {
+        struct Test {
+            int                                  d_line;
+            bmqt::CompressionAlgorithmType::Enum d_value;
+        } k_DATA[] = {
+            {L_, bmqt::CompressionAlgorithmType::e_NONE},
+            {L_, bmqt::CompressionAlgorithmType::e_ZLIB},
+            {L_, bmqt::CompressionAlgorithmType::e_NONE},
+        };
+
+        const size_t k_NUM_DATA = sizeof(k_DATA) / sizeof(*k_DATA);
+
+        bmqp::EventHeader eventHeader(bmqp::EventType::e_STORAGE);
+        ASSERT_EQ(
+            bmqt::CompressionAlgorithmType::e_NONE,
+            bmqp::EventHeaderUtil::storageEventCompressionType(eventHeader));
+
+        // Set each compression algorithm in succession, and ensure that the
+        // algorithm returned is always the one last set
+        for (size_t idx = 0; idx != k_NUM_DATA; ++idx) {
+            const Test& test = k_DATA[idx];
+
+            // 1. Set the compression algorithm
+            PVV(test.d_line << ": Testing: EventHeaderUtil::"
+                            << "setStorageEventCompressionType("
+                            << test.d_value << ")");
+            bmqp::EventHeaderUtil::setStorageEventCompressionType(
+                &eventHeader,
+                test.d_value);
+
+            // 2. Verify that the intended compression algorithm is set
+            ASSERT_EQ(test.d_value,
+                      bmqp::EventHeaderUtil::storageEventCompressionType(
+                          eventHeader));
+        }
+    }
 }
 // ============================================================================
 //                                 MAIN PROGRAM
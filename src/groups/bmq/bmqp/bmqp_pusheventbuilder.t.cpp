@@ -18,6 +18,7 @@
 
 // BMQ
 #include <bmqp_event.h>
+#include <bmqp_messageguidgenerator.h>
 #include <bmqp_messageproperties.h>
 #include <bmqp_protocolutil.h>
 #include <bmqp_pushmessageiterator.h>
@@ -27,6 +28,7 @@
 // MWC
 #include <mwcu_blob.h>
 #include <mwcu_memoutstream.h>
+#include <mwcu_printutil.h>
 
 // BDE
 #include <bdlb_guidutil.h>
@@ -36,19 +38,29 @@
 #include <bdlbb_blobutil.h>
 #include <bdlbb_pooledblobbufferfactory.h>
 #include <bdlf_bind.h>
+#include <bdlt_timeunitratio.h>
 #include <bsl_cstdlib.h>
 #include <bsl_cstring.h>  // for bsl::strlen
 #include <bsl_ctime.h>
 #include <bsl_fstream.h>
 #include <bsl_iostream.h>
 #include <bsl_limits.h>
+#include <bsl_string.h>
 #include <bsl_vector.h>
 #include <bslma_usesbslmaallocator.h>
 #include <bslmf_nestedtraitdeclaration.h>
+#include <bsls_assert.h>
+#include <bsls_timeutil.h>
+#include <bsls_types.h>
 
 // TEST DRIVER
 #include <mwctst_testhelper.h>
 
+// BENCHMARKING LIBRARY
+#ifdef BSLS_PLATFORM_OS_LINUX
+#include <benchmark/benchmark.h>
+#endif
+
 // CONVENIENCE
 using namespace BloombergLP;
 using namespace bsl;
@@ -233,6 +245,84 @@ bool isDefaultSubscription(
             bmqp::Protocol::k_DEFAULT_SUBSCRIPTION_ID);
 }
 
+/// Number of messages of the events built by the benchmarks.
+const int k_BENCH_NUM_MESSAGES = 32;
+
+/// Payload lengths of the messages of the benchmarks.
+const int k_BENCH_PAYLOAD_LENGTHS[] = {64, 1024, 16384, 65536};
+
+const int k_NUM_BENCH_PAYLOAD_LENGTHS = sizeof(k_BENCH_PAYLOAD_LENGTHS) /
+                                        sizeof(*k_BENCH_PAYLOAD_LENGTHS);
+
+/// Load into the specified `payload` the specified `payloadLength` bytes.
+void populateBenchPayload(bdlbb::Blob* payload, int payloadLength)
+{
+    const bsl::string data(payloadLength, 'x', s_allocator_p);
+
+    payload->removeAll();
+    bdlbb::BlobUtil::append(payload, data.data(), payloadLength);
+}
+
+/// Build with the specified `builder` an event of `k_BENCH_NUM_MESSAGES`
+/// messages having the specified `payload` and the specified `guid`.
+void buildBenchEvent(bmqp::PushEventBuilder*  builder,
+                     const bdlbb::Blob&       payload,
+                     const bmqt::MessageGUID& guid)
+{
+    builder->reset();
+    for (int i = 0; i < k_BENCH_NUM_MESSAGES; ++i) {
+        const bmqt::EventBuilderResult::Enum rc = builder->packMessage(
+            payload,
+            i,
+            guid,
+            0,
+            bmqt::CompressionAlgorithmType::e_NONE);
+        BSLS_ASSERT_OPT(rc == bmqt::EventBuilderResult::e_SUCCESS);
+        (void)rc;
+    }
+}
+
+/// Iterate over the messages of the PUSH event in the specified `blob`,
+/// loading their payload, using the specified `bufferFactory`.  Return the
+/// number of messages.
+int iterateBenchEvent(const bdlbb::Blob&        blob,
+                      bdlbb::BlobBufferFactory* bufferFactory)
+{
+    bmqp::Event               event(&blob, s_allocator_p);
+    bmqp::PushMessageIterator iterator(bufferFactory, s_allocator_p);
+    bdlbb::Blob               payload(s_allocator_p);
+
+    event.loadPushMessageIterator(&iterator, true);
+
+    int numMessages = 0;
+    while (iterator.next() == 1) {
+        payload.removeAll();
+        iterator.loadMessagePayload(&payload);
+        ++numMessages;
+    }
+
+    return numMessages;
+}
+
+/// Print the specified `totalTimeNs` taken by the specified `numIterations`
+/// on events of messages having the specified `payloadLength`.
+void printBenchResult(int                payloadLength,
+                      int                numIterations,
+                      bsls::Types::Int64 totalTimeNs)
+{
+    const bsls::Types::Int64 numBytes = static_cast<bsls::Types::Int64>(
+                                            numIterations) *
+                                        k_BENCH_NUM_MESSAGES * payloadLength;
+
+    cout << "payload: " << mwcu::PrintUtil::prettyBytes(payloadLength)
+         << " => "
+         << mwcu::PrintUtil::prettyTimeInterval(totalTimeNs / numIterations)
+         << " per event, "
+         << mwcu::PrintUtil::prettyBytes(
+                numBytes * bdlt::TimeUnitRatio::k_NS_PER_S / totalTimeNs)
+         << " of payload per second\n";
+}
+
 }  // close unnamed namespace
 
 // ============================================================================
@@ -1205,6 +1295,170 @@ static void testN1_decodeFromFile()
     ASSERT_EQ(0, pushIter.next());  // we added only 1 msg
     ASSERT_EQ(false, pushIter.isValid());
 }
+
+BSLA_MAYBE_UNUSED
+static void testN2_buildEvent()
+// ------------------------------------------------------------------------
+// BENCHMARK: BUILD PUSH EVENT
+//
+// Concerns:
+//   Test the throughput of building PUSH events with
+//   'bmqp::PushEventBuilder', depending on the size of the payload of the
+//   messages.
+//
+// Plan:
+//   - For each payload length, time the build of a large number of events
+//     and report the average time per event and the payload throughput.
+//
+// Testing:
+//   Throughput of bmqp::PushEventBuilder::packMessage()
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("BENCHMARK: BUILD PUSH EVENT");
+
+    const int k_NUM_ITERS = 1000;
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::PushEventBuilder         builder(&bufferFactory, s_allocator_p);
+    bdlbb::Blob                    payload(&bufferFactory, s_allocator_p);
+    const bmqt::MessageGUID guid = bmqp::MessageGUIDGenerator::testGUID();
+
+    for (int l = 0; l < k_NUM_BENCH_PAYLOAD_LENGTHS; ++l) {
+        const int length = k_BENCH_PAYLOAD_LENGTHS[l];
+        populateBenchPayload(&payload, length);
+
+        // <time>
+        const bsls::Types::Int64 begin = bsls::TimeUtil::getTimer();
+        for (int i = 0; i < k_NUM_ITERS; ++i) {
+            buildBenchEvent(&builder, payload, guid);
+        }
+        const bsls::Types::Int64 end = bsls::TimeUtil::getTimer();
+        // </time>
+
+        printBenchResult(length, k_NUM_ITERS, end - begin);
+    }
+}
+
+BSLA_MAYBE_UNUSED
+static void testN2_iterateEvent()
+// ------------------------------------------------------------------------
+// BENCHMARK: ITERATE PUSH EVENT
+//
+// Concerns:
+//   Test the throughput of iterating over PUSH events with
+//   'bmqp::PushMessageIterator' and loading the payload of their
+//   messages, depending on the size of the payload.
+//
+// Plan:
+//   - For each payload length, build an event and time a large number of
+//     iterations over it, and report the average time per event and the
+//     payload throughput.
+//
+// Testing:
+//   Throughput of bmqp::PushMessageIterator
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("BENCHMARK: ITERATE PUSH EVENT");
+
+    const int k_NUM_ITERS = 1000;
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::PushEventBuilder         builder(&bufferFactory, s_allocator_p);
+    bdlbb::Blob                    payload(&bufferFactory, s_allocator_p);
+    const bmqt::MessageGUID guid = bmqp::MessageGUIDGenerator::testGUID();
+
+    for (int l = 0; l < k_NUM_BENCH_PAYLOAD_LENGTHS; ++l) {
+        const int length = k_BENCH_PAYLOAD_LENGTHS[l];
+        populateBenchPayload(&payload, length);
+        buildBenchEvent(&builder, payload, guid);
+
+        // <time>
+        const bsls::Types::Int64 begin = bsls::TimeUtil::getTimer();
+        for (int i = 0; i < k_NUM_ITERS; ++i) {
+            iterateBenchEvent(builder.blob(), &bufferFactory);
+        }
+        const bsls::Types::Int64 end = bsls::TimeUtil::getTimer();
+        // </time>
+
+        printBenchResult(length, k_NUM_ITERS, end - begin);
+    }
+}
+
+// Begin Benchmarking Tests
+#ifdef BSLS_PLATFORM_OS_LINUX
+static void testN2_buildEvent_GoogleBenchmark(benchmark::State& state)
+// ------------------------------------------------------------------------
+// BENCHMARK: BUILD PUSH EVENT
+//
+// Concerns:
+//   Test the throughput of building PUSH events with
+//   'bmqp::PushEventBuilder', depending on the size of the payload of the
+//   messages, provided as the argument of 'state'.
+//
+// Testing:
+//   Throughput of bmqp::PushEventBuilder::packMessage()
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("GOOGLE BENCHMARK: BUILD PUSH EVENT");
+
+    const int length = static_cast<int>(state.range(0));
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::PushEventBuilder         builder(&bufferFactory, s_allocator_p);
+    bdlbb::Blob                    payload(&bufferFactory, s_allocator_p);
+    const bmqt::MessageGUID guid = bmqp::MessageGUIDGenerator::testGUID();
+
+    populateBenchPayload(&payload, length);
+
+    // <time>
+    for (auto _ : state) {
+        buildBenchEvent(&builder, payload, guid);
+    }
+    // </time>
+
+    state.SetItemsProcessed(state.iterations() * k_BENCH_NUM_MESSAGES);
+    state.SetBytesProcessed(state.iterations() * k_BENCH_NUM_MESSAGES *
+                            length);
+}
+
+static void testN2_iterateEvent_GoogleBenchmark(benchmark::State& state)
+// ------------------------------------------------------------------------
+// BENCHMARK: ITERATE PUSH EVENT
+//
+// Concerns:
+//   Test the throughput of iterating over PUSH events with
+//   'bmqp::PushMessageIterator', depending on the size of the payload of
+//   the messages, provided as the argument of 'state'.
+//
+// Testing:
+//   Throughput of bmqp::PushMessageIterator
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("GOOGLE BENCHMARK: ITERATE PUSH EVENT");
+
+    const int length = static_cast<int>(state.range(0));
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::PushEventBuilder         builder(&bufferFactory, s_allocator_p);
+    bdlbb::Blob                    payload(&bufferFactory, s_allocator_p);
+    const bmqt::MessageGUID guid = bmqp::MessageGUIDGenerator::testGUID();
+
+    populateBenchPayload(&payload, length);
+    buildBenchEvent(&builder, payload, guid);
+
+    // <time>
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            iterateBenchEvent(builder.blob(), &bufferFactory));
+    }
+    // </time>
+
+    state.SetItemsProcessed(state.iterations() * k_BENCH_NUM_MESSAGES);
+    state.SetBytesProcessed(state.iterations() * k_BENCH_NUM_MESSAGES *
+                            length);
+}
+#endif  // BSLS_PLATFORM_OS_LINUX
+
 // ============================================================================
 //                                 MAIN PROGRAM
 // ----------------------------------------------------------------------------
@@ -1241,12 +1495,25 @@ int main(int argc, char* argv[])
     case 2: test2_buildEventBackwardsCompatibility(); break;
     case 1: test1_breathingTest(); break;
     case -1: testN1_decodeFromFile(); break;
+    case -2:
+        MWC_BENCHMARK_WITH_ARGS(testN2_buildEvent,
+                                RangeMultiplier(4)->Range(64, 65536));
+        MWC_BENCHMARK_WITH_ARGS(testN2_iterateEvent,
+                                RangeMultiplier(4)->Range(64, 65536));
+        break;
     default: {
         cerr << "WARNING: CASE '" << _testCase << "' NOT FOUND." << endl;
         s_testStatus = -1;
     } break;
     }
 
+#ifdef BSLS_PLATFORM_OS_LINUX
+    if (_testCase < 0) {
+        benchmark::Initialize(&argc, argv);
+        benchmark::RunSpecifiedBenchmarks();
+    }
+#endif
+
     bmqp::ProtocolUtil::shutdown();
 
     TEST_EPILOG(mwctst::TestHelper::e_CHECK_DEF_GBL_ALLOC);
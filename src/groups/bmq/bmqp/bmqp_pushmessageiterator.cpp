@@ -323,20 +323,33 @@ int PushMessageIterator::messagePayloadSize() const
     return d_lazyMessagePayloadSize;
 }
 
-int PushMessageIterator::loadMessagePayloadPosition() const
+int PushMessageIterator::loadMessagePayloadPosition(
+    mwcu::BlobPosition* position) const
 {
     // PRECONDITIONS
+    BSLS_ASSERT_SAFE(position);
     BSLS_ASSERT_SAFE(isValid());
     BSLS_ASSERT_SAFE(d_decompressFlag);
 
     enum RcEnum {
         // Value for the various RC error categories
-        rc_SUCCESS                  = 0,
-        rc_IMPLICIT_APP_DATA        = -1,
-        rc_INVALID_MSG_PROPS_OFFSET = -2,
-        rc_INVALID_PAYLOAD_OFFSET   = -3
+        rc_SUCCESS                = 0,
+        rc_IMPLICIT_APP_DATA      = -1,
+        rc_INVALID_PAYLOAD_OFFSET = -2
     };
 
+    if (isApplicationDataImplicit()) {
+        return rc_IMPLICIT_APP_DATA;  // RETURN
+    }
+
+    if (!hasMessageProperties() ||
+        d_lazyMessagePayloadPosition != mwcu::BlobPosition()) {
+        // Payload starts at the beginning of the application data if there
+        // are no message properties.
+        *position = d_lazyMessagePayloadPosition;
+        return rc_SUCCESS;  // RETURN
+    }
+
     // Message properties are present.
 
     BSLS_ASSERT_SAFE(0 < d_messagePropertiesSize);
@@ -352,6 +365,7 @@ int PushMessageIterator::loadMessagePayloadPosition() const
         return (rc * 10 + rc_INVALID_PAYLOAD_OFFSET);  // RETURN
     }
 
+    *position = d_lazyMessagePayloadPosition;
     return rc_SUCCESS;
 }
 
@@ -378,7 +392,8 @@ int PushMessageIterator::loadMessagePayload(bdlbb::Blob* blob) const
         // because it failed.  If its later, calling it will fail again, and an
         // appropriate error will be returned.
 
-        int rc = loadMessagePayloadPosition();
+        mwcu::BlobPosition payloadPos;
+        int                rc = loadMessagePayloadPosition(&payloadPos);
         if (0 != rc) {
             return rc * 10 + rc_INVALID_PAYLOAD_OFFSET;  // RETURN
         }
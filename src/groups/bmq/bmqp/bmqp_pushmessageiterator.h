@@ -172,13 +172,6 @@ class PushMessageIterator {
     /// undefined unless latest call to `next()` returned 1.
     void initCachedOptionsView() const;
 
-    /// Load the `d_lazyMessagePayloadPosition` variable to payload for the
-    /// message currently pointed to by this iterator.  Return zero on
-    /// success, and a non-zero value otherwise.  Behavior is undefined
-    /// unless `d_decompressFlag` is true and the latest call to `next()`
-    /// returned 1.
-    int loadMessagePayloadPosition() const;
-
     /// Return the size (in bytes) of compressed application data for the
     /// message currently pointed to by this iterator.  Behavior is
     /// undefined unless latest call to `next()` returned 1.  Note that
@@ -354,6 +347,25 @@ class PushMessageIterator {
     /// `d_decompressFlag` is true.
     int loadMessagePayload(bdlbb::Blob* blob) const;
 
+    /// Load into the specified `position` the position of payload for the
+    /// message currently pointed to by this iterator, in the blob returned
+    /// by `applicationData()`.  Return zero on success, and a non-zero value
+    /// in case of failure or if application data is implicit.  Behavior is
+    /// undefined unless `d_decompressFlag` is true and the latest call to
+    /// `next()` returned 1.
+    int loadMessagePayloadPosition(mwcu::BlobPosition* position) const;
+
+    /// Return a reference not offering modifiable access to the blob
+    /// holding the (decompressed) application data of the message currently
+    /// pointed to by this iterator.  Behavior is undefined unless
+    /// `d_decompressFlag` is true and the latest call to `next()` returned
+    /// 1.  Note that unless the message was compressed, the buffers of the
+    /// returned blob are aliased from the blob being iterated over.  Also
+    /// note that the returned blob is empty if application data is
+    /// implicit, and is only valid until the next call to `next()`,
+    /// `reset()` or `clear()`.
+    const bdlbb::Blob& applicationData() const;
+
     /// Return the size (in bytes) of options for the message currently
     /// pointed to by this iterator.  Behavior is undefined unless latest
     /// call to `next()` returned 1.  Note that this length includes
@@ -558,6 +570,15 @@ inline int PushMessageIterator::loadOptionsView(OptionsView* view) const
     return view->reset(d_blobIter.blob(), d_optionsPosition, d_optionsSize);
 }
 
+inline const bdlbb::Blob& PushMessageIterator::applicationData() const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(isValid());
+    BSLS_ASSERT_SAFE(d_decompressFlag);
+
+    return d_applicationData;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
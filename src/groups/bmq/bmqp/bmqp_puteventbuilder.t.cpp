@@ -25,11 +25,13 @@
 #include <bmqp_protocolutil.h>
 #include <bmqp_putmessageiterator.h>
 #include <bmqp_puttester.h>
+#include <bmqt_compressionalgorithmtype.h>
 #include <bmqt_messageguid.h>
 
 // MWC
 #include <mwcu_blob.h>
 #include <mwcu_memoutstream.h>
+#include <mwcu_printutil.h>
 
 // BDE
 #include <bdlb_guid.h>
@@ -39,6 +41,7 @@
 #include <bdlbb_blobutil.h>
 #include <bdlbb_pooledblobbufferfactory.h>
 #include <bdlf_bind.h>
+#include <bdlt_timeunitratio.h>
 #include <bsl_algorithm.h>
 #include <bsl_cstring.h>  // for bsl::strlen
 #include <bsl_fstream.h>
@@ -50,10 +53,17 @@
 #include <bslmf_assert.h>
 #include <bslmf_nestedtraitdeclaration.h>
 #include <bsls_assert.h>
+#include <bsls_timeutil.h>
+#include <bsls_types.h>
 
 // TEST DRIVER
 #include <mwctst_testhelper.h>
 
+// BENCHMARKING LIBRARY
+#ifdef BSLS_PLATFORM_OS_LINUX
+#include <benchmark/benchmark.h>
+#endif
+
 // CONVENIENCE
 using namespace BloombergLP;
 using namespace bsl;
@@ -176,6 +186,143 @@ unsigned int findExpectedCrc32(
     return expectedCrc32;
 }
 
+/// Number of messages of the events built by the benchmarks.
+const int k_BENCH_NUM_MESSAGES = 32;
+
+/// Payload lengths, numbers of properties and compression algorithms of the
+/// messages of the benchmarks.
+const int k_BENCH_PAYLOAD_LENGTHS[] = {64, 1024, 16384, 65536};
+const int k_BENCH_NUM_PROPERTIES[]  = {0, 4, 16};
+const bmqt::CompressionAlgorithmType::Enum k_BENCH_COMPRESSIONS[] = {
+    bmqt::CompressionAlgorithmType::e_NONE,
+    bmqt::CompressionAlgorithmType::e_ZLIB};
+
+const int k_NUM_BENCH_PAYLOAD_LENGTHS = sizeof(k_BENCH_PAYLOAD_LENGTHS) /
+                                        sizeof(*k_BENCH_PAYLOAD_LENGTHS);
+const int k_NUM_BENCH_NUM_PROPERTIES  = sizeof(k_BENCH_NUM_PROPERTIES) /
+                                       sizeof(*k_BENCH_NUM_PROPERTIES);
+const int k_NUM_BENCH_COMPRESSIONS    = sizeof(k_BENCH_COMPRESSIONS) /
+                                     sizeof(*k_BENCH_COMPRESSIONS);
+
+/// Load into the specified `properties` the specified `numProperties`
+/// properties, alternating between the int32, int64 and string types.
+void populateBenchProperties(bmqp::MessageProperties* properties,
+                             int                      numProperties)
+{
+    properties->clear();
+    for (int i = 0; i < numProperties; ++i) {
+        mwcu::MemOutStream os(s_allocator_p);
+        os << "property" << i;
+        const bsl::string name(os.str().data(),
+                               os.str().length(),
+                               s_allocator_p);
+
+        switch (i % 3) {
+        case 0: properties->setPropertyAsInt32(name, i); break;
+        case 1: properties->setPropertyAsInt64(name, i * 1000000007LL); break;
+        default:
+            properties->setPropertyAsString(
+                name,
+                bsl::string(32, 'p', s_allocator_p));
+            break;
+        }
+    }
+}
+
+/// Build with the specified `builder` an event of `k_BENCH_NUM_MESSAGES`
+/// messages having the specified `payload` of the specified
+/// `payloadLength`, the specified `guid`, the specified `properties`, if
+/// any, and compressed with the specified `compressionAlgorithmType`.
+void buildBenchEvent(
+    bmqp::PutEventBuilder*               builder,
+    const char*                          payload,
+    int                                  payloadLength,
+    const bmqt::MessageGUID&             guid,
+    const bmqp::MessageProperties&       properties,
+    bmqt::CompressionAlgorithmType::Enum compressionAlgorithmType)
+{
+    builder->reset();
+    for (int i = 0; i < k_BENCH_NUM_MESSAGES; ++i) {
+        builder->startMessage();
+        builder->setMessagePayload(payload, payloadLength)
+            .setMessageGUID(guid)
+            .setCompressionAlgorithmType(compressionAlgorithmType);
+        if (properties.numProperties() > 0) {
+            builder->setMessageProperties(&properties);
+        }
+
+        const bmqt::EventBuilderResult::Enum rc = builder->packMessage(i);
+        BSLS_ASSERT_OPT(rc == bmqt::EventBuilderResult::e_SUCCESS);
+        (void)rc;
+    }
+}
+
+/// Iterate over the messages of the PUT event in the specified `blob`,
+/// decompressing them and loading their payload and properties, using the
+/// specified `bufferFactory`.  Return the number of messages.
+int iterateBenchEvent(const bdlbb::Blob&        blob,
+                      bdlbb::BlobBufferFactory* bufferFactory)
+{
+    bmqp::Event              event(&blob, s_allocator_p);
+    bmqp::PutMessageIterator iterator(bufferFactory, s_allocator_p);
+    bdlbb::Blob              payload(s_allocator_p);
+    bmqp::MessageProperties  properties(s_allocator_p);
+
+    event.loadPutMessageIterator(&iterator, true);
+
+    int numMessages = 0;
+    while (iterator.next() == 1) {
+        payload.removeAll();
+        iterator.loadMessagePayload(&payload);
+        if (iterator.hasMessageProperties()) {
+            iterator.loadMessageProperties(&properties);
+        }
+        ++numMessages;
+    }
+
+    return numMessages;
+}
+
+/// Print the specified `totalTimeNs` taken by the specified `numIterations`
+/// on events of messages having the specified `payloadLength`,
+/// `numProperties` and `compression`.
+void printBenchResult(int                                  payloadLength,
+                      int                                  numProperties,
+                      bmqt::CompressionAlgorithmType::Enum compression,
+                      int                                  numIterations,
+                      bsls::Types::Int64                   totalTimeNs)
+{
+    const bsls::Types::Int64 numBytes = static_cast<bsls::Types::Int64>(
+                                            numIterations) *
+                                        k_BENCH_NUM_MESSAGES * payloadLength;
+
+    cout << "payload: " << mwcu::PrintUtil::prettyBytes(payloadLength)
+         << ", properties: " << numProperties
+         << ", compression: " << compression << " => "
+         << mwcu::PrintUtil::prettyTimeInterval(totalTimeNs / numIterations)
+         << " per event, "
+         << mwcu::PrintUtil::prettyBytes(
+                numBytes * bdlt::TimeUnitRatio::k_NS_PER_S / totalTimeNs)
+         << " of payload per second\n";
+}
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+/// Apply to the specified `b` benchmark the payload lengths, numbers of
+/// properties and compression algorithms of the benchmarks.
+void applyBenchArguments_GoogleBenchmark(benchmark::internal::Benchmark* b)
+{
+    for (int l = 0; l < k_NUM_BENCH_PAYLOAD_LENGTHS; ++l) {
+        for (int p = 0; p < k_NUM_BENCH_NUM_PROPERTIES; ++p) {
+            for (int c = 0; c < k_NUM_BENCH_COMPRESSIONS; ++c) {
+                b->Args({k_BENCH_PAYLOAD_LENGTHS[l],
+                         k_BENCH_NUM_PROPERTIES[p],
+                         k_BENCH_COMPRESSIONS[c]});
+            }
+        }
+    }
+}
+#endif  // BSLS_PLATFORM_OS_LINUX
+
 }  // close unnamed namespace
 
 // ============================================================================
@@ -2411,6 +2558,221 @@ static void testN1_decodeFromFile()
     ASSERT_EQ(false, putIter.isValid());
 }
 
+BSLA_MAYBE_UNUSED
+static void testN2_buildEvent()
+// ------------------------------------------------------------------------
+// BENCHMARK: BUILD PUT EVENT
+//
+// Concerns:
+//   Test the throughput of building PUT events with
+//   'bmqp::PutEventBuilder', depending on the size of the payload, the
+//   number of properties and the compression of the messages.
+//
+// Plan:
+//   - For each combination of payload length, number of properties and
+//     compression algorithm, time the build of a large number of events
+//     and report the average time per event and the payload throughput.
+//
+// Testing:
+//   Throughput of bmqp::PutEventBuilder::packMessage()
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("BENCHMARK: BUILD PUT EVENT");
+
+    const int k_NUM_ITERS = 1000;
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::PutEventBuilder          builder(&bufferFactory, s_allocator_p);
+    bmqp::MessageProperties        properties(s_allocator_p);
+    const bmqt::MessageGUID guid = bmqp::MessageGUIDGenerator::testGUID();
+
+    for (int l = 0; l < k_NUM_BENCH_PAYLOAD_LENGTHS; ++l) {
+        const int         length = k_BENCH_PAYLOAD_LENGTHS[l];
+        const bsl::string payload(length, 'x', s_allocator_p);
+
+        for (int p = 0; p < k_NUM_BENCH_NUM_PROPERTIES; ++p) {
+            populateBenchProperties(&properties, k_BENCH_NUM_PROPERTIES[p]);
+
+            for (int c = 0; c < k_NUM_BENCH_COMPRESSIONS; ++c) {
+                // <time>
+                const bsls::Types::Int64 begin = bsls::TimeUtil::getTimer();
+                for (int i = 0; i < k_NUM_ITERS; ++i) {
+                    buildBenchEvent(&builder,
+                                    payload.data(),
+                                    length,
+                                    guid,
+                                    properties,
+                                    k_BENCH_COMPRESSIONS[c]);
+                }
+                const bsls::Types::Int64 end = bsls::TimeUtil::getTimer();
+                // </time>
+
+                printBenchResult(length,
+                                 k_BENCH_NUM_PROPERTIES[p],
+                                 k_BENCH_COMPRESSIONS[c],
+                                 k_NUM_ITERS,
+                                 end - begin);
+            }
+        }
+    }
+}
+
+BSLA_MAYBE_UNUSED
+static void testN2_iterateEvent()
+// ------------------------------------------------------------------------
+// BENCHMARK: ITERATE PUT EVENT
+//
+// Concerns:
+//   Test the throughput of iterating over PUT events with
+//   'bmqp::PutMessageIterator', decompressing the messages and loading
+//   their payload and properties, depending on the size of the payload,
+//   the number of properties and the compression of the messages.
+//
+// Plan:
+//   - For each combination of payload length, number of properties and
+//     compression algorithm, build an event and time a large number of
+//     iterations over it, and report the average time per event and the
+//     payload throughput.
+//
+// Testing:
+//   Throughput of bmqp::PutMessageIterator
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("BENCHMARK: ITERATE PUT EVENT");
+
+    const int k_NUM_ITERS = 1000;
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::PutEventBuilder          builder(&bufferFactory, s_allocator_p);
+    bmqp::MessageProperties        properties(s_allocator_p);
+    const bmqt::MessageGUID guid = bmqp::MessageGUIDGenerator::testGUID();
+
+    for (int l = 0; l < k_NUM_BENCH_PAYLOAD_LENGTHS; ++l) {
+        const int         length = k_BENCH_PAYLOAD_LENGTHS[l];
+        const bsl::string payload(length, 'x', s_allocator_p);
+
+        for (int p = 0; p < k_NUM_BENCH_NUM_PROPERTIES; ++p) {
+            populateBenchProperties(&properties, k_BENCH_NUM_PROPERTIES[p]);
+
+            for (int c = 0; c < k_NUM_BENCH_COMPRESSIONS; ++c) {
+                buildBenchEvent(&builder,
+                                payload.data(),
+                                length,
+                                guid,
+                                properties,
+                                k_BENCH_COMPRESSIONS[c]);
+
+                // <time>
+                const bsls::Types::Int64 begin = bsls::TimeUtil::getTimer();
+                for (int i = 0; i < k_NUM_ITERS; ++i) {
+                    iterateBenchEvent(builder.blob(), &bufferFactory);
+                }
+                const bsls::Types::Int64 end = bsls::TimeUtil::getTimer();
+                // </time>
+
+                printBenchResult(length,
+                                 k_BENCH_NUM_PROPERTIES[p],
+                                 k_BENCH_COMPRESSIONS[c],
+                                 k_NUM_ITERS,
+                                 end - begin);
+            }
+        }
+    }
+}
+
+// Begin Benchmarking Tests
+#ifdef BSLS_PLATFORM_OS_LINUX
+static void testN2_buildEvent_GoogleBenchmark(benchmark::State& state)
+// ------------------------------------------------------------------------
+// BENCHMARK: BUILD PUT EVENT
+//
+// Concerns:
+//   Test the throughput of building PUT events with
+//   'bmqp::PutEventBuilder', depending on the size of the payload, the
+//   number of properties and the compression of the messages, provided
+//   as the arguments of 'state'.
+//
+// Testing:
+//   Throughput of bmqp::PutEventBuilder::packMessage()
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("GOOGLE BENCHMARK: BUILD PUT EVENT");
+
+    const int length = static_cast<int>(state.range(0));
+    const bmqt::CompressionAlgorithmType::Enum compression =
+        static_cast<bmqt::CompressionAlgorithmType::Enum>(state.range(2));
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::PutEventBuilder          builder(&bufferFactory, s_allocator_p);
+    bmqp::MessageProperties        properties(s_allocator_p);
+    const bmqt::MessageGUID guid = bmqp::MessageGUIDGenerator::testGUID();
+    const bsl::string       payload(length, 'x', s_allocator_p);
+
+    populateBenchProperties(&properties, static_cast<int>(state.range(1)));
+
+    // <time>
+    for (auto _ : state) {
+        buildBenchEvent(&builder,
+                        payload.data(),
+                        length,
+                        guid,
+                        properties,
+                        compression);
+    }
+    // </time>
+
+    state.SetItemsProcessed(state.iterations() * k_BENCH_NUM_MESSAGES);
+    state.SetBytesProcessed(state.iterations() * k_BENCH_NUM_MESSAGES *
+                            length);
+}
+
+static void testN2_iterateEvent_GoogleBenchmark(benchmark::State& state)
+// ------------------------------------------------------------------------
+// BENCHMARK: ITERATE PUT EVENT
+//
+// Concerns:
+//   Test the throughput of iterating over PUT events with
+//   'bmqp::PutMessageIterator', depending on the size of the payload, the
+//   number of properties and the compression of the messages, provided
+//   as the arguments of 'state'.
+//
+// Testing:
+//   Throughput of bmqp::PutMessageIterator
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("GOOGLE BENCHMARK: ITERATE PUT EVENT");
+
+    const int length = static_cast<int>(state.range(0));
+    const bmqt::CompressionAlgorithmType::Enum compression =
+        static_cast<bmqt::CompressionAlgorithmType::Enum>(state.range(2));
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::PutEventBuilder          builder(&bufferFactory, s_allocator_p);
+    bmqp::MessageProperties        properties(s_allocator_p);
+    const bmqt::MessageGUID guid = bmqp::MessageGUIDGenerator::testGUID();
+    const bsl::string       payload(length, 'x', s_allocator_p);
+
+    populateBenchProperties(&properties, static_cast<int>(state.range(1)));
+    buildBenchEvent(&builder,
+                    payload.data(),
+                    length,
+                    guid,
+                    properties,
+                    compression);
+
+    // <time>
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            iterateBenchEvent(builder.blob(), &bufferFactory));
+    }
+    // </time>
+
+    state.SetItemsProcessed(state.iterations() * k_BENCH_NUM_MESSAGES);
+    state.SetBytesProcessed(state.iterations() * k_BENCH_NUM_MESSAGES *
+                            length);
+}
+#endif  // BSLS_PLATFORM_OS_LINUX
+
 // ============================================================================
 //                                 MAIN PROGRAM
 // ----------------------------------------------------------------------------
@@ -2450,12 +2812,25 @@ int main(int argc, char* argv[])
     case 2: test2_manipulators_one(); break;
     case 1: test1_breathingTest(); break;
     case -1: testN1_decodeFromFile(); break;
+    case -2:
+        MWC_BENCHMARK_WITH_ARGS(testN2_buildEvent,
+                                Apply(applyBenchArguments_GoogleBenchmark));
+        MWC_BENCHMARK_WITH_ARGS(testN2_iterateEvent,
+                                Apply(applyBenchArguments_GoogleBenchmark));
+        break;
     default: {
         cerr << "WARNING: CASE '" << _testCase << "' NOT FOUND." << endl;
         s_testStatus = -1;
     } break;
     }
 
+#ifdef BSLS_PLATFORM_OS_LINUX
+    if (_testCase < 0) {
+        benchmark::Initialize(&argc, argv);
+        benchmark::RunSpecifiedBenchmarks();
+    }
+#endif
+
     bmqp::ProtocolUtil::shutdown();
 
     TEST_EPILOG(mwctst::TestHelper::e_CHECK_DEF_GBL_ALLOC);
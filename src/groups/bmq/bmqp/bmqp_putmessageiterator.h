@@ -201,13 +201,6 @@ class PutMessageIterator {
     /// undefined unless latest call to `next()` returned 1.
     void initCachedOptionsView() const;
 
-    /// Load into the specified `position` the position of payload for the
-    /// message currently pointed to by this iterator.  Return zero on
-    /// success, and a non-zero value otherwise.  Behavior is undefined
-    /// unless `d_decompressFlag` is true and the latest call to `next()`
-    /// returned 1.
-    int loadMessagePayloadPosition(mwcu::BlobPosition* position) const;
-
     /// Return the size (in bytes) of compressed application data for the
     /// message currently pointed to by this iterator.  Behavior is
     /// undefined unless latest call to `next()` returned 1.  Note that
@@ -398,6 +391,23 @@ class PutMessageIterator {
     /// `next()` returned 1.
     int loadMessagePayload(bdlbb::Blob* blob) const;
 
+    /// Load into the specified `position` the position of payload for the
+    /// message currently pointed to by this iterator, in the blob returned
+    /// by `applicationData()`.  Return zero on success, and a non-zero value
+    /// otherwise.  Behavior is undefined unless `d_decompressFlag` is true
+    /// and the latest call to `next()` returned 1.
+    int loadMessagePayloadPosition(mwcu::BlobPosition* position) const;
+
+    /// Return a reference not offering modifiable access to the blob
+    /// holding the (decompressed) application data of the message currently
+    /// pointed to by this iterator.  Behavior is undefined unless
+    /// `d_decompressFlag` is true and the latest call to `next()` returned
+    /// 1.  Note that unless the message was compressed, the buffers of the
+    /// returned blob are aliased from the blob being iterated over.  Also
+    /// note that the returned blob is only valid until the next call to
+    /// `next()`, `reset()` or `clear()`.
+    const bdlbb::Blob& applicationData() const;
+
     /// Load into the specified `msgGroupId` the Group Id associated with
     /// the message currently pointed to by this iterator.  Return `true` if
     /// the load was successfully or `false` otherwise.  Behavior is
@@ -564,6 +574,15 @@ inline int PutMessageIterator::optionsSize() const
     return d_optionsSize;
 }
 
+inline const bdlbb::Blob& PutMessageIterator::applicationData() const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(isValid());
+    BSLS_ASSERT_SAFE(d_decompressFlag);
+
+    return d_applicationData;
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
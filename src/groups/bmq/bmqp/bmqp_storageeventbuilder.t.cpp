@@ -18,21 +18,37 @@
 
 // BMQ
 #include <bmqp_event.h>
+#include <bmqp_protocol.h>
+#include <bmqp_storagemessageiterator.h>
+
+// MWC
+#include <mwcu_blob.h>
+#include <mwcu_printutil.h>
 
 // BDE
 #include <bdlbb_blob.h>
 #include <bdlbb_blobutil.h>
 #include <bdlbb_pooledblobbufferfactory.h>
+#include <bdlt_timeunitratio.h>
 #include <bsl_cstring.h>  // for bsl::strlen
 #include <bsl_iostream.h>
 #include <bsl_limits.h>
 #include <bsl_memory.h>
+#include <bsl_string.h>
 #include <bslma_usesbslmaallocator.h>
 #include <bslmf_nestedtraitdeclaration.h>
+#include <bsls_assert.h>
+#include <bsls_timeutil.h>
+#include <bsls_types.h>
 
 // TEST DRIVER
 #include <mwctst_testhelper.h>
 
+// BENCHMARKING LIBRARY
+#ifdef BSLS_PLATFORM_OS_LINUX
+#include <benchmark/benchmark.h>
+#endif
+
 // CONVENIENCE
 using namespace BloombergLP;
 using namespace bsl;
@@ -162,6 +178,84 @@ bmqt::EventBuilderResult::Enum appendMessage(unsigned int               index,
                             journalRecordBlobBuffer);
 }
 
+/// Number of messages of the events built by the benchmarks.
+const int k_BENCH_NUM_MESSAGES = 32;
+
+/// Payload lengths of the messages of the benchmarks.  Must be 4byte
+/// aligned.
+const int k_BENCH_PAYLOAD_LENGTHS[] = {64, 1024, 16384, 65536};
+
+const int k_NUM_BENCH_PAYLOAD_LENGTHS = sizeof(k_BENCH_PAYLOAD_LENGTHS) /
+                                        sizeof(*k_BENCH_PAYLOAD_LENGTHS);
+
+/// Return a blob buffer referring to the specified `length` bytes at the
+/// specified `data`, without owning them.
+bdlbb::BlobBuffer makeBenchBlobBuffer(const char* data, int length)
+{
+    bsl::shared_ptr<char> bufferSp(const_cast<char*>(data),
+                                   bslstl::SharedPtrNilDeleter(),
+                                   s_allocator_p);
+    return bdlbb::BlobBuffer(bufferSp, length);
+}
+
+/// Build with the specified `builder` an event of `k_BENCH_NUM_MESSAGES`
+/// DATA messages having the specified `journalRecord` and `payload`.
+void buildBenchEvent(bmqp::StorageEventBuilder* builder,
+                     const bdlbb::BlobBuffer&   journalRecord,
+                     const bdlbb::BlobBuffer&   payload)
+{
+    builder->reset();
+    for (int i = 0; i < k_BENCH_NUM_MESSAGES; ++i) {
+        const bmqt::EventBuilderResult::Enum rc = builder->packMessage(
+            bmqp::StorageMessageType::e_DATA,
+            1,                                  // partitionId
+            0,                                  // flags
+            i * (k_RECORD_SIZE / bmqp::Protocol::k_WORD_SIZE),
+            journalRecord,
+            payload);
+        BSLS_ASSERT_OPT(rc == bmqt::EventBuilderResult::e_SUCCESS);
+        (void)rc;
+    }
+}
+
+/// Iterate over the messages of the STORAGE event in the specified `blob`,
+/// loading the position of their data.  Return the number of messages.
+int iterateBenchEvent(const bdlbb::Blob& blob)
+{
+    bmqp::Event                  event(&blob, s_allocator_p);
+    bmqp::StorageMessageIterator iterator;
+    mwcu::BlobPosition           position;
+
+    event.loadStorageMessageIterator(&iterator);
+
+    int numMessages = 0;
+    while (iterator.next() == 1) {
+        iterator.loadDataPosition(&position);
+        ++numMessages;
+    }
+
+    return numMessages;
+}
+
+/// Print the specified `totalTimeNs` taken by the specified `numIterations`
+/// on events of messages having the specified `payloadLength`.
+void printBenchResult(int                payloadLength,
+                      int                numIterations,
+                      bsls::Types::Int64 totalTimeNs)
+{
+    const bsls::Types::Int64 numBytes = static_cast<bsls::Types::Int64>(
+                                            numIterations) *
+                                        k_BENCH_NUM_MESSAGES * payloadLength;
+
+    cout << "payload: " << mwcu::PrintUtil::prettyBytes(payloadLength)
+         << " => "
+         << mwcu::PrintUtil::prettyTimeInterval(totalTimeNs / numIterations)
+         << " per event, "
+         << mwcu::PrintUtil::prettyBytes(
+                numBytes * bdlt::TimeUnitRatio::k_NS_PER_S / totalTimeNs)
+         << " of payload per second\n";
+}
+
 }  // close unnamed namespace
 
 // ============================================================================
@@ -694,6 +788,196 @@ static void test6_packMessageRaw_invalidPosition()
     ASSERT_EQ(seb.eventSize(), static_cast<int>(sizeof(bmqp::EventHeader)));
 }
 
+BSLA_MAYBE_UNUSED
+static void testN1_buildEvent()
+// ------------------------------------------------------------------------
+// BENCHMARK: BUILD STORAGE EVENT
+//
+// Concerns:
+//   Test the throughput of building STORAGE events with
+//   'bmqp::StorageEventBuilder', depending on the size of the payload of
+//   the messages.
+//
+// Plan:
+//   - For each payload length, time the build of a large number of events
+//     and report the average time per event and the payload throughput.
+//
+// Testing:
+//   Throughput of bmqp::StorageEventBuilder::packMessage()
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("BENCHMARK: BUILD STORAGE EVENT");
+
+    const int k_NUM_ITERS = 1000;
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::StorageEventBuilder      builder(1,  // storage protocol version
+                                           bmqp::EventType::e_STORAGE,
+                                           &bufferFactory,
+                                           s_allocator_p);
+    const bsl::string record(k_RECORD_SIZE, 'r', s_allocator_p);
+    const bdlbb::BlobBuffer journalRecord = makeBenchBlobBuffer(
+        record.data(),
+        k_RECORD_SIZE);
+
+    for (int l = 0; l < k_NUM_BENCH_PAYLOAD_LENGTHS; ++l) {
+        const int               length = k_BENCH_PAYLOAD_LENGTHS[l];
+        const bsl::string       data(length, 'x', s_allocator_p);
+        const bdlbb::BlobBuffer payload = makeBenchBlobBuffer(data.data(),
+                                                              length);
+
+        // <time>
+        const bsls::Types::Int64 begin = bsls::TimeUtil::getTimer();
+        for (int i = 0; i < k_NUM_ITERS; ++i) {
+            buildBenchEvent(&builder, journalRecord, payload);
+        }
+        const bsls::Types::Int64 end = bsls::TimeUtil::getTimer();
+        // </time>
+
+        printBenchResult(length, k_NUM_ITERS, end - begin);
+    }
+}
+
+BSLA_MAYBE_UNUSED
+static void testN1_iterateEvent()
+// ------------------------------------------------------------------------
+// BENCHMARK: ITERATE STORAGE EVENT
+//
+// Concerns:
+//   Test the throughput of iterating over STORAGE events with
+//   'bmqp::StorageMessageIterator' and loading the position of the data
+//   of their messages, depending on the size of the payload.
+//
+// Plan:
+//   - For each payload length, build an event and time a large number of
+//     iterations over it, and report the average time per event and the
+//     payload throughput.
+//
+// Testing:
+//   Throughput of bmqp::StorageMessageIterator
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("BENCHMARK: ITERATE STORAGE EVENT");
+
+    const int k_NUM_ITERS = 1000;
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::StorageEventBuilder      builder(1,  // storage protocol version
+                                           bmqp::EventType::e_STORAGE,
+                                           &bufferFactory,
+                                           s_allocator_p);
+    const bsl::string record(k_RECORD_SIZE, 'r', s_allocator_p);
+    const bdlbb::BlobBuffer journalRecord = makeBenchBlobBuffer(
+        record.data(),
+        k_RECORD_SIZE);
+
+    for (int l = 0; l < k_NUM_BENCH_PAYLOAD_LENGTHS; ++l) {
+        const int               length = k_BENCH_PAYLOAD_LENGTHS[l];
+        const bsl::string       data(length, 'x', s_allocator_p);
+        const bdlbb::BlobBuffer payload = makeBenchBlobBuffer(data.data(),
+                                                              length);
+
+        buildBenchEvent(&builder, journalRecord, payload);
+
+        // <time>
+        const bsls::Types::Int64 begin = bsls::TimeUtil::getTimer();
+        for (int i = 0; i < k_NUM_ITERS; ++i) {
+            iterateBenchEvent(builder.blob());
+        }
+        const bsls::Types::Int64 end = bsls::TimeUtil::getTimer();
+        // </time>
+
+        printBenchResult(length, k_NUM_ITERS, end - begin);
+    }
+}
+
+// Begin Benchmarking Tests
+#ifdef BSLS_PLATFORM_OS_LINUX
+static void testN1_buildEvent_GoogleBenchmark(benchmark::State& state)
+// ------------------------------------------------------------------------
+// BENCHMARK: BUILD STORAGE EVENT
+//
+// Concerns:
+//   Test the throughput of building STORAGE events with
+//   'bmqp::StorageEventBuilder', depending on the size of the payload of
+//   the messages, provided as the argument of 'state'.
+//
+// Testing:
+//   Throughput of bmqp::StorageEventBuilder::packMessage()
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName(
+        "GOOGLE BENCHMARK: BUILD STORAGE EVENT");
+
+    const int length = static_cast<int>(state.range(0));
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::StorageEventBuilder      builder(1,  // storage protocol version
+                                           bmqp::EventType::e_STORAGE,
+                                           &bufferFactory,
+                                           s_allocator_p);
+    const bsl::string       record(k_RECORD_SIZE, 'r', s_allocator_p);
+    const bsl::string       data(length, 'x', s_allocator_p);
+    const bdlbb::BlobBuffer journalRecord = makeBenchBlobBuffer(
+        record.data(),
+        k_RECORD_SIZE);
+    const bdlbb::BlobBuffer payload = makeBenchBlobBuffer(data.data(), length);
+
+    // <time>
+    for (auto _ : state) {
+        buildBenchEvent(&builder, journalRecord, payload);
+    }
+    // </time>
+
+    state.SetItemsProcessed(state.iterations() * k_BENCH_NUM_MESSAGES);
+    state.SetBytesProcessed(state.iterations() * k_BENCH_NUM_MESSAGES *
+                            length);
+}
+
+static void testN1_iterateEvent_GoogleBenchmark(benchmark::State& state)
+// ------------------------------------------------------------------------
+// BENCHMARK: ITERATE STORAGE EVENT
+//
+// Concerns:
+//   Test the throughput of iterating over STORAGE events with
+//   'bmqp::StorageMessageIterator', depending on the size of the payload
+//   of the messages, provided as the argument of 'state'.
+//
+// Testing:
+//   Throughput of bmqp::StorageMessageIterator
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName(
+        "GOOGLE BENCHMARK: ITERATE STORAGE EVENT");
+
+    const int length = static_cast<int>(state.range(0));
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(4096, s_allocator_p);
+    bmqp::StorageEventBuilder      builder(1,  // storage protocol version
+                                           bmqp::EventType::e_STORAGE,
+                                           &bufferFactory,
+                                           s_allocator_p);
+    const bsl::string       record(k_RECORD_SIZE, 'r', s_allocator_p);
+    const bsl::string       data(length, 'x', s_allocator_p);
+    const bdlbb::BlobBuffer journalRecord = makeBenchBlobBuffer(
+        record.data(),
+        k_RECORD_SIZE);
+    const bdlbb::BlobBuffer payload = makeBenchBlobBuffer(data.data(), length);
+
+    buildBenchEvent(&builder, journalRecord, payload);
+
+    // <time>
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(iterateBenchEvent(builder.blob()));
+    }
+    // </time>
+
+    state.SetItemsProcessed(state.iterations() * k_BENCH_NUM_MESSAGES);
+    state.SetBytesProcessed(state.iterations() * k_BENCH_NUM_MESSAGES *
+                            length);
+}
+#endif  // BSLS_PLATFORM_OS_LINUX
+
 // ============================================================================
 //                                 MAIN PROGRAM
 // ----------------------------------------------------------------------------
@@ -719,11 +1003,24 @@ int main(int argc, char* argv[])
     case 3: test3_packMessage_payloadTooBig(); break;
     case 2: test2_storageEventHavingMultipleMessages(); break;
     case 1: test1_breathingTest(); break;
+    case -1:
+        MWC_BENCHMARK_WITH_ARGS(testN1_buildEvent,
+                                RangeMultiplier(4)->Range(64, 65536));
+        MWC_BENCHMARK_WITH_ARGS(testN1_iterateEvent,
+                                RangeMultiplier(4)->Range(64, 65536));
+        break;
     default: {
         cerr << "WARNING: CASE '" << _testCase << "' NOT FOUND." << endl;
         s_testStatus = -1;
     } break;
     }
 
+#ifdef BSLS_PLATFORM_OS_LINUX
+    if (_testCase < 0) {
+        benchmark::Initialize(&argc, argv);
+        benchmark::RunSpecifiedBenchmarks();
+    }
+#endif
+
     TEST_EPILOG(mwctst::TestHelper::e_CHECK_DEF_GBL_ALLOC);
 }
@@ -37,6 +37,7 @@ SessionOptions::SessionOptions(bslma::Allocator* allocator)
 , d_blobBufferSize(4 * 1024)
 , d_channelHighWatermark(128 * 1024 * 1024)
 , d_statsDumpInterval(5 * 60.0)
+, d_messageTraceSamplingPeriod(0)
 , d_connectTimeout(60)
 , d_disconnectTimeout(30)
 , d_openQueueTimeout(k_QUEUE_OPERATION_DEFAULT_TIMEOUT)
@@ -60,6 +61,7 @@ SessionOptions::SessionOptions(const SessionOptions& other,
 , d_blobBufferSize(other.blobBufferSize())
 , d_channelHighWatermark(other.channelHighWatermark())
 , d_statsDumpInterval(other.statsDumpInterval())
+, d_messageTraceSamplingPeriod(other.messageTraceSamplingPeriod())
 , d_connectTimeout(other.connectTimeout())
 , d_disconnectTimeout(other.disconnectTimeout())
 , d_openQueueTimeout(other.openQueueTimeout())
@@ -92,6 +94,8 @@ bsl::ostream& SessionOptions::print(bsl::ostream& stream,
     printer.printAttribute("channelHighWatermark", d_channelHighWatermark);
     printer.printAttribute("statsDumpInterval",
                            d_statsDumpInterval.totalSecondsAsDouble());
+    printer.printAttribute("messageTraceSamplingPeriod",
+                           d_messageTraceSamplingPeriod);
     printer.printAttribute("connectTimeout",
                            d_connectTimeout.totalSecondsAsDouble());
     printer.printAttribute("disconnectTimeout",
@@ -73,6 +73,14 @@
 //:      of session). Default is 5min. The value must be a multiple of 30s, in
 //:      the range [0s - 60min].
 //:
+//: o !messageTraceSamplingPeriod!:
+//:      If not 0, trace one in every 'messageTraceSamplingPeriod' messages
+//:      (rounded down to a power of 2) posted or received by the session, and
+//:      print the latencies between the hops of the traced messages along
+//:      with the stats.  The messages are sampled on their GUID, so that
+//:      brokers configured with the same period trace the same messages.
+//:      Default is 0 (disabled).
+//:
 //: o !connectTimeout!,
 //: o !disconnetTimeout!,
 //: o !openQueueTimeout!,
@@ -196,6 +204,11 @@ class SessionOptions {
     // Interval at which to dump stats to
     // log file (0 to disable dump)
 
+    int d_messageTraceSamplingPeriod;
+    // Period of the sampling of the
+    // traced messages (0 to disable
+    // tracing)
+
     bsls::TimeInterval d_connectTimeout;
 
     bsls::TimeInterval d_disconnectTimeout;
@@ -263,6 +276,11 @@ class SessionOptions {
     /// minutes.
     SessionOptions& setStatsDumpInterval(const bsls::TimeInterval& value);
 
+    /// Set the period of the sampling of the traced messages to the
+    /// specified `value`, 0 disabling tracing.  The behavior is undefined
+    /// unless `0 <= value`.
+    SessionOptions& setMessageTraceSamplingPeriod(int value);
+
     SessionOptions& setConnectTimeout(const bsls::TimeInterval& value);
     SessionOptions& setDisconnectTimeout(const bsls::TimeInterval& value);
     SessionOptions& setOpenQueueTimeout(const bsls::TimeInterval& value);
@@ -319,6 +337,9 @@ class SessionOptions {
     /// Get the stats dump interval.
     const bsls::TimeInterval& statsDumpInterval() const;
 
+    /// Get the period of the sampling of the traced messages.
+    int messageTraceSamplingPeriod() const;
+
     const bsls::TimeInterval& connectTimeout() const;
     const bsls::TimeInterval& disconnectTimeout() const;
     const bsls::TimeInterval& openQueueTimeout() const;
@@ -433,6 +454,15 @@ SessionOptions::setStatsDumpInterval(const bsls::TimeInterval& value)
     return *this;
 }
 
+inline SessionOptions& SessionOptions::setMessageTraceSamplingPeriod(int value)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_OPT(0 <= value);
+
+    d_messageTraceSamplingPeriod = value;
+    return *this;
+}
+
 inline SessionOptions&
 SessionOptions::setConnectTimeout(const bsls::TimeInterval& value)
 {
@@ -537,6 +567,11 @@ inline const bsls::TimeInterval& SessionOptions::statsDumpInterval() const
     return d_statsDumpInterval;
 }
 
+inline int SessionOptions::messageTraceSamplingPeriod() const
+{
+    return d_messageTraceSamplingPeriod;
+}
+
 inline const bsls::TimeInterval& SessionOptions::connectTimeout() const
 {
     return d_connectTimeout;
@@ -608,6 +643,8 @@ inline bool bmqt::operator==(const bmqt::SessionOptions& lhs,
            lhs.blobBufferSize() == rhs.blobBufferSize() &&
            lhs.channelHighWatermark() == rhs.channelHighWatermark() &&
            lhs.statsDumpInterval() == rhs.statsDumpInterval() &&
+           lhs.messageTraceSamplingPeriod() ==
+               rhs.messageTraceSamplingPeriod() &&
            lhs.connectTimeout() == rhs.connectTimeout() &&
            lhs.openQueueTimeout() == rhs.openQueueTimeout() &&
            lhs.configureQueueTimeout() == rhs.configureQueueTimeout() &&
@@ -627,6 +664,8 @@ inline bool bmqt::operator!=(const bmqt::SessionOptions& lhs,
            lhs.blobBufferSize() != rhs.blobBufferSize() ||
            lhs.channelHighWatermark() != rhs.channelHighWatermark() ||
            lhs.statsDumpInterval() != rhs.statsDumpInterval() ||
+           lhs.messageTraceSamplingPeriod() !=
+               rhs.messageTraceSamplingPeriod() ||
            lhs.connectTimeout() != rhs.connectTimeout() ||
            lhs.openQueueTimeout() != rhs.openQueueTimeout() ||
            lhs.configureQueueTimeout() != rhs.configureQueueTimeout() ||
@@ -57,7 +57,8 @@ static void test2_printTest()
         "[ brokerUri = \"tcp://localhost:30114\" processNameOverride = \"\" "
         "numProcessingThreads = 1 "
         "blobBufferSize = 4096 channelHighWatermark = 134217728 "
-        "statsDumpInterval = 300 connectTimeout = 60 disconnectTimeout = 30 "
+        "statsDumpInterval = 300 messageTraceSamplingPeriod = 0 "
+        "connectTimeout = 60 disconnectTimeout = 30 "
         "openQueueTimeout = 300 configureQueueTimeout = 300 "
         "closeQueueTimeout = 300 eventQueueLowWatermark = 50 "
         "eventQueueHighWatermark = 2000 hasHostHealthMonitor = false "
@@ -113,6 +114,12 @@ static void test3_setterGetterAndCopyTest()
     obj.setStatsDumpInterval(statsDumpInterval);
     ASSERT_EQ(obj.statsDumpInterval(), statsDumpInterval);
 
+    PVV("Checking setter and getter for messageTraceSamplingPeriod");
+    const int messageTraceSamplingPeriod = 1024;
+    ASSERT_NE(obj.messageTraceSamplingPeriod(), messageTraceSamplingPeriod);
+    obj.setMessageTraceSamplingPeriod(messageTraceSamplingPeriod);
+    ASSERT_EQ(obj.messageTraceSamplingPeriod(), messageTraceSamplingPeriod);
+
     PVV("Checking setter and getter for connectTimeout");
     const bsls::TimeInterval connectTimeout(70);
     ASSERT_NE(obj.connectTimeout(), connectTimeout);
@@ -157,6 +164,8 @@ static void test3_setterGetterAndCopyTest()
     ASSERT_EQ(objCopy.blobBufferSize(), blobBufferSize);
     ASSERT_EQ(objCopy.channelHighWatermark(), channelHighWatermark);
     ASSERT_EQ(objCopy.statsDumpInterval(), statsDumpInterval);
+    ASSERT_EQ(objCopy.messageTraceSamplingPeriod(),
+              messageTraceSamplingPeriod);
     ASSERT_EQ(objCopy.connectTimeout(), connectTimeout);
     ASSERT_EQ(objCopy.openQueueTimeout(), openQueueTimeout);
     ASSERT_EQ(objCopy.configureQueueTimeout(), configureQueueTimeout);
@@ -39,13 +39,16 @@
 
 // BMQ
 #include <bmqp_crc32c.h>
+#include <bmqp_messagetrace.h>
 #include <bmqt_uri.h>
 
 // MWC
 #include <mwcscm_version.h>
 #include <mwcst_statcontext.h>
+#include <mwcsys_threadutil.h>
 #include <mwcsys_time.h>
 #include <mwcu_memoutstream.h>
+#include <mwcu_printutil.h>
 
 // BDE
 #include <baljsn_encoder.h>
@@ -56,6 +59,8 @@
 #include <bdls_memoryutil.h>
 #include <bdls_osutil.h>
 #include <bdls_processutil.h>
+#include <bdlt_timeunitratio.h>
+#include <bsl_algorithm.h>
 #include <bsl_cstddef.h>
 #include <bsl_cstdlib.h>
 #include <bsl_ctime.h>
@@ -76,6 +81,64 @@ namespace {
 const int k_BLOBBUFFER_SIZE           = 4 * 1024;
 const int k_BLOB_POOL_GROWTH_STRATEGY = 1024;
 
+/// Maximum duration, in seconds, of a `STAT PROFILE` command.
+const int k_MAX_PROFILE_DURATION = 60;
+
+/// Maximum number of clients and of allocators listed by a `STAT PROFILE`
+/// command.
+const size_t k_PROFILE_TOP_COUNT = 20;
+
+/// Number of allocations and deallocations of an allocator while profiling.
+struct AllocationDelta {
+    // PUBLIC DATA
+    const bsl::string* d_path_p;
+
+    bsls::Types::Int64 d_numAllocations;
+
+    bsls::Types::Int64 d_numDeallocations;
+};
+
+/// Return true if the specified `lhs` processor orders before the specified
+/// `rhs` processor, by type then by id.
+bool processorLess(const Dispatcher::ProfileEntry& lhs,
+                   const Dispatcher::ProfileEntry& rhs)
+{
+    if (lhs.d_type != rhs.d_type) {
+        return lhs.d_type < rhs.d_type;  // RETURN
+    }
+
+    return lhs.d_processorId < rhs.d_processorId;
+}
+
+/// Return true if the specified `lhs` client consumed more CPU time than
+/// the specified `rhs` client.
+bool clientCpuTimeGreater(const Dispatcher::ProfileEntry& lhs,
+                          const Dispatcher::ProfileEntry& rhs)
+{
+    return lhs.d_cpuTime > rhs.d_cpuTime;
+}
+
+/// Return true if the specified `lhs` allocator performed more allocations
+/// than the specified `rhs` allocator.
+bool allocationsGreater(const AllocationDelta& lhs, const AllocationDelta& rhs)
+{
+    return lhs.d_numAllocations > rhs.d_numAllocations;
+}
+
+/// Print to the specified `stream` the CPU time and number of events of the
+/// specified `entry`, profiled over the specified `elapsedNs`.
+void printProfileEntry(bsl::ostream&                   stream,
+                       const Dispatcher::ProfileEntry& entry,
+                       bsls::Types::Int64              elapsedNs)
+{
+    stream << mwcu::PrintUtil::prettyTimeInterval(entry.d_cpuTime)
+           << " CPU ("
+           << mwcu::PrintUtil::prettyNumber(100.0 * entry.d_cpuTime /
+                                            elapsedNs)
+           << "%), " << mwcu::PrintUtil::prettyNumber(entry.d_numEvents)
+           << " events\n";
+}
+
 /// Create a new blob at the specified `arena` address, using the specified
 /// `bufferFactory` and `allocator`.
 void createBlob(bdlbb::BlobBufferFactory* bufferFactory,
@@ -85,8 +148,46 @@ void createBlob(bdlbb::BlobBufferFactory* bufferFactory,
     new (arena) bdlbb::Blob(bufferFactory, allocator);
 }
 
+/// Flatten and print the specified `cmdResult` to the specified `os`.
+void printResult(bsl::ostream& os, const mqbcmd::InternalResult& cmdResult)
+{
+    mqbcmd::Result result;
+    mqbcmd::Util::flatten(&result, cmdResult);
+
+    mqbcmd::HumanPrinter::print(os, result);
+}
+
 }  // close unnamed namespace
 
+// ----------------------------------
+// struct Application::ProfileContext
+// ----------------------------------
+
+/// State of a `STAT PROFILE` command in progress.
+struct Application::ProfileContext {
+    // PUBLIC DATA
+    mqbstat::StatController::AllocationCounts d_allocationsBefore;
+    // Allocation counts when profiling
+    // started.
+
+    bsls::Types::Int64 d_startNs;
+    // High resolution time when profiling
+    // started.
+
+    CommandProcessedCb d_onProcessedCb;
+    // Callback reporting the profile.
+
+    // CREATORS
+    ProfileContext(const CommandProcessedCb& onProcessedCb,
+                   bslma::Allocator*         allocator)
+    : d_allocationsBefore(allocator)
+    , d_startNs(0)
+    , d_onProcessedCb(onProcessedCb)
+    {
+        // NOTHING
+    }
+};
+
 // -----------
 // Application
 // -----------
@@ -117,6 +218,7 @@ void Application::oneTimeInit()
         bmqp::Crc32c::initialize();
         bmqt::UriParser::initialize();
         bmqp::ProtocolUtil::initialize();
+        bmqp::MessageTraceUtil::initialize();
     }
 }
 
@@ -124,12 +226,192 @@ void Application::oneTimeShutdown()
 {
     BSLMT_ONCE_DO
     {
+        bmqp::MessageTraceUtil::shutdown();
         bmqp::ProtocolUtil::shutdown();
         bmqt::UriParser::shutdown();
         mwcsys::Time::shutdown();
     }
 }
 
+void Application::startProfile(int                       durationSeconds,
+                               const CommandProcessedCb& onProcessedCb)
+{
+    // executed by the *ADMIN EXECUTION* thread
+
+    mqbcmd::InternalResult cmdResult;
+    if (durationSeconds <= 0 || durationSeconds > k_MAX_PROFILE_DURATION) {
+        mwcu::MemOutStream os;
+        os << "Invalid profiling duration " << durationSeconds
+           << ", must be between 1 and " << k_MAX_PROFILE_DURATION
+           << " seconds";
+        cmdResult.makeError().message() = os.str();
+    }
+    else if (d_profileContext_sp) {
+        cmdResult.makeError().message() = "Profiling already in progress";
+    }
+
+    if (cmdResult.isErrorValue()) {
+        mwcu::MemOutStream os;
+        printResult(os, cmdResult);
+        onProcessedCb(0, os.str());
+        return;  // RETURN
+    }
+
+    BALL_LOG_INFO << "Profiling the broker for " << durationSeconds
+                  << " seconds";
+
+    // Collect the profile from the admin execution thread once the duration
+    // has elapsed, so that other commands can be executed meanwhile.
+
+    d_profileContext_sp.createInplace(d_allocator_p,
+                                      onProcessedCb,
+                                      d_allocator_p);
+
+    d_statController_mp->loadAllocationCounts(
+        &d_profileContext_sp->d_allocationsBefore);
+    d_dispatcher_mp->startProfiling();
+    d_profileContext_sp->d_startNs = mwcsys::Time::highResolutionTimer();
+
+    d_scheduler_p->scheduleEvent(
+        &d_profileEventHandle,
+        d_scheduler_p->now() + bsls::TimeInterval(durationSeconds),
+        bdlf::BindUtil::bind(&Application::onProfileTimeout, this));
+}
+
+void Application::onProfileTimeout()
+{
+    // executed by the *SCHEDULER* thread
+
+    const int rc = d_adminExecutionPool.enqueueJob(
+        bdlf::BindUtil::bind(&Application::stopProfile, this));
+    if (0 != rc) {
+        BALL_LOG_ERROR << "Failed to enqueue the collection of the profile "
+                       << "to the admin execution pool, rc: " << rc;
+    }
+}
+
+void Application::stopProfile()
+{
+    // executed by the *ADMIN EXECUTION* thread
+
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(d_profileContext_sp);
+
+    typedef mqbstat::StatController::AllocationCounts AllocationCounts;
+
+    bsl::shared_ptr<ProfileContext> context;
+    context.swap(d_profileContext_sp);
+
+    const AllocationCounts& allocationsBefore = context->d_allocationsBefore;
+
+    AllocationCounts           allocationsAfter(d_allocator_p);
+    Dispatcher::ProfileEntries processors(d_allocator_p);
+    Dispatcher::ProfileEntries clients(d_allocator_p);
+
+    d_dispatcher_mp->stopProfiling(&processors, &clients);
+    const bsls::Types::Int64 elapsedNs = mwcsys::Time::highResolutionTimer() -
+                                         context->d_startNs;
+    d_statController_mp->loadAllocationCounts(&allocationsAfter);
+
+    mwcu::MemOutStream os;
+    os << "Profile of the broker over "
+       << mwcu::PrintUtil::prettyTimeInterval(elapsedNs) << "\n";
+    if (!mwcsys::ThreadUtil::k_SUPPORT_THREAD_CPU_TIME) {
+        os << "(CPU time is not measured on this platform)\n";
+    }
+
+    // Dispatcher threads
+    bsl::sort(processors.begin(), processors.end(), &processorLess);
+    os << "\nDispatcher threads:\n";
+    for (size_t i = 0; i < processors.size(); ++i) {
+        os << "  " << processors[i].d_type << " #"
+           << processors[i].d_processorId << ": ";
+        printProfileEntry(os, processors[i], elapsedNs);
+    }
+
+    // Clients
+    bsl::sort(clients.begin(), clients.end(), &clientCpuTimeGreater);
+    os << "\nTop clients by CPU time:\n";
+    for (size_t i = 0; i < clients.size() && i < k_PROFILE_TOP_COUNT; ++i) {
+        os << "  " << clients[i].d_description << " ("
+           << clients[i].d_type << " #" << clients[i].d_processorId
+           << "): ";
+        printProfileEntry(os, clients[i], elapsedNs);
+    }
+
+    // Allocators
+    bsl::vector<AllocationDelta> allocations(d_allocator_p);
+    allocations.reserve(allocationsAfter.size());
+    for (AllocationCounts::const_iterator it = allocationsAfter.begin();
+         it != allocationsAfter.end();
+         ++it) {
+        AllocationDelta delta = {&it->first,
+                                 it->second.first,
+                                 it->second.second};
+
+        AllocationCounts::const_iterator before = allocationsBefore.find(
+            it->first);
+        if (before != allocationsBefore.end()) {
+            delta.d_numAllocations -= before->second.first;
+            delta.d_numDeallocations -= before->second.second;
+        }
+
+        if (delta.d_numAllocations != 0 || delta.d_numDeallocations != 0) {
+            allocations.push_back(delta);
+        }
+    }
+
+    bsl::sort(allocations.begin(), allocations.end(), &allocationsGreater);
+    const double elapsedSeconds = static_cast<double>(elapsedNs) /
+                                  bdlt::TimeUnitRatio::k_NS_PER_S;
+    os << "\nTop allocators by allocation rate:\n";
+    for (size_t i = 0; i < allocations.size() && i < k_PROFILE_TOP_COUNT;
+         ++i) {
+        os << "  " << *allocations[i].d_path_p << ": "
+           << mwcu::PrintUtil::prettyNumber(allocations[i].d_numAllocations /
+                                            elapsedSeconds)
+           << " allocations/s, "
+           << mwcu::PrintUtil::prettyNumber(
+                  allocations[i].d_numDeallocations / elapsedSeconds)
+           << " deallocations/s\n";
+    }
+
+    mqbcmd::InternalResult cmdResult;
+    cmdResult.makeStatResult().makeStats(os.str());
+
+    mwcu::MemOutStream resultOs;
+    printResult(resultOs, cmdResult);
+    context->d_onProcessedCb(0, resultOs.str());
+}
+
+void Application::abortProfile(const bsl::string& reason)
+{
+    // executed by the *ADMIN EXECUTION* thread
+
+    if (!d_profileContext_sp) {
+        return;  // RETURN
+    }
+
+    bsl::shared_ptr<ProfileContext> context;
+    context.swap(d_profileContext_sp);
+
+    Dispatcher::ProfileEntries processors(d_allocator_p);
+    Dispatcher::ProfileEntries clients(d_allocator_p);
+    d_dispatcher_mp->stopProfiling(&processors, &clients);
+
+    BALL_LOG_INFO << "Aborted profiling the broker: " << reason;
+
+    mwcu::MemOutStream errorOs;
+    errorOs << "Profiling aborted: " << reason;
+
+    mqbcmd::InternalResult cmdResult;
+    cmdResult.makeError().message() = errorOs.str();
+
+    mwcu::MemOutStream os;
+    printResult(os, cmdResult);
+    context->d_onProcessedCb(0, os.str());
+}
+
 // CREATORS
 Application::Application(bdlmt::EventScheduler* scheduler,
                          mwcst::StatContext*    allocatorsStatContext,
@@ -141,6 +423,8 @@ Application::Application(bdlmt::EventScheduler* scheduler,
                        1,
                        bsls::TimeInterval(120).totalMilliseconds(),
                        allocator)
+, d_profileEventHandle()
+, d_profileContext_sp()
 , d_bufferFactory(k_BLOBBUFFER_SIZE, d_allocators.get("BufferFactory"))
 , d_blobSpPool(bdlf::BindUtil::bind(&createBlob,
                                     &d_bufferFactory,
@@ -454,6 +738,23 @@ void Application::stop()
     BALL_LOG_INFO << "Closing client and proxy sessions...";
     d_transportManager_mp->closeClients();
 
+    // The profile of a 'STAT PROFILE' command in progress, if any, can't be
+    // collected once the dispatcher is stopped.  If its collection is not
+    // already enqueued, in which case it is performed before the admin
+    // execution pool stops, abort the command, so that its caller gets a
+    // reply and the dispatcher stops profiling.
+    if (0 == d_scheduler_p->cancelEventAndWait(&d_profileEventHandle)) {
+        const int rc = d_adminExecutionPool.enqueueJob(
+            bdlf::BindUtil::bind(&Application::abortProfile,
+                                 this,
+                                 bsl::string("broker shutting down",
+                                             d_allocator_p)));
+        if (0 != rc) {
+            BALL_LOG_ERROR << "Failed to enqueue the abortion of the profile "
+                           << "to the admin execution pool, rc: " << rc;
+        }
+    }
+
     BALL_LOG_INFO << "Stopping admin thread pool...";
     d_adminExecutionPool.stop();
 
@@ -546,7 +847,15 @@ int Application::processCommand(const bslstl::StringRef& source,
     }
     else if (command.isStatValue()) {
         mqbcmd::StatResult statResult;
-        d_statController_mp->processCommand(&statResult, command.stat());
+        if (command.stat().isProfileValue()) {
+            // Profiling lasts several seconds, and replies asynchronously
+            // (see 'processCommandCb').
+            statResult.makeError().message() =
+                "STAT PROFILE is only supported by asynchronous commands";
+        }
+        else {
+            d_statController_mp->processCommand(&statResult, command.stat());
+        }
         if (statResult.isErrorValue()) {
             cmdResult.makeError(statResult.error());
         }
@@ -609,12 +918,8 @@ int Application::processCommand(const bslstl::StringRef& source,
         cmdResult.makeError().message() = errorOs.str();
     }
 
-    // Flatten into the final result
-    mqbcmd::Result result;
-    mqbcmd::Util::flatten(&result, cmdResult);
-
-    // Pretty print
-    mqbcmd::HumanPrinter::print(os, result);
+    // Flatten into the final result, and pretty print
+    printResult(os, cmdResult);
 
     return 0;
 }
@@ -624,6 +929,22 @@ int Application::processCommandCb(
     const bsl::string&                                  cmd,
     const bsl::function<void(int, const bsl::string&)>& onProcessedCb)
 {
+    // executed by the *ADMIN EXECUTION* thread
+
+    // Profiling spans the dispatcher, which the stat controller does not
+    // know about, and lasts several seconds: don't block the admin execution
+    // thread meanwhile.
+
+    mqbcmd::Command command;
+    bsl::string     parseError;
+    if (0 == mqbcmd::ParseUtil::parse(&command, &parseError, cmd) &&
+        command.isStatValue() && command.stat().isProfileValue()) {
+        BALL_LOG_INFO << "Received command '" << cmd << "' "
+                      << "[source: " << source << "]";
+        startProfile(command.stat().profile(), onProcessedCb);
+        return 0;  // RETURN
+    }
+
     mwcu::MemOutStream os;
     int                rc = processCommand(source, cmd, os);
 
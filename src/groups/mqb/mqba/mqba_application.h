@@ -39,7 +39,10 @@
 #include <bdlbb_pooledblobbufferfactory.h>
 #include <bdlcc_objectpool.h>
 #include <bdlcc_sharedobjectpool.h>
+#include <bdlmt_eventscheduler.h>
 #include <bdlmt_threadpool.h>
+#include <bsl_functional.h>
+#include <bsl_memory.h>
 #include <bsl_ostream.h>
 #include <bsl_string.h>
 #include <bsl_unordered_map.h>
@@ -53,9 +56,6 @@
 namespace BloombergLP {
 
 // FORWARD DECLARATION
-namespace bdlmt {
-class EventScheduler;
-}
 namespace mqbblp {
 class ClusterCatalog;
 }
@@ -108,6 +108,12 @@ class Application {
         bdlcc::ObjectPoolFunctors::RemoveAll<bdlbb::Blob> >
         BlobSpPool;
 
+    /// Callback reporting the return code and the output of a command.
+    typedef bsl::function<void(int, const bsl::string&)> CommandProcessedCb;
+
+    /// State of a `STAT PROFILE` command in progress.
+    struct ProfileContext;
+
     // Data members
     mwcma::CountingAllocatorStore d_allocators;
     // Allocator store to spawn new allocators
@@ -121,6 +127,16 @@ class Application {
     // Thread pool for admin commands
     // execution.
 
+    bdlmt::EventSchedulerEventHandle d_profileEventHandle;
+    // Event collecting the profile of the
+    // 'STAT PROFILE' command in progress, if
+    // any.
+
+    bsl::shared_ptr<ProfileContext> d_profileContext_sp;
+    // State of the 'STAT PROFILE' command in
+    // progress, if any.  Only accessed from
+    // the admin execution thread.
+
     bdlbb::PooledBlobBufferFactory d_bufferFactory;
 
     BlobSpPool d_blobSpPool;
@@ -158,6 +174,33 @@ class Application {
     /// Pendant operation of the `oneTimeInit` one.
     void oneTimeShutdown();
 
+    /// Start profiling the broker for the specified `durationSeconds`, and
+    /// return without waiting for the profile: the result of the command,
+    /// ie the CPU time consumed by each dispatcher thread and by its
+    /// busiest clients, and the allocation rate of the busiest allocators,
+    /// is reported to the specified `onProcessedCb` from the admin
+    /// execution thread once `durationSeconds` have elapsed, or right away
+    /// if profiling can't be started.  Executed by the admin execution
+    /// thread.
+    void startProfile(int durationSeconds,
+                      const CommandProcessedCb& onProcessedCb);
+
+    /// Enqueue the collection of the profile of the `STAT PROFILE` command
+    /// in progress to the admin execution pool.  Executed by the scheduler
+    /// thread.
+    void onProfileTimeout();
+
+    /// Stop profiling the broker, and report the profile to the callback of
+    /// the `STAT PROFILE` command in progress.  Executed by the admin
+    /// execution thread.
+    void stopProfile();
+
+    /// Stop profiling the broker, if a `STAT PROFILE` command is in
+    /// progress, and report to its callback an error having the specified
+    /// `reason` instead of the profile.  Executed by the admin execution
+    /// thread.
+    void abortProfile(const bsl::string& reason);
+
   private:
     // NOT IMPLEMENTED
     Application(const Application& other) BSLS_CPP11_DELETED;
@@ -196,13 +239,15 @@ class Application {
 
     /// Process the command in the specified `cmd` coming from the specified
     /// `source`, and write the result of the command in the specified `os`.
+    /// Note that `STAT PROFILE` is only supported by `processCommandCb`.
     int processCommand(const bslstl::StringRef& source,
                        const bsl::string&       cmd,
                        bsl::ostream&            os);
 
     /// Process the command in the specified `cmd` coming from the specified
     /// `source`, and send the result of the command in the specified
-    /// `onProcessedCb`.
+    /// `onProcessedCb`.  Note that `onProcessedCb` may be invoked after
+    /// this method returns, as for `STAT PROFILE`.
     int processCommandCb(
         const bslstl::StringRef&                            source,
         const bsl::string&                                  cmd,
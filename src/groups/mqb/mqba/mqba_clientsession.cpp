@@ -162,6 +162,7 @@
 #include <bmqp_controlmessageutil.h>
 #include <bmqp_event.h>
 #include <bmqp_messageproperties.h>
+#include <bmqp_messagetrace.h>
 #include <bmqp_protocolutil.h>
 #include <bmqp_putmessageiterator.h>
 #include <bmqp_queueid.h>
@@ -269,6 +270,19 @@ bool isClientGeneratingGUIDs(
     return !clientIdentity.guidInfo().clientId().empty();  // RETURN
 }
 
+bool isCumulativeAckSupported(
+    const bmqp_ctrlmsg::ClientIdentity& clientIdentity)
+// Return true when the client identity represents an SDK client generating
+// GUIDs and advertising the cumulative ACK feature.
+{
+    return clientIdentity.clientType() ==
+               bmqp_ctrlmsg::ClientType::E_TCPCLIENT &&
+           isClientGeneratingGUIDs(clientIdentity) &&
+           bmqp::ProtocolUtil::hasFeature(bmqp::AckFeatures::k_FIELD_NAME,
+                                          bmqp::AckFeatures::k_CUMULATIVE,
+                                          clientIdentity.features());
+}
+
 }  // close unnamed namespace
 
 // -------------------------
@@ -291,6 +305,9 @@ ClientSessionState::ClientSessionState(
 , d_schemaEventBuilder(bufferFactory, allocator, encodingType)
 , d_pushBuilder(bufferFactory, allocator)
 , d_ackBuilder(bufferFactory, allocator)
+, d_cumulativeAckBuilder(bufferFactory, allocator)
+, d_unackedGUIDs(allocator)
+, d_cumulativeAcks(allocator)
 , d_throttledFailedAckMessages()
 , d_throttledFailedPutMessages()
 {
@@ -305,6 +322,8 @@ ClientSessionState::ClientSessionState(
         1,
         5 * bdlt::TimeUnitRatio::k_NS_PER_S);
     // One maximum log per 5 seconds
+
+    d_cumulativeAckBuilder.setFlags(bmqp::AckHeaderFlags::e_CUMULATIVE);
 }
 
 // -------------------
@@ -529,26 +548,32 @@ void ClientSession::sendAck(bmqt::AckResult::Enum    status,
                    << ", GUID: " << messageGUID << ", queue: '" << uri
                    << "' (id: " << queueId << ")]";
 
-    // Append the ACK to the ackBuilder
-    bmqt::EventBuilderResult::Enum rc = bmqp::ProtocolUtil::buildEvent(
-        bdlf::BindUtil::bind(&bmqp::AckEventBuilder::appendMessage,
-                             &d_state.d_ackBuilder,
-                             bmqp::ProtocolUtil::ackResultToCode(status),
-                             correlationId,
-                             messageGUID,
-                             queueId),
-        bdlf::BindUtil::bind(&ClientSession::flush, this));
-
-    if (rc != bmqt::EventBuilderResult::e_SUCCESS) {
-        BALL_LOG_ERROR << "Failed to append ACK [rc: " << rc << ", source: '"
-                       << source << "'"
-                       << ", correlationId: " << correlationId
-                       << ", GUID: " << messageGUID << ", queue: '" << uri
-                       << "' (id: " << queueId << ")]";
-    }
-
-    if (d_state.d_ackBuilder.eventSize() >= k_NAGLE_PACKET_SIZE) {
-        flush();
+    if (d_isCumulativeAckEnabled && status == bmqt::AckResult::e_SUCCESS &&
+        appendCumulativeAck(queueId, messageGUID)) {
+        // The ACK will be sent as part of a cumulative ACK when flushing.
+    }
+    else {
+        // Append the ACK to the ackBuilder
+        bmqt::EventBuilderResult::Enum rc = bmqp::ProtocolUtil::buildEvent(
+            bdlf::BindUtil::bind(&bmqp::AckEventBuilder::appendMessage,
+                                 &d_state.d_ackBuilder,
+                                 bmqp::ProtocolUtil::ackResultToCode(status),
+                                 correlationId,
+                                 messageGUID,
+                                 queueId),
+            bdlf::BindUtil::bind(&ClientSession::flush, this));
+
+        if (rc != bmqt::EventBuilderResult::e_SUCCESS) {
+            BALL_LOG_ERROR << "Failed to append ACK [rc: " << rc
+                           << ", source: '" << source << "'"
+                           << ", correlationId: " << correlationId
+                           << ", GUID: " << messageGUID << ", queue: '"
+                           << uri << "' (id: " << queueId << ")]";
+        }
+
+        if (d_state.d_ackBuilder.eventSize() >= k_NAGLE_PACKET_SIZE) {
+            flush();
+        }
     }
 
     mqbstat::QueueStatsClient* queueStats = 0;
@@ -581,6 +606,53 @@ void ClientSession::sendAck(bmqt::AckResult::Enum    status,
     queueStats->onEvent(mqbstat::QueueStatsClient::EventType::e_ACK, 1);
 }
 
+bool ClientSession::appendCumulativeAck(int                      queueId,
+                                        const bmqt::MessageGUID& messageGUID)
+{
+    // executed by the *CLIENT* dispatcher thread
+
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(dispatcher()->inDispatcherThread(this));
+    BSLS_ASSERT_SAFE(d_isCumulativeAckEnabled);
+
+    ClientSessionState::UnackedGUIDsMap::iterator it =
+        d_state.d_unackedGUIDs.find(queueId);
+    if (it == d_state.d_unackedGUIDs.end()) {
+        return false;  // RETURN
+    }
+
+    // Skip the messages already acknowledged individually (i.e. out of
+    // order, or with a failure status).  Note that the ACK for
+    // 'messageGUID' has already been removed from 'd_unackedMessageInfos'.
+    bsl::deque<bmqt::MessageGUID>& guids = it->second;
+    while (!guids.empty() && guids.front() != messageGUID &&
+           d_state.d_unackedMessageInfos.find(guids.front()) ==
+               d_state.d_unackedMessageInfos.end()) {
+        guids.pop_front();
+    }
+
+    if (guids.empty() || guids.front() != messageGUID) {
+        // Some older messages of this queue are still pending an ACK, so the
+        // client is not able to tell them apart from this one in a
+        // cumulative ACK.
+        if (guids.empty()) {
+            d_state.d_unackedGUIDs.erase(it);
+        }
+        return false;  // RETURN
+    }
+
+    guids.pop_front();
+    if (guids.empty()) {
+        d_state.d_unackedGUIDs.erase(it);
+    }
+
+    // This message, and all the ones received before it on this queue, are
+    // acknowledged: advance the watermark of the cumulative ACK.
+    d_state.d_cumulativeAcks[queueId] = messageGUID;
+
+    return true;
+}
+
 void ClientSession::tearDownImpl(bslmt::Semaphore*            semaphore,
                                  const bsl::shared_ptr<void>& session,
                                  bool                         isBrokerShutdown)
@@ -1289,6 +1361,22 @@ void ClientSession::closeQueueCb(
     // PRECONDITIONS
     BSLS_ASSERT_SAFE(dispatcher()->inDispatcherThread(this));
     BSLS_ASSERT_SAFE(handleParamsCtrlMsg.choice().isCloseQueueValue());
+
+    if (d_isCumulativeAckEnabled) {
+        const int queueId = handleParamsCtrlMsg.choice()
+                                .closeQueue()
+                                .handleParameters()
+                                .qId();
+        if (d_queueSessionManager.queues().find(queueId) ==
+            d_queueSessionManager.queues().end()) {
+            // The queue is fully closed, so its id may be reused by the
+            // client for another queue: forget the order of its PUT messages
+            // still pending an ACK, which will be acknowledged individually
+            // (see 'appendCumulativeAck').
+            d_state.d_unackedGUIDs.erase(queueId);
+        }
+    }
+
     bdlma::LocalSequentialAllocator<2048> localAllocator(
         d_state.d_allocator_p);
 
@@ -1896,6 +1984,10 @@ void ClientSession::onPushEvent(const mqbi::DispatcherPushEvent& event)
     }
 
     if (convertingRc == 0) {
+        bmqp::MessageTraceUtil::recordHop(
+            event.guid(),
+            bmqp::MessageTraceHop::e_BROKER_PUSH_OUT);
+
         d_state.d_pushBuilder.packMessage(*blob,
                                           event.queueId(),
                                           event.guid(),
@@ -2211,6 +2303,12 @@ void ClientSession::onPutEvent(const mqbi::DispatcherPutEvent& event)
                         << "message.";
                 }
             }
+            else if (d_isCumulativeAckEnabled) {
+                // Keep track of the order of the PUT messages, so that
+                // consecutive ACKs can be coalesced into a cumulative ACK.
+                d_state.d_unackedGUIDs[putHeader.queueId()].push_back(
+                    putHeader.messageGUID());
+            }
         }
 
         BALL_LOG_TRACE << description() << ": PUT message #" << ++msgNum
@@ -2222,6 +2320,10 @@ void ClientSession::onPutEvent(const mqbi::DispatcherPutEvent& event)
                        << "]:\n"
                        << mwcu::BlobStartHexDumper(appDataSp.get(), 64);
 
+        bmqp::MessageTraceUtil::recordHop(
+            putIt.header().messageGUID(),
+            bmqp::MessageTraceHop::e_BROKER_PUT_IN);
+
         queueStatePtr->d_handle_p->postMessage(putIt.header(),
                                                appDataSp,
                                                optionsSp);
@@ -2477,6 +2579,7 @@ ClientSession::ClientSession(
 , d_negotiationMessage(negotiationMessage, allocator)
 , d_clientIdentity_p(extractClientIdentity(d_negotiationMessage))
 , d_isClientGeneratingGUIDs(isClientGeneratingGUIDs(*d_clientIdentity_p))
+, d_isCumulativeAckEnabled(isCumulativeAckSupported(*d_clientIdentity_p))
 , d_description(sessionDescription, allocator)
 , d_channel_sp(channel)
 , d_state(clientStatContext,
@@ -2935,6 +3038,44 @@ void ClientSession::flush()
         sendPacket(d_state.d_ackBuilder.blob(), false);
         d_state.d_ackBuilder.reset();
     }
+
+    // Finally flush the cumulative 'ACK' messages, after the individual ones:
+    // a cumulative ACK may cover a message which was NACKed individually,
+    // which the client must have processed first.
+    if (d_state.d_cumulativeAcks.empty()) {
+        return;  // RETURN
+    }
+
+    for (ClientSessionState::CumulativeAcksMap::const_iterator cit =
+             d_state.d_cumulativeAcks.begin();
+         cit != d_state.d_cumulativeAcks.end();
+         ++cit) {
+        bmqt::EventBuilderResult::Enum rc =
+            d_state.d_cumulativeAckBuilder.appendMessage(
+                bmqp::ProtocolUtil::ackResultToCode(
+                    bmqt::AckResult::e_SUCCESS),
+                bmqp::AckMessage::k_NULL_CORRELATION_ID,
+                cit->second,
+                cit->first);
+        if (rc == bmqt::EventBuilderResult::e_EVENT_TOO_BIG) {
+            sendPacket(d_state.d_cumulativeAckBuilder.blob(), false);
+            d_state.d_cumulativeAckBuilder.reset();
+            rc = d_state.d_cumulativeAckBuilder.appendMessage(
+                bmqp::ProtocolUtil::ackResultToCode(
+                    bmqt::AckResult::e_SUCCESS),
+                bmqp::AckMessage::k_NULL_CORRELATION_ID,
+                cit->second,
+                cit->first);
+        }
+        BSLS_ASSERT_SAFE(rc == bmqt::EventBuilderResult::e_SUCCESS);
+    }
+    d_state.d_cumulativeAcks.clear();
+
+    BALL_LOG_TRACE << description() << ": Flushing "
+                   << d_state.d_cumulativeAckBuilder.messageCount()
+                   << " cumulative ACK messages";
+    sendPacket(d_state.d_cumulativeAckBuilder.blob(), false);
+    d_state.d_cumulativeAckBuilder.reset();
 }
 
 }  // close package namespace
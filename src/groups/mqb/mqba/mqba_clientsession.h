@@ -149,6 +149,15 @@ struct ClientSessionState {
     typedef bsl::pair<UnackedMessageInfoMap::iterator, bool>
         UnackedMessageInfoMapInsertRc;
 
+    /// Map of queueId -> GUIDs of the PUT messages pending an ACK, in the
+    /// order they were received from the client
+    typedef bsl::unordered_map<int, bsl::deque<bmqt::MessageGUID> >
+        UnackedGUIDsMap;
+
+    /// Map of queueId -> GUID of the latest message acknowledged by the
+    /// pending cumulative ACK of the queue
+    typedef bsl::unordered_map<int, bmqt::MessageGUID> CumulativeAcksMap;
+
     typedef bslma::ManagedPtr<mwcst::StatContext> StatContextMp;
 
   public:
@@ -206,6 +215,24 @@ struct ClientSessionState {
     // used only in client dispatcher
     // thread.
 
+    bmqp::AckEventBuilder d_cumulativeAckBuilder;
+    // Builder for cumulative ack messages.
+    // To be used only in client dispatcher
+    // thread.
+
+    UnackedGUIDsMap d_unackedGUIDs;
+    // Per queue GUIDs of the PUT messages
+    // pending an ACK, in the order they
+    // were received.  The entry of a queue
+    // is removed once the queue is fully
+    // closed.  Only used if the client
+    // supports cumulative ACKs.
+
+    CumulativeAcksMap d_cumulativeAcks;
+    // Per queue cumulative ACKs pending
+    // being sent to the client at the next
+    // flush.
+
     bdlmt::Throttle d_throttledFailedAckMessages;
     // Throttler for failed ACK messages.
 
@@ -354,6 +381,14 @@ class ClientSession : public mqbnet::Session,
     // 'bmqp::MessageGUIDGenerator' and
     // doesn't provide correlation ids.
 
+    const bool d_isCumulativeAckEnabled;
+    // Set to true when the client is an
+    // SDK generating GUIDs which
+    // advertised support for cumulative
+    // ACKs: consecutive successful ACKs
+    // for a queue are then coalesced into
+    // a single cumulative ACK message.
+
     bsl::string d_description;
     // Short identifier for this session.
 
@@ -434,6 +469,16 @@ class ClientSession : public mqbnet::Session,
                  bool                     isSelfGenerated,
                  const bslstl::StringRef& source);
 
+    /// Try to account for the successful ACK of the message having the
+    /// specified `messageGUID` and posted on the queue with the specified
+    /// `queueId` in the pending cumulative ACK of that queue.  Return true
+    /// if all the messages received before it on that queue have already
+    /// been acknowledged, and thus the ACK must not be sent individually,
+    /// or false otherwise.  The behavior is undefined unless cumulative
+    /// ACKs are enabled for this session.
+    bool appendCumulativeAck(int                      queueId,
+                             const bmqt::MessageGUID& messageGUID);
+
     /// Implementation of the teardown process, with the specified `session`
     /// representing this session and posting on the specified `semaphore`
     /// once processing is done. The specified `isBrokerShutdown` is set to
@@ -451,6 +451,9 @@ class MyMockQueueHandle : public mqbmock::QueueHandle {
 
     bsl::vector<Post> d_postedMessages;
 
+    HandleReleasedCallback d_releasedCb;
+    // Callback of the last 'release' of this handle.
+
   public:
     // TRAITS
     BSLMF_NESTED_TRAIT_DECLARATION(MyMockQueueHandle,
@@ -476,6 +479,7 @@ class MyMockQueueHandle : public mqbmock::QueueHandle {
                         .value("In", 11)
                         .value("Out", 11),
                     allocator)
+    , d_releasedCb(bsl::allocator_arg, allocator)
     {
         // Not used upstreamSubQueueId;
         unsigned int upstreamSubQueueId = 1;
@@ -519,6 +523,35 @@ class MyMockQueueHandle : public mqbmock::QueueHandle {
         p.d_appData   = appData;
         p.d_options   = options;
     }
+
+    /// Called by the framework to release this handle.  We capture the
+    /// specified `releasedCb`, so that the test can complete the release
+    /// (see `completeRelease`).  The specified `handleParameters` and
+    /// `isFinal` are ignored.
+    void
+    release(BSLS_ANNOTATION_UNUSED const bmqp_ctrlmsg::QueueHandleParameters&
+                                         handleParameters,
+            BSLS_ANNOTATION_UNUSED bool  isFinal,
+            const HandleReleasedCallback& releasedCb) BSLS_KEYWORD_OVERRIDE
+    {
+        d_releasedCb = releasedCb;
+    }
+
+    /// Complete the last release of the specified `handle`, as if it had no
+    /// clients left.  The behavior is undefined unless `release` was called
+    /// on `handle`.
+    static void
+    completeRelease(const bsl::shared_ptr<MyMockQueueHandle>& handle)
+    {
+        BSLS_ASSERT_OPT(handle->d_releasedCb);
+
+        mqbi::QueueHandleReleaseResult result;
+        result.makeNoHandleClients();
+        result.makeNoHandleStreamConsumers();
+        result.makeNoHandleStreamProducers();
+
+        handle->d_releasedCb(handle, result);
+    }
 };
 
 class MyQueueEngine : public mqbmock::QueueEngine {
@@ -2306,6 +2339,205 @@ static void test11_initiateShutdown()
     }
 }
 
+static void test12_cumulativeAck()
+// ------------------------------------------------------------------------
+// TESTS CUMULATIVE ACK
+//
+// Concerns:
+//   - Verify that, for a client advertising the cumulative ACK feature,
+//     successful ACKs received in the order of the PUTs are coalesced in a
+//     single cumulative ACK message, and that the ACKs received out of order
+//     are sent individually, before the cumulative ACK.
+//
+// Plan:
+//   Instantiate a testbench with a client advertising the feature, open a
+//   queue, send three puts, ack the second, then the first and the third,
+//   and verify the events sent to the client.
+//
+// Testing:
+//   Cumulative ACK.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("TESTS CUMULATIVE ACK");
+
+    const bsl::string uri("bmq://my.domain/queue-foo-bar", s_allocator_p);
+    const int         queueId        = 4;  // A queue number
+    const bool        isAtMostOnce   = false;
+    const bool        isAckRequested = true;
+    const int         k_NUM_MSGS     = 3;
+    bmqt::MessageGUID guids[k_NUM_MSGS];
+
+    bmqp_ctrlmsg::NegotiationMessage negotiationMessage = client(e_FirstHop);
+    negotiationMessage.clientIdentity().features() =
+        bsl::string(bmqp::AckFeatures::k_FIELD_NAME) + ":" +
+        bmqp::AckFeatures::k_CUMULATIVE;
+
+    TestBench tb(negotiationMessage, isAtMostOnce, s_allocator_p);
+
+    // Send an 'OpenQueue` request.
+    tb.openQueue(uri, queueId);
+
+    // Send PUTs.
+    for (int i = 0; i < k_NUM_MSGS; ++i) {
+        guids[i] = bmqp::MessageGUIDGenerator::testGUID();
+        tb.sendOldPut(queueId,
+                      guids[i],
+                      bmqp::AckMessage::k_NULL_CORRELATION_ID,
+                      isAckRequested);
+    }
+
+    // Confirm that the OpenQueue response has been sent downstream.
+    tb.d_cs.flush();
+    tb.assertOpenQueueResponse();
+
+    // Send the 'Ack' messages, the second one out of order.
+    tb.sendAck(queueId, guids[1], bmqt::AckResult::e_SUCCESS);
+    tb.sendAck(queueId, guids[0], bmqt::AckResult::e_SUCCESS);
+    tb.sendAck(queueId, guids[2], bmqt::AckResult::e_SUCCESS);
+
+    tb.d_cs.flush();
+
+    // The out of order ACK is sent individually ...
+    tb.assertAckIsSentIfExpected(e_AckResultSuccess,
+                                 queueId,
+                                 guids[1],
+                                 bmqp::AckMessage::k_NULL_CORRELATION_ID,
+                                 1,       // eventIndex
+                                 false);  // isFinal
+
+    // ... followed by a cumulative ACK for the last message.
+    ASSERT(tb.d_channel->waitFor(3, true));
+
+    bmqp::Event ackEvent(&tb.d_channel->writeCalls()[2].d_blob,
+                         s_allocator_p);
+    ASSERT(ackEvent.isAckEvent());
+
+    bmqp::AckMessageIterator iter;
+    ackEvent.loadAckMessageIterator(&iter);
+    ASSERT(iter.isValid());
+    ASSERT_EQ(iter.header().flags(), bmqp::AckHeaderFlags::e_CUMULATIVE);
+    ASSERT(iter.next());
+    ASSERT_EQ(iter.message().queueId(), queueId);
+    ASSERT_EQ(iter.message().messageGUID(), guids[2]);
+    ASSERT_EQ(bmqp::ProtocolUtil::ackResultFromCode(iter.message().status()),
+              bmqt::AckResult::e_SUCCESS);
+    ASSERT(!iter.next());
+}
+
+static void test13_cumulativeAckQueueClosed()
+// ------------------------------------------------------------------------
+// TESTS CUMULATIVE ACK AFTER QUEUE CLOSE
+//
+// Concerns:
+//   - Verify that, once a queue is fully closed, the PUTs of that queue
+//     still pending an ACK do not prevent the PUTs of a queue reopened
+//     with the same id from being acknowledged cumulatively, and that they
+//     are acknowledged individually.
+//
+// Plan:
+//   Instantiate a testbench with a client advertising the feature, open a
+//   queue, send two puts, close the queue, reopen it with the same id,
+//   send a third put, ack the third, then the first and the second, and
+//   verify the events sent to the client.
+//
+// Testing:
+//   Cumulative ACK after queue close.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName(
+        "TESTS CUMULATIVE ACK AFTER QUEUE CLOSE");
+
+    const bsl::string uri("bmq://my.domain/queue-foo-bar", s_allocator_p);
+    const int         queueId        = 4;  // A queue number
+    const bool        isAtMostOnce   = false;
+    const bool        isAckRequested = true;
+    const int         k_NUM_MSGS     = 3;
+    bmqt::MessageGUID guids[k_NUM_MSGS];
+
+    for (int i = 0; i < k_NUM_MSGS; ++i) {
+        guids[i] = bmqp::MessageGUIDGenerator::testGUID();
+    }
+
+    bmqp_ctrlmsg::NegotiationMessage negotiationMessage = client(e_FirstHop);
+    negotiationMessage.clientIdentity().features() =
+        bsl::string(bmqp::AckFeatures::k_FIELD_NAME) + ":" +
+        bmqp::AckFeatures::k_CUMULATIVE;
+
+    TestBench tb(negotiationMessage, isAtMostOnce, s_allocator_p);
+
+    // Open the queue, and send the first two PUTs.
+    tb.openQueue(uri, queueId);
+    for (int i = 0; i < 2; ++i) {
+        tb.sendOldPut(queueId,
+                      guids[i],
+                      bmqp::AckMessage::k_NULL_CORRELATION_ID,
+                      isAckRequested);
+    }
+
+    // Fully close the queue before receiving the ACKs of these PUTs.
+    const bsl::shared_ptr<MyMockQueueHandle> closedHandle =
+        tb.d_domain.d_queueHandle;
+    tb.closeQueue(uri, queueId);
+    MyMockQueueHandle::completeRelease(closedHandle);
+
+    // Reopen a queue with the same id, and send the third PUT.
+    tb.openQueue(uri, queueId);
+    tb.sendOldPut(queueId,
+                  guids[2],
+                  bmqp::AckMessage::k_NULL_CORRELATION_ID,
+                  isAckRequested);
+
+    // Confirm that the OpenQueue, CloseQueue and OpenQueue responses have
+    // been sent downstream.
+    tb.d_cs.flush();
+    ASSERT(tb.d_channel->waitFor(3, false));
+    for (int i = 0; i < 3; ++i) {
+        bmqp::Event event(&tb.d_channel->writeCalls()[i].d_blob,
+                          s_allocator_p);
+        ASSERT_D(i, event.isControlEvent());
+    }
+
+    // Send the 'Ack' messages, the one of the reopened queue first.
+    tb.sendAck(queueId, guids[2], bmqt::AckResult::e_SUCCESS);
+    tb.sendAck(queueId, guids[0], bmqt::AckResult::e_SUCCESS);
+    tb.sendAck(queueId, guids[1], bmqt::AckResult::e_SUCCESS);
+
+    tb.d_cs.flush();
+
+    // The ACKs of the PUTs sent before the close are sent individually ...
+    ASSERT(tb.d_channel->waitFor(5, true));
+
+    bmqp::Event ackEvent(&tb.d_channel->writeCalls()[3].d_blob,
+                         s_allocator_p);
+    ASSERT(ackEvent.isAckEvent());
+
+    bmqp::AckMessageIterator iter;
+    ackEvent.loadAckMessageIterator(&iter);
+    ASSERT(iter.isValid());
+    ASSERT_EQ(iter.header().flags(), 0);
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_D(i, iter.next());
+        ASSERT_EQ_D(i, iter.message().queueId(), queueId);
+        ASSERT_EQ_D(i, iter.message().messageGUID(), guids[i]);
+    }
+    ASSERT(!iter.next());
+
+    // ... followed by a cumulative ACK for the PUT of the reopened queue.
+    bmqp::Event cumulativeAckEvent(&tb.d_channel->writeCalls()[4].d_blob,
+                                   s_allocator_p);
+    ASSERT(cumulativeAckEvent.isAckEvent());
+
+    cumulativeAckEvent.loadAckMessageIterator(&iter);
+    ASSERT(iter.isValid());
+    ASSERT_EQ(iter.header().flags(), bmqp::AckHeaderFlags::e_CUMULATIVE);
+    ASSERT(iter.next());
+    ASSERT_EQ(iter.message().queueId(), queueId);
+    ASSERT_EQ(iter.message().messageGUID(), guids[2]);
+    ASSERT_EQ(bmqp::ProtocolUtil::ackResultFromCode(iter.message().status()),
+              bmqt::AckResult::e_SUCCESS);
+    ASSERT(!iter.next());
+}
+
 static void testN1_ackConfiguration()
 // ------------------------------------------------------------------------
 // TESTS ACK CONFIGURATION FOR CLIENT SESSION
@@ -2560,6 +2792,8 @@ int main(int argc, char* argv[])
 
         switch (_testCase) {
         case 0:
+        case 13: test13_cumulativeAckQueueClosed(); break;
+        case 12: test12_cumulativeAck(); break;
         case 11: test11_initiateShutdown(); break;
         case 10: test10_newStyleCompressedPush(); break;
         case 9: test9_newStylePush(); break;
@@ -32,8 +32,11 @@
 #include <bsl_iostream.h>
 #include <bsl_string.h>
 #include <bslma_managedptr.h>
+#include <bslmt_lockguard.h>
+#include <bslmt_mutex.h>
 #include <bslmt_semaphore.h>
 #include <bsls_annotation.h>
+#include <bsls_performancehint.h>
 #include <bsls_systemclocktype.h>
 #include <bsls_timeinterval.h>
 
@@ -216,6 +219,53 @@ void Dispatcher_ClientExecutor::dispatch(const bsl::function<void()>& f) const
     }
 }
 
+// -------------------------------
+// struct Dispatcher::ProfileEntry
+// -------------------------------
+
+Dispatcher::ProfileEntry::ProfileEntry(bslma::Allocator* allocator)
+: d_description(allocator)
+, d_type(mqbi::DispatcherClientType::e_UNDEFINED)
+, d_processorId(-1)
+, d_cpuTime(0)
+, d_numEvents(0)
+{
+    // NOTHING
+}
+
+Dispatcher::ProfileEntry::ProfileEntry(const ProfileEntry& original,
+                                       bslma::Allocator*   allocator)
+: d_description(original.d_description, allocator)
+, d_type(original.d_type)
+, d_processorId(original.d_processorId)
+, d_cpuTime(original.d_cpuTime)
+, d_numEvents(original.d_numEvents)
+{
+    // NOTHING
+}
+
+// -----------------------------------
+// struct Dispatcher::ProcessorProfile
+// -----------------------------------
+
+Dispatcher::ProcessorProfile::ProcessorProfile(bslma::Allocator* allocator)
+: d_startCpuTime(0)
+, d_numEvents(0)
+, d_clients(allocator)
+{
+    // NOTHING
+}
+
+Dispatcher::ProcessorProfile::ProcessorProfile(
+    const ProcessorProfile& original,
+    bslma::Allocator*       allocator)
+: d_startCpuTime(original.d_startCpuTime)
+, d_numEvents(original.d_numEvents)
+, d_clients(original.d_clients, allocator)
+{
+    // NOTHING
+}
+
 // ------------------------------------
 // struct Dispatcher::DispatcherContext
 // ------------------------------------
@@ -229,6 +279,7 @@ Dispatcher::DispatcherContext::DispatcherContext(
 , d_flushList(config.numProcessors(),
               DispatcherClientPtrVector(allocator),
               allocator)
+, d_profiles(config.numProcessors(), ProcessorProfile(allocator), allocator)
 {
     // NOTHING
 }
@@ -358,6 +409,13 @@ void Dispatcher::queueEventCb(mqbi::DispatcherClientType::Enum type,
     case ProcessorPool::Event::MWCC_USER: {
         BALL_LOG_TRACE << "Dispatching Event to queue " << processorId
                        << " of " << type << " dispatcher: " << event->object();
+
+        const bool isProfiling = d_isProfiling.loadRelaxed();
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(isProfiling)) {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+            ++d_contexts[type]->d_profiles[processorId].d_numEvents;
+        }
+
         if (event->object().type() ==
             mqbi::DispatcherEventType::e_DISPATCHER) {
             const mqbi::DispatcherDispatcherEvent* realEvent =
@@ -379,7 +437,23 @@ void Dispatcher::queueEventCb(mqbi::DispatcherClientType::Enum type,
         }
         else {
             DispatcherContext& dispatcherContext = *(d_contexts[type]);
-            event->object().destination()->onDispatcherEvent(event->object());
+            if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(isProfiling)) {
+                BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+                const bsls::Types::Int64 start =
+                    mwcsys::ThreadUtil::currentThreadCpuTime();
+                event->object().destination()->onDispatcherEvent(
+                    event->object());
+                profileClient(type,
+                              processorId,
+                              event->object().destination(),
+                              mwcsys::ThreadUtil::currentThreadCpuTime() -
+                                  start,
+                              1);
+            }
+            else {
+                event->object().destination()->onDispatcherEvent(
+                    event->object());
+            }
             if (!event->object()
                      .destination()
                      ->dispatcherClientData()
@@ -419,9 +493,23 @@ void Dispatcher::flushClients(mqbi::DispatcherClientType::Enum type,
 {
     // executed by the *DISPATCHER* thread
 
-    DispatcherContext& context = *(d_contexts[type]);
+    DispatcherContext& context     = *(d_contexts[type]);
+    const bool         isProfiling = d_isProfiling.loadRelaxed();
     for (size_t i = 0; i < context.d_flushList[processorId].size(); ++i) {
-        context.d_flushList[processorId][i]->flush();
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(isProfiling)) {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+            const bsls::Types::Int64 start =
+                mwcsys::ThreadUtil::currentThreadCpuTime();
+            context.d_flushList[processorId][i]->flush();
+            profileClient(type,
+                          processorId,
+                          context.d_flushList[processorId][i],
+                          mwcsys::ThreadUtil::currentThreadCpuTime() - start,
+                          0);
+        }
+        else {
+            context.d_flushList[processorId][i]->flush();
+        }
         context.d_flushList[processorId][i]
             ->dispatcherClientData()
             .setAddedToFlushList(false);
@@ -429,6 +517,76 @@ void Dispatcher::flushClients(mqbi::DispatcherClientType::Enum type,
     context.d_flushList[processorId].clear();
 }
 
+void Dispatcher::profileClient(mqbi::DispatcherClientType::Enum type,
+                               int                              processorId,
+                               const mqbi::DispatcherClient*    client,
+                               bsls::Types::Int64               cpuTime,
+                               bsls::Types::Int64               numEvents)
+{
+    // executed by the *DISPATCHER* thread
+
+    ClientProfiles& profiles =
+        d_contexts[type]->d_profiles[processorId].d_clients;
+
+    ClientProfiles::iterator it = profiles.find(client);
+    if (it == profiles.end()) {
+        // Capture the description now, as the client may be destroyed
+        // before the profile is collected.
+        it = profiles.emplace(client, ProfileEntry()).first;
+        it->second.d_description = client->description();
+        it->second.d_type        = type;
+        it->second.d_processorId = processorId;
+    }
+
+    it->second.d_cpuTime += cpuTime;
+    it->second.d_numEvents += numEvents;
+}
+
+void Dispatcher::resetProfile(mqbi::DispatcherClientType::Enum type,
+                              int                              processorId)
+{
+    // executed by the *DISPATCHER* thread
+
+    ProcessorProfile& profile = d_contexts[type]->d_profiles[processorId];
+
+    profile.d_startCpuTime = mwcsys::ThreadUtil::currentThreadCpuTime();
+    profile.d_numEvents    = 0;
+    profile.d_clients.clear();
+}
+
+void Dispatcher::collectProfile(ProfileEntries*                  processors,
+                                ProfileEntries*                  clients,
+                                bslmt::Mutex*                    mutex,
+                                mqbi::DispatcherClientType::Enum type,
+                                int                              processorId)
+{
+    // executed by the *DISPATCHER* thread
+
+    ProcessorProfile& profile = d_contexts[type]->d_profiles[processorId];
+
+    ProfileEntry entry;
+    entry.d_type        = type;
+    entry.d_processorId = processorId;
+    entry.d_cpuTime     = mwcsys::ThreadUtil::currentThreadCpuTime() -
+                      profile.d_startCpuTime;
+    entry.d_numEvents   = profile.d_numEvents;
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(mutex);  // LOCK
+
+        processors->push_back(entry);
+        for (ClientProfiles::const_iterator it = profile.d_clients.begin();
+             it != profile.d_clients.end();
+             ++it) {
+            clients->push_back(it->second);
+        }
+    }  // UNLOCK
+
+    profile.d_startCpuTime = 0;
+    profile.d_numEvents    = 0;
+    profile.d_clients.clear();
+}
+
 void Dispatcher::onNewClient(mqbi::DispatcherClientType::Enum type,
                              int                              processorId)
 {
@@ -454,6 +612,7 @@ Dispatcher::Dispatcher(const mqbcfg::DispatcherConfig& config,
 , d_config(config)
 , d_scheduler_p(scheduler)
 , d_contexts(allocator)
+, d_isProfiling(false)
 {
     // PRECONDITIONS
     BSLS_ASSERT_SAFE(scheduler->clockType() ==
@@ -557,6 +716,66 @@ void Dispatcher::stop()
 #undef STOP_AND_CLEAR
 }
 
+void Dispatcher::startProfiling()
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(d_isStarted);
+
+    typedef void (bslmt::Semaphore::*PostFn)();
+
+    // Enable profiling before resetting the profile of each processor, so
+    // that the CPU time of a processor and the CPU time of its clients are
+    // measured over the same period.
+    d_isProfiling = true;
+
+    bslmt::Semaphore semaphore;
+    for (int type = 0; type < mqbi::DispatcherClientType::k_COUNT; ++type) {
+        const mqbi::DispatcherClientType::Enum clientType =
+            static_cast<mqbi::DispatcherClientType::Enum>(type);
+        execute(bdlf::BindUtil::bind(&Dispatcher::resetProfile,
+                                     this,
+                                     clientType,
+                                     bdlf::PlaceHolders::_1),  // processorId
+                clientType,
+                bdlf::BindUtil::bind(static_cast<PostFn>(
+                                         &bslmt::Semaphore::post),
+                                     &semaphore));
+        semaphore.wait();
+    }
+}
+
+void Dispatcher::stopProfiling(ProfileEntries* processors,
+                               ProfileEntries* clients)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(d_isStarted);
+    BSLS_ASSERT_SAFE(processors);
+    BSLS_ASSERT_SAFE(clients);
+
+    typedef void (bslmt::Semaphore::*PostFn)();
+
+    d_isProfiling = false;
+
+    bslmt::Mutex     mutex;
+    bslmt::Semaphore semaphore;
+    for (int type = 0; type < mqbi::DispatcherClientType::k_COUNT; ++type) {
+        const mqbi::DispatcherClientType::Enum clientType =
+            static_cast<mqbi::DispatcherClientType::Enum>(type);
+        execute(bdlf::BindUtil::bind(&Dispatcher::collectProfile,
+                                     this,
+                                     processors,
+                                     clients,
+                                     &mutex,
+                                     clientType,
+                                     bdlf::PlaceHolders::_1),  // processorId
+                clientType,
+                bdlf::BindUtil::bind(static_cast<PostFn>(
+                                         &bslmt::Semaphore::post),
+                                     &semaphore));
+        semaphore.wait();
+    }
+}
+
 mqbi::Dispatcher::ProcessorHandle
 Dispatcher::registerClient(mqbi::DispatcherClient*           client,
                            mqbi::DispatcherClientType::Enum  type,
@@ -47,6 +47,15 @@
 // the submitted functor to be executed in-place.  A call to 'dispatch' from
 // outside of the executor's associated processor thread is equivalent to a
 // call to 'post'.
+//
+/// Profiling
+///---------
+// 'mqba::Dispatcher' can measure, between a call to 'startProfiling' and a
+// call to 'stopProfiling', the CPU time consumed by each of its processor
+// threads, and the part of it spent processing the events of, and flushing,
+// each client.  The CPU time is read from the clock of the processor thread
+// around each event, so that profiling has a small cost per event, which is
+// only paid while profiling.
 
 // MQB
 
@@ -63,6 +72,8 @@
 #include <bdlmt_threadpool.h>
 #include <bsl_memory.h>
 #include <bsl_ostream.h>
+#include <bsl_string.h>
+#include <bsl_unordered_map.h>
 #include <bsl_vector.h>
 #include <bslma_allocator.h>
 #include <bslma_managedptr.h>
@@ -70,6 +81,8 @@
 #include <bslmf_nestedtraitdeclaration.h>
 #include <bslmt_threadutil.h>
 #include <bsls_assert.h>
+#include <bsls_atomic.h>
+#include <bsls_types.h>
 
 namespace BloombergLP {
 
@@ -77,6 +90,9 @@ namespace BloombergLP {
 namespace bdlmt {
 class EventScheduler;
 }
+namespace bslmt {
+class Mutex;
+}
 
 namespace mqba {
 
@@ -212,6 +228,49 @@ class Dispatcher BSLS_CPP11_FINAL : public mqbi::Dispatcher {
     // CLASS-SCOPE CATEGORY
     BALL_LOG_SET_CLASS_CATEGORY("MQBA.DISPATCHER");
 
+  public:
+    // TYPES
+
+    /// CPU time consumed, and number of events processed, by a processor
+    /// or by a client of the dispatcher while profiling.
+    struct ProfileEntry {
+        // PUBLIC DATA
+        bsl::string d_description;
+        // Description of the client, or empty
+        // for a processor
+
+        mqbi::DispatcherClientType::Enum d_type;
+        // Type of the processor, or of the
+        // processor of the client
+
+        int d_processorId;
+        // Id of the processor, or of the
+        // processor of the client
+
+        bsls::Types::Int64 d_cpuTime;
+        // CPU time consumed, in nanoseconds
+
+        bsls::Types::Int64 d_numEvents;
+        // Number of events processed
+
+        // TRAITS
+        BSLMF_NESTED_TRAIT_DECLARATION(ProfileEntry,
+                                       bslma::UsesBslmaAllocator)
+
+        // CREATORS
+
+        /// Create an empty entry, using the optionally specified
+        /// `allocator`.
+        explicit ProfileEntry(bslma::Allocator* allocator = 0);
+
+        /// Create an entry having the value of the specified `original`
+        /// one, using the optionally specified `allocator`.
+        ProfileEntry(const ProfileEntry& original,
+                     bslma::Allocator*   allocator = 0);
+    };
+
+    typedef bsl::vector<ProfileEntry> ProfileEntries;
+
   private:
     // PRIVATE TYPES
     typedef mwcc::MultiQueueThreadPool<mqbi::DispatcherEvent> ProcessorPool;
@@ -222,6 +281,43 @@ class Dispatcher BSLS_CPP11_FINAL : public mqbi::Dispatcher {
 
     typedef bsl::vector<mqbi::DispatcherClient*> DispatcherClientPtrVector;
 
+    typedef bsl::unordered_map<const mqbi::DispatcherClient*, ProfileEntry>
+        ClientProfiles;
+
+    /// Profiling data of a processor, only accessed from the thread of the
+    /// processor.
+    struct ProcessorProfile {
+        // PUBLIC DATA
+        bsls::Types::Int64 d_startCpuTime;
+        // CPU time of the thread when profiling
+        // started
+
+        bsls::Types::Int64 d_numEvents;
+        // Number of events processed since
+        // profiling started
+
+        ClientProfiles d_clients;
+        // CPU time consumed by each client since
+        // profiling started.  Note that a client
+        // is only ever dereferenced while it is
+        // processing an event, so that an entry
+        // outlives its client.
+
+        // TRAITS
+        BSLMF_NESTED_TRAIT_DECLARATION(ProcessorProfile,
+                                       bslma::UsesBslmaAllocator)
+
+        // CREATORS
+
+        /// Create an empty profile, using the specified `allocator`.
+        explicit ProcessorProfile(bslma::Allocator* allocator);
+
+        /// Create a profile having the value of the specified `original`
+        /// one, using the specified `allocator`.
+        ProcessorProfile(const ProcessorProfile& original,
+                         bslma::Allocator*       allocator);
+    };
+
     /// Context for a dispatcher, with threads and pools
     struct DispatcherContext {
       private:
@@ -256,6 +352,10 @@ class Dispatcher BSLS_CPP11_FINAL : public mqbi::Dispatcher {
         // corresponds to the
         // processor.
 
+        bsl::vector<ProcessorProfile> d_profiles;
+        // Profiling data of each processor,
+        // indexed by processor.
+
         // TRAITS
         BSLMF_NESTED_TRAIT_DECLARATION(DispatcherContext,
                                        bslma::UsesBslmaAllocator)
@@ -293,6 +393,10 @@ class Dispatcher BSLS_CPP11_FINAL : public mqbi::Dispatcher {
     // The various context, one for each
     // ClientType
 
+    bsls::AtomicBool d_isProfiling;
+    // True if the processors measure the CPU
+    // time they spend on each client
+
     // FRIENDS
     friend class Dispatcher_ClientExecutor;
     friend class Dispatcher_Executor;
@@ -333,6 +437,29 @@ class Dispatcher BSLS_CPP11_FINAL : public mqbi::Dispatcher {
     /// `processorId`.
     void flushClients(mqbi::DispatcherClientType::Enum type, int processorId);
 
+    /// Add the specified `cpuTime` and `numEvents` to the profile of the
+    /// specified `client` of the specified `type` on the processor having
+    /// the specified `processorId`.
+    void profileClient(mqbi::DispatcherClientType::Enum type,
+                       int                              processorId,
+                       const mqbi::DispatcherClient*    client,
+                       bsls::Types::Int64               cpuTime,
+                       bsls::Types::Int64               numEvents);
+
+    /// Reset the profile of the processor having the specified
+    /// `processorId` among the processors of the specified `type`.
+    void resetProfile(mqbi::DispatcherClientType::Enum type, int processorId);
+
+    /// Append to the specified `processors` the profile of the processor
+    /// having the specified `processorId` among the processors of the
+    /// specified `type`, and to the specified `clients` the profile of each
+    /// of its clients, while holding the specified `mutex`, and reset them.
+    void collectProfile(ProfileEntries*                  processors,
+                        ProfileEntries*                  clients,
+                        bslmt::Mutex*                    mutex,
+                        mqbi::DispatcherClientType::Enum type,
+                        int                              processorId);
+
     /// This method is invoked when a new client of the specified `type` is
     /// registered to the dispatcher, from the thread associated to that new
     /// client that is mapped to the specified `processorId`.
@@ -364,6 +491,21 @@ class Dispatcher BSLS_CPP11_FINAL : public mqbi::Dispatcher {
     /// Stop the `Dispatcher`.
     void stop();
 
+    /// Start measuring the CPU time consumed by each processor, and by
+    /// each client on its processor, and block until all processors are
+    /// measuring.  The behavior is undefined unless this dispatcher is
+    /// started, and this method is called from a thread other than the
+    /// processor threads.
+    void startProfiling();
+
+    /// Stop measuring the CPU time consumed by each processor and client,
+    /// and load into the specified `processors` and `clients` what was
+    /// measured since the last call to `startProfiling`.  Block until all
+    /// processors are done.  The behavior is undefined unless this
+    /// dispatcher is started, and this method is called from a thread
+    /// other than the processor threads.
+    void stopProfiling(ProfileEntries* processors, ProfileEntries* clients);
+
     /// Based on the specified `type`, associate the specified `client` to
     /// one of the processors of the dispatcher if the optionally specified
     /// `handle` is invalid, or to the provided `handle` if it is valid, and
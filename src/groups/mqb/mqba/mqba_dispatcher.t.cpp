@@ -25,6 +25,7 @@
 #include <mwcex_executionpolicy.h>
 #include <mwcex_executionutil.h>
 #include <mwcex_executor.h>
+#include <mwcsys_threadutil.h>
 #include <mwcsys_time.h>
 
 // BDE
@@ -89,6 +90,33 @@ struct LoadSelfThreadId {
     }
 };
 
+// =====================
+// struct ConsumeCpuTime
+// =====================
+
+/// Provides a functor that consumes at least the specified CPU time, in
+/// nanoseconds, on the current thread.
+struct ConsumeCpuTime {
+    // TYPES
+
+    /// Defines the result type of the call operator.
+    typedef void ResultType;
+
+    // ACCESSORS
+    void operator()(bsls::Types::Int64 cpuTime) const
+    {
+        if (!mwcsys::ThreadUtil::k_SUPPORT_THREAD_CPU_TIME) {
+            return;  // RETURN
+        }
+
+        const bsls::Types::Int64 start =
+            mwcsys::ThreadUtil::currentThreadCpuTime();
+        while (mwcsys::ThreadUtil::currentThreadCpuTime() - start < cpuTime) {
+            // Spin
+        }
+    }
+};
+
 }  // close unnamed namespace
 
 // ============================================================================
@@ -484,6 +512,110 @@ static void test3_executorsSupport()
     eventScheduler.stop();
 }
 
+static void test4_profiling()
+// ------------------------------------------------------------------------
+// PROFILING
+//
+// Concerns:
+//   - The CPU time consumed by each processor, and by each client on its
+//     processor, is measured between 'startProfiling' and
+//     'stopProfiling'.
+//   - Nothing is measured once profiling stopped.
+//
+// Testing:
+//   startProfiling
+//   stopProfiling
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("PROFILING");
+
+    const int                k_NUM_EVENTS = 5;
+    const bsls::Types::Int64 k_CPU_TIME   = 1000 * 1000;  // 1 ms
+
+    bdlmt::EventScheduler eventScheduler(bsls::SystemClockType::e_MONOTONIC,
+                                         s_allocator_p);
+    int                   rc = eventScheduler.start();
+    BSLS_ASSERT_OPT(rc == 0);
+
+    mqbcfg::DispatcherConfig dispatcherConfig;
+    dispatcherConfig.sessions().numProcessors() = 1;
+    dispatcherConfig.sessions().processorConfig().queueSize() = 100;
+    dispatcherConfig.sessions().processorConfig().queueSizeHighWatermark() =
+        100;
+    dispatcherConfig.queues().numProcessors()                            = 2;
+    dispatcherConfig.queues().processorConfig().queueSize()              = 100;
+    dispatcherConfig.queues().processorConfig().queueSizeHighWatermark() = 100;
+    dispatcherConfig.clusters().numProcessors()               = 1;
+    dispatcherConfig.clusters().processorConfig().queueSize() = 100;
+    dispatcherConfig.clusters().processorConfig().queueSizeHighWatermark() =
+        100;
+
+    mqba::Dispatcher dispatcher(dispatcherConfig,
+                                &eventScheduler,
+                                s_allocator_p);
+
+    bsl::stringstream startErr(s_allocator_p);
+    rc = dispatcher.start(startErr);
+    ASSERT_EQ(rc, 0);
+
+    mqbmock::DispatcherClient client(s_allocator_p);
+    client._setDescription("queue");
+    dispatcher.registerClient(&client, mqbi::DispatcherClientType::e_QUEUE);
+
+    mqba::Dispatcher::ProfileEntries processors(s_allocator_p);
+    mqba::Dispatcher::ProfileEntries clients(s_allocator_p);
+
+    PV("Profiling");
+    dispatcher.startProfiling();
+    for (int i = 0; i < k_NUM_EVENTS; ++i) {
+        dispatcher.clientExecutor(&client).post(
+            bdlf::BindUtil::bind(ConsumeCpuTime(), k_CPU_TIME));
+    }
+    dispatcher.synchronize(&client);
+    dispatcher.stopProfiling(&processors, &clients);
+
+    ASSERT_EQ(processors.size(), 4U);
+    ASSERT_EQ(clients.size(), 1U);
+    if (clients.size() == 1U) {
+        ASSERT_EQ(clients[0].d_description, "queue");
+        ASSERT_EQ(clients[0].d_type, mqbi::DispatcherClientType::e_QUEUE);
+        ASSERT_EQ(clients[0].d_processorId,
+                  client.dispatcherClientData().processorHandle());
+        ASSERT_EQ(clients[0].d_numEvents, k_NUM_EVENTS);
+        if (mwcsys::ThreadUtil::k_SUPPORT_THREAD_CPU_TIME) {
+            ASSERT_GE(clients[0].d_cpuTime, k_NUM_EVENTS * k_CPU_TIME);
+        }
+
+        for (size_t i = 0; i < processors.size(); ++i) {
+            const mqba::Dispatcher::ProfileEntry& processor = processors[i];
+            if (processor.d_type != clients[0].d_type ||
+                processor.d_processorId != clients[0].d_processorId) {
+                continue;  // CONTINUE
+            }
+
+            // The events of the client, and the one to synchronize.
+            ASSERT_GE(processor.d_numEvents, k_NUM_EVENTS + 1);
+            ASSERT_GE(processor.d_cpuTime, clients[0].d_cpuTime);
+        }
+    }
+
+    PV("Events before profiling are not measured");
+    processors.clear();
+    clients.clear();
+    dispatcher.clientExecutor(&client).post(
+        bdlf::BindUtil::bind(ConsumeCpuTime(), k_CPU_TIME));
+    dispatcher.synchronize(&client);
+    dispatcher.startProfiling();
+    dispatcher.stopProfiling(&processors, &clients);
+
+    ASSERT_EQ(processors.size(), 4U);
+    ASSERT(clients.empty());
+
+    dispatcher.unregisterClient(&client);
+    dispatcher.stop();
+    eventScheduler.stop();
+}
+
 // ============================================================================
 //                                 MAIN PROGRAM
 // ----------------------------------------------------------------------------
@@ -496,6 +628,7 @@ int main(int argc, char* argv[])
 
     switch (_testCase) {
     case 0:
+    case 4: test4_profiling(); break;
     case 3: test3_executorsSupport(); break;
     case 2: test2_clientTypeEnumValues(); break;
     case 1: test1_breathingTest(); break;
@@ -133,7 +133,13 @@ void loadBrokerIdentity(bmqp_ctrlmsg::ClientIdentity* identity,
         .append(";")
         .append(bmqp::HighAvailabilityFeatures::k_FIELD_NAME)
         .append(":")
-        .append(bmqp::HighAvailabilityFeatures::k_GRACEFUL_SHUTDOWN);
+        .append(bmqp::HighAvailabilityFeatures::k_GRACEFUL_SHUTDOWN)
+        .append(",")
+        .append(bmqp::HighAvailabilityFeatures::k_PARALLEL_RECOVERY)
+        .append(",")
+        .append(bmqp::HighAvailabilityFeatures::k_INCREMENTAL_RECOVERY)
+        .append(",")
+        .append(bmqp::HighAvailabilityFeatures::k_COMPRESSED_REPLICATION);
 
     if (shouldBroadcastToProxies) {
         features.append(",").append(
@@ -34,6 +34,7 @@
 #include <bmqp_confirmmessageiterator.h>
 #include <bmqp_controlmessageutil.h>
 #include <bmqp_event.h>
+#include <bmqp_eventutil.h>
 #include <bmqp_protocol.h>
 #include <bmqp_protocolutil.h>
 #include <bmqp_pushmessageiterator.h>
@@ -2559,6 +2560,18 @@ Cluster::Cluster(const bslstl::StringRef&           name,
             d_clusterData.clusterNodesStatContext()->addSubcontext(config);
         StatContextSp statContextSp(statContextMp, d_allocator_p);
         nodeSessionSp->statContext() = statContextSp;
+        (*nodeIter)->setStatContext(statContextSp);
+
+        // Compress the storage events replicated to the nodes located in a
+        // different data center, if so configured
+        if (d_clusterData.clusterConfig()
+                .partitionConfig()
+                .compressRemoteReplication() &&
+            (*nodeIter)->dataCenter() !=
+                netCluster_p->selfNode()->dataCenter()) {
+            (*nodeIter)->setReplicationCompression(
+                bmqt::CompressionAlgorithmType::e_ZLIB);
+        }
 
         nodeSessionMap.insert(bsl::make_pair(*nodeIter, nodeSessionSp));
 
@@ -3268,6 +3281,40 @@ void Cluster::processEvent(const bmqp::Event&   event,
     } break;
     case bmqp::EventType::e_STORAGE: {
         // Storage event arrives from primary to replica/replication nodes.
+        if (event.isCompressedStorageEvent()) {
+            // Decompress the event here, in the IO thread, so that the
+            // storage layer only ever deals with uncompressed events.
+            const bsls::Types::Int64 startTime =
+                mwcsys::Time::highResolutionTimer();
+
+            bdlbb::Blob decompressed(d_clusterData.bufferFactory(),
+                                     d_allocator_p);
+            const int   rc = bmqp::EventUtil::decompressStorageEvent(
+                &decompressed,
+                *event.blob(),
+                d_clusterData.bufferFactory(),
+                d_allocator_p);
+            if (rc != 0) {
+                MWCTSK_ALARMLOG_ALARM("CLUSTER")
+                    << description()
+                    << ": failed to decompress storage event from node "
+                    << source->nodeDescription() << ", rc: " << rc
+                    << ". Dropping the event." << MWCTSK_ALARMLOG_END;
+                return;  // RETURN
+            }
+
+            mqbc::ClusterNodeSession* nodeSession =
+                d_clusterData.membership().getClusterNodeSession(source);
+            if (nodeSession && nodeSession->statContext()) {
+                mqbstat::ClusterNodeStats::onReplicationDecompressed(
+                    nodeSession->statContext().get(),
+                    mwcsys::Time::highResolutionTimer() - startTime);
+            }
+
+            processEvent(bmqp::Event(&decompressed, d_allocator_p), source);
+            return;  // RETURN
+        }
+
         DISPATCH_EVENT(mqbi::DispatcherEventType::e_STORAGE, false);
     } break;  // BREAK
     case bmqp::EventType::e_PARTITION_SYNC: {
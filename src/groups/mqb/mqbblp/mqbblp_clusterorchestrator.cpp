@@ -415,6 +415,18 @@ void ClusterOrchestrator::onNodeUnavailable(mqbnet::ClusterNode* node)
 
     dropPeerQueues(ns);
 
+    // For each partition for which self is primary, notify the StorageMgr
+    // that the peer is gone, so that it stops tracking its Receipts.
+
+    const bsl::vector<int>& selfPartitions =
+        d_clusterData_p->membership().selfNodeSession()->primaryPartitions();
+    for (unsigned int i = 0; i < selfPartitions.size(); ++i) {
+        d_storageManager_p->processReplicaStatusAdvisory(
+            selfPartitions[i],
+            node,
+            bmqp_ctrlmsg::NodeStatus::E_UNAVAILABLE);
+    }
+
     if (ns->primaryPartitions().empty()) {
         // Node was not primary for any partition.  Nothing else to do.
 
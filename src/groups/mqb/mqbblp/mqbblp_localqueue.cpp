@@ -30,6 +30,7 @@
 #include <mqbu_storagekey.h>
 
 // BMQ
+#include <bmqp_messagetrace.h>
 #include <bmqp_protocolutil.h>
 #include <bmqt_queueflags.h>
 #include <bmqt_resultcode.h>
@@ -485,6 +486,10 @@ void LocalQueue::postMessage(const bmqp::PutHeader&              putHeader,
         // flushed (which occurs in 'flush' routine).  In no case should
         // 'afterNewMessage' be called here.
 
+        bmqp::MessageTraceUtil::recordHop(
+            putHeader.messageGUID(),
+            bmqp::MessageTraceHop::e_PRIMARY_STORED);
+
         d_state_p->stats().onEvent(mqbstat::QueueStatsDomain::EventType::e_PUT,
                                    appData->length());
 
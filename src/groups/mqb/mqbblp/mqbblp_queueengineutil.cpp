@@ -860,6 +860,7 @@ QueueEngineUtil_AppState::deliverMessages(bsls::TimeInterval*     delay,
     //   1. End of storage; or
     //   2. subStream's capacity is saturated
     mqbi::StorageIterator* storageIter_p = d_storageIter_mp.get();
+    storageIter_p->resume();
 
     while (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(storageIter_p->hasReceipt())) {
         Routers::Result result = Routers::e_SUCCESS;
@@ -985,6 +986,7 @@ void QueueEngineUtil_AppState::beforeMessageRemoved(
     // PRECONDITIONS
     BSLS_ASSERT_SAFE(d_storageIter_mp);
 
+    d_storageIter_mp->resume();
     if (!d_storageIter_mp->atEnd() && (d_storageIter_mp->guid() == msgGUID)) {
         d_storageIter_mp->advance();
     }
@@ -1314,7 +1316,7 @@ Routers::Result QueueEngineUtil_AppState::selectConsumer(
     return result;
 }
 
-bslma::ManagedPtr<mqbi::StorageIterator> QueueEngineUtil_AppState::head() const
+bslma::ManagedPtr<mqbi::StorageIterator> QueueEngineUtil_AppState::head()
 {
     bslma::ManagedPtr<mqbi::StorageIterator> out;
 
@@ -1322,8 +1324,11 @@ bslma::ManagedPtr<mqbi::StorageIterator> QueueEngineUtil_AppState::head() const
         d_queue_p->storage()->getIterator(&out,
                                           d_appKey,
                                           d_putAsideList.first());
+        return out;  // RETURN
     }
-    else if (!d_storageIter_mp->atEnd()) {
+
+    d_storageIter_mp->resume();
+    if (!d_storageIter_mp->atEnd()) {
         d_queue_p->storage()->getIterator(&out,
                                           d_appKey,
                                           d_storageIter_mp->guid());
@@ -503,6 +503,11 @@ struct QueueEngineUtil_AppState {
     selectConsumer(const Routers::Visitor&      visitor,
                    const mqbi::StorageIterator* currentMessage);
 
+    /// Returns storage iterator to the 1st un-delivered message including
+    /// `put-aside` messages (those without matching Subscriptions).  Note
+    /// that this resumes the storage iterator of this app.
+    bslma::ManagedPtr<mqbi::StorageIterator> head();
+
     // ACCESSORS
     size_t redeliveryListSize() const;
 
@@ -511,10 +516,6 @@ struct QueueEngineUtil_AppState {
     unsigned int upstreamSubQueueId() const;
 
     bool hasConsumers() const;
-
-    /// Returns storage iterator to the 1st un-delivered message including
-    /// `put-aside` messages (those without matching Subscriptions).
-    bslma::ManagedPtr<mqbi::StorageIterator> head() const;
 };
 
 // ==========================================
@@ -28,10 +28,12 @@
 #include <mqbs_journalfileiterator.h>
 #include <mqbs_offsetptr.h>
 #include <mqbs_qlistfileiterator.h>
+#include <mqbstat_clusterstats.h>
 
 // BMQ
 #include <bmqp_event.h>
 #include <bmqp_protocol.h>
+#include <bmqp_protocolutil.h>
 #include <bmqp_recoveryeventbuilder.h>
 #include <bmqp_recoverymessageiterator.h>
 #include <bmqp_schemaeventbuilder.h>
@@ -57,6 +59,7 @@
 #include <bdlt_currenttime.h>
 #include <bdlt_datetime.h>
 #include <bdlt_epochutil.h>
+#include <bdlt_timeunitratio.h>
 #include <bsl_algorithm.h>
 #include <bsl_cstddef.h>
 #include <bsl_cstdlib.h>  // for bsl::rand()
@@ -88,6 +91,39 @@ class SyncPointOffsetPairComparator {
     }
 };
 
+/// This class provides a custom comparator to compare the sync point of a
+/// (sync-point, offset) pair with a sync point, ignoring the offset.
+class SyncPointOffsetPairSyncPointComparator {
+  public:
+    // ACCESSORS
+    bool operator()(const bmqp_ctrlmsg::SyncPointOffsetPair& lhs,
+                    const bmqp_ctrlmsg::SyncPoint&           rhs) const
+    {
+        return lhs.syncPoint() < rhs;
+    }
+};
+
+/// Position of the next chunk to send of one of the files of a partition
+/// (see `RecoveryManager::sendFiles`).
+struct FileChunkCursor {
+    // DATA
+    bmqp::RecoveryFileChunkType::Enum d_chunkFileType;
+
+    mqbs::MappedFileDescriptor* d_mfd_p;
+
+    bsls::Types::Uint64 d_offset;
+    // Offset of the next chunk.
+
+    bsls::Types::Uint64 d_endOffset;
+    // Offset past the last chunk.
+
+    unsigned int d_sequenceNumber;
+    // Sequence number of the last chunk sent.
+
+    bool d_isDone;
+    // Whether the final chunk has been sent.
+};
+
 /// Move all files associated with the specified `partitionId` located at
 /// the specified `currentLocation` to the specified `archiveLocation`.
 /// Behavior is undefined unless `partitionId` is non-zero, and both
@@ -198,10 +234,39 @@ void RecoveryManager_RecoveryContext::clear()
     d_inRecovery         = false;
     d_recoveryPeer_p     = 0;
     d_responseType       = bmqp_ctrlmsg::StorageSyncResponseType::E_UNDEFINED;
-    d_expectedChunkFileType     = bmqp::RecoveryFileChunkType::e_UNDEFINED;
-    d_lastChunkSequenceNumber   = 0;
+    d_isReceivingChunks         = false;
+    d_receivedFiles             = 0;
+    d_chunksStartTime           = 0;
+    d_numChunkBytes             = 0;
     d_recoveryStartupWaitHandle = EventHandle();
     d_recoveryStatusCheckHandle = EventHandle();
+    bsl::fill_n(d_lastChunkSequenceNumbers, k_NUM_CHUNK_FILE_TYPES, 0U);
+}
+
+void RecoveryManager_RecoveryContext::rewindToSyncPoint(
+    const bmqp_ctrlmsg::SyncPoint& syncPoint,
+    bsls::Types::Uint64            journalOffset)
+{
+    const bsls::Types::Uint64 dataFileOffsetDwords =
+        syncPoint.dataFileOffsetDwords();
+    const bsls::Types::Uint64 qlistFileOffsetWords =
+        syncPoint.qlistFileOffsetWords();
+
+    d_oldSyncPoint       = syncPoint;
+    d_oldSyncPointOffset = journalOffset;
+    d_journalFileOffset  = journalOffset +
+                          mqbs::FileStoreProtocol::k_JOURNAL_RECORD_SIZE;
+    d_dataFileOffset     = dataFileOffsetDwords * bmqp::Protocol::k_DWORD_SIZE;
+    d_qlistFileOffset    = qlistFileOffsetWords * bmqp::Protocol::k_WORD_SIZE;
+}
+
+void RecoveryManager_RecoveryContext::startReceivingChunks()
+{
+    d_isReceivingChunks = true;
+    d_receivedFiles     = 0;
+    d_chunksStartTime   = mwcsys::Time::highResolutionTimer();
+    d_numChunkBytes     = 0;
+    bsl::fill_n(d_lastChunkSequenceNumbers, k_NUM_CHUNK_FILE_TYPES, 0U);
 }
 
 // ----------------------------------------
@@ -359,6 +424,164 @@ void RecoveryManager_ChunkDeleter::operator()(
 // class RecoveryManager
 // ---------------------
 
+// CLASS METHODS
+int RecoveryManager::verifyChunkDigest(
+    bsl::ostream&                        errorDescription,
+    const bdlbb::Blob&                   event,
+    const bmqp::RecoveryMessageIterator& iterator)
+{
+    // executed by *ANY* thread
+
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(iterator.isValid());
+
+    enum {
+        rc_SUCCESS                = 0,
+        rc_INVALID_CHUNK_POSITION = -1,
+        rc_DIGEST_FAILURE         = -2,
+        rc_DIGEST_MISMATCH        = -3
+    };
+
+    const bmqp::RecoveryHeader& header = iterator.header();
+    const unsigned int          chunkSize =
+        (header.messageWords() - header.headerWords()) *
+        bmqp::Protocol::k_WORD_SIZE;
+
+    // Perform md5 digest check only if chunk is of non-zero size.  Note that
+    // if chunkSize is zero, 'RecoveryMessageIterator::loadChunkPosition' will
+    // still return success, but 'chunkPosition' will point to an invalid
+    // position (the buffer index will be invalid).
+
+    if (0 == chunkSize) {
+        return rc_SUCCESS;  // RETURN
+    }
+
+    mwcu::BlobPosition chunkPosition;
+    int                rc = iterator.loadChunkPosition(&chunkPosition);
+    if (0 != rc) {
+        errorDescription << "failed to load chunk position, rc: " << rc;
+        return rc * 10 + rc_INVALID_CHUNK_POSITION;  // RETURN
+    }
+
+    bdlde::Md5::Md5Digest md5Digest;
+    rc = mqbs::FileStoreProtocolUtil::calculateMd5Digest(&md5Digest,
+                                                         event,
+                                                         chunkPosition,
+                                                         chunkSize);
+    if (0 != rc) {
+        errorDescription << "failed to calculate MD5 digest, rc: " << rc;
+        return rc * 10 + rc_DIGEST_FAILURE;  // RETURN
+    }
+
+    if (0 != bsl::memcmp(md5Digest.buffer(),
+                         header.md5Digest(),
+                         bmqp::RecoveryHeader::k_MD5_DIGEST_LEN)) {
+        errorDescription << "chunk MD5 digest mismatch. Calculated: ";
+        bdlb::Print::singleLineHexDump(errorDescription,
+                                       md5Digest.buffer(),
+                                       bmqp::RecoveryHeader::k_MD5_DIGEST_LEN);
+        errorDescription << ", specified in header: ";
+        bdlb::Print::singleLineHexDump(errorDescription,
+                                       header.md5Digest(),
+                                       bmqp::RecoveryHeader::k_MD5_DIGEST_LEN);
+        return rc_DIGEST_MISMATCH;  // RETURN
+    }
+
+    return rc_SUCCESS;
+}
+
+int RecoveryManager::findDivergenceSyncPoint(
+    bmqp_ctrlmsg::SyncPointOffsetPair* result,
+    const SyncPointOffsetPairs&        spOffsetPairs,
+    const bmqp_ctrlmsg::SyncPoint&     beginSyncPoint,
+    const bmqp_ctrlmsg::SyncPoint&     endSyncPoint)
+{
+    // executed by *ANY* thread
+
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(result);
+
+    // Only the sync points are compared, because the journal offset of a
+    // sync point unknown to this node is meaningless.
+
+    const bmqp_ctrlmsg::SyncPoint& limit = beginSyncPoint < endSyncPoint
+                                               ? beginSyncPoint
+                                               : endSyncPoint;
+
+    SyncPointOffsetConstIter it = bsl::lower_bound(
+        spOffsetPairs.begin(),
+        spOffsetPairs.end(),
+        limit,
+        SyncPointOffsetPairSyncPointComparator());
+    if (spOffsetPairs.begin() == it) {
+        // All the sync points are at or after 'limit', ie the journal has
+        // rolled over since the divergence.
+
+        return -1;  // RETURN
+    }
+
+    *result = *(--it);
+    return 0;
+}
+
+int RecoveryManager::findJournalSyncPoint(
+    bsls::Types::Uint64*              journalOffset,
+    const mqbs::MappedFileDescriptor& journalFd,
+    const bmqp_ctrlmsg::SyncPoint&    syncPoint)
+{
+    // executed by *ANY* thread
+
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(journalOffset);
+    BSLS_ASSERT_SAFE(journalFd.isValid());
+
+    enum {
+        rc_SUCCESS              = 0,
+        rc_ITERATOR_FAILURE     = -1,
+        rc_SYNC_POINT_NOT_FOUND = -2
+    };
+
+    mqbs::JournalFileIterator jit;
+    int                       rc = jit.reset(
+        &journalFd,
+        mqbs::FileStoreProtocolUtil::bmqHeader(journalFd),
+        true);  // reverse mode
+    if (0 != rc) {
+        return rc * 10 + rc_ITERATOR_FAILURE;  // RETURN
+    }
+
+    // Sync points are in increasing order in the journal, so iterate from
+    // the end until reaching a sync point which is not after 'syncPoint'.
+
+    while (1 == jit.nextRecord()) {
+        if (mqbs::RecordType::e_JOURNAL_OP != jit.recordType()) {
+            continue;  // CONTINUE
+        }
+
+        const mqbs::JournalOpRecord& rec = jit.asJournalOpRecord();
+        if (mqbs::JournalOpType::e_SYNCPOINT != rec.type()) {
+            continue;  // CONTINUE
+        }
+
+        bmqp_ctrlmsg::SyncPoint sp;
+        sp.primaryLeaseId()       = rec.primaryLeaseId();
+        sp.sequenceNum()          = rec.sequenceNum();
+        sp.dataFileOffsetDwords() = rec.dataFileOffsetDwords();
+        sp.qlistFileOffsetWords() = rec.qlistFileOffsetWords();
+
+        if (sp == syncPoint) {
+            *journalOffset = jit.recordOffset();
+            return rc_SUCCESS;  // RETURN
+        }
+
+        if (sp < syncPoint) {
+            break;  // BREAK
+        }
+    }
+
+    return rc_SYNC_POINT_NOT_FOUND;
+}
+
 // PRIVATE MANIPULATORS
 void RecoveryManager::recoveryStartupWaitCb(int partitionId)
 {
@@ -857,8 +1080,7 @@ void RecoveryManager::onStorageSyncResponseDispatched(
     RecoveryContext& recoveryCtx = d_recoveryContexts[partitionId];
     BSLS_ASSERT_SAFE(bmqp_ctrlmsg::StorageSyncResponseType::E_UNDEFINED ==
                      recoveryCtx.responseType());
-    BSLS_ASSERT_SAFE(bmqp::RecoveryFileChunkType::e_UNDEFINED ==
-                     recoveryCtx.expectedChunkFileType());
+    BSLS_ASSERT_SAFE(!recoveryCtx.isReceivingChunks());
 
     const bmqp_ctrlmsg::StorageSyncRequest& req = context->request()
                                                       .choice()
@@ -1207,8 +1429,7 @@ void RecoveryManager::onStorageSyncResponseDispatched(
         recoveryCtx.setDataFileOffset(0);
         recoveryCtx.setJournalFileOffset(0);
         recoveryCtx.setQlistFileOffset(0);
-        recoveryCtx.setExpectedChunkFileType(
-            bmqp::RecoveryFileChunkType::e_DATA);
+        recoveryCtx.startReceivingChunks();
 
         return;  // RETURN
     }
@@ -1234,6 +1455,32 @@ void RecoveryManager::onStorageSyncResponseDispatched(
             return;  // RETURN
         }
 
+        bsls::Types::Uint64 divergenceSpOffset = 0;
+        if (beginSp < recoveryCtx.oldSyncPoint() &&
+            recoveryCtx.journalFd().isValid() &&
+            0 == findJournalSyncPoint(&divergenceSpOffset,
+                                      recoveryCtx.journalFd(),
+                                      beginSp)) {
+            // Peer does not have the 'A' sync point, and sent a patch from
+            // the last sync point common to both histories instead (see
+            // 'processStorageSyncRequest').  Rewind to that sync point, so
+            // that the records after it are overwritten by the patch, or
+            // truncated once recovery completes.
+
+            BALL_LOG_INFO << d_clusterData_p->identity().description()
+                          << " PartitionId [" << partitionId
+                          << "]: 'A' sync point: "
+                          << recoveryCtx.oldSyncPoint()
+                          << " diverges from peer's history, rewinding to "
+                          << "sync point: " << beginSp
+                          << " at journal offset: "
+                          << mwcu::PrintUtil::prettyNumber(
+                                 static_cast<bsls::Types::Int64>(
+                                     divergenceSpOffset));
+
+            recoveryCtx.rewindToSyncPoint(beginSp, divergenceSpOffset);
+        }
+
         if (beginSp != recoveryCtx.oldSyncPoint()) {
             MWCTSK_ALARMLOG_ALARM("RECOVERY")
                 << d_clusterData_p->identity().description()
@@ -1318,8 +1565,7 @@ void RecoveryManager::onStorageSyncResponseDispatched(
         // All good.  Recovery will be complete when this node has received
         // entire patch from the peer.
 
-        recoveryCtx.setExpectedChunkFileType(
-            bmqp::RecoveryFileChunkType::e_DATA);
+        recoveryCtx.startReceivingChunks();
         return;  // RETURN
     }
 
@@ -1479,147 +1725,183 @@ void RecoveryManager::stopDispatched(int partitionId, bslmt::Latch* latch)
     latch->arrive();
 }
 
-int RecoveryManager::sendFile(RequestContext*                   context,
-                              bsls::Types::Uint64               beginOffset,
-                              bsls::Types::Uint64               endOffset,
-                              unsigned int                      chunkSize,
-                              bmqp::RecoveryFileChunkType::Enum chunkFileType)
-
+int RecoveryManager::sendFiles(RequestContext*     context,
+                               bsls::Types::Uint64 dataFileBeginOffset,
+                               bsls::Types::Uint64 dataFileEndOffset,
+                               bsls::Types::Uint64 qlistFileBeginOffset,
+                               bsls::Types::Uint64 qlistFileEndOffset,
+                               bsls::Types::Uint64 journalFileBeginOffset,
+                               bsls::Types::Uint64 journalFileEndOffset,
+                               bool                interleave)
 {
     // executed by *ANY* thread
 
     // PRECONDITIONS
     BSLS_ASSERT_SAFE(context);
-    BSLS_ASSERT_SAFE(beginOffset <= endOffset);
-    BSLS_ASSERT_SAFE(0 < chunkSize);
+    BSLS_ASSERT_SAFE(dataFileBeginOffset <= dataFileEndOffset);
+    BSLS_ASSERT_SAFE(qlistFileBeginOffset <= qlistFileEndOffset);
+    BSLS_ASSERT_SAFE(journalFileBeginOffset <= journalFileEndOffset);
 
     enum { rc_SUCCESS = 0, rc_BUILDER_FAILURE = -1, rc_WRITE_FAILURE = -2 };
 
-    mqbs::MappedFileDescriptor* mfd = 0;
-    FileTransferInfo&           fti = context->fileTransferInfo();
-
-    switch (chunkFileType) {
-    case bmqp::RecoveryFileChunkType::e_DATA:
-        mfd = &fti.dataFd();
-        break;  // BREAK
-
-    case bmqp::RecoveryFileChunkType::e_QLIST:
-        mfd = &fti.qlistFd();
-        break;  // BREAK
-
-    case bmqp::RecoveryFileChunkType::e_JOURNAL:
-        mfd = &fti.journalFd();
-        break;  // BREAK
-
-    case bmqp::RecoveryFileChunkType::e_UNDEFINED:
-        BSLS_ASSERT_SAFE(false);
-        break;  // BREAK
-    }
+    const mqbcfg::StorageSyncConfig& syncConfig =
+        d_clusterConfig.partitionConfig().syncConfig();
+    const unsigned int chunkSize = syncConfig.fileChunkSize();
+    BSLS_ASSERT_SAFE(0 < chunkSize);
 
-    BSLS_ASSERT_SAFE(0 != mfd);
-    BSLS_ASSERT_SAFE(mfd->isValid());
+    FileTransferInfo& fti = context->fileTransferInfo();
+    FileChunkCursor   cursors[] = {{bmqp::RecoveryFileChunkType::e_DATA,
+                                    &fti.dataFd(),
+                                    dataFileBeginOffset,
+                                    dataFileEndOffset,
+                                    0,
+                                    false},
+                                   {bmqp::RecoveryFileChunkType::e_QLIST,
+                                    &fti.qlistFd(),
+                                    qlistFileBeginOffset,
+                                    qlistFileEndOffset,
+                                    0,
+                                    false},
+                                   {bmqp::RecoveryFileChunkType::e_JOURNAL,
+                                    &fti.journalFd(),
+                                    journalFileBeginOffset,
+                                    journalFileEndOffset,
+                                    0,
+                                    false}};
+    const int k_NUM_FILES = sizeof(cursors) / sizeof(cursors[0]);
 
     // Builder should be created on the stack because this routine can be
     // invoked from any thread.
 
-    unsigned int               sequenceNumber = 0;
-    bsls::Types::Uint64        currOffset     = beginOffset;
     bmqp::RecoveryEventBuilder builder(d_clusterData_p->bufferFactory(),
                                        d_allocator_p);
 
-    while ((currOffset + chunkSize) < endOffset) {
-        BSLS_ASSERT_SAFE(currOffset < mfd->fileSize());
+    // Events are written without waiting for the peer, so that as many
+    // chunks as the channel buffers are in flight.  Note that the final
+    // chunk of a file is sent even if it is empty, so that the peer knows
+    // that the file is complete.
+
+    int numDone = 0;
+    int rc      = rc_SUCCESS;
+    for (int i = 0; numDone < k_NUM_FILES;) {
+        FileChunkCursor& cursor = cursors[i % k_NUM_FILES];
+        if (cursor.d_isDone) {
+            ++i;
+            continue;  // CONTINUE
+        }
 
-        bsl::shared_ptr<char> chunkBufferSp(mfd->mapping() + currOffset,
+        BSLS_ASSERT_SAFE(cursor.d_mfd_p->isValid());
+        BSLS_ASSERT_SAFE(cursor.d_offset == cursor.d_endOffset ||
+                         cursor.d_offset < cursor.d_mfd_p->fileSize());
+
+        const bool isFinal = cursor.d_endOffset <=
+                             cursor.d_offset + chunkSize;
+        const unsigned int length =
+            isFinal ? static_cast<unsigned int>(cursor.d_endOffset -
+                                                cursor.d_offset)
+                    : chunkSize;
+
+        bsl::shared_ptr<char> chunkBufferSp(cursor.d_mfd_p->mapping() +
+                                                cursor.d_offset,
                                             ChunkDeleter(context));
-        bdlbb::BlobBuffer     chunkBlobBuffer(chunkBufferSp, chunkSize);
+        bdlbb::BlobBuffer     chunkBlobBuffer(chunkBufferSp, length);
 
         // Bump up aliased chunk counter now that 'chunkBufferSp' is referring
         // to the mapped region of type 'chunkFileType' (DATA/QLIST/JOURNAL).
 
         fti.incrementAliasedChunksCount();
 
-        // Add chunk to recovery event builder.
+        // Add chunk to recovery event builder, sending the chunks already
+        // added if it does not fit.
 
         bmqt::EventBuilderResult::Enum buildRc = builder.packMessage(
             static_cast<unsigned int>(context->partitionId()),
-            chunkFileType,
-            ++sequenceNumber,
+            cursor.d_chunkFileType,
+            cursor.d_sequenceNumber + 1,
             chunkBlobBuffer,
-            false);  // Not the last chunk
+            isFinal);
+
+        if (bmqt::EventBuilderResult::e_EVENT_TOO_BIG == buildRc &&
+            0 < builder.messageCount()) {
+            rc = flushRecoveryEvent(&builder, context);
+            if (0 != rc) {
+                return rc * 10 + rc_WRITE_FAILURE;  // RETURN
+            }
+
+            buildRc = builder.packMessage(
+                static_cast<unsigned int>(context->partitionId()),
+                cursor.d_chunkFileType,
+                cursor.d_sequenceNumber + 1,
+                chunkBlobBuffer,
+                isFinal);
+        }
 
         if (bmqt::EventBuilderResult::e_SUCCESS != buildRc) {
             return static_cast<int>(buildRc) * 10 +
                    rc_BUILDER_FAILURE;  // RETURN
         }
 
-        bmqt::GenericResult::Enum writeRc = context->requesterNode()->write(
-            builder.blob(),
-            bmqp::EventType::e_RECOVERY);
-
-        if (bmqt::GenericResult::e_SUCCESS != writeRc) {
-            BALL_LOG_ERROR << "Failed to write " << chunkFileType
-                           << " file chunk with sequence # " << sequenceNumber
-                           << " for PartitionId [" << context->partitionId()
-                           << "] to peer node: "
-                           << context->requesterNode()->nodeDescription()
-                           << ", rc: " << writeRc;
-            return static_cast<int>(writeRc) * 10 +
-                   rc_WRITE_FAILURE;  // RETURN
+        ++cursor.d_sequenceNumber;
+        cursor.d_offset += length;
+        if (isFinal) {
+            cursor.d_isDone = true;
+            ++numDone;
         }
 
-        // Its important to reset the builder at this point so that it can
-        // release its copy of 'chunkBufferSp', so that when other copies of
-        // 'chunkBufferSp' are released, its custom deleter is invoked.
-
-        builder.reset();
+        if (syncConfig.partitionSyncEventSize() <= builder.eventSize()) {
+            rc = flushRecoveryEvent(&builder, context);
+            if (0 != rc) {
+                return rc * 10 + rc_WRITE_FAILURE;  // RETURN
+            }
+        }
 
-        currOffset += chunkSize;
+        if (interleave || cursor.d_isDone) {
+            ++i;
+        }
     }
 
-    // Send remaining part of the file.
-
-    bsl::shared_ptr<char> chunkBufferSp(mfd->mapping() + currOffset,
-                                        ChunkDeleter(context));
-    bdlbb::BlobBuffer chunkBlobBuffer(chunkBufferSp, endOffset - currOffset);
+    rc = flushRecoveryEvent(&builder, context);
+    if (0 != rc) {
+        return rc * 10 + rc_WRITE_FAILURE;  // RETURN
+    }
 
-    // Bump up aliased chunk counter now that 'chunkBufferSp' is referring to
-    // the mapped region of type 'chunkFileType' (DATA/QLIST/JOURNAL).
+    return rc_SUCCESS;
+}
 
-    fti.incrementAliasedChunksCount();
+int RecoveryManager::flushRecoveryEvent(bmqp::RecoveryEventBuilder* builder,
+                                        RequestContext*             context)
+{
+    // executed by *ANY* thread
 
-    // Add chunk to recovery event builder.
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(builder);
+    BSLS_ASSERT_SAFE(context);
 
-    bmqt::EventBuilderResult::Enum buildRc = builder.packMessage(
-        static_cast<unsigned int>(context->partitionId()),
-        chunkFileType,
-        ++sequenceNumber,
-        chunkBlobBuffer,
-        true);  // Its the last chunk
+    enum { rc_SUCCESS = 0, rc_WRITE_FAILURE = -1 };
 
-    if (bmqt::EventBuilderResult::e_SUCCESS != buildRc) {
-        return static_cast<int>(buildRc) * 10 + rc_BUILDER_FAILURE;  // RETURN
+    if (0 == builder->messageCount()) {
+        return rc_SUCCESS;  // RETURN
     }
 
     bmqt::GenericResult::Enum writeRc = context->requesterNode()->write(
-        builder.blob(),
+        builder->blob(),
         bmqp::EventType::e_RECOVERY);
 
     if (bmqt::GenericResult::e_SUCCESS != writeRc) {
-        BALL_LOG_ERROR << "Failed to write " << chunkFileType
-                       << " file chunk with sequence # " << sequenceNumber
-                       << " for PartitionId [" << context->partitionId() << "]"
-                       << " to peer node: "
+        BALL_LOG_ERROR << "Failed to write recovery event with "
+                       << builder->messageCount() << " file chunks for "
+                       << "PartitionId [" << context->partitionId()
+                       << "] to peer node: "
                        << context->requesterNode()->nodeDescription()
                        << ", rc: " << writeRc;
         return static_cast<int>(writeRc) * 10 + rc_WRITE_FAILURE;  // RETURN
     }
 
     // Its important to reset the builder at this point so that it can release
-    // its copy of 'chunkBufferSp', so that when other copies of
-    // 'chunkBufferSp' are released, its custom deleter is invoked.
+    // its copy of the chunk buffers, so that when other copies of them are
+    // released, their custom deleter is invoked.
 
-    builder.reset();
+    builder->reset();
 
     return rc_SUCCESS;
 }
@@ -3353,39 +3635,25 @@ void RecoveryManager::processRecoveryEvent(
     BSLS_ASSERT_SAFE(iter.isValid());
 
     while (1 == iter.next()) {
-        const bmqp::RecoveryHeader& header = iter.header();
-
-        bool isData    = false;
-        bool isJournal = false;
-        bool isQlist   = false;
-
-        switch (header.fileChunkType()) {
-        case bmqp::RecoveryFileChunkType::e_DATA:
-            isData = true;
-            break;  // BREAK
-
-        case bmqp::RecoveryFileChunkType::e_QLIST:
-            isQlist = true;
-            break;  // BREAK
+        const bmqp::RecoveryHeader&             header = iter.header();
+        const bmqp::RecoveryFileChunkType::Enum chunkFileType =
+            header.fileChunkType();
 
-        case bmqp::RecoveryFileChunkType::e_JOURNAL:
-            isJournal = true;
-            break;  // BREAK
-
-        case bmqp::RecoveryFileChunkType::e_UNDEFINED:
-            BSLS_ASSERT_SAFE(false && "Unreachable by design.");
-        }
+        BSLS_ASSERT_SAFE(bmqp::RecoveryFileChunkType::e_UNDEFINED !=
+                             chunkFileType &&
+                         "Unreachable by design.");
 
-        BSLS_ASSERT_SAFE(isData || isJournal || isQlist);
-        (void)isJournal;  // Compiler happiness
+        // Chunks of the DATA, QLIST and JOURNAL files may be interleaved if
+        // the peer supports it, but the chunks of each file are received in
+        // order.
 
-        if (header.fileChunkType() != recoveryCtx.expectedChunkFileType()) {
+        if (!recoveryCtx.isReceivingChunks() ||
+            recoveryCtx.isFileReceived(chunkFileType)) {
             MWCTSK_ALARMLOG_ALARM("RECOVERY")
                 << d_clusterData_p->identity().description()
                 << ": For PartitionId [" << partitionId
-                << "], received incorrect file chunk type: "
-                << header.fileChunkType()
-                << ", expected: " << recoveryCtx.expectedChunkFileType()
+                << "], received unexpected file chunk type: " << chunkFileType
+                << ", chunk sequence number: " << header.chunkSequenceNumber()
                 << ", from: " << source->nodeDescription()
                 << ". Stopping recovery." << MWCTSK_ALARMLOG_END;
 
@@ -3399,8 +3667,8 @@ void RecoveryManager::processRecoveryEvent(
             return;  // RETURN
         }
 
-        unsigned int expectedSeqNum = recoveryCtx.lastChunkSequenceNumber() +
-                                      1;
+        unsigned int expectedSeqNum =
+            recoveryCtx.lastChunkSequenceNumber(chunkFileType) + 1;
 
         if (header.chunkSequenceNumber() != expectedSeqNum) {
             MWCTSK_ALARMLOG_ALARM("RECOVERY")
@@ -3409,6 +3677,7 @@ void RecoveryManager::processRecoveryEvent(
                 << "], received incorrect chunk sequence "
                 << "number: " << header.chunkSequenceNumber()
                 << ", expected: " << expectedSeqNum
+                << ", chunk type: " << chunkFileType
                 << ", from: " << source->nodeDescription()
                 << ". Stopping recovery." << MWCTSK_ALARMLOG_END;
 
@@ -3430,7 +3699,7 @@ void RecoveryManager::processRecoveryEvent(
                 << d_clusterData_p->identity().description()
                 << ": For PartitionId [" << partitionId << "],"
                 << " failed to load chunk position, rc: " << rc
-                << ". Chunk type: " << header.fileChunkType()
+                << ". Chunk type: " << chunkFileType
                 << ", chunk sequence number: " << header.chunkSequenceNumber()
                 << ", from: " << source->nodeDescription()
                 << ". Stopping recovery." << MWCTSK_ALARMLOG_END;
@@ -3445,101 +3714,57 @@ void RecoveryManager::processRecoveryEvent(
             return;  // RETURN
         }
 
-        unsigned int chunkSize = (header.messageWords() -
-                                  header.headerWords()) *
-                                 bmqp::Protocol::k_WORD_SIZE;
-
-        // Perform md5 digest check only if chunk is of non-zero size.  Note
-        // that if chunkSize is zero,
-        // 'RecoveryMessageIterator::loadChunkPosition' will still return
-        // success, but 'chunkPosition' will point to an invalid position (the
-        // buffer index will be invalid).
-
-        if (0 != chunkSize) {
-            bdlde::Md5::Md5Digest md5Digest;
-            rc = mqbs::FileStoreProtocolUtil::calculateMd5Digest(&md5Digest,
-                                                                 *blob,
-                                                                 chunkPosition,
-                                                                 chunkSize);
-            if (0 != rc) {
-                MWCTSK_ALARMLOG_ALARM("RECOVERY")
-                    << d_clusterData_p->identity().description()
-                    << ": For PartitionId [" << partitionId << "], "
-                    << "failed to calculate MD5 digest, "
-                    << "rc: " << rc
-                    << ". Chunk type: " << header.fileChunkType()
-                    << ", chunk sequence number: "
-                    << header.chunkSequenceNumber()
-                    << ", from: " << source->nodeDescription()
-                    << ". Stopping recovery." << MWCTSK_ALARMLOG_END;
-
-                onPartitionRecoveryStatus(partitionId, -1 /* status */);
-
-                // TBD: reschedule recovery.  Note that peer will continue to
-                // send recovery chunks because we don't notify the peer to
-                // cancel recovery request.  The chunks sent by it will be
-                // rejected with one of the two 'if' checks at the beginning of
-                // this routine.
-
-                return;  // RETURN
-            }
-
-            if (0 != bsl::memcmp(md5Digest.buffer(),
-                                 header.md5Digest(),
-                                 bmqp::RecoveryHeader::k_MD5_DIGEST_LEN)) {
-                mwcu::MemOutStream out;
-                out << d_clusterData_p->identity().description()
-                    << ": For PartitionId [" << partitionId
-                    << "], chunk MD5 digest mismatch. Calculated: ";
-
-                bdlb::Print::singleLineHexDump(
-                    out,
-                    md5Digest.buffer(),
-                    bmqp::RecoveryHeader::k_MD5_DIGEST_LEN);
+        // Verify the MD5 digest of the chunk in the partition's thread,
+        // rather than in the cluster dispatcher thread shared by all the
+        // partitions, before writing the chunk to the file.
 
-                out << ", specified in header: ";
-
-                bdlb::Print::singleLineHexDump(
-                    out,
-                    header.md5Digest(),
-                    bmqp::RecoveryHeader::k_MD5_DIGEST_LEN);
-
-                out << ". Chunk type: " << header.fileChunkType()
-                    << ", chunk sequence number: "
-                    << header.chunkSequenceNumber()
-                    << ", from: " << source->nodeDescription()
-                    << ". Stopping recovery.";
-
-                MWCTSK_ALARMLOG_ALARM("RECOVERY")
-                    << out.str() << MWCTSK_ALARMLOG_END;
+        mwcu::MemOutStream errorDesc;
+        rc = verifyChunkDigest(errorDesc, *blob, iter);
+        if (0 != rc) {
+            MWCTSK_ALARMLOG_ALARM("RECOVERY")
+                << d_clusterData_p->identity().description()
+                << ": For PartitionId [" << partitionId
+                << "], received invalid file chunk, rc: " << rc
+                << ", reason: " << errorDesc.str()
+                << ". Chunk type: " << chunkFileType
+                << ", chunk sequence number: " << header.chunkSequenceNumber()
+                << ", from: " << source->nodeDescription()
+                << ". Stopping recovery." << MWCTSK_ALARMLOG_END;
 
-                onPartitionRecoveryStatus(partitionId, -1 /* status */);
+            onPartitionRecoveryStatus(partitionId, -1 /* status */);
 
-                // TBD: reschedule recovery.  Note that peer will continue to
-                // send recovery chunks because we don't notify the peer to
-                // cancel recovery request.  The chunks sent by it will be
-                // rejected with one of the two 'if' checks at the beginning of
-                // this routine.
+            // TBD: reschedule recovery.  Note that peer will continue to send
+            // recovery chunks because we don't notify the peer to cancel
+            // recovery request.  The chunks sent by it will be rejected with
+            // one of the two 'if' checks at the beginning of this routine.
 
-                return;  // RETURN
-            }
+            return;  // RETURN
         }
 
+        unsigned int chunkSize = (header.messageWords() -
+                                  header.headerWords()) *
+                                 bmqp::Protocol::k_WORD_SIZE;
+
         mqbs::MappedFileDescriptor* mfd    = 0;
         bsls::Types::Uint64         offset = 0;
 
-        if (isData) {
+        switch (chunkFileType) {
+        case bmqp::RecoveryFileChunkType::e_DATA: {
             mfd    = &recoveryCtx.dataFd();
             offset = recoveryCtx.dataFileOffset();
-        }
-        else if (isQlist) {
+        } break;  // BREAK
+        case bmqp::RecoveryFileChunkType::e_QLIST: {
             mfd    = &recoveryCtx.qlistFd();
             offset = recoveryCtx.qlistFileOffset();
-        }
-        else {
-            BSLS_ASSERT_SAFE(isJournal);
+        } break;  // BREAK
+        case bmqp::RecoveryFileChunkType::e_JOURNAL: {
             mfd    = &recoveryCtx.journalFd();
             offset = recoveryCtx.journalFileOffset();
+        } break;  // BREAK
+        case bmqp::RecoveryFileChunkType::e_UNDEFINED:
+        default: {
+            BSLS_ASSERT_SAFE(false && "Unreachable by design.");
+        } break;  // BREAK
         }
 
         // 'offset' can be zero if we are writing from the beginning of the
@@ -3547,6 +3772,11 @@ void RecoveryManager::processRecoveryEvent(
 
         BSLS_ASSERT_SAFE(mfd);
 
+        // Note that if chunkSize is zero,
+        // 'RecoveryMessageIterator::loadChunkPosition' will still return
+        // success, but 'chunkPosition' will point to an invalid position (the
+        // buffer index will be invalid).
+
         if (0 != chunkSize) {
             mwcu::BlobUtil::copyToRawBufferFromIndex(mfd->block().base() +
                                                          offset,
@@ -3556,43 +3786,69 @@ void RecoveryManager::processRecoveryEvent(
                                                      chunkSize);
             // Update offset.
 
-            if (isData) {
+            switch (chunkFileType) {
+            case bmqp::RecoveryFileChunkType::e_DATA: {
                 recoveryCtx.setDataFileOffset(offset + chunkSize);
-            }
-            else if (isQlist) {
+            } break;  // BREAK
+            case bmqp::RecoveryFileChunkType::e_QLIST: {
                 recoveryCtx.setQlistFileOffset(offset + chunkSize);
-            }
-            else {
+            } break;  // BREAK
+            case bmqp::RecoveryFileChunkType::e_JOURNAL: {
                 recoveryCtx.setJournalFileOffset(offset + chunkSize);
+            } break;  // BREAK
+            case bmqp::RecoveryFileChunkType::e_UNDEFINED:
+            default: {
+                BSLS_ASSERT_SAFE(false && "Unreachable by design.");
+            } break;  // BREAK
             }
+
+            recoveryCtx.addChunkBytes(chunkSize);
+            d_clusterData_p->stats().onPartitionEvent(
+                mqbstat::ClusterStats::PartitionEventType::
+                    e_PARTITION_SYNC_CHUNK,
+                partitionId,
+                chunkSize);
         }
 
+        recoveryCtx.setLastChunkSequenceNumber(chunkFileType,
+                                               header.chunkSequenceNumber());
+
         if (!header.isFinalChunk()) {
             // There are more chunks to come for this file.
 
-            recoveryCtx.setLastChunkSequenceNumber(
-                header.chunkSequenceNumber());
             continue;  // CONTINUE
         }
 
-        // Last chunk for the current file.  Update sequence number and the
-        // expected file.
+        recoveryCtx.setFileReceived(chunkFileType);
 
-        recoveryCtx.setLastChunkSequenceNumber(0);
-        if (isData) {
-            recoveryCtx.setExpectedChunkFileType(
-                bmqp::RecoveryFileChunkType::e_QLIST);
-        }
-        else if (isQlist) {
-            recoveryCtx.setExpectedChunkFileType(
-                bmqp::RecoveryFileChunkType::e_JOURNAL);
+        if (!recoveryCtx.areAllFilesReceived()) {
+            continue;  // CONTINUE
         }
-        else {
-            // Journal file is the last one, and this is its last chunk.  This
-            // implies that recovery complete.
 
-            onPartitionRecoveryStatus(partitionId, 0 /* status */);
-        }
+        // Last chunk of the last file.  This implies that recovery is
+        // complete.
+
+        const bsls::Types::Int64 elapsed =
+            mwcsys::Time::highResolutionTimer() -
+            recoveryCtx.chunksStartTime();
+        const bsls::Types::Int64 numBytes = recoveryCtx.numChunkBytes();
+        const bsls::Types::Int64 bytesPerSecond =
+            elapsed > 0
+                ? static_cast<bsls::Types::Int64>(
+                      static_cast<double>(numBytes) *
+                      bdlt::TimeUnitRatio::k_NANOSECONDS_PER_SECOND / elapsed)
+                : 0;
+
+        BALL_LOG_INFO << d_clusterData_p->identity().description()
+                      << " PartitionId [" << partitionId << "]: received "
+                      << mwcu::PrintUtil::prettyBytes(numBytes) << " from "
+                      << source->nodeDescription() << " in "
+                      << mwcu::PrintUtil::prettyTimeInterval(elapsed) << " ("
+                      << mwcu::PrintUtil::prettyBytes(bytesPerSecond)
+                      << "/s).";
+
+        onPartitionRecoveryStatus(partitionId, 0 /* status */);
+        return;  // RETURN
     }
 }
 
@@ -3818,6 +4074,40 @@ void RecoveryManager::processStorageSyncRequest(
 
     BSLS_ASSERT_SAFE(mqbc::ClusterUtil::isValid(bsp));
 
+    if (mqbc::ClusterUtil::isValid(asp.syncPoint()) &&
+        bmqp::ProtocolUtil::hasFeature(
+            bmqp::HighAvailabilityFeatures::k_FIELD_NAME,
+            bmqp::HighAvailabilityFeatures::k_INCREMENTAL_RECOVERY,
+            source->identity().features()) &&
+        (bsp < asp || !bsl::binary_search(spOffsetPairs.begin(),
+                                          spOffsetPairs.end(),
+                                          asp,
+                                          SyncPointOffsetPairComparator()))) {
+        // The requester's history diverged from the one of this node after
+        // some sync point, typically because the requester was the primary
+        // and went down before replicating its last records.  Instead of
+        // failing the request, which makes the requester fall back to
+        // retrieving the entire partition, send it a patch from the last
+        // sync point this node has before 'A' and 'B'.  The requester
+        // truncates its files to that sync point before applying the patch.
+
+        bmqp_ctrlmsg::SyncPointOffsetPair divergenceSp;
+        if (0 == findDivergenceSyncPoint(&divergenceSp,
+                                         spOffsetPairs,
+                                         asp.syncPoint(),
+                                         bsp.syncPoint())) {
+            BALL_LOG_INFO << d_clusterData_p->identity().description()
+                          << " PartitionId [" << req.partitionId()
+                          << "]: Begin sync point (A): " << asp
+                          << " diverges from self's history, sending patch "
+                          << "from sync point: " << divergenceSp
+                          << " instead, while serving storage sync request: "
+                          << req << ", from: " << source->nodeDescription();
+
+            asp = divergenceSp;
+        }
+    }
+
     if (bsp < asp) {
         BALL_LOG_WARN << d_clusterData_p->identity().description()
                       << ": End sync point (B): " << bsp
@@ -4155,84 +4445,50 @@ void RecoveryManager::processStorageSyncRequest(
 
     d_clusterData_p->messageTransmitter().sendMessageSafe(controlMsg, source);
 
-    // Send data file patch first, in chunks.
     const bsls::Types::Int64 dataFileSize = dataFileEndOffset -
                                             dataFileBeginOffset;
-    BSLS_ASSERT_SAFE(dataFileSize >= 0);
-    BALL_LOG_INFO << d_clusterData_p->identity().description()
-                  << " PartitionId [" << req.partitionId()
-                  << "]: sending DATA patch/file of size: "
-                  << mwcu::PrintUtil::prettyNumber(dataFileSize) << " bytes.";
-
-    const int fileChunkSize =
-        d_clusterConfig.partitionConfig().syncConfig().fileChunkSize();
-    rc = sendFile(&requestCtx,
-                  dataFileBeginOffset,
-                  dataFileEndOffset,
-                  fileChunkSize,
-                  bmqp::RecoveryFileChunkType::e_DATA);
-    if (0 != rc) {
-        MWCTSK_ALARMLOG_ALARM("RECOVERY")
-            << d_clusterData_p->identity().description()
-            << ": Failed to send DATA file/patch to "
-            << source->nodeDescription()
-            << ", while serving storage sync request: " << req
-            << ", from: " << source->nodeDescription() << ". [rc: " << rc
-            << "]. "
-            << "Sending error." << MWCTSK_ALARMLOG_END;
-        return;  // RETURN
-    }
-
-    // Next, send qlist file, in chunks.
     const bsls::Types::Int64 qlistFileSize = qlistFileEndOffset -
                                              qlistFileBeginOffset;
-    BSLS_ASSERT_SAFE(qlistFileSize >= 0);
-    BALL_LOG_INFO << d_clusterData_p->identity().description()
-                  << " PartitionId [" << req.partitionId()
-                  << "]: sending QLIST file/patch of size: "
-                  << mwcu::PrintUtil::prettyNumber(qlistFileSize) << " bytes.";
-
-    rc = sendFile(&requestCtx,
-                  qlistFileBeginOffset,
-                  qlistFileEndOffset,
-                  fileChunkSize,
-                  bmqp::RecoveryFileChunkType::e_QLIST);
-    if (0 != rc) {
-        MWCTSK_ALARMLOG_ALARM("RECOVERY")
-            << d_clusterData_p->identity().description()
-            << ": Failed to send QLIST file/patch to "
-            << source->nodeDescription()
-            << ", while serving storage sync request: " << req
-            << ", from: " << source->nodeDescription() << ". [rc: " << rc
-            << "]. "
-            << "Sending error." << MWCTSK_ALARMLOG_END;
-        return;  // RETURN
-    }
-
-    // Send journal file once data file patch has been sent, in chunks.
     const bsls::Types::Int64 journalFileSize = journalFileEndOffset -
                                                journalFileBeginOffset;
+    BSLS_ASSERT_SAFE(dataFileSize >= 0);
+    BSLS_ASSERT_SAFE(qlistFileSize >= 0);
     BSLS_ASSERT_SAFE(journalFileSize >= 0);
+
+    // Chunks of the DATA, QLIST and JOURNAL files are sent interleaved if
+    // the requester supports it, so that it receives all three files
+    // concurrently.  Otherwise, DATA is sent first, then QLIST, then JOURNAL.
+
+    const bool interleave = bmqp::ProtocolUtil::hasFeature(
+        bmqp::HighAvailabilityFeatures::k_FIELD_NAME,
+        bmqp::HighAvailabilityFeatures::k_PARALLEL_RECOVERY,
+        source->identity().features());
+
     BALL_LOG_INFO << d_clusterData_p->identity().description()
                   << " PartitionId [" << req.partitionId()
-                  << "]: sending JOURNAL file/patch of size: "
+                  << "]: sending DATA, QLIST and JOURNAL patch/file of size: "
+                  << mwcu::PrintUtil::prettyNumber(dataFileSize) << ", "
+                  << mwcu::PrintUtil::prettyNumber(qlistFileSize) << " and "
                   << mwcu::PrintUtil::prettyNumber(journalFileSize)
-                  << " bytes.";
-
-    rc = sendFile(&requestCtx,
-                  journalFileBeginOffset,
-                  journalFileEndOffset,
-                  fileChunkSize,
-                  bmqp::RecoveryFileChunkType::e_JOURNAL);
+                  << " bytes respectively"
+                  << (interleave ? ", interleaved." : ", in sequence.");
+
+    rc = sendFiles(&requestCtx,
+                   dataFileBeginOffset,
+                   dataFileEndOffset,
+                   qlistFileBeginOffset,
+                   qlistFileEndOffset,
+                   journalFileBeginOffset,
+                   journalFileEndOffset,
+                   interleave);
     if (0 != rc) {
         MWCTSK_ALARMLOG_ALARM("RECOVERY")
             << d_clusterData_p->identity().description()
-            << ": Failed to send JOURNAL file/patch to "
+            << ": Failed to send DATA/QLIST/JOURNAL file/patch to "
             << source->nodeDescription()
             << ", while serving storage sync request: " << req
             << ", from: " << source->nodeDescription() << ". [rc: " << rc
-            << "]. "
-            << "Sending error." << MWCTSK_ALARMLOG_END;
+            << "]. " << MWCTSK_ALARMLOG_END;
         return;  // RETURN
     }
 }
@@ -42,6 +42,7 @@
 
 // BMQ
 #include <bmqp_ctrlmsg_messages.h>
+#include <bmqp_protocol.h>
 
 // MWC
 #include <mwcu_blob.h>
@@ -50,6 +51,7 @@
 #include <ball_log.h>
 #include <bdlbb_blob.h>
 #include <bdlmt_eventscheduler.h>
+#include <bsl_algorithm.h>
 #include <bsl_functional.h>
 #include <bsl_list.h>
 #include <bsl_memory.h>
@@ -66,6 +68,10 @@
 namespace BloombergLP {
 
 // FORWARD DECLARATION
+namespace bmqp {
+class RecoveryEventBuilder;
+class RecoveryMessageIterator;
+}
 namespace bslmt {
 class Latch;
 }
@@ -184,6 +190,12 @@ class RecoveryManager_RecoveryContext {
                                mqbnet::ClusterNode* recoveryPeer)>
         PartitionRecoveryCb;
 
+    // CONSTANTS
+    enum {
+        /// Size of the arrays indexed by file chunk type.
+        k_NUM_CHUNK_FILE_TYPES = bmqp::RecoveryFileChunkType::e_QLIST + 1
+    };
+
   private:
     // PRIVATE TYPES
     typedef mqbs::FileStoreSet FileSet;
@@ -275,12 +287,31 @@ class RecoveryManager_RecoveryContext {
     // Type of storage sync response sent
     // by the peer.
 
-    bmqp::RecoveryFileChunkType::Enum d_expectedChunkFileType;
-    // Type of file chunk expected next
-    // from the peer.
+    bool d_isReceivingChunks;
+    // Flag to indicate if the storage sync
+    // response of the peer has been
+    // processed, and file chunks are now
+    // expected from it.
 
-    unsigned int d_lastChunkSequenceNumber;
+    unsigned int d_lastChunkSequenceNumbers[k_NUM_CHUNK_FILE_TYPES];
     // Sequence number of last chunk
+    // received from the peer for each
+    // file, indexed by file chunk type.
+    // Chunks of the different files may
+    // be interleaved.
+
+    int d_receivedFiles;
+    // Bit mask, indexed by file chunk
+    // type, of the files whose final
+    // chunk has been received.
+
+    bsls::Types::Int64 d_chunksStartTime;
+    // High resolution timer value when
+    // file chunks started being expected
+    // from the peer.
+
+    bsls::Types::Int64 d_numChunkBytes;
+    // Number of bytes of file chunks
     // received from the peer.
 
     EventHandle d_recoveryStartupWaitHandle;
@@ -350,9 +381,24 @@ class RecoveryManager_RecoveryContext {
 
     void setResponseType(bmqp_ctrlmsg::StorageSyncResponseType::Value value);
 
-    void setExpectedChunkFileType(bmqp::RecoveryFileChunkType::Enum value);
+    /// Make the specified `syncPoint`, located at the specified
+    /// `journalOffset` in the journal, the old sync point, and set the
+    /// offsets at which the next chunks of the journal, data and qlist
+    /// files are written to the ones right after it, so that the records
+    /// after `syncPoint` are overwritten by the patch sent by the peer.
+    void rewindToSyncPoint(const bmqp_ctrlmsg::SyncPoint& syncPoint,
+                           bsls::Types::Uint64            journalOffset);
+
+    /// Start expecting file chunks from the peer, resetting the sequence
+    /// numbers, received files and throughput counters.
+    void startReceivingChunks();
+
+    void setLastChunkSequenceNumber(bmqp::RecoveryFileChunkType::Enum type,
+                                    unsigned int                      value);
 
-    void setLastChunkSequenceNumber(unsigned int value);
+    void setFileReceived(bmqp::RecoveryFileChunkType::Enum type);
+
+    void addChunkBytes(bsls::Types::Int64 value);
 
     EventHandle& recoveryStartupWaitHandle();
 
@@ -397,9 +443,20 @@ class RecoveryManager_RecoveryContext {
 
     bmqp_ctrlmsg::StorageSyncResponseType::Value responseType() const;
 
-    bmqp::RecoveryFileChunkType::Enum expectedChunkFileType() const;
+    bool isReceivingChunks() const;
+
+    unsigned int
+    lastChunkSequenceNumber(bmqp::RecoveryFileChunkType::Enum type) const;
 
-    unsigned int lastChunkSequenceNumber() const;
+    bool isFileReceived(bmqp::RecoveryFileChunkType::Enum type) const;
+
+    /// Return true if the final chunk of each of the DATA, QLIST and
+    /// JOURNAL files has been received.
+    bool areAllFilesReceived() const;
+
+    bsls::Types::Int64 chunksStartTime() const;
+
+    bsls::Types::Int64 numChunkBytes() const;
 
     const StorageEvents& storageEvents() const;
 };
@@ -941,11 +998,30 @@ class RecoveryManager : public mqbnet::ClusterObserver {
 
     void stopDispatched(int partitionId, bslmt::Latch* latch);
 
-    int sendFile(RequestContext*                   context,
-                 bsls::Types::Uint64               beginOffset,
-                 bsls::Types::Uint64               endOffset,
-                 unsigned int                      chunkSize,
-                 bmqp::RecoveryFileChunkType::Enum chunkFileType);
+    /// Send to the requester node of the specified `context` the DATA,
+    /// QLIST and JOURNAL files of its partition between the specified
+    /// respective begin and end offsets, in chunks of the configured file
+    /// chunk size, packing as many chunks as fit in the configured
+    /// partition sync event size in each recovery event.  If the specified
+    /// `interleave` is true, the chunks of the three files are sent
+    /// alternately, otherwise the files are sent one after the other.
+    /// Return 0 on success, or a non-zero value otherwise.  Executed by any
+    /// thread.
+    int sendFiles(RequestContext*     context,
+                  bsls::Types::Uint64 dataFileBeginOffset,
+                  bsls::Types::Uint64 dataFileEndOffset,
+                  bsls::Types::Uint64 qlistFileBeginOffset,
+                  bsls::Types::Uint64 qlistFileEndOffset,
+                  bsls::Types::Uint64 journalFileBeginOffset,
+                  bsls::Types::Uint64 journalFileEndOffset,
+                  bool                interleave);
+
+    /// Write the recovery event built by the specified `builder`, if it is
+    /// not empty, to the requester node of the specified `context`, and
+    /// reset the `builder`.  Return 0 on success, or a non-zero value
+    /// otherwise.
+    int flushRecoveryEvent(bmqp::RecoveryEventBuilder* builder,
+                           RequestContext*             context);
 
     int replayPartition(
         RequestContext*                              requestContext,
@@ -1007,6 +1083,40 @@ class RecoveryManager : public mqbnet::ClusterObserver {
                       const mqbnet::ClusterNode*          source);
 
   public:
+    // CLASS METHODS
+
+    /// Verify the MD5 digest of the file chunk at the current position of
+    /// the specified `iterator` over the specified recovery `event`.
+    /// Return 0 on success, or a non-zero value and populate the specified
+    /// `errorDescription` otherwise.  Executed by any thread.
+    static int
+    verifyChunkDigest(bsl::ostream&                        errorDescription,
+                      const bdlbb::Blob&                   event,
+                      const bmqp::RecoveryMessageIterator& iterator);
+
+    /// Load into the specified `result` the most recent of the specified
+    /// `spOffsetPairs` whose sync point strictly precedes both the
+    /// specified `beginSyncPoint` and `endSyncPoint`, ie the point from
+    /// which a requester whose last sync point is `beginSyncPoint` can be
+    /// sent a patch up to `endSyncPoint` when `beginSyncPoint` is not one
+    /// of `spOffsetPairs`.  Return 0 on success, or a non-zero value if no
+    /// such sync point exists.  Behavior is undefined unless
+    /// `spOffsetPairs` is sorted.
+    static int
+    findDivergenceSyncPoint(bmqp_ctrlmsg::SyncPointOffsetPair* result,
+                            const SyncPointOffsetPairs&        spOffsetPairs,
+                            const bmqp_ctrlmsg::SyncPoint&     beginSyncPoint,
+                            const bmqp_ctrlmsg::SyncPoint&     endSyncPoint);
+
+    /// Load into the specified `journalOffset` the offset of the record of
+    /// the specified `syncPoint` in the journal file represented by the
+    /// specified `journalFd`.  Return 0 on success, or a non-zero value if
+    /// the journal does not contain `syncPoint`.
+    static int
+    findJournalSyncPoint(bsls::Types::Uint64*              journalOffset,
+                         const mqbs::MappedFileDescriptor& journalFd,
+                         const bmqp_ctrlmsg::SyncPoint&    syncPoint);
+
     // CREATORS
 
     /// Create a `RecoveryManager` object with the specified
@@ -1045,8 +1155,11 @@ class RecoveryManager : public mqbnet::ClusterObserver {
                                    mqbnet::ClusterNode*                source,
                                    const mqbs::FileStore*              fs);
 
-    /// Executed in the dispatcher thread associated with the specified
-    /// `partitionId`.
+    /// Verify the digest of each chunk of the recovery event in the
+    /// specified `blob` received from the specified `source`, and write the
+    /// chunks to the files of the specified `partitionId`, stopping the
+    /// recovery of `partitionId` on the first invalid chunk.  Executed in
+    /// the dispatcher thread associated with `partitionId`.
     void processRecoveryEvent(int                                 partitionId,
                               const bsl::shared_ptr<bdlbb::Blob>& blob,
                               mqbnet::ClusterNode*                source);
@@ -1273,11 +1386,14 @@ inline RecoveryManager_RecoveryContext::RecoveryManager_RecoveryContext(
 , d_inRecovery(false)
 , d_recoveryPeer_p(0)
 , d_responseType(bmqp_ctrlmsg::StorageSyncResponseType::E_UNDEFINED)
-, d_expectedChunkFileType(bmqp::RecoveryFileChunkType::e_UNDEFINED)
-, d_lastChunkSequenceNumber(0)
+, d_isReceivingChunks(false)
+, d_receivedFiles(0)
+, d_chunksStartTime(0)
+, d_numChunkBytes(0)
 , d_recoveryStartupWaitHandle()
 , d_recoveryStatusCheckHandle()
 {
+    bsl::fill_n(d_lastChunkSequenceNumbers, k_NUM_CHUNK_FILE_TYPES, 0U);
 }
 
 inline RecoveryManager_RecoveryContext::RecoveryManager_RecoveryContext(
@@ -1300,11 +1416,16 @@ inline RecoveryManager_RecoveryContext::RecoveryManager_RecoveryContext(
 , d_inRecovery(other.d_inRecovery)
 , d_recoveryPeer_p(other.d_recoveryPeer_p)
 , d_responseType(other.d_responseType)
-, d_expectedChunkFileType(other.d_expectedChunkFileType)
-, d_lastChunkSequenceNumber(other.d_lastChunkSequenceNumber)
+, d_isReceivingChunks(other.d_isReceivingChunks)
+, d_receivedFiles(other.d_receivedFiles)
+, d_chunksStartTime(other.d_chunksStartTime)
+, d_numChunkBytes(other.d_numChunkBytes)
 , d_recoveryStartupWaitHandle(other.d_recoveryStartupWaitHandle)
 , d_recoveryStatusCheckHandle(other.d_recoveryStatusCheckHandle)
 {
+    bsl::copy(other.d_lastChunkSequenceNumbers,
+              other.d_lastChunkSequenceNumbers + k_NUM_CHUNK_FILE_TYPES,
+              d_lastChunkSequenceNumbers);
 }
 
 // MANIPULATORS
@@ -1350,16 +1471,29 @@ inline void RecoveryManager_RecoveryContext::setResponseType(
     d_responseType = value;
 }
 
-inline void RecoveryManager_RecoveryContext::setExpectedChunkFileType(
-    bmqp::RecoveryFileChunkType::Enum value)
+inline void RecoveryManager_RecoveryContext::setLastChunkSequenceNumber(
+    bmqp::RecoveryFileChunkType::Enum type,
+    unsigned int                      value)
 {
-    d_expectedChunkFileType = value;
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(bmqp::RecoveryFileChunkType::e_UNDEFINED != type);
+
+    d_lastChunkSequenceNumbers[type] = value;
+}
+
+inline void RecoveryManager_RecoveryContext::setFileReceived(
+    bmqp::RecoveryFileChunkType::Enum type)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(bmqp::RecoveryFileChunkType::e_UNDEFINED != type);
+
+    d_receivedFiles |= 1 << type;
 }
 
 inline void
-RecoveryManager_RecoveryContext::setLastChunkSequenceNumber(unsigned int value)
+RecoveryManager_RecoveryContext::addChunkBytes(bsls::Types::Int64 value)
 {
-    d_lastChunkSequenceNumber = value;
+    d_numChunkBytes += value;
 }
 
 inline bdlmt::EventScheduler::EventHandle&
@@ -1528,16 +1662,46 @@ RecoveryManager_RecoveryContext::responseType() const
     return d_responseType;
 }
 
-inline bmqp::RecoveryFileChunkType::Enum
-RecoveryManager_RecoveryContext::expectedChunkFileType() const
+inline bool RecoveryManager_RecoveryContext::isReceivingChunks() const
+{
+    return d_isReceivingChunks;
+}
+
+inline unsigned int RecoveryManager_RecoveryContext::lastChunkSequenceNumber(
+    bmqp::RecoveryFileChunkType::Enum type) const
 {
-    return d_expectedChunkFileType;
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(bmqp::RecoveryFileChunkType::e_UNDEFINED != type);
+
+    return d_lastChunkSequenceNumbers[type];
 }
 
-inline unsigned int
-RecoveryManager_RecoveryContext::lastChunkSequenceNumber() const
+inline bool RecoveryManager_RecoveryContext::isFileReceived(
+    bmqp::RecoveryFileChunkType::Enum type) const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(bmqp::RecoveryFileChunkType::e_UNDEFINED != type);
+
+    return d_receivedFiles & (1 << type);
+}
+
+inline bool RecoveryManager_RecoveryContext::areAllFilesReceived() const
+{
+    return isFileReceived(bmqp::RecoveryFileChunkType::e_DATA) &&
+           isFileReceived(bmqp::RecoveryFileChunkType::e_QLIST) &&
+           isFileReceived(bmqp::RecoveryFileChunkType::e_JOURNAL);
+}
+
+inline bsls::Types::Int64
+RecoveryManager_RecoveryContext::chunksStartTime() const
+{
+    return d_chunksStartTime;
+}
+
+inline bsls::Types::Int64
+RecoveryManager_RecoveryContext::numChunkBytes() const
 {
-    return d_lastChunkSequenceNumber;
+    return d_numChunkBytes;
 }
 
 inline const bsl::vector<bsl::shared_ptr<bdlbb::Blob> >&
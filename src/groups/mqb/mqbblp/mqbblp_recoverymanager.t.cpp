@@ -0,0 +1,538 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// mqbblp_recoverymanager.t.cpp                                       -*-C++-*-
+#include <mqbblp_recoverymanager.h>
+
+// MQB
+#include <mqbs_filestore.h>
+#include <mqbs_filestoreprotocol.h>
+#include <mqbs_mappedfiledescriptor.h>
+#include <mqbs_memoryblock.h>
+#include <mqbs_offsetptr.h>
+
+// BMQ
+#include <bmqp_ctrlmsg_messages.h>
+#include <bmqp_event.h>
+#include <bmqp_protocol.h>
+#include <bmqp_recoveryeventbuilder.h>
+#include <bmqp_recoverymessageiterator.h>
+
+// MWC
+#include <mwcu_memoutstream.h>
+
+// BDE
+#include <bdlbb_blob.h>
+#include <bdlbb_pooledblobbufferfactory.h>
+#include <bsl_cstring.h>
+#include <bsl_memory.h>
+#include <bsl_vector.h>
+#include <bsls_types.h>
+
+// TEST DRIVER
+#include <mwctst_testhelper.h>
+
+// CONVENIENCE
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                            TEST HELPERS UTILITY
+// ----------------------------------------------------------------------------
+namespace {
+
+/// Return a blob buffer aliasing the specified null-terminated `chunk`.
+bdlbb::BlobBuffer chunkBuffer(const char* chunk)
+{
+    bsl::shared_ptr<char> chunkSp(const_cast<char*>(chunk),
+                                  bslstl::SharedPtrNilDeleter());
+    return bdlbb::BlobBuffer(chunkSp, bsl::strlen(chunk));
+}
+
+/// Return a (sync-point, offset) pair having the specified
+/// `primaryLeaseId`, `sequenceNum` and journal `offset`.
+bmqp_ctrlmsg::SyncPointOffsetPair
+syncPointOffsetPair(unsigned int        primaryLeaseId,
+                    bsls::Types::Uint64 sequenceNum,
+                    bsls::Types::Uint64 offset)
+{
+    bmqp_ctrlmsg::SyncPointOffsetPair spOffsetPair;
+    spOffsetPair.syncPoint().primaryLeaseId() = primaryLeaseId;
+    spOffsetPair.syncPoint().sequenceNum()    = sequenceNum;
+    spOffsetPair.offset()                     = offset;
+    return spOffsetPair;
+}
+
+/// Number of records of the journal written by `writeJournal`.
+const unsigned int k_NUM_JOURNAL_RECORDS = 8;
+
+/// Size of the headers of the journal written by `writeJournal`.
+const bsls::Types::Uint64 k_JOURNAL_HEADERS_SIZE =
+    sizeof(mqbs::FileHeader) + sizeof(mqbs::JournalFileHeader);
+
+/// Return the sync point of the record at the specified `index` in the
+/// journal written by `writeJournal`.
+bmqp_ctrlmsg::SyncPoint journalSyncPoint(unsigned int index)
+{
+    bmqp_ctrlmsg::SyncPoint syncPoint;
+    syncPoint.primaryLeaseId()       = 1;
+    syncPoint.sequenceNum()          = index + 1;
+    syncPoint.dataFileOffsetDwords() = 100 * (index + 1);
+    syncPoint.qlistFileOffsetWords() = 10 * (index + 1);
+    return syncPoint;
+}
+
+/// Return the offset of the record at the specified `index` in the journal
+/// written by `writeJournal`.
+bsls::Types::Uint64 journalRecordOffset(unsigned int index)
+{
+    return k_JOURNAL_HEADERS_SIZE +
+           index * mqbs::FileStoreProtocol::k_JOURNAL_RECORD_SIZE;
+}
+
+/// Write into the specified `buffer` a journal of `k_NUM_JOURNAL_RECORDS`
+/// records of primary lease 1, whose records at an index multiple of 3 are
+/// sync points (see `journalSyncPoint`) and the other ones are messages,
+/// and load into the specified `journalFd` a descriptor mapping it.
+void writeJournal(mqbs::MappedFileDescriptor* journalFd,
+                  bsl::vector<char>*          buffer)
+{
+    buffer->resize(journalRecordOffset(k_NUM_JOURNAL_RECORDS));
+    mqbs::MemoryBlock block(buffer->data(), buffer->size());
+
+    new (mqbs::OffsetPtr<mqbs::FileHeader>(block, 0).get())
+        mqbs::FileHeader();
+    new (mqbs::OffsetPtr<mqbs::JournalFileHeader>(block,
+                                                  sizeof(mqbs::FileHeader))
+             .get()) mqbs::JournalFileHeader();
+
+    for (unsigned int i = 0; i < k_NUM_JOURNAL_RECORDS; ++i) {
+        const bsls::Types::Uint64 offset = journalRecordOffset(i);
+
+        if (0 == i % 3) {
+            const bmqp_ctrlmsg::SyncPoint sp = journalSyncPoint(i);
+
+            mqbs::OffsetPtr<mqbs::JournalOpRecord> rec(block, offset);
+            new (rec.get())
+                mqbs::JournalOpRecord(mqbs::JournalOpType::e_SYNCPOINT,
+                                      mqbs::SyncPointType::e_REGULAR,
+                                      sp.sequenceNum(),
+                                      1,  // primaryNodeId
+                                      sp.primaryLeaseId(),
+                                      sp.dataFileOffsetDwords(),
+                                      sp.qlistFileOffsetWords(),
+                                      mqbs::RecordHeader::k_MAGIC);
+            rec->header().setPrimaryLeaseId(1).setSequenceNumber(i + 1);
+        }
+        else {
+            mqbs::OffsetPtr<mqbs::MessageRecord> rec(block, offset);
+            new (rec.get()) mqbs::MessageRecord();
+            rec->header().setPrimaryLeaseId(1).setSequenceNumber(i + 1);
+            rec->setRefCount(1).setMagic(mqbs::RecordHeader::k_MAGIC);
+        }
+    }
+
+    journalFd->setFd(-1);  // invalid fd will suffice
+    journalFd->setBlock(block);
+    journalFd->setFileSize(buffer->size());
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                                    TESTS
+// ----------------------------------------------------------------------------
+
+static void test1_verifyChunkDigest()
+// ------------------------------------------------------------------------
+// VERIFY CHUNK DIGEST
+//
+// Concerns:
+//   - The digest of a chunk packed with its MD5 digest is verified.
+//   - An empty chunk, which carries no digest, is verified.
+//   - A chunk whose digest does not match its content is rejected, and the
+//     error description is populated.
+//
+// Testing:
+//   RecoveryManager::verifyChunkDigest
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("VERIFY CHUNK DIGEST");
+
+    // Note that chunks must be word aligned per RecoveryEventBuilder's
+    // contract.
+    const char* k_DATA    = "abcdefghijklmnopqrstuvwx";
+    const char* k_JOURNAL = "0123456789012345";
+
+    bdlbb::PooledBlobBufferFactory bufferFactory(1024, s_allocator_p);
+    bmqp::RecoveryEventBuilder     builder(&bufferFactory, s_allocator_p);
+
+    ASSERT_EQ(bmqt::EventBuilderResult::e_SUCCESS,
+              builder.packMessage(1,  // partitionId
+                                  bmqp::RecoveryFileChunkType::e_DATA,
+                                  1,  // sequenceNumber
+                                  chunkBuffer(k_DATA),
+                                  true));  // isFinal
+    ASSERT_EQ(bmqt::EventBuilderResult::e_SUCCESS,
+              builder.packMessage(1,  // partitionId
+                                  bmqp::RecoveryFileChunkType::e_QLIST,
+                                  1,  // sequenceNumber
+                                  chunkBuffer(""),
+                                  true));  // isFinal
+    ASSERT_EQ(bmqt::EventBuilderResult::e_SUCCESS,
+              builder.packMessage(1,  // partitionId
+                                  bmqp::RecoveryFileChunkType::e_JOURNAL,
+                                  1,  // sequenceNumber
+                                  chunkBuffer(k_JOURNAL),
+                                  true,    // isFinal
+                                  false));  // isSetMd5
+
+    bmqp::Event rawEvent(&builder.blob(), s_allocator_p);
+    ASSERT(rawEvent.isRecoveryEvent());
+
+    bmqp::RecoveryMessageIterator iter;
+    rawEvent.loadRecoveryMessageIterator(&iter);
+    ASSERT(iter.isValid());
+
+    PV("Chunk with a valid digest");
+    {
+        mwcu::MemOutStream errorDesc(s_allocator_p);
+        ASSERT_EQ(iter.next(), 1);
+        ASSERT_EQ(mqbblp::RecoveryManager::verifyChunkDigest(errorDesc,
+                                                             builder.blob(),
+                                                             iter),
+                  0);
+        ASSERT(errorDesc.str().empty());
+    }
+
+    PV("Empty chunk");
+    {
+        mwcu::MemOutStream errorDesc(s_allocator_p);
+        ASSERT_EQ(iter.next(), 1);
+        ASSERT_EQ(mqbblp::RecoveryManager::verifyChunkDigest(errorDesc,
+                                                             builder.blob(),
+                                                             iter),
+                  0);
+        ASSERT(errorDesc.str().empty());
+    }
+
+    PV("Chunk with a mismatching digest");
+    {
+        mwcu::MemOutStream errorDesc(s_allocator_p);
+        ASSERT_EQ(iter.next(), 1);
+        ASSERT_NE(mqbblp::RecoveryManager::verifyChunkDigest(errorDesc,
+                                                             builder.blob(),
+                                                             iter),
+                  0);
+        ASSERT(!errorDesc.str().empty());
+    }
+
+    ASSERT_EQ(iter.next(), 0);
+}
+
+static void test2_recoveryContextInterleavedChunks()
+// ------------------------------------------------------------------------
+// RECOVERY CONTEXT INTERLEAVED CHUNKS
+//
+// Concerns:
+//   - The sequence numbers of the chunks of each file are tracked
+//     independently, so that the chunks of the different files can be
+//     interleaved.
+//   - All the files are received only once the final chunk of each of the
+//     DATA, QLIST and JOURNAL files has been received.
+//   - 'clear' resets the state of the chunks.
+//
+// Testing:
+//   RecoveryManager_RecoveryContext::startReceivingChunks
+//   RecoveryManager_RecoveryContext::setLastChunkSequenceNumber
+//   RecoveryManager_RecoveryContext::setFileReceived
+//   RecoveryManager_RecoveryContext::areAllFilesReceived
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("RECOVERY CONTEXT INTERLEAVED CHUNKS");
+
+    typedef bmqp::RecoveryFileChunkType ChunkType;
+
+    mqbblp::RecoveryManager_RecoveryContext obj(s_allocator_p);
+    ASSERT(!obj.isReceivingChunks());
+
+    obj.startReceivingChunks();
+    ASSERT(obj.isReceivingChunks());
+    ASSERT_EQ(obj.numChunkBytes(), 0);
+    ASSERT_EQ(obj.lastChunkSequenceNumber(ChunkType::e_DATA), 0U);
+    ASSERT_EQ(obj.lastChunkSequenceNumber(ChunkType::e_QLIST), 0U);
+    ASSERT_EQ(obj.lastChunkSequenceNumber(ChunkType::e_JOURNAL), 0U);
+
+    // DATA, JOURNAL, DATA, QLIST (final), DATA (final), JOURNAL (final)
+
+    obj.setLastChunkSequenceNumber(ChunkType::e_DATA, 1);
+    obj.setLastChunkSequenceNumber(ChunkType::e_JOURNAL, 1);
+    obj.setLastChunkSequenceNumber(ChunkType::e_DATA, 2);
+    ASSERT_EQ(obj.lastChunkSequenceNumber(ChunkType::e_DATA), 2U);
+    ASSERT_EQ(obj.lastChunkSequenceNumber(ChunkType::e_QLIST), 0U);
+    ASSERT_EQ(obj.lastChunkSequenceNumber(ChunkType::e_JOURNAL), 1U);
+
+    obj.setLastChunkSequenceNumber(ChunkType::e_QLIST, 1);
+    obj.setFileReceived(ChunkType::e_QLIST);
+    ASSERT(obj.isFileReceived(ChunkType::e_QLIST));
+    ASSERT(!obj.isFileReceived(ChunkType::e_DATA));
+    ASSERT(!obj.areAllFilesReceived());
+
+    obj.setLastChunkSequenceNumber(ChunkType::e_DATA, 3);
+    obj.setFileReceived(ChunkType::e_DATA);
+    ASSERT(!obj.areAllFilesReceived());
+
+    obj.setLastChunkSequenceNumber(ChunkType::e_JOURNAL, 2);
+    obj.setFileReceived(ChunkType::e_JOURNAL);
+    ASSERT(obj.areAllFilesReceived());
+
+    obj.addChunkBytes(100);
+    obj.addChunkBytes(28);
+    ASSERT_EQ(obj.numChunkBytes(), 128);
+
+    PV("Copy");
+    {
+        mqbblp::RecoveryManager_RecoveryContext copy(obj, s_allocator_p);
+        ASSERT(copy.areAllFilesReceived());
+        ASSERT_EQ(copy.lastChunkSequenceNumber(ChunkType::e_DATA), 3U);
+        ASSERT_EQ(copy.lastChunkSequenceNumber(ChunkType::e_JOURNAL), 2U);
+        ASSERT_EQ(copy.numChunkBytes(), 128);
+    }
+
+    PV("Clear");
+    obj.clear();
+    ASSERT(!obj.isReceivingChunks());
+    ASSERT(!obj.isFileReceived(ChunkType::e_DATA));
+    ASSERT(!obj.areAllFilesReceived());
+    ASSERT_EQ(obj.lastChunkSequenceNumber(ChunkType::e_DATA), 0U);
+    ASSERT_EQ(obj.numChunkBytes(), 0);
+}
+
+static void test3_findDivergenceSyncPoint()
+// ------------------------------------------------------------------------
+// FIND DIVERGENCE SYNC POINT
+//
+// Concerns:
+//   - The divergence sync point is the last sync point strictly preceding
+//     both the begin and the end sync points.
+//   - Journal offsets are ignored when comparing sync points.
+//   - No divergence sync point is found if all the sync points are at or
+//     after the begin sync point, ie the journal rolled over.
+//
+// Testing:
+//   RecoveryManager::findDivergenceSyncPoint
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("FIND DIVERGENCE SYNC POINT");
+
+    typedef mqbs::FileStore::SyncPointOffsetPairs SyncPointOffsetPairs;
+
+    SyncPointOffsetPairs spOffsetPairs(s_allocator_p);
+    spOffsetPairs.push_back(syncPointOffsetPair(1, 10, 100));
+    spOffsetPairs.push_back(syncPointOffsetPair(1, 20, 200));
+    spOffsetPairs.push_back(syncPointOffsetPair(2, 1, 300));
+    spOffsetPairs.push_back(syncPointOffsetPair(2, 2, 400));
+
+    const bmqp_ctrlmsg::SyncPoint& y = spOffsetPairs.back().syncPoint();
+    bmqp_ctrlmsg::SyncPointOffsetPair result;
+
+    PV("Begin sync point unknown, between two sync points");
+    ASSERT_EQ(mqbblp::RecoveryManager::findDivergenceSyncPoint(
+                  &result,
+                  spOffsetPairs,
+                  syncPointOffsetPair(1, 25, 250).syncPoint(),
+                  y),
+              0);
+    ASSERT_EQ(result, spOffsetPairs[1]);
+
+    PV("Begin sync point of an unknown lease, ahead of the end sync point");
+    ASSERT_EQ(mqbblp::RecoveryManager::findDivergenceSyncPoint(
+                  &result,
+                  spOffsetPairs,
+                  syncPointOffsetPair(3, 5, 900).syncPoint(),
+                  y),
+              0);
+    ASSERT_EQ(result, spOffsetPairs[2]);
+
+    PV("Begin sync point known at another journal offset");
+    ASSERT_EQ(mqbblp::RecoveryManager::findDivergenceSyncPoint(
+                  &result,
+                  spOffsetPairs,
+                  spOffsetPairs[2].syncPoint(),
+                  y),
+              0);
+    ASSERT_EQ(result, spOffsetPairs[1]);
+
+    PV("Journal rolled over");
+    ASSERT_NE(mqbblp::RecoveryManager::findDivergenceSyncPoint(
+                  &result,
+                  spOffsetPairs,
+                  syncPointOffsetPair(1, 5, 50).syncPoint(),
+                  y),
+              0);
+    ASSERT_NE(mqbblp::RecoveryManager::findDivergenceSyncPoint(
+                  &result,
+                  spOffsetPairs,
+                  spOffsetPairs.front().syncPoint(),
+                  y),
+              0);
+}
+
+static void test4_findJournalSyncPoint()
+// ------------------------------------------------------------------------
+// FIND JOURNAL SYNC POINT
+//
+// Concerns:
+//   - The offset of each sync point of the journal is found, whether it is
+//     the last record, the last sync point or the first record.
+//   - A sync point which is not in the journal is not found, whether it
+//     falls between two sync points of the journal or after the last one.
+//   - A sync point is only found if all its fields match.
+//
+// Testing:
+//   RecoveryManager::findJournalSyncPoint
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("FIND JOURNAL SYNC POINT");
+
+    bsl::vector<char>          buffer(s_allocator_p);
+    mqbs::MappedFileDescriptor journalFd;
+    writeJournal(&journalFd, &buffer);
+
+    PV("Sync points of the journal");
+    for (unsigned int i = 0; i < k_NUM_JOURNAL_RECORDS; i += 3) {
+        bsls::Types::Uint64 offset = 0;
+        ASSERT_EQ_D(i,
+                    mqbblp::RecoveryManager::findJournalSyncPoint(
+                        &offset,
+                        journalFd,
+                        journalSyncPoint(i)),
+                    0);
+        ASSERT_EQ_D(i, offset, journalRecordOffset(i));
+    }
+
+    PV("Sync points not in the journal");
+    {
+        bsls::Types::Uint64 offset = 0;
+
+        // Between the sync points of records 3 and 6.
+        ASSERT_NE(mqbblp::RecoveryManager::findJournalSyncPoint(
+                      &offset,
+                      journalFd,
+                      journalSyncPoint(4)),
+                  0);
+
+        // After the last sync point, and after the last record.
+        ASSERT_NE(mqbblp::RecoveryManager::findJournalSyncPoint(
+                      &offset,
+                      journalFd,
+                      journalSyncPoint(7)),
+                  0);
+        ASSERT_NE(mqbblp::RecoveryManager::findJournalSyncPoint(
+                      &offset,
+                      journalFd,
+                      journalSyncPoint(k_NUM_JOURNAL_RECORDS)),
+                  0);
+
+        // Same lease and sequence number, different offsets.
+        bmqp_ctrlmsg::SyncPoint sp = journalSyncPoint(3);
+        ++sp.dataFileOffsetDwords();
+        ASSERT_NE(mqbblp::RecoveryManager::findJournalSyncPoint(&offset,
+                                                                journalFd,
+                                                                sp),
+                  0);
+
+        ASSERT_EQ(offset, 0ULL);
+    }
+}
+
+static void test5_recoveryContextRewindToSyncPoint()
+// ------------------------------------------------------------------------
+// RECOVERY CONTEXT REWIND TO SYNC POINT
+//
+// Concerns:
+//   - A requester whose 'A' sync point diverges from the peer's history
+//     rewinds to the sync point the peer's patch starts from, as found in
+//     its journal: that sync point becomes the old sync point, and the
+//     next chunks of the journal, data and qlist files are written right
+//     after it, overwriting the diverged records.
+//
+// Testing:
+//   RecoveryManager_RecoveryContext::rewindToSyncPoint
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("RECOVERY CONTEXT REWIND TO SYNC POINT");
+
+    bsl::vector<char>          buffer(s_allocator_p);
+    mqbs::MappedFileDescriptor journalFd;
+    writeJournal(&journalFd, &buffer);
+
+    // The requester's 'A' sync point is the last one of its journal.
+
+    const bmqp_ctrlmsg::SyncPoint oldSp = journalSyncPoint(6);
+
+    mqbblp::RecoveryManager_RecoveryContext obj(s_allocator_p);
+    obj.setOldSyncPoint(oldSp);
+    obj.setOldSyncPointOffset(journalRecordOffset(6));
+    obj.setJournalFileOffset(buffer.size());
+    obj.setDataFileOffset(oldSp.dataFileOffsetDwords() *
+                          bmqp::Protocol::k_DWORD_SIZE);
+    obj.setQlistFileOffset(oldSp.qlistFileOffsetWords() *
+                           bmqp::Protocol::k_WORD_SIZE);
+
+    // The peer's patch starts from an earlier sync point.
+
+    const bmqp_ctrlmsg::SyncPoint beginSp = journalSyncPoint(3);
+    ASSERT(beginSp < oldSp);
+
+    bsls::Types::Uint64 offset = 0;
+    ASSERT_EQ(mqbblp::RecoveryManager::findJournalSyncPoint(&offset,
+                                                            journalFd,
+                                                            beginSp),
+              0);
+
+    obj.rewindToSyncPoint(beginSp, offset);
+    ASSERT_EQ(obj.oldSyncPoint(), beginSp);
+    ASSERT_EQ(obj.oldSyncPointOffset(), journalRecordOffset(3));
+    ASSERT_EQ(obj.journalFileOffset(), journalRecordOffset(4));
+    ASSERT_EQ(obj.dataFileOffset(),
+              beginSp.dataFileOffsetDwords() * bmqp::Protocol::k_DWORD_SIZE);
+    ASSERT_EQ(obj.qlistFileOffset(),
+              beginSp.qlistFileOffsetWords() * bmqp::Protocol::k_WORD_SIZE);
+}
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    TEST_PROLOG(mwctst::TestHelper::e_DEFAULT);
+
+    switch (_testCase) {
+    case 0:
+    case 5: test5_recoveryContextRewindToSyncPoint(); break;
+    case 4: test4_findJournalSyncPoint(); break;
+    case 3: test3_findDivergenceSyncPoint(); break;
+    case 2: test2_recoveryContextInterleavedChunks(); break;
+    case 1: test1_verifyChunkDigest(); break;
+    default: {
+        cerr << "WARNING: CASE '" << _testCase << "' NOT FOUND." << endl;
+        s_testStatus = -1;
+    } break;
+    }
+
+    TEST_EPILOG(mwctst::TestHelper::e_CHECK_DEF_GBL_ALLOC);
+}
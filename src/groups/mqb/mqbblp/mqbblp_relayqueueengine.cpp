@@ -572,6 +572,13 @@ void RelayQueueEngine::deliverMessages()
 
     QueueEngineUtil_AppsDeliveryContext context(d_queueState_p->queue(),
                                                 d_allocator_p);
+
+    // The storage may have been modified since the storage iterators were
+    // last moved.  Resynchronize them once, before the delivery loop.
+    for (AppsMap::iterator it = d_apps.begin(); it != d_apps.end(); ++it) {
+        it->second->d_storageIter_mp->resume();
+    }
+
     while (context.d_doRepeat) {
         context.reset();
 
@@ -32,6 +32,7 @@
 #include <mqbu_storagekey.h>
 
 // BMQ
+#include <bmqp_messagetrace.h>
 #include <bmqp_protocol.h>
 #include <bmqt_messageguid.h>
 #include <bmqt_queueflags.h>
@@ -1020,6 +1021,9 @@ void RemoteQueue::postMessage(const bmqp::PutHeader&              putHeaderIn,
 
     if (ctx.d_state == SubStreamContext::e_OPENED) {
         sendPutMessage(putHeader, appData, options, state, ctx.d_genCount);
+        bmqp::MessageTraceUtil::recordHop(
+            putHeader.messageGUID(),
+            bmqp::MessageTraceHop::e_BROKER_PUT_OUT);
     }
 
     // Update the domain's PUT stats (note that ideally this should be done at
@@ -1153,6 +1153,12 @@ void RootQueueEngine::afterNewMessage(
     QueueEngineUtil_AppsDeliveryContext context(d_queueState_p->queue(),
                                                 d_allocator_p);
 
+    // The storage may have been modified since the storage iterators were
+    // last moved.  Resynchronize them once, before the delivery loop.
+    for (Apps::iterator iter = d_apps.begin(); iter != d_apps.end(); ++iter) {
+        iter->value()->d_storageIter_mp->resume();
+    }
+
     while (context.d_doRepeat) {
         context.reset();
 
@@ -1633,6 +1639,7 @@ void RootQueueEngine::loadInternals(mqbcmd::QueueEngine* out) const
         consumerState.appId()                = iter->key1();
 
         if (d_queueState_p->storage()->hasVirtualStorage(iter->key1())) {
+            iter->value()->d_storageIter_mp->resume();
             consumerState.isAtEndOfStorage().makeValue(
                 iter->value()->d_storageIter_mp->atEnd());
             consumerState.status() = (!iter->value()->hasConsumers()
@@ -1252,6 +1252,8 @@ int StorageUtil::assignPartitionDispatcherThreads(
             .setBufferFactory(clusterData->bufferFactory())
             .setPreallocate(config.preallocate())
             .setPrefaultPages(config.prefaultPages())
+            .setDedicatedIoThread(config.dedicatedIoThreads())
+            .setIoThreadSyncIntervalMs(config.ioThreadSyncIntervalMs())
             .setLocation(config.location())
             .setArchiveLocation(config.archiveLocation())
             .setNodeId(clusterData->membership().selfNode()->nodeId())
@@ -2573,6 +2575,12 @@ void StorageUtil::processReplicaStatusAdvisoryDispatched(
     BSLS_ASSERT_SAFE(fs);
     BSLS_ASSERT_SAFE(0 <= partitionId);
 
+    if (bmqp_ctrlmsg::NodeStatus::E_UNAVAILABLE == status) {
+        // Replica has gone down.  Stop tracking its Receipts.
+        fs->processNodeUnavailable(source->nodeId());
+        return;  // RETURN
+    }
+
     // If self is *active* primary, force-issue a syncPt.
     BSLS_ASSERT_SAFE(pinfo.primary() == clusterData->membership().selfNode());
     if (bmqp_ctrlmsg::PrimaryStatus::E_ACTIVE == pinfo.primaryStatus()) {
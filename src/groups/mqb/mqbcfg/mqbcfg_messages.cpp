@@ -4367,6 +4367,12 @@ const bool PartitionConfig::DEFAULT_INITIALIZER_PREFAULT_PAGES = false;
 
 const bool PartitionConfig::DEFAULT_INITIALIZER_FLUSH_AT_SHUTDOWN = true;
 
+const bool PartitionConfig::DEFAULT_INITIALIZER_COMPRESS_REMOTE_REPLICATION = false;
+
+const bool PartitionConfig::DEFAULT_INITIALIZER_DEDICATED_IO_THREADS = false;
+
+const int PartitionConfig::DEFAULT_INITIALIZER_IO_THREAD_SYNC_INTERVAL_MS = 0;
+
 const bdlat_AttributeInfo PartitionConfig::ATTRIBUTE_INFO_ARRAY[] = {
     {
         ATTRIBUTE_ID_NUM_PARTITIONS,
@@ -4444,6 +4450,27 @@ const bdlat_AttributeInfo PartitionConfig::ATTRIBUTE_INFO_ARRAY[] = {
         sizeof("syncConfig") - 1,
         "",
         bdlat_FormattingMode::e_DEFAULT
+    },
+    {
+        ATTRIBUTE_ID_COMPRESS_REMOTE_REPLICATION,
+        "compressRemoteReplication",
+        sizeof("compressRemoteReplication") - 1,
+        "",
+        bdlat_FormattingMode::e_TEXT
+    },
+    {
+        ATTRIBUTE_ID_DEDICATED_IO_THREADS,
+        "dedicatedIoThreads",
+        sizeof("dedicatedIoThreads") - 1,
+        "",
+        bdlat_FormattingMode::e_TEXT
+    },
+    {
+        ATTRIBUTE_ID_IO_THREAD_SYNC_INTERVAL_MS,
+        "ioThreadSyncIntervalMs",
+        sizeof("ioThreadSyncIntervalMs") - 1,
+        "",
+        bdlat_FormattingMode::e_DEC
     }
 };
 
@@ -4453,7 +4480,7 @@ const bdlat_AttributeInfo *PartitionConfig::lookupAttributeInfo(
         const char *name,
         int         nameLength)
 {
-    for (int i = 0; i < 11; ++i) {
+    for (int i = 0; i < 14; ++i) {
         const bdlat_AttributeInfo& attributeInfo =
                     PartitionConfig::ATTRIBUTE_INFO_ARRAY[i];
 
@@ -4492,6 +4519,12 @@ const bdlat_AttributeInfo *PartitionConfig::lookupAttributeInfo(int id)
         return &ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_FLUSH_AT_SHUTDOWN];
       case ATTRIBUTE_ID_SYNC_CONFIG:
         return &ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_SYNC_CONFIG];
+      case ATTRIBUTE_ID_COMPRESS_REMOTE_REPLICATION:
+        return &ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_COMPRESS_REMOTE_REPLICATION];
+      case ATTRIBUTE_ID_DEDICATED_IO_THREADS:
+        return &ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_DEDICATED_IO_THREADS];
+      case ATTRIBUTE_ID_IO_THREAD_SYNC_INTERVAL_MS:
+        return &ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_IO_THREAD_SYNC_INTERVAL_MS];
       default:
         return 0;
     }
@@ -4508,9 +4541,12 @@ PartitionConfig::PartitionConfig(bslma::Allocator *basicAllocator)
 , d_syncConfig()
 , d_numPartitions()
 , d_maxArchivedFileSets()
+, d_ioThreadSyncIntervalMs(DEFAULT_INITIALIZER_IO_THREAD_SYNC_INTERVAL_MS)
 , d_preallocate(DEFAULT_INITIALIZER_PREALLOCATE)
 , d_prefaultPages(DEFAULT_INITIALIZER_PREFAULT_PAGES)
 , d_flushAtShutdown(DEFAULT_INITIALIZER_FLUSH_AT_SHUTDOWN)
+, d_compressRemoteReplication(DEFAULT_INITIALIZER_COMPRESS_REMOTE_REPLICATION)
+, d_dedicatedIoThreads(DEFAULT_INITIALIZER_DEDICATED_IO_THREADS)
 {
 }
 
@@ -4524,9 +4560,12 @@ PartitionConfig::PartitionConfig(const PartitionConfig& original,
 , d_syncConfig(original.d_syncConfig)
 , d_numPartitions(original.d_numPartitions)
 , d_maxArchivedFileSets(original.d_maxArchivedFileSets)
+, d_ioThreadSyncIntervalMs(original.d_ioThreadSyncIntervalMs)
 , d_preallocate(original.d_preallocate)
 , d_prefaultPages(original.d_prefaultPages)
 , d_flushAtShutdown(original.d_flushAtShutdown)
+, d_compressRemoteReplication(original.d_compressRemoteReplication)
+, d_dedicatedIoThreads(original.d_dedicatedIoThreads)
 {
 }
 
@@ -4541,9 +4580,12 @@ PartitionConfig::PartitionConfig(PartitionConfig&& original) noexcept
 , d_syncConfig(bsl::move(original.d_syncConfig))
 , d_numPartitions(bsl::move(original.d_numPartitions))
 , d_maxArchivedFileSets(bsl::move(original.d_maxArchivedFileSets))
+, d_ioThreadSyncIntervalMs(bsl::move(original.d_ioThreadSyncIntervalMs))
 , d_preallocate(bsl::move(original.d_preallocate))
 , d_prefaultPages(bsl::move(original.d_prefaultPages))
 , d_flushAtShutdown(bsl::move(original.d_flushAtShutdown))
+, d_compressRemoteReplication(bsl::move(original.d_compressRemoteReplication))
+, d_dedicatedIoThreads(bsl::move(original.d_dedicatedIoThreads))
 {
 }
 
@@ -4557,9 +4599,12 @@ PartitionConfig::PartitionConfig(PartitionConfig&& original,
 , d_syncConfig(bsl::move(original.d_syncConfig))
 , d_numPartitions(bsl::move(original.d_numPartitions))
 , d_maxArchivedFileSets(bsl::move(original.d_maxArchivedFileSets))
+, d_ioThreadSyncIntervalMs(bsl::move(original.d_ioThreadSyncIntervalMs))
 , d_preallocate(bsl::move(original.d_preallocate))
 , d_prefaultPages(bsl::move(original.d_prefaultPages))
 , d_flushAtShutdown(bsl::move(original.d_flushAtShutdown))
+, d_compressRemoteReplication(bsl::move(original.d_compressRemoteReplication))
+, d_dedicatedIoThreads(bsl::move(original.d_dedicatedIoThreads))
 {
 }
 #endif
@@ -4585,6 +4630,9 @@ PartitionConfig::operator=(const PartitionConfig& rhs)
         d_prefaultPages = rhs.d_prefaultPages;
         d_flushAtShutdown = rhs.d_flushAtShutdown;
         d_syncConfig = rhs.d_syncConfig;
+        d_compressRemoteReplication = rhs.d_compressRemoteReplication;
+        d_dedicatedIoThreads = rhs.d_dedicatedIoThreads;
+        d_ioThreadSyncIntervalMs = rhs.d_ioThreadSyncIntervalMs;
     }
 
     return *this;
@@ -4607,6 +4655,9 @@ PartitionConfig::operator=(PartitionConfig&& rhs)
         d_prefaultPages = bsl::move(rhs.d_prefaultPages);
         d_flushAtShutdown = bsl::move(rhs.d_flushAtShutdown);
         d_syncConfig = bsl::move(rhs.d_syncConfig);
+        d_compressRemoteReplication = bsl::move(rhs.d_compressRemoteReplication);
+        d_dedicatedIoThreads = bsl::move(rhs.d_dedicatedIoThreads);
+        d_ioThreadSyncIntervalMs = bsl::move(rhs.d_ioThreadSyncIntervalMs);
     }
 
     return *this;
@@ -4626,6 +4677,9 @@ void PartitionConfig::reset()
     d_prefaultPages = DEFAULT_INITIALIZER_PREFAULT_PAGES;
     d_flushAtShutdown = DEFAULT_INITIALIZER_FLUSH_AT_SHUTDOWN;
     bdlat_ValueTypeFunctions::reset(&d_syncConfig);
+    d_compressRemoteReplication = DEFAULT_INITIALIZER_COMPRESS_REMOTE_REPLICATION;
+    d_dedicatedIoThreads = DEFAULT_INITIALIZER_DEDICATED_IO_THREADS;
+    d_ioThreadSyncIntervalMs = DEFAULT_INITIALIZER_IO_THREAD_SYNC_INTERVAL_MS;
 }
 
 // ACCESSORS
@@ -4648,6 +4702,9 @@ bsl::ostream& PartitionConfig::print(
     printer.printAttribute("prefaultPages", this->prefaultPages());
     printer.printAttribute("flushAtShutdown", this->flushAtShutdown());
     printer.printAttribute("syncConfig", this->syncConfig());
+    printer.printAttribute("compressRemoteReplication", this->compressRemoteReplication());
+    printer.printAttribute("dedicatedIoThreads", this->dedicatedIoThreads());
+    printer.printAttribute("ioThreadSyncIntervalMs", this->ioThreadSyncIntervalMs());
     printer.end();
     return stream;
 }
@@ -4664,6 +4721,10 @@ const char StatsConfig::CLASS_NAME[] = "StatsConfig";
 
 const int StatsConfig::DEFAULT_INITIALIZER_SNAPSHOT_INTERVAL = 1;
 
+const char StatsConfig::DEFAULT_INITIALIZER_EXPORT_PATH[] = "";
+
+const int StatsConfig::DEFAULT_INITIALIZER_MESSAGE_TRACE_SAMPLING_PERIOD = 0;
+
 const bdlat_AttributeInfo StatsConfig::ATTRIBUTE_INFO_ARRAY[] = {
     {
         ATTRIBUTE_ID_SNAPSHOT_INTERVAL,
@@ -4685,6 +4746,20 @@ const bdlat_AttributeInfo StatsConfig::ATTRIBUTE_INFO_ARRAY[] = {
         sizeof("printer") - 1,
         "",
         bdlat_FormattingMode::e_DEFAULT
+    },
+    {
+        ATTRIBUTE_ID_EXPORT_PATH,
+        "exportPath",
+        sizeof("exportPath") - 1,
+        "",
+        bdlat_FormattingMode::e_TEXT
+    },
+    {
+        ATTRIBUTE_ID_MESSAGE_TRACE_SAMPLING_PERIOD,
+        "messageTraceSamplingPeriod",
+        sizeof("messageTraceSamplingPeriod") - 1,
+        "",
+        bdlat_FormattingMode::e_DEC
     }
 };
 
@@ -4694,7 +4769,7 @@ const bdlat_AttributeInfo *StatsConfig::lookupAttributeInfo(
         const char *name,
         int         nameLength)
 {
-    for (int i = 0; i < 3; ++i) {
+    for (int i = 0; i < 5; ++i) {
         const bdlat_AttributeInfo& attributeInfo =
                     StatsConfig::ATTRIBUTE_INFO_ARRAY[i];
 
@@ -4717,6 +4792,10 @@ const bdlat_AttributeInfo *StatsConfig::lookupAttributeInfo(int id)
         return &ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_PLUGINS];
       case ATTRIBUTE_ID_PRINTER:
         return &ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_PRINTER];
+      case ATTRIBUTE_ID_EXPORT_PATH:
+        return &ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_EXPORT_PATH];
+      case ATTRIBUTE_ID_MESSAGE_TRACE_SAMPLING_PERIOD:
+        return &ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_MESSAGE_TRACE_SAMPLING_PERIOD];
       default:
         return 0;
     }
@@ -4726,16 +4805,20 @@ const bdlat_AttributeInfo *StatsConfig::lookupAttributeInfo(int id)
 
 StatsConfig::StatsConfig(bslma::Allocator *basicAllocator)
 : d_plugins(basicAllocator)
+, d_exportPath(DEFAULT_INITIALIZER_EXPORT_PATH, basicAllocator)
 , d_printer(basicAllocator)
 , d_snapshotInterval(DEFAULT_INITIALIZER_SNAPSHOT_INTERVAL)
+, d_messageTraceSamplingPeriod(DEFAULT_INITIALIZER_MESSAGE_TRACE_SAMPLING_PERIOD)
 {
 }
 
 StatsConfig::StatsConfig(const StatsConfig& original,
                          bslma::Allocator *basicAllocator)
 : d_plugins(original.d_plugins, basicAllocator)
+, d_exportPath(original.d_exportPath, basicAllocator)
 , d_printer(original.d_printer, basicAllocator)
 , d_snapshotInterval(original.d_snapshotInterval)
+, d_messageTraceSamplingPeriod(original.d_messageTraceSamplingPeriod)
 {
 }
 
@@ -4743,16 +4826,20 @@ StatsConfig::StatsConfig(const StatsConfig& original,
  && defined(BSLS_COMPILERFEATURES_SUPPORT_NOEXCEPT)
 StatsConfig::StatsConfig(StatsConfig&& original) noexcept
 : d_plugins(bsl::move(original.d_plugins))
+, d_exportPath(bsl::move(original.d_exportPath))
 , d_printer(bsl::move(original.d_printer))
 , d_snapshotInterval(bsl::move(original.d_snapshotInterval))
+, d_messageTraceSamplingPeriod(bsl::move(original.d_messageTraceSamplingPeriod))
 {
 }
 
 StatsConfig::StatsConfig(StatsConfig&& original,
                          bslma::Allocator *basicAllocator)
 : d_plugins(bsl::move(original.d_plugins), basicAllocator)
+, d_exportPath(bsl::move(original.d_exportPath), basicAllocator)
 , d_printer(bsl::move(original.d_printer), basicAllocator)
 , d_snapshotInterval(bsl::move(original.d_snapshotInterval))
+, d_messageTraceSamplingPeriod(bsl::move(original.d_messageTraceSamplingPeriod))
 {
 }
 #endif
@@ -4770,6 +4857,8 @@ StatsConfig::operator=(const StatsConfig& rhs)
         d_snapshotInterval = rhs.d_snapshotInterval;
         d_plugins = rhs.d_plugins;
         d_printer = rhs.d_printer;
+        d_exportPath = rhs.d_exportPath;
+        d_messageTraceSamplingPeriod = rhs.d_messageTraceSamplingPeriod;
     }
 
     return *this;
@@ -4784,6 +4873,8 @@ StatsConfig::operator=(StatsConfig&& rhs)
         d_snapshotInterval = bsl::move(rhs.d_snapshotInterval);
         d_plugins = bsl::move(rhs.d_plugins);
         d_printer = bsl::move(rhs.d_printer);
+        d_exportPath = bsl::move(rhs.d_exportPath);
+        d_messageTraceSamplingPeriod = bsl::move(rhs.d_messageTraceSamplingPeriod);
     }
 
     return *this;
@@ -4795,6 +4886,8 @@ void StatsConfig::reset()
     d_snapshotInterval = DEFAULT_INITIALIZER_SNAPSHOT_INTERVAL;
     bdlat_ValueTypeFunctions::reset(&d_plugins);
     bdlat_ValueTypeFunctions::reset(&d_printer);
+    d_exportPath = DEFAULT_INITIALIZER_EXPORT_PATH;
+    d_messageTraceSamplingPeriod = DEFAULT_INITIALIZER_MESSAGE_TRACE_SAMPLING_PERIOD;
 }
 
 // ACCESSORS
@@ -4809,6 +4902,8 @@ bsl::ostream& StatsConfig::print(
     printer.printAttribute("snapshotInterval", this->snapshotInterval());
     printer.printAttribute("plugins", this->plugins());
     printer.printAttribute("printer", this->printer());
+    printer.printAttribute("exportPath", this->exportPath());
+    printer.printAttribute("messageTraceSamplingPeriod", this->messageTraceSamplingPeriod());
     printer.end();
     return stream;
 }
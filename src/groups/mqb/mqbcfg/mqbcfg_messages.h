@@ -5813,7 +5813,14 @@ class PartitionConfig {
     // whether to populate (prefault) page tables for a mapping.
     // flushAtShutdown......: flag to indicate whether broker should flush
     // storage files to disk at shutdown syncConfig...........: configuration
-    // for storage synchronization and recovery
+    // for storage synchronization and recovery compressRemoteReplication:
+    // flag to indicate whether storage events replicated to nodes located in
+    // a different data center should be compressed, if the peer supports it
+    // dedicatedIoThreads...: flag to indicate whether each partition should
+    // use a dedicated thread to prefault and sync its storage files, off the
+    // partition dispatcher thread ioThreadSyncIntervalMs: interval, in
+    // milliseconds, at which the dedicated IO thread syncs the written parts
+    // of the storage files to disk, or 0 to never sync them
 
     // INSTANCE DATA
     bsls::Types::Uint64  d_maxDataFileSize;
@@ -5824,42 +5831,51 @@ class PartitionConfig {
     StorageSyncConfig    d_syncConfig;
     int                  d_numPartitions;
     int                  d_maxArchivedFileSets;
+    int                  d_ioThreadSyncIntervalMs;
     bool                 d_preallocate;
     bool                 d_prefaultPages;
     bool                 d_flushAtShutdown;
+    bool                 d_compressRemoteReplication;
+    bool                 d_dedicatedIoThreads;
 
   public:
     // TYPES
     enum {
-        ATTRIBUTE_ID_NUM_PARTITIONS         = 0
-      , ATTRIBUTE_ID_LOCATION               = 1
-      , ATTRIBUTE_ID_ARCHIVE_LOCATION       = 2
-      , ATTRIBUTE_ID_MAX_DATA_FILE_SIZE     = 3
-      , ATTRIBUTE_ID_MAX_JOURNAL_FILE_SIZE  = 4
-      , ATTRIBUTE_ID_MAX_QLIST_FILE_SIZE    = 5
-      , ATTRIBUTE_ID_PREALLOCATE            = 6
-      , ATTRIBUTE_ID_MAX_ARCHIVED_FILE_SETS = 7
-      , ATTRIBUTE_ID_PREFAULT_PAGES         = 8
-      , ATTRIBUTE_ID_FLUSH_AT_SHUTDOWN      = 9
-      , ATTRIBUTE_ID_SYNC_CONFIG            = 10
+        ATTRIBUTE_ID_NUM_PARTITIONS              = 0
+      , ATTRIBUTE_ID_LOCATION                    = 1
+      , ATTRIBUTE_ID_ARCHIVE_LOCATION            = 2
+      , ATTRIBUTE_ID_MAX_DATA_FILE_SIZE          = 3
+      , ATTRIBUTE_ID_MAX_JOURNAL_FILE_SIZE       = 4
+      , ATTRIBUTE_ID_MAX_QLIST_FILE_SIZE         = 5
+      , ATTRIBUTE_ID_PREALLOCATE                 = 6
+      , ATTRIBUTE_ID_MAX_ARCHIVED_FILE_SETS      = 7
+      , ATTRIBUTE_ID_PREFAULT_PAGES              = 8
+      , ATTRIBUTE_ID_FLUSH_AT_SHUTDOWN           = 9
+      , ATTRIBUTE_ID_SYNC_CONFIG                 = 10
+      , ATTRIBUTE_ID_COMPRESS_REMOTE_REPLICATION = 11
+      , ATTRIBUTE_ID_DEDICATED_IO_THREADS        = 12
+      , ATTRIBUTE_ID_IO_THREAD_SYNC_INTERVAL_MS  = 13
     };
 
     enum {
-        NUM_ATTRIBUTES = 11
+        NUM_ATTRIBUTES = 14
     };
 
     enum {
-        ATTRIBUTE_INDEX_NUM_PARTITIONS         = 0
-      , ATTRIBUTE_INDEX_LOCATION               = 1
-      , ATTRIBUTE_INDEX_ARCHIVE_LOCATION       = 2
-      , ATTRIBUTE_INDEX_MAX_DATA_FILE_SIZE     = 3
-      , ATTRIBUTE_INDEX_MAX_JOURNAL_FILE_SIZE  = 4
-      , ATTRIBUTE_INDEX_MAX_QLIST_FILE_SIZE    = 5
-      , ATTRIBUTE_INDEX_PREALLOCATE            = 6
-      , ATTRIBUTE_INDEX_MAX_ARCHIVED_FILE_SETS = 7
-      , ATTRIBUTE_INDEX_PREFAULT_PAGES         = 8
-      , ATTRIBUTE_INDEX_FLUSH_AT_SHUTDOWN      = 9
-      , ATTRIBUTE_INDEX_SYNC_CONFIG            = 10
+        ATTRIBUTE_INDEX_NUM_PARTITIONS              = 0
+      , ATTRIBUTE_INDEX_LOCATION                    = 1
+      , ATTRIBUTE_INDEX_ARCHIVE_LOCATION            = 2
+      , ATTRIBUTE_INDEX_MAX_DATA_FILE_SIZE          = 3
+      , ATTRIBUTE_INDEX_MAX_JOURNAL_FILE_SIZE       = 4
+      , ATTRIBUTE_INDEX_MAX_QLIST_FILE_SIZE         = 5
+      , ATTRIBUTE_INDEX_PREALLOCATE                 = 6
+      , ATTRIBUTE_INDEX_MAX_ARCHIVED_FILE_SETS      = 7
+      , ATTRIBUTE_INDEX_PREFAULT_PAGES              = 8
+      , ATTRIBUTE_INDEX_FLUSH_AT_SHUTDOWN           = 9
+      , ATTRIBUTE_INDEX_SYNC_CONFIG                 = 10
+      , ATTRIBUTE_INDEX_COMPRESS_REMOTE_REPLICATION = 11
+      , ATTRIBUTE_INDEX_DEDICATED_IO_THREADS        = 12
+      , ATTRIBUTE_INDEX_IO_THREAD_SYNC_INTERVAL_MS  = 13
     };
 
     // CONSTANTS
@@ -5871,6 +5887,12 @@ class PartitionConfig {
 
     static const bool DEFAULT_INITIALIZER_FLUSH_AT_SHUTDOWN;
 
+    static const bool DEFAULT_INITIALIZER_COMPRESS_REMOTE_REPLICATION;
+
+    static const bool DEFAULT_INITIALIZER_DEDICATED_IO_THREADS;
+
+    static const int DEFAULT_INITIALIZER_IO_THREAD_SYNC_INTERVAL_MS;
+
     static const bdlat_AttributeInfo ATTRIBUTE_INFO_ARRAY[];
 
   public:
@@ -6009,6 +6031,18 @@ class PartitionConfig {
         // Return a reference to the modifiable "SyncConfig" attribute of this
         // object.
 
+    bool& compressRemoteReplication();
+        // Return a reference to the modifiable "CompressRemoteReplication"
+        // attribute of this object.
+
+    bool& dedicatedIoThreads();
+        // Return a reference to the modifiable "DedicatedIoThreads" attribute
+        // of this object.
+
+    int& ioThreadSyncIntervalMs();
+        // Return a reference to the modifiable "IoThreadSyncIntervalMs"
+        // attribute of this object.
+
     // ACCESSORS
     bsl::ostream& print(bsl::ostream& stream,
                         int           level = 0,
@@ -6090,6 +6124,18 @@ class PartitionConfig {
     const StorageSyncConfig& syncConfig() const;
         // Return a reference offering non-modifiable access to the
         // "SyncConfig" attribute of this object.
+
+    bool compressRemoteReplication() const;
+        // Return the value of the "CompressRemoteReplication" attribute of
+        // this object.
+
+    bool dedicatedIoThreads() const;
+        // Return the value of the "DedicatedIoThreads" attribute of this
+        // object.
+
+    int ioThreadSyncIntervalMs() const;
+        // Return the value of the "IoThreadSyncIntervalMs" attribute of this
+        // object.
 };
 
 // FREE OPERATORS
@@ -6133,8 +6179,10 @@ class StatsConfig {
 
     // INSTANCE DATA
     bsl::vector<StatPluginConfig>  d_plugins;
+    bsl::string                    d_exportPath;
     StatsPrinterConfig             d_printer;
     int                            d_snapshotInterval;
+    int                            d_messageTraceSamplingPeriod;
 
   public:
     // TYPES
@@ -6142,16 +6190,20 @@ class StatsConfig {
         ATTRIBUTE_ID_SNAPSHOT_INTERVAL = 0
       , ATTRIBUTE_ID_PLUGINS           = 1
       , ATTRIBUTE_ID_PRINTER           = 2
+      , ATTRIBUTE_ID_EXPORT_PATH       = 3
+      , ATTRIBUTE_ID_MESSAGE_TRACE_SAMPLING_PERIOD = 4
     };
 
     enum {
-        NUM_ATTRIBUTES = 3
+        NUM_ATTRIBUTES = 5
     };
 
     enum {
         ATTRIBUTE_INDEX_SNAPSHOT_INTERVAL = 0
       , ATTRIBUTE_INDEX_PLUGINS           = 1
       , ATTRIBUTE_INDEX_PRINTER           = 2
+      , ATTRIBUTE_INDEX_EXPORT_PATH       = 3
+      , ATTRIBUTE_INDEX_MESSAGE_TRACE_SAMPLING_PERIOD = 4
     };
 
     // CONSTANTS
@@ -6159,6 +6211,10 @@ class StatsConfig {
 
     static const int DEFAULT_INITIALIZER_SNAPSHOT_INTERVAL;
 
+    static const char DEFAULT_INITIALIZER_EXPORT_PATH[];
+
+    static const int DEFAULT_INITIALIZER_MESSAGE_TRACE_SAMPLING_PERIOD;
+
     static const bdlat_AttributeInfo ATTRIBUTE_INFO_ARRAY[];
 
   public:
@@ -6265,6 +6321,14 @@ class StatsConfig {
         // Return a reference to the modifiable "Printer" attribute of this
         // object.
 
+    bsl::string& exportPath();
+        // Return a reference to the modifiable "ExportPath" attribute of this
+        // object.
+
+    int& messageTraceSamplingPeriod();
+        // Return a reference to the modifiable "MessageTraceSamplingPeriod"
+        // attribute of this object.
+
     // ACCESSORS
     bsl::ostream& print(bsl::ostream& stream,
                         int           level = 0,
@@ -6319,6 +6383,14 @@ class StatsConfig {
     const StatsPrinterConfig& printer() const;
         // Return a reference offering non-modifiable access to the "Printer"
         // attribute of this object.
+
+    const bsl::string& exportPath() const;
+        // Return a reference offering non-modifiable access to the
+        // "ExportPath" attribute of this object.
+
+    int messageTraceSamplingPeriod() const;
+        // Return the value of the "MessageTraceSamplingPeriod" attribute of
+        // this object.
 };
 
 // FREE OPERATORS
@@ -13455,6 +13527,21 @@ int PartitionConfig::manipulateAttributes(t_MANIPULATOR& manipulator)
         return ret;
     }
 
+    ret = manipulator(&d_compressRemoteReplication, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_COMPRESS_REMOTE_REPLICATION]);
+    if (ret) {
+        return ret;
+    }
+
+    ret = manipulator(&d_dedicatedIoThreads, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_DEDICATED_IO_THREADS]);
+    if (ret) {
+        return ret;
+    }
+
+    ret = manipulator(&d_ioThreadSyncIntervalMs, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_IO_THREAD_SYNC_INTERVAL_MS]);
+    if (ret) {
+        return ret;
+    }
+
     return 0;
 }
 
@@ -13497,6 +13584,15 @@ int PartitionConfig::manipulateAttribute(t_MANIPULATOR& manipulator, int id)
       case ATTRIBUTE_ID_SYNC_CONFIG: {
         return manipulator(&d_syncConfig, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_SYNC_CONFIG]);
       }
+      case ATTRIBUTE_ID_COMPRESS_REMOTE_REPLICATION: {
+        return manipulator(&d_compressRemoteReplication, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_COMPRESS_REMOTE_REPLICATION]);
+      }
+      case ATTRIBUTE_ID_DEDICATED_IO_THREADS: {
+        return manipulator(&d_dedicatedIoThreads, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_DEDICATED_IO_THREADS]);
+      }
+      case ATTRIBUTE_ID_IO_THREAD_SYNC_INTERVAL_MS: {
+        return manipulator(&d_ioThreadSyncIntervalMs, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_IO_THREAD_SYNC_INTERVAL_MS]);
+      }
       default:
         return NOT_FOUND;
     }
@@ -13585,6 +13681,24 @@ StorageSyncConfig& PartitionConfig::syncConfig()
     return d_syncConfig;
 }
 
+inline
+bool& PartitionConfig::compressRemoteReplication()
+{
+    return d_compressRemoteReplication;
+}
+
+inline
+bool& PartitionConfig::dedicatedIoThreads()
+{
+    return d_dedicatedIoThreads;
+}
+
+inline
+int& PartitionConfig::ioThreadSyncIntervalMs()
+{
+    return d_ioThreadSyncIntervalMs;
+}
+
 // ACCESSORS
 template <typename t_ACCESSOR>
 int PartitionConfig::accessAttributes(t_ACCESSOR& accessor) const
@@ -13646,6 +13760,21 @@ int PartitionConfig::accessAttributes(t_ACCESSOR& accessor) const
         return ret;
     }
 
+    ret = accessor(d_compressRemoteReplication, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_COMPRESS_REMOTE_REPLICATION]);
+    if (ret) {
+        return ret;
+    }
+
+    ret = accessor(d_dedicatedIoThreads, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_DEDICATED_IO_THREADS]);
+    if (ret) {
+        return ret;
+    }
+
+    ret = accessor(d_ioThreadSyncIntervalMs, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_IO_THREAD_SYNC_INTERVAL_MS]);
+    if (ret) {
+        return ret;
+    }
+
     return 0;
 }
 
@@ -13688,6 +13817,15 @@ int PartitionConfig::accessAttribute(t_ACCESSOR& accessor, int id) const
       case ATTRIBUTE_ID_SYNC_CONFIG: {
         return accessor(d_syncConfig, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_SYNC_CONFIG]);
       }
+      case ATTRIBUTE_ID_COMPRESS_REMOTE_REPLICATION: {
+        return accessor(d_compressRemoteReplication, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_COMPRESS_REMOTE_REPLICATION]);
+      }
+      case ATTRIBUTE_ID_DEDICATED_IO_THREADS: {
+        return accessor(d_dedicatedIoThreads, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_DEDICATED_IO_THREADS]);
+      }
+      case ATTRIBUTE_ID_IO_THREAD_SYNC_INTERVAL_MS: {
+        return accessor(d_ioThreadSyncIntervalMs, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_IO_THREAD_SYNC_INTERVAL_MS]);
+      }
       default:
         return NOT_FOUND;
     }
@@ -13776,6 +13914,24 @@ const StorageSyncConfig& PartitionConfig::syncConfig() const
     return d_syncConfig;
 }
 
+inline
+bool PartitionConfig::compressRemoteReplication() const
+{
+    return d_compressRemoteReplication;
+}
+
+inline
+bool PartitionConfig::dedicatedIoThreads() const
+{
+    return d_dedicatedIoThreads;
+}
+
+inline
+int PartitionConfig::ioThreadSyncIntervalMs() const
+{
+    return d_ioThreadSyncIntervalMs;
+}
+
 
 
                              // -----------------
@@ -13804,6 +13960,16 @@ int StatsConfig::manipulateAttributes(t_MANIPULATOR& manipulator)
         return ret;
     }
 
+    ret = manipulator(&d_exportPath, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_EXPORT_PATH]);
+    if (ret) {
+        return ret;
+    }
+
+    ret = manipulator(&d_messageTraceSamplingPeriod, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_MESSAGE_TRACE_SAMPLING_PERIOD]);
+    if (ret) {
+        return ret;
+    }
+
     return 0;
 }
 
@@ -13822,6 +13988,12 @@ int StatsConfig::manipulateAttribute(t_MANIPULATOR& manipulator, int id)
       case ATTRIBUTE_ID_PRINTER: {
         return manipulator(&d_printer, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_PRINTER]);
       }
+      case ATTRIBUTE_ID_EXPORT_PATH: {
+        return manipulator(&d_exportPath, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_EXPORT_PATH]);
+      }
+      case ATTRIBUTE_ID_MESSAGE_TRACE_SAMPLING_PERIOD: {
+        return manipulator(&d_messageTraceSamplingPeriod, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_MESSAGE_TRACE_SAMPLING_PERIOD]);
+      }
       default:
         return NOT_FOUND;
     }
@@ -13862,6 +14034,18 @@ StatsPrinterConfig& StatsConfig::printer()
     return d_printer;
 }
 
+inline
+bsl::string& StatsConfig::exportPath()
+{
+    return d_exportPath;
+}
+
+inline
+int& StatsConfig::messageTraceSamplingPeriod()
+{
+    return d_messageTraceSamplingPeriod;
+}
+
 // ACCESSORS
 template <typename t_ACCESSOR>
 int StatsConfig::accessAttributes(t_ACCESSOR& accessor) const
@@ -13883,6 +14067,16 @@ int StatsConfig::accessAttributes(t_ACCESSOR& accessor) const
         return ret;
     }
 
+    ret = accessor(d_exportPath, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_EXPORT_PATH]);
+    if (ret) {
+        return ret;
+    }
+
+    ret = accessor(d_messageTraceSamplingPeriod, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_MESSAGE_TRACE_SAMPLING_PERIOD]);
+    if (ret) {
+        return ret;
+    }
+
     return 0;
 }
 
@@ -13901,6 +14095,12 @@ int StatsConfig::accessAttribute(t_ACCESSOR& accessor, int id) const
       case ATTRIBUTE_ID_PRINTER: {
         return accessor(d_printer, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_PRINTER]);
       }
+      case ATTRIBUTE_ID_EXPORT_PATH: {
+        return accessor(d_exportPath, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_EXPORT_PATH]);
+      }
+      case ATTRIBUTE_ID_MESSAGE_TRACE_SAMPLING_PERIOD: {
+        return accessor(d_messageTraceSamplingPeriod, ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_MESSAGE_TRACE_SAMPLING_PERIOD]);
+      }
       default:
         return NOT_FOUND;
     }
@@ -13941,6 +14141,18 @@ const StatsPrinterConfig& StatsConfig::printer() const
     return d_printer;
 }
 
+inline
+const bsl::string& StatsConfig::exportPath() const
+{
+    return d_exportPath;
+}
+
+inline
+int StatsConfig::messageTraceSamplingPeriod() const
+{
+    return d_messageTraceSamplingPeriod;
+}
+
 
 
                              // -----------------
@@ -16967,7 +17179,10 @@ bool mqbcfg::operator==(
          && lhs.maxArchivedFileSets() == rhs.maxArchivedFileSets()
          && lhs.prefaultPages() == rhs.prefaultPages()
          && lhs.flushAtShutdown() == rhs.flushAtShutdown()
-         && lhs.syncConfig() == rhs.syncConfig();
+         && lhs.syncConfig() == rhs.syncConfig()
+         && lhs.compressRemoteReplication() == rhs.compressRemoteReplication()
+         && lhs.dedicatedIoThreads() == rhs.dedicatedIoThreads()
+         && lhs.ioThreadSyncIntervalMs() == rhs.ioThreadSyncIntervalMs();
 }
 
 inline
@@ -17001,6 +17216,9 @@ void mqbcfg::hashAppend(t_HASH_ALGORITHM& hashAlg, const mqbcfg::PartitionConfig
     hashAppend(hashAlg, object.prefaultPages());
     hashAppend(hashAlg, object.flushAtShutdown());
     hashAppend(hashAlg, object.syncConfig());
+    hashAppend(hashAlg, object.compressRemoteReplication());
+    hashAppend(hashAlg, object.dedicatedIoThreads());
+    hashAppend(hashAlg, object.ioThreadSyncIntervalMs());
 }
 
 
@@ -17011,7 +17229,9 @@ bool mqbcfg::operator==(
 {
     return  lhs.snapshotInterval() == rhs.snapshotInterval()
          && lhs.plugins() == rhs.plugins()
-         && lhs.printer() == rhs.printer();
+         && lhs.printer() == rhs.printer()
+         && lhs.exportPath() == rhs.exportPath()
+         && lhs.messageTraceSamplingPeriod() == rhs.messageTraceSamplingPeriod();
 }
 
 inline
@@ -17037,6 +17257,8 @@ void mqbcfg::hashAppend(t_HASH_ALGORITHM& hashAlg, const mqbcfg::StatsConfig& ob
     hashAppend(hashAlg, object.snapshotInterval());
     hashAppend(hashAlg, object.plugins());
     hashAppend(hashAlg, object.printer());
+    hashAppend(hashAlg, object.exportPath());
+    hashAppend(hashAlg, object.messageTraceSamplingPeriod());
 }
 
 
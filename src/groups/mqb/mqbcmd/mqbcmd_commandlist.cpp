@@ -90,6 +90,12 @@ struct CommandDefinition {
     {"STAT LIST_TUNABLES",
      "Get the supported settable parameters for the stat controller",
      "Get the supported settable parameters for the stat controller"},
+    {"STAT PROFILE <seconds>",
+     "Profile the broker for 'seconds' seconds",
+     "Measure, for 'seconds' seconds, the CPU time spent by each dispatcher "
+     "thread and by each queue, session and cluster on these threads, and "
+     "the allocation rate of each allocator.  Note that the command blocks "
+     "for the whole duration of the profiling."},
     // ClusterCatalog
     {"CLUSTERS LIST", "List all active clusters", "List all active clusters"},
     {"CLUSTERS ADDREVERSE <clusterName> <remotePeer>",
@@ -14048,14 +14048,19 @@ const bdlat_SelectionInfo StatCommand::SELECTION_INFO_ARRAY[] = {
      "listTunables",
      sizeof("listTunables") - 1,
      "",
-     bdlat_FormattingMode::e_DEFAULT}};
+     bdlat_FormattingMode::e_DEFAULT},
+    {SELECTION_ID_PROFILE,
+     "profile",
+     sizeof("profile") - 1,
+     "",
+     bdlat_FormattingMode::e_DEC}};
 
 // CLASS METHODS
 
 const bdlat_SelectionInfo* StatCommand::lookupSelectionInfo(const char* name,
                                                             int nameLength)
 {
-    for (int i = 0; i < 4; ++i) {
+    for (int i = 0; i < 5; ++i) {
         const bdlat_SelectionInfo& selectionInfo =
             StatCommand::SELECTION_INFO_ARRAY[i];
 
@@ -14078,6 +14083,8 @@ const bdlat_SelectionInfo* StatCommand::lookupSelectionInfo(int id)
         return &SELECTION_INFO_ARRAY[SELECTION_INDEX_GET_TUNABLE];
     case SELECTION_ID_LIST_TUNABLES:
         return &SELECTION_INFO_ARRAY[SELECTION_INDEX_LIST_TUNABLES];
+    case SELECTION_ID_PROFILE:
+        return &SELECTION_INFO_ARRAY[SELECTION_INDEX_PROFILE];
     default: return 0;
     }
 }
@@ -14104,6 +14111,9 @@ StatCommand::StatCommand(const StatCommand& original,
     case SELECTION_ID_LIST_TUNABLES: {
         new (d_listTunables.buffer()) Void(original.d_listTunables.object());
     } break;
+    case SELECTION_ID_PROFILE: {
+        new (d_profile.buffer()) int(original.d_profile.object());
+    } break;
     default: BSLS_ASSERT(SELECTION_ID_UNDEFINED == d_selectionId);
     }
 }
@@ -14132,6 +14142,9 @@ StatCommand::StatCommand(StatCommand&& original) noexcept
         new (d_listTunables.buffer())
             Void(bsl::move(original.d_listTunables.object()));
     } break;
+    case SELECTION_ID_PROFILE: {
+        new (d_profile.buffer()) int(bsl::move(original.d_profile.object()));
+    } break;
     default: BSLS_ASSERT(SELECTION_ID_UNDEFINED == d_selectionId);
     }
 }
@@ -14159,6 +14172,9 @@ StatCommand::StatCommand(StatCommand&&     original,
         new (d_listTunables.buffer())
             Void(bsl::move(original.d_listTunables.object()));
     } break;
+    case SELECTION_ID_PROFILE: {
+        new (d_profile.buffer()) int(bsl::move(original.d_profile.object()));
+    } break;
     default: BSLS_ASSERT(SELECTION_ID_UNDEFINED == d_selectionId);
     }
 }
@@ -14182,6 +14198,9 @@ StatCommand& StatCommand::operator=(const StatCommand& rhs)
         case SELECTION_ID_LIST_TUNABLES: {
             makeListTunables(rhs.d_listTunables.object());
         } break;
+        case SELECTION_ID_PROFILE: {
+            makeProfile(rhs.d_profile.object());
+        } break;
         default:
             BSLS_ASSERT(SELECTION_ID_UNDEFINED == rhs.d_selectionId);
             reset();
@@ -14209,6 +14228,9 @@ StatCommand& StatCommand::operator=(StatCommand&& rhs)
         case SELECTION_ID_LIST_TUNABLES: {
             makeListTunables(bsl::move(rhs.d_listTunables.object()));
         } break;
+        case SELECTION_ID_PROFILE: {
+            makeProfile(bsl::move(rhs.d_profile.object()));
+        } break;
         default:
             BSLS_ASSERT(SELECTION_ID_UNDEFINED == rhs.d_selectionId);
             reset();
@@ -14235,6 +14257,9 @@ void StatCommand::reset()
     case SELECTION_ID_LIST_TUNABLES: {
         d_listTunables.object().~Void();
     } break;
+    case SELECTION_ID_PROFILE: {
+        // no destruction required
+    } break;
     default: BSLS_ASSERT(SELECTION_ID_UNDEFINED == d_selectionId);
     }
 
@@ -14256,6 +14281,9 @@ int StatCommand::makeSelection(int selectionId)
     case SELECTION_ID_LIST_TUNABLES: {
         makeListTunables();
     } break;
+    case SELECTION_ID_PROFILE: {
+        makeProfile();
+    } break;
     case SELECTION_ID_UNDEFINED: {
         reset();
     } break;
@@ -14457,6 +14485,34 @@ Void& StatCommand::makeListTunables(Void&& value)
 }
 #endif
 
+int& StatCommand::makeProfile()
+{
+    if (SELECTION_ID_PROFILE == d_selectionId) {
+        bdlat_ValueTypeFunctions::reset(&d_profile.object());
+    }
+    else {
+        reset();
+        new (d_profile.buffer()) int();
+        d_selectionId = SELECTION_ID_PROFILE;
+    }
+
+    return d_profile.object();
+}
+
+int& StatCommand::makeProfile(int value)
+{
+    if (SELECTION_ID_PROFILE == d_selectionId) {
+        d_profile.object() = value;
+    }
+    else {
+        reset();
+        new (d_profile.buffer()) int(value);
+        d_selectionId = SELECTION_ID_PROFILE;
+    }
+
+    return d_profile.object();
+}
+
 // ACCESSORS
 
 bsl::ostream&
@@ -14477,6 +14533,9 @@ StatCommand::print(bsl::ostream& stream, int level, int spacesPerLevel) const
     case SELECTION_ID_LIST_TUNABLES: {
         printer.printAttribute("listTunables", d_listTunables.object());
     } break;
+    case SELECTION_ID_PROFILE: {
+        printer.printAttribute("profile", d_profile.object());
+    } break;
     default: stream << "SELECTION UNDEFINED\n";
     }
     printer.end();
@@ -14494,6 +14553,8 @@ const char* StatCommand::selectionName() const
         return SELECTION_INFO_ARRAY[SELECTION_INDEX_GET_TUNABLE].name();
     case SELECTION_ID_LIST_TUNABLES:
         return SELECTION_INFO_ARRAY[SELECTION_INDEX_LIST_TUNABLES].name();
+    case SELECTION_ID_PROFILE:
+        return SELECTION_INFO_ARRAY[SELECTION_INDEX_PROFILE].name();
     default:
         BSLS_ASSERT(SELECTION_ID_UNDEFINED == d_selectionId);
         return "(* UNDEFINED *)";
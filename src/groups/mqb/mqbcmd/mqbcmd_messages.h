@@ -17654,6 +17654,7 @@ class StatCommand {
         bsls::ObjectBuffer<SetTunable>  d_setTunable;
         bsls::ObjectBuffer<bsl::string> d_getTunable;
         bsls::ObjectBuffer<Void>        d_listTunables;
+        bsls::ObjectBuffer<int>         d_profile;
     };
 
     int               d_selectionId;
@@ -17667,16 +17668,18 @@ class StatCommand {
         SELECTION_ID_SHOW          = 0,
         SELECTION_ID_SET_TUNABLE   = 1,
         SELECTION_ID_GET_TUNABLE   = 2,
-        SELECTION_ID_LIST_TUNABLES = 3
+        SELECTION_ID_LIST_TUNABLES = 3,
+        SELECTION_ID_PROFILE       = 4
     };
 
-    enum { NUM_SELECTIONS = 4 };
+    enum { NUM_SELECTIONS = 5 };
 
     enum {
         SELECTION_INDEX_SHOW          = 0,
         SELECTION_INDEX_SET_TUNABLE   = 1,
         SELECTION_INDEX_GET_TUNABLE   = 2,
-        SELECTION_INDEX_LIST_TUNABLES = 3
+        SELECTION_INDEX_LIST_TUNABLES = 3,
+        SELECTION_INDEX_PROFILE       = 4
     };
 
     // CONSTANTS
@@ -17798,6 +17801,12 @@ class StatCommand {
     // Optionally specify the 'value' of the "ListTunables".  If 'value' is
     // not specified, the default "ListTunables" value is used.
 
+    /// Set the value of this object to be a "Profile" value.  Optionally
+    /// specify the `value` of the "Profile".  If `value` is not specified,
+    /// the default "Profile" value is used.
+    int& makeProfile();
+    int& makeProfile(int value);
+
     /// Invoke the specified `manipulator` on the address of the modifiable
     /// selection, supplying `manipulator` with the corresponding selection
     /// information structure.  Return the value returned from the
@@ -17827,6 +17836,11 @@ class StatCommand {
     /// object.
     Void& listTunables();
 
+    /// Return a reference to the modifiable "Profile" selection of this
+    /// object if "Profile" is the current selection.  The behavior is
+    /// undefined unless "Profile" is the selection of this object.
+    int& profile();
+
     // ACCESSORS
 
     /// Format this object to the specified output `stream` at the
@@ -17875,6 +17889,11 @@ class StatCommand {
     /// object.
     const Void& listTunables() const;
 
+    /// Return a reference to the non-modifiable "Profile" selection of this
+    /// object if "Profile" is the current selection.  The behavior is
+    /// undefined unless "Profile" is the selection of this object.
+    const int& profile() const;
+
     /// Return `true` if the value of this object is a "Show" value, and
     /// return `false` otherwise.
     bool isShowValue() const;
@@ -17891,6 +17910,10 @@ class StatCommand {
     /// and return `false` otherwise.
     bool isListTunablesValue() const;
 
+    /// Return `true` if the value of this object is a "Profile" value, and
+    /// return `false` otherwise.
+    bool isProfileValue() const;
+
     /// Return `true` if the value of this object is undefined, and `false`
     /// otherwise.
     bool isUndefinedValue() const;
@@ -41106,6 +41129,9 @@ int StatCommand::manipulateSelection(MANIPULATOR& manipulator)
         return manipulator(
             &d_listTunables.object(),
             SELECTION_INFO_ARRAY[SELECTION_INDEX_LIST_TUNABLES]);
+    case StatCommand::SELECTION_ID_PROFILE:
+        return manipulator(&d_profile.object(),
+                           SELECTION_INFO_ARRAY[SELECTION_INDEX_PROFILE]);
     default:
         BSLS_ASSERT(StatCommand::SELECTION_ID_UNDEFINED == d_selectionId);
         return -1;
@@ -41136,6 +41162,12 @@ inline Void& StatCommand::listTunables()
     return d_listTunables.object();
 }
 
+inline int& StatCommand::profile()
+{
+    BSLS_ASSERT(SELECTION_ID_PROFILE == d_selectionId);
+    return d_profile.object();
+}
+
 // ACCESSORS
 inline int StatCommand::selectionId() const
 {
@@ -41158,6 +41190,9 @@ int StatCommand::accessSelection(ACCESSOR& accessor) const
     case SELECTION_ID_LIST_TUNABLES:
         return accessor(d_listTunables.object(),
                         SELECTION_INFO_ARRAY[SELECTION_INDEX_LIST_TUNABLES]);
+    case SELECTION_ID_PROFILE:
+        return accessor(d_profile.object(),
+                        SELECTION_INFO_ARRAY[SELECTION_INDEX_PROFILE]);
     default: BSLS_ASSERT(SELECTION_ID_UNDEFINED == d_selectionId); return -1;
     }
 }
@@ -41186,6 +41221,12 @@ inline const Void& StatCommand::listTunables() const
     return d_listTunables.object();
 }
 
+inline const int& StatCommand::profile() const
+{
+    BSLS_ASSERT(SELECTION_ID_PROFILE == d_selectionId);
+    return d_profile.object();
+}
+
 inline bool StatCommand::isShowValue() const
 {
     return SELECTION_ID_SHOW == d_selectionId;
@@ -41206,6 +41247,11 @@ inline bool StatCommand::isListTunablesValue() const
     return SELECTION_ID_LIST_TUNABLES == d_selectionId;
 }
 
+inline bool StatCommand::isProfileValue() const
+{
+    return SELECTION_ID_PROFILE == d_selectionId;
+}
+
 inline bool StatCommand::isUndefinedValue() const
 {
     return SELECTION_ID_UNDEFINED == d_selectionId;
@@ -41228,6 +41274,9 @@ void hashAppend(HASH_ALGORITHM& hashAlg, const mqbcmd::StatCommand& object)
     case Class::SELECTION_ID_LIST_TUNABLES:
         hashAppend(hashAlg, object.listTunables());
         break;
+    case Class::SELECTION_ID_PROFILE:
+        hashAppend(hashAlg, object.profile());
+        break;
     default:
         BSLS_ASSERT(Class::SELECTION_ID_UNDEFINED == object.selectionId());
     }
@@ -50153,6 +50202,8 @@ inline bool mqbcmd::operator==(const mqbcmd::StatCommand& lhs,
             return lhs.getTunable() == rhs.getTunable();
         case Class::SELECTION_ID_LIST_TUNABLES:
             return lhs.listTunables() == rhs.listTunables();
+        case Class::SELECTION_ID_PROFILE:
+            return lhs.profile() == rhs.profile();
         default:
             BSLS_ASSERT(Class::SELECTION_ID_UNDEFINED == rhs.selectionId());
             return true;
@@ -607,6 +607,23 @@ int parseStat(StatCommand* stats, bsl::string* error, WordGenerator next)
         stats->makeListTunables();
         return expectEnd(error, next);  // RETURN
     }
+    else if (equalCaseless(subcommand, "PROFILE")) {
+        const bslstl::StringRef durationString = next();
+
+        if (durationString.empty()) {
+            *error = "The command STAT PROFILE "
+                     "must be followed by a duration in seconds.";
+            return -1;  // RETURN
+        }
+
+        if (parseInt(&stats->makeProfile(), durationString)) {
+            *error = "Invalid <seconds> for STAT PROFILE <seconds>: " +
+                     durationString;
+            return -1;  // RETURN
+        }
+
+        return expectEnd(error, next);  // RETURN
+    }
 
     *error = "Unexpected STAT subcommand: " + subcommand;
     return -1;
@@ -207,6 +207,12 @@ const Test k_TESTS[] = {
      "CONFIGPROVIDER CACHE_CLEAR",
      0},
     {__LINE__, "show statistics", "STAT SHOW", "{\"stat\": {\"show\": {}}}"},
+    {__LINE__,
+     "profile the broker",
+     "STAT PROFILE 10",
+     "{\"stat\": {\"profile\": 10}}"},
+    {__LINE__, "profiling requires a duration", "STAT PROFILE", 0},
+    {__LINE__, "profiling duration must be an integer", "STAT PROFILE x", 0},
     {__LINE__,
      "list all active clusters",
      "CLUSTERS LIST",
@@ -647,19 +647,48 @@ bsl::ostream& FileBackedStorage::print(bsl::ostream& stream,
 
 const char InMemoryStorage::CLASS_NAME[] = "InMemoryStorage";
 
+const bsls::Types::Int64
+    InMemoryStorage::DEFAULT_INITIALIZER_MAX_RESIDENT_BYTES = 0;
+
+const int InMemoryStorage::DEFAULT_INITIALIZER_SPILL_AGE_SECONDS = 0;
+
+const bdlat_AttributeInfo InMemoryStorage::ATTRIBUTE_INFO_ARRAY[] = {
+    {ATTRIBUTE_ID_MAX_RESIDENT_BYTES,
+     "maxResidentBytes",
+     sizeof("maxResidentBytes") - 1,
+     "",
+     bdlat_FormattingMode::e_DEC},
+    {ATTRIBUTE_ID_SPILL_AGE_SECONDS,
+     "spillAgeSeconds",
+     sizeof("spillAgeSeconds") - 1,
+     "",
+     bdlat_FormattingMode::e_DEC}};
+
 // CLASS METHODS
 
 const bdlat_AttributeInfo*
 InMemoryStorage::lookupAttributeInfo(const char* name, int nameLength)
 {
-    (void)name;
-    (void)nameLength;
+    for (int i = 0; i < 2; ++i) {
+        const bdlat_AttributeInfo& attributeInfo =
+            InMemoryStorage::ATTRIBUTE_INFO_ARRAY[i];
+
+        if (nameLength == attributeInfo.d_nameLength &&
+            0 == bsl::memcmp(attributeInfo.d_name_p, name, nameLength)) {
+            return &attributeInfo;
+        }
+    }
+
     return 0;
 }
 
 const bdlat_AttributeInfo* InMemoryStorage::lookupAttributeInfo(int id)
 {
     switch (id) {
+    case ATTRIBUTE_ID_MAX_RESIDENT_BYTES:
+        return &ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_MAX_RESIDENT_BYTES];
+    case ATTRIBUTE_ID_SPILL_AGE_SECONDS:
+        return &ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_SPILL_AGE_SECONDS];
     default: return 0;
     }
 }
@@ -667,12 +696,15 @@ const bdlat_AttributeInfo* InMemoryStorage::lookupAttributeInfo(int id)
 // CREATORS
 
 InMemoryStorage::InMemoryStorage()
+: d_maxResidentBytes(DEFAULT_INITIALIZER_MAX_RESIDENT_BYTES)
+, d_spillAgeSeconds(DEFAULT_INITIALIZER_SPILL_AGE_SECONDS)
 {
 }
 
 InMemoryStorage::InMemoryStorage(const InMemoryStorage& original)
+: d_maxResidentBytes(original.d_maxResidentBytes)
+, d_spillAgeSeconds(original.d_spillAgeSeconds)
 {
-    (void)original;
 }
 
 InMemoryStorage::~InMemoryStorage()
@@ -683,7 +715,11 @@ InMemoryStorage::~InMemoryStorage()
 
 InMemoryStorage& InMemoryStorage::operator=(const InMemoryStorage& rhs)
 {
-    (void)rhs;
+    if (this != &rhs) {
+        d_maxResidentBytes = rhs.d_maxResidentBytes;
+        d_spillAgeSeconds  = rhs.d_spillAgeSeconds;
+    }
+
     return *this;
 }
 
@@ -691,13 +727,19 @@ InMemoryStorage& InMemoryStorage::operator=(const InMemoryStorage& rhs)
     defined(BSLS_COMPILERFEATURES_SUPPORT_NOEXCEPT)
 InMemoryStorage& InMemoryStorage::operator=(InMemoryStorage&& rhs)
 {
-    (void)rhs;
+    if (this != &rhs) {
+        d_maxResidentBytes = bsl::move(rhs.d_maxResidentBytes);
+        d_spillAgeSeconds  = bsl::move(rhs.d_spillAgeSeconds);
+    }
+
     return *this;
 }
 #endif
 
 void InMemoryStorage::reset()
 {
+    d_maxResidentBytes = DEFAULT_INITIALIZER_MAX_RESIDENT_BYTES;
+    d_spillAgeSeconds  = DEFAULT_INITIALIZER_SPILL_AGE_SECONDS;
 }
 
 // ACCESSORS
@@ -706,8 +748,11 @@ bsl::ostream& InMemoryStorage::print(bsl::ostream& stream,
                                      int           level,
                                      int           spacesPerLevel) const
 {
-    (void)level;
-    (void)spacesPerLevel;
+    bslim::Printer printer(&stream, level, spacesPerLevel);
+    printer.start();
+    printer.printAttribute("maxResidentBytes", this->maxResidentBytes());
+    printer.printAttribute("spillAgeSeconds", this->spillAgeSeconds());
+    printer.end();
     return stream;
 }
 
@@ -1165,16 +1165,40 @@ namespace mqbconfm {
 // =====================
 
 /// Configuration for storage using an in-memory map.
+/// maxResidentBytes..: maximum cumulated number of bytes of messages kept in
+/// memory by a queue.  Beyond this, the payloads of the oldest messages are
+/// spilled to a file in the partition location, and reloaded when they are
+/// delivered.  0 (the default) means unlimited
+/// spillAgeSeconds...: age, in seconds, after which the payload of a message
+/// is spilled regardless of the memory budget.  0 (the default) means never
 class InMemoryStorage {
     // INSTANCE DATA
+    bsls::Types::Int64 d_maxResidentBytes;
+    int                d_spillAgeSeconds;
 
   public:
     // TYPES
-    enum { NUM_ATTRIBUTES = 0 };
+    enum {
+        ATTRIBUTE_ID_MAX_RESIDENT_BYTES = 0,
+        ATTRIBUTE_ID_SPILL_AGE_SECONDS  = 1
+    };
+
+    enum { NUM_ATTRIBUTES = 2 };
+
+    enum {
+        ATTRIBUTE_INDEX_MAX_RESIDENT_BYTES = 0,
+        ATTRIBUTE_INDEX_SPILL_AGE_SECONDS  = 1
+    };
 
     // CONSTANTS
     static const char CLASS_NAME[];
 
+    static const bsls::Types::Int64 DEFAULT_INITIALIZER_MAX_RESIDENT_BYTES;
+
+    static const int DEFAULT_INITIALIZER_SPILL_AGE_SECONDS;
+
+    static const bdlat_AttributeInfo ATTRIBUTE_INFO_ARRAY[];
+
   public:
     // CLASS METHODS
 
@@ -1254,6 +1278,14 @@ class InMemoryStorage {
                             const char*    name,
                             int            nameLength);
 
+    /// Return a reference to the modifiable "MaxResidentBytes" attribute of
+    /// this object.
+    bsls::Types::Int64& maxResidentBytes();
+
+    /// Return a reference to the modifiable "SpillAgeSeconds" attribute of
+    /// this object.
+    int& spillAgeSeconds();
+
     // ACCESSORS
 
     /// Format this object to the specified output `stream` at the
@@ -1297,6 +1329,12 @@ class InMemoryStorage {
     int accessAttribute(t_ACCESSOR& accessor,
                         const char* name,
                         int         nameLength) const;
+
+    /// Return the value of the "MaxResidentBytes" attribute of this object.
+    bsls::Types::Int64 maxResidentBytes() const;
+
+    /// Return the value of the "SpillAgeSeconds" attribute of this object.
+    int spillAgeSeconds() const;
 };
 
 // FREE OPERATORS
@@ -5701,17 +5739,40 @@ int FileBackedStorage::accessAttribute(t_ACCESSOR& accessor,
 template <typename t_MANIPULATOR>
 int InMemoryStorage::manipulateAttributes(t_MANIPULATOR& manipulator)
 {
-    (void)manipulator;
+    int ret;
+
+    ret = manipulator(
+        &d_maxResidentBytes,
+        ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_MAX_RESIDENT_BYTES]);
+    if (ret) {
+        return ret;
+    }
+
+    ret = manipulator(&d_spillAgeSeconds,
+                      ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_SPILL_AGE_SECONDS]);
+    if (ret) {
+        return ret;
+    }
+
     return 0;
 }
 
 template <typename t_MANIPULATOR>
 int InMemoryStorage::manipulateAttribute(t_MANIPULATOR& manipulator, int id)
 {
-    (void)manipulator;
     enum { NOT_FOUND = -1 };
 
     switch (id) {
+    case ATTRIBUTE_ID_MAX_RESIDENT_BYTES: {
+        return manipulator(
+            &d_maxResidentBytes,
+            ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_MAX_RESIDENT_BYTES]);
+    }
+    case ATTRIBUTE_ID_SPILL_AGE_SECONDS: {
+        return manipulator(
+            &d_spillAgeSeconds,
+            ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_SPILL_AGE_SECONDS]);
+    }
     default: return NOT_FOUND;
     }
 }
@@ -5732,21 +5793,53 @@ int InMemoryStorage::manipulateAttribute(t_MANIPULATOR& manipulator,
     return manipulateAttribute(manipulator, attributeInfo->d_id);
 }
 
+inline bsls::Types::Int64& InMemoryStorage::maxResidentBytes()
+{
+    return d_maxResidentBytes;
+}
+
+inline int& InMemoryStorage::spillAgeSeconds()
+{
+    return d_spillAgeSeconds;
+}
+
 // ACCESSORS
 template <typename t_ACCESSOR>
 int InMemoryStorage::accessAttributes(t_ACCESSOR& accessor) const
 {
-    (void)accessor;
+    int ret;
+
+    ret = accessor(d_maxResidentBytes,
+                   ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_MAX_RESIDENT_BYTES]);
+    if (ret) {
+        return ret;
+    }
+
+    ret = accessor(d_spillAgeSeconds,
+                   ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_SPILL_AGE_SECONDS]);
+    if (ret) {
+        return ret;
+    }
+
     return 0;
 }
 
 template <typename t_ACCESSOR>
 int InMemoryStorage::accessAttribute(t_ACCESSOR& accessor, int id) const
 {
-    (void)accessor;
     enum { NOT_FOUND = -1 };
 
     switch (id) {
+    case ATTRIBUTE_ID_MAX_RESIDENT_BYTES: {
+        return accessor(
+            d_maxResidentBytes,
+            ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_MAX_RESIDENT_BYTES]);
+    }
+    case ATTRIBUTE_ID_SPILL_AGE_SECONDS: {
+        return accessor(
+            d_spillAgeSeconds,
+            ATTRIBUTE_INFO_ARRAY[ATTRIBUTE_INDEX_SPILL_AGE_SECONDS]);
+    }
     default: return NOT_FOUND;
     }
 }
@@ -5767,6 +5860,16 @@ int InMemoryStorage::accessAttribute(t_ACCESSOR& accessor,
     return accessAttribute(accessor, attributeInfo->d_id);
 }
 
+inline bsls::Types::Int64 InMemoryStorage::maxResidentBytes() const
+{
+    return d_maxResidentBytes;
+}
+
+inline int InMemoryStorage::spillAgeSeconds() const
+{
+    return d_spillAgeSeconds;
+}
+
 // ------------
 // class Limits
 // ------------
@@ -8116,16 +8219,17 @@ void mqbconfm::hashAppend(t_HASH_ALGORITHM&                  hashAlg,
     (void)object;
 }
 
-inline bool mqbconfm::operator==(const mqbconfm::InMemoryStorage&,
-                                 const mqbconfm::InMemoryStorage&)
+inline bool mqbconfm::operator==(const mqbconfm::InMemoryStorage& lhs,
+                                 const mqbconfm::InMemoryStorage& rhs)
 {
-    return true;
+    return lhs.maxResidentBytes() == rhs.maxResidentBytes() &&
+           lhs.spillAgeSeconds() == rhs.spillAgeSeconds();
 }
 
-inline bool mqbconfm::operator!=(const mqbconfm::InMemoryStorage&,
-                                 const mqbconfm::InMemoryStorage&)
+inline bool mqbconfm::operator!=(const mqbconfm::InMemoryStorage& lhs,
+                                 const mqbconfm::InMemoryStorage& rhs)
 {
-    return false;
+    return !(lhs == rhs);
 }
 
 inline bsl::ostream& mqbconfm::operator<<(bsl::ostream& stream,
@@ -8138,8 +8242,9 @@ template <typename t_HASH_ALGORITHM>
 void mqbconfm::hashAppend(t_HASH_ALGORITHM&                hashAlg,
                           const mqbconfm::InMemoryStorage& object)
 {
-    (void)hashAlg;
-    (void)object;
+    using bslh::hashAppend;
+    hashAppend(hashAlg, object.maxResidentBytes());
+    hashAppend(hashAlg, object.spillAgeSeconds());
 }
 
 inline bool mqbconfm::operator==(const mqbconfm::Limits& lhs,
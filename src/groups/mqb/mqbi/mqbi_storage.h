@@ -290,6 +290,13 @@ class StorageIterator {
     /// storage.
     virtual void reset() = 0;
 
+    /// Resynchronize this iterator, left in place since it was last moved,
+    /// with the underlying storage, which may have been modified meanwhile.
+    /// This must be called before resuming an iteration with an iterator
+    /// which was kept across modifications of the storage.  Note that the
+    /// accessors of this iterator do not resynchronize it.
+    virtual void resume() = 0;
+
     // ACCESSORS
 
     /// Return a reference offering non-modifiable access to the guid
@@ -36,6 +36,7 @@
 
 // BMQ
 #include <bmqp_ctrlmsg_messages.h>
+#include <bmqt_compressionalgorithmtype.h>
 
 // MWC
 #include <mwcio_channel.h>
@@ -48,6 +49,12 @@
 #include <bsl_string.h>
 
 namespace BloombergLP {
+
+// FORWARD DECLARATION
+namespace mwcst {
+class StatContext;
+}
+
 namespace mqbnet {
 
 // FORWARD DECLARATIONS
@@ -151,6 +158,18 @@ class ClusterNode {
     virtual bmqt::GenericResult::Enum write(const bdlbb::Blob&    blob,
                                             bmqp::EventType::Enum type) = 0;
 
+    /// Compress with the specified `algorithm` the storage events broadcast
+    /// to this node, as long as the peer advertises support for compressed
+    /// storage events.  Specify `bmqt::CompressionAlgorithmType::e_NONE` to
+    /// disable compression.
+    virtual void setReplicationCompression(
+        bmqt::CompressionAlgorithmType::Enum algorithm) = 0;
+
+    /// Set the stat context to which the replication statistics of this
+    /// node are reported to the specified `statContext`.
+    virtual void setStatContext(
+        const bsl::shared_ptr<mwcst::StatContext>& statContext) = 0;
+
     // ACCESSORS
 
     /// Return identity from the last received negotiation message.
@@ -176,6 +195,17 @@ class ClusterNode {
     /// Return true if this node is available, i.e., it has an attached
     /// channel.
     virtual bool isAvailable() const = 0;
+
+    /// Return the compression algorithm with which the storage events
+    /// broadcast to this node are compressed, i.e. `e_NONE` unless
+    /// compression was enabled with `setReplicationCompression` and the
+    /// peer supports it.
+    virtual bmqt::CompressionAlgorithmType::Enum
+    replicationCompression() const = 0;
+
+    /// Return the stat context to which the replication statistics of this
+    /// node are reported, or a null pointer if none was set.
+    virtual mwcst::StatContext* statContext() const = 0;
 };
 
 // =============
@@ -17,8 +17,17 @@
 #include <mqbnet_clusterimp.h>
 
 #include <mqbscm_version.h>
+// MQB
+#include <mqbstat_clusterstats.h>
+
 // BMQ
+#include <bmqp_eventutil.h>
 #include <bmqp_protocol.h>
+#include <bmqp_protocolutil.h>
+
+// MWC
+#include <mwcst_statcontext.h>
+#include <mwcsys_time.h>
 #include <mwcu_memoutstream.h>
 
 // BDE
@@ -34,6 +43,7 @@
 #include <bsls_annotation.h>
 #include <bsls_assert.h>
 #include <bsls_performancehint.h>
+#include <bsls_types.h>
 
 namespace BloombergLP {
 namespace mqbnet {
@@ -53,6 +63,9 @@ ClusterNodeImp::ClusterNodeImp(ClusterImp*                cluster,
 , d_channel(blobBufferFactory, itemPool, config.name(), allocator)
 , d_identity(allocator)
 , d_isReading(false)
+, d_replicationCompression(bmqt::CompressionAlgorithmType::e_NONE)
+, d_peerSupportsCompression(false)
+, d_statContext_sp()
 {
     BSLS_ASSERT_SAFE(d_cluster_p &&
                      "A ClusterNode should always be part of a Cluster");
@@ -77,6 +90,11 @@ ClusterNodeImp::setChannel(const bsl::weak_ptr<mwcio::Channel>& value,
     d_isReading = false;
     d_identity  = identity;
 
+    d_peerSupportsCompression = bmqp::ProtocolUtil::hasFeature(
+        bmqp::HighAvailabilityFeatures::k_FIELD_NAME,
+        bmqp::HighAvailabilityFeatures::k_COMPRESSED_REPLICATION,
+        identity.features());
+
     d_channel.setChannel(value);
 
     // Notify the cluster of changes to this node
@@ -126,6 +144,7 @@ ClusterNode* ClusterNodeImp::resetChannel()
     d_channel.resetChannel();
     d_isReading = false;
     d_identity.reset();
+    d_peerSupportsCompression = false;
     d_readCb = mwcio::Channel::ReadCallback();
 
     // Notify the cluster of changes to this node
@@ -148,6 +167,21 @@ bmqt::GenericResult::Enum ClusterNodeImp::write(const bdlbb::Blob&    blob,
     return d_channel.writeBlob(blob, type);
 }
 
+void ClusterNodeImp::setReplicationCompression(
+    bmqt::CompressionAlgorithmType::Enum algorithm)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(algorithm != bmqt::CompressionAlgorithmType::e_UNKNOWN);
+
+    d_replicationCompression = algorithm;
+}
+
+void ClusterNodeImp::setStatContext(
+    const bsl::shared_ptr<mwcst::StatContext>& statContext)
+{
+    d_statContext_sp = statContext;
+}
+
 // ----------------
 // class ClusterImp
 // ----------------
@@ -184,6 +218,7 @@ ClusterImp::ClusterImp(const bsl::string&                      name,
                        Channel::ItemPool*        itemPool,
                        bslma::Allocator*         allocator)
 : d_allocator_p(allocator)
+, d_blobBufferFactory_p(blobBufferFactory)
 , d_name(name, allocator)
 , d_nodesConfig(nodesConfig, allocator)
 , d_selfNodeId(selfNodeId)
@@ -235,6 +270,16 @@ Cluster* ClusterImp::unregisterObserver(ClusterObserver* observer)
 
 int ClusterImp::writeAll(const bdlbb::Blob& blob, bmqp::EventType::Enum type)
 {
+    // Storage events are compressed lazily, and at most once, for all the
+    // peers requiring it.  Note that this method may be invoked concurrently
+    // from the threads of different partitions, hence the compressed event
+    // is local to this invocation.
+    bdlbb::Blob        compressedBlob(d_blobBufferFactory_p, d_allocator_p);
+    bsls::Types::Int64 compressionTimeNs = 0;
+    bmqt::CompressionAlgorithmType::Enum compressionAlgorithm =
+        bmqt::CompressionAlgorithmType::e_NONE;
+    bool compressionAttempted = false;
+
     unsigned int maxPushChannelPendingItems = 0;
     unsigned int maxChannelPendingItems     = 0;
     for (bsl::list<ClusterNodeImp>::iterator it = d_nodes.begin();
@@ -254,7 +299,54 @@ int ClusterImp::writeAll(const bdlbb::Blob& blob, bmqp::EventType::Enum type)
                 }
             }
 
-            bmqt::GenericResult::Enum rc = it->write(blob, type);
+            const bdlbb::Blob* blobToWrite = &blob;
+
+            const bmqt::CompressionAlgorithmType::Enum nodeAlgorithm =
+                it->replicationCompression();
+            if (type == bmqp::EventType::e_STORAGE &&
+                nodeAlgorithm != bmqt::CompressionAlgorithmType::e_NONE) {
+                if (!compressionAttempted) {
+                    compressionAttempted = true;
+
+                    const bsls::Types::Int64 startTime =
+                        mwcsys::Time::highResolutionTimer();
+                    const int rc = bmqp::EventUtil::compressStorageEvent(
+                        &compressedBlob,
+                        blob,
+                        nodeAlgorithm,
+                        d_blobBufferFactory_p,
+                        d_allocator_p);
+                    compressionTimeNs = mwcsys::Time::highResolutionTimer() -
+                                        startTime;
+
+                    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(rc == 0)) {
+                        compressionAlgorithm = nodeAlgorithm;
+                    }
+                    else if (d_failedWritesThrottler.requestPermission()) {
+                        BALL_LOG_ERROR << "#CLUSTER_SEND_FAILURE "
+                                       << "Failed to compress storage event "
+                                       << "of length [" << blob.length()
+                                       << "] bytes, sending it uncompressed"
+                                       << ", rc: " << rc << ".";
+                    }
+                }
+
+                // Peers configured with a different algorithm than the one
+                // the event was compressed with get the event uncompressed.
+                if (compressionAlgorithm == nodeAlgorithm) {
+                    blobToWrite = &compressedBlob;
+
+                    if (it->d_statContext_sp) {
+                        mqbstat::ClusterNodeStats::onReplicationCompressed(
+                            it->d_statContext_sp.get(),
+                            blob.length(),
+                            compressedBlob.length(),
+                            compressionTimeNs);
+                    }
+                }
+            }
+
+            bmqt::GenericResult::Enum rc = it->write(*blobToWrite, type);
 
             if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
                     bmqt::GenericResult::e_SUCCESS != rc &&
@@ -264,7 +356,8 @@ int ClusterImp::writeAll(const bdlbb::Blob& blob, bmqp::EventType::Enum type)
                 if (d_failedWritesThrottler.requestPermission()) {
                     BALL_LOG_ERROR << "#CLUSTER_SEND_FAILURE "
                                    << "Failed to write blob of length ["
-                                   << blob.length() << "] bytes, to node "
+                                   << blobToWrite->length()
+                                   << "] bytes, to node "
                                    << it->nodeDescription() << ", rc: " << rc
                                    << ".";
                 }
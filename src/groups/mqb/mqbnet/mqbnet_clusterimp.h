@@ -54,6 +54,7 @@
 #include <bslma_usesbslmaallocator.h>
 #include <bslmf_nestedtraitdeclaration.h>
 #include <bslmt_mutex.h>
+#include <bsls_atomic.h>
 #include <bsls_cpp11.h>
 
 namespace BloombergLP {
@@ -96,6 +97,24 @@ class ClusterNodeImp : public ClusterNode {
     // Indicates if post-negotiation read has
     // started.
 
+    bsls::AtomicInt d_replicationCompression;
+    // Compression algorithm configured for
+    // the storage events broadcast to this
+    // node.
+
+    bsls::AtomicBool d_peerSupportsCompression;
+    // Whether the peer advertised, in its
+    // last negotiation message, support for
+    // compressed storage events.
+
+    bsl::shared_ptr<mwcst::StatContext> d_statContext_sp;
+    // Stat context to report the
+    // replication statistics of this node
+    // to, if any.
+
+    // FRIENDS
+    friend class ClusterImp;
+
   private:
     // NOT IMPLEMENTED
     ClusterNodeImp(const ClusterNodeImp&) BSLS_CPP11_DELETED;
@@ -153,6 +172,20 @@ class ClusterNodeImp : public ClusterNode {
     write(const bdlbb::Blob&    blob,
           bmqp::EventType::Enum type) BSLS_KEYWORD_OVERRIDE;
 
+    /// Compress with the specified `algorithm` the storage events broadcast
+    /// to this node, as long as the peer advertises support for compressed
+    /// storage events.  Specify `bmqt::CompressionAlgorithmType::e_NONE` to
+    /// disable compression.
+    void setReplicationCompression(bmqt::CompressionAlgorithmType::Enum
+                                       algorithm) BSLS_KEYWORD_OVERRIDE;
+
+    /// Set the stat context to which the replication statistics of this
+    /// node are reported to the specified `statContext`.  The behavior is
+    /// undefined unless this method is called before any storage event is
+    /// exchanged with this node.
+    void setStatContext(const bsl::shared_ptr<mwcst::StatContext>&
+                            statContext) BSLS_KEYWORD_OVERRIDE;
+
     // ACCESSORS
     const bmqp_ctrlmsg::ClientIdentity& identity() const BSLS_KEYWORD_OVERRIDE;
     // Return identity from the last received negotiation message.
@@ -177,6 +210,17 @@ class ClusterNodeImp : public ClusterNode {
     /// Return true if this node is available, i.e., it has an attached
     /// channel.
     bool isAvailable() const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the compression algorithm with which the storage events
+    /// broadcast to this node are compressed, i.e. `e_NONE` unless
+    /// compression was enabled with `setReplicationCompression` and the
+    /// peer supports it.
+    bmqt::CompressionAlgorithmType::Enum
+    replicationCompression() const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the stat context to which the replication statistics of this
+    /// node are reported, or a null pointer if none was set.
+    mwcst::StatContext* statContext() const BSLS_KEYWORD_OVERRIDE;
 };
 
 // =============
@@ -200,6 +244,10 @@ class ClusterImp : public Cluster {
     bslma::Allocator* d_allocator_p;
     // Allocator to use
 
+    bdlbb::BlobBufferFactory* d_blobBufferFactory_p;
+    // Blob buffer factory to use for the
+    // compressed storage events
+
     bsl::string d_name;
     // Name of this Cluster
 
@@ -394,6 +442,22 @@ inline bool ClusterNodeImp::isAvailable() const
     return d_channel.isAvailable();
 }
 
+inline bmqt::CompressionAlgorithmType::Enum
+ClusterNodeImp::replicationCompression() const
+{
+    if (!d_peerSupportsCompression) {
+        return bmqt::CompressionAlgorithmType::e_NONE;  // RETURN
+    }
+
+    return static_cast<bmqt::CompressionAlgorithmType::Enum>(
+        d_replicationCompression.load());
+}
+
+inline mwcst::StatContext* ClusterNodeImp::statContext() const
+{
+    return d_statContext_sp.get();
+}
+
 // ----------------
 // class ClusterImp
 // ----------------
@@ -49,6 +49,8 @@ MockClusterNode::MockClusterNode(MockCluster*               cluster,
 , d_channel(blobBufferFactory, itemPool, config.name(), allocator)
 , d_identity(allocator)
 , d_isReading(false)
+, d_replicationCompression(bmqt::CompressionAlgorithmType::e_NONE)
+, d_statContext_sp()
 {
     BSLS_ASSERT_SAFE(d_cluster_p &&
                      "A ClusterNode should always be part of a Cluster");
@@ -125,6 +127,18 @@ bmqt::GenericResult::Enum MockClusterNode::write(const bdlbb::Blob&    blob,
     return d_channel.writeBlob(blob, type);
 }
 
+void MockClusterNode::setReplicationCompression(
+    bmqt::CompressionAlgorithmType::Enum algorithm)
+{
+    d_replicationCompression = algorithm;
+}
+
+void MockClusterNode::setStatContext(
+    const bsl::shared_ptr<mwcst::StatContext>& statContext)
+{
+    d_statContext_sp = statContext;
+}
+
 // -----------------
 // class MockCluster
 // -----------------
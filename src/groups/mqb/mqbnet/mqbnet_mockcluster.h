@@ -83,6 +83,15 @@ class MockClusterNode : public ClusterNode {
     bool d_isReading;
     // Indicates if post-negotiation read
     // has started.
+
+    bmqt::CompressionAlgorithmType::Enum d_replicationCompression;
+    // Compression algorithm configured
+    // for the storage events broadcast to
+    // this node.
+
+    bsl::shared_ptr<mwcst::StatContext> d_statContext_sp;
+    // Stat context set with
+    // 'setStatContext', if any.
   private:
     // NOT IMPLEMENTED
 
@@ -141,6 +150,14 @@ class MockClusterNode : public ClusterNode {
     write(const bdlbb::Blob&    blob,
           bmqp::EventType::Enum type) BSLS_KEYWORD_OVERRIDE;
 
+    /// Store the specified compression `algorithm`.
+    void setReplicationCompression(bmqt::CompressionAlgorithmType::Enum
+                                       algorithm) BSLS_KEYWORD_OVERRIDE;
+
+    /// Store the specified `statContext`.
+    void setStatContext(const bsl::shared_ptr<mwcst::StatContext>&
+                            statContext) BSLS_KEYWORD_OVERRIDE;
+
     // ACCESSORS
     //   (virtual mqbnet::ClusterNode)
 
@@ -167,6 +184,14 @@ class MockClusterNode : public ClusterNode {
     /// Return true if this node is available, i.e., it has an attached
     /// channel.
     bool isAvailable() const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the compression algorithm last set with
+    /// `setReplicationCompression`.
+    bmqt::CompressionAlgorithmType::Enum
+    replicationCompression() const BSLS_KEYWORD_OVERRIDE;
+
+    /// Return the stat context last set with `setStatContext`, if any.
+    mwcst::StatContext* statContext() const BSLS_KEYWORD_OVERRIDE;
 };
 
 // =================
@@ -378,6 +403,17 @@ inline bool MockClusterNode::isAvailable() const
     return d_channel.isAvailable();
 }
 
+inline bmqt::CompressionAlgorithmType::Enum
+MockClusterNode::replicationCompression() const
+{
+    return d_replicationCompression;
+}
+
+inline mwcst::StatContext* MockClusterNode::statContext() const
+{
+    return d_statContext_sp.get();
+}
+
 // -----------------
 // class MockCluster
 // -----------------
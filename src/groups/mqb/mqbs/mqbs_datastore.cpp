@@ -42,6 +42,8 @@ DataStoreConfig::DataStoreConfig()
 , d_scheduler_p(0)
 , d_preallocate(false)
 , d_prefaultPages(false)
+, d_dedicatedIoThread(false)
+, d_ioThreadSyncIntervalMs(0)
 , d_location()
 , d_archiveLocation()
 , d_nodeId(-1)
@@ -75,6 +77,9 @@ bsl::ostream& DataStoreConfig::print(bsl::ostream& stream,
                            (hasPreallocate() ? "true" : "false"));
     printer.printAttribute("prefaultPages",
                            (hasPrefaultPages() ? "true" : "false"));
+    printer.printAttribute("dedicatedIoThread",
+                           (hasDedicatedIoThread() ? "true" : "false"));
+    printer.printAttribute("ioThreadSyncIntervalMs", ioThreadSyncIntervalMs());
     printer.printAttribute("maxDataFileSize", maxDataFileSize());
     printer.printAttribute("maxQlistFileSize", maxQlistFileSize());
     printer.printAttribute("maxJournalFileSize", maxJournalFileSize());
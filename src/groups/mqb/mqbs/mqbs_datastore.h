@@ -20,12 +20,13 @@
 //@PURPOSE: Provide an interface for a BlazingMQ data store.
 //
 //@CLASSES:
-//  mqbs::DataStoreRecordFlag:     Status of a record in data store.
-//  mqbs::DataStoreRecordFlagUtil: 'mqbs::DataStoreRecordFlag' utility
-//  mqbs::DataStoreRecord:         A record in data store.
-//  mqbs::DataStoreConfig:         Configuration of a data store.
-//  mqbs::DataStoreRecordHandle:   VST handle to a 'mqbs::DataStoreRecord'
-//  mqbs::DataStore:               Interface for a BlazingMQ data store.
+//  mqbs::DataStoreRecordFlag:      Status of a record in data store.
+//  mqbs::DataStoreRecordFlagUtil:  'mqbs::DataStoreRecordFlag' utility
+//  mqbs::DataStoreRecord:          A record in data store.
+//  mqbs::DataStoreConfig:          Configuration of a data store.
+//  mqbs::DataStoreRecordHandle:    VST handle to a 'mqbs::DataStoreRecord'
+//  mqbs::DataStoreReadAheadCursor: State of a reader reading ahead messages
+//  mqbs::DataStore:                Interface for a BlazingMQ data store.
 //
 //@SEE ALSO: mqbs::FileStore
 //
@@ -378,6 +379,17 @@ class DataStoreConfig {
     // (prefault) page tables for a
     // mapping.
 
+    bool d_dedicatedIoThread;
+    // Flag to indicate whether file store
+    // should prefault and sync its files
+    // in a dedicated IO thread
+
+    int d_ioThreadSyncIntervalMs;
+    // Interval, in milliseconds, at which
+    // the dedicated IO thread syncs the
+    // written parts of the files to disk,
+    // or 0 to never sync them
+
     bslstl::StringRef d_location;
 
     bslstl::StringRef d_archiveLocation;
@@ -411,6 +423,8 @@ class DataStoreConfig {
     DataStoreConfig& setScheduler(bdlmt::EventScheduler* value);
     DataStoreConfig& setPreallocate(bool value);
     DataStoreConfig& setPrefaultPages(bool value);
+    DataStoreConfig& setDedicatedIoThread(bool value);
+    DataStoreConfig& setIoThreadSyncIntervalMs(int value);
     DataStoreConfig& setLocation(const bslstl::StringRef& value);
     DataStoreConfig& setArchiveLocation(const bslstl::StringRef& value);
     DataStoreConfig& setClusterName(const bslstl::StringRef& value);
@@ -432,6 +446,8 @@ class DataStoreConfig {
     bdlmt::EventScheduler*    scheduler() const;
     bool                      hasPreallocate() const;
     bool                      hasPrefaultPages() const;
+    bool                      hasDedicatedIoThread() const;
+    int                       ioThreadSyncIntervalMs() const;
     const bslstl::StringRef&  location() const;
     const bslstl::StringRef&  archiveLocation() const;
     const bslstl::StringRef&  clusterName() const;
@@ -525,6 +541,32 @@ bool operator==(const DataStoreRecordHandle& lhs,
 bool operator!=(const DataStoreRecordHandle& lhs,
                 const DataStoreRecordHandle& rhs);
 
+// ===============================
+// struct DataStoreReadAheadCursor
+// ===============================
+
+/// This component provides a VST keeping track, for one reader of the
+/// messages of an instance of a concrete implementation of
+/// `mqbs::DataStore`, of the data already read ahead on its behalf.  Each
+/// reader (e.g., each storage iterator) must own its cursor.
+struct DataStoreReadAheadCursor {
+  public:
+    // PUBLIC DATA
+    bsls::Types::Uint64 d_dataFileId;
+    // Identifier, assigned by the data
+    // store, of the data file read ahead,
+    // or 0 if nothing was read ahead yet.
+
+    bsls::Types::Uint64 d_position;
+    // Offset in the data file up to which
+    // the data was read ahead.
+
+    // CREATORS
+
+    /// Create a cursor for a reader which has not read ahead anything yet.
+    DataStoreReadAheadCursor();
+};
+
 // ===============
 // class DataStore
 // ===============
@@ -730,6 +772,16 @@ class DataStore : public mqbi::DispatcherClient {
     virtual unsigned int
     getMessageLenRaw(const DataStoreRecordHandle& handle) const = 0;
 
+    /// Advise that the messages stored after the message record having the
+    /// specified `handle` are about to be loaded, which is what happens
+    /// when a backlog is drained in arrival order.  The specified `cursor`
+    /// keeps track, across calls made by the same reader, of the data
+    /// already prefetched, and must be default-constructed before the first
+    /// call.
+    virtual void readAheadMessagesRaw(DataStoreReadAheadCursor*    cursor,
+                                      const DataStoreRecordHandle& handle)
+        const = 0;
+
     /// Return the current primary leaseId for this partition.
     virtual unsigned int primaryLeaseId() const = 0;
 
@@ -946,6 +998,18 @@ inline DataStoreConfig& DataStoreConfig::setPrefaultPages(bool value)
     return *this;
 }
 
+inline DataStoreConfig& DataStoreConfig::setDedicatedIoThread(bool value)
+{
+    d_dedicatedIoThread = value;
+    return *this;
+}
+
+inline DataStoreConfig& DataStoreConfig::setIoThreadSyncIntervalMs(int value)
+{
+    d_ioThreadSyncIntervalMs = value;
+    return *this;
+}
+
 inline DataStoreConfig&
 DataStoreConfig::setLocation(const bslstl::StringRef& value)
 {
@@ -1048,6 +1112,16 @@ inline bool DataStoreConfig::hasPrefaultPages() const
     return d_prefaultPages;
 }
 
+inline bool DataStoreConfig::hasDedicatedIoThread() const
+{
+    return d_dedicatedIoThread;
+}
+
+inline int DataStoreConfig::ioThreadSyncIntervalMs() const
+{
+    return d_ioThreadSyncIntervalMs;
+}
+
 inline const bslstl::StringRef& DataStoreConfig::location() const
 {
     return d_location;
@@ -1164,6 +1238,17 @@ inline unsigned int DataStoreRecordHandle::primaryLeaseId() const
     return d_iterator->first.d_primaryLeaseId;
 }
 
+// -------------------------------
+// struct DataStoreReadAheadCursor
+// -------------------------------
+
+// CREATORS
+inline DataStoreReadAheadCursor::DataStoreReadAheadCursor()
+: d_dataFileId(0)
+, d_position(0)
+{
+}
+
 }  // close package namespace
 
 // -------------------------
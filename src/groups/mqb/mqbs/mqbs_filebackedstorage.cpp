@@ -131,6 +131,7 @@ FileBackedStorage::FileBackedStorage(
 , d_isEmpty(1)
 , d_defaultRdaInfo(defaultRdaInfo)
 , d_hasReceipts(!config.consistency().isStrongValue())
+, d_readAheadCursor()
 {
     BSLS_ASSERT(d_store_p);
 
@@ -170,6 +171,9 @@ FileBackedStorage::get(bsl::shared_ptr<bdlbb::Blob>*   appData,
     const RecordHandlesArray& handles = it->second.d_array;
     BSLS_ASSERT(!handles.empty());
 
+    // Messages are usually retrieved in arrival order, so read ahead the
+    // ones which follow.
+    d_store_p->readAheadMessagesRaw(&d_readAheadCursor, handles[0]);
     d_store_p->loadMessageRaw(appData, options, attributes, handles[0]);
 
     if (handles[0].primaryLeaseId() < d_store_p->primaryLeaseId()) {
@@ -989,6 +993,8 @@ void FileBackedStorageIterator::loadMessageAndAttributes() const
     if (!d_appData_sp) {
         const RecordHandlesArray& array = d_iterator->second.d_array;
         BSLS_ASSERT_SAFE(!array.empty());
+        d_storage_p->d_store_p->readAheadMessagesRaw(&d_readAheadCursor,
+                                                     array[0]);
         d_storage_p->d_store_p->loadMessageRaw(&d_appData_sp,
                                                &d_options_sp,
                                                &d_attributes,
@@ -1003,6 +1009,7 @@ FileBackedStorageIterator::FileBackedStorageIterator()
 , d_attributes()
 , d_appData_sp()
 , d_options_sp()
+, d_readAheadCursor()
 {
     // NOTHING
 }
@@ -1013,6 +1020,9 @@ FileBackedStorageIterator::FileBackedStorageIterator(
 : d_storage_p(storage)
 , d_iterator(initialPosition)
 , d_attributes()
+, d_appData_sp()
+, d_options_sp()
+, d_readAheadCursor()
 {
 }
 
@@ -1040,6 +1050,11 @@ void FileBackedStorageIterator::reset()
     d_iterator = d_storage_p->d_handles.begin();
 }
 
+void FileBackedStorageIterator::resume()
+{
+    // NOTHING
+}
+
 // ACCESSORS
 const bmqt::MessageGUID& FileBackedStorageIterator::guid() const
 {
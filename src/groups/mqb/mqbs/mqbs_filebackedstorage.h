@@ -206,6 +206,11 @@ class FileBackedStorage BSLS_KEYWORD_FINAL : public ReplicatedStorage {
 
     const bool d_hasReceipts;
 
+    mutable DataStoreReadAheadCursor d_readAheadCursor;
+    // Data read ahead of the messages
+    // retrieved with 'get' (see
+    // 'DataStore::readAheadMessagesRaw').
+
   private:
     // NOT IMPLEMENTED
     FileBackedStorage(const FileBackedStorage&) BSLS_KEYWORD_DELETED;
@@ -535,6 +540,9 @@ class FileBackedStorageIterator : public mqbi::StorageIterator {
 
     mutable bsl::shared_ptr<bdlbb::Blob> d_options_sp;
 
+    mutable DataStoreReadAheadCursor d_readAheadCursor;
+    // Data read ahead of this iterator.
+
   private:
     // PRIVATE MANIPULATORS
     void clear();
@@ -569,6 +577,10 @@ class FileBackedStorageIterator : public mqbi::StorageIterator {
     /// storage.
     void reset() BSLS_KEYWORD_OVERRIDE;
 
+    /// Do nothing: this iterator does not need to be resynchronized with
+    /// the underlying storage.
+    void resume() BSLS_KEYWORD_OVERRIDE;
+
     // ACCESSORS
 
     /// Return a reference offering non-modifiable access to the guid
@@ -0,0 +1,338 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// mqbs_filesetiothread.cpp                                           -*-C++-*-
+#include <mqbs_filesetiothread.h>
+
+#include <mqbscm_version.h>
+// MQB
+#include <mqbs_filesystemutil.h>
+
+// MWC
+#include <mwcsys_threadutil.h>
+#include <mwcu_memoutstream.h>
+
+// BDE
+#include <ball_log.h>
+#include <bdlf_memfn.h>
+#include <bdls_memoryutil.h>
+#include <bsl_algorithm.h>
+#include <bslmt_lockguard.h>
+#include <bslmt_threadattributes.h>
+#include <bsls_assert.h>
+#include <bsls_systemclocktype.h>
+#include <bsls_systemtime.h>
+
+namespace BloombergLP {
+namespace mqbs {
+
+namespace {
+
+BALL_LOG_SET_NAMESPACE_CATEGORY("MQBS.FILESETIOTHREAD");
+
+}  // close unnamed namespace
+
+// ---------------------
+// class FileSetIoThread
+// ---------------------
+
+// Force variable/symbol definition so that they can be used in other files
+const bsls::Types::Uint64 FileSetIoThread::k_PREFAULT_WINDOW;
+const bsls::Types::Uint64 FileSetIoThread::k_PREFAULT_CHUNK;
+const bsls::Types::Uint64 FileSetIoThread::k_SYNC_CHUNK;
+const int                 FileSetIoThread::k_IDLE_INTERVAL_MS;
+
+// PRIVATE MANIPULATORS
+void FileSetIoThread::threadFn()
+{
+    // executed by the *IO* thread
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);  // LOCK
+
+    while (!d_isStopping) {
+        if (!d_isAttached || d_isDetaching) {
+            d_condition.wait(&d_mutex);
+            continue;  // CONTINUE
+        }
+
+        const bool isSyncDue = d_syncInterval != bsls::TimeInterval() &&
+                               d_nextSyncTime <=
+                                   bsls::SystemTime::nowMonotonicClock();
+
+        // Access the files without holding the mutex, so that 'detach',
+        // called from the dispatcher thread, only waits for the current
+        // chunk of IO, and not for the mutex to be released.  The files
+        // remain mapped until 'd_isBusy' is reset.
+
+        bool hasMore = false;
+        d_isBusy     = true;
+        {
+            bslmt::UnLockGuard<bslmt::Mutex> unlockGuard(&d_mutex);  // UNLOCK
+
+            hasMore = prefaultNextChunk();
+            if (isSyncDue) {
+                sync();
+            }
+        }
+        d_isBusy = false;
+
+        if (d_isDetaching) {
+            d_ioDoneCondition.signal();
+            continue;  // CONTINUE
+        }
+
+        const bsls::TimeInterval now = bsls::SystemTime::nowMonotonicClock();
+        if (isSyncDue) {
+            d_nextSyncTime = now + d_syncInterval;
+        }
+
+        if (hasMore) {
+            continue;  // CONTINUE
+        }
+
+        bsls::TimeInterval deadline = now;
+        deadline.addMilliseconds(k_IDLE_INTERVAL_MS);
+        if (d_syncInterval != bsls::TimeInterval()) {
+            deadline = bsl::min(deadline, d_nextSyncTime);
+        }
+        d_condition.timedWait(&d_mutex, deadline);
+    }
+}
+
+bool FileSetIoThread::prefaultNextChunk()
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(d_isBusy);
+
+    bool hasMore = false;
+    for (int i = 0; i < k_NUM_FILES; ++i) {
+        File& file = d_files[i];
+
+        const bsls::Types::Uint64 target = bsl::min(
+            file.d_writePosition.loadAcquire() + k_PREFAULT_WINDOW,
+            file.d_size);
+        const bsls::Types::Uint64 begin = file.d_prefaultPosition;
+        if (target <= begin) {
+            continue;  // CONTINUE
+        }
+
+        const bsls::Types::Uint64 length = bsl::min(target - begin,
+                                                    k_PREFAULT_CHUNK);
+        FileSystemUtil::prefault(file.d_mapping_p + begin, length);
+        file.d_prefaultPosition.storeRelease(begin + length);
+
+        hasMore = hasMore || begin + length < target;
+    }
+
+    return hasMore;
+}
+
+void FileSetIoThread::sync()
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(d_isBusy);
+
+    // 'msync' requires a page-aligned address, so each sync starts at the
+    // beginning of the page holding the previous sync position.
+
+    const bsls::Types::Uint64 pageMask = ~static_cast<bsls::Types::Uint64>(
+        bdls::MemoryUtil::pageSize() - 1);
+
+    for (int i = 0; i < k_NUM_FILES; ++i) {
+        File& file = d_files[i];
+
+        const bsls::Types::Uint64 end = file.d_writePosition.loadAcquire();
+        if (end <= file.d_syncPosition) {
+            continue;  // CONTINUE
+        }
+
+        bool isComplete = true;
+        while (file.d_syncPosition < end) {
+            if (d_isDetaching) {
+                // The remaining bytes are left to the owner of the files.
+                return;  // RETURN
+            }
+
+            const bsls::Types::Uint64 begin    = file.d_syncPosition &
+                                              pageMask;
+            const bsls::Types::Uint64 chunkEnd = bsl::min(begin + k_SYNC_CHUNK,
+                                                          end);
+
+            mwcu::MemOutStream errorDesc(d_allocator_p);
+            const int rc = FileSystemUtil::flush(file.d_mapping_p + begin,
+                                                 chunkEnd - begin,
+                                                 errorDesc);
+            if (0 != rc) {
+                BALL_LOG_ERROR << "[" << d_name << "] Failed to sync "
+                               << (i == FileType::e_JOURNAL ? "journal"
+                                                            : "data")
+                               << " file, rc: " << rc << ", error: "
+                               << errorDesc.str();
+                isComplete = false;
+                break;  // BREAK
+            }
+
+            file.d_syncPosition.storeRelease(chunkEnd);
+        }
+
+        if (isComplete) {
+            ++d_numSyncs;
+        }
+    }
+}
+
+// CREATORS
+FileSetIoThread::FileSetIoThread(const bslstl::StringRef& name,
+                                 int                      syncIntervalMs,
+                                 bslma::Allocator*        allocator)
+: d_name(name.data(), name.length(), allocator)
+, d_syncInterval()
+, d_nextSyncTime()
+, d_files()
+, d_mutex()
+, d_condition(bsls::SystemClockType::e_MONOTONIC)
+, d_ioDoneCondition()
+, d_isBusy(false)
+, d_isDetaching(false)
+, d_isAttached(false)
+, d_isStopping(false)
+, d_isStarted(false)
+, d_threadHandle()
+, d_numSyncs(0)
+, d_allocator_p(allocator)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(0 <= syncIntervalMs);
+
+    d_syncInterval.addMilliseconds(syncIntervalMs);
+}
+
+FileSetIoThread::~FileSetIoThread()
+{
+    stop();
+}
+
+// MANIPULATORS
+int FileSetIoThread::start()
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(!d_isStarted);
+
+    enum { rc_SUCCESS = 0, rc_THREAD_CREATION_FAILURE = -1 };
+
+    d_isStopping = false;
+
+    bslmt::ThreadAttributes attr = mwcsys::ThreadUtil::defaultAttributes();
+    attr.setThreadName(d_name);
+    const int rc = bslmt::ThreadUtil::createWithAllocator(
+        &d_threadHandle,
+        attr,
+        bdlf::MemFnUtil::memFn(&FileSetIoThread::threadFn, this),
+        d_allocator_p);
+    if (0 != rc) {
+        return rc_THREAD_CREATION_FAILURE;  // RETURN
+    }
+
+    d_isStarted = true;
+    return rc_SUCCESS;
+}
+
+void FileSetIoThread::stop()
+{
+    if (!d_isStarted) {
+        return;  // RETURN
+    }
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);  // LOCK
+        d_isStopping  = true;
+        d_isAttached  = false;
+        d_isDetaching = true;  // Interrupt the IO in progress, if any
+    }
+    d_condition.signal();
+
+    const int rc = bslmt::ThreadUtil::join(d_threadHandle);
+    BSLS_ASSERT_SAFE(rc == 0);
+    (void)rc;  // Compiler happiness
+
+    d_isDetaching = false;
+
+    d_isStarted = false;
+}
+
+void FileSetIoThread::attach(const MappedFileDescriptor& journalFile,
+                             bsls::Types::Uint64         journalPosition,
+                             const MappedFileDescriptor& dataFile,
+                             bsls::Types::Uint64         dataPosition)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(journalFile.isValid());
+    BSLS_ASSERT_SAFE(dataFile.isValid());
+    BSLS_ASSERT_SAFE(journalPosition <= journalFile.fileSize());
+    BSLS_ASSERT_SAFE(dataPosition <= dataFile.fileSize());
+
+    const MappedFileDescriptor* mfds[k_NUM_FILES];
+    bsls::Types::Uint64         positions[k_NUM_FILES];
+    mfds[FileType::e_JOURNAL]      = &journalFile;
+    mfds[FileType::e_DATA]         = &dataFile;
+    positions[FileType::e_JOURNAL] = journalPosition;
+    positions[FileType::e_DATA]    = dataPosition;
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);  // LOCK
+        BSLS_ASSERT_SAFE(!d_isAttached);
+
+        // Bytes written before the file set is attached are neither
+        // prefaulted nor synced again.
+
+        for (int i = 0; i < k_NUM_FILES; ++i) {
+            File& file       = d_files[i];
+            file.d_mapping_p = mfds[i]->mapping();
+            file.d_size      = mfds[i]->fileSize();
+            file.d_writePosition.storeRelease(positions[i]);
+            file.d_prefaultPosition.storeRelease(positions[i]);
+            file.d_syncPosition.storeRelease(positions[i]);
+        }
+
+        d_nextSyncTime = bsls::SystemTime::nowMonotonicClock() +
+                         d_syncInterval;
+        d_isAttached   = true;
+    }
+    d_condition.signal();
+}
+
+void FileSetIoThread::detach()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);  // LOCK
+
+    // Interrupt the IO in progress, if any, after its current chunk, and
+    // wait for the IO thread to stop accessing the files.  It won't start
+    // accessing them again while 'd_isDetaching' is set.
+
+    d_isDetaching = true;
+    while (d_isBusy) {
+        d_ioDoneCondition.wait(&d_mutex);
+    }
+    d_isDetaching = false;
+
+    d_isAttached = false;
+    for (int i = 0; i < k_NUM_FILES; ++i) {
+        d_files[i].d_mapping_p = 0;
+        d_files[i].d_size      = 0;
+    }
+}
+
+}  // close package namespace
+}  // close enterprise namespace
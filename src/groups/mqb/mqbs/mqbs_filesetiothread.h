@@ -0,0 +1,330 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// mqbs_filesetiothread.h                                             -*-C++-*-
+#ifndef INCLUDED_MQBS_FILESETIOTHREAD
+#define INCLUDED_MQBS_FILESETIOTHREAD
+
+//@PURPOSE: Provide a thread performing the blocking IO of a file set.
+//
+//@CLASSES:
+//  mqbs::FileSetIoThread: dedicated IO thread of the active file set
+//
+//@DESCRIPTION: 'mqbs::FileSetIoThread' is a mechanism moving the blocking IO
+// of the active file set of a partition off the dispatcher thread of the
+// partition, which is shared with the queues.  Records are still appended to
+// the mapped journal and data files by the dispatcher thread, because the
+// memory they are written to is aliased by the replicated storage events and
+// by the payload blobs of the messages.  Instead, the dispatcher thread
+// 'publish'es the write position of each file, with a single atomic store per
+// file and without any lock, and the IO thread:
+//: o prefaults the pages located ahead of the write position of each file,
+//:   so that appending records does not cause a major page fault in the
+//:   dispatcher thread, and
+//: o if configured with a positive sync interval, syncs to disk, in a single
+//:   batch per file, all the bytes written since the previous sync.
+//
+// Since write positions only grow, only the latest published position
+// matters to the IO thread, and publishing never waits for the IO thread.
+//
+// 'attach' starts serving the files of a file set, and 'detach' stops it,
+// waiting for the IO thread to stop accessing them: a file set must be
+// detached before its files are truncated or unmapped.  The IO thread does
+// not hold any lock while it accesses the files, and splits its IO in
+// chunks of bounded size, checking in between whether a 'detach' is
+// pending: 'detach', which is called from the dispatcher thread, therefore
+// waits for at most one chunk of IO, instead of a whole prefault window or
+// sync batch.  Note that the bytes of a sync batch interrupted by 'detach'
+// are not synced by the IO thread.
+//
+/// Thread Safety
+///-------------
+// 'publish', 'prefaultPosition', 'syncPosition' and 'numSyncs' may be called
+// from any thread.  All the other methods must be called from the same
+// thread.
+
+// MQB
+#include <mqbs_mappedfiledescriptor.h>
+
+// BDE
+#include <bsl_string.h>
+#include <bslma_allocator.h>
+#include <bslma_usesbslmaallocator.h>
+#include <bslmf_nestedtraitdeclaration.h>
+#include <bslmt_condition.h>
+#include <bslmt_mutex.h>
+#include <bslmt_threadutil.h>
+#include <bslstl_stringref.h>
+#include <bsls_atomic.h>
+#include <bsls_keyword.h>
+#include <bsls_timeinterval.h>
+#include <bsls_types.h>
+
+namespace BloombergLP {
+namespace mqbs {
+
+// =====================
+// class FileSetIoThread
+// =====================
+
+/// Dedicated IO thread of the active file set of a partition.
+class FileSetIoThread {
+  public:
+    // TYPES
+
+    /// Enumeration of the files served by the IO thread.
+    struct FileType {
+        enum Enum { e_JOURNAL = 0, e_DATA = 1 };
+    };
+
+    // PUBLIC CONSTANTS
+
+    /// Number of bytes ahead of the write position of a file which are
+    /// kept prefaulted.
+    static const bsls::Types::Uint64 k_PREFAULT_WINDOW = 16 * 1024 * 1024;
+
+    /// Maximum number of bytes prefaulted in one go, after which 'detach'
+    /// and 'stop' are given a chance to proceed.
+    static const bsls::Types::Uint64 k_PREFAULT_CHUNK = 1024 * 1024;
+
+    /// Maximum number of bytes synced in one go, after which 'detach' and
+    /// 'stop' are given a chance to proceed.
+    static const bsls::Types::Uint64 k_SYNC_CHUNK = 4 * 1024 * 1024;
+
+    /// Interval, in milliseconds, at which the IO thread checks the
+    /// published write positions when it has nothing to do.
+    static const int k_IDLE_INTERVAL_MS = 1;
+
+  private:
+    // PRIVATE TYPES
+    enum { k_NUM_FILES = 2 };
+
+    /// State of a served file.
+    struct File {
+        char* d_mapping_p;
+        // Mapping of the file, or null if no file set is attached.
+
+        bsls::Types::Uint64 d_size;
+        // Size of the file, beyond which the mapping must not be accessed.
+
+        bsls::AtomicUint64 d_writePosition;
+        // Write position last published by the dispatcher thread.
+
+        bsls::AtomicUint64 d_prefaultPosition;
+        // Position up to which the file has been prefaulted.
+
+        bsls::AtomicUint64 d_syncPosition;
+        // Position up to which the file has been synced to disk.
+
+        // CREATORS
+        File();
+    };
+
+    // DATA
+    bsl::string d_name;
+    // Name of the thread.
+
+    bsls::TimeInterval d_syncInterval;
+    // Interval at which written bytes are synced to disk, or zero to never
+    // sync them.
+
+    bsls::TimeInterval d_nextSyncTime;
+    // Time, on the monotonic clock, of the next sync.
+
+    File d_files[k_NUM_FILES];
+
+    bslmt::Mutex d_mutex;
+    // Protects the attachment of the files.  Not held by the IO thread
+    // while accessing the files.
+
+    bslmt::Condition d_condition;
+    // Signaled on 'attach' and 'stop'.
+
+    bslmt::Condition d_ioDoneCondition;
+    // Signaled by the IO thread when it stops accessing the files while
+    // 'd_isDetaching' is set.
+
+    bool d_isBusy;
+    // Whether the IO thread is accessing the files.  Protected by
+    // 'd_mutex'.
+
+    bsls::AtomicBool d_isDetaching;
+    // Whether 'detach' or 'stop' waits for the IO thread to stop accessing
+    // the files.  Checked by the IO thread between two chunks of IO.
+
+    bool d_isAttached;
+    // Whether a file set is attached.  Protected by 'd_mutex'.
+
+    bool d_isStopping;
+    // Whether the IO thread has been requested to stop.  Protected by
+    // 'd_mutex'.
+
+    bool d_isStarted;
+
+    bslmt::ThreadUtil::Handle d_threadHandle;
+
+    bsls::AtomicInt64 d_numSyncs;
+    // Number of syncs performed.
+
+    bslma::Allocator* d_allocator_p;
+
+  private:
+    // NOT IMPLEMENTED
+    FileSetIoThread(const FileSetIoThread&) BSLS_KEYWORD_DELETED;
+    FileSetIoThread& operator=(const FileSetIoThread&) BSLS_KEYWORD_DELETED;
+
+  private:
+    // PRIVATE MANIPULATORS
+
+    /// Entry point of the IO thread.
+    void threadFn();
+
+    /// Prefault the next chunk of the attached files which is within the
+    /// prefault window.  Return true if there are more bytes to prefault.
+    /// The behavior is undefined unless `d_isBusy` is set.
+    bool prefaultNextChunk();
+
+    /// Sync to disk all the bytes of the attached files written since the
+    /// previous sync, in chunks of at most `k_SYNC_CHUNK` bytes, stopping
+    /// early if `d_isDetaching` is set.  The behavior is undefined unless
+    /// `d_isBusy` is set.
+    void sync();
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(FileSetIoThread, bslma::UsesBslmaAllocator)
+
+    // CREATORS
+
+    /// Create an IO thread object having the specified `name`, which syncs
+    /// the written bytes to disk every specified `syncIntervalMs`
+    /// milliseconds, or never if `syncIntervalMs` is 0.  Use the specified
+    /// `allocator` to supply memory.  Note that the thread is created by
+    /// `start`.
+    FileSetIoThread(const bslstl::StringRef& name,
+                    int                      syncIntervalMs,
+                    bslma::Allocator*        allocator);
+
+    /// Stop the thread, if started, and destroy this object.
+    ~FileSetIoThread();
+
+    // MANIPULATORS
+
+    /// Create the IO thread.  Return 0 on success, non-zero value
+    /// otherwise.  The behavior is undefined if the thread is already
+    /// started.
+    int start();
+
+    /// Detach any attached file set, and stop and join the IO thread.  This
+    /// method has no effect if the thread is not started.
+    void stop();
+
+    /// Start serving the specified `journalFile` and `dataFile`, whose
+    /// current write positions are the specified `journalPosition` and
+    /// `dataPosition`, respectively.  The behavior is undefined if a file
+    /// set is already attached, or unless both files remain mapped until
+    /// `detach` is called.
+    void attach(const MappedFileDescriptor& journalFile,
+                bsls::Types::Uint64         journalPosition,
+                const MappedFileDescriptor& dataFile,
+                bsls::Types::Uint64         dataPosition);
+
+    /// Stop serving the attached files, if any, and return once the IO
+    /// thread no longer accesses them.  Note that this method waits for at
+    /// most one chunk of IO in progress, of `k_PREFAULT_CHUNK` or
+    /// `k_SYNC_CHUNK` bytes.
+    void detach();
+
+    /// Publish the specified `journalPosition` and `dataPosition` as the
+    /// current write positions of the attached journal and data files.
+    /// This method never blocks.
+    void publish(bsls::Types::Uint64 journalPosition,
+                 bsls::Types::Uint64 dataPosition);
+
+    // ACCESSORS
+
+    /// Return true if the IO thread is started.
+    bool isStarted() const;
+
+    /// Return the position up to which the file of the specified `type` is
+    /// prefaulted.
+    bsls::Types::Uint64 prefaultPosition(FileType::Enum type) const;
+
+    /// Return the position up to which the file of the specified `type` is
+    /// synced to disk.
+    bsls::Types::Uint64 syncPosition(FileType::Enum type) const;
+
+    /// Return the number of syncs performed.
+    bsls::Types::Int64 numSyncs() const;
+};
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+// ---------------------------
+// struct FileSetIoThread::File
+// ---------------------------
+
+inline FileSetIoThread::File::File()
+: d_mapping_p(0)
+, d_size(0)
+, d_writePosition(0)
+, d_prefaultPosition(0)
+, d_syncPosition(0)
+{
+    // NOTHING
+}
+
+// ---------------------
+// class FileSetIoThread
+// ---------------------
+
+// MANIPULATORS
+inline void FileSetIoThread::publish(bsls::Types::Uint64 journalPosition,
+                                     bsls::Types::Uint64 dataPosition)
+{
+    d_files[FileType::e_JOURNAL].d_writePosition.storeRelease(
+        journalPosition);
+    d_files[FileType::e_DATA].d_writePosition.storeRelease(dataPosition);
+}
+
+// ACCESSORS
+inline bool FileSetIoThread::isStarted() const
+{
+    return d_isStarted;
+}
+
+inline bsls::Types::Uint64
+FileSetIoThread::prefaultPosition(FileType::Enum type) const
+{
+    return d_files[type].d_prefaultPosition.loadAcquire();
+}
+
+inline bsls::Types::Uint64
+FileSetIoThread::syncPosition(FileType::Enum type) const
+{
+    return d_files[type].d_syncPosition.loadAcquire();
+}
+
+inline bsls::Types::Int64 FileSetIoThread::numSyncs() const
+{
+    return d_numSyncs;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
@@ -0,0 +1,333 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// mqbs_filesetiothread.t.cpp                                         -*-C++-*-
+#include <mqbs_filesetiothread.h>
+
+// MQB
+#include <mqbs_filesystemutil.h>
+#include <mqbs_mappedfiledescriptor.h>
+
+// MWC
+#include <mwcu_memoutstream.h>
+#include <mwcu_tempdirectory.h>
+
+// BDE
+#include <bdls_pathutil.h>
+#include <bsl_cstring.h>
+#include <bsl_string.h>
+#include <bslmf_assert.h>
+#include <bslmt_threadutil.h>
+#include <bsls_types.h>
+
+// TEST DRIVER
+#include <mwctst_testhelper.h>
+
+// CONVENIENCE
+using namespace BloombergLP;
+using namespace bsl;
+
+namespace {
+
+// TYPES
+typedef mqbs::FileSetIoThread::FileType FileType;
+
+// CONSTANTS
+const bsls::Types::Uint64 k_FILE_SIZE = 4 * 1024 * 1024;
+
+// FUNCTIONS
+
+/// Create a file of `k_FILE_SIZE` bytes having the specified `name` in the
+/// specified `tempDir`, and load its mapping into the specified `mfd`.
+void createFile(mqbs::MappedFileDescriptor* mfd,
+                const mwcu::TempDirectory&  tempDir,
+                const char*                 name)
+{
+    bsl::string path(tempDir.path(), s_allocator_p);
+    bdls::PathUtil::appendRaw(&path, name);
+
+    mwcu::MemOutStream errorDesc(s_allocator_p);
+    ASSERT_EQ(mqbs::FileSystemUtil::open(mfd,
+                                         path.c_str(),
+                                         k_FILE_SIZE,
+                                         false,  // readOnly
+                                         errorDesc),
+              0);
+    ASSERT_EQ(mqbs::FileSystemUtil::grow(mfd,
+                                         false,  // reserveOnDisk
+                                         errorDesc),
+              0);
+}
+
+/// Wait, for at most 10 seconds, until the sync position if the specified
+/// `isSync` is true, or the prefault position otherwise, reported by the
+/// specified `obj` for the file of the specified `type` reaches the
+/// specified `expected` value.  Return true if it does, false otherwise.
+bool waitForPosition(const mqbs::FileSetIoThread& obj,
+                     FileType::Enum               type,
+                     bool                         isSync,
+                     bsls::Types::Uint64          expected)
+{
+    for (int i = 0; i < 10000; ++i) {
+        const bsls::Types::Uint64 position = isSync
+                                                 ? obj.syncPosition(type)
+                                                 : obj.prefaultPosition(type);
+        if (position == expected) {
+            return true;  // RETURN
+        }
+        bslmt::ThreadUtil::microSleep(1000);
+    }
+
+    return false;
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                                    TESTS
+// ----------------------------------------------------------------------------
+
+static void test1_breathingTest()
+// ------------------------------------------------------------------------
+// BREATHING TEST
+//
+// Testing:
+//   Starting and stopping 'mqbs::FileSetIoThread', with and without a file
+//   set attached.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("BREATHING TEST");
+
+    mwcu::TempDirectory        tempDir(s_allocator_p);
+    mqbs::MappedFileDescriptor journal;
+    mqbs::MappedFileDescriptor data;
+    createFile(&journal, tempDir, "test.bmq_journal");
+    createFile(&data, tempDir, "test.bmq_data");
+
+    {
+        PV("Start and stop without a file set");
+        mqbs::FileSetIoThread obj("bmqFileIO-test", 0, s_allocator_p);
+        ASSERT(!obj.isStarted());
+        ASSERT_EQ(obj.start(), 0);
+        ASSERT(obj.isStarted());
+        obj.stop();
+        ASSERT(!obj.isStarted());
+        obj.stop();  // No effect
+    }
+
+    {
+        PV("Destroy with a file set attached");
+        mqbs::FileSetIoThread obj("bmqFileIO-test", 0, s_allocator_p);
+        ASSERT_EQ(obj.start(), 0);
+        obj.attach(journal, 0, data, 0);
+    }
+
+    mqbs::FileSystemUtil::close(&journal);
+    mqbs::FileSystemUtil::close(&data);
+}
+
+static void test2_prefault()
+// ------------------------------------------------------------------------
+// PREFAULT
+//
+// Concerns:
+//   - Once attached, each file is prefaulted up to the prefault window
+//     ahead of its published write position, without going past the end
+//     of the file.
+//   - Nothing is synced if the sync interval is 0.
+//   - Published positions are ignored once the file set is detached.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("PREFAULT");
+
+    // The files are smaller than the prefault window.
+    BSLMF_ASSERT(k_FILE_SIZE < mqbs::FileSetIoThread::k_PREFAULT_WINDOW);
+
+    mwcu::TempDirectory        tempDir(s_allocator_p);
+    mqbs::MappedFileDescriptor journal;
+    mqbs::MappedFileDescriptor data;
+    createFile(&journal, tempDir, "test.bmq_journal");
+    createFile(&data, tempDir, "test.bmq_data");
+
+    mqbs::FileSetIoThread obj("bmqFileIO-test", 0, s_allocator_p);
+    ASSERT_EQ(obj.start(), 0);
+
+    obj.attach(journal, 0, data, 0);
+    obj.publish(1024, 4096);
+
+    ASSERT(waitForPosition(obj, FileType::e_JOURNAL, false, k_FILE_SIZE));
+    ASSERT(waitForPosition(obj, FileType::e_DATA, false, k_FILE_SIZE));
+    ASSERT_EQ(obj.numSyncs(), 0);
+    ASSERT_EQ(obj.syncPosition(FileType::e_JOURNAL), 0U);
+    ASSERT_EQ(obj.syncPosition(FileType::e_DATA), 0U);
+
+    obj.detach();
+    obj.publish(2048, 8192);
+    ASSERT_EQ(obj.prefaultPosition(FileType::e_JOURNAL), k_FILE_SIZE);
+    ASSERT_EQ(obj.prefaultPosition(FileType::e_DATA), k_FILE_SIZE);
+
+    obj.stop();
+
+    mqbs::FileSystemUtil::close(&journal);
+    mqbs::FileSystemUtil::close(&data);
+}
+
+static void test3_sync()
+// ------------------------------------------------------------------------
+// SYNC
+//
+// Concerns:
+//   - With a positive sync interval, the bytes written since the previous
+//     sync, as published, are synced in one batch per file.
+//   - Bytes written before the file set is attached are not synced.
+//   - Content written by the dispatcher thread is left unchanged.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("SYNC");
+
+    mwcu::TempDirectory        tempDir(s_allocator_p);
+    mqbs::MappedFileDescriptor journal;
+    mqbs::MappedFileDescriptor data;
+    createFile(&journal, tempDir, "test.bmq_journal");
+    createFile(&data, tempDir, "test.bmq_data");
+
+    mqbs::FileSetIoThread obj("bmqFileIO-test", 1, s_allocator_p);
+    ASSERT_EQ(obj.start(), 0);
+
+    obj.attach(journal, 60, data, 8);
+    ASSERT_EQ(obj.syncPosition(FileType::e_JOURNAL), 60U);
+    ASSERT_EQ(obj.syncPosition(FileType::e_DATA), 8U);
+
+    // Write, as the dispatcher thread would, and publish.
+
+    bsl::memset(journal.mapping() + 60, 'j', 120);
+    bsl::memset(data.mapping() + 8, 'd', 10000);
+    obj.publish(180, 10008);
+
+    ASSERT(waitForPosition(obj, FileType::e_JOURNAL, true, 180));
+    ASSERT(waitForPosition(obj, FileType::e_DATA, true, 10008));
+    ASSERT_LE(2, obj.numSyncs());
+
+    // Prefaulting does not alter the content.
+    ASSERT(waitForPosition(obj, FileType::e_DATA, false, k_FILE_SIZE));
+    ASSERT_EQ(data.mapping()[10007], 'd');
+    ASSERT_EQ(data.mapping()[10008], 0);
+
+    obj.detach();
+    obj.stop();
+
+    mqbs::FileSystemUtil::close(&journal);
+    mqbs::FileSystemUtil::close(&data);
+}
+
+static void test4_detachDuringIo()
+// ------------------------------------------------------------------------
+// DETACH DURING IO
+//
+// Concerns:
+//   - 'detach' interrupts the prefaulting and the syncing in progress,
+//     and returns once the IO thread no longer accesses the files, so
+//     that they can be unmapped right away.
+//   - Nothing is prefaulted or synced once the file set is detached.
+//   - A file set can be attached again after an interrupted sync.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("DETACH DURING IO");
+
+    const int k_NUM_ITERATIONS = 50;
+
+    mwcu::TempDirectory   tempDir(s_allocator_p);
+    mqbs::FileSetIoThread obj("bmqFileIO-test", 1, s_allocator_p);
+    ASSERT_EQ(obj.start(), 0);
+
+    for (int i = 0; i < k_NUM_ITERATIONS; ++i) {
+        mqbs::MappedFileDescriptor journal;
+        mqbs::MappedFileDescriptor data;
+        createFile(&journal, tempDir, "test.bmq_journal");
+        createFile(&data, tempDir, "test.bmq_data");
+
+        // Dirty the whole files, so that there is more than one chunk to
+        // sync, and detach at various points of the IO.
+
+        obj.attach(journal, 0, data, 0);
+        bsl::memset(journal.mapping(), 'j', k_FILE_SIZE);
+        bsl::memset(data.mapping(), 'd', k_FILE_SIZE);
+        obj.publish(k_FILE_SIZE, k_FILE_SIZE);
+        bslmt::ThreadUtil::microSleep(100 * (i % 10));
+        obj.detach();
+
+        const bsls::Types::Uint64 journalSync = obj.syncPosition(
+            FileType::e_JOURNAL);
+        const bsls::Types::Uint64 dataSync = obj.syncPosition(
+            FileType::e_DATA);
+        const bsls::Types::Uint64 dataPrefault = obj.prefaultPosition(
+            FileType::e_DATA);
+        ASSERT_LE(journalSync, k_FILE_SIZE);
+        ASSERT_LE(dataSync, k_FILE_SIZE);
+
+        // The files are unmapped right after 'detach': the IO thread must
+        // not touch them anymore.
+
+        mqbs::FileSystemUtil::close(&journal);
+        mqbs::FileSystemUtil::close(&data);
+
+        bslmt::ThreadUtil::microSleep(2000);
+        ASSERT_EQ(obj.syncPosition(FileType::e_JOURNAL), journalSync);
+        ASSERT_EQ(obj.syncPosition(FileType::e_DATA), dataSync);
+        ASSERT_EQ(obj.prefaultPosition(FileType::e_DATA), dataPrefault);
+    }
+
+    {
+        PV("Attach again after an interrupted sync");
+        mqbs::MappedFileDescriptor journal;
+        mqbs::MappedFileDescriptor data;
+        createFile(&journal, tempDir, "test.bmq_journal");
+        createFile(&data, tempDir, "test.bmq_data");
+
+        obj.attach(journal, 0, data, 0);
+        bsl::memset(data.mapping(), 'd', k_FILE_SIZE);
+        obj.publish(0, k_FILE_SIZE);
+        ASSERT(waitForPosition(obj, FileType::e_DATA, true, k_FILE_SIZE));
+
+        obj.detach();
+        mqbs::FileSystemUtil::close(&journal);
+        mqbs::FileSystemUtil::close(&data);
+    }
+
+    obj.stop();
+}
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    TEST_PROLOG(mwctst::TestHelper::e_DEFAULT);
+
+    switch (_testCase) {
+    case 0:
+    case 4: test4_detachDuringIo(); break;
+    case 3: test3_sync(); break;
+    case 2: test2_prefault(); break;
+    case 1: test1_breathingTest(); break;
+    default: {
+        cerr << "WARNING: CASE '" << _testCase << "' NOT FOUND." << endl;
+        s_testStatus = -1;
+    } break;
+    }
+
+    TEST_EPILOG(mwctst::TestHelper::e_CHECK_DEF_GBL_ALLOC);
+}
@@ -66,6 +66,7 @@
 #include <bdlf_placeholder.h>
 #include <bdlma_localsequentialallocator.h>
 #include <bdls_filesystemutil.h>
+#include <bdls_memoryutil.h>
 #include <bdlt_currenttime.h>
 #include <bdlt_datetime.h>
 #include <bdlt_epochutil.h>
@@ -84,6 +85,7 @@
 #include <bsls_timeinterval.h>
 
 // SYS
+#include <sys/mman.h>
 #include <unistd.h>
 
 namespace BloombergLP {
@@ -104,6 +106,20 @@ const double k_PARTITION_AVAILABLESPACE_SECS = 20;
 
 const int k_NAGLE_PACKET_COUNT = 100;
 
+/// Interval, in sequence numbers, at which the messages requiring strong
+/// consistency are sampled to report the latency breakdown of their ACK.
+const bsls::Types::Uint64 k_ACK_LATENCY_SAMPLING_INTERVAL = 64;
+
+/// Maximum number of sampled messages kept to report the latency of the
+/// Receipts of each node, so that a node which stopped sending Receipts
+/// does not retain them forever.
+const size_t k_MAX_RECEIPT_SAMPLES = 1024;
+
+/// Size, in bytes, of the window of the data file read ahead of the
+/// messages loaded by a reader draining a backlog.  A new read-ahead is
+/// issued once the reader went past half of the window.
+const bsls::Types::Uint64 k_READ_AHEAD_WINDOW_SIZE = 2 * 1024 * 1024;
+
 const int k_KEY_LEN = FileStoreProtocol::k_KEY_LENGTH;
 
 const unsigned int k_REQUESTED_JOURNAL_SPACE =
@@ -315,12 +331,121 @@ void FileStore::cancelUnreceipted(const DataStoreRecordKey& recordKey)
     d_unreceipted.erase(it);
 }
 
+void FileStore::releaseReceiptedRecords()
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(d_isPrimary);
+
+    if (d_unreceipted.empty()) {
+        return;  // RETURN
+    }
+
+    // Self counts as one replica; a record needs Receipts from
+    // 'd_replicationFactor - 1' other nodes.  Since Receipts are cumulative,
+    // the highest record confirmed by a quorum is the
+    // '(d_replicationFactor - 1)'-th highest Receipt across all nodes.
+
+    const int          numReceipts = d_replicationFactor - 1;
+    DataStoreRecordKey quorumKey;
+
+    if (numReceipts > 0) {
+        if (d_nodes.size() < static_cast<size_t>(numReceipts)) {
+            return;  // RETURN
+        }
+
+        bsl::vector<DataStoreRecordKey> keys(d_allocator_p);
+        keys.reserve(d_nodes.size());
+        for (NodeReceiptContexts::const_iterator cit = d_nodes.begin();
+             cit != d_nodes.end();
+             ++cit) {
+            keys.push_back(cit->second.d_key);
+        }
+
+        bsl::vector<DataStoreRecordKey>::iterator quorumIt = keys.end() -
+                                                             numReceipts;
+        bsl::nth_element(keys.begin(),
+                         quorumIt,
+                         keys.end(),
+                         DataStoreRecordKeyLess());
+        quorumKey = *quorumIt;
+    }
+
+    // 'd_unreceipted' is in the order of sequence numbers, so the records
+    // confirmed by the quorum are a prefix of it, released in one pass.
+
+    bsl::unordered_set<mqbi::Queue*> affectedQueues(d_allocator_p);
+    mqbu::StorageKey                 lastKey;
+    mqbi::Queue*                     lastQueue = 0;
+    bsls::Types::Int64               now       = 0;
+    Unreceipted::iterator            it        = d_unreceipted.begin();
+
+    while (it != d_unreceipted.end()) {
+        if (numReceipts > 0 && quorumKey < it->first) {
+            break;  // BREAK
+        }
+
+        it->second.d_handle->second.d_hasReceipt = true;
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                it->second.d_replicationTimepoint != 0)) {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+            // Sampled message: report the time it waited for the quorum of
+            // Receipts, and the total time to its ACK.
+            if (now == 0) {
+                now = mwcsys::Time::highResolutionTimer();
+            }
+            d_clusterStats_p->onPartitionEvent(
+                mqbstat::ClusterStats::PartitionEventType::
+                    e_PARTITION_RECEIPT_LATENCY,
+                d_config.partitionId(),
+                now - it->second.d_replicationTimepoint);
+            d_clusterStats_p->onPartitionEvent(
+                mqbstat::ClusterStats::PartitionEventType::
+                    e_PARTITION_ACK_LATENCY,
+                d_config.partitionId(),
+                now - it->second.d_handle->second.d_arrivalTimepoint);
+        }
+        // notify the queue
+
+        const mqbu::StorageKey& queueKey  = it->second.d_queueKey;
+        bool                    haveQueue = (queueKey == lastKey);
+        if (!haveQueue) {
+            StorageMapIter sit = d_storages.find(queueKey);
+            if (sit != d_storages.end()) {
+                haveQueue = true;
+                lastKey   = queueKey;
+                lastQueue = sit->second->queue();
+                BSLS_ASSERT_SAFE(lastQueue);
+
+                affectedQueues.insert(lastQueue);
+            }
+            // else the queue and its storage are gone; ignore the receipt
+        }
+        if (haveQueue) {
+            lastQueue->onReceipt(
+                it->second.d_guid,
+                it->second.d_qH,
+                it->second.d_handle->second.d_arrivalTimepoint);
+        }  // else the queue is gone
+        it = d_unreceipted.erase(it);
+    }
+
+    for (bsl::unordered_set<mqbi::Queue*>::iterator qit =
+             affectedQueues.begin();
+         qit != affectedQueues.end();
+         ++qit) {
+        (*qit)->queueEngine()->afterNewMessage(bmqt::MessageGUID(), 0);
+    }
+}
+
 int FileStore::openInNonRecoveryMode()
 {
     FileSetSp fileSetSp;
     int       rc = create(&fileSetSp);
     if (0 == rc) {
         d_fileSets.insert(d_fileSets.begin(), fileSetSp);
+        ++d_activeDataFileId;
     }
 
     // If error, already logged by 'create'
@@ -727,6 +852,7 @@ int FileStore::openInRecoveryMode(bsl::ostream&          errorDescription,
     FileSetSp fileSetSp;
     fileSetSp.createInplace(d_allocator_p, this, d_allocator_p);
     d_fileSets.insert(d_fileSets.begin(), fileSetSp);
+    ++d_activeDataFileId;
 
     fileSetSp->d_dataFile         = dataFd;
     fileSetSp->d_dataFileName     = recoveryFileSet.dataFile();
@@ -2768,7 +2894,12 @@ int FileStore::rollover(bsls::Types::Uint64 timestamp)
     // too.  Old file set can be archived as well after that.
 
     // Irrespective of the aliased blob buffer counter, file set can be
-    // truncated because nothing else will be written to the file.
+    // truncated because nothing else will be written to the file.  The
+    // dedicated IO thread, if any, must stop accessing it first.
+
+    if (d_ioThread_mp) {
+        d_ioThread_mp->detach();
+    }
 
     truncate(activeFileSet);
     BALL_LOG_INFO_BLOCK
@@ -2819,6 +2950,8 @@ int FileStore::rollover(bsls::Types::Uint64 timestamp)
 
     // Add 'newActiveFileSetSp' as the first element of 'd_fileSets'.
     d_fileSets.insert(d_fileSets.begin(), newActiveFileSetSp);
+    ++d_activeDataFileId;
+    attachIoThread();
 
     BALL_LOG_INFO_BLOCK
     {
@@ -3157,6 +3290,33 @@ void FileStore::truncate(FileSet* fileSet)
     }
 }
 
+void FileStore::attachIoThread()
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(0 < d_fileSets.size());
+
+    if (!d_ioThread_mp) {
+        return;  // RETURN
+    }
+
+    const FileSet* activeFileSet = d_fileSets[0].get();
+    d_ioThread_mp->attach(activeFileSet->d_journalFile,
+                          activeFileSet->d_journalFilePosition,
+                          activeFileSet->d_dataFile,
+                          activeFileSet->d_dataFilePosition);
+}
+
+void FileStore::publishWritePositions()
+{
+    if (!d_ioThread_mp) {
+        return;  // RETURN
+    }
+
+    const FileSet* activeFileSet = d_fileSets[0].get();
+    d_ioThread_mp->publish(activeFileSet->d_journalFilePosition,
+                           activeFileSet->d_dataFilePosition);
+}
+
 void FileStore::close(FileSet& fileSetRef, bool flush)
 {
     if (flush) {
@@ -3833,95 +3993,78 @@ void FileStore::processReceiptEvent(unsigned int         primaryLeaseId,
         return;  // RETURN
     }
 
-    const DataStoreRecordKey recordKey(sequenceNumber, primaryLeaseId);
-    Unreceipted::iterator    to = d_unreceipted.find(recordKey);
-    // end of of Receipt range
-
-    if (to == d_unreceipted.end()) {
-        // ignore
-        return;  // RETURN
-    }
+    // Receipts are cumulative: a Receipt from a replica confirms every
+    // record up to and including the specified one.  Only keep track of the
+    // highest Receipt per node, and ignore outdated ones.
 
-    // `to` is the end of Receipt range.  Find the start of the range
-    // using prior 'source' history and making sure not to count anything
-    // twice.
-
-    int                           nodeId = source->nodeId();
+    const DataStoreRecordKey      recordKey(sequenceNumber, primaryLeaseId);
+    const int                     nodeId = source->nodeId();
     NodeReceiptContexts::iterator itNode = d_nodes.find(nodeId);
-    Unreceipted::iterator         from;  // start of Receipt range
+    DataStoreRecordKey            previousKey;
 
     if (itNode == d_nodes.end()) {
         // no prior history about this node
         d_nodes.insert(bsl::make_pair(
             nodeId,
             NodeContext(d_config.bufferFactory(), recordKey, d_allocator_p)));
-        from = d_unreceipted.begin();
     }
     else if (itNode->second.d_key < recordKey) {
-        from = d_unreceipted.find(itNode->second.d_key);
-
-        if (from == d_unreceipted.end()) {
-            // we went past the last Receipt from this node
-            from = d_unreceipted.begin();
-        }
-        else {
-            ++from;  // `itNode->second` was the last Receipt
-        }
-
+        previousKey          = itNode->second.d_key;
         itNode->second.d_key = recordKey;
-        // next range starts at (d_unreceipted.find(itNode->second) + 1)
     }
     else {
         // This Receipt is about something already Receipted.  Ignore
         return;  // RETURN
     }
 
-    // everything in [from, to] is Receipt'ed
-    bool                             isEndOfRange = false;
-    mqbu::StorageKey                 lastKey;
-    bsl::unordered_set<mqbi::Queue*> affectedQueues(d_allocator_p);
-    mqbi::Queue*                     lastQueue = 0;
+    if (!d_receiptSamples.empty()) {
+        processReceiptSamples(source, previousKey, recordKey);
+    }
 
-    while (from != d_unreceipted.end() && !isEndOfRange) {
-        if (from->first == recordKey) {
-            // This is the last in the range
-            isEndOfRange = true;
-        }
-        if (++(from->second.d_count) >= d_replicationFactor) {
-            from->second.d_handle->second.d_hasReceipt = true;
-            // notify the queue
-
-            const mqbu::StorageKey& queueKey  = from->second.d_queueKey;
-            bool                    haveQueue = (queueKey == lastKey);
-            if (!haveQueue) {
-                StorageMapIter sit = d_storages.find(queueKey);
-                if (sit != d_storages.end()) {
-                    haveQueue = true;
-                    lastKey   = queueKey;
-                    lastQueue = sit->second->queue();
-                    BSLS_ASSERT_SAFE(lastQueue);
-
-                    affectedQueues.insert(lastQueue);
-                }
-                // else the queue and its storage are gone; ignore the receipt
-            }
-            if (haveQueue) {
-                lastQueue->onReceipt(
-                    from->second.d_guid,
-                    from->second.d_qH,
-                    from->second.d_handle->second.d_arrivalTimepoint);
-            }  // else the queue is gone
-            from = d_unreceipted.erase(from);
+    releaseReceiptedRecords();
+}
+
+void FileStore::processReceiptSamples(mqbnet::ClusterNode*      source,
+                                      const DataStoreRecordKey& previousKey,
+                                      const DataStoreRecordKey& recordKey)
+{
+    // Report the latency of the Receipt from 'source' of each sampled
+    // message in '(previousKey, recordKey]'.
+
+    mwcst::StatContext* statContext = source->statContext();
+    if (statContext) {
+        const bsls::Types::Int64 now = mwcsys::Time::highResolutionTimer();
+        const bsls::Types::Int64 k_MAX_TIMEPOINT =
+            bsl::numeric_limits<bsls::Types::Int64>::max();
+
+        ReceiptSamples::const_iterator it = bsl::upper_bound(
+            d_receiptSamples.begin(),
+            d_receiptSamples.end(),
+            bsl::make_pair(previousKey, k_MAX_TIMEPOINT));
+        for (; it != d_receiptSamples.end() && !(recordKey < it->first);
+             ++it) {
+            mqbstat::ClusterNodeStats::onReplicationReceipt(statContext,
+                                                            now - it->second);
         }
-        else {
-            ++from;
+    }
+
+    dropReceiptedSamples(recordKey);
+}
+
+void FileStore::dropReceiptedSamples(const DataStoreRecordKey& recordKey)
+{
+    DataStoreRecordKey minKey = recordKey;
+    for (NodeReceiptContexts::const_iterator cit = d_nodes.begin();
+         cit != d_nodes.end();
+         ++cit) {
+        if (cit->second.d_key < minKey) {
+            minKey = cit->second.d_key;
         }
     }
-    for (bsl::unordered_set<mqbi::Queue*>::iterator it =
-             affectedQueues.begin();
-         it != affectedQueues.end();
-         ++it) {
-        (*it)->queueEngine()->afterNewMessage(bmqt::MessageGUID(), 0);
+
+    while (!d_receiptSamples.empty() &&
+           !(minKey < d_receiptSamples.front().first)) {
+        d_receiptSamples.pop_front();
     }
 }
 
@@ -5130,9 +5273,12 @@ FileStore::FileStore(const DataStoreConfig&  config,
 , d_unreceipted(d_allocators.get("UnreceiptedRecords"))
 , d_replicationFactor(replicationFactor)
 , d_nodes(allocator)
+, d_receiptSamples(allocator)
 , d_fileSets(allocator)
+, d_activeDataFileId(0)
 , d_cluster_p(cluster)
 , d_miscWorkThreadPool_p(miscWorkThreadPool)
+, d_ioThread_mp()
 , d_storageEventBuilder(FileStoreProtocol::k_VERSION,
                         bmqp::EventType::e_STORAGE,
                         config.bufferFactory(),
@@ -5228,6 +5374,29 @@ int FileStore::open(const QueueKeyInfoMap& queueKeyInfoMap)
 
     BSLS_ASSERT_SAFE(d_isOpen);
 
+    if (d_config.hasDedicatedIoThread()) {
+        mwcu::MemOutStream threadName;
+        threadName << "bmqFileIO-" << d_config.partitionId();
+
+        d_ioThread_mp.load(
+            new (*d_allocator_p)
+                FileSetIoThread(threadName.str(),
+                                d_config.ioThreadSyncIntervalMs(),
+                                d_allocator_p),
+            d_allocator_p);
+        rc = d_ioThread_mp->start();
+        if (0 != rc) {
+            // Not fatal: the dispatcher thread will incur the page faults.
+
+            BALL_LOG_WARN << partitionDesc() << "Failed to start dedicated IO "
+                          << "thread, rc: " << rc << ".";
+            d_ioThread_mp.reset();
+        }
+        else {
+            attachIoThread();
+        }
+    }
+
     // Report cluster's partition stats
     d_clusterStats_p->setPartitionOutstandingBytes(
         d_config.partitionId(),
@@ -5254,11 +5423,17 @@ void FileStore::close(bool flush)
 
     BALL_LOG_INFO << partitionDesc() << "Closing partition. ";
 
+    if (d_ioThread_mp) {
+        d_ioThread_mp->stop();
+        d_ioThread_mp.reset();
+    }
+
     // Clear 'd_records' so that gc logic is invoked on all mapped data files.
     // Note that logic will be invoked in this thread.  Note that data file of
     // active file set will not be gc'd because its alias blob buffer count
     // will not go to 0 as its initialized with 1.
     d_unreceipted.clear();
+    d_receiptSamples.clear();
     d_records.clear();
 
     // After mapped data files have been gc'd, there should be only 1 file set
@@ -5296,16 +5471,21 @@ void FileStore::createStorage(bsl::shared_ptr<ReplicatedStorage>* storageSp,
 
     bslma::Allocator* storageAlloc = d_storageAllocatorStore.baseAllocator();
     if (storageCfg.isInMemoryValue()) {
-        storageSp->reset(new (*storageAlloc)
-                             InMemoryStorage(queueUri,
-                                             queueKey,
-                                             config().partitionId(),
-                                             domain->config(),
-                                             domain->capacityMeter(),
-                                             rdaInfo,
-                                             storageAlloc,
-                                             &d_storageAllocatorStore),
-                         storageAlloc);
+        InMemoryStorage* inMemoryStorage = new (*storageAlloc)
+            InMemoryStorage(queueUri,
+                            queueKey,
+                            config().partitionId(),
+                            domain->config(),
+                            domain->capacityMeter(),
+                            rdaInfo,
+                            storageAlloc,
+                            &d_storageAllocatorStore);
+
+        // Cold payloads of the queue, if configured to be spilled, are
+        // written next to the files of this partition.
+
+        inMemoryStorage->setSpillLocation(config().location());
+        storageSp->reset(inMemoryStorage, storageAlloc);
     }
     else if (storageCfg.isFileBackedValue()) {
         storageSp->reset(new (*storageAlloc)
@@ -5504,17 +5684,28 @@ int FileStore::writeMessageRecord(mqbi::StorageMessageAttributes* attributes,
     insertDataStoreRecord(&recordIt, key, record);
     recordIteratorToHandle(handle, recordIt);
 
-    int flags = 0;
+    int                   flags          = 0;
+    bsls::Types::Int64    writeTimepoint = 0;
+    Unreceipted::iterator unreceiptedIt;
+
     // If this requires Receipt
     if (!attributes->hasReceipt()) {
-        d_unreceipted.insert(
-            bsl::make_pair(key,
-                           ReceiptContext(queueKey,
-                                          guid,
-                                          recordIt,
-                                          1,  // receipt count
-                                          attributes->queueHandle())));
-        flags = bmqp::StorageHeaderFlags::e_RECEIPT_REQUESTED;
+        unreceiptedIt = d_unreceipted
+                            .insert(bsl::make_pair(
+                                key,
+                                ReceiptContext(queueKey,
+                                               guid,
+                                               recordIt,
+                                               attributes->queueHandle())))
+                            .first;
+        flags         = bmqp::StorageHeaderFlags::e_RECEIPT_REQUESTED;
+
+        if (d_sequenceNum % k_ACK_LATENCY_SAMPLING_INTERVAL == 0 &&
+            attributes->arrivalTimepoint() != 0) {
+            // Sample this message to report the latency breakdown of its
+            // ACK.
+            writeTimepoint = mwcsys::Time::highResolutionTimer();
+        }
     }
 
     // Replicate the message.
@@ -5524,6 +5715,29 @@ int FileStore::writeMessageRecord(mqbi::StorageMessageAttributes* attributes,
                     dataOffset,
                     totalLength);
 
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(writeTimepoint != 0)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        const bsls::Types::Int64 now = mwcsys::Time::highResolutionTimer();
+        unreceiptedIt->second.d_replicationTimepoint = now;
+
+        d_receiptSamples.push_back(bsl::make_pair(key, now));
+        if (d_receiptSamples.size() > k_MAX_RECEIPT_SAMPLES) {
+            d_receiptSamples.pop_front();
+        }
+
+        d_clusterStats_p->onPartitionEvent(
+            mqbstat::ClusterStats::PartitionEventType::
+                e_PARTITION_WRITE_LATENCY,
+            d_config.partitionId(),
+            writeTimepoint - attributes->arrivalTimepoint());
+        d_clusterStats_p->onPartitionEvent(
+            mqbstat::ClusterStats::PartitionEventType::
+                e_PARTITION_REPLICATION_LATENCY,
+            d_config.partitionId(),
+            now - writeTimepoint);
+    }
+
     // Update outstanding JOURNAL and DATA bytes.
     activeFileSet->d_outstandingBytesJournal +=
         FileStoreProtocol::k_JOURNAL_RECORD_SIZE;
@@ -6079,6 +6293,14 @@ void FileStore::processStorageEvent(const bsl::shared_ptr<bdlbb::Blob>& blob,
     rawEvent.loadStorageMessageIterator(&iter);
     BSLS_ASSERT_SAFE(iter.isValid());
 
+    // Receipts are cumulative, so only the highest record requesting one in
+    // this event needs to be Receipted, once the whole event is written.
+    // The number of Receipts sent therefore adapts to the load: the more
+    // records the primary batches per event, the fewer Receipts we send.
+
+    DataStoreRecordKey receiptKey;
+    bool               isReceiptRequested = false;
+
     while (1 == iter.next()) {
         const bmqp::StorageHeader&                header = iter.header();
         mwcu::BlobPosition                        recordPosition;
@@ -6090,7 +6312,7 @@ void FileStore::processStorageEvent(const bsl::shared_ptr<bdlbb::Blob>& blob,
                                                            blob,
                                                            partitionDesc());
         if (rc != 0) {
-            return;  // RETURN
+            break;  // BREAK
         }
 
         // Check sequence number (only if leaseId is same).  Received leaseId
@@ -6111,7 +6333,7 @@ void FileStore::processStorageEvent(const bsl::shared_ptr<bdlbb::Blob>& blob,
                 << " Record's journal offset (in words): "
                 << header.journalOffsetWords() << ". Ignoring entire event."
                 << MWCTSK_ALARMLOG_END;
-            return;  // RETURN
+            break;  // BREAK
         }
 
         if (d_primaryLeaseId == recHeader->primaryLeaseId()) {
@@ -6138,9 +6360,10 @@ void FileStore::processStorageEvent(const bsl::shared_ptr<bdlbb::Blob>& blob,
             if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(0 == rc)) {
                 if (header.flags() &
                     bmqp::StorageHeaderFlags::e_RECEIPT_REQUESTED) {
-                    issueReceipt(source,
-                                 recHeader->primaryLeaseId(),
-                                 recHeader->sequenceNumber());
+                    receiptKey         = DataStoreRecordKey(
+                        recHeader->sequenceNumber(),
+                        recHeader->primaryLeaseId());
+                    isReceiptRequested = true;
                 }
             }
         }
@@ -6192,6 +6415,14 @@ void FileStore::processStorageEvent(const bsl::shared_ptr<bdlbb::Blob>& blob,
                 << MWCTSK_ALARMLOG_END;
         }
     }  // end: while loop
+
+    publishWritePositions();
+
+    if (isReceiptRequested) {
+        issueReceipt(source,
+                     receiptKey.d_primaryLeaseId,
+                     receiptKey.d_sequenceNum);
+    }
 }
 
 int FileStore::processRecoveryEvent(const bsl::shared_ptr<bdlbb::Blob>& blob)
@@ -6813,6 +7044,8 @@ void FileStore::dispatcherFlush(bool storage, bool queues)
             }
             d_storageEventBuilder.reset();
         }
+
+        publishWritePositions();
     }
     if (queues && d_storageEventBuilder.messageCount() == 0) {
         // Empty 'd_storageEventBuilder' means it has been flushed and it is a
@@ -7112,53 +7345,30 @@ void FileStore::setReplicationFactor(int value)
         return;
     }
 
-    // Build a set of unreceipted messages whose count of persisted replicas
+    // Release the unreceipted messages whose count of persisted replicas
     // meets the new threshold replication factor.
-    bsl::unordered_set<mqbi::Queue*> affectedQueues(d_allocator_p);
+    releaseReceiptedRecords();
+}
 
-    Unreceipted::iterator it = d_unreceipted.begin();
-    mqbu::StorageKey      lastKey;
-    mqbi::Queue*          lastQueue = 0;
-    while (it != d_unreceipted.end()) {
-        if (it->second.d_count >= d_replicationFactor) {
-            it->second.d_handle->second.d_hasReceipt = true;
-            // notify the queue.
-
-            const mqbu::StorageKey& queueKey  = it->second.d_queueKey;
-            bool                    haveQueue = (queueKey == lastKey);
-            if (!haveQueue) {
-                StorageMapIter sit = d_storages.find(queueKey);
-                if (sit != d_storages.end()) {
-                    haveQueue = true;
-                    lastKey   = queueKey;
-                    lastQueue = sit->second->queue();
-                    BSLS_ASSERT_SAFE(lastQueue);
-
-                    affectedQueues.insert(lastQueue);
-                }
-                // else the queue and its storage are gone; ignore the receipt
-            }
-            if (haveQueue) {
-                lastQueue->onReceipt(
-                    it->second.d_guid,
-                    it->second.d_qH,
-                    it->second.d_handle->second.d_arrivalTimepoint);
-            }  // else the queue is gone
-            it = d_unreceipted.erase(it);
-        }
-        else {
-            // Since we have as an invariant that
-            //   unreceipted[k].d_count > unreceipted[k+1].d_count,
-            // We can safely break, once we find an entry whose count does not
-            // meet the replication factor.
-            break;
-        }
+void FileStore::processNodeUnavailable(int nodeId)
+{
+    // executed by the *DISPATCHER* thread
+
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(inDispatcherThread());
+
+    NodeReceiptContexts::iterator itNode = d_nodes.find(nodeId);
+    if (itNode == d_nodes.end()) {
+        return;  // RETURN
     }
-    for (bsl::unordered_set<mqbi::Queue*>::iterator qit =
-             affectedQueues.begin();
-         qit != affectedQueues.end();
-         ++qit) {
-        (*qit)->queueEngine()->afterNewMessage(bmqt::MessageGUID(), 0);
+
+    d_nodes.erase(itNode);
+
+    // Drop the samples which were only waiting for a Receipt from that node
+    // (all of them if no other node sent a Receipt).
+
+    if (!d_receiptSamples.empty()) {
+        dropReceiptedSamples(d_receiptSamples.back().first);
     }
 }
 
@@ -7328,6 +7538,83 @@ FileStore::getMessageLenRaw(const DataStoreRecordHandle& handle) const
     return record.d_appDataUnpaddedLen;
 }
 
+void FileStore::readAheadMessagesRaw(DataStoreReadAheadCursor*    cursor,
+                                     const DataStoreRecordHandle& handle) const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(cursor);
+    BSLS_ASSERT_SAFE(handle.isValid());
+    BSLS_ASSERT_SAFE(0 < d_fileSets.size());
+
+    const RecordIterator& recordIt = *reinterpret_cast<const RecordIterator*>(
+        &handle);
+    const DataStoreRecord& record = recordIt->second;
+    BSLS_ASSERT_SAFE(RecordType::e_MESSAGE == record.d_recordType);
+
+    const FileSet* activeFileSet = d_fileSets[0].get();
+    BSLS_ASSERT_SAFE(activeFileSet);
+
+    const bsls::Types::Uint64 offset = record.d_messageOffset;
+    bsls::Types::Uint64       begin  = cursor->d_position;
+
+    if (cursor->d_dataFileId != d_activeDataFileId ||
+        begin <= offset || begin > offset + 2 * k_READ_AHEAD_WINDOW_SIZE) {
+        // Nothing was read ahead in this data file yet (e.g., on the first
+        // call, or after a rollover), or the reader went past the window read
+        // ahead so far, or moved away from it (e.g., when a reader resumes
+        // from an earlier message): read ahead from the message onward.
+
+        begin = offset;
+    }
+    else if (begin - offset >= k_READ_AHEAD_WINDOW_SIZE / 2) {
+        // Enough data is already being read ahead of the reader.
+
+        return;  // RETURN
+    }
+
+    // Messages are only appended up to the current position in the file.
+
+    const bsls::Types::Uint64 end = bsl::min(
+        offset + k_READ_AHEAD_WINDOW_SIZE,
+        activeFileSet->d_dataFilePosition);
+    if (begin >= end) {
+        return;  // RETURN
+    }
+
+    const bsls::Types::Uint64 pageSize = bdls::MemoryUtil::pageSize();
+    const bsls::Types::Uint64 first    = begin & ~(pageSize - 1);
+    const char*               base = activeFileSet->d_dataFile.block().base();
+
+    if (begin == offset) {
+        // The reader is about to load a message which was not read ahead:
+        // report, as page faults, the pages of the message which are not
+        // resident in memory.  Note that this is checked only once per
+        // window, so that loading many messages does not cost a system call
+        // each.
+
+        const bsls::Types::Int64 numFaults =
+            FileSystemUtil::numNonResidentPages(
+                base + first,
+                offset + record.d_dataOrQlistRecordPaddedLen - first);
+        if (0 < numFaults) {
+            d_clusterStats_p->onPartitionEvent(
+                mqbstat::ClusterStats::PartitionEventType::
+                    e_PARTITION_DATA_PAGE_FAULT,
+                d_config.partitionId(),
+                numFaults);
+        }
+    }
+
+    FileSystemUtil::madvise(base + first, end - first, MADV_WILLNEED);
+    cursor->d_dataFileId = d_activeDataFileId;
+    cursor->d_position   = end;
+
+    d_clusterStats_p->onPartitionEvent(
+        mqbstat::ClusterStats::PartitionEventType::e_PARTITION_DATA_READ_AHEAD,
+        d_config.partitionId(),
+        (end - first + pageSize - 1) / pageSize);
+}
+
 void FileStore::loadCurrentFiles(mqbs::FileStoreSet* fileStoreSet) const
 {
     // PRECONDITIONS
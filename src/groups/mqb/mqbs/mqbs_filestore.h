@@ -40,6 +40,7 @@
 #include <mqbnet_cluster.h>
 #include <mqbs_datastore.h>
 #include <mqbs_fileset.h>
+#include <mqbs_filesetiothread.h>
 #include <mqbs_filestoreprotocol.h>
 #include <mqbs_mappedfiledescriptor.h>
 #include <mqbs_storagecollectionutil.h>
@@ -74,6 +75,7 @@
 #include <bsl_vector.h>
 #include <bslh_hash.h>
 #include <bslma_allocator.h>
+#include <bslma_managedptr.h>
 #include <bslma_usesbslmaallocator.h>
 #include <bslmf_nestedtraitdeclaration.h>
 #include <bsls_assert.h>
@@ -225,24 +227,25 @@ class FileStore : public DataStore {
         const bmqt::MessageGUID d_guid;
         const RecordIterator    d_handle;
         mqbi::QueueHandle*      d_qH;
-        int                     d_count;  // Primary initializes this as
-                                          // zero and increments for each
-                                          // Receipt. When it reaches
-                                          // 'd_replicationFactor', the
-                                          // Receipt'ed messages are
-                                          // strong consistent.
+        bsls::Types::Int64      d_replicationTimepoint;
+        // HiRes timer value at which
+        // the message was replicated if
+        // it is sampled to report the
+        // latency of its ACK, and 0
+        // otherwise.
 
         ReceiptContext(const mqbu::StorageKey&  queueKey,
                        const bmqt::MessageGUID& guid,
                        const RecordIterator&    handle,
-                       int                      count,
                        mqbi::QueueHandle*       qH);
     };
 
     struct NodeContext {
         DataStoreRecordKey d_key;
-        // last Receipt from/to this
-        // node (Replica/Primary).
+        // highest Receipt from/to this
+        // node (Replica/Primary).  Since
+        // Receipts are cumulative, it
+        // confirms all prior records.
         bdlbb::Blob d_blob;
         // Receipt to this node.
         bsl::shared_ptr<mwcu::AtomicState> d_state;
@@ -259,6 +262,13 @@ class FileStore : public DataStore {
     /// Map of NodeId -> NodeContext to assist in Receipt processing
     typedef bsl::unordered_map<int, NodeContext> NodeReceiptContexts;
 
+    /// Record key and HiRes timer value at which a message sampled to report
+    /// the latency of its Receipts was replicated.
+    typedef bsl::pair<DataStoreRecordKey, bsls::Types::Int64> ReceiptSample;
+
+    /// Sampled messages, in the order of their record keys.
+    typedef bsl::deque<ReceiptSample> ReceiptSamples;
+
   private:
     // DATA
     bslma::Allocator* d_allocator_p;
@@ -323,12 +333,21 @@ class FileStore : public DataStore {
 
     Unreceipted d_unreceipted;
     // Ordered list of records pending
-    // Receipt.
+    // Receipt, in the order of their
+    // sequence numbers.  Records are
+    // released by prefix once a quorum
+    // of replicas Receipted them.
 
     int d_replicationFactor;
 
     NodeReceiptContexts d_nodes;
 
+    ReceiptSamples d_receiptSamples;
+    // Sampled messages not yet Receipted
+    // by all the nodes, to report the
+    // latency of the Receipts of each
+    // node.
+
     DataStoreRecordKey d_lastRecoveredMessage;
 
     FileSets d_fileSets;
@@ -342,6 +361,13 @@ class FileStore : public DataStore {
     // rollover file set, which is then
     // inserted to the front of the list.
 
+    bsls::Types::Uint64 d_activeDataFileId;
+    // Identifier of the data file of the
+    // file set at index 0 of
+    // 'd_fileSets', incremented each time
+    // a file set is inserted there (see
+    // 'readAheadMessagesRaw').
+
     mqbnet::Cluster* d_cluster_p;
 
     bdlmt::FixedThreadPool* d_miscWorkThreadPool_p;
@@ -349,6 +375,11 @@ class FileStore : public DataStore {
     // work that can be offloaded to
     // non-partition-dispatcher threads.
 
+    bslma::ManagedPtr<FileSetIoThread> d_ioThread_mp;
+    // Dedicated thread prefaulting and
+    // syncing the files of the active file
+    // set, or null if not configured.
+
     bmqp::StorageEventBuilder d_storageEventBuilder;
     // Storage event builder to use.
 
@@ -419,6 +450,14 @@ class FileStore : public DataStore {
     /// current sizes.  Note that files are not closed.
     void truncate(FileSet* fileSet);
 
+    /// Have the dedicated IO thread, if any, serve the files of the active
+    /// file set.
+    void attachIoThread();
+
+    /// Publish the write positions of the active file set to the dedicated
+    /// IO thread, if any.
+    void publishWritePositions();
+
     /// Optionally flush, unmap and close all files contained in the
     /// specified `fileSetRef`.  Note that files are *not* truncated.  Also
     /// note that no data is written to any file in this method.  This
@@ -603,6 +642,25 @@ class FileStore : public DataStore {
     /// still pending receipt of quorum Receipts.
     void cancelUnreceipted(const DataStoreRecordKey& recordKey);
 
+    /// Release the longest prefix of the records pending Receipt which
+    /// have been Receipted by `d_replicationFactor - 1` nodes, as indicated
+    /// by the highest Receipt received from each node, notifying the
+    /// corresponding queues.  The behavior is undefined unless self is the
+    /// primary.
+    void releaseReceiptedRecords();
+
+    /// Report the latency of the Receipt from the specified `source` of
+    /// each sampled message having a record key in the range from the
+    /// specified `previousKey` (excluded) to the specified `recordKey`
+    /// (included), and drop the samples Receipted by all the nodes.
+    void processReceiptSamples(mqbnet::ClusterNode*      source,
+                               const DataStoreRecordKey& previousKey,
+                               const DataStoreRecordKey& recordKey);
+
+    /// Drop the samples having a record key lower than or equal to the
+    /// specified `recordKey` which have been Receipted by all the nodes.
+    void dropReceiptedSamples(const DataStoreRecordKey& recordKey);
+
     /// Send Replication Receipt to the specified `node` confirming the
     /// receipt of message with the specified `primaryLeaseId` and
     /// `sequenceNumber`.
@@ -894,6 +952,12 @@ class FileStore : public DataStore {
     /// Set the replication factor for strong consistency to `factor`.
     void setReplicationFactor(int factor);
 
+    /// Forget the Receipts received from the node having the specified
+    /// `nodeId`, which is no longer available, so that it does not retain
+    /// the sampled messages it did not Receipt.  Note that the records
+    /// already released are not affected.
+    void processNodeUnavailable(int nodeId);
+
     /// Set the ignore Crc32c flag to the specified `value`.  We should only
     /// set this to true during testing.
     void setIgnoreCrc32c(bool value);
@@ -950,6 +1014,10 @@ class FileStore : public DataStore {
     unsigned int getMessageLenRaw(const DataStoreRecordHandle& handle) const
         BSLS_KEYWORD_OVERRIDE;
 
+    void readAheadMessagesRaw(DataStoreReadAheadCursor*    cursor,
+                              const DataStoreRecordHandle& handle) const
+        BSLS_KEYWORD_OVERRIDE;
+
     // ACCESSORS
     int processorId() const;
 
@@ -1073,13 +1141,12 @@ inline FileStore::ReceiptContext::ReceiptContext(
     const mqbu::StorageKey&  queueKey,
     const bmqt::MessageGUID& guid,
     const RecordIterator&    handle,
-    int                      count,
     mqbi::QueueHandle*       qH)
 : d_queueKey(queueKey)
 , d_guid(guid)
 , d_handle(handle)
 , d_qH(qH)
-, d_count(count)
+, d_replicationTimepoint(0)
 {
     // NOTHING
 }
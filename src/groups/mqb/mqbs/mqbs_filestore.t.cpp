@@ -36,6 +36,9 @@
 #include <bmqt_uri.h>
 
 // MWC
+#include <mwcst_statcontext.h>
+#include <mwcst_statutil.h>
+#include <mwcst_statvalue.h>
 #include <mwcsys_time.h>
 #include <mwcu_memoutstream.h>
 
@@ -166,7 +169,10 @@ struct Tester {
 
   public:
     // CREATORS
-    Tester()
+
+    /// Create a `Tester` object for a cluster made of self and the
+    /// specified `numPeers` other nodes.
+    explicit Tester(int numPeers = 0)
     : d_scheduler(bsls::SystemClockType::e_MONOTONIC, s_allocator_p)
     , d_bufferFactory(1024, s_allocator_p)
     , d_itemPool(mqbnet::Channel::k_ITEM_SIZE, s_allocator_p)
@@ -218,6 +224,23 @@ struct Tester {
             "tcp://localhost:34567");
         d_clusterNodesCfg.push_back(d_clusterNodeCfg);
 
+        for (int i = 1; i <= numPeers; ++i) {
+            mqbcfg::ClusterNode peerCfg(d_clusterNodeCfg, s_allocator_p);
+            mwcu::MemOutStream  osstr(s_allocator_p);
+
+            osstr << "peer" << i;
+            peerCfg.name().assign(osstr.str().data(), osstr.str().length());
+            peerCfg.id() = k_NODE_ID + i;
+
+            osstr.reset();
+            osstr << "tcp://localhost:" << (34567 + i);
+            peerCfg.transport().makeTcp().endpoint().assign(
+                osstr.str().data(),
+                osstr.str().length());
+
+            d_clusterNodesCfg.push_back(peerCfg);
+        }
+
         d_clusterCfg.nodes() = d_clusterNodesCfg;
 
         d_cluster_mp.load(new (*s_allocator_p)
@@ -228,6 +251,9 @@ struct Tester {
                           s_allocator_p);
         d_node_p = d_cluster_mp->lookupNode(k_NODE_ID);
 
+        // Replicated records are not sent to the peers.
+        d_cluster_mp->_setDisableBroadcast(true);
+
         d_dsCfg
             .setScheduler(&d_scheduler)
             // provide a scheduler which has not been started
@@ -744,10 +770,54 @@ struct Tester {
         return true;
     }
 
+    /// Write to the specified `fs` a message record of the queue having the
+    /// specified `queueKey`, which requests Receipts, and load its handle
+    /// into the specified `handle`.  Optionally specify the
+    /// `arrivalTimepoint` of the message, so that it may be sampled to
+    /// report the latency of its ACK.  Return 0 on success, or a non-zero
+    /// value otherwise.
+    int writeUnreceiptedMessage(mqbs::FileStore*             fs,
+                                mqbs::DataStoreRecordHandle* handle,
+                                const mqbu::StorageKey&      queueKey,
+                                bsls::Types::Int64 arrivalTimepoint = 0)
+    {
+        mqbi::StorageMessageAttributes attributes(
+            bdlt::EpochUtil::convertToTimeT64(bdlt::CurrentTime::utc()),
+            1,  // refCount
+            bmqp::MessagePropertiesInfo(),
+            bmqt::CompressionAlgorithmType::e_NONE,
+            false,  // hasReceipt
+            0,      // queueHandle
+            0,      // crc32c
+            arrivalTimepoint);
+
+        bmqt::MessageGUID guid;
+        mqbu::MessageGUIDUtil::generateGUID(&guid);
+
+        bsl::shared_ptr<bdlbb::Blob> appData;
+        appData.createInplace(s_allocator_p, &d_bufferFactory, s_allocator_p);
+        bdlbb::BlobUtil::append(appData.get(), "payload", 7);
+
+        return fs->writeMessageRecord(&attributes,
+                                      handle,
+                                      guid,
+                                      appData,
+                                      bsl::shared_ptr<bdlbb::Blob>(),
+                                      queueKey);
+    }
+
+    mqbmock::Dispatcher& dispatcher() { return d_dispatcher; }
+
     // ACCESSORS
     mqbs::FileStore& fileSore() const { return *(d_fs_mp); }
 
     mqbnet::ClusterNode* node() const { return d_node_p; }
+
+    /// Return the peer node having the specified 1-based `index`.
+    mqbnet::ClusterNode* peer(int index) const
+    {
+        return d_cluster_mp->lookupNode(k_NODE_ID + index);
+    }
 };
 
 // ============================================================================
@@ -970,6 +1040,360 @@ static void test2_printTest()
     fs.close();
 }
 
+static void test3_readAheadMessages()
+// ------------------------------------------------------------------------
+// READ AHEAD MESSAGES
+//
+// Concerns:
+//   - The data following a message is read ahead on the first call made
+//     with a cursor, up to the end of the data written so far.
+//   - A message whose data was already read ahead with a cursor does not
+//     cause a new read ahead with that cursor.
+//   - Each cursor keeps track of its own reader.
+//   - A cursor used in another data file (e.g., before a rollover) is
+//     reset.
+//
+// Testing:
+//   readAheadMessagesRaw(DataStoreReadAheadCursor *, handle)
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("READ AHEAD MESSAGES");
+
+    s_ignoreCheckDefAlloc = true;
+
+    Tester           tester;
+    mqbs::FileStore& fs = tester.fileSore();
+    BSLS_ASSERT_OPT(fs.open() == 0);
+
+    // Set primary.
+    unsigned int        primaryLeaseId = 1;
+    bsls::Types::Uint64 seqNum         = 1;
+    fs.setPrimary(tester.node(), primaryLeaseId);
+
+    // Write various records to the partition.
+    SyncPointOffsetPairs          spOffsetPairs(s_allocator_p);
+    bsl::vector<HandleRecordPair> records(s_allocator_p);
+
+    const size_t        k_NUM_RECORDS     = 70;
+    bsls::Types::Uint64 numRecordsWritten = 0;
+    BSLS_ASSERT_OPT(tester.writeRecords(&fs,
+                                        &records,
+                                        &spOffsetPairs,
+                                        &primaryLeaseId,
+                                        &seqNum,
+                                        &numRecordsWritten,
+                                        k_NUM_RECORDS));
+
+    bsl::vector<mqbs::DataStoreRecordHandle> messages(s_allocator_p);
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (mqbs::RecordType::e_MESSAGE == records[i].second.d_recordType) {
+            messages.push_back(records[i].first);
+        }
+    }
+    BSLS_ASSERT_OPT(2 < messages.size());
+
+    mqbs::DataStoreReadAheadCursor cursor;
+    ASSERT_EQ(0ULL, cursor.d_dataFileId);
+    ASSERT_EQ(0ULL, cursor.d_position);
+
+    PV("First message");
+    fs.readAheadMessagesRaw(&cursor, messages.front());
+    ASSERT_NE(0ULL, cursor.d_dataFileId);
+    ASSERT_NE(0ULL, cursor.d_position);
+
+    const mqbs::DataStoreReadAheadCursor readAhead = cursor;
+
+    PV("Messages already read ahead");
+    for (size_t i = 1; i < messages.size(); ++i) {
+        fs.readAheadMessagesRaw(&cursor, messages[i]);
+        ASSERT_EQ_D(i, readAhead.d_dataFileId, cursor.d_dataFileId);
+        ASSERT_EQ_D(i, readAhead.d_position, cursor.d_position);
+    }
+
+    PV("Another reader");
+    mqbs::DataStoreReadAheadCursor otherCursor;
+    fs.readAheadMessagesRaw(&otherCursor, messages.back());
+    ASSERT_EQ(readAhead.d_dataFileId, otherCursor.d_dataFileId);
+    ASSERT_EQ(readAhead.d_position, otherCursor.d_position);
+
+    PV("Cursor from another data file");
+    cursor.d_dataFileId = readAhead.d_dataFileId + 1;
+    cursor.d_position   = readAhead.d_position + 1;
+    fs.readAheadMessagesRaw(&cursor, messages.back());
+    ASSERT_EQ(readAhead.d_dataFileId, cursor.d_dataFileId);
+    ASSERT_EQ(readAhead.d_position, cursor.d_position);
+
+    // Loading messages is unaffected.
+    for (size_t i = 0; i < messages.size(); ++i) {
+        bsl::shared_ptr<bdlbb::Blob>   appData;
+        bsl::shared_ptr<bdlbb::Blob>   options;
+        mqbi::StorageMessageAttributes attributes;
+        fs.loadMessageRaw(&appData, &options, &attributes, messages[i]);
+        ASSERT_EQ_D(i,
+                    fs.getMessageLenRaw(messages[i]),
+                    static_cast<unsigned int>(appData->length()));
+    }
+
+    fs.close();
+}
+
+static void test4_receipts()
+// ------------------------------------------------------------------------
+// RECEIPTS
+//
+// Concerns:
+//   - Records pending Receipt are released, in order, once Receipted by
+//     'replicationFactor - 1' peers, a Receipt confirming all the records
+//     up to the one it is about.
+//   - A Receipt older than the last one from the same peer is ignored.
+//   - A Receipt about a record already released does not release any
+//     other record, nor count twice.
+//   - Lowering the replication factor releases the records Receipted by
+//     enough peers for the new replication factor.
+//
+// Testing:
+//   processReceiptEvent
+//   setReplicationFactor
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("RECEIPTS");
+
+    s_ignoreCheckDefAlloc = true;
+
+    Tester           tester(3);  // numPeers
+    mqbs::FileStore& fs = tester.fileSore();
+    BSLS_ASSERT_OPT(fs.open() == 0);
+    ASSERT_EQ(4U, fs.clusterSize());
+
+    tester.dispatcher()._setInDispatcherThread(true);
+
+    // Set primary.
+    const unsigned int primaryLeaseId = 1;
+    fs.setPrimary(tester.node(), primaryLeaseId);
+    fs.setReplicationFactor(3);
+
+    const mqbu::StorageKey queueKey(mqbu::StorageKey::BinaryRepresentation(),
+                                    "12345");
+
+    mqbs::DataStoreRecordHandle queueHandle;
+    BSLS_ASSERT_OPT(
+        fs.writeQueueCreationRecord(
+            &queueHandle,
+            bmqt::Uri("bmq://si.amw.bmq.stats/queue", s_allocator_p),
+            queueKey,
+            AppIdKeyPairs(),
+            bdlt::EpochUtil::convertToTimeT64(bdlt::CurrentTime::utc()),
+            true) == 0);  // isNewQueue
+
+    // Write the messages, and keep track of their sequence numbers.
+
+    const int                   k_NUM_MESSAGES = 5;
+    mqbs::DataStoreRecordHandle handles[k_NUM_MESSAGES];
+    bsls::Types::Uint64         seqNums[k_NUM_MESSAGES];
+    for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+        BSLS_ASSERT_OPT(
+            tester.writeUnreceiptedMessage(&fs, &handles[i], queueKey) == 0);
+        seqNums[i] = fs.sequenceNumber();
+        ASSERT_EQ_D(i, false, fs.hasReceipt(handles[i]));
+    }
+
+    PV("Receipt from a single peer");
+    fs.processReceiptEvent(primaryLeaseId, seqNums[3], tester.peer(1));
+    for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+        ASSERT_EQ_D(i, false, fs.hasReceipt(handles[i]));
+    }
+
+    PV("Out of order Receipts");
+    // Older than the last Receipt of peer 1: ignored.
+    fs.processReceiptEvent(primaryLeaseId, seqNums[1], tester.peer(1));
+    for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+        ASSERT_EQ_D(i, false, fs.hasReceipt(handles[i]));
+    }
+
+    // Peers 1 and 2 Receipted up to messages 3 and 1 respectively.
+    fs.processReceiptEvent(primaryLeaseId, seqNums[1], tester.peer(2));
+    for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+        ASSERT_EQ_D(i, i <= 1, fs.hasReceipt(handles[i]));
+    }
+
+    // Peers 1 and 2 Receipted up to messages 3 and 4 respectively.
+    fs.processReceiptEvent(primaryLeaseId, seqNums[4], tester.peer(2));
+    for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+        ASSERT_EQ_D(i, i <= 3, fs.hasReceipt(handles[i]));
+    }
+
+    PV("Receipt below the released prefix");
+    // Peer 3 Receipted up to message 0, which was already released.
+    fs.processReceiptEvent(primaryLeaseId, seqNums[0], tester.peer(3));
+    for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+        ASSERT_EQ_D(i, i <= 3, fs.hasReceipt(handles[i]));
+    }
+
+    // Peer 1 Receipted again up to message 2, which was already released.
+    fs.processReceiptEvent(primaryLeaseId, seqNums[2], tester.peer(1));
+    for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+        ASSERT_EQ_D(i, i <= 3, fs.hasReceipt(handles[i]));
+    }
+
+    PV("Replication factor change");
+    // Message 4 was only Receipted by peer 2.
+    fs.setReplicationFactor(4);
+    ASSERT_EQ(false, fs.hasReceipt(handles[4]));
+
+    fs.setReplicationFactor(2);
+    for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+        ASSERT_EQ_D(i, true, fs.hasReceipt(handles[i]));
+    }
+
+    fs.close();
+}
+
+static void test5_receiptsOfUnavailableNode()
+// ------------------------------------------------------------------------
+// RECEIPTS OF UNAVAILABLE NODE
+//
+// Concerns:
+//   - The Receipt latency of a sampled message is reported once for each
+//     peer whose Receipt covers it.
+//   - Once a peer is unavailable, the sampled messages it did not Receipt
+//     are no longer retained for it, even if it comes back.
+//   - The records already released are not affected.
+//
+// Testing:
+//   processNodeUnavailable
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("RECEIPTS OF UNAVAILABLE NODE");
+
+    s_ignoreCheckDefAlloc = true;
+
+    Tester           tester(2);  // numPeers
+    mqbs::FileStore& fs = tester.fileSore();
+    BSLS_ASSERT_OPT(fs.open() == 0);
+
+    tester.dispatcher()._setInDispatcherThread(true);
+
+    // Give each peer a stat context, to which its Receipt latencies are
+    // reported.
+
+    bsl::shared_ptr<mwcst::StatContext> nodesStatContext =
+        mqbstat::ClusterStatsUtil::initializeStatContextClusterNodes(
+            2,  // historySize
+            s_allocator_p);
+    for (int i = 1; i <= 2; ++i) {
+        mwcu::MemOutStream osstr(s_allocator_p);
+        osstr << "peer" << i;
+
+        bsl::shared_ptr<mwcst::StatContext> statContext(
+            nodesStatContext->addSubcontext(
+                mwcst::StatContextConfiguration(osstr.str(), s_allocator_p)),
+            s_allocator_p);
+        tester.peer(i)->setStatContext(statContext);
+    }
+
+    // Set primary.
+    const unsigned int primaryLeaseId = 1;
+    fs.setPrimary(tester.node(), primaryLeaseId);
+    fs.setReplicationFactor(2);
+
+    const mqbu::StorageKey queueKey(mqbu::StorageKey::BinaryRepresentation(),
+                                    "12345");
+
+    mqbs::DataStoreRecordHandle queueHandle;
+    BSLS_ASSERT_OPT(
+        fs.writeQueueCreationRecord(
+            &queueHandle,
+            bmqt::Uri("bmq://si.amw.bmq.stats/queue", s_allocator_p),
+            queueKey,
+            AppIdKeyPairs(),
+            bdlt::EpochUtil::convertToTimeT64(bdlt::CurrentTime::utc()),
+            true) == 0);  // isNewQueue
+
+    // Write enough messages for several of them to be sampled, and keep
+    // track of their sequence numbers.  Peer 2 Receipts the first one right
+    // away.
+
+    const int k_NUM_MESSAGES = 2 * 64 + 1;
+
+    bsl::vector<mqbs::DataStoreRecordHandle> handles(s_allocator_p);
+    bsl::vector<bsls::Types::Uint64>         seqNums(s_allocator_p);
+    handles.resize(k_NUM_MESSAGES);
+    seqNums.resize(k_NUM_MESSAGES);
+    for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+        BSLS_ASSERT_OPT(tester.writeUnreceiptedMessage(
+                            &fs,
+                            &handles[i],
+                            queueKey,
+                            mwcsys::Time::highResolutionTimer()) == 0);
+        seqNums[i] = fs.sequenceNumber();
+
+        if (i == 0) {
+            fs.processReceiptEvent(primaryLeaseId, seqNums[0], tester.peer(2));
+        }
+    }
+
+    // Return the number of Receipt latencies reported for the peer having
+    // the specified 1-based 'INDEX'.
+#define NUM_RECEIPT_LATENCIES(INDEX)                                          \
+    mwcst::StatUtil::events(                                                  \
+        tester.peer(INDEX)->statContext()->value(                             \
+            mwcst::StatContext::DMCST_DIRECT_VALUE,                           \
+            tester.peer(INDEX)->statContext()->valueIndex(                    \
+                "replication_receipt_time")),                                 \
+        mwcst::StatValue::SnapshotLocation(0, 0))
+
+    PV("Receipts of the sampled messages");
+    fs.processReceiptEvent(primaryLeaseId,
+                           seqNums[k_NUM_MESSAGES - 1],
+                           tester.peer(1));
+    for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+        ASSERT_EQ_D(i, true, fs.hasReceipt(handles[i]));
+    }
+
+    nodesStatContext->snapshot();
+    const bsls::Types::Int64 numSamples = NUM_RECEIPT_LATENCIES(1);
+    ASSERT_LE(2, numSamples);
+    ASSERT_EQ(0, NUM_RECEIPT_LATENCIES(2));
+
+    // Peer 2 Receipts the first half of the messages.
+    fs.processReceiptEvent(primaryLeaseId,
+                           seqNums[k_NUM_MESSAGES / 2],
+                           tester.peer(2));
+
+    nodesStatContext->snapshot();
+    const bsls::Types::Int64 numPeer2Samples = NUM_RECEIPT_LATENCIES(2);
+    ASSERT_LT(0, numPeer2Samples);
+    ASSERT_LT(numPeer2Samples, numSamples);
+
+    PV("Unavailable peer");
+    fs.processNodeUnavailable(tester.peer(2)->nodeId());
+
+    // Peer 2 comes back, and Receipts all the messages: the samples were
+    // dropped when it became unavailable.
+    fs.processReceiptEvent(primaryLeaseId,
+                           seqNums[k_NUM_MESSAGES - 1],
+                           tester.peer(2));
+
+    nodesStatContext->snapshot();
+    ASSERT_EQ(numPeer2Samples, NUM_RECEIPT_LATENCIES(2));
+    ASSERT_EQ(numSamples, NUM_RECEIPT_LATENCIES(1));
+    for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+        ASSERT_EQ_D(i, true, fs.hasReceipt(handles[i]));
+    }
+
+    // Unknown node: no-op.
+    fs.processNodeUnavailable(tester.peer(2)->nodeId() + 10);
+
+#undef NUM_RECEIPT_LATENCIES
+
+    // The stat contexts of the peers must not outlive their parent.
+    for (int i = 1; i <= 2; ++i) {
+        tester.peer(i)->setStatContext(bsl::shared_ptr<mwcst::StatContext>());
+    }
+
+    fs.close();
+}
+
 }  // close unnamed namespace
 
 // ============================================================================
@@ -986,6 +1410,9 @@ int main(int argc, char* argv[])
 
     switch (_testCase) {
     case 0:
+    case 5: test5_receiptsOfUnavailableNode(); break;
+    case 4: test4_receipts(); break;
+    case 3: test3_readAheadMessages(); break;
     case 2: test2_printTest(); break;
     case 1: test1_breathingTest(); break;
     default: {
@@ -150,7 +150,9 @@
 // BDE
 #include <bdlb_string.h>
 #include <bdls_filesystemutil.h>
+#include <bdls_memoryutil.h>
 #include <bdls_pathutil.h>
+#include <bsl_algorithm.h>
 #include <bsl_ostream.h>
 #include <bsls_assert.h>
 #include <bsls_platform.h>
@@ -644,6 +646,83 @@ void FileSystemUtil::madvise(void*               mapping,
     ::madvise(static_cast<char*>(mapping), size, advice);
 }
 
+bsls::Types::Int64
+FileSystemUtil::numNonResidentPages(const void*         address,
+                                    bsls::Types::Uint64 size)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(address);
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    // Number of pages queried with one call to 'mincore'
+    enum { k_NUM_PAGES_PER_CALL = 256 };
+
+    const bsls::Types::Uint64 pageSize = bdls::MemoryUtil::pageSize();
+    const bsls::Types::Uint64 start =
+        reinterpret_cast<bsls::Types::Uint64>(address);
+    const bsls::Types::Uint64 begin = start & ~(pageSize - 1);
+    const bsls::Types::Uint64 end   = start + size;
+
+    unsigned char      residency[k_NUM_PAGES_PER_CALL];
+    bsls::Types::Int64 numNonResident = 0;
+
+    for (bsls::Types::Uint64 chunk = begin; chunk < end;
+         chunk += k_NUM_PAGES_PER_CALL * pageSize) {
+        const bsls::Types::Uint64 chunkSize = bsl::min<bsls::Types::Uint64>(
+            end - chunk,
+            k_NUM_PAGES_PER_CALL * pageSize);
+        const bsls::Types::Uint64 numPages = (chunkSize + pageSize - 1) /
+                                             pageSize;
+
+        if (0 != ::mincore(reinterpret_cast<void*>(chunk),
+                           chunkSize,
+                           residency)) {
+            return -1;  // RETURN
+        }
+
+        for (bsls::Types::Uint64 i = 0; i < numPages; ++i) {
+            if (0 == (residency[i] & 1)) {
+                ++numNonResident;
+            }
+        }
+    }
+
+    return numNonResident;
+#else
+    (void)address;
+    (void)size;  // Compiler happiness
+
+    return -1;
+#endif
+}
+
+void FileSystemUtil::prefault(char* address, bsls::Types::Uint64 size)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(address);
+
+    const bsls::Types::Uint64 pageSize = bdls::MemoryUtil::pageSize();
+    const bsls::Types::Uint64 start =
+        reinterpret_cast<bsls::Types::Uint64>(address);
+    const bsls::Types::Uint64 begin = start & ~(pageSize - 1);
+    const bsls::Types::Uint64 end   = start + size;
+
+#if defined(BSLS_PLATFORM_OS_LINUX) && defined(MADV_POPULATE_WRITE)
+    // Available since linux 5.14.  Unlike touching the pages, this populates
+    // writable entries, so that the next write does not fault at all.
+
+    if (0 == ::madvise(reinterpret_cast<void*>(begin),
+                       end - begin,
+                       MADV_POPULATE_WRITE)) {
+        return;  // RETURN
+    }
+#endif
+
+    for (bsls::Types::Uint64 page = begin; page < end; page += pageSize) {
+        (void)*reinterpret_cast<const volatile char*>(page);
+    }
+}
+
 int FileSystemUtil::flush(void*               mapping,
                           bsls::Types::Uint64 size,
                           bsl::ostream&       errorDescription)
@@ -145,6 +145,22 @@ struct FileSystemUtil {
     /// `size`, and `advice`.
     static void madvise(void* mapping, bsls::Types::Uint64 size, int advice);
 
+    /// Return the number of pages spanned by the memory-mapped segment of
+    /// the specified `size` starting at the specified `address` which are
+    /// not resident in memory, that is for which an access would cause a
+    /// major page fault, or a negative value if this information is not
+    /// available.  Note that this method only has effect on Linux.
+    static bsls::Types::Int64 numNonResidentPages(const void*         address,
+                                                  bsls::Types::Uint64 size);
+
+    /// Populate the page tables of the memory-mapped segment of the
+    /// specified `size` starting at the specified `address`, so that a
+    /// subsequent write to it does not cause a major page fault.  The
+    /// content of the segment is left unchanged.  Note that writable page
+    /// table entries are populated if the OS supports it, otherwise each
+    /// page is read.
+    static void prefault(char* address, bsls::Types::Uint64 size);
+
     /// Flush the memory-mapped `mapping` segment up to the specified
     /// `size`.  Return zero on success, a non-zero value otherwise with
     /// specified `errorDescription` containing a detailed error.
@@ -25,11 +25,14 @@
 // MWC
 #include <mwcma_countingallocatorstore.h>
 #include <mwcsys_time.h>
+#include <mwcu_memoutstream.h>
 #include <mwcu_printutil.h>
 
 // BDE
+#include <bdls_pathutil.h>
 #include <bsl_algorithm.h>
 #include <bsl_iostream.h>
+#include <bsl_limits.h>
 #include <bsl_utility.h>
 #include <bslma_allocator.h>
 #include <bsls_annotation.h>
@@ -42,12 +45,167 @@ namespace {
 
 const int k_GC_MESSAGES_BATCH_SIZE = 1000;  // how many to process in one run
 
+// Number of payload bytes written to the spill file in one run, which bounds
+// the time the queue dispatcher thread spends spilling.
+const bsls::Types::Int64 k_SPILL_BATCH_BYTES = 1024 * 1024;
+
 }
 
 // ---------------------
 // class InMemoryStorage
 // ---------------------
 
+// PRIVATE MANIPULATORS
+void InMemoryStorage::insertItem(
+    const bmqt::MessageGUID&              msgGUID,
+    const bsl::shared_ptr<bdlbb::Blob>&   appData,
+    const bsl::shared_ptr<bdlbb::Blob>&   options,
+    const mqbi::StorageMessageAttributes& attributes)
+{
+    const bool allSpilled = d_firstResident == d_items.end();
+
+    bsl::pair<ItemsMapIter, bool> result = d_items.insert(
+        bsl::make_pair(msgGUID, Item(appData, options, attributes)),
+        attributes.arrivalTimepoint());
+    if (!result.second) {
+        return;  // RETURN
+    }
+
+    if (allSpilled) {
+        d_firstResident = result.first;
+    }
+    d_numResidentBytes += result.first->second.residentLength();
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+            isSpillEnabled() && d_maxResidentBytes > 0 &&
+            d_numResidentBytes > d_maxResidentBytes)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        // Spilling at least as many bytes as were just added brings the
+        // resident bytes back within the budget.
+
+        spillColdItems(attributes.arrivalTimestamp(),
+                       bsl::numeric_limits<int>::max(),
+                       bsl::max(k_SPILL_BATCH_BYTES,
+                                static_cast<bsls::Types::Int64>(
+                                    result.first->second.residentLength())));
+    }
+}
+
+void InMemoryStorage::onErase(const ItemsMapIter& it)
+{
+    if (it == d_firstResident) {
+        ++d_firstResident;
+    }
+
+    const Item& item = it->second;
+    if (item.isSpilled()) {
+        BSLS_ASSERT_SAFE(d_spillFile_mp);
+        d_spillFile_mp->release(item.spillHandle());
+    }
+    else {
+        d_numResidentBytes -= item.residentLength();
+    }
+}
+
+int InMemoryStorage::spillColdItems(bsls::Types::Uint64 secondsFromEpoch,
+                                    int                 limit,
+                                    bsls::Types::Int64  bytesLimit)
+{
+    int                numSpilled      = 0;
+    bsls::Types::Int64 numBytesSpilled = 0;
+
+    for (; numSpilled < limit && numBytesSpilled < bytesLimit &&
+           d_firstResident != d_items.end();
+         ++d_firstResident, ++numSpilled) {
+        Item& item = d_firstResident->second;
+
+        const bsls::Types::Uint64 arrival =
+            item.attributes().arrivalTimestamp();
+        const bool isOverBudget = d_maxResidentBytes > 0 &&
+                                  d_numResidentBytes > d_maxResidentBytes;
+        const bool isTooOld =
+            d_spillAgeSeconds > 0 && secondsFromEpoch > arrival &&
+            (secondsFromEpoch - arrival) >
+                static_cast<bsls::Types::Uint64>(d_spillAgeSeconds);
+        if (!isOverBudget && !isTooOld) {
+            break;  // BREAK
+        }
+
+        if (!d_spillFile_mp) {
+            d_spillFile_mp.load(new (*d_allocator_p) SpillFile(d_allocator_p),
+                                d_allocator_p);
+        }
+
+        mwcu::MemOutStream errorDesc;
+        int                rc = 0;
+        if (!d_spillFile_mp->isOpen()) {
+            // Open the file on first use, or after it was closed when this
+            // storage was purged.
+
+            mwcu::MemOutStream fileName;
+            fileName << "bmq_" << d_partitionId << "_" << d_key << ".spill";
+
+            bsl::string path(d_spillLocation, d_allocator_p);
+            bdls::PathUtil::appendRaw(&path,
+                                      fileName.str().data(),
+                                      fileName.str().length());
+            rc = d_spillFile_mp->open(errorDesc, path);
+        }
+
+        SpillFile::Handle handle;
+        if (0 == rc) {
+            rc = d_spillFile_mp->write(&handle,
+                                       errorDesc,
+                                       *item.appData(),
+                                       item.options().get());
+        }
+
+        if (0 != rc) {
+            // Keep the payloads in memory from now on: the capacity meter
+            // still bounds the memory used by this queue.
+
+            BALL_LOG_ERROR << "#STORAGE_SPILL_FAILURE "
+                           << "Failed to spill messages of queue '"
+                           << queueUri() << "' & queueKey '" << queueKey()
+                           << "', spilling is now disabled for this queue. "
+                           << "Reason: " << errorDesc.str();
+            d_spillLocation.clear();
+            break;  // BREAK
+        }
+
+        numBytesSpilled += item.residentLength();
+        d_numResidentBytes -= item.residentLength();
+        item.spill(handle);
+    }
+
+    return numSpilled;
+}
+
+// PRIVATE ACCESSORS
+int InMemoryStorage::loadSpilled(bsl::shared_ptr<bdlbb::Blob>* appData,
+                                 bsl::shared_ptr<bdlbb::Blob>* options,
+                                 const Item&                   item) const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(item.isSpilled());
+    BSLS_ASSERT_SAFE(d_spillFile_mp);
+
+    mwcu::MemOutStream errorDesc;
+    const int          rc = d_spillFile_mp->read(appData,
+                                        options,
+                                        errorDesc,
+                                        item.spillHandle());
+    if (0 != rc) {
+        BALL_LOG_ERROR << "#STORAGE_SPILL_FAILURE "
+                       << "Failed to load spilled message of queue '"
+                       << queueUri() << "' & queueKey '" << queueKey()
+                       << "'. Reason: " << errorDesc.str();
+    }
+
+    return rc;
+}
+
 // CREATORS
 InMemoryStorage::InMemoryStorage(const bmqt::Uri&        uri,
                                  const mqbu::StorageKey& queueKey,
@@ -78,6 +236,12 @@ InMemoryStorage::InMemoryStorage(const bmqt::Uri&        uri,
 , d_nullAppKey()
 , d_isEmpty(1)
 , d_defaultRdaInfo(defaultRdaInfo)
+, d_spillLocation(allocator)
+, d_maxResidentBytes(0)
+, d_spillAgeSeconds(0)
+, d_numResidentBytes(0)
+, d_firstResident(d_items.end())
+, d_spillFile_mp()
 {
     BSLS_ASSERT_SAFE(0 <= d_ttlSeconds);  // Broadcast queues can use 0 for TTL
 }
@@ -102,9 +266,26 @@ int InMemoryStorage::configure(
                                 limits.bytesWatermarkRatio());
     d_ttlSeconds = messageTtl;
 
+    if (config.isInMemoryValue()) {
+        d_maxResidentBytes = config.inMemory().maxResidentBytes();
+        d_spillAgeSeconds  = config.inMemory().spillAgeSeconds();
+    }
+    else {
+        d_maxResidentBytes = 0;
+        d_spillAgeSeconds  = 0;
+    }
+
     return 0;
 }
 
+void InMemoryStorage::setSpillLocation(const bslstl::StringRef& location)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(d_items.empty());
+
+    d_spillLocation.assign(location.data(), location.length());
+}
+
 void InMemoryStorage::setQueue(mqbi::Queue* queue)
 {
     d_queue_p = queue;
@@ -199,9 +380,7 @@ InMemoryStorage::put(mqbi::StorageMessageAttributes*     attributes,
                         : mqbi::StorageResult::e_LIMIT_BYTES);  // RETURN
         }
 
-        d_items.insert(bsl::make_pair(msgGUID,
-                                      Item(appData, options, *attributes)),
-                       attributes->arrivalTimepoint());
+        insertItem(msgGUID, appData, options, *attributes);
 
         d_virtualStorageCatalog.put(msgGUID,
                                     msgSize,
@@ -246,9 +425,7 @@ InMemoryStorage::put(mqbi::StorageMessageAttributes*     attributes,
                             storageKeys.size());  // Bump up
     }
     else {
-        d_items.insert(bsl::make_pair(msgGUID,
-                                      Item(appData, options, *attributes)),
-                       attributes->arrivalTimepoint());
+        insertItem(msgGUID, appData, options, *attributes);
     }
 
     return mqbi::StorageResult::e_SUCCESS;  // RETURN
@@ -299,8 +476,9 @@ InMemoryStorage::remove(const bmqt::MessageGUID& msgGUID,
 
     BSLS_ASSERT_SAFE(!d_virtualStorageCatalog.hasMessage(msgGUID));
 
-    int msgLen = it->second.appData()->length();
+    int msgLen = it->second.appDataLength();
 
+    onErase(it);
     d_items.erase(it);
 
     // Update resource usage
@@ -333,6 +511,12 @@ InMemoryStorage::removeAll(const mqbu::StorageKey& appKey)
         d_items.clear();
         d_capacityMeter.clear();
 
+        d_firstResident    = d_items.end();
+        d_numResidentBytes = 0;
+        if (d_spillFile_mp) {
+            d_spillFile_mp->close();
+        }
+
         if (d_queue_p) {
             d_queue_p->stats()->onEvent(
                 mqbstat::QueueStatsDomain::EventType::e_PURGE,
@@ -389,7 +573,7 @@ InMemoryStorage::removeAll(const mqbu::StorageKey& appKey)
             // This appKey was the last outstanding client for this message.
             // Message can now be deleted.
 
-            int msgLen = it->second.appData()->length();
+            int msgLen = it->second.appDataLength();
             d_capacityMeter.remove(1, msgLen);
             if (d_queue_p) {
                 d_queue_p->queueEngine()->beforeMessageRemoved(guid);
@@ -405,6 +589,7 @@ InMemoryStorage::removeAll(const mqbu::StorageKey& appKey)
             // zero).  So we just delete the guid from the underlying (this)
             // storage.
 
+            onErase(it);
             d_items.erase(it);
         }
 
@@ -452,7 +637,7 @@ int InMemoryStorage::gcExpiredMessages(
             break;  // BREAK
         }
 
-        int msgLen = cit->second.appData()->length();
+        int msgLen = cit->second.appDataLength();
         d_capacityMeter.remove(1, msgLen);
         if (d_queue_p) {
             d_queue_p->queueEngine()->beforeMessageRemoved(cit->first);
@@ -465,10 +650,19 @@ int InMemoryStorage::gcExpiredMessages(
         // storage.
         d_virtualStorageCatalog.remove(cit->first,
                                        mqbu::StorageKey::k_NULL_KEY);
+        onErase(cit);
         d_items.erase(cit, now);
         ++numMsgsDeleted;
     }
 
+    if (isSpillEnabled() && d_spillAgeSeconds > 0) {
+        // Spill the payload of the messages which are now cold.
+
+        spillColdItems(secondsFromEpoch,
+                       k_GC_MESSAGES_BATCH_SIZE,
+                       k_SPILL_BATCH_BYTES);
+    }
+
     if (d_queue_p && (numMsgsDeleted > 0)) {
         d_queue_p->stats()->onEvent(
             mqbstat::QueueStatsDomain::EventType::e_GC_MESSAGE,
@@ -501,8 +695,17 @@ InMemoryStorage::get(bsl::shared_ptr<bdlbb::Blob>*   appData,
         return mqbi::StorageResult::e_GUID_NOT_FOUND;  // RETURN
     }
 
-    *appData    = it->second.appData();
-    *options    = it->second.options();
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(it->second.isSpilled())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        if (0 != loadSpilled(appData, options, it->second)) {
+            return mqbi::StorageResult::e_INVALID_OPERATION;  // RETURN
+        }
+    }
+    else {
+        *appData = it->second.appData();
+        *options = it->second.options();
+    }
     *attributes = it->second.attributes();
 
     return mqbi::StorageResult::e_SUCCESS;
@@ -593,6 +796,8 @@ InMemoryStorageIterator::InMemoryStorageIterator(
     const ItemsMapConstIter& initialPosition)
 : d_storage_p(storage)
 , d_iterator(initialPosition)
+, d_appData_sp()
+, d_options_sp()
 {
     // NOTHING
 }
@@ -602,5 +807,27 @@ InMemoryStorageIterator::~InMemoryStorageIterator()
     // NOTHING
 }
 
+// PRIVATE ACCESSORS
+void InMemoryStorageIterator::loadSpilled() const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(d_iterator->second.isSpilled());
+
+    if (d_appData_sp) {
+        return;  // RETURN
+    }
+
+    // On failure, an empty payload is returned for this message, and the
+    // failure is logged.
+
+    if (0 != d_storage_p->loadSpilled(&d_appData_sp,
+                                      &d_options_sp,
+                                      d_iterator->second)) {
+        d_appData_sp.createInplace(d_storage_p->d_allocator_p,
+                                   d_storage_p->d_allocator_p);
+        d_options_sp.reset();
+    }
+}
+
 }  // close package namespace
 }  // close enterprise namespace
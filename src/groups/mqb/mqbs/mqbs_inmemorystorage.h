@@ -28,12 +28,46 @@
 // memory.  'mqbs::InMemoryStorageIterator' provides an iterator implementation
 // of 'mqbi::StorageIterator' protocol and can be used to iterate over messages
 // stored in the in-memory storage.
+//
+/// Spilling
+///--------
+// When a spill location is set and the storage is configured with a
+// 'maxResidentBytes' budget or a 'spillAgeSeconds' threshold, the payload of
+// the oldest messages exceeding the budget, or older than the threshold, is
+// moved to an 'mqbs::SpillFile' in that location.  Only the attributes and a
+// compact reference to the payload of a spilled message stay in memory, so
+// that a queue can hold a deep backlog with bounded memory.  The payload of a
+// spilled message is reloaded from the file, without being made resident
+// again, each time it is retrieved for delivery.  Since messages are spilled
+// in arrival order, the resident messages are always the most recent ones.
+// The budget is enforced whenever a message is added, and the age threshold
+// each time expired messages are garbage-collected.
+//
+// The spill file is accessed synchronously by the queue dispatcher thread,
+// and the time it stalls that thread is bounded as follows:
+//: o Adding a message spills at most 1 MiB of payloads, or the payload of
+//:   the message added if it is larger, which is enough to bring the
+//:   resident bytes back within the budget.  A garbage collection spills at
+//:   most 1 MiB of payloads, the next ones resuming where it stopped.  The
+//:   spill file is never synced, so these writes normally complete in the
+//:   page cache of the file system.
+//: o Retrieving a spilled message reads its payload, and only its payload,
+//:   from the spill file.
+//: o Releasing a spilled payload returns its pages to the file system with
+//:   one call which does not access the data.
+//
+// Note that 'mqbs::FileBackedStorage' has no such mechanism because its items
+// only hold handles to the records of the message in the partition's files:
+// the payloads are never copied in memory, but read from the mapped data file
+// when delivered, and the attributes are likewise read from the journal each
+// time they are accessed, so there is nothing to evict from the storage.
 
 // MQB
 
 #include <mqbconfm_messages.h>
 #include <mqbi_storage.h>
 #include <mqbs_replicatedstorage.h>
+#include <mqbs_spillfile.h>
 #include <mqbs_virtualstoragecatalog.h>
 #include <mqbu_capacitymeter.h>
 #include <mqbu_storagekey.h>
@@ -92,6 +126,11 @@ class InMemoryStorage_Item {
 
     mqbi::StorageMessageAttributes d_attributes;
 
+    SpillFile::Handle d_spillHandle;
+    // Reference to the payload of this item in the spill file, valid only
+    // if this item was spilled, in which case `d_appData` and `d_options`
+    // are null.
+
   public:
     // CREATORS
     InMemoryStorage_Item();
@@ -109,12 +148,30 @@ class InMemoryStorage_Item {
     setAttributes(const mqbi::StorageMessageAttributes& value);
     mqbi::StorageMessageAttributes& attributes();
 
+    /// Release the payload of this item, which was written to a spill file
+    /// at the specified `handle`.
+    void spill(const SpillFile::Handle& handle);
+
     void reset();
 
     // ACCESSORS
     const bsl::shared_ptr<bdlbb::Blob>&   appData() const;
     const bsl::shared_ptr<bdlbb::Blob>&   options() const;
     const mqbi::StorageMessageAttributes& attributes() const;
+
+    /// Return true if the payload of this item was spilled.
+    bool isSpilled() const;
+
+    /// Return the reference to the spilled payload of this item.  The
+    /// behavior is undefined unless `isSpilled()`.
+    const SpillFile::Handle& spillHandle() const;
+
+    /// Return the length of the application data of this item.
+    int appDataLength() const;
+
+    /// Return the number of bytes of the payload of this item held in
+    /// memory.
+    int residentLength() const;
 };
 
 // =====================
@@ -223,6 +280,30 @@ class InMemoryStorage BSLS_KEYWORD_FINAL : public ReplicatedStorage {
 
     bmqp::RdaInfo d_defaultRdaInfo;
     // Use in all 'put' operations.
+
+    bsl::string d_spillLocation;
+    // Directory of the spill file, or empty if
+    // spilling is not supported.
+
+    bsls::Types::Int64 d_maxResidentBytes;
+    // Budget of payload bytes held in memory,
+    // or 0 if unlimited.
+
+    bsls::Types::Int64 d_spillAgeSeconds;
+    // Age after which payloads are spilled, or
+    // 0 if never.
+
+    bsls::Types::Int64 d_numResidentBytes;
+    // Number of payload bytes held in memory.
+
+    ItemsMapIter d_firstResident;
+    // Oldest item whose payload was not
+    // spilled, or end.  All the items before
+    // it are spilled, and none after it.
+
+    bslma::ManagedPtr<SpillFile> d_spillFile_mp;
+    // Spill file, created on first use.
+
   private:
     // NOT IMPLEMENTED
     InMemoryStorage(const InMemoryStorage&) BSLS_KEYWORD_DELETED;
@@ -230,6 +311,43 @@ class InMemoryStorage BSLS_KEYWORD_FINAL : public ReplicatedStorage {
     /// Not implemented
     InMemoryStorage& operator=(const InMemoryStorage&) BSLS_KEYWORD_DELETED;
 
+  private:
+    // PRIVATE MANIPULATORS
+
+    /// Insert into the items an item for the message having the specified
+    /// `msgGUID`, `appData`, `options` and `attributes`, and spill the
+    /// oldest items if this exceeds the memory budget.
+    void insertItem(const bmqt::MessageGUID&              msgGUID,
+                    const bsl::shared_ptr<bdlbb::Blob>&   appData,
+                    const bsl::shared_ptr<bdlbb::Blob>&   options,
+                    const mqbi::StorageMessageAttributes& attributes);
+
+    /// Update the spilling state before the item at the specified `it` is
+    /// erased from the items.
+    void onErase(const ItemsMapIter& it);
+
+    /// Spill, in arrival order, the payload of the resident items while
+    /// the memory budget is exceeded or while they arrived more than the
+    /// spill age before the specified `secondsFromEpoch`, up to the
+    /// specified `limit` items, and stopping once at least the specified
+    /// `bytesLimit` bytes were spilled.  Return the number of items
+    /// spilled.
+    int spillColdItems(bsls::Types::Uint64 secondsFromEpoch,
+                       int                 limit,
+                       bsls::Types::Int64  bytesLimit);
+
+    // PRIVATE ACCESSORS
+
+    /// Return true if payloads should be spilled.
+    bool isSpillEnabled() const;
+
+    /// Load into the specified `appData` and `options` the payload of the
+    /// spilled specified `item`.  Return 0 on success, or a non-zero value
+    /// otherwise.
+    int loadSpilled(bsl::shared_ptr<bdlbb::Blob>* appData,
+                    bsl::shared_ptr<bdlbb::Blob>* options,
+                    const Item&                   item) const;
+
   public:
     // TRAITS
     BSLMF_NESTED_TRAIT_DECLARATION(InMemoryStorage, bslma::UsesBslmaAllocator)
@@ -253,6 +371,13 @@ class InMemoryStorage BSLS_KEYWORD_FINAL : public ReplicatedStorage {
     virtual ~InMemoryStorage() BSLS_KEYWORD_OVERRIDE;
 
     // MANIPULATORS
+
+    /// Allow the payload of messages to be spilled to a file in the
+    /// specified `location` directory, according to the configuration of
+    /// this storage.  The behavior is undefined unless this storage is
+    /// empty.
+    void setSpillLocation(const bslstl::StringRef& location);
+
     //   (virtual mqbi::Storage)
 
     /// Configure this storage using the specified `config` and `limits`.
@@ -387,6 +512,11 @@ class InMemoryStorage BSLS_KEYWORD_FINAL : public ReplicatedStorage {
     removeVirtualStorage(const mqbu::StorageKey& appKey) BSLS_KEYWORD_OVERRIDE;
 
     // ACCESSORS
+
+    /// Return the number of bytes of the payloads of the messages of this
+    /// storage held in memory, i.e. not spilled.
+    bsls::Types::Int64 numResidentBytes() const;
+
     //   (virtual mqbi::Storage)
 
     /// Return the URI of the queue this storage is associated with.
@@ -538,6 +668,19 @@ class InMemoryStorageIterator : public mqbi::StorageIterator {
     ItemsMapConstIter d_iterator;  // Internal iterator representing the
                                    // current position
 
+    mutable bsl::shared_ptr<bdlbb::Blob> d_appData_sp;
+    // Payload reloaded from the spill file,
+    // if the current item was spilled.
+
+    mutable bsl::shared_ptr<bdlbb::Blob> d_options_sp;
+
+  private:
+    // PRIVATE ACCESSORS
+
+    /// Reload the payload of the current item, which was spilled, unless
+    /// already done.
+    void loadSpilled() const;
+
   public:
     // CREATORS
 
@@ -602,6 +745,10 @@ class InMemoryStorageIterator : public mqbi::StorageIterator {
     /// Reset the iterator to point to first item, if any, in the underlying
     /// storage.
     void reset() BSLS_KEYWORD_OVERRIDE;
+
+    /// Do nothing: this iterator does not need to be resynchronized with
+    /// the underlying storage.
+    void resume() BSLS_KEYWORD_OVERRIDE;
 };
 
 // ============================================================================
@@ -617,6 +764,7 @@ inline InMemoryStorage_Item::InMemoryStorage_Item()
 : d_appData()
 , d_options()
 , d_attributes()
+, d_spillHandle()
 {
 }
 
@@ -627,6 +775,7 @@ inline InMemoryStorage_Item::InMemoryStorage_Item(
 : d_appData(appData)
 , d_options(options)
 , d_attributes(attributes)
+, d_spillHandle()
 {
 }
 
@@ -657,10 +806,21 @@ inline mqbi::StorageMessageAttributes& InMemoryStorage_Item::attributes()
     return d_attributes;
 }
 
+inline void InMemoryStorage_Item::spill(const SpillFile::Handle& handle)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(handle.isValid());
+
+    d_spillHandle = handle;
+    d_appData.reset();
+    d_options.reset();
+}
+
 inline void InMemoryStorage_Item::reset()
 {
     d_appData.reset();
     d_options.reset();
+    d_spillHandle = SpillFile::Handle();
 }
 
 // ACCESSORS
@@ -682,6 +842,30 @@ InMemoryStorage_Item::attributes() const
     return d_attributes;
 }
 
+inline bool InMemoryStorage_Item::isSpilled() const
+{
+    return d_spillHandle.isValid();
+}
+
+inline const SpillFile::Handle& InMemoryStorage_Item::spillHandle() const
+{
+    return d_spillHandle;
+}
+
+inline int InMemoryStorage_Item::appDataLength() const
+{
+    return isSpilled() ? d_spillHandle.d_appDataLength : d_appData->length();
+}
+
+inline int InMemoryStorage_Item::residentLength() const
+{
+    if (isSpilled()) {
+        return 0;  // RETURN
+    }
+
+    return d_appData->length() + (d_options ? d_options->length() : 0);
+}
+
 // ---------------------
 // class InMemoryStorage
 // ---------------------
@@ -711,6 +895,11 @@ InMemoryStorage::removeVirtualStorage(const mqbu::StorageKey& appKey)
 }
 
 // ACCESSORS
+inline bsls::Types::Int64 InMemoryStorage::numResidentBytes() const
+{
+    return d_numResidentBytes;
+}
+
 //   (virtual mqbi::Storage)
 inline const bmqt::Uri& InMemoryStorage::queueUri() const
 {
@@ -786,7 +975,7 @@ InMemoryStorage::getMessageSize(int*                     msgSize,
         return mqbi::StorageResult::e_GUID_NOT_FOUND;  // RETURN
     }
 
-    *msgSize = it->second.appData()->length();
+    *msgSize = it->second.appDataLength();
     return mqbi::StorageResult::e_SUCCESS;
 }
 
@@ -824,6 +1013,13 @@ inline mqbu::CapacityMeter* InMemoryStorage::capacityMeter()
     return &d_capacityMeter;
 }
 
+// PRIVATE ACCESSORS
+inline bool InMemoryStorage::isSpillEnabled() const
+{
+    return !d_spillLocation.empty() &&
+           (d_maxResidentBytes > 0 || d_spillAgeSeconds > 0);
+}
+
 // ACCESSORS
 //   (virtual mqbs::ReplicatedStorage)
 inline int InMemoryStorage::partitionId() const
@@ -858,6 +1054,14 @@ InMemoryStorageIterator::appData() const
     // PRECONDITIONS
     BSLS_ASSERT_SAFE(!atEnd());
 
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+            d_iterator->second.isSpilled())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        loadSpilled();
+        return d_appData_sp;  // RETURN
+    }
+
     return d_iterator->second.appData();
 }
 
@@ -867,6 +1071,14 @@ InMemoryStorageIterator::options() const
     // PRECONDITIONS
     BSLS_ASSERT_SAFE(!atEnd());
 
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+            d_iterator->second.isSpilled())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        loadSpilled();
+        return d_options_sp;  // RETURN
+    }
+
     return d_iterator->second.options();
 }
 
@@ -896,12 +1108,21 @@ inline bool InMemoryStorageIterator::advance()
     BSLS_ASSERT_SAFE(!atEnd());
 
     ++d_iterator;
+    d_appData_sp.reset();
+    d_options_sp.reset();
     return !atEnd();
 }
 
 inline void InMemoryStorageIterator::reset()
 {
     d_iterator = d_storage_p->d_items.begin();
+    d_appData_sp.reset();
+    d_options_sp.reset();
+}
+
+inline void InMemoryStorageIterator::resume()
+{
+    // NOTHING
 }
 
 }  // close package namespace
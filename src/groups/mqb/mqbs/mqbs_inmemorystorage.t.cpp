@@ -38,6 +38,7 @@
 
 // MWC
 #include <mwcu_memoutstream.h>
+#include <mwcu_tempdirectory.h>
 
 // BDE
 #include <ball_log.h>
@@ -88,6 +89,7 @@ using namespace bsl;
 //   capacityMeter_limitBytes
 // - garbageCollect
 // - addQueueOpRecordHandle
+// - spillColdMessages
 //-----------------------------------------------------------------------------
 
 // ============================================================================
@@ -1574,6 +1576,231 @@ TEST_F(Test, addQueueOpRecordHandle)
     ASSERT(d_tester.storage().queueOpRecordHandles()[0] == handle);
 }
 
+TEST_F(Test, spillColdMessages)
+// ------------------------------------------------------------------------
+// SPILL COLD MESSAGES
+//
+// Concerns:
+//   - Once the resident bytes budget is exceeded, the payload of the
+//     oldest messages is spilled to a file, so that the resident bytes
+//     stay within the budget.
+//   - Spilled messages are retrieved unchanged, by 'get' as well as by
+//     iterators, without being made resident again, and can be removed
+//     like resident messages.
+//
+// Testing:
+//   - setSpillLocation(...)
+//   - configure(...) with 'maxResidentBytes'
+//   - numResidentBytes()
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("SPILL COLD MESSAGES");
+
+    const int k_MSG_COUNT    = 10;
+    const int k_NUM_RESIDENT = 3;
+    const int k_DATA_SIZE    = static_cast<int>(sizeof(int));
+
+    mwcu::TempDirectory tempDir(s_allocator_p);
+    d_tester.storage().setSpillLocation(tempDir.path());
+
+    mqbconfm::Storage config;
+    mqbconfm::Limits  limits;
+
+    // 'addMessages' uses the same blob for the application data and the
+    // options of each message.
+    const int k_MAX_RESIDENT_BYTES = k_NUM_RESIDENT * 2 * k_DATA_SIZE;
+    config.makeInMemory().maxResidentBytes() = k_MAX_RESIDENT_BYTES;
+
+    limits.messages()               = k_DEFAULT_MSG;
+    limits.messagesWatermarkRatio() = 0.8;
+    limits.bytes()                  = k_DEFAULT_BYTES;
+    limits.bytesWatermarkRatio()    = 0.8;
+
+    mwcu::MemOutStream errDescription(s_allocator_p);
+    ASSERT_EQ(d_tester.storage().configure(errDescription,
+                                           config,
+                                           limits,
+                                           k_INT64_MAX,
+                                           0),  // maxDeliveryAttempts
+              0);
+
+    const mqbi::Storage::StorageKeys storageKeys;
+    bsl::vector<bmqt::MessageGUID>   guids(s_allocator_p);
+
+    ASSERT_EQ(d_tester.addMessages(&guids, storageKeys, k_MSG_COUNT),
+              mqbi::StorageResult::e_SUCCESS);
+    ASSERT_EQ(d_tester.storage().numResidentBytes(), k_MAX_RESIDENT_BYTES);
+    ASSERT_EQ(d_tester.storage().numBytes(k_NULL_KEY),
+              k_MSG_COUNT * k_DATA_SIZE);
+
+    PV("Get");
+    for (int i = 0; i < k_MSG_COUNT; ++i) {
+        bsl::shared_ptr<bdlbb::Blob>   appData;
+        bsl::shared_ptr<bdlbb::Blob>   options;
+        mqbi::StorageMessageAttributes attributes;
+
+        ASSERT_EQ_D(i,
+                    d_tester.storage().get(&appData,
+                                           &options,
+                                           &attributes,
+                                           guids[i]),
+                    mqbi::StorageResult::e_SUCCESS);
+        ASSERT_EQ_D(i, appData->length(), k_DATA_SIZE);
+        ASSERT_EQ_D(i,
+                    *(reinterpret_cast<int*>(appData->buffer(0).data())),
+                    i);
+        ASSERT_EQ_D(i, options->length(), k_DATA_SIZE);
+        ASSERT_EQ_D(i, attributes.arrivalTimestamp(), unsigned(i));
+
+        int msgSize = 0;
+        ASSERT_EQ_D(i,
+                    d_tester.storage().getMessageSize(&msgSize, guids[i]),
+                    mqbi::StorageResult::e_SUCCESS);
+        ASSERT_EQ_D(i, msgSize, k_DATA_SIZE);
+    }
+    ASSERT_EQ(d_tester.storage().numResidentBytes(), k_MAX_RESIDENT_BYTES);
+
+    PV("Iterate");
+    bslma::ManagedPtr<mqbi::StorageIterator> iterator =
+        d_tester.storage().getIterator(k_NULL_KEY);
+    for (int i = 0; i < k_MSG_COUNT; ++i) {
+        ASSERT_EQ_D(i, iterator->atEnd(), false);
+        ASSERT_EQ_D(i, iterator->guid(), guids[i]);
+        ASSERT_EQ_D(
+            i,
+            *(reinterpret_cast<int*>(iterator->appData()->buffer(0).data())),
+            i);
+        ASSERT_EQ_D(i, iterator->options()->length(), k_DATA_SIZE);
+        iterator->advance();
+    }
+    ASSERT(iterator->atEnd());
+
+    PV("Remove");
+    int msgSize = 0;
+    ASSERT_EQ(d_tester.storage().remove(guids[0], &msgSize, true),
+              mqbi::StorageResult::e_SUCCESS);
+    ASSERT_EQ(msgSize, k_DATA_SIZE);
+    ASSERT_EQ(d_tester.storage().numResidentBytes(), k_MAX_RESIDENT_BYTES);
+    ASSERT_EQ(d_tester.storage().remove(guids[k_MSG_COUNT - 1],
+                                        &msgSize,
+                                        true),
+              mqbi::StorageResult::e_SUCCESS);
+    ASSERT_EQ(msgSize, k_DATA_SIZE);
+    ASSERT_EQ(d_tester.storage().numResidentBytes(),
+              k_MAX_RESIDENT_BYTES - 2 * k_DATA_SIZE);
+    ASSERT_EQ(d_tester.storage().numMessages(k_NULL_KEY), k_MSG_COUNT - 2);
+    ASSERT_EQ(d_tester.storage().numBytes(k_NULL_KEY),
+              (k_MSG_COUNT - 2) * k_DATA_SIZE);
+
+    ASSERT_EQ(d_tester.storage().removeAll(k_NULL_KEY),
+              mqbi::StorageResult::e_SUCCESS);
+    ASSERT_EQ(d_tester.storage().numMessages(k_NULL_KEY), 0);
+    ASSERT_EQ(d_tester.storage().numResidentBytes(), 0);
+}
+
+TEST_F(Test, spillOldMessages)
+// ------------------------------------------------------------------------
+// SPILL OLD MESSAGES
+//
+// Concerns:
+//   - When expired messages are garbage-collected, the payload of the
+//     messages older than the spill age is spilled, even without a
+//     resident bytes budget, and the payload of the others is not.
+//   - Spilled messages are retrieved unchanged.
+//
+// Testing:
+//   - configure(...) with 'spillAgeSeconds'
+//   - gcExpiredMessages(...)
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("SPILL OLD MESSAGES");
+
+    const int k_MSG_COUNT   = 10;
+    const int k_SPILL_AGE   = 5;
+    const int k_DATA_SIZE   = static_cast<int>(sizeof(int));
+    const int k_ITEM_LENGTH = 2 * k_DATA_SIZE;
+    // 'addMessages' uses the same blob for the application data and the
+    // options of each message.
+
+    mwcu::TempDirectory tempDir(s_allocator_p);
+    d_tester.storage().setSpillLocation(tempDir.path());
+
+    mqbconfm::Storage config;
+    mqbconfm::Limits  limits;
+
+    config.makeInMemory().spillAgeSeconds() = k_SPILL_AGE;
+
+    limits.messages()               = k_DEFAULT_MSG;
+    limits.messagesWatermarkRatio() = 0.8;
+    limits.bytes()                  = k_DEFAULT_BYTES;
+    limits.bytesWatermarkRatio()    = 0.8;
+
+    mwcu::MemOutStream errDescription(s_allocator_p);
+    ASSERT_EQ(d_tester.storage().configure(errDescription,
+                                           config,
+                                           limits,
+                                           k_INT64_MAX,
+                                           0),  // maxDeliveryAttempts
+              0);
+
+    const mqbi::Storage::StorageKeys storageKeys;
+    bsl::vector<bmqt::MessageGUID>   guids(s_allocator_p);
+
+    // The message 'i' arrives at 'i' seconds from epoch.
+    ASSERT_EQ(d_tester.addMessages(&guids, storageKeys, k_MSG_COUNT),
+              mqbi::StorageResult::e_SUCCESS);
+    ASSERT_EQ(d_tester.storage().numResidentBytes(),
+              k_MSG_COUNT * k_ITEM_LENGTH);
+
+    PV("Nothing old enough");
+    bsls::Types::Uint64 latestMsgTimestamp = 0;
+    bsls::Types::Int64  configuredTtlValue = 0;
+    ASSERT_EQ(d_tester.storage().gcExpiredMessages(&latestMsgTimestamp,
+                                                   &configuredTtlValue,
+                                                   k_SPILL_AGE),
+              0);
+    ASSERT_EQ(d_tester.storage().numResidentBytes(),
+              k_MSG_COUNT * k_ITEM_LENGTH);
+
+    PV("Spill the 3 oldest messages");
+    ASSERT_EQ(d_tester.storage().gcExpiredMessages(&latestMsgTimestamp,
+                                                   &configuredTtlValue,
+                                                   k_SPILL_AGE + 3),
+              0);
+    ASSERT_EQ(d_tester.storage().numResidentBytes(),
+              (k_MSG_COUNT - 3) * k_ITEM_LENGTH);
+    ASSERT_EQ(d_tester.storage().numMessages(k_NULL_KEY), k_MSG_COUNT);
+
+    PV("Get");
+    for (int i = 0; i < k_MSG_COUNT; ++i) {
+        bsl::shared_ptr<bdlbb::Blob>   appData;
+        bsl::shared_ptr<bdlbb::Blob>   options;
+        mqbi::StorageMessageAttributes attributes;
+
+        ASSERT_EQ_D(i,
+                    d_tester.storage().get(&appData,
+                                           &options,
+                                           &attributes,
+                                           guids[i]),
+                    mqbi::StorageResult::e_SUCCESS);
+        ASSERT_EQ_D(i,
+                    *(reinterpret_cast<int*>(appData->buffer(0).data())),
+                    i);
+        ASSERT_EQ_D(i, options->length(), k_DATA_SIZE);
+    }
+
+    PV("Spill all the messages");
+    ASSERT_EQ(d_tester.storage().gcExpiredMessages(&latestMsgTimestamp,
+                                                   &configuredTtlValue,
+                                                   k_SPILL_AGE + 100),
+              0);
+    ASSERT_EQ(d_tester.storage().numResidentBytes(), 0);
+
+    ASSERT_EQ(d_tester.storage().removeAll(k_NULL_KEY),
+              mqbi::StorageResult::e_SUCCESS);
+    ASSERT_EQ(d_tester.storage().numMessages(k_NULL_KEY), 0);
+}
+
 // ============================================================================
 //                                 MAIN PROGRAM
 // ----------------------------------------------------------------------------
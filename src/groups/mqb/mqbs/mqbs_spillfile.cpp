@@ -0,0 +1,321 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// mqbs_spillfile.cpp                                                 -*-C++-*-
+#include <mqbs_spillfile.h>
+
+#include <mqbscm_version.h>
+// BDE
+#include <bsl_cerrno.h>
+#include <bsl_cstring.h>
+#include <bsls_assert.h>
+#include <bsls_platform.h>
+
+// SYS
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+#include <linux/falloc.h>
+#endif
+
+namespace BloombergLP {
+namespace mqbs {
+
+namespace {
+
+/// Maximum number of blob buffers written with one system call.
+const int k_MAX_IOVECS = 64;
+
+/// Granularity at which disk space of released payloads is returned to the
+/// file system.
+const bsls::Types::Uint64 k_PAGE_SIZE = 4096;
+
+}  // close unnamed namespace
+
+// ---------------
+// class SpillFile
+// ---------------
+
+// PRIVATE MANIPULATORS
+int SpillFile::writeBlob(const bdlbb::Blob& blob, bsls::Types::Uint64 offset)
+{
+    struct iovec iov[k_MAX_IOVECS];
+    int          numIov     = 0;
+    ssize_t      numPending = 0;
+
+    for (int i = 0; i < blob.numDataBuffers(); ++i) {
+        iov[numIov].iov_base = blob.buffer(i).data();
+        iov[numIov].iov_len  = i == blob.numDataBuffers() - 1
+                                   ? blob.lastDataBufferLength()
+                                   : blob.buffer(i).size();
+        numPending += iov[numIov].iov_len;
+        ++numIov;
+
+        if (numIov == k_MAX_IOVECS || i == blob.numDataBuffers() - 1) {
+            const ssize_t rc = ::pwritev(d_fd, iov, numIov, offset);
+            if (rc != numPending) {
+                // Short writes only happen when the file system is full.
+
+                if (rc >= 0) {
+                    errno = ENOSPC;
+                }
+                return -1;  // RETURN
+            }
+
+            offset += numPending;
+            numIov     = 0;
+            numPending = 0;
+        }
+    }
+
+    return 0;
+}
+
+void SpillFile::punchHole(bsls::Types::Uint64 offset,
+                          bsls::Types::Uint64 length)
+{
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    const bsls::Types::Uint64 begin = (offset + k_PAGE_SIZE - 1) &
+                                      ~(k_PAGE_SIZE - 1);
+    const bsls::Types::Uint64 end   = (offset + length) & ~(k_PAGE_SIZE - 1);
+
+    if (begin < end) {
+        // Failure is benign: the space is reclaimed when the file is
+        // truncated.
+
+        ::fallocate(d_fd,
+                    FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                    begin,
+                    end - begin);
+    }
+#else
+    (void)offset;
+    (void)length;
+#endif
+}
+
+// CREATORS
+SpillFile::SpillFile(bslma::Allocator* allocator)
+: d_fd(-1)
+, d_path(allocator)
+, d_writeOffset(0)
+, d_numBytes(0)
+, d_numPayloads(0)
+, d_allocator_p(allocator)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(allocator);
+}
+
+SpillFile::~SpillFile()
+{
+    close();
+}
+
+// MANIPULATORS
+int SpillFile::open(bsl::ostream& errorDescription, const bsl::string& path)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(!isOpen());
+
+    enum RcEnum {
+        // Value for the various RC error categories
+        rc_SUCCESS        = 0,
+        rc_OPEN_FAILURE   = -1,
+        rc_UNLINK_FAILURE = -2
+    };
+
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0660);
+    if (fd < 0) {
+        errorDescription << "Failed to open spill file [" << path
+                         << "], errno: " << errno << " ["
+                         << bsl::strerror(errno) << "]";
+        return rc_OPEN_FAILURE;  // RETURN
+    }
+
+    if (0 != ::unlink(path.c_str())) {
+        errorDescription << "Failed to unlink spill file [" << path
+                         << "], errno: " << errno << " ["
+                         << bsl::strerror(errno) << "]";
+        ::close(fd);
+        return rc_UNLINK_FAILURE;  // RETURN
+    }
+
+    d_fd          = fd;
+    d_path        = path;
+    d_writeOffset = 0;
+    d_numBytes    = 0;
+    d_numPayloads = 0;
+
+    return rc_SUCCESS;
+}
+
+void SpillFile::close()
+{
+    if (!isOpen()) {
+        return;  // RETURN
+    }
+
+    ::close(d_fd);
+
+    d_fd          = -1;
+    d_writeOffset = 0;
+    d_numBytes    = 0;
+    d_numPayloads = 0;
+}
+
+int SpillFile::write(Handle*            handle,
+                     bsl::ostream&      errorDescription,
+                     const bdlbb::Blob& appData,
+                     const bdlbb::Blob* options)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(handle);
+    BSLS_ASSERT_SAFE(isOpen());
+
+    enum RcEnum {
+        // Value for the various RC error categories
+        rc_SUCCESS       = 0,
+        rc_WRITE_FAILURE = -1
+    };
+
+    int rc = writeBlob(appData, d_writeOffset);
+    if (0 == rc && options) {
+        rc = writeBlob(*options, d_writeOffset + appData.length());
+    }
+
+    if (0 != rc) {
+        errorDescription << "Failed to write to spill file [" << d_path
+                         << "] at offset " << d_writeOffset
+                         << ", errno: " << errno << " ["
+                         << bsl::strerror(errno) << "]";
+        return rc_WRITE_FAILURE;  // RETURN
+    }
+
+    handle->d_offset        = d_writeOffset;
+    handle->d_appDataLength = appData.length();
+    handle->d_optionsLength = options ? options->length() : -1;
+
+    d_writeOffset += handle->length();
+    d_numBytes += handle->length();
+    ++d_numPayloads;
+
+    return rc_SUCCESS;
+}
+
+void SpillFile::release(const Handle& handle)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(handle.isValid());
+
+    if (!isOpen()) {
+        // The payload was released when the file was closed.
+        return;  // RETURN
+    }
+
+    BSLS_ASSERT_SAFE(0 < d_numPayloads);
+
+    d_numBytes -= handle.length();
+    --d_numPayloads;
+
+    if (0 == d_numPayloads) {
+        // Everything was released, start over from an empty file.
+
+        BSLS_ASSERT_SAFE(0 == d_numBytes);
+
+        if (0 == ::ftruncate(d_fd, 0)) {
+            d_writeOffset = 0;
+        }
+        return;  // RETURN
+    }
+
+    punchHole(handle.d_offset, handle.length());
+}
+
+// ACCESSORS
+int SpillFile::read(bsl::shared_ptr<bdlbb::Blob>* appData,
+                    bsl::shared_ptr<bdlbb::Blob>* options,
+                    bsl::ostream&                 errorDescription,
+                    const Handle&                 handle) const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(appData);
+    BSLS_ASSERT_SAFE(options);
+    BSLS_ASSERT_SAFE(handle.isValid());
+    BSLS_ASSERT_SAFE(handle.d_offset + handle.length() <= d_writeOffset);
+
+    enum RcEnum {
+        // Value for the various RC error categories
+        rc_SUCCESS      = 0,
+        rc_READ_FAILURE = -1
+    };
+
+    const int length = handle.length();
+
+    // Read the whole payload in one buffer, shared by the application data
+    // and options blobs.
+
+    bsl::shared_ptr<char> buffer;
+    if (length) {
+        buffer.reset(static_cast<char*>(d_allocator_p->allocate(length)),
+                     d_allocator_p);
+    }
+
+    int numRead = 0;
+    while (numRead < length) {
+        const ssize_t rc = ::pread(d_fd,
+                                   buffer.get() + numRead,
+                                   length - numRead,
+                                   handle.d_offset + numRead);
+        if (rc <= 0) {
+            errorDescription << "Failed to read " << length
+                             << " bytes from spill file [" << d_path
+                             << "] at offset " << handle.d_offset
+                             << ", rc: " << rc << ", errno: " << errno << " ["
+                             << bsl::strerror(errno) << "]";
+            return rc_READ_FAILURE;  // RETURN
+        }
+        numRead += static_cast<int>(rc);
+    }
+
+    appData->createInplace(d_allocator_p, d_allocator_p);
+    if (handle.d_appDataLength) {
+        (*appData)->appendDataBuffer(
+            bdlbb::BlobBuffer(buffer, handle.d_appDataLength));
+    }
+
+    if (handle.d_optionsLength < 0) {
+        options->reset();
+        return rc_SUCCESS;  // RETURN
+    }
+
+    options->createInplace(d_allocator_p, d_allocator_p);
+    if (handle.d_optionsLength) {
+        bsl::shared_ptr<char> optionsBuffer(buffer,
+                                            buffer.get() +
+                                                handle.d_appDataLength);
+        (*options)->appendDataBuffer(
+            bdlbb::BlobBuffer(optionsBuffer, handle.d_optionsLength));
+    }
+
+    return rc_SUCCESS;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
@@ -0,0 +1,262 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// mqbs_spillfile.h                                                   -*-C++-*-
+#ifndef INCLUDED_MQBS_SPILLFILE
+#define INCLUDED_MQBS_SPILLFILE
+
+//@PURPOSE: Provide a file holding the payload of messages evicted from memory.
+//
+//@CLASSES:
+//  mqbs::SpillFile:         append-only file of message payloads
+//  mqbs::SpillFile::Handle: compact reference to a payload in a spill file
+//
+//@DESCRIPTION: 'mqbs::SpillFile' is a mechanism used by a storage to keep the
+// application data and options of cold messages on disk instead of in memory.
+// 'write' appends the payload of a message to the file and returns a
+// 'Handle', which is all the storage needs to keep in memory in order to
+// 'read' the payload back, into newly allocated blobs, when the message is
+// delivered.  'release' indicates that the payload referred to by a handle is
+// no longer needed.
+//
+// The file is unlinked as soon as it is opened, so that its disk space is
+// reclaimed when it is closed, including when the process terminates
+// abnormally: the content of a spill file is never recovered.  Disk space of
+// released payloads is returned to the file system page by page where the
+// platform supports it, and the file is truncated once all its payloads have
+// been released.
+//
+// All the IO is performed synchronously by the calling thread, and the file
+// is never synced: it is up to the user to bound the amount of data written
+// or read at once (see 'mqbs::InMemoryStorage').
+//
+/// Thread Safety
+///-------------
+// NOT thread safe.
+
+// BDE
+#include <bdlbb_blob.h>
+#include <bsl_memory.h>
+#include <bsl_ostream.h>
+#include <bsl_string.h>
+#include <bslma_allocator.h>
+#include <bslma_usesbslmaallocator.h>
+#include <bslmf_nestedtraitdeclaration.h>
+#include <bsls_keyword.h>
+#include <bsls_types.h>
+
+namespace BloombergLP {
+namespace mqbs {
+
+// ===============
+// class SpillFile
+// ===============
+
+/// Append-only file of message payloads.
+class SpillFile {
+  public:
+    // TYPES
+
+    /// Compact reference to the payload of a message in a spill file.
+    struct Handle {
+        // PUBLIC DATA
+        bsls::Types::Uint64 d_offset;
+        // Offset of the payload in the file.
+
+        int d_appDataLength;
+        // Length of the application data.
+
+        int d_optionsLength;
+        // Length of the options, which follow the application data, or
+        // -1 if the message has no options blob.
+
+        // CREATORS
+
+        /// Create an invalid handle.
+        Handle();
+
+        // ACCESSORS
+
+        /// Return true if this handle refers to a payload.
+        bool isValid() const;
+
+        /// Return the total number of bytes of the payload.
+        int length() const;
+    };
+
+  private:
+    // DATA
+    int d_fd;
+    // File descriptor of the (unlinked) file, or -1 if it is not open.
+
+    bsl::string d_path;
+    // Path of the file when it was opened.
+
+    bsls::Types::Uint64 d_writeOffset;
+    // Offset at which the next payload is appended.
+
+    bsls::Types::Int64 d_numBytes;
+    // Number of bytes of the payloads not yet released.
+
+    bsls::Types::Int64 d_numPayloads;
+    // Number of payloads not yet released.
+
+    bslma::Allocator* d_allocator_p;
+
+  private:
+    // NOT IMPLEMENTED
+    SpillFile(const SpillFile&) BSLS_KEYWORD_DELETED;
+    SpillFile& operator=(const SpillFile&) BSLS_KEYWORD_DELETED;
+
+  private:
+    // PRIVATE MANIPULATORS
+
+    /// Write the data of the specified `blob` at the specified `offset`.
+    /// Return 0 on success, or a non-zero value with `errno` set otherwise.
+    int writeBlob(const bdlbb::Blob& blob, bsls::Types::Uint64 offset);
+
+    /// Return to the file system the disk space of the pages fully covered
+    /// by the range of the specified `length` starting at the specified
+    /// `offset`, if the platform supports it.
+    void punchHole(bsls::Types::Uint64 offset, bsls::Types::Uint64 length);
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(SpillFile, bslma::UsesBslmaAllocator)
+
+    // CREATORS
+
+    /// Create a closed spill file using the specified `allocator` to supply
+    /// memory, including to the blobs loaded by `read`.
+    explicit SpillFile(bslma::Allocator* allocator);
+
+    /// Close this spill file and destroy this object.
+    ~SpillFile();
+
+    // MANIPULATORS
+
+    /// Create, truncate and open the file at the specified `path`, and
+    /// unlink it.  Return 0 on success, or a non-zero value and populate
+    /// the specified `errorDescription` otherwise.  The behavior is
+    /// undefined if this file is already open.
+    int open(bsl::ostream& errorDescription, const bsl::string& path);
+
+    /// Close this file, if it is open, releasing all its payloads.
+    void close();
+
+    /// Append to this file the specified `appData` and, if not null, the
+    /// specified `options`, and load into the specified `handle` a
+    /// reference to them.  Return 0 on success, or a non-zero value and
+    /// populate the specified `errorDescription` otherwise.  The behavior is
+    /// undefined unless this file is open.
+    int write(Handle*            handle,
+              bsl::ostream&      errorDescription,
+              const bdlbb::Blob& appData,
+              const bdlbb::Blob* options);
+
+    /// Release the payload referred to by the specified `handle`, which
+    /// must have been returned by `write` and not yet released.
+    void release(const Handle& handle);
+
+    // ACCESSORS
+
+    /// Load into the specified `appData` and `options` new blobs holding
+    /// the payload referred to by the specified `handle`.  Return 0 on
+    /// success, or a non-zero value and populate the specified
+    /// `errorDescription` otherwise.  `options` is reset if the payload was
+    /// written without options.
+    int read(bsl::shared_ptr<bdlbb::Blob>* appData,
+             bsl::shared_ptr<bdlbb::Blob>* options,
+             bsl::ostream&                 errorDescription,
+             const Handle&                 handle) const;
+
+    /// Return true if this file is open.
+    bool isOpen() const;
+
+    /// Return the path this file was opened with.
+    const bsl::string& path() const;
+
+    /// Return the number of bytes of the payloads not yet released.
+    bsls::Types::Int64 numBytes() const;
+
+    /// Return the number of payloads not yet released.
+    bsls::Types::Int64 numPayloads() const;
+
+    /// Return the current size of the file, in bytes.
+    bsls::Types::Uint64 size() const;
+};
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+// -----------------------
+// class SpillFile::Handle
+// -----------------------
+
+// CREATORS
+inline SpillFile::Handle::Handle()
+: d_offset(0)
+, d_appDataLength(-1)
+, d_optionsLength(-1)
+{
+    // NOTHING
+}
+
+// ACCESSORS
+inline bool SpillFile::Handle::isValid() const
+{
+    return d_appDataLength >= 0;
+}
+
+inline int SpillFile::Handle::length() const
+{
+    return d_appDataLength + (d_optionsLength > 0 ? d_optionsLength : 0);
+}
+
+// ---------------
+// class SpillFile
+// ---------------
+
+// ACCESSORS
+inline bool SpillFile::isOpen() const
+{
+    return d_fd >= 0;
+}
+
+inline const bsl::string& SpillFile::path() const
+{
+    return d_path;
+}
+
+inline bsls::Types::Int64 SpillFile::numBytes() const
+{
+    return d_numBytes;
+}
+
+inline bsls::Types::Int64 SpillFile::numPayloads() const
+{
+    return d_numPayloads;
+}
+
+inline bsls::Types::Uint64 SpillFile::size() const
+{
+    return d_writeOffset;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
@@ -0,0 +1,259 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// mqbs_spillfile.t.cpp                                               -*-C++-*-
+#include <mqbs_spillfile.h>
+
+// MWC
+#include <mwcu_memoutstream.h>
+#include <mwcu_tempdirectory.h>
+
+// BDE
+#include <bdlbb_blob.h>
+#include <bdlbb_blobutil.h>
+#include <bdlbb_pooledblobbufferfactory.h>
+#include <bdls_pathutil.h>
+#include <bsl_memory.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+// TEST DRIVER
+#include <mwctst_testhelper.h>
+
+// CONVENIENCE
+using namespace BloombergLP;
+using namespace bsl;
+
+namespace {
+
+// FUNCTIONS
+
+/// Return the path of a spill file in the specified `tempDir`.
+bsl::string spillFilePath(const mwcu::TempDirectory& tempDir)
+{
+    bsl::string path(tempDir.path(), s_allocator_p);
+    bdls::PathUtil::appendRaw(&path, "test.spill");
+    return path;
+}
+
+/// Load into the specified `blob` the specified `length` bytes, all equal
+/// to the specified `value`.
+void fillBlob(bdlbb::Blob* blob, int length, char value)
+{
+    const bsl::string data(length, value, s_allocator_p);
+    bdlbb::BlobUtil::append(blob, data.data(), length);
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                                    TESTS
+// ----------------------------------------------------------------------------
+
+static void test1_breathingTest()
+// ------------------------------------------------------------------------
+// BREATHING TEST
+//
+// Testing:
+//   Basic functionality of 'mqbs::SpillFile': writing a payload, reading
+//   it back, and releasing it.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("BREATHING TEST");
+
+    mwcu::TempDirectory tempDir(s_allocator_p);
+    mwcu::MemOutStream  errorDesc(s_allocator_p);
+
+    // Small buffers, so that payloads span several blob buffers
+    bdlbb::PooledBlobBufferFactory bufferFactory(16, s_allocator_p);
+
+    mqbs::SpillFile obj(s_allocator_p);
+    ASSERT(!obj.isOpen());
+    ASSERT_EQ(obj.numPayloads(), 0);
+
+    ASSERT_EQ(obj.open(errorDesc, spillFilePath(tempDir)), 0);
+    ASSERT(obj.isOpen());
+    ASSERT_EQ(obj.size(), 0U);
+
+    bdlbb::Blob appData(&bufferFactory, s_allocator_p);
+    bdlbb::Blob options(&bufferFactory, s_allocator_p);
+    fillBlob(&appData, 100, 'a');
+    fillBlob(&options, 20, 'o');
+
+    PV("Write with options");
+    mqbs::SpillFile::Handle withOptions;
+    ASSERT(!withOptions.isValid());
+    ASSERT_EQ(obj.write(&withOptions, errorDesc, appData, &options), 0);
+    ASSERT(withOptions.isValid());
+    ASSERT_EQ(withOptions.length(), 120);
+    ASSERT_EQ(obj.numPayloads(), 1);
+    ASSERT_EQ(obj.numBytes(), 120);
+
+    PV("Write without options");
+    mqbs::SpillFile::Handle withoutOptions;
+    ASSERT_EQ(obj.write(&withoutOptions, errorDesc, appData, 0), 0);
+    ASSERT_EQ(withoutOptions.length(), 100);
+    ASSERT_EQ(obj.numPayloads(), 2);
+    ASSERT_EQ(obj.numBytes(), 220);
+    ASSERT_EQ(obj.size(), 220U);
+
+    PV("Read");
+    bsl::shared_ptr<bdlbb::Blob> appDataSp;
+    bsl::shared_ptr<bdlbb::Blob> optionsSp;
+
+    ASSERT_EQ(obj.read(&appDataSp, &optionsSp, errorDesc, withOptions), 0);
+    ASSERT(appDataSp);
+    ASSERT(optionsSp);
+    ASSERT_EQ(bdlbb::BlobUtil::compare(*appDataSp, appData), 0);
+    ASSERT_EQ(bdlbb::BlobUtil::compare(*optionsSp, options), 0);
+
+    ASSERT_EQ(obj.read(&appDataSp, &optionsSp, errorDesc, withoutOptions),
+              0);
+    ASSERT(appDataSp);
+    ASSERT(!optionsSp);
+    ASSERT_EQ(bdlbb::BlobUtil::compare(*appDataSp, appData), 0);
+
+    PV("Release");
+    obj.release(withOptions);
+    ASSERT_EQ(obj.numPayloads(), 1);
+    ASSERT_EQ(obj.numBytes(), 100);
+    ASSERT_EQ(obj.size(), 220U);
+
+    obj.release(withoutOptions);
+    ASSERT_EQ(obj.numPayloads(), 0);
+    ASSERT_EQ(obj.numBytes(), 0);
+    ASSERT_EQ(obj.size(), 0U);
+
+    obj.close();
+    ASSERT(!obj.isOpen());
+}
+
+static void test2_releaseOutOfOrder()
+// ------------------------------------------------------------------------
+// RELEASE OUT OF ORDER
+//
+// Concerns:
+//   - Releasing payloads in any order does not affect the other payloads.
+//   - The file is truncated once all the payloads are released, and
+//     writing resumes from its beginning.
+//   - Closing the file releases all the payloads.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("RELEASE OUT OF ORDER");
+
+    const int k_NUM_PAYLOADS = 64;
+    const int k_LENGTH       = 5000;  // Span several pages
+
+    mwcu::TempDirectory            tempDir(s_allocator_p);
+    mwcu::MemOutStream             errorDesc(s_allocator_p);
+    bdlbb::PooledBlobBufferFactory bufferFactory(1024, s_allocator_p);
+
+    mqbs::SpillFile obj(s_allocator_p);
+    ASSERT_EQ(obj.open(errorDesc, spillFilePath(tempDir)), 0);
+
+    bsl::vector<mqbs::SpillFile::Handle> handles(k_NUM_PAYLOADS,
+                                                 s_allocator_p);
+    for (int i = 0; i < k_NUM_PAYLOADS; ++i) {
+        bdlbb::Blob appData(&bufferFactory, s_allocator_p);
+        fillBlob(&appData, k_LENGTH, static_cast<char>('A' + i % 26));
+        ASSERT_EQ(obj.write(&handles[i], errorDesc, appData, 0), 0);
+    }
+    ASSERT_EQ(obj.numPayloads(), k_NUM_PAYLOADS);
+
+    // Release every other payload, and verify the remaining ones.
+    for (int i = 0; i < k_NUM_PAYLOADS; i += 2) {
+        obj.release(handles[i]);
+    }
+    ASSERT_EQ(obj.numPayloads(), k_NUM_PAYLOADS / 2);
+    ASSERT_EQ(obj.numBytes(), k_LENGTH * k_NUM_PAYLOADS / 2);
+
+    for (int i = 1; i < k_NUM_PAYLOADS; i += 2) {
+        bdlbb::Blob expected(&bufferFactory, s_allocator_p);
+        fillBlob(&expected, k_LENGTH, static_cast<char>('A' + i % 26));
+
+        bsl::shared_ptr<bdlbb::Blob> appDataSp;
+        bsl::shared_ptr<bdlbb::Blob> optionsSp;
+        ASSERT_EQ_D(i,
+                    obj.read(&appDataSp, &optionsSp, errorDesc, handles[i]),
+                    0);
+        ASSERT_EQ_D(i, bdlbb::BlobUtil::compare(*appDataSp, expected), 0);
+    }
+
+    for (int i = 1; i < k_NUM_PAYLOADS; i += 2) {
+        obj.release(handles[i]);
+    }
+    ASSERT_EQ(obj.numPayloads(), 0);
+    ASSERT_EQ(obj.size(), 0U);
+
+    // Writing resumes from the beginning of the file.
+    bdlbb::Blob appData(&bufferFactory, s_allocator_p);
+    fillBlob(&appData, k_LENGTH, 'z');
+
+    mqbs::SpillFile::Handle handle;
+    ASSERT_EQ(obj.write(&handle, errorDesc, appData, 0), 0);
+    ASSERT_EQ(handle.d_offset, 0U);
+
+    // Closing releases everything; releasing afterwards is a no-op.
+    obj.close();
+    ASSERT_EQ(obj.numPayloads(), 0);
+    obj.release(handle);
+    ASSERT_EQ(obj.numPayloads(), 0);
+}
+
+static void test3_openFailure()
+// ------------------------------------------------------------------------
+// OPEN FAILURE
+//
+// Concerns:
+//   Opening a file in a directory which does not exist fails and populates
+//   the error description.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("OPEN FAILURE");
+
+    mwcu::TempDirectory tempDir(s_allocator_p);
+    mwcu::MemOutStream  errorDesc(s_allocator_p);
+
+    bsl::string path(tempDir.path(), s_allocator_p);
+    bdls::PathUtil::appendRaw(&path, "doesNotExist");
+    bdls::PathUtil::appendRaw(&path, "test.spill");
+
+    mqbs::SpillFile obj(s_allocator_p);
+    ASSERT_NE(obj.open(errorDesc, path), 0);
+    ASSERT(!obj.isOpen());
+    ASSERT(!errorDesc.str().empty());
+}
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    TEST_PROLOG(mwctst::TestHelper::e_DEFAULT);
+
+    switch (_testCase) {
+    case 0:
+    case 3: test3_openFailure(); break;
+    case 2: test2_releaseOutOfOrder(); break;
+    case 1: test1_breathingTest(); break;
+    default: {
+        cerr << "WARNING: CASE '" << _testCase << "' NOT FOUND." << endl;
+        s_testStatus = -1;
+    } break;
+    }
+
+    TEST_EPILOG(mwctst::TestHelper::e_CHECK_DEF_GBL_ALLOC);
+}
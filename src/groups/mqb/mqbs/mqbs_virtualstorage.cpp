@@ -39,13 +39,44 @@ VirtualStorage::VirtualStorage(mqbi::Storage*          storage,
 , d_storage_p(storage)
 , d_appId(appId, allocator)
 , d_appKey(appKey)
-, d_guids(allocator)
+, d_ordinal(0)
+, d_ownDataStream_mp()
+, d_dataStream_p(0)
+, d_numMessages(0)
 , d_totalBytes(0)
 {
     BSLS_ASSERT_SAFE(d_storage_p);
     BSLS_ASSERT_SAFE(allocator);
     BSLS_ASSERT_SAFE(!appId.empty());
     BSLS_ASSERT_SAFE(!appKey.isNull());
+
+    d_ownDataStream_mp.load(new (*allocator) DataStream(allocator),
+                            allocator);
+    d_dataStream_p = d_ownDataStream_mp.get();
+}
+
+VirtualStorage::VirtualStorage(mqbi::Storage*          storage,
+                               const bsl::string&      appId,
+                               const mqbu::StorageKey& appKey,
+                               DataStream*             dataStream,
+                               int                     ordinal,
+                               bslma::Allocator*       allocator)
+: d_allocator_p(allocator)
+, d_storage_p(storage)
+, d_appId(appId, allocator)
+, d_appKey(appKey)
+, d_ordinal(ordinal)
+, d_ownDataStream_mp()
+, d_dataStream_p(dataStream)
+, d_numMessages(0)
+, d_totalBytes(0)
+{
+    BSLS_ASSERT_SAFE(d_storage_p);
+    BSLS_ASSERT_SAFE(d_dataStream_p);
+    BSLS_ASSERT_SAFE(allocator);
+    BSLS_ASSERT_SAFE(!appId.empty());
+    BSLS_ASSERT_SAFE(!appKey.isNull());
+    BSLS_ASSERT_SAFE(ordinal >= 0);
 }
 
 VirtualStorage::~VirtualStorage()
@@ -53,6 +84,46 @@ VirtualStorage::~VirtualStorage()
     // NOTHING
 }
 
+// PRIVATE MANIPULATORS
+mqbi::StorageResult::Enum
+VirtualStorage::setPending(const DataStreamIterator& it,
+                           const bmqp::RdaInfo&      rdaInfo,
+                           unsigned int              subscriptionId)
+{
+    if (!it->second.setPending(d_ordinal, rdaInfo, subscriptionId)) {
+        // Duplicate GUID
+        return mqbi::StorageResult::e_GUID_NOT_UNIQUE;  // RETURN
+    }
+
+    ++d_numMessages;
+    d_totalBytes += it->second.size();
+    return mqbi::StorageResult::e_SUCCESS;
+}
+
+VirtualStorage::DataStreamIterator
+VirtualStorage::clearPending(DataStreamIterator it)
+{
+    const bool wasPending = it->second.clearPending(d_ordinal);
+    BSLS_ASSERT_SAFE(wasPending);
+    static_cast<void>(wasPending);
+
+    --d_numMessages;
+    d_totalBytes -= it->second.size();
+
+    if (0 == it->second.numApps()) {
+        // No app has the message pending anymore.
+        return d_dataStream_p->erase(it);  // RETURN
+    }
+
+    return ++it;
+}
+
+void VirtualStorage::resetCounts()
+{
+    d_numMessages = 0;
+    d_totalBytes  = 0;
+}
+
 // MANIPULATORS
 mqbi::StorageResult::Enum
 VirtualStorage::get(bsl::shared_ptr<bdlbb::Blob>*   appData,
@@ -110,18 +181,16 @@ mqbi::StorageResult::Enum VirtualStorage::put(const bmqt::MessageGUID& msgGUID,
                                               const bmqp::RdaInfo&     rdaInfo,
                                               unsigned int subScriptionId)
 {
-    if (d_guids
-            .insert(bsl::make_pair(
-                msgGUID,
-                MessageContext(msgSize, rdaInfo, subScriptionId)))
-            .second == false) {
-        // Duplicate GUID
-        return mqbi::StorageResult::e_GUID_NOT_UNIQUE;  // RETURN
+    DataStreamIterator it = d_dataStream_p->find(msgGUID);
+    if (it == d_dataStream_p->end()) {
+        it = d_dataStream_p
+                 ->insert(bsl::make_pair(
+                     msgGUID,
+                     DataStreamMessage(msgSize, d_allocator_p)))
+                 .first;
     }
 
-    // Success: new GUID
-    d_totalBytes += msgSize;
-    return mqbi::StorageResult::e_SUCCESS;
+    return setPending(it, rdaInfo, subScriptionId);
 }
 
 mqbi::StorageResult::Enum VirtualStorage::put(
@@ -142,7 +211,8 @@ VirtualStorage::getIterator(const mqbu::StorageKey& appKey)
     static_cast<void>(appKey);
 
     bslma::ManagedPtr<mqbi::StorageIterator> mp(
-        new (*d_allocator_p) VirtualStorageIterator(this, d_guids.begin()),
+        new (*d_allocator_p)
+            VirtualStorageIterator(this, d_dataStream_p->begin()),
         d_allocator_p);
 
     return mp;
@@ -157,8 +227,8 @@ VirtualStorage::getIterator(bslma::ManagedPtr<mqbi::StorageIterator>* out,
     BSLS_ASSERT_SAFE(d_appKey == appKey);
     static_cast<void>(appKey);
 
-    GuidListIter it = d_guids.find(msgGUID);
-    if (it == d_guids.end()) {
+    DataStreamConstIterator it = d_dataStream_p->find(msgGUID);
+    if (it == d_dataStream_p->end() || !it->second.isPending(d_ordinal)) {
         return mqbi::StorageResult::e_GUID_NOT_FOUND;  // RETURN
     }
 
@@ -184,24 +254,41 @@ VirtualStorage::remove(const bmqt::MessageGUID&    msgGUID,
                        BSLS_ANNOTATION_UNUSED bool clearAll)
 
 {
-    GuidList::const_iterator it = d_guids.find(msgGUID);
-    if (it == d_guids.end()) {
+    DataStreamIterator it = d_dataStream_p->find(msgGUID);
+    if (it == d_dataStream_p->end() || !it->second.isPending(d_ordinal)) {
         return mqbi::StorageResult::e_GUID_NOT_FOUND;  // RETURN
     }
 
     if (msgSize) {
-        *msgSize = it->second.d_size;
+        *msgSize = it->second.size();
     }
-    d_totalBytes -= it->second.d_size;
-    d_guids.erase(it);
+    clearPending(it);
     return mqbi::StorageResult::e_SUCCESS;
 }
 
 mqbi::StorageResult::Enum VirtualStorage::removeAll(
     BSLS_ANNOTATION_UNUSED const mqbu::StorageKey& appKey)
 {
-    d_guids.clear();
-    d_totalBytes = 0;
+    if (d_ownDataStream_mp) {
+        d_dataStream_p->clear();
+        resetCounts();
+        return mqbi::StorageResult::e_SUCCESS;  // RETURN
+    }
+
+    // The data stream is shared with other apps: clear this app's bit in
+    // each message, erasing the ones not pending for any app anymore.
+    DataStreamIterator it = d_dataStream_p->begin();
+    while (d_numMessages > 0 && it != d_dataStream_p->end()) {
+        if (it->second.isPending(d_ordinal)) {
+            it = clearPending(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    BSLS_ASSERT_SAFE(0 == d_numMessages);
+    BSLS_ASSERT_SAFE(0 == d_totalBytes);
     return mqbi::StorageResult::e_SUCCESS;
 }
 
@@ -215,12 +302,12 @@ mqbi::StorageResult::Enum
 VirtualStorage::getMessageSize(int*                     msgSize,
                                const bmqt::MessageGUID& msgGUID) const
 {
-    GuidList::const_iterator cit = d_guids.find(msgGUID);
-    if (cit == d_guids.end()) {
+    DataStreamConstIterator cit = d_dataStream_p->find(msgGUID);
+    if (cit == d_dataStream_p->end() || !cit->second.isPending(d_ordinal)) {
         return mqbi::StorageResult::e_GUID_NOT_FOUND;  // RETURN
     }
 
-    *msgSize = cit->second.d_size;
+    *msgSize = cit->second.size();
     return mqbi::StorageResult::e_SUCCESS;
 }
 
@@ -303,9 +390,31 @@ void VirtualStorageIterator::clear()
     d_haveReceipt = false;
 }
 
+void VirtualStorageIterator::skipNonPending()
+{
+    const VirtualStorage::DataStream& dataStream =
+        *d_virtualStorage_p->d_dataStream_p;
+    const int ordinal = d_virtualStorage_p->d_ordinal;
+
+    // The message this iterator is positioned on may have been erased, e.g.
+    // purged, since it was last moved.
+    VirtualStorage::DataStreamConstIterator it = dataStream.lowerBound(
+        d_iterator);
+    while (it != dataStream.end() && !it->second.isPending(ordinal)) {
+        ++it;
+    }
+
+    if (it != d_iterator) {
+        // Loaded state, if any, is of a message not pending for this app.
+        d_iterator = it;
+        clear();
+    }
+}
+
 // PRIVATE ACCESSORS
 bool VirtualStorageIterator::loadMessageAndAttributes() const
 {
+    // PRECONDITIONS
     BSLS_ASSERT_SAFE(!atEnd());
 
     if (!d_appData_sp) {
@@ -323,8 +432,8 @@ bool VirtualStorageIterator::loadMessageAndAttributes() const
 
 // CREATORS
 VirtualStorageIterator::VirtualStorageIterator(
-    VirtualStorage*                                 storage,
-    const VirtualStorage::GuidList::const_iterator& initialPosition)
+    VirtualStorage*                                storage,
+    const VirtualStorage::DataStreamConstIterator& initialPosition)
 : d_virtualStorage_p(storage)
 , d_iterator(initialPosition)
 , d_attributes()
@@ -333,6 +442,8 @@ VirtualStorageIterator::VirtualStorageIterator(
 , d_haveReceipt(false)
 {
     BSLS_ASSERT_SAFE(d_virtualStorage_p);
+
+    skipNonPending();
 }
 
 VirtualStorageIterator::~VirtualStorageIterator()
@@ -348,6 +459,7 @@ bool VirtualStorageIterator::advance()
 
     clear();
     ++d_iterator;
+    skipNonPending();
     return !atEnd();
 }
 
@@ -356,7 +468,13 @@ void VirtualStorageIterator::reset()
     clear();
 
     // Reset iterator to beginning
-    d_iterator = d_virtualStorage_p->d_guids.begin();
+    d_iterator = d_virtualStorage_p->d_dataStream_p->begin();
+    skipNonPending();
+}
+
+void VirtualStorageIterator::resume()
+{
+    skipNonPending();
 }
 
 // ACCESSORS
@@ -373,7 +491,7 @@ bmqp::RdaInfo& VirtualStorageIterator::rdaInfo() const
     // PRECONDITIONS
     BSLS_ASSERT_SAFE(!atEnd());
 
-    return d_iterator->second.d_rdaInfo;
+    return d_iterator->second.app(d_virtualStorage_p->d_ordinal).d_rdaInfo;
 }
 
 unsigned int VirtualStorageIterator::subscriptionId() const
@@ -381,7 +499,8 @@ unsigned int VirtualStorageIterator::subscriptionId() const
     // PRECONDITIONS
     BSLS_ASSERT_SAFE(!atEnd());
 
-    return d_iterator->second.d_subscriptionId;
+    return d_iterator->second.app(d_virtualStorage_p->d_ordinal)
+        .d_subscriptionId;
 }
 
 const bsl::shared_ptr<bdlbb::Blob>& VirtualStorageIterator::appData() const
@@ -405,7 +524,7 @@ VirtualStorageIterator::attributes() const
 
 bool VirtualStorageIterator::atEnd() const
 {
-    return (d_iterator == d_virtualStorage_p->d_guids.end());
+    return (d_iterator == d_virtualStorage_p->d_dataStream_p->end());
 }
 
 bool VirtualStorageIterator::hasReceipt() const
@@ -26,6 +26,22 @@
 //@DESCRIPTION: 'mqbs::VirtualStorage' provides a mechanism to add per-client
 // state to an underlying BlazingMQ storage.
 //
+/// Shared Data Stream
+///------------------
+// All virtual storages of a given physical storage (see
+// 'mqbs::VirtualStorageCatalog') share a single
+// 'mqbs::VirtualStorageDataStream', in which messages are sequenced in
+// arrival order.  Each message of the data stream holds the size of the
+// message and one compact 'AppState' (RDA counter, subscription id and
+// 'pending' bit) per app, indexed by the ordinal the catalog assigned to the
+// virtual storage of that app.  Confirming a message for an app clears the
+// corresponding bit, and the message is removed from the data stream once no
+// app has it pending anymore.  As a result, each GUID is stored and indexed
+// once regardless of the number of apps.
+//
+// A virtual storage created without a data stream (e.g., in test drivers)
+// owns a private one.
+//
 /// Warning
 ///-------
 // An instance of this component is backed by a "real" underlying storage.
@@ -39,14 +55,13 @@
 #include <mqbi_storage.h>
 #include <mqbs_datastore.h>
 #include <mqbs_filestoreprotocol.h>
+#include <mqbs_virtualstoragedatastream.h>
 #include <mqbu_storagekey.h>
 
 // BMQ
+#include <bmqp_protocol.h>
 #include <bmqt_messageguid.h>
 
-// MWC
-#include <mwcc_orderedhashmap.h>
-
 // BDE
 #include <bdlbb_blob.h>
 #include <bsl_memory.h>
@@ -62,6 +77,7 @@ namespace BloombergLP {
 namespace mqbs {
 
 // FORWARD DECLARATION
+class VirtualStorageCatalog;
 class VirtualStorageIterator;
 
 // ====================
@@ -71,31 +87,24 @@ class VirtualStorageIterator;
 class VirtualStorage : public mqbi::Storage {
     // TBD
 
+  public:
+    // PUBLIC TYPES
+    typedef VirtualStorageDataStream DataStream;
+
+    typedef DataStream::AppState AppState;
+
+    typedef DataStream::Message DataStreamMessage;
+
+    typedef DataStream::iterator DataStreamIterator;
+
+    typedef DataStream::const_iterator DataStreamConstIterator;
+
   private:
     // FRIENDS
     friend class VirtualStorageIterator;
+    friend class VirtualStorageCatalog;
 
     // PRIVATE TYPES
-    struct MessageContext {
-        int                   d_size;
-        mutable bmqp::RdaInfo d_rdaInfo;
-        unsigned int          d_subscriptionId;
-
-        MessageContext(int                  size,
-                       const bmqp::RdaInfo& rdaInfo,
-                       unsigned int         subScriptionId);
-    };
-
-    /// msgGUID -> MessageContext
-    /// Must be a container in which iteration order is same as insertion
-    /// order.
-    typedef mwcc::OrderedHashMap<bmqt::MessageGUID,
-                                 MessageContext,
-                                 bslh::Hash<bmqt::MessageGUIDHashAlgo> >
-        GuidList;
-
-    typedef GuidList::iterator GuidListIter;
-
     typedef mqbi::Storage::StorageKeys StorageKeys;
 
   private:
@@ -112,13 +121,49 @@ class VirtualStorage : public mqbi::Storage {
     mqbu::StorageKey d_appKey;
     // Storage key of the associated 'appId'.
 
-    GuidList d_guids;
-    // List of guids that are part of this storage.
+    int d_ordinal;
+    // Index of the state of this app in each
+    // message of the data stream.
+
+    bslma::ManagedPtr<DataStream> d_ownDataStream_mp;
+    // Data stream owned by this instance, if
+    // it was not given one at construction.
+
+    DataStream* d_dataStream_p;
+    // Data stream of the messages, possibly
+    // shared with other virtual storages.
+    // Held, not owned.
+
+    bsls::Types::Int64 d_numMessages;
+    // Number of messages pending for this
+    // app.
 
     bsls::Types::Int64 d_totalBytes;
     // Total size (in bytes) of all the messages that
     // it holds.
 
+  private:
+    // PRIVATE MANIPULATORS
+
+    /// Mark the message pointed to by the specified `it` as pending for
+    /// this app, with the specified `rdaInfo` and `subscriptionId`.
+    /// Return 0 on success, or `e_GUID_NOT_UNIQUE` if the message already
+    /// was pending for this app.
+    mqbi::StorageResult::Enum setPending(const DataStreamIterator& it,
+                                         const bmqp::RdaInfo&      rdaInfo,
+                                         unsigned int subscriptionId);
+
+    /// Mark the message pointed to by the specified `it` as no longer
+    /// pending for this app and erase it from the data stream if it is not
+    /// pending for any app anymore.  Return the iterator following `it`.
+    /// The behavior is undefined unless the message is pending for this
+    /// app.
+    DataStreamIterator clearPending(DataStreamIterator it);
+
+    /// Reset the message and byte counts of this app to zero.  Used when
+    /// the shared data stream is cleared at once.
+    void resetCounts();
+
   private:
     // NOT IMPLEMENTED
     VirtualStorage(const VirtualStorage&);             // = delete
@@ -141,6 +186,22 @@ class VirtualStorage : public mqbi::Storage {
                    const mqbu::StorageKey& appKey,
                    bslma::Allocator*       allocator);
 
+    /// Create an instance of virtual storage backed by the specified real
+    /// `storage`, having the specified `appId` and `appKey`, and keeping
+    /// its state at the specified `ordinal` of each message of the
+    /// specified shared `dataStream`.  Use the specified `allocator` for
+    /// any memory allocations.  Behavior is undefined unless `storage` and
+    /// `dataStream` are non-null, `appId` is non-empty, `appKey` is
+    /// non-null and `ordinal` is not used by any other virtual storage
+    /// sharing `dataStream`.  Note that `storage` and `dataStream` must
+    /// outlive this virtual storage instance.
+    VirtualStorage(mqbi::Storage*          storage,
+                   const bsl::string&      appId,
+                   const mqbu::StorageKey& appKey,
+                   DataStream*             dataStream,
+                   int                     ordinal,
+                   bslma::Allocator*       allocator);
+
     /// Destructor.
     ~VirtualStorage() BSLS_KEYWORD_OVERRIDE;
 
@@ -160,6 +221,10 @@ class VirtualStorage : public mqbi::Storage {
     /// Note that the returned key is always non-null.
     const mqbu::StorageKey& appKey() const BSLS_KEYWORD_OVERRIDE;
 
+    /// Return the index of the state of this app in the messages of the
+    /// data stream.
+    int ordinal() const;
+
     /// Return the current configuration used by this storage. The behavior
     /// is undefined unless `configure` was successfully called.
     const mqbconfm::Storage& config() const BSLS_KEYWORD_OVERRIDE;
@@ -380,7 +445,13 @@ class VirtualStorageIterator : public mqbi::StorageIterator {
     // DATA
     VirtualStorage* d_virtualStorage_p;
 
-    VirtualStorage::GuidList::const_iterator d_iterator;
+    VirtualStorage::DataStreamConstIterator d_iterator;
+    // Position in the data stream shared
+    // by all apps.  May refer to a message
+    // erased, or not pending for the app
+    // anymore, since this iterator was
+    // last moved, until 'resume' is
+    // called.
 
     mutable mqbi::StorageMessageAttributes d_attributes;
 
@@ -409,6 +480,12 @@ class VirtualStorageIterator : public mqbi::StorageIterator {
     /// can be loaded in `appData`, `options` or `attributes` routines.
     void clear();
 
+    /// Move `d_iterator` forward, if needed, to the first message still in
+    /// the data stream and pending for the app of the virtual storage, or
+    /// to the end, and clear any state loaded for the message it was
+    /// pointing at if it moved.
+    void skipNonPending();
+
     // PRIVATE ACCESSORS
 
     /// Load the internal state of this iterator instance with the
@@ -423,10 +500,11 @@ class VirtualStorageIterator : public mqbi::StorageIterator {
     // CREATORS
 
     /// Create a new VirtualStorageIterator from the specified `storage` and
-    /// pointing at the specified `initialPosition`.
+    /// pointing at the first message pending for the app of `storage` at
+    /// or after the specified `initialPosition`.
     VirtualStorageIterator(
-        VirtualStorage*                                 storage,
-        const VirtualStorage::GuidList::const_iterator& initialPosition);
+        VirtualStorage*                                storage,
+        const VirtualStorage::DataStreamConstIterator& initialPosition);
 
     /// Destructor
     ~VirtualStorageIterator() BSLS_KEYWORD_OVERRIDE;
@@ -435,6 +513,15 @@ class VirtualStorageIterator : public mqbi::StorageIterator {
     bool advance() BSLS_KEYWORD_OVERRIDE;
     void reset() BSLS_KEYWORD_OVERRIDE;
 
+    /// Move this iterator past the messages which, since it was last moved,
+    /// were erased or confirmed for its app, and past the messages appended
+    /// since which are not pending for its app.  Note that this is
+    /// required because the data stream is shared by all the apps of the
+    /// queue: an iterator parked at the end of the stream, or on a message
+    /// confirmed or erased since, would otherwise resume onto messages
+    /// pending for other apps only, or onto no message at all.
+    void resume() BSLS_KEYWORD_OVERRIDE;
+
     // ACCESSORS
 
     /// Return a reference offering non-modifiable access to the guid
@@ -482,21 +569,6 @@ class VirtualStorageIterator : public mqbi::StorageIterator {
 //                             INLINE DEFINITIONS
 // ============================================================================
 
-// ------------------------------------
-// class VirtualStorage::MessageContext
-// ------------------------------------
-
-inline VirtualStorage::MessageContext::MessageContext(
-    int                  size,
-    const bmqp::RdaInfo& rdaInfo,
-    unsigned int         subScriptionId)
-: d_size(size)
-, d_rdaInfo(rdaInfo)
-, d_subscriptionId(subScriptionId)
-{
-    // NOTHING
-}
-
 // --------------------
 // class VirtualStorage
 // --------------------
@@ -522,6 +594,11 @@ inline const mqbu::StorageKey& VirtualStorage::appKey() const
     return d_appKey;
 }
 
+inline int VirtualStorage::ordinal() const
+{
+    return d_ordinal;
+}
+
 inline const mqbconfm::Storage& VirtualStorage::config() const
 {
     return d_storage_p->config();
@@ -546,7 +623,7 @@ inline mqbu::CapacityMeter* VirtualStorage::capacityMeter()
 inline bsls::Types::Int64 VirtualStorage::numMessages(
     BSLS_ANNOTATION_UNUSED const mqbu::StorageKey& appKey) const
 {
-    return d_guids.size();
+    return d_numMessages;
 }
 
 inline bsls::Types::Int64 VirtualStorage::numBytes(
@@ -568,7 +645,8 @@ inline bool VirtualStorage::isEmpty() const
 
 inline bool VirtualStorage::hasMessage(const bmqt::MessageGUID& msgGUID) const
 {
-    return 1 == d_guids.count(msgGUID);
+    DataStreamConstIterator cit = d_dataStream_p->find(msgGUID);
+    return cit != d_dataStream_p->end() && cit->second.isPending(d_ordinal);
 }
 
 }  // close package namespace
@@ -26,6 +26,7 @@
 #include <mqbmock_queue.h>
 #include <mqbmock_queueengine.h>
 #include <mqbs_inmemorystorage.h>
+#include <mqbs_virtualstoragecatalog.h>
 #include <mqbstat_brokerstats.h>
 #include <mqbu_messageguidutil.h>
 #include <mqbu_storagekey.h>
@@ -34,6 +35,9 @@
 #include <bmqt_messageguid.h>
 #include <bmqt_uri.h>
 
+// MWC
+#include <mwcc_orderedhashmap.h>
+
 // BDE
 #include <bdlbb_blob.h>
 #include <bdlbb_blobutil.h>
@@ -43,6 +47,7 @@
 #include <bsl_vector.h>
 #include <bslma_allocator.h>
 #include <bslma_managedptr.h>
+#include <bslma_testallocator.h>
 #include <bsls_assert.h>
 #include <bsls_types.h>
 
@@ -68,7 +73,12 @@ using namespace bsl;
 // - remove
 // - removeAll
 // - getIterator
+// - sharedDataStream
+// - parkedIterator
+// - parkedIteratorErasedMessages
+// - parkedIteratorPurgedMessage
 //-----------------------------------------------------------------------------
+// - fanoutMemoryFootprint
 
 // ============================================================================
 //                            TEST HELPERS UTILITY
@@ -113,6 +123,31 @@ static bmqt::MessageGUID generateUniqueGUID(MessageGuids* guids)
 }
 
 // CLASSES
+// ====================
+// struct PerAppContext
+// ====================
+
+/// Per-app entry of a per-app GUID map, the layout used by
+/// `mqbs::VirtualStorage` before the introduction of the shared data stream.
+/// Used as a reference by the memory footprint test.
+struct PerAppContext {
+    int           d_size;
+    bmqp::RdaInfo d_rdaInfo;
+    unsigned int  d_subscriptionId;
+
+    explicit PerAppContext(int size)
+    : d_size(size)
+    , d_rdaInfo()
+    , d_subscriptionId(bmqp::Protocol::k_DEFAULT_SUBSCRIPTION_ID)
+    {
+    }
+};
+
+typedef mwcc::OrderedHashMap<bmqt::MessageGUID,
+                             PerAppContext,
+                             bslh::Hash<bmqt::MessageGUIDHashAlgo> >
+    PerAppGuidList;
+
 // =============
 // struct Tester
 // =============
@@ -761,6 +796,553 @@ static void test9_getIterator()
               mqbi::StorageResult::e_SUCCESS);
 }
 
+static void test10_sharedDataStream()
+// ------------------------------------------------------------------------
+// SHARED DATA STREAM
+//
+// Concerns:
+//   Virtual storages created by a 'mqbs::VirtualStorageCatalog' share a
+//   single data stream, while keeping independent per-app state: pending
+//   messages, counts, RDA info and iteration.  A message is dropped from
+//   the data stream once no app has it pending, and the ordinal of a
+//   removed app is reused without leaking its state.
+//
+// Testing:
+//   mqbs::VirtualStorageCatalog::put(...)
+//   mqbs::VirtualStorageCatalog::remove(...)
+//   mqbs::VirtualStorageCatalog::removeAll(...)
+//   mqbs::VirtualStorageCatalog::addVirtualStorage(...)
+//   mqbs::VirtualStorageCatalog::removeVirtualStorage(...)
+//   mqbs::VirtualStorageCatalog::hasMessage(...)
+//   getIterator(...)
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("SHARED DATA STREAM");
+
+    Tester                      tester;
+    mqbs::VirtualStorageCatalog catalog(&tester.storage(), s_allocator_p);
+    mwcu::MemOutStream          errDescription(s_allocator_p);
+    const mqbu::StorageKey      k_NULL_KEY = mqbu::StorageKey::k_NULL_KEY;
+    const mqbu::StorageKey      k_KEY1(1u);
+    const mqbu::StorageKey      k_KEY2(2u);
+    const mqbu::StorageKey      k_KEY3(3u);
+    const mqbu::StorageKey      k_KEY4(4u);
+    const int                   k_MSG_COUNT = 5;
+    MessageGuids                guids;
+
+    ASSERT_EQ(catalog.addVirtualStorage(errDescription, "app1", k_KEY1), 0);
+    ASSERT_EQ(catalog.addVirtualStorage(errDescription, "app2", k_KEY2), 0);
+    ASSERT_EQ(catalog.addVirtualStorage(errDescription, "app3", k_KEY3), 0);
+
+    // Put messages for all apps
+    for (int i = 0; i < k_MSG_COUNT; ++i) {
+        ASSERT_EQ(catalog.put(generateUniqueGUID(&guids),
+                              k_DEFAULT_MSG_SIZE,
+                              bmqp::RdaInfo(),
+                              bmqp::Protocol::k_DEFAULT_SUBSCRIPTION_ID,
+                              k_NULL_KEY),
+                  mqbi::StorageResult::e_SUCCESS);
+    }
+
+    ASSERT_EQ(catalog.numMessages(k_KEY1), k_MSG_COUNT);
+    ASSERT_EQ(catalog.numMessages(k_KEY2), k_MSG_COUNT);
+    ASSERT_EQ(catalog.numMessages(k_KEY3), k_MSG_COUNT);
+    ASSERT_EQ(catalog.numBytes(k_KEY1), k_MSG_COUNT * k_DEFAULT_MSG_SIZE);
+
+    // Confirming for one app does not affect the others
+    ASSERT_EQ(catalog.remove(guids[0], k_KEY1),
+              mqbi::StorageResult::e_SUCCESS);
+    ASSERT_EQ(catalog.remove(guids[0], k_KEY1),
+              mqbi::StorageResult::e_GUID_NOT_FOUND);
+    ASSERT_EQ(catalog.numMessages(k_KEY1), k_MSG_COUNT - 1);
+    ASSERT_EQ(catalog.numBytes(k_KEY1),
+              (k_MSG_COUNT - 1) * k_DEFAULT_MSG_SIZE);
+    ASSERT_EQ(catalog.numMessages(k_KEY2), k_MSG_COUNT);
+    ASSERT(!catalog.virtualStorage(k_KEY1)->hasMessage(guids[0]));
+    ASSERT(catalog.virtualStorage(k_KEY2)->hasMessage(guids[0]));
+    ASSERT(catalog.hasMessage(guids[0]));
+
+    bslma::ManagedPtr<mqbi::StorageIterator> it1 = catalog.getIterator(
+        k_KEY1);
+    bslma::ManagedPtr<mqbi::StorageIterator> it2 = catalog.getIterator(
+        k_KEY2);
+    ASSERT_EQ(it1->guid(), guids[1]);
+    ASSERT_EQ(it2->guid(), guids[0]);
+
+    bslma::ManagedPtr<mqbi::StorageIterator> out;
+    ASSERT_EQ(catalog.getIterator(&out, k_KEY1, guids[0]),
+              mqbi::StorageResult::e_GUID_NOT_FOUND);
+    ASSERT_EQ(catalog.getIterator(&out, k_KEY2, guids[0]),
+              mqbi::StorageResult::e_SUCCESS);
+
+    // RDA info is per app
+    it1->rdaInfo().setCounter(3);
+    ASSERT(it2->advance());
+    ASSERT_EQ(it2->guid(), guids[1]);
+    ASSERT_EQ(it1->rdaInfo().counter(), 3u);
+    ASSERT(it2->rdaInfo().isUnlimited());
+
+    // A message not pending for any app is dropped from the data stream
+    ASSERT_EQ(catalog.remove(guids[0], k_KEY2),
+              mqbi::StorageResult::e_SUCCESS);
+    ASSERT(catalog.hasMessage(guids[0]));
+    ASSERT_EQ(catalog.remove(guids[0], k_KEY3),
+              mqbi::StorageResult::e_SUCCESS);
+    ASSERT(!catalog.hasMessage(guids[0]));
+
+    // A message put for one app only is not visible to the others
+    bmqt::MessageGUID appOnlyGuid = generateUniqueGUID(&guids);
+    ASSERT_EQ(catalog.put(appOnlyGuid,
+                          k_DEFAULT_MSG_SIZE,
+                          bmqp::RdaInfo(),
+                          bmqp::Protocol::k_DEFAULT_SUBSCRIPTION_ID,
+                          k_KEY2),
+              mqbi::StorageResult::e_SUCCESS);
+    ASSERT_EQ(catalog.numMessages(k_KEY2), k_MSG_COUNT);
+    ASSERT_EQ(catalog.numMessages(k_KEY3), k_MSG_COUNT - 1);
+    ASSERT(!catalog.virtualStorage(k_KEY1)->hasMessage(appOnlyGuid));
+
+    int numIterated = 0;
+    for (it1->reset(); !it1->atEnd(); it1->advance()) {
+        ASSERT_NE(it1->guid(), appOnlyGuid);
+        ++numIterated;
+    }
+    ASSERT_EQ(numIterated, k_MSG_COUNT - 1);
+
+    numIterated = 0;
+    for (it2->reset(); !it2->atEnd(); it2->advance()) {
+        ++numIterated;
+    }
+    ASSERT_EQ(numIterated, k_MSG_COUNT);
+
+    // Removing an app clears its state, and its ordinal is reused
+    it1.reset();
+    ASSERT(catalog.removeVirtualStorage(k_KEY1));
+    ASSERT_EQ(catalog.addVirtualStorage(errDescription, "app4", k_KEY4), 0);
+    ASSERT_EQ(catalog.numVirtualStorages(), 3);
+    ASSERT_EQ(catalog.numMessages(k_KEY4), 0);
+    ASSERT(!catalog.virtualStorage(k_KEY4)->hasMessage(guids[1]));
+    ASSERT(catalog.getIterator(k_KEY4)->atEnd());
+
+    // Clearing one app
+    it2.reset();
+    ASSERT_EQ(catalog.removeAll(k_KEY2), mqbi::StorageResult::e_SUCCESS);
+    ASSERT_EQ(catalog.numMessages(k_KEY2), 0);
+    ASSERT_EQ(catalog.numBytes(k_KEY2), 0);
+    ASSERT(!catalog.hasMessage(appOnlyGuid));
+    ASSERT(catalog.hasMessage(guids[1]));
+    ASSERT_EQ(catalog.numMessages(k_KEY3), k_MSG_COUNT - 1);
+
+    // Clearing all apps
+    ASSERT_EQ(catalog.removeAll(k_NULL_KEY), mqbi::StorageResult::e_SUCCESS);
+    ASSERT_EQ(catalog.numMessages(k_KEY3), 0);
+    ASSERT_EQ(catalog.numBytes(k_KEY3), 0);
+    ASSERT(!catalog.hasMessage(guids[1]));
+
+    catalog.removeVirtualStorage(k_NULL_KEY);
+}
+
+static void test11_parkedIterator()
+// ------------------------------------------------------------------------
+// PARKED ITERATOR
+//
+// Concerns:
+//   An iterator of a virtual storage sharing its data stream with other
+//   apps, and left in place (at the end of the stream, or on a message),
+//   is moved by 'resume' onto messages pending for its app only, without
+//   having to be reset or advanced, even if messages pending for other
+//   apps only were put, or the message it points at was confirmed for its
+//   app, since it was last moved.
+//
+// Testing:
+//   VirtualStorageIterator::resume()
+//   VirtualStorageIterator::atEnd()
+//   VirtualStorageIterator::guid()
+//   VirtualStorageIterator::appData()
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("PARKED ITERATOR");
+
+    Tester                      tester;
+    mqbs::VirtualStorageCatalog catalog(&tester.storage(), s_allocator_p);
+    mwcu::MemOutStream          errDescription(s_allocator_p);
+    const mqbu::StorageKey      k_NULL_KEY = mqbu::StorageKey::k_NULL_KEY;
+    const mqbu::StorageKey      k_KEY1(1u);
+    const mqbu::StorageKey      k_KEY2(2u);
+    MessageGuids                guids;
+
+    ASSERT_EQ(tester.configure(k_INT64_MAX, k_INT64_MAX), 0);
+    ASSERT_EQ(catalog.addVirtualStorage(errDescription, "app1", k_KEY1), 0);
+    ASSERT_EQ(catalog.addVirtualStorage(errDescription, "app2", k_KEY2), 0);
+
+    bslma::ManagedPtr<mqbi::StorageIterator> it1 = catalog.getIterator(
+        k_KEY1);
+    bslma::ManagedPtr<mqbi::StorageIterator> it2 = catalog.getIterator(
+        k_KEY2);
+    ASSERT(it1->atEnd());
+    ASSERT(it2->atEnd());
+
+    // Messages put for app2 only are not seen by the iterator of app1 parked
+    // at the end of the stream.
+    const bmqt::MessageGUID app2Guid1 = generateUniqueGUID(&guids);
+    const bmqt::MessageGUID app2Guid2 = generateUniqueGUID(&guids);
+    ASSERT_EQ(catalog.put(app2Guid1,
+                          k_DEFAULT_MSG_SIZE,
+                          bmqp::RdaInfo(),
+                          bmqp::Protocol::k_DEFAULT_SUBSCRIPTION_ID,
+                          k_KEY2),
+              mqbi::StorageResult::e_SUCCESS);
+    ASSERT_EQ(catalog.put(app2Guid2,
+                          k_DEFAULT_MSG_SIZE,
+                          bmqp::RdaInfo(),
+                          bmqp::Protocol::k_DEFAULT_SUBSCRIPTION_ID,
+                          k_KEY2),
+              mqbi::StorageResult::e_SUCCESS);
+    it1->resume();
+    it2->resume();
+    ASSERT(it1->atEnd());
+    ASSERT(!it1->hasReceipt());
+    ASSERT(!it2->atEnd());
+    ASSERT_EQ(it2->guid(), app2Guid1);
+
+    // A message put for all apps is resumed onto by both parked iterators
+    MessageGuids allGuids(s_allocator_p);
+    allGuids.push_back(generateUniqueGUID(&guids));
+    allGuids.push_back(generateUniqueGUID(&guids));
+    ASSERT_EQ(tester.addPhysicalMessages(allGuids),
+              mqbi::StorageResult::e_SUCCESS);
+    for (size_t i = 0; i < allGuids.size(); ++i) {
+        ASSERT_EQ(catalog.put(allGuids[i],
+                              k_DEFAULT_MSG_SIZE,
+                              bmqp::RdaInfo(),
+                              bmqp::Protocol::k_DEFAULT_SUBSCRIPTION_ID,
+                              k_NULL_KEY),
+                  mqbi::StorageResult::e_SUCCESS);
+    }
+    it1->resume();
+    it2->resume();
+    ASSERT(!it1->atEnd());
+    ASSERT_EQ(it1->guid(), allGuids[0]);
+    ASSERT(it1->appData());
+    ASSERT_EQ(it2->guid(), app2Guid1);
+
+    // Confirming, for app1, the message the iterator of app1 is parked on
+    // moves it to the next message pending for app1, with its own data.
+    ASSERT_EQ(catalog.remove(allGuids[0], k_KEY1),
+              mqbi::StorageResult::e_SUCCESS);
+    ASSERT(catalog.hasMessage(allGuids[0]));
+    it1->resume();
+    ASSERT_EQ(it1->guid(), allGuids[1]);
+    ASSERT_EQ(it1->attributes().arrivalTimestamp(), 1u);
+    ASSERT_EQ(*(reinterpret_cast<int*>(it1->appData()->buffer(0).data())),
+              1);
+
+    // Once the last message pending for app1 is confirmed, the iterator of
+    // app1 is at the end again, even though app2 has messages pending.
+    ASSERT_EQ(catalog.remove(allGuids[1], k_KEY1),
+              mqbi::StorageResult::e_SUCCESS);
+    it1->resume();
+    it2->resume();
+    ASSERT(it1->atEnd());
+    ASSERT(!it2->atEnd());
+    ASSERT_EQ(it2->guid(), app2Guid1);
+
+    // Confirming for app2 the messages it is parked on, one at a time
+    ASSERT_EQ(catalog.remove(app2Guid1, k_KEY2),
+              mqbi::StorageResult::e_SUCCESS);
+    it2->resume();
+    ASSERT_EQ(it2->guid(), app2Guid2);
+    ASSERT_EQ(catalog.remove(app2Guid2, k_KEY2),
+              mqbi::StorageResult::e_SUCCESS);
+    it2->resume();
+    ASSERT_EQ(it2->guid(), allGuids[0]);
+    ASSERT(it2->advance());
+    ASSERT_EQ(it2->guid(), allGuids[1]);
+    ASSERT(!it2->advance());
+
+    it1.reset();
+    it2.reset();
+    ASSERT_EQ(catalog.removeAll(k_NULL_KEY), mqbi::StorageResult::e_SUCCESS);
+    catalog.removeVirtualStorage(k_NULL_KEY);
+}
+
+static void test12_parkedIteratorErasedMessages()
+// ------------------------------------------------------------------------
+// PARKED ITERATOR ERASED MESSAGES
+//
+// Concerns:
+//   An iterator of a virtual storage left in place is moved by 'resume'
+//   onto the next message pending for its app, without having to be reset
+//   or advanced, when the message it points at, and those following it,
+//   were erased from the shared data stream since it was last moved,
+//   including when whole segments of the data stream were released.
+//
+// Testing:
+//   VirtualStorageIterator::resume()
+//   VirtualStorageIterator::atEnd()
+//   VirtualStorageIterator::guid()
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("PARKED ITERATOR ERASED MESSAGES");
+
+    Tester                      tester;
+    mqbs::VirtualStorageCatalog catalog(&tester.storage(), s_allocator_p);
+    mwcu::MemOutStream          errDescription(s_allocator_p);
+    const mqbu::StorageKey      k_NULL_KEY = mqbu::StorageKey::k_NULL_KEY;
+    const mqbu::StorageKey      k_KEY1(1u);
+    const mqbu::StorageKey      k_KEY2(2u);
+    const int                   k_MSG_COUNT = 200;  // several segments
+    const int                   k_PARKED    = 40;
+    const int                   k_SURVIVOR  = 170;
+    MessageGuids                guids;
+
+    ASSERT_EQ(catalog.addVirtualStorage(errDescription, "app1", k_KEY1), 0);
+    ASSERT_EQ(catalog.addVirtualStorage(errDescription, "app2", k_KEY2), 0);
+
+    bslma::ManagedPtr<mqbi::StorageIterator> it1 = catalog.getIterator(
+        k_KEY1);
+    ASSERT(it1->atEnd());
+
+    for (int i = 0; i < k_MSG_COUNT; ++i) {
+        ASSERT_EQ(catalog.put(generateUniqueGUID(&guids),
+                              k_DEFAULT_MSG_SIZE,
+                              bmqp::RdaInfo(),
+                              bmqp::Protocol::k_DEFAULT_SUBSCRIPTION_ID,
+                              k_KEY2),
+                  mqbi::StorageResult::e_SUCCESS);
+    }
+    it1->resume();
+    ASSERT(it1->atEnd());
+
+    // Park the iterator of app2 on a message, then erase it and all the
+    // messages but one after it, releasing the segments holding them.
+    bslma::ManagedPtr<mqbi::StorageIterator> it2 = catalog.getIterator(
+        k_KEY2);
+    for (int i = 0; i < k_PARKED; ++i) {
+        ASSERT(it2->advance());
+    }
+    ASSERT_EQ(it2->guid(), guids[k_PARKED]);
+
+    for (int i = k_PARKED; i < k_MSG_COUNT; ++i) {
+        if (i != k_SURVIVOR) {
+            ASSERT_EQ(catalog.remove(guids[i], k_KEY2),
+                      mqbi::StorageResult::e_SUCCESS);
+        }
+    }
+    ASSERT(!catalog.hasMessage(guids[k_PARKED]));
+    it2->resume();
+    ASSERT(!it2->atEnd());
+    ASSERT_EQ(it2->guid(), guids[k_SURVIVOR]);
+    ASSERT(!it2->advance());
+    ASSERT(it1->atEnd());
+
+    // Erasing the remaining messages of app2 while the iterator of app1 is
+    // parked at the end of the stream, then putting one for all apps.
+    ASSERT_EQ(catalog.removeAll(k_KEY2), mqbi::StorageResult::e_SUCCESS);
+    it2->resume();
+    ASSERT(it2->atEnd());
+
+    const bmqt::MessageGUID allGuid = generateUniqueGUID(&guids);
+    ASSERT_EQ(catalog.put(allGuid,
+                          k_DEFAULT_MSG_SIZE,
+                          bmqp::RdaInfo(),
+                          bmqp::Protocol::k_DEFAULT_SUBSCRIPTION_ID,
+                          k_NULL_KEY),
+              mqbi::StorageResult::e_SUCCESS);
+    it1->resume();
+    it2->resume();
+    ASSERT_EQ(it1->guid(), allGuid);
+    ASSERT_EQ(it2->guid(), allGuid);
+
+    // Clearing app1 while its iterator is parked on its only message
+    ASSERT_EQ(catalog.removeAll(k_KEY1), mqbi::StorageResult::e_SUCCESS);
+    it1->resume();
+    it2->resume();
+    ASSERT(it1->atEnd());
+    ASSERT_EQ(it2->guid(), allGuid);
+
+    it1.reset();
+    it2.reset();
+    ASSERT_EQ(catalog.removeAll(k_NULL_KEY), mqbi::StorageResult::e_SUCCESS);
+    catalog.removeVirtualStorage(k_NULL_KEY);
+}
+
+static void test13_parkedIteratorPurgedMessage()
+// ------------------------------------------------------------------------
+// PARKED ITERATOR PURGED MESSAGE
+//
+// Concerns:
+//   1. Reading an iterator left in place does not move it: its accessors
+//      keep returning the message it points at, even if that message was
+//      confirmed for its app, until 'resume' is called.
+//   2. 'resume' moves an iterator parked on a message purged since it was
+//      last moved onto the next message pending for its app.
+//
+// Testing:
+//   VirtualStorageIterator::resume()
+//   VirtualStorageIterator::guid()
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("PARKED ITERATOR PURGED MESSAGE");
+
+    Tester                      tester;
+    mqbs::VirtualStorageCatalog catalog(&tester.storage(), s_allocator_p);
+    mwcu::MemOutStream          errDescription(s_allocator_p);
+    const mqbu::StorageKey      k_NULL_KEY = mqbu::StorageKey::k_NULL_KEY;
+    const mqbu::StorageKey      k_KEY1(1u);
+    const mqbu::StorageKey      k_KEY2(2u);
+    MessageGuids                guids;
+
+    ASSERT_EQ(catalog.addVirtualStorage(errDescription, "app1", k_KEY1), 0);
+    ASSERT_EQ(catalog.addVirtualStorage(errDescription, "app2", k_KEY2), 0);
+
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_EQ(catalog.put(generateUniqueGUID(&guids),
+                              k_DEFAULT_MSG_SIZE,
+                              bmqp::RdaInfo(),
+                              bmqp::Protocol::k_DEFAULT_SUBSCRIPTION_ID,
+                              k_KEY1),
+                  mqbi::StorageResult::e_SUCCESS);
+    }
+
+    bslma::ManagedPtr<mqbi::StorageIterator> it1 = catalog.getIterator(
+        k_KEY1);
+    ASSERT_EQ(it1->guid(), guids[0]);
+
+    // Purge the queue while the iterator is parked on its first message,
+    // then put a message for all apps, and one for app1 only.
+    ASSERT_EQ(catalog.removeAll(k_NULL_KEY), mqbi::StorageResult::e_SUCCESS);
+    ASSERT(!catalog.hasMessage(guids[0]));
+
+    const bmqt::MessageGUID allGuid  = generateUniqueGUID(&guids);
+    const bmqt::MessageGUID app1Guid = generateUniqueGUID(&guids);
+    ASSERT_EQ(catalog.put(allGuid,
+                          k_DEFAULT_MSG_SIZE,
+                          bmqp::RdaInfo(),
+                          bmqp::Protocol::k_DEFAULT_SUBSCRIPTION_ID,
+                          k_NULL_KEY),
+              mqbi::StorageResult::e_SUCCESS);
+    ASSERT_EQ(catalog.put(app1Guid,
+                          k_DEFAULT_MSG_SIZE,
+                          bmqp::RdaInfo(),
+                          bmqp::Protocol::k_DEFAULT_SUBSCRIPTION_ID,
+                          k_KEY1),
+              mqbi::StorageResult::e_SUCCESS);
+
+    it1->resume();
+    ASSERT(!it1->atEnd());
+    ASSERT_EQ(it1->guid(), allGuid);
+    ASSERT_EQ(it1->guid(), allGuid);
+
+    // Confirming, for app1, the message the iterator is parked on keeps it
+    // in the stream, for app2.  Reading the iterator does not move it.
+    ASSERT_EQ(catalog.remove(allGuid, k_KEY1),
+              mqbi::StorageResult::e_SUCCESS);
+    ASSERT(catalog.hasMessage(allGuid));
+    ASSERT_EQ(it1->guid(), allGuid);
+    ASSERT_EQ(it1->guid(), allGuid);
+
+    it1->resume();
+    ASSERT_EQ(it1->guid(), app1Guid);
+    ASSERT_EQ(it1->guid(), app1Guid);
+    ASSERT(!it1->advance());
+    ASSERT(it1->atEnd());
+
+    it1.reset();
+    ASSERT_EQ(catalog.removeAll(k_NULL_KEY), mqbi::StorageResult::e_SUCCESS);
+    catalog.removeVirtualStorage(k_NULL_KEY);
+}
+
+// ============================================================================
+//                              PERFORMANCE TESTS
+// ----------------------------------------------------------------------------
+
+static void testN1_fanoutMemoryFootprint()
+// ------------------------------------------------------------------------
+// FANOUT MEMORY FOOTPRINT
+//
+// Concerns:
+//   Report the memory used to track the pending messages of a fanout
+//   queue with 1, 10 and 50 apps, using the shared data stream of
+//   'mqbs::VirtualStorageCatalog', compared to one ordered hash map of
+//   GUIDs per app (the layout previously used by 'mqbs::VirtualStorage').
+//
+// Plan:
+//   - For each number of apps, put the same messages to all apps, and
+//     report the bytes in use, per message, of a test allocator.
+//
+// Testing:
+//   Memory footprint
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("FANOUT MEMORY FOOTPRINT");
+
+    const int k_NUM_MESSAGES = 100000;
+    const int k_NUM_APPS[]   = {1, 10, 50};
+
+    Tester       tester;
+    MessageGuids guids;
+    guids.reserve(k_NUM_MESSAGES);
+    for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+        bmqt::MessageGUID guid;
+        mqbu::MessageGUIDUtil::generateGUID(&guid);
+        guids.push_back(guid);
+    }
+
+    for (size_t n = 0; n < sizeof(k_NUM_APPS) / sizeof(*k_NUM_APPS); ++n) {
+        const int numApps = k_NUM_APPS[n];
+
+        bsls::Types::Int64 perAppMapsBytes = 0;
+        {
+            bslma::TestAllocator         ta("perApp");
+            bsl::vector<PerAppGuidList*> lists(&ta);
+            const PerAppContext          context(k_DEFAULT_MSG_SIZE);
+            for (int app = 0; app < numApps; ++app) {
+                lists.push_back(new (ta) PerAppGuidList(&ta));
+            }
+            const bsls::Types::Int64 baseline = ta.numBytesInUse();
+            for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+                for (int app = 0; app < numApps; ++app) {
+                    lists[app]->insert(bsl::make_pair(guids[i], context));
+                }
+            }
+            perAppMapsBytes = ta.numBytesInUse() - baseline;
+            for (int app = 0; app < numApps; ++app) {
+                ta.deleteObject(lists[app]);
+            }
+        }
+
+        bsls::Types::Int64 dataStreamBytes = 0;
+        {
+            bslma::TestAllocator        ta("dataStream");
+            mqbs::VirtualStorageCatalog catalog(&tester.storage(), &ta);
+            mwcu::MemOutStream          errDescription(&ta);
+            for (int app = 0; app < numApps; ++app) {
+                mwcu::MemOutStream appId(&ta);
+                appId << "app" << app;
+                mqbu::StorageKey appKey(static_cast<unsigned int>(app + 1));
+                catalog.addVirtualStorage(errDescription, appId.str(), appKey);
+            }
+            const bsls::Types::Int64 baseline = ta.numBytesInUse();
+            for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+                catalog.put(guids[i],
+                            k_DEFAULT_MSG_SIZE,
+                            bmqp::RdaInfo(),
+                            bmqp::Protocol::k_DEFAULT_SUBSCRIPTION_ID,
+                            mqbu::StorageKey::k_NULL_KEY);
+            }
+            dataStreamBytes = ta.numBytesInUse() - baseline;
+            catalog.removeVirtualStorage(mqbu::StorageKey::k_NULL_KEY);
+        }
+
+        cout << numApps << " app(s), " << k_NUM_MESSAGES << " messages:\n"
+             << "  per-app GUID maps : " << perAppMapsBytes / k_NUM_MESSAGES
+             << " bytes per message\n"
+             << "  shared data stream: " << dataStreamBytes / k_NUM_MESSAGES
+             << " bytes per message\n";
+    }
+}
+
 // ============================================================================
 //                                 MAIN PROGRAM
 // ----------------------------------------------------------------------------
@@ -780,6 +1362,10 @@ int main(int argc, char* argv[])
 
         switch (_testCase) {
         case 0:
+        case 13: test13_parkedIteratorPurgedMessage(); break;
+        case 12: test12_parkedIteratorErasedMessages(); break;
+        case 11: test11_parkedIterator(); break;
+        case 10: test10_sharedDataStream(); break;
         case 9: test9_getIterator(); break;
         case 8: test8_removeAll(); break;
         case 7: test7_remove(); break;
@@ -789,6 +1375,7 @@ int main(int argc, char* argv[])
         case 3: test3_put(); break;
         case 2: test2_unsupportedOperations(); break;
         case 1: test1_breathingTest(); break;
+        case -1: testN1_fanoutMemoryFootprint(); break;
         default: {
             cerr << "WARNING: CASE '" << _testCase << "' NOT FOUND." << endl;
             s_testStatus = -1;
@@ -23,6 +23,7 @@
 // BDE
 #include <bdlbb_blob.h>
 #include <bsl_utility.h>
+#include <bsl_vector.h>
 #include <bslma_allocator.h>
 #include <bsls_annotation.h>
 #include <bsls_assert.h>
@@ -34,10 +35,35 @@ namespace mqbs {
 // class VirtualStorageCatalog
 // ---------------------------
 
+// PRIVATE ACCESSORS
+int VirtualStorageCatalog::nextOrdinal() const
+{
+    bsl::vector<bool> isUsed(d_virtualStorages.size() + 1,
+                             false,
+                             d_allocator_p);
+
+    for (VirtualStoragesConstIter cit = d_virtualStorages.begin();
+         cit != d_virtualStorages.end();
+         ++cit) {
+        const size_t ordinal = cit->second->ordinal();
+        if (ordinal < isUsed.size()) {
+            isUsed[ordinal] = true;
+        }
+    }
+
+    int ordinal = 0;
+    while (isUsed[ordinal]) {
+        ++ordinal;
+    }
+
+    return ordinal;
+}
+
 // CREATORS
 VirtualStorageCatalog::VirtualStorageCatalog(mqbi::Storage*    storage,
                                              bslma::Allocator* allocator)
 : d_storage_p(storage)
+, d_dataStream(allocator)
 , d_virtualStorages(allocator)
 , d_allocator_p(allocator)
 {
@@ -50,6 +76,7 @@ VirtualStorageCatalog::~VirtualStorageCatalog()
 {
     // TBD: Should it be asserted here that 'd_virtualStorages' is empty?
     d_virtualStorages.clear();
+    d_dataStream.clear();
 }
 
 // MANIPULATORS
@@ -70,12 +97,27 @@ VirtualStorageCatalog::put(const bmqt::MessageGUID& msgGUID,
                                subScriptionId);  // RETURN
     }
 
-    // Add guid to all virtual storages.
+    // Add guid to all virtual storages: insert it once in the shared data
+    // stream, and set the bit of each app.
+
+    if (d_virtualStorages.empty()) {
+        return mqbi::StorageResult::e_SUCCESS;  // RETURN
+    }
+
+    VirtualStorage::DataStreamIterator data = d_dataStream.find(msgGUID);
+    if (data == d_dataStream.end()) {
+        data = d_dataStream
+                   .insert(bsl::make_pair(
+                       msgGUID,
+                       VirtualStorage::DataStreamMessage(msgSize,
+                                                         d_allocator_p)))
+                   .first;
+    }
 
     for (VirtualStoragesIter it = d_virtualStorages.begin();
          it != d_virtualStorages.end();
          ++it) {
-        it->second->put(msgGUID, msgSize, rdaInfo, subScriptionId);
+        it->second->setPending(data, rdaInfo, subScriptionId);  // ignore rc
     }
 
     return mqbi::StorageResult::e_SUCCESS;  // RETURN
@@ -134,11 +176,12 @@ VirtualStorageCatalog::removeAll(const mqbu::StorageKey& appKey)
         return it->second->removeAll(appKey);  // RETURN
     }
 
-    // Clear all virtual storages.
+    // Clear all virtual storages at once.
+    d_dataStream.clear();
     for (VirtualStoragesIter it = d_virtualStorages.begin();
          it != d_virtualStorages.end();
          ++it) {
-        it->second->removeAll(it->first);  // ignore rc
+        it->second->resetCounts();
     }
 
     return mqbi::StorageResult::e_SUCCESS;
@@ -169,6 +212,8 @@ int VirtualStorageCatalog::addVirtualStorage(bsl::ostream& errorDescription,
                       d_storage_p,
                       appId,
                       appKey,
+                      &d_dataStream,
+                      nextOrdinal(),
                       d_allocator_p);
     d_virtualStorages.insert(bsl::make_pair(appKey, vsp));
 
@@ -181,11 +226,15 @@ bool VirtualStorageCatalog::removeVirtualStorage(
     if (appKey.isNull()) {
         // Remove all virtual storages
         d_virtualStorages.clear();
+        d_dataStream.clear();
         return true;  // RETURN
     }
 
-    VirtualStoragesConstIter it = d_virtualStorages.find(appKey);
+    VirtualStoragesIter it = d_virtualStorages.find(appKey);
     if (it != d_virtualStorages.end()) {
+        // Clear the bit of the app in the data stream so that its ordinal
+        // can be reused.
+        it->second->removeAll(appKey);
         d_virtualStorages.erase(it);
         return true;  // RETURN
     }
@@ -252,15 +301,9 @@ bool VirtualStorageCatalog::hasVirtualStorage(const bsl::string& appId,
 
 bool VirtualStorageCatalog::hasMessage(const bmqt::MessageGUID& msgGUID) const
 {
-    for (VirtualStoragesConstIter it = d_virtualStorages.begin();
-         it != d_virtualStorages.end();
-         ++it) {
-        if (it->second->hasMessage(msgGUID)) {
-            return true;  // RETURN
-        }
-    }
-
-    return false;
+    // A message is erased from the data stream as soon as it is not pending
+    // for any app.
+    return d_dataStream.find(msgGUID) != d_dataStream.end();
 }
 
 void VirtualStorageCatalog::loadVirtualStorageDetails(
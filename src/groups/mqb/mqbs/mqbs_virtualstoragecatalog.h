@@ -23,7 +23,10 @@
 //  mqbs::VirtualStorageCatalog: Catalog of virtual storages
 //
 //@DESCRIPTION: 'mqbs::VirtualStorageCatalog' provides a collection of virtual
-// storages associated with a queue.
+// storages associated with a queue.  All virtual storages of the catalog share
+// a single 'mqbs::VirtualStorage::DataStream', in which each app is
+// identified by an ordinal assigned by the catalog, so that each message is
+// stored once regardless of the number of apps.
 
 // MQB
 
@@ -71,6 +74,11 @@ class VirtualStorageCatalog {
                                  // virtual storages known to this
                                  // object
 
+    VirtualStorage::DataStream d_dataStream;
+    // Ordered sequence of the messages pending
+    // for at least one app, shared by all
+    // virtual storages of this catalog.
+
     VirtualStorages d_virtualStorages;
     // Map of appKey to corresponding
     // virtual storage
@@ -83,6 +91,13 @@ class VirtualStorageCatalog {
     VirtualStorageCatalog&
     operator=(const VirtualStorageCatalog&);  // = delete
 
+  private:
+    // PRIVATE ACCESSORS
+
+    /// Return the lowest ordinal not used by any virtual storage of this
+    /// catalog.
+    int nextOrdinal() const;
+
   public:
     // TRAITS
     BSLMF_NESTED_TRAIT_DECLARATION(VirtualStorageCatalog,
@@ -0,0 +1,195 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// mqbs_virtualstoragedatastream.cpp                                  -*-C++-*-
+#include <mqbs_virtualstoragedatastream.h>
+
+#include <mqbscm_version.h>
+// BDE
+#include <bsls_assert.h>
+
+namespace BloombergLP {
+namespace mqbs {
+
+// ------------------------------
+// class VirtualStorageDataStream
+// ------------------------------
+
+// PRIVATE MANIPULATORS
+VirtualStorageDataStream::Segment* VirtualStorageDataStream::allocateSegment()
+{
+    if (d_spareSegment_p) {
+        Segment* seg     = d_spareSegment_p;
+        d_spareSegment_p = 0;
+        return seg;  // RETURN
+    }
+
+    return new (*d_allocator_p) Segment();
+}
+
+void VirtualStorageDataStream::releaseSegment(Segment* segment)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(segment);
+    BSLS_ASSERT_SAFE(0 == segment->d_liveSlots);
+
+    if (!d_spareSegment_p) {
+        d_spareSegment_p = segment;
+        return;  // RETURN
+    }
+
+    d_allocator_p->deleteObject(segment);
+}
+
+void VirtualStorageDataStream::trimFront()
+{
+    while (!d_segments.empty() && 0 == d_segments.front()) {
+        d_segments.pop_front();
+        d_firstSequenceNumber += k_SEGMENT_SIZE;
+    }
+}
+
+// CREATORS
+VirtualStorageDataStream::VirtualStorageDataStream(
+    bslma::Allocator* allocator)
+: d_segments(allocator)
+, d_index(allocator)
+, d_firstSequenceNumber(0)
+, d_nextSequenceNumber(0)
+, d_spareSegment_p(0)
+, d_allocator_p(allocator)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(allocator);
+}
+
+VirtualStorageDataStream::~VirtualStorageDataStream()
+{
+    clear();
+
+    if (d_spareSegment_p) {
+        d_allocator_p->deleteObject(d_spareSegment_p);
+    }
+}
+
+// MANIPULATORS
+bsl::pair<VirtualStorageDataStream::iterator, bool>
+VirtualStorageDataStream::insert(const value_type& value)
+{
+    bsl::pair<Index::iterator, bool> irc = d_index.insert(
+        bsl::make_pair(value.first, d_nextSequenceNumber));
+    if (!irc.second) {
+        return bsl::make_pair(iterator(this, irc.first->second),
+                              false);  // RETURN
+    }
+
+    const bsls::Types::Uint64 sequenceNumber = d_nextSequenceNumber++;
+    const bsls::Types::Uint64 index = (sequenceNumber -
+                                       d_firstSequenceNumber) >>
+                                      k_SEGMENT_SIZE_LOG2;
+    if (index == d_segments.size()) {
+        d_segments.push_back(allocateSegment());
+    }
+    BSLS_ASSERT_SAFE(index < d_segments.size());
+
+    Segment*  seg    = d_segments[index];
+    const int offset = static_cast<int>(sequenceNumber & k_SEGMENT_MASK);
+    BSLS_ASSERT_SAFE(seg);
+
+    bslalg::ScalarPrimitives::copyConstruct(&seg->d_slots[offset].object(),
+                                            value,
+                                            d_allocator_p);
+    seg->d_liveSlots |= (1ULL << offset);
+
+    return bsl::make_pair(iterator(this, sequenceNumber), true);
+}
+
+VirtualStorageDataStream::iterator
+VirtualStorageDataStream::erase(const const_iterator& position)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(position.d_stream_p == this);
+
+    const bsls::Types::Uint64 sequenceNumber = position.sequenceNumber();
+    const bsls::Types::Uint64 index = (sequenceNumber -
+                                       d_firstSequenceNumber) >>
+                                      k_SEGMENT_SIZE_LOG2;
+    Segment*  seg    = segment(sequenceNumber);
+    const int offset = static_cast<int>(sequenceNumber & k_SEGMENT_MASK);
+
+    BSLS_ASSERT_SAFE(seg);
+    BSLS_ASSERT_SAFE(seg->d_liveSlots & (1ULL << offset));
+
+    value_type& value = seg->d_slots[offset].object();
+
+    const size_t numErased = d_index.erase(value.first);
+    BSLS_ASSERT_SAFE(1 == numErased);
+    static_cast<void>(numErased);
+
+    bslma::DestructionUtil::destroy(&value);
+    seg->d_liveSlots &= ~(1ULL << offset);
+
+    // Release the segment once all its slots have been used and erased.  The
+    // segment being filled is kept, unless the stream is empty.
+    const bool isFilled = (sequenceNumber | k_SEGMENT_MASK) <
+                          d_nextSequenceNumber;
+    if (0 == seg->d_liveSlots && (isFilled || d_index.empty())) {
+        releaseSegment(seg);
+        d_segments[index] = 0;
+
+        if (!isFilled) {
+            // The stream is empty: restart from the segment the next message
+            // will be inserted in.
+            BSLS_ASSERT_SAFE(index + 1 == d_segments.size());
+            d_segments.clear();
+            d_firstSequenceNumber = d_nextSequenceNumber &
+                                    ~static_cast<bsls::Types::Uint64>(
+                                        k_SEGMENT_MASK);
+        }
+        trimFront();
+    }
+
+    return iterator(this, nextLive(sequenceNumber + 1));
+}
+
+void VirtualStorageDataStream::clear()
+{
+    for (Segments::iterator it = d_segments.begin(); it != d_segments.end();
+         ++it) {
+        Segment* seg = *it;
+        if (!seg) {
+            continue;  // CONTINUE
+        }
+
+        for (int offset = 0; seg->d_liveSlots; ++offset) {
+            const bsls::Types::Uint64 bit = 1ULL << offset;
+            if (seg->d_liveSlots & bit) {
+                bslma::DestructionUtil::destroy(
+                    &seg->d_slots[offset].object());
+                seg->d_liveSlots &= ~bit;
+            }
+        }
+
+        releaseSegment(seg);
+    }
+
+    d_segments.clear();
+    d_index.clear();
+    d_firstSequenceNumber = d_nextSequenceNumber &
+                            ~static_cast<bsls::Types::Uint64>(k_SEGMENT_MASK);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
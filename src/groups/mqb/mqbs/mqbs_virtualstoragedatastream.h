@@ -0,0 +1,827 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// mqbs_virtualstoragedatastream.h                                    -*-C++-*-
+#ifndef INCLUDED_MQBS_VIRTUALSTORAGEDATASTREAM
+#define INCLUDED_MQBS_VIRTUALSTORAGEDATASTREAM
+
+//@PURPOSE: Provide a sequenced stream of messages shared by virtual storages.
+//
+//@CLASSES:
+//  mqbs::VirtualStorageDataStream: sequenced stream of messages
+//  mqbs::VirtualStorageDataStreamIterator: iterator over the stream
+//
+//@DESCRIPTION: 'mqbs::VirtualStorageDataStream' is the ordered sequence of
+// messages shared by all the virtual storages of a physical storage (see
+// 'mqbs::VirtualStorage' and 'mqbs::VirtualStorageCatalog').  Each message is
+// a 'VirtualStorageDataStream::Message' holding the size of the message and
+// the per-app state ('AppState') of every app, indexed by app ordinal.
+//
+// Every message is assigned, on arrival, a dense 64-bit sequence number which
+// is its primary index: messages are stored by sequence number in fixed-size
+// segments of contiguous slots, and a bitmap per segment tells which slots
+// hold a message.  A 'GUID -> sequence number' side index is only consulted
+// by the paths starting from a GUID (confirm, purge, lookup).  Iterating the
+// stream, which is what delivery does, therefore walks contiguous memory and
+// skips erased slots with bit operations, instead of chasing one heap node
+// per message.
+//
+// A segment is released as soon as all its slots have been used and erased,
+// so that messages stuck at the head of the stream do not pin the memory of
+// the ones which followed them, beyond their own segment.  One released
+// segment is kept aside to be reused by the next allocation.
+//
+/// Iterator Invalidation
+///---------------------
+// An iterator is a sequence number in a stream: it is *not* invalidated by
+// the insertion or the erasure of other messages.  Dereferencing an iterator
+// to an erased message is undefined behavior, but advancing it is not, and
+// 'lowerBound' moves it to the first message still in the stream.  Like
+// 'mwcc::OrderedHashMap', an iterator equal to 'end()' refers to the next
+// message to be inserted.
+//
+/// Thread Safety
+///-------------
+// NOT Thread-Safe.
+
+// BMQ
+#include <bmqp_protocol.h>
+#include <bmqt_messageguid.h>
+
+// BDE
+#include <bdlb_bitutil.h>
+#include <bsl_cstddef.h>
+#include <bsl_deque.h>
+#include <bsl_unordered_map.h>
+#include <bsl_utility.h>
+#include <bsl_vector.h>
+#include <bslalg_scalarprimitives.h>
+#include <bslh_hash.h>
+#include <bslma_allocator.h>
+#include <bslma_destructionutil.h>
+#include <bslma_usesbslmaallocator.h>
+#include <bslmf_nestedtraitdeclaration.h>
+#include <bslmf_removecv.h>
+#include <bsls_assert.h>
+#include <bsls_objectbuffer.h>
+#include <bsls_performancehint.h>
+#include <bsls_types.h>
+
+namespace BloombergLP {
+namespace mqbs {
+
+// FORWARD DECLARATION
+class VirtualStorageDataStream;
+
+// ======================================
+// class VirtualStorageDataStreamIterator
+// ======================================
+
+/// Iterator over the messages of a `VirtualStorageDataStream`, in sequence
+/// number order.  The (template parameter) `VALUE` is either the
+/// `value_type` of the stream or its `const` counterpart.
+template <class VALUE>
+class VirtualStorageDataStreamIterator {
+  private:
+    // PRIVATE TYPES
+    typedef typename bsl::remove_cv<VALUE>::type NcType;
+
+    typedef VirtualStorageDataStreamIterator<NcType> NcIter;
+
+    // FRIENDS
+    friend class VirtualStorageDataStream;
+
+    friend class VirtualStorageDataStreamIterator<const VALUE>;
+
+    template <class VALUE1, class VALUE2>
+    friend bool operator==(const VirtualStorageDataStreamIterator<VALUE1>&,
+                           const VirtualStorageDataStreamIterator<VALUE2>&);
+
+  private:
+    // DATA
+    const VirtualStorageDataStream* d_stream_p;
+
+    bsls::Types::Uint64 d_sequenceNumber;
+
+  private:
+    // PRIVATE CREATORS
+
+    /// Create an iterator over the specified `stream`, referring to the
+    /// message having the specified `sequenceNumber`.
+    VirtualStorageDataStreamIterator(const VirtualStorageDataStream* stream,
+                                     bsls::Types::Uint64 sequenceNumber);
+
+  public:
+    // CREATORS
+
+    /// Create a default-constructed iterator, which is not
+    /// dereferenceable.
+    VirtualStorageDataStreamIterator();
+
+    /// Create an iterator having the same value as the specified `other`.
+    /// Note that this constructor enables converting from modifiable to
+    /// const iterators.
+    VirtualStorageDataStreamIterator(const NcIter& other);
+
+    // MANIPULATORS
+
+    /// Advance this iterator to the next message of the stream, or to the
+    /// end of the stream, and return a reference to it.  The behavior is
+    /// undefined unless this iterator is not at the end of the stream.
+    VirtualStorageDataStreamIterator& operator++();
+
+    /// Advance this iterator as with the prefix `operator++` and return its
+    /// previous value.
+    VirtualStorageDataStreamIterator operator++(int);
+
+    // ACCESSORS
+
+    /// Return a reference to the message referred to by this iterator.
+    /// The behavior is undefined unless this iterator refers to a message
+    /// of the stream.
+    VALUE& operator*() const;
+
+    /// Return the address of the message referred to by this iterator.
+    /// The behavior is undefined unless this iterator refers to a message
+    /// of the stream.
+    VALUE* operator->() const;
+
+    /// Return the sequence number of the message referred to by this
+    /// iterator.
+    bsls::Types::Uint64 sequenceNumber() const;
+};
+
+// ==============================
+// class VirtualStorageDataStream
+// ==============================
+
+/// Sequenced stream of messages shared by the virtual storages of a
+/// physical storage.
+class VirtualStorageDataStream {
+  public:
+    // PUBLIC TYPES
+
+    /// State of a message for one app.
+    struct AppState {
+        // PUBLIC DATA
+        mutable bmqp::RdaInfo d_rdaInfo;
+
+        bool d_isPending;
+        // Whether the message is still pending for
+        // the app.
+
+        unsigned int d_subscriptionId;
+
+        // CREATORS
+
+        /// Create a non-pending `AppState` having default RDA info and
+        /// subscription id.
+        AppState();
+    };
+
+    /// State of a message shared by all the apps of a physical storage.
+    class Message {
+      private:
+        // DATA
+        int d_size;
+        // Size of the message, in bytes.
+
+        int d_numApps;
+        // Number of apps for which the message
+        // is pending.
+
+        AppState d_firstApp;
+        // State of the app having ordinal 0.
+
+        bsl::vector<AppState> d_otherApps;
+        // State of the apps having ordinal 1 and
+        // above, indexed by 'ordinal - 1'.  Grown
+        // on demand.
+
+      private:
+        // PRIVATE MANIPULATORS
+
+        /// Return a reference offering modifiable access to the state of
+        /// the app having the specified `ordinal`, growing the per-app
+        /// state as needed.
+        AppState& appState(int ordinal);
+
+      public:
+        // TRAITS
+        BSLMF_NESTED_TRAIT_DECLARATION(Message, bslma::UsesBslmaAllocator)
+
+        // CREATORS
+
+        /// Create a message of the specified `size`, pending for no app,
+        /// using the specified `allocator`.
+        Message(int size, bslma::Allocator* allocator);
+
+        /// Create a copy of the specified `other` using the optionally
+        /// specified `allocator`.
+        Message(const Message& other, bslma::Allocator* allocator = 0);
+
+        // MANIPULATORS
+
+        /// Mark this message as pending for the app having the specified
+        /// `ordinal`, with the specified `rdaInfo` and `subscriptionId`.
+        /// Return `false` if it already was pending for that app, and
+        /// `true` otherwise.
+        bool setPending(int                  ordinal,
+                        const bmqp::RdaInfo& rdaInfo,
+                        unsigned int         subscriptionId);
+
+        /// Mark this message as not pending for the app having the
+        /// specified `ordinal`.  Return `false` if it was not pending for
+        /// that app, and `true` otherwise.
+        bool clearPending(int ordinal);
+
+        // ACCESSORS
+
+        /// Return the size, in bytes, of this message.
+        int size() const;
+
+        /// Return the number of apps for which this message is pending.
+        int numApps() const;
+
+        /// Return `true` if this message is pending for the app having the
+        /// specified `ordinal`.
+        bool isPending(int ordinal) const;
+
+        /// Return a reference offering non-modifiable access to the state
+        /// of the app having the specified `ordinal`.  The behavior is
+        /// undefined unless `isPending(ordinal)`.
+        const AppState& app(int ordinal) const;
+    };
+
+    typedef bmqt::MessageGUID key_type;
+
+    typedef bsl::pair<const bmqt::MessageGUID, Message> value_type;
+
+    typedef VirtualStorageDataStreamIterator<value_type> iterator;
+
+    typedef VirtualStorageDataStreamIterator<const value_type> const_iterator;
+
+  private:
+    // FRIENDS
+    friend class VirtualStorageDataStreamIterator<value_type>;
+    friend class VirtualStorageDataStreamIterator<const value_type>;
+
+    // PRIVATE CONSTANTS
+    enum {
+        k_SEGMENT_SIZE_LOG2 = 5,
+        k_SEGMENT_SIZE      = 1 << k_SEGMENT_SIZE_LOG2,  // slots per segment
+        k_SEGMENT_MASK      = k_SEGMENT_SIZE - 1
+    };
+
+    // PRIVATE TYPES
+
+    /// Fixed-size array of slots, each holding a message or not, as told by
+    /// the bit of the slot in `d_liveSlots`.
+    struct Segment {
+        // PUBLIC DATA
+        bsls::ObjectBuffer<value_type> d_slots[k_SEGMENT_SIZE];
+
+        bsls::Types::Uint64 d_liveSlots;
+        // Bit 'i' is set if 'd_slots[i]' holds a
+        // message.
+
+        // CREATORS
+        Segment();
+    };
+
+    /// Segments by index, in sequence number order.  A null segment was
+    /// released after all its slots were used and erased.
+    typedef bsl::deque<Segment*> Segments;
+
+    /// GUID -> sequence number
+    typedef bsl::unordered_map<bmqt::MessageGUID,
+                               bsls::Types::Uint64,
+                               bslh::Hash<bmqt::MessageGUIDHashAlgo> >
+        Index;
+
+  private:
+    // DATA
+    Segments d_segments;
+    // Segments covering the sequence numbers
+    // in ['d_firstSequenceNumber',
+    // 'd_nextSequenceNumber').
+
+    Index d_index;
+    // Sequence number of each message.
+
+    bsls::Types::Uint64 d_firstSequenceNumber;
+    // Sequence number of the first slot of the
+    // first segment.  Always a multiple of
+    // 'k_SEGMENT_SIZE'.
+
+    bsls::Types::Uint64 d_nextSequenceNumber;
+    // Sequence number of the next message to
+    // be inserted.
+
+    Segment* d_spareSegment_p;
+    // Released segment kept aside to be
+    // reused, if any.  Owned.
+
+    bslma::Allocator* d_allocator_p;
+
+  private:
+    // NOT IMPLEMENTED
+    VirtualStorageDataStream(const VirtualStorageDataStream&);  // = delete
+    VirtualStorageDataStream&
+    operator=(const VirtualStorageDataStream&);  // = delete
+
+  private:
+    // PRIVATE MANIPULATORS
+
+    /// Return a new segment having no message.
+    Segment* allocateSegment();
+
+    /// Release the specified `segment`, which must not hold any message.
+    void releaseSegment(Segment* segment);
+
+    /// Release the leading null segments.
+    void trimFront();
+
+    // PRIVATE ACCESSORS
+
+    /// Return the segment holding the specified `sequenceNumber`, or 0 if
+    /// that segment was released or `sequenceNumber` is out of the range
+    /// of the stream.
+    Segment* segment(bsls::Types::Uint64 sequenceNumber) const;
+
+    /// Return the sequence number of the first message of the stream
+    /// having a sequence number greater than or equal to the specified
+    /// `sequenceNumber`, or `d_nextSequenceNumber` if there is none.
+    bsls::Types::Uint64 nextLive(bsls::Types::Uint64 sequenceNumber) const;
+
+    /// Return a reference to the message having the specified
+    /// `sequenceNumber`.  The behavior is undefined unless the stream
+    /// holds a message with that `sequenceNumber`.
+    value_type& slot(bsls::Types::Uint64 sequenceNumber) const;
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(VirtualStorageDataStream,
+                                   bslma::UsesBslmaAllocator)
+
+    // CREATORS
+
+    /// Create an empty stream using the specified `allocator`.
+    explicit VirtualStorageDataStream(bslma::Allocator* allocator);
+
+    /// Destroy this object.
+    ~VirtualStorageDataStream();
+
+    // MANIPULATORS
+
+    /// Return an iterator to the first message of this stream, or `end()`
+    /// if the stream is empty.
+    iterator begin();
+
+    /// Return an iterator referring to the next message to be inserted.
+    iterator end();
+
+    /// Return an iterator to the message having the specified `key`, or
+    /// `end()` if there is none.
+    iterator find(const key_type& key);
+
+    /// Append the specified `value` at the end of this stream, assigning it
+    /// the next sequence number, unless a message with the same key is
+    /// already in the stream.  Return a pair whose first member is an
+    /// iterator to the message having the key of `value`, and whose second
+    /// member is `true` if `value` was inserted and `false` otherwise.
+    bsl::pair<iterator, bool> insert(const value_type& value);
+
+    /// Remove the message referred to by the specified `position` and
+    /// return an iterator to the message following it.  The behavior is
+    /// undefined unless `position` refers to a message of this stream.
+    iterator erase(const const_iterator& position);
+
+    /// Remove all the messages of this stream.  Note that sequence numbers
+    /// keep increasing.
+    void clear();
+
+    // ACCESSORS
+
+    /// Return an iterator to the first message of this stream, or `end()`
+    /// if the stream is empty.
+    const_iterator begin() const;
+
+    /// Return an iterator referring to the next message to be inserted.
+    const_iterator end() const;
+
+    /// Return an iterator to the message having the specified `key`, or
+    /// `end()` if there is none.
+    const_iterator find(const key_type& key) const;
+
+    /// Return an iterator to the first message of this stream at or after
+    /// the specified `position`, or `end()` if there is none.  Note that
+    /// `position` may refer to a message which has since been erased.
+    const_iterator lowerBound(const const_iterator& position) const;
+
+    /// Return 1 if this stream has a message with the specified `key`, and
+    /// 0 otherwise.
+    bsl::size_t count(const key_type& key) const;
+
+    /// Return the number of messages in this stream.
+    bsl::size_t size() const;
+
+    /// Return `true` if this stream has no message, and `false` otherwise.
+    bool empty() const;
+};
+
+// FREE OPERATORS
+
+/// Return `true` if the specified `lhs` and `rhs` iterators refer to the
+/// same position of the same stream, and `false` otherwise.
+template <class VALUE1, class VALUE2>
+bool operator==(const VirtualStorageDataStreamIterator<VALUE1>& lhs,
+                const VirtualStorageDataStreamIterator<VALUE2>& rhs);
+
+/// Return `true` if the specified `lhs` and `rhs` iterators do not refer to
+/// the same position of the same stream, and `false` otherwise.
+template <class VALUE1, class VALUE2>
+bool operator!=(const VirtualStorageDataStreamIterator<VALUE1>& lhs,
+                const VirtualStorageDataStreamIterator<VALUE2>& rhs);
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+// --------------------------------------
+// class VirtualStorageDataStreamIterator
+// --------------------------------------
+
+// PRIVATE CREATORS
+template <class VALUE>
+inline VirtualStorageDataStreamIterator<VALUE>::
+    VirtualStorageDataStreamIterator(const VirtualStorageDataStream* stream,
+                                     bsls::Types::Uint64 sequenceNumber)
+: d_stream_p(stream)
+, d_sequenceNumber(sequenceNumber)
+{
+    // NOTHING
+}
+
+// CREATORS
+template <class VALUE>
+inline VirtualStorageDataStreamIterator<
+    VALUE>::VirtualStorageDataStreamIterator()
+: d_stream_p(0)
+, d_sequenceNumber(0)
+{
+    // NOTHING
+}
+
+template <class VALUE>
+inline VirtualStorageDataStreamIterator<VALUE>::
+    VirtualStorageDataStreamIterator(const NcIter& other)
+: d_stream_p(other.d_stream_p)
+, d_sequenceNumber(other.d_sequenceNumber)
+{
+    // NOTHING
+}
+
+// MANIPULATORS
+template <class VALUE>
+inline VirtualStorageDataStreamIterator<VALUE>&
+VirtualStorageDataStreamIterator<VALUE>::operator++()
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(d_stream_p);
+    BSLS_ASSERT_SAFE(d_sequenceNumber < d_stream_p->d_nextSequenceNumber);
+
+    d_sequenceNumber = d_stream_p->nextLive(d_sequenceNumber + 1);
+    return *this;
+}
+
+template <class VALUE>
+inline VirtualStorageDataStreamIterator<VALUE>
+VirtualStorageDataStreamIterator<VALUE>::operator++(int)
+{
+    VirtualStorageDataStreamIterator tmp(*this);
+    ++(*this);
+    return tmp;
+}
+
+// ACCESSORS
+template <class VALUE>
+inline VALUE& VirtualStorageDataStreamIterator<VALUE>::operator*() const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(d_stream_p);
+
+    return d_stream_p->slot(d_sequenceNumber);
+}
+
+template <class VALUE>
+inline VALUE* VirtualStorageDataStreamIterator<VALUE>::operator->() const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(d_stream_p);
+
+    return &d_stream_p->slot(d_sequenceNumber);
+}
+
+template <class VALUE>
+inline bsls::Types::Uint64
+VirtualStorageDataStreamIterator<VALUE>::sequenceNumber() const
+{
+    return d_sequenceNumber;
+}
+
+// ----------------------------------------
+// struct VirtualStorageDataStream::AppState
+// ----------------------------------------
+
+inline VirtualStorageDataStream::AppState::AppState()
+: d_rdaInfo()
+, d_isPending(false)
+, d_subscriptionId(bmqp::Protocol::k_DEFAULT_SUBSCRIPTION_ID)
+{
+    // NOTHING
+}
+
+// ---------------------------------------
+// class VirtualStorageDataStream::Message
+// ---------------------------------------
+
+// PRIVATE MANIPULATORS
+inline VirtualStorageDataStream::AppState&
+VirtualStorageDataStream::Message::appState(int ordinal)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(ordinal >= 0);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(ordinal == 0)) {
+        return d_firstApp;  // RETURN
+    }
+
+    const size_t index = ordinal - 1;
+    if (index >= d_otherApps.size()) {
+        d_otherApps.resize(index + 1);
+    }
+    return d_otherApps[index];
+}
+
+// CREATORS
+inline VirtualStorageDataStream::Message::Message(int               size,
+                                                  bslma::Allocator* allocator)
+: d_size(size)
+, d_numApps(0)
+, d_firstApp()
+, d_otherApps(allocator)
+{
+    // NOTHING
+}
+
+inline VirtualStorageDataStream::Message::Message(
+    const Message&    other,
+    bslma::Allocator* allocator)
+: d_size(other.d_size)
+, d_numApps(other.d_numApps)
+, d_firstApp(other.d_firstApp)
+, d_otherApps(other.d_otherApps, allocator)
+{
+    // NOTHING
+}
+
+// MANIPULATORS
+inline bool
+VirtualStorageDataStream::Message::setPending(int                  ordinal,
+                                              const bmqp::RdaInfo& rdaInfo,
+                                              unsigned int subscriptionId)
+{
+    AppState& state = appState(ordinal);
+    if (state.d_isPending) {
+        return false;  // RETURN
+    }
+
+    state.d_isPending      = true;
+    state.d_rdaInfo        = rdaInfo;
+    state.d_subscriptionId = subscriptionId;
+    ++d_numApps;
+
+    return true;
+}
+
+inline bool VirtualStorageDataStream::Message::clearPending(int ordinal)
+{
+    if (!isPending(ordinal)) {
+        return false;  // RETURN
+    }
+
+    appState(ordinal).d_isPending = false;
+    --d_numApps;
+
+    return true;
+}
+
+// ACCESSORS
+inline int VirtualStorageDataStream::Message::size() const
+{
+    return d_size;
+}
+
+inline int VirtualStorageDataStream::Message::numApps() const
+{
+    return d_numApps;
+}
+
+inline bool VirtualStorageDataStream::Message::isPending(int ordinal) const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(ordinal >= 0);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(ordinal == 0)) {
+        return d_firstApp.d_isPending;  // RETURN
+    }
+
+    const size_t index = ordinal - 1;
+    return index < d_otherApps.size() && d_otherApps[index].d_isPending;
+}
+
+inline const VirtualStorageDataStream::AppState&
+VirtualStorageDataStream::Message::app(int ordinal) const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(isPending(ordinal));
+
+    return ordinal == 0 ? d_firstApp : d_otherApps[ordinal - 1];
+}
+
+// ---------------------------------------
+// struct VirtualStorageDataStream::Segment
+// ---------------------------------------
+
+inline VirtualStorageDataStream::Segment::Segment()
+: d_liveSlots(0)
+{
+    // NOTHING
+}
+
+// ------------------------------
+// class VirtualStorageDataStream
+// ------------------------------
+
+// PRIVATE ACCESSORS
+inline VirtualStorageDataStream::Segment*
+VirtualStorageDataStream::segment(bsls::Types::Uint64 sequenceNumber) const
+{
+    if (sequenceNumber < d_firstSequenceNumber) {
+        return 0;  // RETURN
+    }
+
+    const bsls::Types::Uint64 index = (sequenceNumber -
+                                       d_firstSequenceNumber) >>
+                                      k_SEGMENT_SIZE_LOG2;
+    if (index >= d_segments.size()) {
+        return 0;  // RETURN
+    }
+
+    return d_segments[index];
+}
+
+inline bsls::Types::Uint64
+VirtualStorageDataStream::nextLive(bsls::Types::Uint64 sequenceNumber) const
+{
+    if (sequenceNumber < d_firstSequenceNumber) {
+        sequenceNumber = d_firstSequenceNumber;
+    }
+
+    while (sequenceNumber < d_nextSequenceNumber) {
+        const Segment* seg = segment(sequenceNumber);
+        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(seg)) {
+            const bsls::Types::Uint64 live = seg->d_liveSlots >>
+                                             (sequenceNumber & k_SEGMENT_MASK);
+            if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(live)) {
+                sequenceNumber += bdlb::BitUtil::numTrailingUnsetBits(live);
+                BSLS_ASSERT_SAFE(sequenceNumber < d_nextSequenceNumber);
+                return sequenceNumber;  // RETURN
+            }
+        }
+
+        // Move on to the first slot of the next segment.
+        sequenceNumber = (sequenceNumber | k_SEGMENT_MASK) + 1;
+    }
+
+    return d_nextSequenceNumber;
+}
+
+inline VirtualStorageDataStream::value_type&
+VirtualStorageDataStream::slot(bsls::Types::Uint64 sequenceNumber) const
+{
+    Segment* seg = segment(sequenceNumber);
+
+    BSLS_ASSERT_SAFE(seg);
+    BSLS_ASSERT_SAFE(seg->d_liveSlots &
+                     (1ULL << (sequenceNumber & k_SEGMENT_MASK)));
+
+    return seg->d_slots[sequenceNumber & k_SEGMENT_MASK].object();
+}
+
+// MANIPULATORS
+inline VirtualStorageDataStream::iterator VirtualStorageDataStream::begin()
+{
+    return iterator(this, nextLive(d_firstSequenceNumber));
+}
+
+inline VirtualStorageDataStream::iterator VirtualStorageDataStream::end()
+{
+    return iterator(this, d_nextSequenceNumber);
+}
+
+inline VirtualStorageDataStream::iterator
+VirtualStorageDataStream::find(const key_type& key)
+{
+    Index::const_iterator cit = d_index.find(key);
+    if (cit == d_index.end()) {
+        return end();  // RETURN
+    }
+
+    return iterator(this, cit->second);
+}
+
+// ACCESSORS
+inline VirtualStorageDataStream::const_iterator
+VirtualStorageDataStream::begin() const
+{
+    return const_iterator(this, nextLive(d_firstSequenceNumber));
+}
+
+inline VirtualStorageDataStream::const_iterator
+VirtualStorageDataStream::end() const
+{
+    return const_iterator(this, d_nextSequenceNumber);
+}
+
+inline VirtualStorageDataStream::const_iterator
+VirtualStorageDataStream::find(const key_type& key) const
+{
+    Index::const_iterator cit = d_index.find(key);
+    if (cit == d_index.end()) {
+        return end();  // RETURN
+    }
+
+    return const_iterator(this, cit->second);
+}
+
+inline VirtualStorageDataStream::const_iterator
+VirtualStorageDataStream::lowerBound(const const_iterator& position) const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(position.d_stream_p == this);
+
+    return const_iterator(this, nextLive(position.d_sequenceNumber));
+}
+
+inline bsl::size_t VirtualStorageDataStream::count(const key_type& key) const
+{
+    return d_index.count(key);
+}
+
+inline bsl::size_t VirtualStorageDataStream::size() const
+{
+    return d_index.size();
+}
+
+inline bool VirtualStorageDataStream::empty() const
+{
+    return d_index.empty();
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+template <class VALUE1, class VALUE2>
+inline bool
+mqbs::operator==(const VirtualStorageDataStreamIterator<VALUE1>& lhs,
+                 const VirtualStorageDataStreamIterator<VALUE2>& rhs)
+{
+    return lhs.d_stream_p == rhs.d_stream_p &&
+           lhs.d_sequenceNumber == rhs.d_sequenceNumber;
+}
+
+template <class VALUE1, class VALUE2>
+inline bool
+mqbs::operator!=(const VirtualStorageDataStreamIterator<VALUE1>& lhs,
+                 const VirtualStorageDataStreamIterator<VALUE2>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+}  // close enterprise namespace
+
+#endif
@@ -0,0 +1,451 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// mqbs_virtualstoragedatastream.t.cpp                                -*-C++-*-
+#include <mqbs_virtualstoragedatastream.h>
+
+// MQB
+#include <mqbu_messageguidutil.h>
+
+// BMQ
+#include <bmqt_messageguid.h>
+
+// MWC
+#include <mwcc_orderedhashmap.h>
+#include <mwcu_printutil.h>
+
+// BDE
+#include <bsl_utility.h>
+#include <bsl_vector.h>
+#include <bslma_testallocator.h>
+#include <bsls_timeutil.h>
+#include <bsls_types.h>
+
+// TEST DRIVER
+#include <mwctst_testhelper.h>
+
+// CONVENIENCE
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                            TEST HELPERS UTILITY
+// ----------------------------------------------------------------------------
+
+namespace {
+
+// TYPES
+typedef mqbs::VirtualStorageDataStream Obj;
+typedef Obj::Message                   Message;
+typedef bsl::vector<bmqt::MessageGUID> MessageGuids;
+
+// CONSTANTS
+const int k_MSG_SIZE = 42;
+
+// FUNCTIONS
+
+/// Append the specified `numGuids` new GUIDs to the specified `guids`.
+void generateGuids(MessageGuids* guids, int numGuids)
+{
+    for (int i = 0; i < numGuids; ++i) {
+        bmqt::MessageGUID guid;
+        mqbu::MessageGUIDUtil::generateGUID(&guid);
+        guids->push_back(guid);
+    }
+}
+
+/// Insert into the specified `obj` a message having the specified `guid`,
+/// pending for the app with ordinal 0, using the specified `allocator`,
+/// and return the iterator to it.
+Obj::iterator
+insertMessage(Obj* obj, const bmqt::MessageGUID& guid, bslma::Allocator* a)
+{
+    Message message(k_MSG_SIZE, a);
+    message.setPending(0,
+                       bmqp::RdaInfo(),
+                       bmqp::Protocol::k_DEFAULT_SUBSCRIPTION_ID);
+
+    bsl::pair<Obj::iterator, bool> rc = obj->insert(
+        bsl::make_pair(guid, message));
+    BSLS_ASSERT_OPT(rc.second);
+
+    return rc.first;
+}
+
+/// Return the number of messages reached when iterating the specified
+/// `obj` from the beginning.
+int numIterated(const Obj& obj)
+{
+    int count = 0;
+    for (Obj::const_iterator cit = obj.begin(); cit != obj.end(); ++cit) {
+        ++count;
+    }
+    return count;
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                                    TESTS
+// ----------------------------------------------------------------------------
+
+static void test1_breathingTest()
+// ------------------------------------------------------------------------
+// BREATHING TEST
+//
+// Concerns:
+//   Exercise the basic functionality of the component.
+//
+// Testing:
+//   Basic functionality
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("BREATHING TEST");
+
+    Obj obj(s_allocator_p);
+    ASSERT(obj.empty());
+    ASSERT_EQ(obj.size(), 0U);
+    ASSERT(obj.begin() == obj.end());
+
+    MessageGuids guids(s_allocator_p);
+    generateGuids(&guids, 3);
+
+    Obj::iterator it = insertMessage(&obj, guids[0], s_allocator_p);
+    ASSERT_EQ(it->first, guids[0]);
+    ASSERT_EQ(it->second.size(), k_MSG_SIZE);
+    ASSERT_EQ(it->second.numApps(), 1);
+    ASSERT(it->second.isPending(0));
+    ASSERT(!it->second.isPending(1));
+    ASSERT_EQ(it.sequenceNumber(), 0U);
+
+    // Duplicate
+    bsl::pair<Obj::iterator, bool> rc = obj.insert(
+        bsl::make_pair(guids[0], Message(k_MSG_SIZE, s_allocator_p)));
+    ASSERT(!rc.second);
+    ASSERT(rc.first == it);
+    ASSERT_EQ(obj.size(), 1U);
+
+    it = insertMessage(&obj, guids[1], s_allocator_p);
+    ASSERT_EQ(it.sequenceNumber(), 1U);
+    ASSERT_EQ(obj.size(), 2U);
+    ASSERT_EQ(obj.count(guids[1]), 1U);
+    ASSERT_EQ(obj.count(guids[2]), 0U);
+    ASSERT(obj.find(guids[1]) == it);
+    ASSERT(obj.find(guids[2]) == obj.end());
+
+    // Per-app state
+    ASSERT(it->second.setPending(3, bmqp::RdaInfo().setCounter(2), 7));
+    ASSERT(!it->second.setPending(3, bmqp::RdaInfo(), 8));
+    ASSERT_EQ(it->second.numApps(), 2);
+    ASSERT_EQ(it->second.app(3).d_rdaInfo.counter(), 2U);
+    ASSERT_EQ(it->second.app(3).d_subscriptionId, 7U);
+    ASSERT(it->second.clearPending(0));
+    ASSERT(!it->second.clearPending(0));
+    ASSERT_EQ(it->second.numApps(), 1);
+
+    Obj::iterator next = obj.erase(obj.begin());
+    ASSERT(next == it);
+    ASSERT_EQ(obj.size(), 1U);
+    ASSERT(obj.find(guids[0]) == obj.end());
+
+    obj.clear();
+    ASSERT(obj.empty());
+    ASSERT(obj.begin() == obj.end());
+}
+
+static void test2_sequencing()
+// ------------------------------------------------------------------------
+// SEQUENCING
+//
+// Concerns:
+//   1. Messages are iterated in arrival order, with increasing sequence
+//      numbers, across segments.
+//   2. Erasing messages in any order skips them during iteration, and
+//      returns the iterator to the following message.
+//   3. Iterators are not invalidated by insertion or erasure of other
+//      messages, an iterator to an erased message is moved to the next
+//      message by 'lowerBound', and an iterator at the end refers to the
+//      next message to be inserted.
+//   4. Sequence numbers keep increasing after 'clear'.
+//
+// Testing:
+//   insert(...)
+//   erase(...)
+//   clear()
+//   begin()
+//   end()
+//   lowerBound(...)
+//   iterator::operator++()
+//   iterator::sequenceNumber()
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("SEQUENCING");
+
+    const int k_NUM_MESSAGES = 1000;
+
+    Obj          obj(s_allocator_p);
+    MessageGuids guids(s_allocator_p);
+    generateGuids(&guids, k_NUM_MESSAGES);
+
+    PV("Arrival order");
+    for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+        insertMessage(&obj, guids[i], s_allocator_p);
+    }
+
+    int i = 0;
+    for (Obj::iterator it = obj.begin(); it != obj.end(); ++it, ++i) {
+        ASSERT_EQ(it->first, guids[i]);
+        ASSERT_EQ(it.sequenceNumber(), static_cast<bsls::Types::Uint64>(i));
+    }
+    ASSERT_EQ(i, k_NUM_MESSAGES);
+
+    PV("Erase every other message, and a whole range");
+    Obj::iterator it = obj.begin();
+    while (it != obj.end()) {
+        if (it.sequenceNumber() % 2 == 0 ||
+            (it.sequenceNumber() >= 100 && it.sequenceNumber() < 500)) {
+            it = obj.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+    ASSERT_EQ(obj.size(), static_cast<size_t>(k_NUM_MESSAGES / 2 - 200));
+    ASSERT_EQ(numIterated(obj), k_NUM_MESSAGES / 2 - 200);
+
+    for (it = obj.begin(); it != obj.end(); ++it) {
+        const bsls::Types::Uint64 sequenceNumber = it.sequenceNumber();
+        ASSERT_EQ(sequenceNumber % 2, 1U);
+        ASSERT(sequenceNumber < 100 || sequenceNumber >= 500);
+        ASSERT_EQ(it->first, guids[sequenceNumber]);
+        ASSERT(obj.find(it->first) == it);
+    }
+
+    PV("Iterator stability");
+    Obj::iterator held = obj.find(guids[501]);
+    ASSERT(held != obj.end());
+    obj.erase(obj.find(guids[499 + 4]));
+    obj.erase(obj.begin());
+    ASSERT_EQ(held->first, guids[501]);
+
+    // Advancing from an erased message is well-defined.
+    Obj::iterator erased = obj.find(guids[503 + 2]);
+    obj.erase(erased);
+    ++erased;
+    ASSERT_EQ(erased->first, guids[507]);
+
+    PV("Lower bound");
+    Obj::const_iterator parked = obj.find(guids[601]);
+    ASSERT(parked != obj.end());
+    for (int i = 601; i < 701; i += 2) {
+        obj.erase(obj.find(guids[i]));
+    }
+    ASSERT(obj.lowerBound(parked) == obj.find(guids[701]));
+    ASSERT(obj.lowerBound(obj.find(guids[701])) == obj.find(guids[701]));
+    ASSERT(obj.lowerBound(obj.end()) == obj.end());
+
+    PV("End iterator refers to the next message");
+    Obj::iterator end = obj.end();
+    bmqt::MessageGUID newGuid;
+    mqbu::MessageGUIDUtil::generateGUID(&newGuid);
+    Obj::iterator inserted = insertMessage(&obj, newGuid, s_allocator_p);
+    ASSERT(end == inserted);
+    ASSERT_EQ(inserted.sequenceNumber(),
+              static_cast<bsls::Types::Uint64>(k_NUM_MESSAGES));
+
+    PV("Clear");
+    obj.clear();
+    ASSERT(obj.empty());
+    ASSERT_EQ(numIterated(obj), 0);
+
+    inserted = insertMessage(&obj, guids[0], s_allocator_p);
+    ASSERT(inserted.sequenceNumber() >
+           static_cast<bsls::Types::Uint64>(k_NUM_MESSAGES));
+    ASSERT(obj.begin() == inserted);
+    ASSERT_EQ(numIterated(obj), 1);
+}
+
+static void test3_memoryRelease()
+// ------------------------------------------------------------------------
+// MEMORY RELEASE
+//
+// Concerns:
+//   1. Segments are released once all their messages are erased, even if
+//      an older message remains at the head of the stream.
+//   2. Once the stream is empty, a spare segment is kept and reused, so
+//      that a stream oscillating around empty does not allocate.
+//   3. Destroying the stream releases all memory.
+//
+// Testing:
+//   erase(...)
+//   ~VirtualStorageDataStream()
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("MEMORY RELEASE");
+
+    const int k_NUM_MESSAGES = 10000;
+
+    bslma::TestAllocator ta("stream");
+    MessageGuids         guids(s_allocator_p);
+    generateGuids(&guids, k_NUM_MESSAGES);
+
+    {
+        Obj obj(&ta);
+
+        for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+            insertMessage(&obj, guids[i], &ta);
+        }
+        const bsls::Types::Int64 full = ta.numBytesInUse();
+
+        // Keep the head stuck, and erase everything else.  Note that the
+        // nodes of the index are pooled, so only the segments are released.
+        for (int i = 1; i < k_NUM_MESSAGES; ++i) {
+            obj.erase(obj.find(guids[i]));
+        }
+        ASSERT_EQ(obj.size(), 1U);
+        ASSERT_EQ(obj.begin()->first, guids[0]);
+        ASSERT_LT(ta.numBytesInUse(), full);
+
+        obj.erase(obj.begin());
+        ASSERT(obj.empty());
+
+        // The spare segment is reused
+        insertMessage(&obj, guids[0], &ta);
+        obj.erase(obj.begin());
+        const bsls::Types::Int64 steady = ta.numBytesInUse();
+        const bsls::Types::Int64 numAllocations = ta.numAllocations();
+
+        insertMessage(&obj, guids[1], &ta);
+        obj.erase(obj.begin());
+        ASSERT_EQ(ta.numBytesInUse(), steady);
+        ASSERT_EQ(ta.numAllocations(), numAllocations);
+    }
+
+    ASSERT_EQ(ta.numBytesInUse(), 0);
+}
+
+// ============================================================================
+//                              PERFORMANCE TESTS
+// ----------------------------------------------------------------------------
+
+static void testN1_iterationPerformance()
+// ------------------------------------------------------------------------
+// ITERATION PERFORMANCE
+//
+// Concerns:
+//   Compare the time to find, and to iterate, messages of a
+//   'mqbs::VirtualStorageDataStream' with an 'mwcc::OrderedHashMap' keyed
+//   by GUID, which it replaced.
+//
+// Plan:
+//   - Insert the same messages in both containers, then time a lookup of
+//     every message and a full iteration, repeated a few times.
+//
+// Testing:
+//   Performance
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("ITERATION PERFORMANCE");
+
+    typedef mwcc::OrderedHashMap<bmqt::MessageGUID,
+                                 Message,
+                                 bslh::Hash<bmqt::MessageGUIDHashAlgo> >
+        GuidMap;
+
+    const int k_NUM_MESSAGES = 1000000;
+    const int k_NUM_ROUNDS   = 10;
+
+    MessageGuids guids(s_allocator_p);
+    generateGuids(&guids, k_NUM_MESSAGES);
+
+    Obj     stream(s_allocator_p);
+    GuidMap map(s_allocator_p);
+    for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+        insertMessage(&stream, guids[i], s_allocator_p);
+        map.insert(bsl::make_pair(guids[i], stream.find(guids[i])->second));
+    }
+
+    bsls::Types::Int64 sum = 0;
+
+    bsls::Types::Int64 begin = bsls::TimeUtil::getTimer();
+    for (int round = 0; round < k_NUM_ROUNDS; ++round) {
+        for (GuidMap::const_iterator cit = map.begin(); cit != map.end();
+             ++cit) {
+            sum += cit->second.size();
+        }
+    }
+    const bsls::Types::Int64 mapIteration = bsls::TimeUtil::getTimer() -
+                                            begin;
+
+    begin = bsls::TimeUtil::getTimer();
+    for (int round = 0; round < k_NUM_ROUNDS; ++round) {
+        for (Obj::const_iterator cit = stream.begin(); cit != stream.end();
+             ++cit) {
+            sum += cit->second.size();
+        }
+    }
+    const bsls::Types::Int64 streamIteration = bsls::TimeUtil::getTimer() -
+                                               begin;
+
+    begin = bsls::TimeUtil::getTimer();
+    for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+        sum += map.find(guids[i])->second.size();
+    }
+    const bsls::Types::Int64 mapFind = bsls::TimeUtil::getTimer() - begin;
+
+    begin = bsls::TimeUtil::getTimer();
+    for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+        sum += stream.find(guids[i])->second.size();
+    }
+    const bsls::Types::Int64 streamFind = bsls::TimeUtil::getTimer() - begin;
+
+    cout << "Checksum: " << sum << "\n"
+         << "Iterating " << k_NUM_ROUNDS << " x " << k_NUM_MESSAGES
+         << " messages:\n"
+         << "  OrderedHashMap : "
+         << mwcu::PrintUtil::prettyTimeInterval(mapIteration) << "\n"
+         << "  DataStream     : "
+         << mwcu::PrintUtil::prettyTimeInterval(streamIteration) << "\n"
+         << "Finding " << k_NUM_MESSAGES << " messages:\n"
+         << "  OrderedHashMap : "
+         << mwcu::PrintUtil::prettyTimeInterval(mapFind) << "\n"
+         << "  DataStream     : "
+         << mwcu::PrintUtil::prettyTimeInterval(streamFind) << "\n";
+}
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    TEST_PROLOG(mwctst::TestHelper::e_DEFAULT);
+
+    mqbu::MessageGUIDUtil::initialize();
+
+    switch (_testCase) {
+    case 0:
+    case 3: test3_memoryRelease(); break;
+    case 2: test2_sequencing(); break;
+    case 1: test1_breathingTest(); break;
+    case -1: testN1_iterationPerformance(); break;
+    default: {
+        cerr << "WARNING: CASE '" << _testCase << "' NOT FOUND." << endl;
+        s_testStatus = -1;
+    } break;
+    }
+
+    TEST_EPILOG(mwctst::TestHelper::e_CHECK_DEF_GBL_ALLOC);
+}
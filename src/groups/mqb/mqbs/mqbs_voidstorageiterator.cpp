@@ -104,5 +104,10 @@ void VoidStorageIterator::reset()
     // NOTHING
 }
 
+void VoidStorageIterator::resume()
+{
+    // NOTHING
+}
+
 }  // close package namespace
 }  // close enterprise namespace
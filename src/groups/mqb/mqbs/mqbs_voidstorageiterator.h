@@ -130,6 +130,9 @@ class VoidStorageIterator : public mqbi::StorageIterator {
     /// Reset the iterator to point to first item, if any, in the underlying
     /// storage.
     virtual void reset() BSLS_KEYWORD_OVERRIDE;
+
+    /// Do nothing.
+    virtual void resume() BSLS_KEYWORD_OVERRIDE;
 };
 
 }  // close package namespace
@@ -25,6 +25,7 @@
 #include <mwcst_statcontext.h>
 #include <mwcst_statutil.h>
 #include <mwcst_statvalue.h>
+#include <mwcst_tableschema.h>
 
 // BDE
 #include <bdld_datummapbuilder.h>
@@ -83,6 +84,32 @@ struct ClusterStatsIndex {
         ,
         e_PARTITION_JOURNAL_BYTES
         // Value: Outstanding bytes in the journal file of the partition.
+        ,
+        e_PARTITION_DATA_PAGE_FAULTS
+        // Value: Number of data file pages not resident when read.
+        ,
+        e_PARTITION_DATA_READ_AHEAD_PAGES
+        // Value: Number of data file pages read ahead.
+        ,
+        e_PARTITION_SYNC_BYTES
+        // Value: Number of bytes of file chunks received during partition
+        //        sync.
+        ,
+        e_PARTITION_WRITE_LATENCY
+        // Value: Nanoseconds between the arrival of a sampled message and
+        //        its write to the partition.
+        ,
+        e_PARTITION_REPLICATION_LATENCY
+        // Value: Nanoseconds between the write of a sampled message and its
+        //        replication.
+        ,
+        e_PARTITION_RECEIPT_LATENCY
+        // Value: Nanoseconds between the replication of a sampled message
+        //        and the receipt of its quorum of Receipts.
+        ,
+        e_PARTITION_ACK_LATENCY
+        // Value: Nanoseconds between the arrival of a sampled message and
+        //        its ACK.
     };
 };
 
@@ -112,9 +139,61 @@ struct ClusterNodeStatsIndex {
         // Value:      Accumulated bytes of all messages ever received from
         //             the client
         // Increments: Number of messages ever received from the client
+
+        ,
+        e_STAT_REPLICATION
+        // Value:      Accumulated uncompressed bytes of all the compressed
+        //             storage events ever replicated to the node
+        // Increments: Number of compressed storage events ever replicated
+        //             to the node
+
+        ,
+        e_STAT_REPLICATION_COMPRESSED
+        // Value:      Accumulated compressed bytes of all the compressed
+        //             storage events ever replicated to the node
+
+        ,
+        e_STAT_REPLICATION_COMPRESSION_TIME
+        // Value:      Accumulated time (ns) spent compressing the storage
+        //             events replicated to the node
+        // Increments: Number of storage events compressed
+
+        ,
+        e_STAT_REPLICATION_DECOMPRESSION_TIME
+        // Value:      Accumulated time (ns) spent decompressing the storage
+        //             events received from the node
+        // Increments: Number of storage events decompressed
+
+        ,
+        e_STAT_REPLICATION_RECEIPT_TIME
+        // Value:      Time (ns) between the replication of a sampled message
+        //             and the receipt of its Receipt from the node
     };
 };
 
+/// Return true if the specified `record` holds the values reported
+/// directly to its stat context.
+bool filterDirect(const mwcst::TableRecords::Record& record)
+{
+    return record.type() == mwcst::StatContext::DMCST_DIRECT_VALUE;
+}
+
+/// Return the specified `value` computed by `mwcst::StatUtil::rangeMax`,
+/// or 0 if no value was reported in the range.
+bsls::Types::Int64 maxOrZero(bsls::Types::Int64 value)
+{
+    return value == bsl::numeric_limits<bsls::Types::Int64>::min() ? 0
+                                                                   : value;
+}
+
+/// Return the specified `value` computed by one of the percentile methods
+/// of `mwcst::StatUtil`, or 0 if no value was reported in the range.
+bsls::Types::Int64 percentileOrZero(bsls::Types::Int64 value)
+{
+    return value == bsl::numeric_limits<bsls::Types::Int64>::max() ? 0
+                                                                   : value;
+}
+
 //-------------------------
 // struct ClusterStatsIndex
 //-------------------------
@@ -205,6 +284,88 @@ bsls::Types::Int64 ClusterStats::getValue(const mwcst::StatContext& context,
         return value == bsl::numeric_limits<bsls::Types::Int64>::min() ? 0
                                                                        : value;
     }
+    case Stat::e_PARTITION_DATA_PAGE_FAULTS: {
+        return STAT_RANGE(valueDifference, e_PARTITION_DATA_PAGE_FAULTS);
+    }
+    case Stat::e_PARTITION_DATA_READ_AHEAD_PAGES: {
+        return STAT_RANGE(valueDifference, e_PARTITION_DATA_READ_AHEAD_PAGES);
+    }
+    case Stat::e_PARTITION_SYNC_BYTES: {
+        return STAT_RANGE(valueDifference, e_PARTITION_SYNC_BYTES);
+    }
+    case Stat::e_PARTITION_WRITE_LATENCY_AVG: {
+        return STAT_RANGE(averagePerEvent, e_PARTITION_WRITE_LATENCY);
+    }
+    case Stat::e_PARTITION_WRITE_LATENCY_MAX: {
+        return maxOrZero(STAT_RANGE(rangeMax, e_PARTITION_WRITE_LATENCY));
+    }
+    case Stat::e_PARTITION_WRITE_LATENCY_P50: {
+        return percentileOrZero(
+            STAT_RANGE(percentile50, e_PARTITION_WRITE_LATENCY));
+    }
+    case Stat::e_PARTITION_WRITE_LATENCY_P99: {
+        return percentileOrZero(
+            STAT_RANGE(percentile99, e_PARTITION_WRITE_LATENCY));
+    }
+    case Stat::e_PARTITION_WRITE_LATENCY_P999: {
+        return percentileOrZero(
+            STAT_RANGE(percentile999, e_PARTITION_WRITE_LATENCY));
+    }
+    case Stat::e_PARTITION_REPLICATION_LATENCY_AVG: {
+        return STAT_RANGE(averagePerEvent, e_PARTITION_REPLICATION_LATENCY);
+    }
+    case Stat::e_PARTITION_REPLICATION_LATENCY_MAX: {
+        return maxOrZero(
+            STAT_RANGE(rangeMax, e_PARTITION_REPLICATION_LATENCY));
+    }
+    case Stat::e_PARTITION_REPLICATION_LATENCY_P50: {
+        return percentileOrZero(
+            STAT_RANGE(percentile50, e_PARTITION_REPLICATION_LATENCY));
+    }
+    case Stat::e_PARTITION_REPLICATION_LATENCY_P99: {
+        return percentileOrZero(
+            STAT_RANGE(percentile99, e_PARTITION_REPLICATION_LATENCY));
+    }
+    case Stat::e_PARTITION_REPLICATION_LATENCY_P999: {
+        return percentileOrZero(
+            STAT_RANGE(percentile999, e_PARTITION_REPLICATION_LATENCY));
+    }
+    case Stat::e_PARTITION_RECEIPT_LATENCY_AVG: {
+        return STAT_RANGE(averagePerEvent, e_PARTITION_RECEIPT_LATENCY);
+    }
+    case Stat::e_PARTITION_RECEIPT_LATENCY_MAX: {
+        return maxOrZero(STAT_RANGE(rangeMax, e_PARTITION_RECEIPT_LATENCY));
+    }
+    case Stat::e_PARTITION_RECEIPT_LATENCY_P50: {
+        return percentileOrZero(
+            STAT_RANGE(percentile50, e_PARTITION_RECEIPT_LATENCY));
+    }
+    case Stat::e_PARTITION_RECEIPT_LATENCY_P99: {
+        return percentileOrZero(
+            STAT_RANGE(percentile99, e_PARTITION_RECEIPT_LATENCY));
+    }
+    case Stat::e_PARTITION_RECEIPT_LATENCY_P999: {
+        return percentileOrZero(
+            STAT_RANGE(percentile999, e_PARTITION_RECEIPT_LATENCY));
+    }
+    case Stat::e_PARTITION_ACK_LATENCY_AVG: {
+        return STAT_RANGE(averagePerEvent, e_PARTITION_ACK_LATENCY);
+    }
+    case Stat::e_PARTITION_ACK_LATENCY_MAX: {
+        return maxOrZero(STAT_RANGE(rangeMax, e_PARTITION_ACK_LATENCY));
+    }
+    case Stat::e_PARTITION_ACK_LATENCY_P50: {
+        return percentileOrZero(
+            STAT_RANGE(percentile50, e_PARTITION_ACK_LATENCY));
+    }
+    case Stat::e_PARTITION_ACK_LATENCY_P99: {
+        return percentileOrZero(
+            STAT_RANGE(percentile99, e_PARTITION_ACK_LATENCY));
+    }
+    case Stat::e_PARTITION_ACK_LATENCY_P999: {
+        return percentileOrZero(
+            STAT_RANGE(percentile999, e_PARTITION_ACK_LATENCY));
+    }
 
     default: {
         BSLS_ASSERT_SAFE(false && "Attempting to access an unknown stat");
@@ -277,6 +438,31 @@ void ClusterStats::onPartitionEvent(PartitionEventType::Enum type,
     case PartitionEventType::e_PARTITION_ROLLOVER: {
         sc->reportValue(ClusterStatsIndex::e_PARTITION_ROLLOVER_TIME, value);
     } break;
+    case PartitionEventType::e_PARTITION_DATA_PAGE_FAULT: {
+        sc->adjustValue(ClusterStatsIndex::e_PARTITION_DATA_PAGE_FAULTS,
+                        value);
+    } break;
+    case PartitionEventType::e_PARTITION_DATA_READ_AHEAD: {
+        sc->adjustValue(ClusterStatsIndex::e_PARTITION_DATA_READ_AHEAD_PAGES,
+                        value);
+    } break;
+    case PartitionEventType::e_PARTITION_SYNC_CHUNK: {
+        sc->adjustValue(ClusterStatsIndex::e_PARTITION_SYNC_BYTES, value);
+    } break;
+    case PartitionEventType::e_PARTITION_WRITE_LATENCY: {
+        sc->reportValue(ClusterStatsIndex::e_PARTITION_WRITE_LATENCY, value);
+    } break;
+    case PartitionEventType::e_PARTITION_REPLICATION_LATENCY: {
+        sc->reportValue(ClusterStatsIndex::e_PARTITION_REPLICATION_LATENCY,
+                        value);
+    } break;
+    case PartitionEventType::e_PARTITION_RECEIPT_LATENCY: {
+        sc->reportValue(ClusterStatsIndex::e_PARTITION_RECEIPT_LATENCY,
+                        value);
+    } break;
+    case PartitionEventType::e_PARTITION_ACK_LATENCY: {
+        sc->reportValue(ClusterStatsIndex::e_PARTITION_ACK_LATENCY, value);
+    } break;
     default: {
         BSLS_ASSERT_SAFE(false && "Unknown event type");
     } break;
@@ -487,6 +673,75 @@ ClusterNodeStats::getValue(const mwcst::StatContext& context,
     case Stat::e_PUT_BYTES_ABS: {
         return STAT_SINGLE(value, ClusterNodeStatsIndex::e_STAT_PUT);
     }
+    case Stat::e_REPLICATION_BYTES_DELTA: {
+        return STAT_RANGE(valueDifference,
+                          ClusterNodeStatsIndex::e_STAT_REPLICATION);
+    }
+    case Stat::e_REPLICATION_COMPRESSED_BYTES_DELTA: {
+        return STAT_RANGE(
+            valueDifference,
+            ClusterNodeStatsIndex::e_STAT_REPLICATION_COMPRESSED);
+    }
+    case Stat::e_REPLICATION_COMPRESSION_RATIO: {
+        const bsls::Types::Int64 compressedBytes = STAT_RANGE(
+            valueDifference,
+            ClusterNodeStatsIndex::e_STAT_REPLICATION_COMPRESSED);
+        if (compressedBytes == 0) {
+            return 0;  // RETURN
+        }
+
+        const bsls::Types::Int64 bytes =
+            STAT_RANGE(valueDifference,
+                       ClusterNodeStatsIndex::e_STAT_REPLICATION);
+        return bytes * 100 / compressedBytes;  // RETURN
+    }
+    case Stat::e_REPLICATION_COMPRESSION_LATENCY: {
+        const int index =
+            ClusterNodeStatsIndex::e_STAT_REPLICATION_COMPRESSION_TIME;
+        const bsls::Types::Int64 numEvents = STAT_RANGE(incrementsDifference,
+                                                        index);
+        if (numEvents == 0) {
+            return 0;  // RETURN
+        }
+
+        return STAT_RANGE(valueDifference, index) / numEvents;  // RETURN
+    }
+    case Stat::e_REPLICATION_DECOMPRESSION_LATENCY: {
+        const int index =
+            ClusterNodeStatsIndex::e_STAT_REPLICATION_DECOMPRESSION_TIME;
+        const bsls::Types::Int64 numEvents = STAT_RANGE(incrementsDifference,
+                                                        index);
+        if (numEvents == 0) {
+            return 0;  // RETURN
+        }
+
+        return STAT_RANGE(valueDifference, index) / numEvents;  // RETURN
+    }
+    case Stat::e_REPLICATION_RECEIPT_LATENCY_AVG: {
+        const int index =
+            ClusterNodeStatsIndex::e_STAT_REPLICATION_RECEIPT_TIME;
+        return STAT_RANGE(averagePerEvent, index);
+    }
+    case Stat::e_REPLICATION_RECEIPT_LATENCY_MAX: {
+        const int index =
+            ClusterNodeStatsIndex::e_STAT_REPLICATION_RECEIPT_TIME;
+        return maxOrZero(STAT_RANGE(rangeMax, index));
+    }
+    case Stat::e_REPLICATION_RECEIPT_LATENCY_P50: {
+        const int index =
+            ClusterNodeStatsIndex::e_STAT_REPLICATION_RECEIPT_TIME;
+        return percentileOrZero(STAT_RANGE(percentile50, index));
+    }
+    case Stat::e_REPLICATION_RECEIPT_LATENCY_P99: {
+        const int index =
+            ClusterNodeStatsIndex::e_STAT_REPLICATION_RECEIPT_TIME;
+        return percentileOrZero(STAT_RANGE(percentile99, index));
+    }
+    case Stat::e_REPLICATION_RECEIPT_LATENCY_P999: {
+        const int index =
+            ClusterNodeStatsIndex::e_STAT_REPLICATION_RECEIPT_TIME;
+        return percentileOrZero(STAT_RANGE(percentile999, index));
+    }
     default: {
         BSLS_ASSERT_SAFE(false && "Attempting to access an unknown stat");
     }
@@ -498,6 +753,46 @@ ClusterNodeStats::getValue(const mwcst::StatContext& context,
 #undef STAT_SINGLE
 }
 
+void ClusterNodeStats::onReplicationCompressed(
+    mwcst::StatContext* context,
+    bsls::Types::Int64  bytes,
+    bsls::Types::Int64  compressedBytes,
+    bsls::Types::Int64  compressionTimeNs)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(context);
+
+    context->adjustValue(ClusterNodeStatsIndex::e_STAT_REPLICATION, bytes);
+    context->adjustValue(ClusterNodeStatsIndex::e_STAT_REPLICATION_COMPRESSED,
+                         compressedBytes);
+    context->adjustValue(
+        ClusterNodeStatsIndex::e_STAT_REPLICATION_COMPRESSION_TIME,
+        compressionTimeNs);
+}
+
+void ClusterNodeStats::onReplicationDecompressed(
+    mwcst::StatContext* context,
+    bsls::Types::Int64  decompressionTimeNs)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(context);
+
+    context->adjustValue(
+        ClusterNodeStatsIndex::e_STAT_REPLICATION_DECOMPRESSION_TIME,
+        decompressionTimeNs);
+}
+
+void ClusterNodeStats::onReplicationReceipt(mwcst::StatContext* context,
+                                            bsls::Types::Int64  latencyNs)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(context);
+
+    context->reportValue(
+        ClusterNodeStatsIndex::e_STAT_REPLICATION_RECEIPT_TIME,
+        latencyNs);
+}
+
 ClusterNodeStats::ClusterNodeStats()
 : d_statContext_mp(0)
 {
@@ -569,7 +864,15 @@ ClusterStatsUtil::initializeStatContextCluster(int               historySize,
         .value("partition_status")
         .value("partition.rollover_time", mwcst::StatValue::DMCST_DISCRETE)
         .value("partition.data_bytes", mwcst::StatValue::DMCST_DISCRETE)
-        .value("partition.journal_bytes", mwcst::StatValue::DMCST_DISCRETE);
+        .value("partition.journal_bytes", mwcst::StatValue::DMCST_DISCRETE)
+        .value("partition.data_page_faults")
+        .value("partition.data_read_ahead_pages")
+        .value("partition.sync_bytes")
+        .value("partition.write_latency", mwcst::StatValue::DMCST_HISTOGRAM)
+        .value("partition.replication_latency",
+               mwcst::StatValue::DMCST_HISTOGRAM)
+        .value("partition.receipt_latency", mwcst::StatValue::DMCST_HISTOGRAM)
+        .value("partition.ack_latency", mwcst::StatValue::DMCST_HISTOGRAM);
 
     // NOTE: For the clusters, the stat context will have two levels of
     //       children, first level is per cluster, and second level is per
@@ -600,7 +903,13 @@ ClusterStatsUtil::initializeStatContextClusterNodes(
         .value("ack")
         .value("confirm")
         .value("push")
-        .value("put");
+        .value("put")
+        .value("replication")
+        .value("replication_compressed")
+        .value("replication_compression_time")
+        .value("replication_decompression_time")
+        .value("replication_receipt_time",
+               mwcst::StatValue::DMCST_HISTOGRAM);
     // NOTE: If the stats are using too much memory, we could reconsider
     //       in_event and out_event to be using atomic int and not stat value.
 
@@ -609,5 +918,191 @@ ClusterStatsUtil::initializeStatContextClusterNodes(
         allocator);
 }
 
+void ClusterStatsUtil::initializeTableAndTipPartitions(
+    mwcst::Table*                 table,
+    mwcu::BasicTableInfoProvider* tip,
+    int                           historySize,
+    mwcst::StatContext*           statContext)
+{
+    mwcst::StatValue::SnapshotLocation start(0, 0);
+    mwcst::StatValue::SnapshotLocation end(0, historySize - 1);
+
+    const struct {
+        const char* d_column;
+        const char* d_group;
+        int         d_index;
+    } k_STAGES[] = {
+        {"write", "Write", ClusterStatsIndex::e_PARTITION_WRITE_LATENCY},
+        {"replication",
+         "Replication",
+         ClusterStatsIndex::e_PARTITION_REPLICATION_LATENCY},
+        {"receipt", "Receipt", ClusterStatsIndex::e_PARTITION_RECEIPT_LATENCY},
+        {"ack", "Ack", ClusterStatsIndex::e_PARTITION_ACK_LATENCY}};
+    const size_t k_NUM_STAGES = sizeof(k_STAGES) / sizeof(*k_STAGES);
+
+    // Create table
+    mwcst::TableSchema& schema = table->schema();
+
+    schema.addDefaultIdColumn("id");
+
+    for (size_t i = 0; i < k_NUM_STAGES; ++i) {
+        const bsl::string column(k_STAGES[i].d_column);
+        const int         index = k_STAGES[i].d_index;
+
+        schema.addColumn(column + "_avg",
+                         index,
+                         mwcst::StatUtil::averagePerEvent,
+                         start,
+                         end);
+        schema.addColumn(column + "_max",
+                         index,
+                         mwcst::StatUtil::rangeMax,
+                         start,
+                         end);
+        schema.addColumn(column + "_p50",
+                         index,
+                         mwcst::StatUtil::percentile50,
+                         start,
+                         end);
+        schema.addColumn(column + "_p99",
+                         index,
+                         mwcst::StatUtil::percentile99,
+                         start,
+                         end);
+        schema.addColumn(column + "_p999",
+                         index,
+                         mwcst::StatUtil::percentile999,
+                         start,
+                         end);
+    }
+
+    // Configure records
+    mwcst::TableRecords& records = table->records();
+    records.setContext(statContext);
+    records.setFilter(&filterDirect);
+
+    // Create the tip
+    tip->setTable(table);
+    tip->setColumnGroup("");
+    tip->addColumn("id", "").justifyLeft();
+
+    for (size_t i = 0; i < k_NUM_STAGES; ++i) {
+        const bsl::string column(k_STAGES[i].d_column);
+
+        tip->setColumnGroup(k_STAGES[i].d_group);
+        tip->addColumn(column + "_avg", "avg")
+            .zeroString("")
+            .extremeValueString("")
+            .printAsNsTimeInterval();
+        tip->addColumn(column + "_max", "max")
+            .zeroString("")
+            .extremeValueString("")
+            .printAsNsTimeInterval();
+        tip->addColumn(column + "_p50", "p50")
+            .zeroString("")
+            .extremeValueString("")
+            .printAsNsTimeInterval();
+        tip->addColumn(column + "_p99", "p99")
+            .zeroString("")
+            .extremeValueString("")
+            .printAsNsTimeInterval();
+        tip->addColumn(column + "_p999", "p99.9")
+            .zeroString("")
+            .extremeValueString("")
+            .printAsNsTimeInterval();
+    }
+}
+
+void ClusterStatsUtil::initializeTableAndTipReplication(
+    mwcst::Table*                 table,
+    mwcu::BasicTableInfoProvider* tip,
+    int                           historySize,
+    mwcst::StatContext*           statContext)
+{
+    mwcst::StatValue::SnapshotLocation start(0, 0);
+    mwcst::StatValue::SnapshotLocation end(0, historySize - 1);
+
+    // Create table
+    mwcst::TableSchema& schema = table->schema();
+
+    schema.addDefaultIdColumn("id");
+
+    schema.addColumn("receipt_avg",
+                     ClusterNodeStatsIndex::e_STAT_REPLICATION_RECEIPT_TIME,
+                     mwcst::StatUtil::averagePerEvent,
+                     start,
+                     end);
+    schema.addColumn("receipt_max",
+                     ClusterNodeStatsIndex::e_STAT_REPLICATION_RECEIPT_TIME,
+                     mwcst::StatUtil::rangeMax,
+                     start,
+                     end);
+    schema.addColumn("receipt_p50",
+                     ClusterNodeStatsIndex::e_STAT_REPLICATION_RECEIPT_TIME,
+                     mwcst::StatUtil::percentile50,
+                     start,
+                     end);
+    schema.addColumn("receipt_p99",
+                     ClusterNodeStatsIndex::e_STAT_REPLICATION_RECEIPT_TIME,
+                     mwcst::StatUtil::percentile99,
+                     start,
+                     end);
+    schema.addColumn("receipt_p999",
+                     ClusterNodeStatsIndex::e_STAT_REPLICATION_RECEIPT_TIME,
+                     mwcst::StatUtil::percentile999,
+                     start,
+                     end);
+    schema.addColumn("compressed_bytes_delta",
+                     ClusterNodeStatsIndex::e_STAT_REPLICATION_COMPRESSED,
+                     mwcst::StatUtil::valueDifference,
+                     start,
+                     end);
+    schema.addColumn("uncompressed_bytes_delta",
+                     ClusterNodeStatsIndex::e_STAT_REPLICATION,
+                     mwcst::StatUtil::valueDifference,
+                     start,
+                     end);
+
+    // Configure records
+    mwcst::TableRecords& records = table->records();
+    records.setContext(statContext);
+    records.setFilter(&filterDirect);
+
+    // Create the tip
+    tip->setTable(table);
+    tip->setColumnGroup("");
+    tip->addColumn("id", "").justifyLeft();
+
+    tip->setColumnGroup("Receipt");
+    tip->addColumn("receipt_avg", "avg")
+        .zeroString("")
+        .extremeValueString("")
+        .printAsNsTimeInterval();
+    tip->addColumn("receipt_max", "max")
+        .zeroString("")
+        .extremeValueString("")
+        .printAsNsTimeInterval();
+    tip->addColumn("receipt_p50", "p50")
+        .zeroString("")
+        .extremeValueString("")
+        .printAsNsTimeInterval();
+    tip->addColumn("receipt_p99", "p99")
+        .zeroString("")
+        .extremeValueString("")
+        .printAsNsTimeInterval();
+    tip->addColumn("receipt_p999", "p99.9")
+        .zeroString("")
+        .extremeValueString("")
+        .printAsNsTimeInterval();
+
+    tip->setColumnGroup("Compression");
+    tip->addColumn("uncompressed_bytes_delta", "bytes (d)")
+        .zeroString("")
+        .printAsMemory();
+    tip->addColumn("compressed_bytes_delta", "compressed (d)")
+        .zeroString("")
+        .printAsMemory();
+}
+
 }  // close package namespace
 }  // close enterprise namespace
@@ -34,6 +34,10 @@
 
 // MQB
 
+// MWC
+#include <mwcst_basictableinfoprovider.h>
+#include <mwcst_table.h>
+
 // BDE
 #include <bsl_memory.h>
 #include <bsl_string.h>
@@ -70,6 +74,35 @@ class ClusterStats {
         enum Enum {
             e_PARTITION_ROLLOVER
             // Time in nanoseconds it took for the rollover operation.
+            ,
+            e_PARTITION_DATA_PAGE_FAULT
+            // Number of pages of the data file which were not resident in
+            // memory when reading messages from it.
+            ,
+            e_PARTITION_DATA_READ_AHEAD
+            // Number of pages of the data file for which a read-ahead was
+            // issued.
+            ,
+            e_PARTITION_SYNC_CHUNK
+            // Number of bytes of a file chunk received from a peer during
+            // partition sync.
+            ,
+            e_PARTITION_WRITE_LATENCY
+            // Time in nanoseconds between the arrival of a sampled message
+            // requiring strong consistency at the primary and its write to
+            // the partition.
+            ,
+            e_PARTITION_REPLICATION_LATENCY
+            // Time in nanoseconds between the write of a sampled message to
+            // the partition and its replication to the peers.
+            ,
+            e_PARTITION_RECEIPT_LATENCY
+            // Time in nanoseconds between the replication of a sampled
+            // message and the receipt of its Receipts from a quorum.
+            ,
+            e_PARTITION_ACK_LATENCY
+            // Time in nanoseconds between the arrival of a sampled message
+            // requiring strong consistency at the primary and its ACK.
         };
     };
 
@@ -109,6 +142,45 @@ class ClusterStats {
             e_PARTITION_JOURNAL_CONTENT
             // Maximum observed outstanding bytes in the journal file of the
             // partition.
+            ,
+            e_PARTITION_DATA_PAGE_FAULTS
+            // Number of pages of the data file which were not resident in
+            // memory when reading messages from it during the report
+            // interval, each of which causing a major page fault.
+            ,
+            e_PARTITION_DATA_READ_AHEAD_PAGES
+            // Number of pages of the data file for which a read-ahead was
+            // issued during the report interval.
+            ,
+            e_PARTITION_SYNC_BYTES
+            // Number of bytes of the partition files received from a peer
+            // during partition sync in the report interval, i.e. the
+            // throughput of the sync.
+            ,
+            e_PARTITION_WRITE_LATENCY_AVG,
+            e_PARTITION_WRITE_LATENCY_MAX,
+            e_PARTITION_WRITE_LATENCY_P50,
+            e_PARTITION_WRITE_LATENCY_P99,
+            e_PARTITION_WRITE_LATENCY_P999,
+            e_PARTITION_REPLICATION_LATENCY_AVG,
+            e_PARTITION_REPLICATION_LATENCY_MAX,
+            e_PARTITION_REPLICATION_LATENCY_P50,
+            e_PARTITION_REPLICATION_LATENCY_P99,
+            e_PARTITION_REPLICATION_LATENCY_P999,
+            e_PARTITION_RECEIPT_LATENCY_AVG,
+            e_PARTITION_RECEIPT_LATENCY_MAX,
+            e_PARTITION_RECEIPT_LATENCY_P50,
+            e_PARTITION_RECEIPT_LATENCY_P99,
+            e_PARTITION_RECEIPT_LATENCY_P999,
+            e_PARTITION_ACK_LATENCY_AVG,
+            e_PARTITION_ACK_LATENCY_MAX,
+            e_PARTITION_ACK_LATENCY_P50,
+            e_PARTITION_ACK_LATENCY_P99,
+            e_PARTITION_ACK_LATENCY_P999
+            // Average, maximum, median, 99th and 99.9th percentile time in
+            // nanoseconds of the corresponding stage of the strong
+            // consistency ACK of the sampled messages during the report
+            // interval (see 'PartitionEventType').
         };
     };
 
@@ -294,7 +366,17 @@ class ClusterNodeStats {
             e_ACK_DELTA,
             e_ACK_ABS,
             e_CONFIRM_DELTA,
-            e_CONFIRM_ABS
+            e_CONFIRM_ABS,
+            e_REPLICATION_BYTES_DELTA,
+            e_REPLICATION_COMPRESSED_BYTES_DELTA,
+            e_REPLICATION_COMPRESSION_RATIO,
+            e_REPLICATION_COMPRESSION_LATENCY,
+            e_REPLICATION_DECOMPRESSION_LATENCY,
+            e_REPLICATION_RECEIPT_LATENCY_AVG,
+            e_REPLICATION_RECEIPT_LATENCY_MAX,
+            e_REPLICATION_RECEIPT_LATENCY_P50,
+            e_REPLICATION_RECEIPT_LATENCY_P99,
+            e_REPLICATION_RECEIPT_LATENCY_P999
         };
     };
 
@@ -324,6 +406,36 @@ class ClusterNodeStats {
                                        int                       snapshotId,
                                        const Stat::Enum&         stat);
 
+    /// Report to the specified `context` of a cluster node that a storage
+    /// event of the specified `bytes` was compressed, in the specified
+    /// `compressionTimeNs`, to the specified `compressedBytes` before being
+    /// replicated to that node.  Note that `getValue` reports the
+    /// compression ratio as a percentage (`bytes * 100 / compressedBytes`)
+    /// and the latencies as the average nanoseconds per event.
+    ///
+    /// THREAD: This method is thread-safe.
+    static void onReplicationCompressed(mwcst::StatContext* context,
+                                        bsls::Types::Int64  bytes,
+                                        bsls::Types::Int64  compressedBytes,
+                                        bsls::Types::Int64  compressionTimeNs);
+
+    /// Report to the specified `context` of a cluster node that a
+    /// compressed storage event received from that node was decompressed in
+    /// the specified `decompressionTimeNs`.
+    ///
+    /// THREAD: This method is thread-safe.
+    static void
+    onReplicationDecompressed(mwcst::StatContext* context,
+                              bsls::Types::Int64  decompressionTimeNs);
+
+    /// Report to the specified `context` of a cluster node that the Receipt
+    /// of a sampled message was received from that node the specified
+    /// `latencyNs` after the message was replicated.
+    ///
+    /// THREAD: This method is thread-safe.
+    static void onReplicationReceipt(mwcst::StatContext* context,
+                                     bsls::Types::Int64  latencyNs);
+
     // CREATORS
 
     /// Create a new object in an uninitialized state.
@@ -369,6 +481,24 @@ struct ClusterStatsUtil {
     static bsl::shared_ptr<mwcst::StatContext>
     initializeStatContextClusterNodes(int               historySize,
                                       bslma::Allocator* allocator);
+
+    /// Load in the specified `table` and `tip` the objects to print the
+    /// strong consistency ACK latency breakdown of the partitions of the
+    /// specified cluster `statContext` for the specified `historySize`.
+    static void
+    initializeTableAndTipPartitions(mwcst::Table*                 table,
+                                    mwcu::BasicTableInfoProvider* tip,
+                                    int                           historySize,
+                                    mwcst::StatContext*           statContext);
+
+    /// Load in the specified `table` and `tip` the objects to print the
+    /// replication statistics of the specified cluster nodes `statContext`
+    /// for the specified `historySize`.
+    static void
+    initializeTableAndTipReplication(mwcst::Table*                 table,
+                                     mwcu::BasicTableInfoProvider* tip,
+                                     int                 historySize,
+                                     mwcst::StatContext* statContext);
 };
 
 // ============================================================================
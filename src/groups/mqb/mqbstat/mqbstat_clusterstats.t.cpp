@@ -0,0 +1,326 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// mqbstat_clusterstats.t.cpp                                         -*-C++-*-
+#include <mqbstat_clusterstats.h>
+
+// BMQ
+#include <bmqt_uri.h>
+
+// MWC
+#include <mwcst_histogram.h>
+#include <mwcst_statcontext.h>
+
+// BDE
+#include <bsl_memory.h>
+#include <bsls_types.h>
+
+// TEST DRIVER
+#include <mwctst_testhelper.h>
+
+// CONVENIENCE
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                            TEST HELPERS UTILITY
+// ----------------------------------------------------------------------------
+namespace {
+
+/// Number of latencies reported by the test cases: the latencies are 1 to
+/// `k_NUM_LATENCIES` microseconds.
+const int k_NUM_LATENCIES = 100;
+
+/// Return the largest difference between a percentile computed from the
+/// histogram of a stat value and the specified exact `value`, which is the
+/// width of the histogram bucket counting `value`.
+bsls::Types::Int64 tolerance(bsls::Types::Int64 value)
+{
+    return value / mwcst::Histogram::k_NUM_SUB_BUCKETS;
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                                    TESTS
+// ----------------------------------------------------------------------------
+
+static void test1_breathingTest()
+// ------------------------------------------------------------------------
+// BREATHING TEST
+//
+// Concerns:
+//   - The latencies of a partition and of a cluster node are 0 when
+//     nothing was reported.
+//
+// Testing:
+//   Stat Context initialization
+// ------------------------------------------------------------------------
+{
+    s_ignoreCheckDefAlloc = true;
+    // Computing a percentile uses the default allocator.
+
+    mwctst::TestHelper::printTestName("BREATHING TEST");
+
+    const int k_HISTORY_SIZE = 2;
+
+    bsl::shared_ptr<mwcst::StatContext> clusters =
+        mqbstat::ClusterStatsUtil::initializeStatContextCluster(
+            k_HISTORY_SIZE,
+            s_allocator_p);
+    bsl::shared_ptr<mwcst::StatContext> clusterNodes =
+        mqbstat::ClusterStatsUtil::initializeStatContextClusterNodes(
+            k_HISTORY_SIZE,
+            s_allocator_p);
+
+    mqbstat::ClusterStats clusterStats(s_allocator_p);
+    clusterStats.initialize("testCluster",
+                            1,  // partitionsCount
+                            clusters.get(),
+                            s_allocator_p);
+
+    mqbstat::ClusterNodeStats clusterNodeStats;
+    clusterNodeStats.initialize(bmqt::Uri("bmq://test/node", s_allocator_p),
+                                clusterNodes.get(),
+                                s_allocator_p);
+
+    clusters->snapshot();
+    clusterNodes->snapshot();
+
+    const mwcst::StatContext* partition =
+        clusterStats.statContext()->getSubcontext("partition0");
+    ASSERT(partition);
+
+    typedef mqbstat::ClusterStats::Stat     PartitionStat;
+    typedef mqbstat::ClusterNodeStats::Stat NodeStat;
+
+#define ASSERT_EQ_TO_0_PARTITIONSTAT(PARAM)                                   \
+    ASSERT_EQ(0,                                                              \
+              mqbstat::ClusterStats::getValue(*partition,                     \
+                                              1,                              \
+                                              PartitionStat::PARAM));
+
+#define ASSERT_EQ_TO_0_NODESTAT(PARAM)                                        \
+    ASSERT_EQ(0,                                                              \
+              mqbstat::ClusterNodeStats::getValue(                            \
+                  *clusterNodeStats.statContext(),                            \
+                  1,                                                          \
+                  NodeStat::PARAM));
+
+    ASSERT_EQ_TO_0_PARTITIONSTAT(e_PARTITION_WRITE_LATENCY_AVG);
+    ASSERT_EQ_TO_0_PARTITIONSTAT(e_PARTITION_WRITE_LATENCY_MAX);
+    ASSERT_EQ_TO_0_PARTITIONSTAT(e_PARTITION_WRITE_LATENCY_P50);
+    ASSERT_EQ_TO_0_PARTITIONSTAT(e_PARTITION_WRITE_LATENCY_P99);
+    ASSERT_EQ_TO_0_PARTITIONSTAT(e_PARTITION_WRITE_LATENCY_P999);
+    ASSERT_EQ_TO_0_PARTITIONSTAT(e_PARTITION_REPLICATION_LATENCY_P50);
+    ASSERT_EQ_TO_0_PARTITIONSTAT(e_PARTITION_RECEIPT_LATENCY_P50);
+    ASSERT_EQ_TO_0_PARTITIONSTAT(e_PARTITION_ACK_LATENCY_P999);
+
+    ASSERT_EQ_TO_0_NODESTAT(e_REPLICATION_RECEIPT_LATENCY_AVG);
+    ASSERT_EQ_TO_0_NODESTAT(e_REPLICATION_RECEIPT_LATENCY_MAX);
+    ASSERT_EQ_TO_0_NODESTAT(e_REPLICATION_RECEIPT_LATENCY_P50);
+    ASSERT_EQ_TO_0_NODESTAT(e_REPLICATION_RECEIPT_LATENCY_P99);
+    ASSERT_EQ_TO_0_NODESTAT(e_REPLICATION_RECEIPT_LATENCY_P999);
+
+#undef ASSERT_EQ_TO_0_PARTITIONSTAT
+#undef ASSERT_EQ_TO_0_NODESTAT
+}
+
+static void test2_partitionLatencies()
+// ------------------------------------------------------------------------
+// PARTITION LATENCIES
+//
+// Concerns:
+//   - Each stage of the strong consistency ACK of a partition reports the
+//     average, maximum and percentiles of its latencies.
+//   - The percentiles only cover the latencies reported between the two
+//     snapshots.
+//
+// Testing:
+//   onPartitionEvent
+//   getValue
+// ------------------------------------------------------------------------
+{
+    s_ignoreCheckDefAlloc = true;
+    // Computing a percentile uses the default allocator.
+
+    mwctst::TestHelper::printTestName("PARTITION LATENCIES");
+
+    bsl::shared_ptr<mwcst::StatContext> clusters =
+        mqbstat::ClusterStatsUtil::initializeStatContextCluster(
+            3,  // historySize
+            s_allocator_p);
+
+    mqbstat::ClusterStats clusterStats(s_allocator_p);
+    clusterStats.initialize("testCluster",
+                            2,  // partitionsCount
+                            clusters.get(),
+                            s_allocator_p);
+
+    typedef mqbstat::ClusterStats::PartitionEventType EventType;
+    typedef mqbstat::ClusterStats::Stat               PartitionStat;
+
+    // *SNAPSHOT 1*
+    // Partition 1: 1 to 100us of write latency, and twice as much of ACK
+    // latency.
+    for (int i = 1; i <= k_NUM_LATENCIES; ++i) {
+        clusterStats.onPartitionEvent(EventType::e_PARTITION_WRITE_LATENCY,
+                                      1,
+                                      i * 1000);
+        clusterStats.onPartitionEvent(EventType::e_PARTITION_ACK_LATENCY,
+                                      1,
+                                      i * 2000);
+    }
+    clusters->snapshot();
+
+    // *SNAPSHOT 2*
+    // Partition 1: a single 1ms write latency.
+    clusterStats.onPartitionEvent(EventType::e_PARTITION_WRITE_LATENCY,
+                                  1,
+                                  1000 * 1000);
+    clusters->snapshot();
+
+    const mwcst::StatContext* partition0 =
+        clusterStats.statContext()->getSubcontext("partition0");
+    const mwcst::StatContext* partition1 =
+        clusterStats.statContext()->getSubcontext("partition1");
+    ASSERT(partition0);
+    ASSERT(partition1);
+
+#define GET_VALUE(CONTEXT, SNAPSHOT, PARAM)                                   \
+    mqbstat::ClusterStats::getValue(*CONTEXT, SNAPSHOT, PartitionStat::PARAM)
+
+    PV("Latest interval");
+    ASSERT_EQ(1000 * 1000,
+              GET_VALUE(partition1, 1, e_PARTITION_WRITE_LATENCY_AVG));
+    ASSERT_EQ(1000 * 1000,
+              GET_VALUE(partition1, 1, e_PARTITION_WRITE_LATENCY_MAX));
+    ASSERT_EQ(1000 * 1000,
+              GET_VALUE(partition1, 1, e_PARTITION_WRITE_LATENCY_P50));
+    ASSERT_EQ(0, GET_VALUE(partition1, 1, e_PARTITION_ACK_LATENCY_P50));
+
+    PV("Both intervals");
+    // The 101 write latencies are 1 to 100us and 1ms.
+    const bsls::Types::Int64 writeP50 =
+        GET_VALUE(partition1, 2, e_PARTITION_WRITE_LATENCY_P50);
+    const bsls::Types::Int64 writeP99 =
+        GET_VALUE(partition1, 2, e_PARTITION_WRITE_LATENCY_P99);
+
+    ASSERT_LE(51 * 1000, writeP50);
+    ASSERT_GE(51 * 1000 + tolerance(51 * 1000), writeP50);
+    ASSERT_LE(100 * 1000, writeP99);
+    ASSERT_GE(100 * 1000 + tolerance(100 * 1000), writeP99);
+    ASSERT_EQ(1000 * 1000,
+              GET_VALUE(partition1, 2, e_PARTITION_WRITE_LATENCY_P999));
+    ASSERT_EQ(1000 * 1000,
+              GET_VALUE(partition1, 2, e_PARTITION_WRITE_LATENCY_MAX));
+
+    // The 100 ACK latencies are 2 to 200us.
+    const bsls::Types::Int64 ackP50 =
+        GET_VALUE(partition1, 2, e_PARTITION_ACK_LATENCY_P50);
+
+    ASSERT_LE(100 * 1000, ackP50);
+    ASSERT_GE(100 * 1000 + tolerance(100 * 1000), ackP50);
+    ASSERT_EQ(200 * 1000,
+              GET_VALUE(partition1, 2, e_PARTITION_ACK_LATENCY_P999));
+    ASSERT_EQ(101 * 1000,
+              GET_VALUE(partition1, 2, e_PARTITION_ACK_LATENCY_AVG));
+
+    PV("Other partition");
+    ASSERT_EQ(0, GET_VALUE(partition0, 2, e_PARTITION_WRITE_LATENCY_P50));
+    ASSERT_EQ(0, GET_VALUE(partition0, 2, e_PARTITION_WRITE_LATENCY_MAX));
+
+#undef GET_VALUE
+}
+
+static void test3_clusterNodeReceiptLatencies()
+// ------------------------------------------------------------------------
+// CLUSTER NODE RECEIPT LATENCIES
+//
+// Concerns:
+//   - The Receipt latencies of a cluster node report their average,
+//     maximum and percentiles.
+//
+// Testing:
+//   onReplicationReceipt
+//   getValue
+// ------------------------------------------------------------------------
+{
+    s_ignoreCheckDefAlloc = true;
+    // Computing a percentile uses the default allocator.
+
+    mwctst::TestHelper::printTestName("CLUSTER NODE RECEIPT LATENCIES");
+
+    bsl::shared_ptr<mwcst::StatContext> clusterNodes =
+        mqbstat::ClusterStatsUtil::initializeStatContextClusterNodes(
+            2,  // historySize
+            s_allocator_p);
+
+    mqbstat::ClusterNodeStats clusterNodeStats;
+    clusterNodeStats.initialize(bmqt::Uri("bmq://test/node", s_allocator_p),
+                                clusterNodes.get(),
+                                s_allocator_p);
+
+    for (int i = 1; i <= k_NUM_LATENCIES; ++i) {
+        mqbstat::ClusterNodeStats::onReplicationReceipt(
+            clusterNodeStats.statContext(),
+            i * 1000);
+    }
+    clusterNodes->snapshot();
+
+    typedef mqbstat::ClusterNodeStats::Stat NodeStat;
+
+#define GET_VALUE(PARAM)                                                      \
+    mqbstat::ClusterNodeStats::getValue(*clusterNodeStats.statContext(),      \
+                                        1,                                    \
+                                        NodeStat::PARAM)
+
+    const bsls::Types::Int64 p50 =
+        GET_VALUE(e_REPLICATION_RECEIPT_LATENCY_P50);
+    const bsls::Types::Int64 p99 =
+        GET_VALUE(e_REPLICATION_RECEIPT_LATENCY_P99);
+
+    ASSERT_LE(50 * 1000, p50);
+    ASSERT_GE(50 * 1000 + tolerance(50 * 1000), p50);
+    ASSERT_LE(99 * 1000, p99);
+    ASSERT_GE(100 * 1000, p99);
+    ASSERT_EQ(100 * 1000, GET_VALUE(e_REPLICATION_RECEIPT_LATENCY_P999));
+    ASSERT_EQ(100 * 1000, GET_VALUE(e_REPLICATION_RECEIPT_LATENCY_MAX));
+    ASSERT_EQ(50500, GET_VALUE(e_REPLICATION_RECEIPT_LATENCY_AVG));
+
+#undef GET_VALUE
+}
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    TEST_PROLOG(mwctst::TestHelper::e_DEFAULT);
+
+    switch (_testCase) {
+    case 0:
+    case 3: test3_clusterNodeReceiptLatencies(); break;
+    case 2: test2_partitionLatencies(); break;
+    case 1: test1_breathingTest(); break;
+    default: {
+        cerr << "WARNING: CASE '" << _testCase << "' NOT FOUND." << endl;
+        s_testStatus = -1;
+    } break;
+    }
+
+    TEST_EPILOG(mwctst::TestHelper::e_CHECK_DEF_GBL_ALLOC);
+}
@@ -19,8 +19,12 @@
 #include <mqbscm_version.h>
 // MQB
 #include <mqbscm_versiontag.h>
+#include <mqbstat_clusterstats.h>
 #include <mqbstat_queuestats.h>
 
+// BMQ
+#include <bmqp_messagetrace.h>
+
 // MWC
 #include <mwcio_statchannelfactory.h>
 #include <mwcma_countingallocator.h>
@@ -44,6 +48,7 @@
 #include <bsl_algorithm.h>
 #include <bsl_ctime.h>
 #include <bsl_iostream.h>
+#include <bsl_vector.h>
 #include <bslma_allocator.h>
 #include <bslmt_threadutil.h>
 #include <bsls_assert.h>
@@ -103,6 +108,20 @@ void Printer::initializeTablesAndTips()
                                                  historySize,
                                                  context->d_statContext_p);
 
+    context = d_contexts["partitions"].get();
+    ClusterStatsUtil::initializeTableAndTipPartitions(
+        &context->d_table,
+        &context->d_tip,
+        historySize,
+        context->d_statContext_p);
+
+    context = d_contexts["replication"].get();
+    ClusterStatsUtil::initializeTableAndTipReplication(
+        &context->d_table,
+        &context->d_tip,
+        historySize,
+        context->d_statContext_p);
+
     context = d_contexts["channels"].get();
     mwcst::StatValue::SnapshotLocation start(0, 0);
     mwcst::StatValue::SnapshotLocation end(0, historySize - 1);
@@ -125,6 +144,8 @@ Printer::Printer(const mqbcfg::StatsConfig& config,
 , d_lastAllocatorSnapshot(0)
 , d_contexts(allocator)
 , d_statLogCleaner(eventScheduler, allocator)
+, d_messageTraceCollector(allocator)
+, d_allocator_p(allocator)
 {
     // PRECONDITIONS
     BSLS_ASSERT_SAFE(eventScheduler->clockType() ==
@@ -143,6 +164,23 @@ Printer::Printer(const mqbcfg::StatsConfig& config,
         // Table and Tip are left default constructed, and will be set
         // during 'start'.
     }
+
+    // The partitions and replication tables print other columns of the
+    // clusters and cluster nodes stat contexts.
+    const char* k_ALIASES[][2] = {{"partitions", "clusters"},
+                                  {"replication", "clusterNodes"}};
+    for (size_t i = 0; i < sizeof(k_ALIASES) / sizeof(*k_ALIASES); ++i) {
+        StatContextsMap::const_iterator it = statContextsMap.find(
+            k_ALIASES[i][1]);
+        if (it == statContextsMap.end()) {
+            continue;  // CONTINUE
+        }
+
+        bsl::shared_ptr<Context> contextSp;
+        contextSp.createInplace(allocator);
+        contextSp->d_statContext_p = it->second;
+        d_contexts.insert(bsl::make_pair(k_ALIASES[i][0], contextSp));
+    }
 }
 
 int Printer::start(BSLS_ANNOTATION_UNUSED bsl::ostream& errorDescription)
@@ -237,6 +275,20 @@ void Printer::printStats(bsl::ostream& stream)
     context->d_table.records().update();
     mwcu::TableUtil::printTable(stream, context->d_tip);
 
+    // PARTITIONS
+    stream << "\n"
+           << ":::::::::: :::::::::: PARTITIONS (STRONG CONSISTENCY) >>";
+    context = d_contexts["partitions"].get();
+    context->d_table.records().update();
+    mwcu::TableUtil::printTable(stream, context->d_tip);
+
+    // REPLICATION
+    stream << "\n"
+           << ":::::::::: :::::::::: REPLICATION >>";
+    context = d_contexts["replication"].get();
+    context->d_table.records().update();
+    mwcu::TableUtil::printTable(stream, context->d_tip);
+
     // CHANNELS
     stream << "\n"
            << ":::::::::: :::::::::: TCP CHANNELS >>";
@@ -299,6 +351,14 @@ void Printer::logStats()
 
     printStats(os);
 
+    // MESSAGE TRACES
+    if (bmqp::MessageTraceUtil::samplingPeriod() != 0) {
+        os << "\n"
+           << ":::::::::: :::::::::: MESSAGE TRACES >>";
+        d_messageTraceCollector.collect();
+        d_messageTraceCollector.printLatencies(os);
+    }
+
     d_statsLogFile.publish(
         record,
         ball::Context(ball::Transmission::e_MANUAL_PUBLISH, 0, 1));
@@ -306,6 +366,12 @@ void Printer::logStats()
 
 void Printer::onSnapshot()
 {
+    // Drain the message traces at every snapshot rather than at every print,
+    // so that they get exported before being overwritten in the buffer.
+    if (bmqp::MessageTraceUtil::samplingPeriod() != 0) {
+        d_messageTraceCollector.collect();
+    }
+
     // Check if we need to print the stats to log
     if (!isEnabled() || --d_actionCounter != 0) {
         return;  // RETURN
@@ -29,6 +29,9 @@
 
 #include <mqbcfg_messages.h>
 
+// BMQ
+#include <bmqp_messagetrace.h>
+
 // MWC
 #include <mwcst_basictableinfoprovider.h>
 #include <mwcst_statcontext.h>
@@ -111,6 +114,13 @@ class Printer {
     mwctsk::LogCleaner d_statLogCleaner;
     // Mechanism to clean up old stat logs.
 
+    bmqp::MessageTraceCollector d_messageTraceCollector;
+    // Exporter of the message trace records,
+    // drained at every snapshot.
+
+    bslma::Allocator* d_allocator_p;
+    // Allocator to use.
+
   private:
     // NOT IMPLEMENTED
     Printer(const Printer& other) BSLS_CPP11_DELETED;
@@ -275,6 +275,22 @@ QueueStatsDomain::getValue(const mwcst::StatContext& context,
             STAT_RANGE(rangeMax, DomainQueueStats::e_STAT_QUEUE_TIME);
         return max == bsl::numeric_limits<bsls::Types::Int64>::min() ? 0 : max;
     }
+    case QueueStatsDomain::Stat::e_QUEUE_TIME_P50: {
+        const bsls::Types::Int64 p50 =
+            STAT_RANGE(percentile50, DomainQueueStats::e_STAT_QUEUE_TIME);
+        return p50 == bsl::numeric_limits<bsls::Types::Int64>::max() ? 0 : p50;
+    }
+    case QueueStatsDomain::Stat::e_QUEUE_TIME_P99: {
+        const bsls::Types::Int64 p99 =
+            STAT_RANGE(percentile99, DomainQueueStats::e_STAT_QUEUE_TIME);
+        return p99 == bsl::numeric_limits<bsls::Types::Int64>::max() ? 0 : p99;
+    }
+    case QueueStatsDomain::Stat::e_QUEUE_TIME_P999: {
+        const bsls::Types::Int64 p999 =
+            STAT_RANGE(percentile999, DomainQueueStats::e_STAT_QUEUE_TIME);
+        return p999 == bsl::numeric_limits<bsls::Types::Int64>::max() ? 0
+                                                                      : p999;
+    }
     case QueueStatsDomain::Stat::e_GC_MSGS_ABS: {
         return STAT_SINGLE(value, DomainQueueStats::e_STAT_GC_MSGS);
     }
@@ -645,8 +661,10 @@ void QueueStatsClient::onEvent(EventType::Enum type, bsls::Types::Int64 value)
 // ---------------------
 
 bsl::shared_ptr<mwcst::StatContext>
-QueueStatsUtil::initializeStatContextDomains(int               historySize,
-                                             bslma::Allocator* allocator)
+QueueStatsUtil::initializeStatContextDomains(
+    int                        historySize,
+    bslma::Allocator*          allocator,
+    mwcstm::StatContextUpdate* updateCollector)
 {
     bdlma::LocalSequentialAllocator<2048> localAllocator(allocator);
 
@@ -667,7 +685,7 @@ QueueStatsUtil::initializeStatContextDomains(int               historySize,
         .value("confirm")
         .value("confirm_time", mwcst::StatValue::DMCST_DISCRETE)
         .value("reject")
-        .value("queue_time", mwcst::StatValue::DMCST_DISCRETE)
+        .value("queue_time", mwcst::StatValue::DMCST_HISTOGRAM)
         .value("gc")
         .value("push")
         .value("put")
@@ -680,14 +698,20 @@ QueueStatsUtil::initializeStatContextDomains(int               historySize,
     //       nb_producer, nb_consumer, messages and bytes to be using atomic
     //       int and not stat value.
 
+    if (updateCollector) {
+        config.enableUpdateCollection(updateCollector);
+    }
+
     return bsl::shared_ptr<mwcst::StatContext>(
         new (*allocator) mwcst::StatContext(config, allocator),
         allocator);
 }
 
 bsl::shared_ptr<mwcst::StatContext>
-QueueStatsUtil::initializeStatContextClients(int               historySize,
-                                             bslma::Allocator* allocator)
+QueueStatsUtil::initializeStatContextClients(
+    int                        historySize,
+    bslma::Allocator*          allocator,
+    mwcstm::StatContextUpdate* updateCollector)
 {
     bdlma::LocalSequentialAllocator<2048> localAllocator(allocator);
 
@@ -704,6 +728,10 @@ QueueStatsUtil::initializeStatContextClients(int               historySize,
     // NOTE: If the stats are using too much memory, we could reconsider
     //       in_event and out_event to be using atomic int and not stat value.
 
+    if (updateCollector) {
+        config.enableUpdateCollection(updateCollector);
+    }
+
     return bsl::shared_ptr<mwcst::StatContext>(
         new (*allocator) mwcst::StatContext(config, allocator),
         allocator);
@@ -844,6 +872,21 @@ void QueueStatsUtil::initializeTableAndTipDomains(
                      mwcst::StatUtil::rangeMax,
                      start,
                      end);
+    schema.addColumn("queue_time_p50",
+                     DomainQueueStats::e_STAT_QUEUE_TIME,
+                     mwcst::StatUtil::percentile50,
+                     start,
+                     end);
+    schema.addColumn("queue_time_p99",
+                     DomainQueueStats::e_STAT_QUEUE_TIME,
+                     mwcst::StatUtil::percentile99,
+                     start,
+                     end);
+    schema.addColumn("queue_time_p999",
+                     DomainQueueStats::e_STAT_QUEUE_TIME,
+                     mwcst::StatUtil::percentile999,
+                     start,
+                     end);
     schema.addColumn("gc_msgs_delta",
                      DomainQueueStats::e_STAT_GC_MSGS,
                      mwcst::StatUtil::valueDifference,
@@ -906,6 +949,18 @@ void QueueStatsUtil::initializeTableAndTipDomains(
         .zeroString("")
         .extremeValueString("")
         .printAsNsTimeInterval();
+    tip->addColumn("queue_time_p50", "p50")
+        .zeroString("")
+        .extremeValueString("")
+        .printAsNsTimeInterval();
+    tip->addColumn("queue_time_p99", "p99")
+        .zeroString("")
+        .extremeValueString("")
+        .printAsNsTimeInterval();
+    tip->addColumn("queue_time_p999", "p99.9")
+        .zeroString("")
+        .extremeValueString("")
+        .printAsNsTimeInterval();
 
     tip->setColumnGroup("Ack");
     tip->addColumn("ack_delta", "delta").zeroString("");
@@ -55,6 +55,9 @@ namespace BloombergLP {
 namespace mwcst {
 class StatContext;
 }
+namespace mwcstm {
+class StatContextUpdate;
+}
 namespace mqbi {
 class Domain;
 }
@@ -129,6 +132,9 @@ class QueueStatsDomain {
             e_REJECT_DELTA,
             e_QUEUE_TIME_AVG,
             e_QUEUE_TIME_MAX,
+            e_QUEUE_TIME_P50,
+            e_QUEUE_TIME_P99,
+            e_QUEUE_TIME_P999,
             e_GC_MSGS_DELTA,
             e_GC_MSGS_ABS,
             e_ROLE,
@@ -346,16 +352,28 @@ struct QueueStatsUtil {
     /// Initialize the statistics for the queues (domain level) keeping the
     /// specified `historySize` of history: return the created top level
     /// stat context to use as parent of all domains statistics.  Use the
-    /// specified `allocator` for all stat context and stat values.
+    /// specified `allocator` for all stat context and stat values.  If the
+    /// optionally specified `updateCollector` is not 0, collect the changes
+    /// of each snapshot into it (see
+    /// `mwcst::StatContextConfiguration::enableUpdateCollection`).
     static bsl::shared_ptr<mwcst::StatContext>
-    initializeStatContextDomains(int historySize, bslma::Allocator* allocator);
+    initializeStatContextDomains(
+        int                        historySize,
+        bslma::Allocator*          allocator,
+        mwcstm::StatContextUpdate* updateCollector = 0);
 
     /// Initialize the statistics for the queues (client level) keeping the
     /// specified `historySize` of history: return the created top level
     /// stat context to use as parent of all domains statistics.  Use the
-    /// specified `allocator` for all stat context and stat values.
+    /// specified `allocator` for all stat context and stat values.  If the
+    /// optionally specified `updateCollector` is not 0, collect the changes
+    /// of each snapshot into it (see
+    /// `mwcst::StatContextConfiguration::enableUpdateCollection`).
     static bsl::shared_ptr<mwcst::StatContext>
-    initializeStatContextClients(int historySize, bslma::Allocator* allocator);
+    initializeStatContextClients(
+        int                        historySize,
+        bslma::Allocator*          allocator,
+        mwcstm::StatContextUpdate* updateCollector = 0);
 
     /// Load in the specified `table` and `tip` the objects to print the
     /// specified `statContext` for the specified `historySize`.
@@ -31,9 +31,13 @@
 #include <mqbstat_domainstats.h>
 #include <mqbstat_queuestats.h>
 
+// BMQ
+#include <bmqp_messagetrace.h>
+
 // MWC
 #include <mwcio_statchannelfactory.h>
 #include <mwcst_statcontext.h>
+#include <mwcst_statutil.h>
 #include <mwcst_statvalue.h>
 #include <mwcsys_threadutil.h>
 #include <mwcsys_time.h>
@@ -83,6 +87,27 @@ void optionalSemaphorePost(bslmt::Semaphore* semaphore)
     }
 }
 
+/// Load into the specified `counts` the number of allocations and
+/// deallocations of the allocator of the specified `context`, having the
+/// specified `path`, and of all its descendants, as of the latest snapshot.
+void loadAllocationCountsRecursive(StatController::AllocationCounts* counts,
+                                   const bsl::string&                path,
+                                   const mwcst::StatContext&         context)
+{
+    const mwcst::StatValue& value =
+        context.value(mwcst::StatContext::DMCST_DIRECT_VALUE, 0);
+    const mwcst::StatValue::SnapshotLocation latest(0, 0);
+
+    (*counts)[path] = bsl::make_pair(
+        mwcst::StatUtil::increments(value, latest),
+        mwcst::StatUtil::decrements(value, latest));
+
+    for (mwcst::StatContextIterator it = context.subcontextIterator(); it;
+         ++it) {
+        loadAllocationCountsRecursive(counts, path + "/" + it->name(), *it);
+    }
+}
+
 }  // close unnamed namespace
 
 // ------------------------
@@ -194,22 +219,35 @@ void StatController::initializeStats()
     // DomainQueues
     bslma::Allocator* domainQueuesAllocator = d_allocators.get(
         "DomainQueuesStats");
-    d_statContextsMap.insert(bsl::make_pair(
-        bsl::string("domainQueues"),
-        StatContextDetails(QueueStatsUtil::initializeStatContextDomains(
-                               historySize,
-                               domainQueuesAllocator),
-                           false)));
+
+    mwcstm::StatContextUpdate* domainQueuesUpdate =
+        d_statExporter_mp ? d_statExporter_mp->createUpdateCollector() : 0;
+    StatContextSp domainQueues = QueueStatsUtil::initializeStatContextDomains(
+        historySize,
+        domainQueuesAllocator,
+        domainQueuesUpdate);
+    d_statContextsMap.insert(
+        bsl::make_pair(bsl::string("domainQueues"),
+                       StatContextDetails(domainQueues, false)));
 
     // -------
     // Clients
     bslma::Allocator* clientsAllocator = d_allocators.get("ClientsStats");
-    d_statContextsMap.insert(bsl::make_pair(
-        bsl::string("clients"),
-        StatContextDetails(
-            QueueStatsUtil::initializeStatContextClients(historySize,
-                                                         clientsAllocator),
-            false)));
+
+    mwcstm::StatContextUpdate* clientsUpdate =
+        d_statExporter_mp ? d_statExporter_mp->createUpdateCollector() : 0;
+    StatContextSp clients = QueueStatsUtil::initializeStatContextClients(
+        historySize,
+        clientsAllocator,
+        clientsUpdate);
+    d_statContextsMap.insert(
+        bsl::make_pair(bsl::string("clients"),
+                       StatContextDetails(clients, false)));
+
+    if (d_statExporter_mp) {
+        d_statExporter_mp->addContext(domainQueues.get(), domainQueuesUpdate);
+        d_statExporter_mp->addContext(clients.get(), clientsUpdate);
+    }
 
     // ------------
     // ClusterNodes
@@ -256,6 +294,29 @@ void StatController::captureStatsAndSemaphorePost(mqbcmd::StatResult* result,
     semaphore->post();
 }
 
+void StatController::loadAllocationCountsDispatched(
+    AllocationCounts* counts,
+    bslmt::Semaphore* semaphore)
+{
+    // executed by the *SCHEDULER* thread
+
+    if (d_allocatorsStatContext_p) {
+        // When using test allocator, we don't have a stat context
+        d_allocatorsStatContext_p->snapshot();
+
+        // The top level context is not an allocator, only its descendants
+        // are.
+        for (mwcst::StatContextIterator it =
+                 d_allocatorsStatContext_p->subcontextIterator();
+             it;
+             ++it) {
+            loadAllocationCountsRecursive(counts, it->name(), *it);
+        }
+    }
+
+    semaphore->post();
+}
+
 void StatController::setTunable(mqbcmd::StatResult*       result,
                                 const mqbcmd::SetTunable& tunable,
                                 bslmt::Semaphore*         semaphore)
@@ -518,6 +579,12 @@ void StatController::snapshot()
     // through snapshot
     d_systemStatMonitor_mp->snapshot();
 
+    // The exporter must be notified of every snapshot, to export the changes
+    // collected by it.
+    if (d_statExporter_mp) {
+        d_statExporter_mp->onSnapshot();
+    }
+
     // StatConsumers will report all stats
     bsl::vector<StatConsumerMp>::iterator it = d_statConsumers.begin();
     for (; it != d_statConsumers.end(); ++it) {
@@ -613,6 +680,7 @@ StatController::StatController(const CommandProcessorFn& commandProcessor,
 , d_scheduler_mp(0)
 , d_lastSnapshotTime()
 , d_allocatorsStatContext_p(allocatorsStatContext)
+, d_statExporter_mp(0)
 , d_statContextsMap(allocator)
 , d_statContextChannelsLocal_mp(0)
 , d_statContextChannelsRemote_mp(0)
@@ -698,10 +766,35 @@ int StatController::start(bsl::ostream& errorDescription)
         errorStream.reset();
     }
 
+    // Tracing of the messages is printed by the stats printer, and is enabled
+    // only when a sampling period is configured.
+    bmqp::MessageTraceUtil::setSamplingPeriod(
+        bsl::max(0, brkrCfg.stats().messageTraceSamplingPeriod()));
+
+    // The exporter must be created *BEFORE* the stats are initialized, to
+    // collect the updates of the stat contexts it exports.
+    if (!brkrCfg.stats().exportPath().empty()) {
+        d_statExporter_mp.load(new (*d_allocator_p)
+                                   StatExporter(brkrCfg.stats().exportPath(),
+                                                d_allocator_p),
+                               d_allocator_p);
+    }
+
     // We now need to initialize our stats *AFTER* the system stat monitor has
     // been created to ensure that we have a valid stat contexts in our map.
     initializeStats();
 
+    if (d_statExporter_mp) {
+        rc = d_statExporter_mp->start(errorStream);
+        if (rc != 0) {
+            MWCTSK_ALARMLOG_ALARM("#STATS")
+                << "Failed to start StatExporter [rc: " << rc << ", error: '"
+                << errorStream.str() << "']" << MWCTSK_ALARMLOG_END;
+            rc = 0;
+            errorStream.reset();
+        }
+    }
+
     // Build Map to be passed to all lower level components
     bsl::unordered_map<bsl::string, mwcst::StatContext*> ctxPtrMap(
         d_allocator_p);
@@ -827,6 +920,7 @@ void StatController::stop()
     }
 
     STOP_OBJ(d_printer_mp, "Printer");
+    STOP_OBJ(d_statExporter_mp, "StatExporter");
     STOP_OBJ(d_systemStatMonitor_mp, "SystemStatMonitor");
 
     // Destroy everything!!
@@ -835,6 +929,8 @@ void StatController::stop()
     }
     DESTROY_OBJ(d_printer_mp, "Printer");
     DESTROY_OBJ(d_systemStatMonitor_mp, "SystemStatMonitor");
+    // Note that 'd_statExporter_mp' is not destroyed, since it owns the update
+    // collectors of stat contexts which outlive this call.
     DESTROY_OBJ(d_scheduler_mp, "Scheduler");
 
 #undef DESTROY_OBJ
@@ -916,5 +1012,20 @@ int StatController::processCommand(mqbcmd::StatResult*        result,
     return -1;
 }
 
+void StatController::loadAllocationCounts(AllocationCounts* counts)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(counts);
+
+    bslmt::Semaphore semaphore;
+    d_scheduler_mp->scheduleEvent(
+        bsls::TimeInterval(),  // asap
+        bdlf::BindUtil::bind(&StatController::loadAllocationCountsDispatched,
+                             this,
+                             counts,
+                             &semaphore));
+    semaphore.wait();
+}
+
 }  // close package namespace
 }  // close enterprise namespace
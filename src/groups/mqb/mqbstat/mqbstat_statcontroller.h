@@ -25,12 +25,15 @@
 //@DESCRIPTION: 'mqbstat::StatController' handles all the statistics.  It holds
 // the top level StatContext, from which all subcontexts are created, and is
 // responsible from calling snapshot on them as well as regularly (if enable in
-// config) dumping the stats to a dedicated log file.
+// config) dumping the stats to a dedicated log file.  If an 'exportPath' is
+// configured, the changes of the queue stat contexts are also exported in
+// binary form after each snapshot (see 'mqbstat_statexporter').
 
 // MQB
 
 #include <mqbcmd_messages.h>
 #include <mqbstat_printer.h>
+#include <mqbstat_statexporter.h>
 
 // MWC
 #include <mwcma_countingallocatorstore.h>
@@ -47,6 +50,7 @@
 #include <bsl_ostream.h>
 #include <bsl_string.h>
 #include <bsl_unordered_map.h>
+#include <bsl_utility.h>
 #include <bsl_vector.h>
 #include <bslma_allocator.h>
 #include <bslma_managedptr.h>
@@ -118,6 +122,13 @@ class StatController {
     /// Map of StatContext names to StatContext pointers
     typedef bsl::unordered_map<bsl::string, mwcst::StatContext*> StatContexts;
 
+    /// Map of the paths of the allocators to the number of allocations and
+    /// the number of deallocations they performed.
+    typedef bsl::unordered_map<
+        bsl::string,
+        bsl::pair<bsls::Types::Int64, bsls::Types::Int64> >
+        AllocationCounts;
+
   private:
     // CLASS-SCOPE CATEGORY
     BALL_LOG_SET_CLASS_CATEGORY("MQBSTAT.STATCONTROLLER");
@@ -129,6 +140,7 @@ class StatController {
     typedef bsl::shared_ptr<mwcst::StatContext>           StatContextSp;
     typedef bslma::ManagedPtr<mwcsys::StatMonitor>        SystemStatMonitorMp;
     typedef bslma::ManagedPtr<Printer>                    PrinterMp;
+    typedef bslma::ManagedPtr<StatExporter>               StatExporterMp;
     typedef bslma::ManagedPtr<mqbplug::StatPublisher>     StatPublisherMp;
     typedef bslma::ManagedPtr<mqbplug::StatConsumer>      StatConsumerMp;
 
@@ -174,6 +186,13 @@ class StatController {
     // Stat context of the counting allocators,
     // if used.
 
+    StatExporterMp d_statExporter_mp;
+    // Exporter of the queue stat contexts, if
+    // an 'exportPath' is configured.  It owns
+    // the update collectors of these
+    // contexts, so it must be destroyed after
+    // them.
+
     StatContextDetailsMap d_statContextsMap;
     // Map holding all the stat contexts
 
@@ -251,6 +270,12 @@ class StatController {
     void listTunables(mqbcmd::StatResult* result,
                       bslmt::Semaphore*   semaphore = 0);
 
+    /// Snapshot the allocators stat context, load into the specified
+    /// `counts` the number of allocations and deallocations of each
+    /// allocator, and post on the specified `semaphore` once done.
+    void loadAllocationCountsDispatched(AllocationCounts* counts,
+                                        bslmt::Semaphore* semaphore);
+
     /// Snapshot the stats.
     void snapshot();
 
@@ -304,6 +329,15 @@ class StatController {
     int processCommand(mqbcmd::StatResult*        result,
                        const mqbcmd::StatCommand& command);
 
+    /// Load into the specified `counts` the number of allocations and the
+    /// number of deallocations performed so far by each allocator reporting
+    /// to the allocators stat context, excluding those of its child
+    /// allocators, keyed by its path (the names of its ancestors and its
+    /// own name, separated by '/').  Note that `counts` is left empty if
+    /// there is no allocators stat context, and that this method blocks
+    /// until the allocators stat context is snapshot.
+    void loadAllocationCounts(AllocationCounts* counts);
+
     /// Retrieve the domains top-level stat context.
     mwcst::StatContext* domainsStatContext();
 
@@ -0,0 +1,425 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// mqbstat_statexporter.cpp                                           -*-C++-*-
+#include <mqbstat_statexporter.h>
+
+#include <mqbscm_version.h>
+// MWC
+#include <mwcst_statcontext.h>
+#include <mwcu_memoutstream.h>
+#include <mwcu_stringutil.h>
+
+// BDE
+#include <bdlb_bigendian.h>
+#include <bdlt_timeunitratio.h>
+#include <bsl_cerrno.h>
+#include <bsl_cstring.h>
+#include <bsl_vector.h>
+#include <bsls_assert.h>
+
+// SYSTEM
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace BloombergLP {
+namespace mqbstat {
+
+namespace {
+
+/// Prefix of an export path designating a UNIX domain socket.
+const char k_UNIX_PREFIX[] = "unix:";
+
+/// Serialization version of the stream the records are encoded with.  Note
+/// that the encoding of the 'mwcstm' types doesn't depend on it.
+const int k_SERIALIZATION_VERSION = 1;
+
+/// Return true if the specified `path` designates a UNIX domain socket.
+bool isSocketPath(const bsl::string& path)
+{
+    return mwcu::StringUtil::startsWith(path, k_UNIX_PREFIX);
+}
+
+/// Return true if one of the specified `values` changed.
+bool hasChangedValues(const bsl::vector<mwcstm::StatValueUpdate>& values)
+{
+    for (bsl::vector<mwcstm::StatValueUpdate>::const_iterator it =
+             values.begin();
+         it != values.end();
+         ++it) {
+        if (it->fieldMask() != 0) {
+            return true;  // RETURN
+        }
+    }
+
+    return false;
+}
+
+/// Load into the specified `result` the specified `update` of a stat
+/// context, without the subcontexts which did not change, and return true
+/// if the context or one of its subcontexts changed.  If the context did
+/// not change and the specified `force` is false, `result` is only loaded
+/// with the (empty) changed subcontexts.
+bool loadChangedContext(mwcstm::StatContextUpdate*       result,
+                        const mwcstm::StatContextUpdate& update,
+                        bool                             force)
+{
+    // Subcontexts are loaded first, to not copy the values of the
+    // subcontexts which did not change, i.e. most of them on a broker with
+    // many idle queues.
+
+    bsl::vector<mwcstm::StatContextUpdate>& subcontexts =
+        result->subcontexts();
+    subcontexts.clear();
+    for (bsl::vector<mwcstm::StatContextUpdate>::const_iterator it =
+             update.subcontexts().begin();
+         it != update.subcontexts().end();
+         ++it) {
+        subcontexts.resize(subcontexts.size() + 1);
+        if (!loadChangedContext(&subcontexts.back(), *it, false)) {
+            subcontexts.pop_back();
+        }
+    }
+
+    const bool isChanged = !subcontexts.empty() || update.flags() != 0 ||
+                           !update.configuration().isNull() ||
+                           hasChangedValues(update.directValues()) ||
+                           hasChangedValues(update.expiredValues());
+    if (!isChanged && !force) {
+        return false;  // RETURN
+    }
+
+    // Values are identified by their position, so all of them are loaded,
+    // those which did not change having an empty field mask.
+
+    result->id()            = update.id();
+    result->flags()         = update.flags();
+    result->timeStamp()     = update.timeStamp();
+    result->configuration() = update.configuration();
+    result->directValues()  = update.directValues();
+    result->expiredValues() = update.expiredValues();
+
+    return isChanged;
+}
+
+}  // close unnamed namespace
+
+// ---------------------------
+// struct StatExporter::Context
+// ---------------------------
+
+StatExporter::Context::Context(bslma::Allocator* basicAllocator)
+: d_statContext_p(0)
+, d_update(basicAllocator)
+{
+    // NOTHING
+}
+
+StatExporter::Context::Context(const Context&    other,
+                               bslma::Allocator* basicAllocator)
+: d_statContext_p(other.d_statContext_p)
+, d_update(other.d_update, basicAllocator)
+{
+    // NOTHING
+}
+
+// ------------------
+// class StatExporter
+// ------------------
+
+// PRIVATE MANIPULATORS
+int StatExporter::open(bsl::ostream& errorDescription)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(d_fd < 0);
+
+    enum {
+        rc_SUCCESS         = 0,
+        rc_OPEN_FAILURE    = -1,
+        rc_SOCKET_FAILURE  = -2,
+        rc_CONNECT_FAILURE = -3,
+        rc_FCNTL_FAILURE   = -4
+    };
+
+    if (!isSocketPath(d_path)) {
+        d_fd = ::open(d_path.c_str(),
+                      O_WRONLY | O_CREAT | O_TRUNC,
+                      S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+        if (d_fd < 0) {
+            errorDescription << "open() failure for file [" << d_path
+                             << "], errno: " << errno << " ["
+                             << bsl::strerror(errno) << "]";
+            return rc_OPEN_FAILURE;  // RETURN
+        }
+
+        return rc_SUCCESS;  // RETURN
+    }
+
+    // The length of the path was validated by 'start'.
+
+    const bsl::string socketPath = d_path.substr(sizeof(k_UNIX_PREFIX) - 1);
+    sockaddr_un       address;
+    bsl::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    bsl::memcpy(address.sun_path, socketPath.data(), socketPath.length());
+
+    d_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (d_fd < 0) {
+        errorDescription << "socket() failure for [" << d_path
+                         << "], errno: " << errno << " ["
+                         << bsl::strerror(errno) << "]";
+        return rc_SOCKET_FAILURE;  // RETURN
+    }
+
+    if (0 != ::connect(d_fd,
+                       reinterpret_cast<const sockaddr*>(&address),
+                       sizeof(address))) {
+        errorDescription << "connect() failure for [" << d_path
+                         << "], errno: " << errno << " ["
+                         << bsl::strerror(errno) << "]";
+        close();
+        return rc_CONNECT_FAILURE;  // RETURN
+    }
+
+    // Writes must never block the snapshot thread.
+
+    const int flags = ::fcntl(d_fd, F_GETFL, 0);
+    if (flags < 0 || 0 != ::fcntl(d_fd, F_SETFL, flags | O_NONBLOCK)) {
+        errorDescription << "fcntl() failure for [" << d_path
+                         << "], errno: " << errno << " ["
+                         << bsl::strerror(errno) << "]";
+        close();
+        return rc_FCNTL_FAILURE;  // RETURN
+    }
+
+    return rc_SUCCESS;
+}
+
+void StatExporter::close()
+{
+    if (d_fd < 0) {
+        return;  // RETURN
+    }
+
+    ::close(d_fd);
+    d_fd = -1;
+}
+
+int StatExporter::write(const char*   data,
+                        int           length,
+                        bsl::ostream& errorDescription)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(0 <= d_fd);
+
+    while (length > 0) {
+        const ssize_t rc = ::write(d_fd, data, length);
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;  // CONTINUE
+            }
+
+            errorDescription << "write() failure for [" << d_path
+                             << "], errno: " << errno << " ["
+                             << bsl::strerror(errno) << "]";
+            return -1;  // RETURN
+        }
+
+        data += rc;
+        length -= static_cast<int>(rc);
+    }
+
+    return 0;
+}
+
+// CLASS METHODS
+bool StatExporter::loadChanges(mwcstm::StatContextUpdate*       result,
+                               const mwcstm::StatContextUpdate& update)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(result);
+
+    return loadChangedContext(result, update, true);
+}
+
+// CREATORS
+StatExporter::StatExporter(const bsl::string& path,
+                           bslma::Allocator*  allocator)
+: d_path(path, allocator)
+, d_contexts(allocator)
+, d_fd(-1)
+, d_isStarted(false)
+, d_isFullUpdateNeeded(true)
+, d_record(allocator)
+, d_stream(k_SERIALIZATION_VERSION, allocator)
+, d_numRecords(0)
+, d_errorLogLimiter()
+, d_allocator_p(allocator)
+{
+    d_errorLogLimiter.initialize(1, 5 * bdlt::TimeUnitRatio::k_NS_PER_M);
+    // Throttling of one maximum warning per 5 minutes
+}
+
+StatExporter::~StatExporter()
+{
+    stop();
+}
+
+// MANIPULATORS
+mwcstm::StatContextUpdate* StatExporter::createUpdateCollector()
+{
+    d_contexts.emplace_back();
+    return &d_contexts.back().d_update;
+}
+
+void StatExporter::addContext(const mwcst::StatContext*  context,
+                              mwcstm::StatContextUpdate* updateCollector)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(context);
+    BSLS_ASSERT_SAFE(updateCollector);
+
+    for (bsl::deque<Context>::iterator it = d_contexts.begin();
+         it != d_contexts.end();
+         ++it) {
+        if (&it->d_update == updateCollector) {
+            BSLS_ASSERT_SAFE(!it->d_statContext_p);
+            it->d_statContext_p = context;
+            return;  // RETURN
+        }
+    }
+
+    BSLS_ASSERT_SAFE(false && "Unknown update collector");
+}
+
+int StatExporter::start(bsl::ostream& errorDescription)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(!d_isStarted);
+
+    enum { rc_SUCCESS = 0, rc_INVALID_PATH = -1 };
+
+    sockaddr_un address;
+    if (d_path.empty() ||
+        (isSocketPath(d_path) &&
+         (d_path.length() == sizeof(k_UNIX_PREFIX) - 1 ||
+          d_path.length() - (sizeof(k_UNIX_PREFIX) - 1) >=
+              sizeof(address.sun_path)))) {
+        errorDescription << "Invalid stats export path '" << d_path << "'";
+        return rc_INVALID_PATH;  // RETURN
+    }
+
+    // Failing to open the file or to connect to the socket is not fatal: it
+    // is retried on each snapshot, so that the reader can be (re)started at
+    // any time.
+
+    mwcu::MemOutStream errorStream(d_allocator_p);
+    if (0 != open(errorStream)) {
+        BALL_LOG_WARN << "#STATS Failed to open stats export, will retry on "
+                      << "next snapshot [error: '" << errorStream.str()
+                      << "']";
+    }
+
+    d_isFullUpdateNeeded = true;
+    d_isStarted          = true;
+
+    BALL_LOG_INFO << "Exporting statistics to '" << d_path << "' ["
+                  << d_contexts.size() << " contexts]";
+
+    return rc_SUCCESS;
+}
+
+void StatExporter::stop()
+{
+    close();
+    d_isStarted = false;
+}
+
+void StatExporter::onSnapshot()
+{
+    // executed by the *SCHEDULER* thread
+
+    if (!d_isStarted) {
+        return;  // RETURN
+    }
+
+    mwcu::MemOutStream errorStream(d_allocator_p);
+    if (d_fd < 0) {
+        if (0 != open(errorStream)) {
+            if (d_errorLogLimiter.requestPermission()) {
+                BALL_LOG_WARN << "#STATS Failed to open stats export [error: '"
+                              << errorStream.str() << "']";
+            }
+            return;  // RETURN
+        }
+
+        // A new reader, or a new file: start with the full state.
+
+        d_isFullUpdateNeeded = true;
+    }
+
+    bsl::vector<mwcstm::StatContextUpdate>& updates = d_record.contexts();
+    updates.resize(d_contexts.size());
+    for (bsl::size_t i = 0; i < d_contexts.size(); ++i) {
+        const Context& context = d_contexts[i];
+        BSLS_ASSERT_SAFE(context.d_statContext_p);
+
+        if (d_isFullUpdateNeeded) {
+            updates[i].reset();
+            context.d_statContext_p->loadFullUpdate(&updates[i]);
+        }
+        else {
+            loadChanges(&updates[i], context.d_update);
+        }
+    }
+
+    d_stream.reset();
+    d_record.bdexStreamOut(
+        d_stream,
+        mwcstm::StatContextUpdateList::maxSupportedBdexVersion());
+    BSLS_ASSERT_SAFE(d_stream);
+
+    const bdlb::BigEndianUint32 header = bdlb::BigEndianUint32::make(
+        static_cast<unsigned int>(d_stream.length()));
+    if (0 != write(reinterpret_cast<const char*>(&header),
+                   sizeof(header),
+                   errorStream) ||
+        0 != write(d_stream.data(),
+                   static_cast<int>(d_stream.length()),
+                   errorStream)) {
+        // The record may have been partially written: close the file or
+        // connection, so that the reader doesn't see a truncated record
+        // followed by a delta it can't apply, and start again on the next
+        // snapshot.
+
+        if (d_errorLogLimiter.requestPermission()) {
+            BALL_LOG_WARN << "#STATS Failed to export stats, restarting the "
+                          << "export on next snapshot [error: '"
+                          << errorStream.str() << "']";
+        }
+        close();
+        return;  // RETURN
+    }
+
+    d_isFullUpdateNeeded = false;
+    ++d_numRecords;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
@@ -0,0 +1,257 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// mqbstat_statexporter.h                                             -*-C++-*-
+#ifndef INCLUDED_MQBSTAT_STATEXPORTER
+#define INCLUDED_MQBSTAT_STATEXPORTER
+
+//@PURPOSE: Provide a binary, delta-encoded exporter of stat contexts.
+//
+//@CLASSES:
+//  mqbstat::StatExporter: binary exporter of stat context snapshots
+//
+//@SEE_ALSO:
+//  mwcst_statcontext
+//  mwcstm_values
+//
+//@DESCRIPTION: 'mqbstat::StatExporter' writes, after each snapshot, the
+// changes of a set of stat contexts to a local file or UNIX domain socket, to
+// be ingested by an external time-series database.  Unlike the stats printer
+// and the stat consumers, it does not format the stats: it writes the
+// 'mwcstm::StatContextUpdate' collected by each context during the snapshot
+// (see 'mwcst::StatContextConfiguration::enableUpdateCollection'), pruned of
+// the subcontexts which did not change, so that the cost of an export is
+// proportional to the number of changed subcontexts.
+//
+// The export path is either the path of a file, which is truncated when
+// opened, or 'unix:' followed by the path of a listening UNIX domain stream
+// socket.  Writes to the socket never block: if the reader can't keep up, the
+// connection is closed, and reopened on the next snapshot.  The same is done
+// for a file which can't be written to.
+//
+/// Format
+///------
+// Each snapshot is exported as a record made of a 4 bytes length, in network
+// byte order, followed by that many bytes holding a
+// 'mwcstm::StatContextUpdateList' encoded with 'bslx::ByteOutStream', at
+// version 'mwcstm::StatContextUpdateList::maxSupportedBdexVersion()'.  The
+// list holds one update per exported context, in the order the contexts were
+// added.  The first record written to a file or connection holds the full
+// state of each context, and each subsequent record holds the fields changed
+// by the snapshot, for the subcontexts having changed.  A reader rebuilds
+// each context by creating a 'mwcst::StatContext' from its first update,
+// using the 'mwcst::StatContextConfiguration' constructor taking an update,
+// and by applying each subsequent update with
+// 'mwcst::StatContext::snapshotFromUpdate'.
+//
+/// Thread Safety
+///-------------
+// This component is not thread-safe.  'onSnapshot' must be called from the
+// thread snapshotting the exported contexts.
+
+// MWC
+#include <mwcstm_values.h>
+
+// BDE
+#include <ball_log.h>
+#include <bdlmt_throttle.h>
+#include <bsl_deque.h>
+#include <bsl_ostream.h>
+#include <bsl_string.h>
+#include <bslma_allocator.h>
+#include <bslma_usesbslmaallocator.h>
+#include <bslmf_nestedtraitdeclaration.h>
+#include <bsls_cpp11.h>
+#include <bsls_types.h>
+#include <bslx_byteoutstream.h>
+
+namespace BloombergLP {
+
+// FORWARD DECLARATION
+namespace mwcst {
+class StatContext;
+}
+
+namespace mqbstat {
+
+// ==================
+// class StatExporter
+// ==================
+
+/// Binary, delta-encoded exporter of stat context snapshots.
+class StatExporter {
+  private:
+    // CLASS-SCOPE CATEGORY
+    BALL_LOG_SET_CLASS_CATEGORY("MQBSTAT.STATEXPORTER");
+
+  private:
+    // PRIVATE TYPES
+
+    /// Exported context, and the update it collects its changes into.
+    struct Context {
+        // DATA
+        const mwcst::StatContext* d_statContext_p;
+
+        mwcstm::StatContextUpdate d_update;
+
+        // TRAITS
+        BSLMF_NESTED_TRAIT_DECLARATION(Context, bslma::UsesBslmaAllocator)
+
+        // CREATORS
+        explicit Context(bslma::Allocator* basicAllocator = 0);
+
+        Context(const Context& other, bslma::Allocator* basicAllocator = 0);
+    };
+
+    // DATA
+    bsl::string d_path;
+    // Path of the file, or 'unix:' followed by
+    // the path of the socket, to export to.
+
+    bsl::deque<Context> d_contexts;
+    // Exported contexts.  A deque, so that
+    // the address of an update collector is
+    // stable.
+
+    int d_fd;
+    // Descriptor of the opened file or
+    // socket, or -1 if not opened.
+
+    bool d_isStarted;
+    // Whether this object is started.
+
+    bool d_isFullUpdateNeeded;
+    // Whether the next record must hold the
+    // full state of the contexts, because
+    // the file or socket was just opened.
+
+    mwcstm::StatContextUpdateList d_record;
+    // Record being exported, kept to reuse
+    // its memory.
+
+    bslx::ByteOutStream d_stream;
+    // Encoded record, kept to reuse its
+    // memory.
+
+    bsls::Types::Int64 d_numRecords;
+    // Number of records exported.
+
+    bdlmt::Throttle d_errorLogLimiter;
+    // Throttler for the failures to open or
+    // write to the file or socket.
+
+    bslma::Allocator* d_allocator_p;
+    // Allocator to use.
+
+  private:
+    // PRIVATE MANIPULATORS
+
+    /// Open the file or socket to export to.  Return 0 on success, or a
+    /// non-zero value on error and fill in the specified
+    /// `errorDescription` with the description of the error.
+    int open(bsl::ostream& errorDescription);
+
+    /// Close the file or socket to export to, if opened.
+    void close();
+
+    /// Write the specified `length` bytes of the specified `data` to the
+    /// opened file or socket.  Return 0 on success, or a non-zero value on
+    /// error and fill in the specified `errorDescription` with the
+    /// description of the error.
+    int write(const char*   data,
+              int           length,
+              bsl::ostream& errorDescription);
+
+  private:
+    // NOT IMPLEMENTED
+    StatExporter(const StatExporter& other) BSLS_CPP11_DELETED;
+    StatExporter& operator=(const StatExporter& other) BSLS_CPP11_DELETED;
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(StatExporter, bslma::UsesBslmaAllocator)
+
+    // CLASS METHODS
+
+    /// Load into the specified `result` the specified `update` of a stat
+    /// context, without the subcontexts which did not change, and return
+    /// true if the context or one of its subcontexts changed.  A context
+    /// changed if it was created or deleted, or if one of its values
+    /// changed.  `result` is only loaded with the values of a context
+    /// which changed.
+    static bool loadChanges(mwcstm::StatContextUpdate*       result,
+                            const mwcstm::StatContextUpdate& update);
+
+    // CREATORS
+
+    /// Create a `StatExporter` writing to the specified `path`, using the
+    /// specified `allocator` for memory allocation.
+    StatExporter(const bsl::string& path, bslma::Allocator* allocator);
+
+    /// Destroy this object.
+    ~StatExporter();
+
+    // MANIPULATORS
+
+    /// Return the address of a new object, owned by this exporter, to
+    /// collect the changes of a stat context to export into (see
+    /// `mwcst::StatContextConfiguration::enableUpdateCollection`).  The
+    /// context must then be added with `addContext`.
+    mwcstm::StatContextUpdate* createUpdateCollector();
+
+    /// Export the specified `context`, whose changes are collected into the
+    /// specified `updateCollector`.  The behavior is undefined unless
+    /// `updateCollector` was returned by `createUpdateCollector`, and
+    /// `context` outlives this object.
+    void addContext(const mwcst::StatContext*  context,
+                    mwcstm::StatContextUpdate* updateCollector);
+
+    /// Start the exporter.  Return 0 on success, or a non-zero return code
+    /// on error and fill in the specified `errorDescription` stream with
+    /// the description of the error.
+    int start(bsl::ostream& errorDescription);
+
+    /// Stop the exporter, closing the file or socket.
+    void stop();
+
+    /// Export the changes of the contexts collected by their latest
+    /// snapshot.
+    ///
+    /// THREAD: This method is called in the `snapshot` thread.
+    void onSnapshot();
+
+    // ACCESSORS
+
+    /// Return the number of records exported.
+    bsls::Types::Int64 numRecords() const;
+};
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+// ------------------
+// class StatExporter
+// ------------------
+
+inline bsls::Types::Int64 StatExporter::numRecords() const
+{
+    return d_numRecords;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
@@ -0,0 +1,334 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// mqbstat_statexporter.t.cpp                                         -*-C++-*-
+#include <mqbstat_statexporter.h>
+
+// MWC
+#include <mwcst_statcontext.h>
+#include <mwcst_statutil.h>
+#include <mwcst_statvalue.h>
+#include <mwcstm_values.h>
+#include <mwcu_memoutstream.h>
+#include <mwcu_tempdirectory.h>
+
+// BDE
+#include <bdlb_bitutil.h>
+#include <bdls_pathutil.h>
+#include <bsl_fstream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+#include <bslma_managedptr.h>
+#include <bslx_byteinstream.h>
+
+// TEST DRIVER
+#include <mwctst_testhelper.h>
+
+// CONVENIENCE
+using namespace BloombergLP;
+using namespace bsl;
+
+namespace {
+
+// TYPES
+typedef bsl::vector<mwcstm::StatContextUpdateList> Records;
+
+// FUNCTIONS
+
+/// Return a stat context configuration for a table named `queues`, having
+/// a single `put` value, and collecting its updates into the specified
+/// `update`.
+mwcst::StatContextConfiguration
+tableConfiguration(mwcstm::StatContextUpdate* update)
+{
+    mwcst::StatContextConfiguration config("queues", s_allocator_p);
+    config.isTable(true)
+        .defaultHistorySize(3)
+        .value("put")
+        .enableUpdateCollection(update);
+    return config;
+}
+
+/// Return the latest snapshot of the `put` value of the subcontext having
+/// the specified `name` in the specified `context`, or -1 if there is no
+/// such subcontext.
+bsls::Types::Int64 putValue(const mwcst::StatContext& context,
+                            const char*               name)
+{
+    const mwcst::StatContext* subcontext = context.getSubcontext(name);
+    if (!subcontext) {
+        return -1;  // RETURN
+    }
+
+    return mwcst::StatUtil::value(
+        subcontext->value(mwcst::StatContext::DMCST_DIRECT_VALUE, 0),
+        mwcst::StatValue::SnapshotLocation(0, 0));
+}
+
+/// Load into the specified `records` the records exported to the file at
+/// the specified `path`.
+void readRecords(Records* records, const bsl::string& path)
+{
+    bsl::ifstream file(path.c_str(), bsl::ios::binary);
+    ASSERT(file);
+
+    file.seekg(0, bsl::ios::end);
+    bsl::vector<char> content(static_cast<size_t>(file.tellg()),
+                              s_allocator_p);
+    file.seekg(0, bsl::ios::beg);
+    file.read(content.data(), content.size());
+
+    bslx::ByteInStream stream(content.data(), content.size());
+    while (stream && stream.cursor() < stream.length()) {
+        unsigned int length = 0;
+        stream.getUint32(length);
+        const bsl::size_t begin = stream.cursor();
+
+        records->resize(records->size() + 1);
+        records->back().bdexStreamIn(
+            stream,
+            mwcstm::StatContextUpdateList::maxSupportedBdexVersion());
+        ASSERT(stream);
+        ASSERT_EQ(stream.cursor() - begin, length);
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                                    TESTS
+// ----------------------------------------------------------------------------
+
+static void test1_breathingTest()
+// ------------------------------------------------------------------------
+// BREATHING TEST
+//
+// Testing:
+//   Starting and stopping a 'mqbstat::StatExporter', and validation of
+//   its export path.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("BREATHING TEST");
+
+    mwcu::TempDirectory tempDir(s_allocator_p);
+    mwcu::MemOutStream  errorDesc(s_allocator_p);
+
+    PV("Invalid paths");
+    {
+        const bsl::string longSocketPath(200, 'x', s_allocator_p);
+        const char*       k_PATHS[] = {"", "unix:", 0};
+        for (int i = 0; i < 3; ++i) {
+            bsl::string path(s_allocator_p);
+            if (k_PATHS[i]) {
+                path = k_PATHS[i];
+            }
+            else {
+                path = "unix:" + longSocketPath;
+            }
+
+            mqbstat::StatExporter obj(path, s_allocator_p);
+            ASSERT_NE_D(path, obj.start(errorDesc), 0);
+            errorDesc.reset();
+        }
+    }
+
+    PV("Unreachable path");
+    {
+        bsl::string path(tempDir.path(), s_allocator_p);
+        bdls::PathUtil::appendRaw(&path, "missing");
+        bdls::PathUtil::appendRaw(&path, "stats.bin");
+
+        mqbstat::StatExporter      obj(path, s_allocator_p);
+        mwcstm::StatContextUpdate* collector = obj.createUpdateCollector();
+        mwcst::StatContext         context(tableConfiguration(collector),
+                                   s_allocator_p);
+        obj.addContext(&context, collector);
+
+        // Failing to open the file is not fatal, and is retried on each
+        // snapshot.
+
+        ASSERT_EQ(obj.start(errorDesc), 0);
+        context.snapshot();
+        obj.onSnapshot();
+        ASSERT_EQ(obj.numRecords(), 0);
+        obj.stop();
+        obj.stop();  // No effect
+    }
+}
+
+static void test2_loadChanges()
+// ------------------------------------------------------------------------
+// LOAD CHANGES
+//
+// Concerns:
+//   - Created and deleted subcontexts are loaded.
+//   - Subcontexts whose values did not change are not loaded.
+//   - All values of a loaded context are loaded, so that they can be
+//     identified by their position.
+//   - The top level context is loaded even if it did not change.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("LOAD CHANGES");
+
+    typedef mwcstm::StatContextUpdateFlags Flags;
+
+    mwcstm::StatContextUpdate update(s_allocator_p);
+    mwcstm::StatContextUpdate result(s_allocator_p);
+    mwcst::StatContext context(tableConfiguration(&update), s_allocator_p);
+
+    bslma::ManagedPtr<mwcst::StatContext> queue1 = context.addSubcontext(
+        mwcst::StatContextConfiguration("queue1", s_allocator_p));
+    bslma::ManagedPtr<mwcst::StatContext> queue2 = context.addSubcontext(
+        mwcst::StatContextConfiguration("queue2", s_allocator_p));
+    bslma::ManagedPtr<mwcst::StatContext> queue3 = context.addSubcontext(
+        mwcst::StatContextConfiguration("queue3", s_allocator_p));
+
+    PV("Created subcontexts");
+    context.snapshot();
+    ASSERT(mqbstat::StatExporter::loadChanges(&result, update));
+    ASSERT_EQ(result.subcontexts().size(), 3U);
+    ASSERT_EQ(result.directValues().size(), 1U);
+
+    PV("Changed subcontext");
+    queue2->adjustValue(0, 7);
+    context.snapshot();
+    ASSERT(mqbstat::StatExporter::loadChanges(&result, update));
+    ASSERT_EQ(result.subcontexts().size(), 1U);
+    ASSERT_EQ(result.subcontexts()[0].id(), queue2->uniqueId());
+    ASSERT_EQ(result.subcontexts()[0].directValues().size(), 1U);
+    ASSERT_NE(result.subcontexts()[0].directValues()[0].fieldMask(), 0U);
+
+    PV("No change");
+
+    // The min of 'queue2' over the next snapshot is 7, which differs from
+    // its min over the previous one, so two snapshots are needed.
+
+    context.snapshot();
+    context.snapshot();
+    ASSERT(!mqbstat::StatExporter::loadChanges(&result, update));
+    ASSERT(result.subcontexts().empty());
+    ASSERT_EQ(result.id(), update.id());
+    ASSERT_EQ(result.timeStamp(), update.timeStamp());
+    ASSERT_EQ(result.directValues().size(), 1U);
+
+    PV("Deleted subcontext");
+    queue3.clear();
+    context.snapshot();
+    ASSERT(mqbstat::StatExporter::loadChanges(&result, update));
+    ASSERT_EQ(result.subcontexts().size(), 1U);
+    ASSERT(bdlb::BitUtil::isBitSet(result.subcontexts()[0].flags(),
+                                   Flags::DMCSTM_CONTEXT_DELETED));
+}
+
+static void test3_exportToFile()
+// ------------------------------------------------------------------------
+// EXPORT TO FILE
+//
+// Concerns:
+//   - A record is written to the file on each snapshot, the first one
+//     holding the full state of the contexts, and the next ones the
+//     changed subcontexts only.
+//   - No subcontext is written once the values stopped changing.
+//   - The contexts can be rebuilt from the records.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("EXPORT TO FILE");
+
+    mwcu::TempDirectory tempDir(s_allocator_p);
+    bsl::string         path(tempDir.path(), s_allocator_p);
+    bdls::PathUtil::appendRaw(&path, "stats.bin");
+
+    mqbstat::StatExporter      obj(path, s_allocator_p);
+    mwcstm::StatContextUpdate* collector = obj.createUpdateCollector();
+    mwcst::StatContext context(tableConfiguration(collector), s_allocator_p);
+    obj.addContext(&context, collector);
+
+    mwcu::MemOutStream errorDesc(s_allocator_p);
+    ASSERT_EQ(obj.start(errorDesc), 0);
+
+    bslma::ManagedPtr<mwcst::StatContext> queue1 = context.addSubcontext(
+        mwcst::StatContextConfiguration("queue1", s_allocator_p));
+    bslma::ManagedPtr<mwcst::StatContext> queue2 = context.addSubcontext(
+        mwcst::StatContextConfiguration("queue2", s_allocator_p));
+
+    queue1->adjustValue(0, 10);
+    context.snapshot();
+    obj.onSnapshot();
+
+    queue2->adjustValue(0, 5);
+    context.snapshot();
+    obj.onSnapshot();
+
+    context.snapshot();
+    obj.onSnapshot();
+
+    context.snapshot();
+    obj.onSnapshot();
+
+    obj.stop();
+    ASSERT_EQ(obj.numRecords(), 4);
+
+    Records records(s_allocator_p);
+    readRecords(&records, path);
+    ASSERT_EQ(records.size(), 4U);
+    if (records.size() != 4U) {
+        return;  // RETURN
+    }
+
+    for (size_t i = 0; i < records.size(); ++i) {
+        ASSERT_EQ_D(i, records[i].contexts().size(), 1U);
+    }
+    ASSERT_EQ(records[0].contexts()[0].subcontexts().size(), 2U);
+    ASSERT_EQ(records[3].contexts()[0].subcontexts().size(), 0U);
+
+    mwcst::StatContext replica(
+        mwcst::StatContextConfiguration(records[0].contexts()[0],
+                                        s_allocator_p),
+        s_allocator_p);
+    ASSERT_EQ(putValue(replica, "queue1"), 10);
+    ASSERT_EQ(putValue(replica, "queue2"), 0);
+
+    replica.snapshotFromUpdate(records[1].contexts()[0]);
+    ASSERT_EQ(putValue(replica, "queue1"), 10);
+    ASSERT_EQ(putValue(replica, "queue2"), 5);
+
+    for (size_t i = 2; i < records.size(); ++i) {
+        replica.snapshotFromUpdate(records[i].contexts()[0]);
+        ASSERT_EQ_D(i, putValue(replica, "queue1"), 10);
+        ASSERT_EQ_D(i, putValue(replica, "queue2"), 5);
+    }
+}
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    TEST_PROLOG(mwctst::TestHelper::e_DEFAULT);
+
+    switch (_testCase) {
+    case 0:
+    case 3: test3_exportToFile(); break;
+    case 2: test2_loadChanges(); break;
+    case 1: test1_breathingTest(); break;
+    default: {
+        cerr << "WARNING: CASE '" << _testCase << "' NOT FOUND." << endl;
+        s_testStatus = -1;
+    } break;
+    }
+
+    TEST_EPILOG(mwctst::TestHelper::e_CHECK_DEF_GBL_ALLOC);
+}
@@ -35,6 +35,14 @@
 namespace BloombergLP {
 namespace mwcio {
 
+namespace {
+
+/// Number of shards of the `out_bytes` value of a channel, which is updated
+/// by any thread writing to the channel.
+const int k_NUM_OUT_BYTES_SHARDS = 8;
+
+}  // close unnamed namespace
+
 // ------------------------------
 // class StatChannelFactoryConfig
 // ------------------------------
@@ -220,6 +228,7 @@ StatChannelFactoryUtil::statContextConfiguration(const bsl::string& name,
     config.isTable(true);
     config.value("in_bytes")
         .value("out_bytes")
+        .valueShards(k_NUM_OUT_BYTES_SHARDS)
         .storeExpiredSubcontextValues(true);
 
     if (historySize != -1) {
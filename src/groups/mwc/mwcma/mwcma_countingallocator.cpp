@@ -29,6 +29,8 @@
 #include <balst_stacktraceprintutil.h>
 #include <bsl_iostream.h>
 #include <bsl_limits.h>
+#include <bsl_string.h>
+#include <bslmf_assert.h>
 #include <bsls_alignmentutil.h>
 #include <bsls_annotation.h>
 #include <bsls_assert.h>
@@ -45,6 +47,26 @@ namespace {
 /// deallocate unallocated or previously freed memory.
 const unsigned int k_MAGIC = 0xabcdabcd;
 
+/// Name of the stat value of each size class, also used to name its columns
+/// in the tables.
+const char* const k_SIZE_CLASS_NAMES[] = {"<= 64B",
+                                          "<= 512B",
+                                          "<= 4KB",
+                                          "<= 32KB",
+                                          "> 32KB"};
+
+/// Suffix of the schema column name of each size class.
+const char* const k_SIZE_CLASS_IDS[] = {"UpTo64B",
+                                        "UpTo512B",
+                                        "UpTo4KB",
+                                        "UpTo32KB",
+                                        "Over32KB"};
+
+BSLMF_ASSERT(sizeof(k_SIZE_CLASS_NAMES) / sizeof(*k_SIZE_CLASS_NAMES) ==
+             CountingAllocator::k_NUM_SIZE_CLASSES);
+BSLMF_ASSERT(sizeof(k_SIZE_CLASS_IDS) / sizeof(*k_SIZE_CLASS_IDS) ==
+             CountingAllocator::k_NUM_SIZE_CLASSES);
+
 // FUNCTIONS
 bool statFilter(const mwcst::StatContext*     context,
                 mwcst::StatContext::ValueType valueType,
@@ -63,6 +85,33 @@ bool statFilter2(const mwcst::TableRecords::Record& rec)
                                         0) > 0);
 }
 
+/// Add to the specified `config` the stat values of a counting allocator,
+/// having the specified `historySize`, or the default history size of the
+/// context if `historySize` is 0.  Use the specified `allocator` to supply
+/// memory.
+void addValues(mwcst::StatContextConfiguration* config,
+               int                              historySize,
+               bslma::Allocator*                allocator)
+{
+    if (historySize == 0) {
+        config->value("Memory");
+    }
+    else {
+        config->value("Memory", historySize);
+    }
+
+    for (int i = 0; i < CountingAllocator::k_NUM_SIZE_CLASSES; ++i) {
+        bsl::string name("Memory ", allocator);
+        name.append(k_SIZE_CLASS_NAMES[i]);
+        if (historySize == 0) {
+            config->value(name);
+        }
+        else {
+            config->value(name, historySize);
+        }
+    }
+}
+
 bool statSort(const mwcst::StatContext* lhs, const mwcst::StatContext* rhs)
 {
     const mwcst::StatValue& lhsTotalValue =
@@ -100,6 +149,11 @@ union Header {
 // class CountingAllocator
 // -----------------------
 
+// PUBLIC CONSTANTS
+const int CountingAllocator::k_MEMORY_VALUE_INDEX;
+const int CountingAllocator::k_SIZE_CLASS_VALUE_INDEX;
+const int CountingAllocator::k_NUM_SIZE_CLASSES;
+
 // CLASS METHODS
 void CountingAllocator::configureStatContextTableInfoProvider(
     mwcst::StatContextTableInfoProvider* tableInfoProvider)
@@ -120,6 +174,24 @@ void CountingAllocator::configureStatContextTableInfoProvider(
     tableInfoProvider->addColumn("-delta-", 0, SU::incrementsDifference, 0, 1);
     tableInfoProvider->addColumn("Deallocations", 0, SU::decrements, 0);
     tableInfoProvider->addColumn("-delta-", 0, SU::decrementsDifference, 0, 1);
+    tableInfoProvider->addColumn("Allocations/s",
+                                 0,
+                                 SU::incrementsPerSecond,
+                                 0,
+                                 1);
+    tableInfoProvider->addColumn("Deallocations/s",
+                                 0,
+                                 SU::decrementsPerSecond,
+                                 0,
+                                 1);
+    for (int i = 0; i < k_NUM_SIZE_CLASSES; ++i) {
+        tableInfoProvider->addColumn(bsl::string("Allocations/s ") +
+                                         k_SIZE_CLASS_NAMES[i],
+                                     k_SIZE_CLASS_VALUE_INDEX + i,
+                                     SU::incrementsPerSecond,
+                                     0,
+                                     1);
+    }
 }
 
 void CountingAllocator::configureStatContextTableInfoProvider(
@@ -156,6 +228,24 @@ void CountingAllocator::configureStatContextTableInfoProvider(
                       SU::decrementsDifference,
                       cur,
                       end);
+    schema->addColumn("numAllocationsPerSecond",
+                      0,
+                      SU::incrementsPerSecond,
+                      cur,
+                      end);
+    schema->addColumn("numDeallocationsPerSecond",
+                      0,
+                      SU::decrementsPerSecond,
+                      cur,
+                      end);
+    for (int i = 0; i < k_NUM_SIZE_CLASSES; ++i) {
+        schema->addColumn(bsl::string("numAllocationsPerSecond") +
+                              k_SIZE_CLASS_IDS[i],
+                          k_SIZE_CLASS_VALUE_INDEX + i,
+                          SU::incrementsPerSecond,
+                          cur,
+                          end);
+    }
 
     // Configure records
     mwcst::TableRecords* records = &table->records();
@@ -180,6 +270,22 @@ void CountingAllocator::configureStatContextTableInfoProvider(
     basicTableInfoProvider->addColumn("numDeallocations", "Deallocations");
     basicTableInfoProvider->addColumn("numDeallocationsDelta", "-delta-")
         .zeroString("");
+    basicTableInfoProvider
+        ->addColumn("numAllocationsPerSecond", "Allocations/s")
+        .zeroString("")
+        .setPrecision(0);
+    basicTableInfoProvider
+        ->addColumn("numDeallocationsPerSecond", "Deallocations/s")
+        .zeroString("")
+        .setPrecision(0);
+    for (int i = 0; i < k_NUM_SIZE_CLASSES; ++i) {
+        basicTableInfoProvider
+            ->addColumn(bsl::string("numAllocationsPerSecond") +
+                            k_SIZE_CLASS_IDS[i],
+                        bsl::string("Allocations/s ") + k_SIZE_CLASS_NAMES[i])
+            .zeroString("")
+            .setPrecision(0);
+    }
 }
 
 void CountingAllocator::onAllocationChange(bsls::Types::Int64 deltaValue)
@@ -210,6 +316,29 @@ void CountingAllocator::onAllocationChange(bsls::Types::Int64 deltaValue)
     }
 }
 
+void CountingAllocator::createStatContext(
+    const bslstl::StringRef& name,
+    mwcst::StatContext*      parentStatContext,
+    bslma::Allocator*        allocator)
+{
+    CountingAllocator* ca = dynamic_cast<CountingAllocator*>(d_allocator_p);
+    if (ca) {
+        // The 'allocator' is a 'CountingAllocator'
+        d_allocator_p      = ca->d_allocator_p;
+        d_parentCounting_p = ca;
+    }
+
+    if (parentStatContext) {
+        mwcst::StatContextConfiguration config(name, allocator);
+        config.isTable(true);
+        addValues(&config,
+                  parentStatContext->hasDefaultHistorySize() ? 0 : 2,
+                  allocator);
+
+        d_statContext_mp = parentStatContext->addSubcontext(config);
+    }
+}
+
 CountingAllocator::CountingAllocator(const bslstl::StringRef& name,
                                      bslma::Allocator*        allocator)
 : d_statContext_mp()
@@ -218,6 +347,7 @@ CountingAllocator::CountingAllocator(const bslstl::StringRef& name,
 , d_allocated(0)
 , d_allocationLimit(bsl::numeric_limits<bsls::Types::Uint64>::max())
 // Disable allocation limit by default
+, d_hasSizeClassStats(false)
 {
     CountingAllocator* ca = dynamic_cast<CountingAllocator*>(d_allocator_p);
     if (ca) {
@@ -225,7 +355,8 @@ CountingAllocator::CountingAllocator(const bslstl::StringRef& name,
         if (ca->d_statContext_mp) {
             d_statContext_mp = ca->d_statContext_mp->addSubcontext(
                 mwcst::StatContextConfiguration(name, allocator));
-            d_parentCounting_p = ca;
+            d_parentCounting_p  = ca;
+            d_hasSizeClassStats = ca->d_hasSizeClassStats;
         }
     }
 }
@@ -239,28 +370,24 @@ CountingAllocator::CountingAllocator(const bslstl::StringRef& name,
 , d_allocated(0)
 , d_allocationLimit(bsl::numeric_limits<bsls::Types::Uint64>::max())
 // Disable allocation limit by default
+, d_hasSizeClassStats(false)
 {
-    CountingAllocator* ca = dynamic_cast<CountingAllocator*>(d_allocator_p);
-    if (ca) {
-        // The 'allocator' is a 'CountingAllocator'
-        d_allocator_p      = ca->d_allocator_p;
-        d_parentCounting_p = ca;
-    }
+    createStatContext(name, parentStatContext, allocator);
+}
 
-    if (parentStatContext) {
-        if (parentStatContext->hasDefaultHistorySize()) {
-            d_statContext_mp = parentStatContext->addSubcontext(
-                mwcst::StatContextConfiguration(name, allocator)
-                    .isTable(true)
-                    .value("Memory"));
-        }
-        else {
-            d_statContext_mp = parentStatContext->addSubcontext(
-                mwcst::StatContextConfiguration(name, allocator)
-                    .isTable(true)
-                    .value("Memory", 2));
-        }
-    }
+CountingAllocator::CountingAllocator(const bslstl::StringRef& name,
+                                     mwcst::StatContext*  parentStatContext,
+                                     SizeClassStats::Enum sizeClassStats,
+                                     bslma::Allocator*    allocator)
+: d_statContext_mp()
+, d_allocator_p(bslma::Default::allocator(allocator))
+, d_parentCounting_p(0)
+, d_allocated(0)
+, d_allocationLimit(bsl::numeric_limits<bsls::Types::Uint64>::max())
+// Disable allocation limit by default
+, d_hasSizeClassStats(sizeClassStats == SizeClassStats::e_ENABLED)
+{
+    createStatContext(name, parentStatContext, allocator);
 }
 
 CountingAllocator::~CountingAllocator()
@@ -304,7 +431,12 @@ void* CountingAllocator::allocate(size_type size)
     const bsls::Types::Int64 totalSize =
         bsls::AlignmentUtil::roundUpToMaximalAlignment(size) + sizeof(Header);
     BSLS_ASSERT_SAFE(totalSize >= 0);
-    d_statContext_mp->adjustValue(0, totalSize);
+    d_statContext_mp->adjustValue(k_MEMORY_VALUE_INDEX, totalSize);
+    if (d_hasSizeClassStats) {
+        d_statContext_mp->adjustValue(k_SIZE_CLASS_VALUE_INDEX +
+                                          sizeClass(totalSize),
+                                      totalSize);
+    }
 
     Header* header = static_cast<Header*>(d_allocator_p->allocate(totalSize));
     header->d_data.d_numAllocatedBytes = totalSize;
@@ -359,7 +491,12 @@ void CountingAllocator::deallocate(void* address)
     header->d_data.d_magic = ~k_MAGIC;
     d_allocator_p->deallocate(header);
 
-    d_statContext_mp->adjustValue(0, -totalSize);
+    d_statContext_mp->adjustValue(k_MEMORY_VALUE_INDEX, -totalSize);
+    if (d_hasSizeClassStats) {
+        d_statContext_mp->adjustValue(k_SIZE_CLASS_VALUE_INDEX +
+                                          sizeClass(totalSize),
+                                      -totalSize);
+    }
     onAllocationChange(-totalSize);
 }
 
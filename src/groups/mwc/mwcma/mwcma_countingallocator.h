@@ -43,6 +43,26 @@
 // See 'mwcma_countingallocatorstore' for how to collect allocation statistics
 // when necessary while incurring no runtime overhead otherwise.
 //
+/// Allocation Rates and Size Classes
+///----------------------------------
+// The stat context of a 'CountingAllocator' has one value holding the bytes
+// currently allocated, at index 'k_MEMORY_VALUE_INDEX', whose increments and
+// decrements are the allocations and deallocations.  It also has one value
+// per size class, starting at index 'k_SIZE_CLASS_VALUE_INDEX', holding the
+// bytes currently allocated by allocations of that class, so that the
+// allocations can be broken down by size.  There are 'k_NUM_SIZE_CLASSES'
+// size classes, each 8 times as wide as the previous one, the first one
+// counting the allocations of up to 64 bytes (header included), and the last
+// one counting all the allocations above 32 KB.  The tables configured by
+// 'configureStatContextTableInfoProvider' show the allocation and
+// deallocation rates per second, in total and for each size class, which
+// helps finding the code paths allocating the most.
+//
+// Since updating the value of the size class doubles the cost of recording
+// an allocation, the size class values are only updated by a counting
+// allocator created with 'SizeClassStats::e_ENABLED', and by its children,
+// and stay at 0 otherwise.
+//
 /// Allocation Limit
 ///----------------
 // The 'CountingAllocator', when created with a StatContext, or as a child of a
@@ -79,6 +99,7 @@
 #include <bslmf_istriviallycopyable.h>
 #include <bslmf_nestedtraitdeclaration.h>
 #include <bslmt_mutex.h>
+#include <bsls_assert.h>
 #include <bsls_atomic.h>
 #include <bsls_keyword.h>
 #include <bsls_types.h>
@@ -117,6 +138,25 @@ class CountingAllocator BSLS_KEYWORD_FINAL : public bslma::Allocator {
 
     typedef bsl::function<void()> AllocationLimitCallback;
 
+    /// Enumeration of whether the allocations are also reported to the
+    /// stat value of their size class.
+    struct SizeClassStats {
+        enum Enum { e_DISABLED = 0, e_ENABLED = 1 };
+    };
+
+    // PUBLIC CONSTANTS
+
+    /// Index of the stat value holding the bytes currently allocated.
+    static const int k_MEMORY_VALUE_INDEX = 0;
+
+    /// Index of the stat value of the first size class.  The stat value of
+    /// the size class at index `i` is at index
+    /// `k_SIZE_CLASS_VALUE_INDEX + i`.
+    static const int k_SIZE_CLASS_VALUE_INDEX = 1;
+
+    /// Number of size classes the allocations are broken down in.
+    static const int k_NUM_SIZE_CLASSES = 5;
+
   private:
     // CLASS-SCOPE CATEGORY
     BALL_LOG_SET_CLASS_CATEGORY("MWCMA.COUNTINGALLOCATOR");
@@ -158,6 +198,11 @@ class CountingAllocator BSLS_KEYWORD_FINAL : public bslma::Allocator {
     // invoked at most once, the first
     // time only the limit is breached.
 
+    bool d_hasSizeClassStats;
+    // Whether allocations are also
+    // reported to the stat value of
+    // their size class.
+
   private:
     // NOT IMPLEMENTED
     CountingAllocator(const CountingAllocator&) BSLS_KEYWORD_DELETED;
@@ -187,6 +232,16 @@ class CountingAllocator BSLS_KEYWORD_FINAL : public bslma::Allocator {
         const mwcst::StatValue::SnapshotLocation& startSnapshot,
         const mwcst::StatValue::SnapshotLocation& endSnapshot);
 
+    /// Return the index of the size class of an allocation of the specified
+    /// `size` bytes, header included.
+    static int sizeClass(size_type size);
+
+    /// Return the largest size, in bytes, of the allocations of the size
+    /// class at the specified `index`.  The behavior is undefined unless
+    /// `0 <= index < k_NUM_SIZE_CLASSES - 1`, the last size class being
+    /// unbounded.
+    static size_type sizeClassUpperBound(int index);
+
   private:
     // PRIVATE MANIPULATORS
 
@@ -196,6 +251,13 @@ class CountingAllocator BSLS_KEYWORD_FINAL : public bslma::Allocator {
     /// deallocation).
     void onAllocationChange(bsls::Types::Int64 deltaValue);
 
+    /// Create the stat context of this object, having the specified `name`,
+    /// as a child of the specified `parentStatContext`, if not null, using
+    /// the specified `allocator` to supply memory.
+    void createStatContext(const bslstl::StringRef& name,
+                           mwcst::StatContext*      parentStatContext,
+                           bslma::Allocator*        allocator);
+
   public:
     // CREATORS
 
@@ -218,6 +280,15 @@ class CountingAllocator BSLS_KEYWORD_FINAL : public bslma::Allocator {
                       mwcst::StatContext*      parentStatContext,
                       bslma::Allocator*        allocator = 0);
 
+    /// Create a counting allocator as above, which reports its allocations
+    /// to the stat value of their size class if the specified
+    /// `sizeClassStats` is `SizeClassStats::e_ENABLED`.  Note that the
+    /// children of this allocator inherit this setting.
+    CountingAllocator(const bslstl::StringRef& name,
+                      mwcst::StatContext*      parentStatContext,
+                      SizeClassStats::Enum     sizeClassStats,
+                      bslma::Allocator*        allocator = 0);
+
     /// Destroy this object.
     virtual ~CountingAllocator() BSLS_KEYWORD_OVERRIDE;
 
@@ -267,6 +338,27 @@ class CountingAllocator BSLS_KEYWORD_FINAL : public bslma::Allocator {
 // class CountingAllocator
 // -----------------------
 
+// CLASS METHODS
+inline int CountingAllocator::sizeClass(size_type size)
+{
+    int index = 0;
+    while (index < k_NUM_SIZE_CLASSES - 1 &&
+           size > sizeClassUpperBound(index)) {
+        ++index;
+    }
+
+    return index;
+}
+
+inline CountingAllocator::size_type
+CountingAllocator::sizeClassUpperBound(int index)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(0 <= index && index < k_NUM_SIZE_CLASSES - 1);
+
+    return static_cast<size_type>(64) << (3 * index);
+}
+
 // ACCESSORS
 //   (specific to mwcma::CountingAllocator)
 inline const mwcst::StatContext* CountingAllocator::context() const
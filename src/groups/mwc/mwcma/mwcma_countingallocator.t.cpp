@@ -20,6 +20,7 @@
 #include <mwcst_basictableinfoprovider.h>
 #include <mwcst_statcontext.h>
 #include <mwcst_statcontexttableinfoprovider.h>
+#include <mwcst_statutil.h>
 #include <mwcst_statvalue.h>
 #include <mwcst_table.h>
 #include <mwctst_scopedlogobserver.h>
@@ -29,6 +30,7 @@
 #include <ball_severity.h>
 #include <bdlf_bind.h>
 #include <bsl_iostream.h>
+#include <bsl_limits.h>
 #include <bsl_sstream.h>
 #include <bslma_default.h>
 #include <bsls_timeutil.h>
@@ -59,7 +61,14 @@ static const char* k_COLS1[] = {""  // Leftmost column is empty
                                 "Allocations",
                                 "-delta-",
                                 "Deallocations",
-                                "-delta-"};
+                                "-delta-",
+                                "Allocations/s",
+                                "Deallocations/s",
+                                "Allocations/s <= 64B",
+                                "Allocations/s <= 512B",
+                                "Allocations/s <= 4KB",
+                                "Allocations/s <= 32KB",
+                                "Allocations/s > 32KB"};
 
 const static size_t k_NUM_COLS1 = sizeof(k_COLS1) / sizeof(k_COLS1[0]);
 
@@ -70,7 +79,14 @@ static const char* k_COLS2[] = {"id",
                                 "numAllocations",
                                 "numAllocationsDelta",
                                 "numDeallocations",
-                                "numDeallocationsDelta"};
+                                "numDeallocationsDelta",
+                                "numAllocationsPerSecond",
+                                "numDeallocationsPerSecond",
+                                "numAllocationsPerSecondUpTo64B",
+                                "numAllocationsPerSecondUpTo512B",
+                                "numAllocationsPerSecondUpTo4KB",
+                                "numAllocationsPerSecondUpTo32KB",
+                                "numAllocationsPerSecondOver32KB"};
 
 const static size_t k_NUM_COLS2 = sizeof(k_COLS2) / sizeof(k_COLS2[0]);
 
@@ -529,6 +545,130 @@ static void test7_configureStatContextTableInfoProvider_part2()
     }
 }
 
+static void test8_sizeClasses()
+// ------------------------------------------------------------------------
+// SIZE CLASSES
+//
+// Concerns:
+//   1. Each size class is bounded by the upper bound of the previous one,
+//      and the last one is unbounded.
+//   2. An allocation and its deallocation are reported to the stat value
+//      of its size class, in addition to the total memory value, by an
+//      allocator created with size class stats enabled, and its children.
+//   3. An allocator created without size class stats enabled only reports
+//      allocations to the total memory value.
+//
+// Testing:
+//   sizeClass
+//   sizeClassUpperBound
+//   CountingAllocator(name, parentStatContext, sizeClassStats, allocator)
+//   allocate
+//   deallocate
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("SIZE CLASSES");
+
+    typedef mwcma::CountingAllocator Obj;
+
+    // 1. Bounds of the size classes
+    ASSERT_EQ(Obj::sizeClass(1), 0);
+    for (int i = 0; i < Obj::k_NUM_SIZE_CLASSES - 1; ++i) {
+        const Obj::size_type bound = Obj::sizeClassUpperBound(i);
+        ASSERT_EQ_D(i, Obj::sizeClass(bound), i);
+        ASSERT_EQ_D(i, Obj::sizeClass(bound + 1), i + 1);
+    }
+    ASSERT_EQ(Obj::sizeClass(bsl::numeric_limits<Obj::size_type>::max()),
+              Obj::k_NUM_SIZE_CLASSES - 1);
+
+    // 2. Allocations are reported to their size class
+    mwcst::StatContextConfiguration config("test", s_allocator_p);
+    mwcst::StatContext              parentStatContext(config, s_allocator_p);
+    Obj                             obj("Test",
+                                        &parentStatContext,
+                                        Obj::SizeClassStats::e_ENABLED,
+                                        s_allocator_p);
+
+    const mwcst::StatContext* context = obj.context();
+    ASSERT_EQ(context->numValues(),
+              Obj::k_SIZE_CLASS_VALUE_INDEX + Obj::k_NUM_SIZE_CLASSES);
+
+    void* small = obj.allocate(1);
+    void* large = obj.allocate(64 * 1024);
+    parentStatContext.snapshot();
+
+    const mwcst::StatContext::ValueType k_DIRECT =
+        mwcst::StatContext::DMCST_DIRECT_VALUE;
+    const mwcst::StatValue::SnapshotLocation k_LATEST(0, 0);
+
+    ASSERT_EQ(mwcst::StatUtil::increments(
+                  context->value(k_DIRECT, Obj::k_MEMORY_VALUE_INDEX),
+                  k_LATEST),
+              2);
+    for (int i = 0; i < Obj::k_NUM_SIZE_CLASSES; ++i) {
+        const bool isUsed = (i == 0 || i == Obj::k_NUM_SIZE_CLASSES - 1);
+        const mwcst::StatValue& value = context->value(
+            k_DIRECT,
+            Obj::k_SIZE_CLASS_VALUE_INDEX + i);
+        ASSERT_EQ_D(i,
+                    mwcst::StatUtil::increments(value, k_LATEST),
+                    isUsed ? 1 : 0);
+        ASSERT_EQ_D(i, mwcst::StatUtil::value(value, k_LATEST) > 0, isUsed);
+    }
+
+    obj.deallocate(large);
+    obj.deallocate(small);
+    parentStatContext.snapshot();
+
+    for (int i = 0; i < Obj::k_NUM_SIZE_CLASSES; ++i) {
+        const mwcst::StatValue& value = context->value(
+            k_DIRECT,
+            Obj::k_SIZE_CLASS_VALUE_INDEX + i);
+        ASSERT_EQ_D(i,
+                    mwcst::StatUtil::decrements(value, k_LATEST),
+                    mwcst::StatUtil::increments(value, k_LATEST));
+        ASSERT_EQ_D(i, mwcst::StatUtil::value(value, k_LATEST), 0);
+    }
+
+    // Children inherit the setting of their parent
+    {
+        Obj child("Child", &obj);
+
+        void* block = child.allocate(1);
+        parentStatContext.snapshot();
+
+        const mwcst::StatValue& value = child.context()->value(
+            k_DIRECT,
+            Obj::k_SIZE_CLASS_VALUE_INDEX);
+        ASSERT_EQ(mwcst::StatUtil::increments(value, k_LATEST), 1);
+
+        child.deallocate(block);
+    }
+
+    // 3. Size class stats are disabled by default
+    Obj defaultObj("Default", &parentStatContext, s_allocator_p);
+
+    const mwcst::StatContext* defaultContext = defaultObj.context();
+    ASSERT_EQ(defaultContext->numValues(),
+              Obj::k_SIZE_CLASS_VALUE_INDEX + Obj::k_NUM_SIZE_CLASSES);
+
+    void* block = defaultObj.allocate(1);
+    parentStatContext.snapshot();
+
+    ASSERT_EQ(mwcst::StatUtil::increments(
+                  defaultContext->value(k_DIRECT, Obj::k_MEMORY_VALUE_INDEX),
+                  k_LATEST),
+              1);
+    for (int i = 0; i < Obj::k_NUM_SIZE_CLASSES; ++i) {
+        const mwcst::StatValue& value = defaultContext->value(
+            k_DIRECT,
+            Obj::k_SIZE_CLASS_VALUE_INDEX + i);
+        ASSERT_EQ_D(i, mwcst::StatUtil::increments(value, k_LATEST), 0);
+        ASSERT_EQ_D(i, mwcst::StatUtil::value(value, k_LATEST), 0);
+    }
+
+    defaultObj.deallocate(block);
+}
+
 BSLA_MAYBE_UNUSED
 static void testN1_performance_allocation()
 // ------------------------------------------------------------------------
@@ -757,6 +897,7 @@ int main(int argc, char** argv)
 
     switch (_testCase) {
     case 0:
+    case 8: test8_sizeClasses(); break;
     case 7: test7_configureStatContextTableInfoProvider_part2(); break;
     case 6: test6_configureStatContextTableInfoProvider_part1(); break;
     case 5: test5_allocationLimitHierarchical(); break;
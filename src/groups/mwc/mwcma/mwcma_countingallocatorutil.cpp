@@ -65,8 +65,9 @@ bsls::AtomicBool g_initialized(false);
 
 // CLASS METHODS
 void CountingAllocatorUtil::initGlobalAllocators(
-    const mwcst::StatContextConfiguration& globalStatContextConfiguration,
-    const bslstl::StringRef&               topAllocatorName)
+    const mwcst::StatContextConfiguration&  globalStatContextConfiguration,
+    const bslstl::StringRef&                topAllocatorName,
+    CountingAllocator::SizeClassStats::Enum sizeClassStats)
 {
     // PRECONDITIONS
     BSLS_ASSERT_OPT(g_initialized.testAndSwap(false, true) != true);
@@ -81,7 +82,10 @@ void CountingAllocatorUtil::initGlobalAllocators(
     mwcst::StatContext& stats = g_statContext.object();
 
     new (g_topAllocator.buffer())
-        mwcma::CountingAllocator(topAllocatorName, &stats, alloc);
+        mwcma::CountingAllocator(topAllocatorName,
+                                 &stats,
+                                 sizeClassStats,
+                                 alloc);
 
     // Create the topAllocatorStore and the default and global allocators
     mwcma::CountingAllocator& topAllocator = g_topAllocator.object();
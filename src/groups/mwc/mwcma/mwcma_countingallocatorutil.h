@@ -33,6 +33,7 @@
 // in 'mwcma_countingallocatorstore'.
 
 // MWC
+#include <mwcma_countingallocator.h>
 
 // BDE
 #include <bsl_iosfwd.h>
@@ -68,12 +69,16 @@ struct CountingAllocatorUtil {
     /// `globalStatContextConfiguration` or with the specified
     /// `globalStatContextName` and default configuration.  The default
     /// allocator will have name "Default Allocator", and the global
-    /// allocator will have name "Global Allocator".  This function should
-    /// be called once in `main`.  The behavior is undefined if this
+    /// allocator will have name "Global Allocator".  Optionally specify
+    /// `sizeClassStats` to also report the allocations to the stat value of
+    /// their size class (see `mwcma::CountingAllocator`).  This function
+    /// should be called once in `main`.  The behavior is undefined if this
     /// function is called more than once.
     static void initGlobalAllocators(
-        const mwcst::StatContextConfiguration& globalStatContextConfiguration,
-        const bslstl::StringRef&               topAllocatorName);
+        const mwcst::StatContextConfiguration&  globalStatContextConfiguration,
+        const bslstl::StringRef&                topAllocatorName,
+        CountingAllocator::SizeClassStats::Enum sizeClassStats =
+            CountingAllocator::SizeClassStats::e_DISABLED);
     static void
     initGlobalAllocators(const bslstl::StringRef& globalStatContextName,
                          const bslstl::StringRef& topAllocatorName);
@@ -0,0 +1,307 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// mwcst_histogram.cpp                                                -*-C++-*-
+#include <mwcst_histogram.h>
+
+#include <mwcscm_version.h>
+// BDE
+#include <bsl_algorithm.h>
+#include <bsl_cmath.h>
+#include <bslim_printer.h>
+
+namespace BloombergLP {
+namespace mwcst {
+
+// ---------------
+// class Histogram
+// ---------------
+
+// Force variable/symbol definition so that they can be used in other files
+const int Histogram::k_SUB_BUCKET_BITS;
+const int Histogram::k_NUM_SUB_BUCKETS;
+const int Histogram::k_MAX_VALUE_BITS;
+const int Histogram::k_NUM_BUCKETS;
+
+// CLASS METHODS
+bsls::Types::Int64 Histogram::bucketLowerBound(int index)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(0 <= index && index < k_NUM_BUCKETS);
+
+    if (index < 2 * k_NUM_SUB_BUCKETS) {
+        return index;  // RETURN
+    }
+
+    const int shift = index / k_NUM_SUB_BUCKETS - 1;
+    return static_cast<bsls::Types::Int64>(index - shift * k_NUM_SUB_BUCKETS)
+           << shift;
+}
+
+bsls::Types::Int64 Histogram::bucketUpperBound(int index)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(0 <= index && index < k_NUM_BUCKETS);
+
+    if (index < 2 * k_NUM_SUB_BUCKETS) {
+        return index;  // RETURN
+    }
+
+    const int shift = index / k_NUM_SUB_BUCKETS - 1;
+    return bucketLowerBound(index) +
+           (static_cast<bsls::Types::Int64>(1) << shift) - 1;
+}
+
+void Histogram::merge(Buckets* result, const Buckets& buckets)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(result);
+
+    if (buckets.empty()) {
+        return;  // RETURN
+    }
+
+    if (result->empty()) {
+        *result = buckets;
+        return;  // RETURN
+    }
+
+    Buckets merged(result->get_allocator());
+    merged.reserve(result->size() + buckets.size());
+
+    Buckets::const_iterator lhs = result->begin();
+    Buckets::const_iterator rhs = buckets.begin();
+    while (lhs != result->end() || rhs != buckets.end()) {
+        if (rhs == buckets.end() ||
+            (lhs != result->end() && lhs->d_index < rhs->d_index)) {
+            merged.push_back(*lhs++);
+        }
+        else if (lhs == result->end() || rhs->d_index < lhs->d_index) {
+            merged.push_back(*rhs++);
+        }
+        else {
+            const bsls::Types::Int64 count = lhs->d_count + rhs->d_count;
+            if (count != 0) {
+                merged.push_back(Bucket(lhs->d_index, count));
+            }
+            ++lhs;
+            ++rhs;
+        }
+    }
+
+    result->swap(merged);
+}
+
+bsls::Types::Int64 Histogram::valueAtPercentile(const Buckets& buckets,
+                                                double         percentile)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(0 <= percentile && percentile <= 100);
+
+    bsls::Types::Int64 total = 0;
+    for (Buckets::const_iterator it = buckets.begin(); it != buckets.end();
+         ++it) {
+        if (it->d_count > 0) {
+            total += it->d_count;
+        }
+    }
+
+    if (total == 0) {
+        return 0;  // RETURN
+    }
+
+    // The rank of the value at 'percentile', in '[1, total]'.
+
+    bsls::Types::Int64 rank = static_cast<bsls::Types::Int64>(
+        bsl::ceil(percentile * static_cast<double>(total) / 100.0));
+    rank = bsl::max(rank, static_cast<bsls::Types::Int64>(1));
+    rank = bsl::min(rank, total);
+
+    bsls::Types::Int64 seen = 0;
+    for (Buckets::const_iterator it = buckets.begin(); it != buckets.end();
+         ++it) {
+        if (it->d_count <= 0) {
+            continue;  // CONTINUE
+        }
+
+        seen += it->d_count;
+        if (rank <= seen) {
+            return bucketUpperBound(it->d_index);  // RETURN
+        }
+    }
+
+    BSLS_ASSERT_SAFE(false && "Unreachable by design");
+    return 0;
+}
+
+// CREATORS
+Histogram::Histogram(bslma::Allocator* basicAllocator)
+: d_counts(basicAllocator)
+{
+    // NOTHING
+}
+
+Histogram::Histogram(const Histogram& other, bslma::Allocator* basicAllocator)
+: d_counts(basicAllocator)
+{
+    *this = other;
+}
+
+// MANIPULATORS
+Histogram& Histogram::operator=(const Histogram& rhs)
+{
+    if (this == &rhs) {
+        return *this;  // RETURN
+    }
+
+    if (!rhs.isInitialized()) {
+        release();
+        return *this;  // RETURN
+    }
+
+    init();
+    for (int i = 0; i < k_NUM_BUCKETS; ++i) {
+        bsls::AtomicOperations::setInt64(&d_counts[i], rhs.count(i));
+    }
+
+    return *this;
+}
+
+void Histogram::init()
+{
+    d_counts.resize(k_NUM_BUCKETS);
+    for (int i = 0; i < k_NUM_BUCKETS; ++i) {
+        bsls::AtomicOperations::initInt64(&d_counts[i], 0);
+    }
+}
+
+void Histogram::release()
+{
+    bsl::vector<AtomicCount>(d_counts.get_allocator()).swap(d_counts);
+}
+
+void Histogram::add(const Histogram& other)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(isInitialized());
+
+    if (!other.isInitialized()) {
+        return;  // RETURN
+    }
+
+    for (int i = 0; i < k_NUM_BUCKETS; ++i) {
+        const bsls::Types::Int64 count = other.count(i);
+        if (count != 0) {
+            bsls::AtomicOperations::addInt64(&d_counts[i], count);
+        }
+    }
+}
+
+void Histogram::add(const Buckets& buckets)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(isInitialized());
+
+    for (Buckets::const_iterator it = buckets.begin(); it != buckets.end();
+         ++it) {
+        BSLS_ASSERT_SAFE(0 <= it->d_index && it->d_index < k_NUM_BUCKETS);
+        bsls::AtomicOperations::addInt64(&d_counts[it->d_index],
+                                         it->d_count);
+    }
+}
+
+void Histogram::reset()
+{
+    for (size_t i = 0; i < d_counts.size(); ++i) {
+        bsls::AtomicOperations::setInt64(&d_counts[i], 0);
+    }
+}
+
+// ACCESSORS
+void Histogram::loadBuckets(Buckets* buckets) const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(buckets);
+
+    buckets->clear();
+    for (size_t i = 0; i < d_counts.size(); ++i) {
+        const int                index = static_cast<int>(i);
+        const bsls::Types::Int64 count = this->count(index);
+        if (count != 0) {
+            buckets->push_back(Bucket(index, count));
+        }
+    }
+}
+
+void Histogram::updateSnapshot(Buckets* snapshot, Buckets* changes) const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(snapshot);
+    BSLS_ASSERT_SAFE(changes);
+    BSLS_ASSERT_SAFE(isInitialized());
+
+    Buckets::iterator previous = snapshot->begin();
+    for (int i = 0; i < k_NUM_BUCKETS; ++i) {
+        const bsls::Types::Int64 count = this->count(i);
+
+        bsls::Types::Int64 previousCount = 0;
+        if (previous != snapshot->end() && previous->d_index == i) {
+            previousCount = previous->d_count;
+        }
+
+        if (count != previousCount) {
+            changes->push_back(Bucket(i, count - previousCount));
+        }
+
+        if (previousCount != 0) {
+            if (count != 0) {
+                previous->d_count = count;
+                ++previous;
+            }
+            else {
+                previous = snapshot->erase(previous);
+            }
+        }
+        else if (count != 0) {
+            previous = snapshot->insert(previous, Bucket(i, count)) + 1;
+        }
+    }
+}
+
+bsl::ostream&
+Histogram::print(bsl::ostream& stream, int level, int spacesPerLevel) const
+{
+    if (stream.bad()) {
+        return stream;  // RETURN
+    }
+
+    bslim::Printer printer(&stream, level, spacesPerLevel);
+    printer.start();
+    for (size_t i = 0; i < d_counts.size(); ++i) {
+        const int                index = static_cast<int>(i);
+        const bsls::Types::Int64 count = this->count(index);
+        if (count != 0) {
+            printer.printIndentation();
+            stream << "[" << bucketLowerBound(index) << ", "
+                   << bucketUpperBound(index) << "]: " << count;
+        }
+    }
+    printer.end();
+
+    return stream;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
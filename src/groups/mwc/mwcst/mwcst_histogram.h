@@ -0,0 +1,282 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// mwcst_histogram.h                                                  -*-C++-*-
+#ifndef INCLUDED_MWCST_HISTOGRAM
+#define INCLUDED_MWCST_HISTOGRAM
+
+//@PURPOSE: Provide a mergeable fixed-memory log-linear histogram.
+//
+//@CLASSES:
+// mwcst::Histogram         : log-linear histogram of reported values
+// mwcst::Histogram::Bucket : count of a bucket in a sparse set of buckets
+//
+//@SEE_ALSO:
+//  mwcst_statvalue
+//
+//@DESCRIPTION: This component defines a mechanism, 'mwcst::Histogram', which
+// counts reported values in a fixed set of 'k_NUM_BUCKETS' log-linear buckets,
+// in the spirit of an HDR histogram.  Values below '2 * k_NUM_SUB_BUCKETS' are
+// counted exactly.  Above that, each power of two is split in
+// 'k_NUM_SUB_BUCKETS' buckets of equal width, so that the width of a bucket is
+// less than '1 / k_NUM_SUB_BUCKETS' (about 3%) of the values it counts.
+// Negative values are counted as 0, and values of '2^k_MAX_VALUE_BITS' (about
+// 18 minutes when the values are nanoseconds) or more are counted in the last
+// bucket.
+//
+// The buckets of a histogram are only allocated by 'init', so that an unused
+// histogram costs nothing but its footprint.  Two histograms are merged by
+// adding their counts bucket by bucket.
+//
+// A histogram can also be represented as a sparse set of 'Bucket's, ordered
+// by index, holding only the buckets having a non-zero count.  This is the
+// representation used to keep the history of a histogram, and to compute
+// percentiles.
+//
+/// Thread Safety
+///-------------
+// 'record' is thread-safe.  All other functions are not.
+
+// BDE
+#include <bdlb_bitutil.h>
+#include <bsl_cstdint.h>
+#include <bsl_ostream.h>
+#include <bsl_vector.h>
+#include <bslma_allocator.h>
+#include <bslma_usesbslmaallocator.h>
+#include <bslmf_nestedtraitdeclaration.h>
+#include <bsls_assert.h>
+#include <bsls_atomicoperations.h>
+#include <bsls_types.h>
+
+namespace BloombergLP {
+namespace mwcst {
+
+// ===============
+// class Histogram
+// ===============
+
+/// Mergeable fixed-memory log-linear histogram.
+class Histogram {
+  public:
+    // PUBLIC TYPES
+
+    /// Count of the bucket at a given index, in a sparse set of buckets.
+    struct Bucket {
+        // DATA
+        int d_index;
+
+        bsls::Types::Int64 d_count;
+
+        // CREATORS
+        Bucket(int index, bsls::Types::Int64 count);
+    };
+
+    /// Sparse set of buckets, ordered by index.
+    typedef bsl::vector<Bucket> Buckets;
+
+    // PUBLIC CONSTANTS
+
+    /// Log2 of the number of buckets each power of two is split in.
+    static const int k_SUB_BUCKET_BITS = 5;
+
+    /// Number of buckets each power of two is split in.
+    static const int k_NUM_SUB_BUCKETS = 1 << k_SUB_BUCKET_BITS;
+
+    /// Number of bits of the largest value counted in its own bucket.
+    static const int k_MAX_VALUE_BITS = 40;
+
+    /// Number of buckets of a histogram.
+    static const int k_NUM_BUCKETS =
+        (k_MAX_VALUE_BITS - k_SUB_BUCKET_BITS + 1) * k_NUM_SUB_BUCKETS;
+
+  private:
+    // PRIVATE TYPES
+    typedef bsls::AtomicOperations::AtomicTypes::Int64 AtomicCount;
+
+    // DATA
+    bsl::vector<AtomicCount> d_counts;
+    // Count of each bucket, or empty if this histogram is not initialized.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(Histogram, bslma::UsesBslmaAllocator)
+
+    // CLASS METHODS
+
+    /// Return the index of the bucket counting the specified `value`.
+    static int bucketIndex(bsls::Types::Int64 value);
+
+    /// Return the lowest value counted by the bucket at the specified
+    /// `index`.  The behavior is undefined unless
+    /// `0 <= index < k_NUM_BUCKETS`.
+    static bsls::Types::Int64 bucketLowerBound(int index);
+
+    /// Return the highest value counted by the bucket at the specified
+    /// `index`.  The behavior is undefined unless
+    /// `0 <= index < k_NUM_BUCKETS`.
+    static bsls::Types::Int64 bucketUpperBound(int index);
+
+    /// Add the counts of the specified `buckets` to the specified `result`.
+    static void merge(Buckets* result, const Buckets& buckets);
+
+    /// Return the highest value counted by the bucket holding the value at
+    /// the specified `percentile` of the values counted by the specified
+    /// `buckets`, or 0 if `buckets` counts no value.  Buckets having a
+    /// negative count are ignored.  The behavior is undefined unless
+    /// `0 <= percentile <= 100`.
+    static bsls::Types::Int64 valueAtPercentile(const Buckets& buckets,
+                                                double         percentile);
+
+    // CREATORS
+
+    /// Create an uninitialized histogram, using the optionally specified
+    /// `basicAllocator` to supply memory.
+    explicit Histogram(bslma::Allocator* basicAllocator = 0);
+
+    /// Create a histogram having the same counts as the specified `other`,
+    /// using the optionally specified `basicAllocator` to supply memory.
+    Histogram(const Histogram& other, bslma::Allocator* basicAllocator = 0);
+
+    // MANIPULATORS
+    Histogram& operator=(const Histogram& rhs);
+
+    /// Allocate the buckets of this histogram, if not already done, and set
+    /// their counts to 0.
+    void init();
+
+    /// Release the buckets of this histogram, leaving it uninitialized.
+    void release();
+
+    /// Count the specified `value` in this histogram.  The behavior is
+    /// undefined unless this histogram is initialized.
+    void record(bsls::Types::Int64 value);
+
+    /// Add the counts of the specified `other` histogram to this histogram.
+    /// This method has no effect if `other` is not initialized.  The
+    /// behavior is undefined unless this histogram is initialized.
+    void add(const Histogram& other);
+
+    /// Add the counts of the specified `buckets` to this histogram.  The
+    /// behavior is undefined unless this histogram is initialized.
+    void add(const Buckets& buckets);
+
+    /// Set the count of each bucket of this histogram to 0.  This method
+    /// has no effect if this histogram is not initialized.
+    void reset();
+
+    // ACCESSORS
+
+    /// Return true if this histogram is initialized.
+    bool isInitialized() const;
+
+    /// Return the count of the bucket at the specified `index`.  The
+    /// behavior is undefined unless this histogram is initialized and
+    /// `0 <= index < k_NUM_BUCKETS`.
+    bsls::Types::Int64 count(int index) const;
+
+    /// Load into the specified `buckets` the buckets of this histogram
+    /// having a non-zero count.
+    void loadBuckets(Buckets* buckets) const;
+
+    /// Load into the specified `snapshot`, which holds the buckets of an
+    /// earlier snapshot of this histogram, the buckets of this histogram
+    /// having a non-zero count, and append to the specified `changes`, in
+    /// order, the buckets whose count changed since the earlier snapshot
+    /// along with the difference.  The behavior is undefined unless this
+    /// histogram is initialized.
+    void updateSnapshot(Buckets* snapshot, Buckets* changes) const;
+
+    /// Format this object to the specified output `stream` at the (absolute
+    /// value of) the optionally specified indentation `level` and return a
+    /// reference to `stream`.  If `level` is specified, optionally specify
+    /// `spacesPerLevel`, the number of spaces per indentation level for
+    /// this and all of its nested objects.  If `level` is negative,
+    /// suppress indentation of the first line.  If `spacesPerLevel` is
+    /// negative format the entire output on one line, suppressing all but
+    /// the initial indentation (as governed by `level`).  If `stream` is
+    /// not valid on entry, this operation has no effect.
+    bsl::ostream&
+    print(bsl::ostream& stream, int level = 0, int spacesPerLevel = 4) const;
+};
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+// ------------------------
+// struct Histogram::Bucket
+// ------------------------
+
+// CREATORS
+inline Histogram::Bucket::Bucket(int index, bsls::Types::Int64 count)
+: d_index(index)
+, d_count(count)
+{
+    // NOTHING
+}
+
+// ---------------
+// class Histogram
+// ---------------
+
+// CLASS METHODS
+inline int Histogram::bucketIndex(bsls::Types::Int64 value)
+{
+    if (value < 2 * k_NUM_SUB_BUCKETS) {
+        return value < 0 ? 0 : static_cast<int>(value);  // RETURN
+    }
+
+    if ((value >> k_MAX_VALUE_BITS) != 0) {
+        return k_NUM_BUCKETS - 1;  // RETURN
+    }
+
+    // 'value >> shift' is in '[k_NUM_SUB_BUCKETS, 2 * k_NUM_SUB_BUCKETS)'.
+
+    const int msb = 63 - bdlb::BitUtil::numLeadingUnsetBits(
+                             static_cast<bsl::uint64_t>(value));
+    const int shift = msb - k_SUB_BUCKET_BITS;
+
+    return shift * k_NUM_SUB_BUCKETS + static_cast<int>(value >> shift);
+}
+
+// MANIPULATORS
+inline void Histogram::record(bsls::Types::Int64 value)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(isInitialized());
+
+    bsls::AtomicOperations::addInt64(&d_counts[bucketIndex(value)], 1);
+}
+
+// ACCESSORS
+inline bool Histogram::isInitialized() const
+{
+    return !d_counts.empty();
+}
+
+inline bsls::Types::Int64 Histogram::count(int index) const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(isInitialized());
+    BSLS_ASSERT_SAFE(0 <= index && index < k_NUM_BUCKETS);
+
+    return bsls::AtomicOperations::getInt64(&d_counts[index]);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
@@ -0,0 +1,240 @@
+// Copyright 2023 Bloomberg Finance L.P.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// mwcst_histogram.t.cpp                                              -*-C++-*-
+#include <mwcst_histogram.h>
+
+// BDE
+#include <bsl_limits.h>
+#include <bsls_types.h>
+
+// TEST DRIVER
+#include <mwctst_testhelper.h>
+
+// CONVENIENCE
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                                    TESTS
+// ----------------------------------------------------------------------------
+
+static void test1_breathingTest()
+// ------------------------------------------------------------------------
+// BREATHING TEST
+//
+// Testing:
+//   Recording values in a 'mwcst::Histogram', and resetting it.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("BREATHING TEST");
+
+    mwcst::Histogram obj(s_allocator_p);
+    ASSERT(!obj.isInitialized());
+
+    obj.init();
+    ASSERT(obj.isInitialized());
+
+    obj.record(10);
+    obj.record(10);
+    obj.record(-5);
+    obj.record(1000);
+    ASSERT_EQ(obj.count(10), 2);
+    ASSERT_EQ(obj.count(0), 1);
+    ASSERT_EQ(obj.count(mwcst::Histogram::bucketIndex(1000)), 1);
+
+    mwcst::Histogram::Buckets buckets(s_allocator_p);
+    obj.loadBuckets(&buckets);
+    ASSERT_EQ(buckets.size(), 3U);
+    ASSERT_EQ(buckets[0].d_index, 0);
+    ASSERT_EQ(buckets[1].d_index, 10);
+    ASSERT_EQ(buckets[1].d_count, 2);
+
+    mwcst::Histogram copy(obj, s_allocator_p);
+    ASSERT_EQ(copy.count(10), 2);
+
+    obj.reset();
+    ASSERT(obj.isInitialized());
+    ASSERT_EQ(obj.count(10), 0);
+    ASSERT_EQ(copy.count(10), 2);
+
+    obj.release();
+    ASSERT(!obj.isInitialized());
+}
+
+static void test2_buckets()
+// ------------------------------------------------------------------------
+// BUCKETS
+//
+// Concerns:
+//   - Small values are counted exactly.
+//   - Buckets are contiguous, and each value is in the bounds of its
+//     bucket.
+//   - The width of a bucket is less than 1 / k_NUM_SUB_BUCKETS of its
+//     values.
+//   - Out of range values are counted in the first and last buckets.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("BUCKETS");
+
+    typedef mwcst::Histogram Obj;
+
+    for (int i = 0; i < 2 * Obj::k_NUM_SUB_BUCKETS; ++i) {
+        ASSERT_EQ_D(i, Obj::bucketIndex(i), i);
+        ASSERT_EQ_D(i, Obj::bucketLowerBound(i), i);
+        ASSERT_EQ_D(i, Obj::bucketUpperBound(i), i);
+    }
+
+    for (int i = 1; i < Obj::k_NUM_BUCKETS; ++i) {
+        const bsls::Types::Int64 lower = Obj::bucketLowerBound(i);
+        const bsls::Types::Int64 upper = Obj::bucketUpperBound(i);
+
+        ASSERT_EQ_D(i, lower, Obj::bucketUpperBound(i - 1) + 1);
+        ASSERT_EQ_D(i, Obj::bucketIndex(lower), i);
+        ASSERT_EQ_D(i, Obj::bucketIndex(upper), i);
+        ASSERT_LT_D(i, (upper - lower) * Obj::k_NUM_SUB_BUCKETS, lower);
+    }
+
+    const bsls::Types::Int64 maxValue = (static_cast<bsls::Types::Int64>(1)
+                                         << Obj::k_MAX_VALUE_BITS) -
+                                        1;
+    ASSERT_EQ(Obj::bucketUpperBound(Obj::k_NUM_BUCKETS - 1), maxValue);
+    ASSERT_EQ(Obj::bucketIndex(maxValue + 1), Obj::k_NUM_BUCKETS - 1);
+    ASSERT_EQ(
+        Obj::bucketIndex(bsl::numeric_limits<bsls::Types::Int64>::max()),
+        Obj::k_NUM_BUCKETS - 1);
+    ASSERT_EQ(
+        Obj::bucketIndex(bsl::numeric_limits<bsls::Types::Int64>::min()),
+        0);
+}
+
+static void test3_mergeAndPercentiles()
+// ------------------------------------------------------------------------
+// MERGE AND PERCENTILES
+//
+// Concerns:
+//   - Merging sparse sets of buckets adds the counts of the buckets having
+//     the same index, and drops the buckets whose count becomes 0.
+//   - 'updateSnapshot' loads the changes since the previous snapshot, and
+//     replaying these changes leads to the histogram.
+//   - 'valueAtPercentile' returns the highest value of the bucket holding
+//     the requested rank, and 0 if no value is counted.
+// ------------------------------------------------------------------------
+{
+    mwctst::TestHelper::printTestName("MERGE AND PERCENTILES");
+
+    typedef mwcst::Histogram Obj;
+
+    Obj::Buckets empty(s_allocator_p);
+    ASSERT_EQ(Obj::valueAtPercentile(empty, 50), 0);
+
+    PV("Merge");
+    {
+        Obj::Buckets lhs(s_allocator_p);
+        Obj::Buckets rhs(s_allocator_p);
+        lhs.push_back(Obj::Bucket(1, 2));
+        lhs.push_back(Obj::Bucket(5, 1));
+        rhs.push_back(Obj::Bucket(3, 4));
+        rhs.push_back(Obj::Bucket(5, -1));
+        rhs.push_back(Obj::Bucket(7, 1));
+
+        Obj::merge(&lhs, rhs);
+        ASSERT_EQ(lhs.size(), 3U);
+        ASSERT_EQ(lhs[0].d_index, 1);
+        ASSERT_EQ(lhs[1].d_index, 3);
+        ASSERT_EQ(lhs[1].d_count, 4);
+        ASSERT_EQ(lhs[2].d_index, 7);
+
+        Obj::merge(&empty, lhs);
+        ASSERT_EQ(empty.size(), 3U);
+        empty.clear();
+    }
+
+    PV("Snapshots");
+    Obj obj(s_allocator_p);
+    obj.init();
+
+    Obj::Buckets snapshot(s_allocator_p);
+    Obj::Buckets changes(s_allocator_p);
+    Obj::Buckets replayed(s_allocator_p);
+
+    for (int i = 1; i <= 100; ++i) {
+        obj.record(i);
+    }
+    obj.updateSnapshot(&snapshot, &changes);
+    ASSERT_EQ(snapshot.size(), changes.size());
+    Obj::merge(&replayed, changes);
+
+    changes.clear();
+    obj.updateSnapshot(&snapshot, &changes);
+    ASSERT(changes.empty());
+
+    obj.record(1000);
+    obj.record(50);
+    obj.updateSnapshot(&snapshot, &changes);
+    ASSERT_EQ(changes.size(), 2U);
+    ASSERT_EQ(changes[0].d_index, 50);
+    ASSERT_EQ(changes[0].d_count, 1);
+    Obj::merge(&replayed, changes);
+
+    Obj::Buckets expected(s_allocator_p);
+    obj.loadBuckets(&expected);
+    ASSERT_EQ(replayed.size(), expected.size());
+    ASSERT_EQ(snapshot.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ_D(i, replayed[i].d_index, expected[i].d_index);
+        ASSERT_EQ_D(i, replayed[i].d_count, expected[i].d_count);
+        ASSERT_EQ_D(i, snapshot[i].d_index, expected[i].d_index);
+        ASSERT_EQ_D(i, snapshot[i].d_count, expected[i].d_count);
+    }
+
+    obj.reset();
+    changes.clear();
+    obj.updateSnapshot(&snapshot, &changes);
+    ASSERT(snapshot.empty());
+    ASSERT_EQ(changes.size(), expected.size());
+    ASSERT_EQ(changes[0].d_count, -expected[0].d_count);
+
+    PV("Percentiles");
+
+    // 'expected' counts 1 to 100, 50 twice, and 1000.
+
+    ASSERT_EQ(Obj::valueAtPercentile(expected, 0), 1);
+    ASSERT_EQ(Obj::valueAtPercentile(expected, 50), 50);
+    ASSERT_EQ(Obj::valueAtPercentile(expected, 99), 101);
+    ASSERT_EQ(Obj::valueAtPercentile(expected, 100), 1007);
+}
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    TEST_PROLOG(mwctst::TestHelper::e_DEFAULT);
+
+    switch (_testCase) {
+    case 0:
+    case 3: test3_mergeAndPercentiles(); break;
+    case 2: test2_buckets(); break;
+    case 1: test1_breathingTest(); break;
+    default: {
+        cerr << "WARNING: CASE '" << _testCase << "' NOT FOUND." << endl;
+        s_testStatus = -1;
+    } break;
+    }
+
+    TEST_EPILOG(mwctst::TestHelper::e_CHECK_DEF_GBL_ALLOC);
+}
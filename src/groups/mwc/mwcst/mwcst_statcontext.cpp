@@ -103,6 +103,36 @@ void clearStats(bsl::vector<StatValue>* values)
     }
 }
 
+/// Return `true` if the latest snapshot of each of the specified `values`
+/// is idle (see `StatValue::isIdle`), or if `values` is 0, and `false`
+/// otherwise.
+bool isIdle(const bsl::vector<StatValue>* values)
+{
+    if (values) {
+        for (size_t i = 0; i < values->size(); ++i) {
+            if (!(*values)[i].isIdle()) {
+                return false;  // RETURN
+            }
+        }
+    }
+
+    return true;
+}
+
+/// Take the specified `numSnapshots` idle snapshots of each of the
+/// specified `values`, if `values` is non-zero, at the times of the
+/// corresponding snapshots of the specified `schedule`.
+void takeIdleSnapshots(bsl::vector<StatValue>*       values,
+                       const bsl::vector<StatValue>& schedule,
+                       int                           numSnapshots)
+{
+    if (values) {
+        for (size_t i = 0; i < values->size(); ++i) {
+            (*values)[i].takeIdleSnapshots(numSnapshots, schedule[i]);
+        }
+    }
+}
+
 /// Load into the specified `updates` corresponding updates from the
 /// specified `values` vector based on the specified `mask`, if `values` is
 /// non-zero, and do nothing otherwise.  If the specified `full` is `true`,
@@ -132,6 +162,15 @@ loadUpdatesFromValues(bsl::vector<mwcstm::StatValueUpdate>* updates,
     }
 }
 
+/// Clear each of the specified `updates`, so that it does not hold any
+/// field.
+static void clearUpdates(bsl::vector<mwcstm::StatValueUpdate>* updates)
+{
+    for (bsl::size_t i = 0; i < updates->size(); ++i) {
+        updates->at(i).reset();
+    }
+}
+
 /// Return the offset between epoch time and the system timer.
 static bsls::Types::Int64 epochOffset()
 {
@@ -183,7 +222,9 @@ void StatContext::datumDeleter(void* /*datum_vp*/, void* datumLock_vp)
 }
 
 // PRIVATE MANIPULATORS
-void StatContext::initValues(ValueVecPtr& vec, bsls::Types::Int64 initTime)
+void StatContext::initValues(ValueVecPtr&       vec,
+                             bsls::Types::Int64 initTime,
+                             bool               useShards)
 {
     if (!d_valueDefs_p) {
         return;
@@ -193,9 +234,11 @@ void StatContext::initValues(ValueVecPtr& vec, bsls::Types::Int64 initTime)
 
     newVec->resize(d_valueDefs_p->size());
     for (size_t vIdx = 0; vIdx < d_valueDefs_p->size(); ++vIdx) {
-        (*newVec)[vIdx].init((*d_valueDefs_p)[vIdx].d_sizes,
-                             (*d_valueDefs_p)[vIdx].d_type,
-                             initTime);
+        const ValueDefinition& def = (*d_valueDefs_p)[vIdx];
+        (*newVec)[vIdx].init(def.d_sizes,
+                             def.d_type,
+                             initTime,
+                             useShards ? def.d_numShards : 0);
     }
 
     vec.load(newVec, d_valueVecPool_p.get());
@@ -204,6 +247,12 @@ void StatContext::initValues(ValueVecPtr& vec, bsls::Types::Int64 initTime)
 void StatContext::clearDeletedSubcontexts(
     bsl::vector<ValueVec*>* expiredValuesVec)
 {
+    if (!d_deletedSubcontexts.empty()) {
+        // Our expired values, and the totals of our subcontexts, change.
+
+        d_isUpdated = true;
+    }
+
     for (StatContextVector::iterator iter = d_deletedSubcontexts.begin();
          iter != d_deletedSubcontexts.end();
          ++iter) {
@@ -295,11 +344,13 @@ StatContext::ValueVec* StatContext::getTotalValuesVec()
     }
 }
 
-void StatContext::snapshotSubcontext(StatContext*       subcontext,
+bool StatContext::snapshotSubcontext(StatContext*       subcontext,
                                      bsls::Types::Int64 snapshotTime)
 {
     if (subcontext->d_numSnapshots == 0 && d_isTable && d_directValues_p) {
-        // Sync the child context's values' snapshotSchedules with ours.
+        // Sync the child context's values' snapshotSchedules with ours, once
+        // ours are up to date.
+        takeSkippedSnapshots();
         syncValues(subcontext->d_totalValues_p.ptr(), *d_directValues_p);
         syncValues(subcontext->d_activeChildrenTotalValues_p.ptr(),
                    *d_directValues_p);
@@ -307,22 +358,84 @@ void StatContext::snapshotSubcontext(StatContext*       subcontext,
         syncValues(subcontext->d_expiredValues_p.ptr(), *d_directValues_p);
     }
 
-    subcontext->snapshotImp(snapshotTime);
+    return subcontext->snapshotImp(snapshotTime);
+}
 
+void StatContext::addSubcontextValues(const StatContext& subcontext)
+{
     // Don't just add the subcontext's total values because that will include
     // their expired children too, if it's keeping track of them
     addValues(d_activeChildrenTotalValues_p.ptr(),
-              subcontext->d_directValues_p.ptr());
+              subcontext.d_directValues_p.ptr());
     addValues(d_activeChildrenTotalValues_p.ptr(),
-              subcontext->d_activeChildrenTotalValues_p.ptr());
+              subcontext.d_activeChildrenTotalValues_p.ptr());
 }
 
-void StatContext::snapshotImp(bsls::Types::Int64 snapshotTime)
+bool StatContext::snapshotImp(bsls::Types::Int64 snapshotTime)
 {
     if (d_preSnapshotCallback) {
         d_preSnapshotCallback(*this);
     }
 
+    const bool isUpdated = d_isUpdated.load() && d_isUpdated.swap(false);
+    if (isUpdated) {
+        moveNewSubcontexts();
+    }
+
+    // Snapshot all subcontexts, remembering if any of them was actually
+    // snapshotted, in which case our children's total must be computed
+    // again.
+
+    bool isSubcontextSnapshotted = !d_deletedSubcontexts.empty();
+    for (StatContextVector::iterator iter = d_deletedSubcontexts.begin();
+         iter != d_deletedSubcontexts.end();
+         ++iter) {
+        snapshotSubcontext(*iter, snapshotTime);
+    }
+
+    for (StatContextMap::iterator iter = d_subcontexts.begin();
+         iter != d_subcontexts.end();
+         /*nothing*/) {
+        if (snapshotSubcontext(iter->second, snapshotTime)) {
+            isSubcontextSnapshotted = true;
+        }
+
+        if (iter->second->isDeleted()) {
+            isSubcontextSnapshotted = true;
+            d_deletedSubcontexts.push_back(iter->second);
+            mwcstm::StatContextUpdate* update = iter->second->d_update_p;
+            if (update) {
+                update->flags() = bdlb::BitUtil::withBitSet(
+                    update->flags(),
+                    mwcstm::StatContextUpdateFlags::DMCSTM_CONTEXT_DELETED);
+            }
+            d_subcontexts.erase(iter++);
+        }
+        else {
+            ++iter;
+        }
+    }
+
+    if (!isUpdated && !isSubcontextSnapshotted && d_isIdle) {
+        // Nothing changed since our latest snapshot, which this snapshot
+        // would only repeat.  Skip it: it is taken, with the other skipped
+        // snapshots, when our values are read.
+
+        if (d_update_p) {
+            d_update_p->timeStamp() = convertToEpoch(snapshotTime);
+            if (0 == d_numSkippedSnapshots) {
+                clearUpdates(&d_update_p->directValues());
+                clearUpdates(&d_update_p->expiredValues());
+            }
+        }
+
+        ++d_numSkippedSnapshots;
+        ++d_numSnapshots;
+        return false;  // RETURN
+    }
+
+    takeSkippedSnapshots();
+
     if (d_update_p) {
         // Update the timestamp, and clear our configuration and created flag
         // if this is our second snapshot.
@@ -336,8 +449,6 @@ void StatContext::snapshotImp(bsls::Types::Int64 snapshotTime)
         }
     }
 
-    moveNewSubcontexts();
-
     if (d_isTable && !d_subcontexts.empty() &&
         !d_activeChildrenTotalValues_p && d_directValues_p) {
         // Initialize 'd_activeChildrenTotalValues_p' if we have subtables
@@ -345,34 +456,18 @@ void StatContext::snapshotImp(bsls::Types::Int64 snapshotTime)
         syncValues(d_activeChildrenTotalValues_p.ptr(), *d_directValues_p);
     }
 
+    // If we're a table, add all subcontexts to our children's total
     clearStats(d_activeChildrenTotalValues_p.ptr());
-
-    // Snapshot all subcontexts and, if we're a table, add them to our
-    // children's total
     for (StatContextVector::iterator iter = d_deletedSubcontexts.begin();
          iter != d_deletedSubcontexts.end();
          ++iter) {
-        snapshotSubcontext(*iter, snapshotTime);
+        addSubcontextValues(**iter);
     }
 
     for (StatContextMap::iterator iter = d_subcontexts.begin();
          iter != d_subcontexts.end();
-         /*nothing*/) {
-        snapshotSubcontext(iter->second, snapshotTime);
-
-        if (iter->second->isDeleted()) {
-            d_deletedSubcontexts.push_back(iter->second);
-            mwcstm::StatContextUpdate* update = iter->second->d_update_p;
-            if (update) {
-                update->flags() = bdlb::BitUtil::withBitSet(
-                    update->flags(),
-                    mwcstm::StatContextUpdateFlags::DMCSTM_CONTEXT_DELETED);
-            }
-            d_subcontexts.erase(iter++);
-        }
-        else {
-            ++iter;
-        }
+         ++iter) {
+        addSubcontextValues(*iter->second);
     }
 
     snapshotValueVec(d_activeChildrenTotalValues_p.ptr(), snapshotTime);
@@ -414,12 +509,55 @@ void StatContext::snapshotImp(bsls::Types::Int64 snapshotTime)
 
     ++d_numSnapshots;
 
+    // Our next snapshots may be skipped if this one is idle, and if they can
+    // be taken later at the times of our parent's snapshots.  They can't be
+    // skipped if we have to call back the user on each snapshot, or before
+    // our second snapshot clears the configuration of our update.
+
+    d_isIdle = d_parent_p && d_parent_p->d_isTable &&
+               d_parent_p->d_directValues_p && 1 < d_numSnapshots &&
+               !d_preSnapshotCallback && !d_userData_p &&
+               isIdle(d_directValues_p.ptr()) &&
+               isIdle(d_activeChildrenTotalValues_p.ptr()) &&
+               isIdle(d_expiredValues_p.ptr()) &&
+               isIdle(d_totalValues_p.ptr());
+
     // Snapshot the user data.  This must happen last so that the user data may
     // trigger a read from the latest snapshot of data in this context.
 
     if (d_userData_p) {
         d_userData_p->snapshot();
     }
+
+    return true;
+}
+
+void StatContext::takeSkippedSnapshots() const
+{
+    if (0 == d_numSkippedSnapshots) {
+        return;  // RETURN
+    }
+
+    // Our snapshots were skipped only if they are taken at the times of the
+    // snapshots of our parent's direct values, which may have been skipped
+    // too.
+
+    BSLS_ASSERT(d_parent_p && d_parent_p->d_directValues_p);
+    d_parent_p->takeSkippedSnapshots();
+
+    const ValueVec& schedule = *d_parent_p->d_directValues_p;
+    takeIdleSnapshots(d_totalValues_p.ptr(), schedule, d_numSkippedSnapshots);
+    takeIdleSnapshots(d_activeChildrenTotalValues_p.ptr(),
+                      schedule,
+                      d_numSkippedSnapshots);
+    takeIdleSnapshots(d_directValues_p.ptr(),
+                      schedule,
+                      d_numSkippedSnapshots);
+    takeIdleSnapshots(d_expiredValues_p.ptr(),
+                      schedule,
+                      d_numSkippedSnapshots);
+
+    d_numSkippedSnapshots = 0;
 }
 
 void StatContext::cleanupImp(bsl::vector<ValueVec*>* expiredValuesVec)
@@ -427,6 +565,7 @@ void StatContext::cleanupImp(bsl::vector<ValueVec*>* expiredValuesVec)
     // Only store expired values if we're a table.  Wouldn't make sense
     // otherwise
     if (d_isTable && d_storeExpiredValues && !d_expiredValues_p) {
+        takeSkippedSnapshots();
         initValues(d_expiredValues_p);
         syncValues(d_expiredValues_p.ptr(), *d_directValues_p);
     }
@@ -455,6 +594,8 @@ void StatContext::applyUpdate(const mwcstm::StatContextUpdate& update)
 {
     // Apply the update to all of our values.
 
+    d_isUpdated = true;
+
     BSLS_ASSERT(update.directValues().size() == d_directValues_p->size());
     bsl::size_t numValues = bsl::min(d_directValues_p->size(),
                                      update.directValues().size());
@@ -530,6 +671,10 @@ StatContext::StatContext(const Config&     config,
                         basicAllocator,
                         config.d_preSnapshotCallback)
 , d_numSnapshots(0)
+, d_parent_p(0)
+, d_isUpdated(false)
+, d_isIdle(false)
+, d_numSkippedSnapshots(0)
 , d_update_p(config.d_updateCollector_p)
 , d_updateValueFieldMask(config.d_updateValueFieldMask)
 , d_statValueAllocator_p(config.d_statValueAllocator_p)
@@ -553,7 +698,7 @@ StatContext::StatContext(const Config&     config,
             }
         }
 
-        initValues(d_directValues_p, bsls::TimeUtil::getTimer());
+        initValues(d_directValues_p, bsls::TimeUtil::getTimer(), true);
     }
 
     if (config.d_update_p) {
@@ -604,7 +749,7 @@ bslma::ManagedPtr<StatContext> StatContext::addSubcontext(const Config& config)
         newContext->d_valueVecPool_p = d_valueVecPool_p;
 
         newContext->d_valueDefs_p = d_valueDefs_p;
-        newContext->initValues(newContext->d_directValues_p);
+        newContext->initValues(newContext->d_directValues_p, 0, true);
     }
     else {
         newConfig.d_statValueAllocator_p = d_statValueAllocator_p;
@@ -624,6 +769,7 @@ bslma::ManagedPtr<StatContext> StatContext::addSubcontext(const Config& config)
     if (0 == newContext->d_uniqueId) {
         newContext->d_uniqueId = (*d_nextSubcontextId_p)++;
     }
+    newContext->d_parent_p = this;
 
     bslma::ManagedPtr<StatContext> ret(newContext,
                                        d_allocator_p,
@@ -632,6 +778,9 @@ bslma::ManagedPtr<StatContext> StatContext::addSubcontext(const Config& config)
     bslmt::LockGuard<bslmt::Mutex> guard(&d_newSubcontextsLock);  // LOCK
     d_newSubcontexts.push_back(newContext);
 
+    // Flag the new subcontext only once it can be found by our next snapshot.
+    d_isUpdated = true;
+
     return ret;
 }
 
@@ -650,6 +799,9 @@ void StatContext::cleanup()
 
 void StatContext::clearValues()
 {
+    d_isIdle              = false;
+    d_numSkippedSnapshots = 0;
+
     moveNewSubcontexts();
     for (StatContextMap::iterator iter = d_subcontexts.begin();
          iter != d_subcontexts.end();
@@ -695,6 +847,12 @@ void StatContext::clearSubcontexts()
     for (StatContextMap::iterator iter = d_subcontexts.begin();
          iter != d_subcontexts.end();
          ++iter) {
+        // The subcontext may outlive us, so take its skipped snapshots while
+        // we can provide their times.
+
+        iter->second->takeSkippedSnapshots();
+        iter->second->d_parent_p = 0;
+
         if (iter->second->d_released.swap(true)) {
             // Subcontext has no external references, so we can safely delete
             // it.
@@ -703,6 +861,7 @@ void StatContext::clearSubcontexts()
         }
     }
     d_subcontexts.clear();
+    d_isUpdated = true;
 
     // If we're tracking updates, clearing the deleted subcontexts will try to
     // clean out the list in the update.  Since we're just clearing out
@@ -784,6 +943,7 @@ void StatContext::initializeUpdate(mwcstm::StatContextUpdate* update) const
 void StatContext::loadFullUpdate(mwcstm::StatContextUpdate* update,
                                  int valueFieldMask) const
 {
+    takeSkippedSnapshots();
     initializeUpdate(update);
 
     if (d_directValues_p) {
@@ -97,6 +97,26 @@
 // 'reportValue', and 'setValue' are thread-safe.  All other functions should
 // be considered not thread safe.
 //
+// A value which is updated by many threads concurrently, in the same context,
+// can be sharded using 'StatContextConfiguration::valueShards', so that the
+// updating threads do not all contend on the same cache line.  The shards are
+// only collected when the context is snapshotted.
+//
+/// Idle Subcontexts
+///----------------
+// Snapshotting a subcontext of a table which was not updated since its
+// previous snapshot, and whose previous snapshot recorded no change, would
+// only repeat that snapshot.  Such a snapshot is skipped, unless a
+// subcontext of the subcontext was snapshotted, so that the cost of
+// 'snapshot' mostly grows with the number of updated contexts.  The skipped
+// snapshots are counted, and taken, at once and at the times of the
+// corresponding snapshots of the parent table, when a value of the
+// subcontext is read through 'value' or 'loadFullUpdate', or when the
+// subcontext is snapshotted again.  Note that this is not observable, except
+// that the subcontexts are still visited on each snapshot, and that the
+// snapshots of contexts having a pre-snapshot callback or user data are never
+// skipped.
+//
 /// Intended Usage Pattern
 ///----------------------
 // The easiest way to use a 'StatContext' to collect statistics for an
@@ -553,6 +573,7 @@ class StatContext {
         bsl::string      d_name;
         bsl::vector<int> d_sizes;
         StatValue::Type  d_type;
+        int              d_numShards;
 
         // TRAITS
         BSLMF_NESTED_TRAIT_DECLARATION(ValueDefinition,
@@ -563,6 +584,7 @@ class StatContext {
         : d_name(basicAllocator)
         , d_sizes(basicAllocator)
         , d_type(StatValue::DMCST_CONTINUOUS)
+        , d_numShards(0)
         {
         }
 
@@ -571,6 +593,7 @@ class StatContext {
         : d_name(other.d_name, basicAllocator)
         , d_sizes(other.d_sizes, basicAllocator)
         , d_type(other.d_type)
+        , d_numShards(other.d_numShards)
         {
         }
     };
@@ -656,6 +679,22 @@ class StatContext {
                                         // 'StatContext' had
                                         // 'snapshot' called on it
 
+    // parent of this context, or 0 if this context is not a subcontext or
+    // was released by its parent
+    const StatContext* d_parent_p;
+
+    // `true` if a value of this context was updated, or a subcontext was
+    // added or cleaned up, since its latest snapshot
+    bsls::AtomicBool d_isUpdated;
+
+    // `true` if the latest snapshot taken of this context is idle, so that
+    // its next snapshots may be skipped until it is updated
+    bool d_isIdle;
+
+    // number of snapshots skipped since the latest snapshot taken of this
+    // context, to be taken before its values are read
+    mutable int d_numSkippedSnapshots;
+
     // holds the update between the last two snapshots (not owned)
     mwcstm::StatContextUpdate* d_update_p;
 
@@ -673,8 +712,13 @@ class StatContext {
 
     // PRIVATE MANIPULATORS
 
-    /// Initialize the specified `vec` using `d_valueDefs_p`
-    void initValues(ValueVecPtr& vec, bsls::Types::Int64 initTime = 0);
+    /// Initialize the specified `vec` using `d_valueDefs_p`, with the
+    /// optionally specified `initTime`.  If the optionally specified
+    /// `useShards` is `true`, the values are sharded as defined in
+    /// `d_valueDefs_p`.
+    void initValues(ValueVecPtr&       vec,
+                    bsls::Types::Int64 initTime  = 0,
+                    bool               useShards = false);
 
     /// Delete everything in `d_deletedSubcontexts`
     void clearDeletedSubcontexts(bsl::vector<ValueVec*>* expiredValuesVec);
@@ -682,16 +726,27 @@ class StatContext {
     /// Move the subcontexts in `d_newSubcontexts` into `d_subcontexts`.
     void moveNewSubcontexts();
 
+    /// Flag this context as updated since its latest snapshot.
+    void markUpdated();
+
     /// Return the value vector containing the `total` values of this
     /// StatContext.
     ValueVec* getTotalValuesVec();
 
-    /// Snapshot the specified `subcontext`
-    void snapshotSubcontext(StatContext*       subcontext,
+    /// Snapshot the specified `subcontext`, and return `true` if its
+    /// snapshot was taken, or `false` if it was skipped.
+    bool snapshotSubcontext(StatContext*       subcontext,
                             bsls::Types::Int64 snapshotTime);
 
-    /// Snapshot all values of all subcontexts.
-    void snapshotImp(bsls::Types::Int64 snapshotTime);
+    /// Add the latest snapshot of the direct and active children total
+    /// values of the specified `subcontext` to our active children total
+    /// values.
+    void addSubcontextValues(const StatContext& subcontext);
+
+    /// Snapshot all values of all subcontexts, and return `true` if the
+    /// snapshot of this context was taken, or `false` if it was skipped
+    /// because it would have repeated the latest one.
+    bool snapshotImp(bsls::Types::Int64 snapshotTime);
 
     /// Imp of `cleanup`.  Add the direct values of all subcontexts
     /// being deleted to the specified `expiredValuesVec`
@@ -701,6 +756,14 @@ class StatContext {
     /// contents of the specified `update`.
     void applyUpdate(const mwcstm::StatContextUpdate& update);
 
+    // PRIVATE ACCESSORS
+
+    /// Take the snapshots of this context skipped since its latest
+    /// snapshot, once its parent took its own.  Note that, although this
+    /// modifies the history of the values of this context and of its
+    /// ancestors, it does not change what can be observed of them.
+    void takeSkippedSnapshots() const;
+
     // NOT IMPLEMENTED
     StatContext(const StatContext&);
     StatContext& operator=(const StatContext&);
@@ -737,7 +800,7 @@ class StatContext {
     /// Set the value at the specified index `valueKey` using the specified
     /// `value`.  Note that this method is thread-safe.  The behavior is
     /// undefined unless the value corresponding to the `valueKey` is
-    /// continuous.
+    /// continuous and not sharded.
     void setValue(int valueKey, bsls::Types::Int64 value);
 
     /// Set the value at the specified index `valueKey` using the specified
@@ -992,6 +1055,16 @@ class StatContextConfiguration {
     /// size.
     StatContextConfiguration& valueLevel(int size);
 
+    /// Spread the updates of the last added value over the specified
+    /// `numShards`, so that threads concurrently updating it in the same
+    /// context don't contend on the same cache line, and collect them on
+    /// each snapshot.  Return this object.  Only the direct values of a
+    /// context are sharded.  Note that the min and max of a sharded
+    /// continuous value are those of its values at each snapshot, and
+    /// that `setValue` can't be used for a sharded value.  The behavior is
+    /// undefined unless a value was added and `0 <= numShards`.
+    StatContextConfiguration& valueShards(int numShards);
+
     /// Set a callback to be invoked right before the `StatContext` is
     /// snapshotted.  Return this object.
     StatContextConfiguration& preSnapshotCallback(
@@ -1061,6 +1134,17 @@ class StatContextIterator {
 // class StatContext
 // -----------------
 
+// PRIVATE MANIPULATORS
+inline void StatContext::markUpdated()
+{
+    // Only write the flag once per snapshot, so that the threads updating
+    // this context do not keep invalidating its cache line.
+
+    if (!d_isUpdated.load()) {
+        d_isUpdated = true;
+    }
+}
+
 // CREATORS
 inline StatContext::~StatContext()
 {
@@ -1072,18 +1156,21 @@ inline void StatContext::adjustValue(int valueKey, bsls::Types::Int64 delta)
 {
     BSLS_ASSERT(valueKey < static_cast<int>(d_directValues_p->size()));
     (*d_directValues_p)[valueKey].adjustValue(delta);
+    markUpdated();
 }
 
 inline void StatContext::setValue(int valueKey, bsls::Types::Int64 value)
 {
     BSLS_ASSERT(valueKey < static_cast<int>(d_directValues_p->size()));
     (*d_directValues_p)[valueKey].setValue(value);
+    markUpdated();
 }
 
 inline void StatContext::reportValue(int valueKey, bsls::Types::Int64 value)
 {
     BSLS_ASSERT(valueKey < static_cast<int>(d_directValues_p->size()));
     (*d_directValues_p)[valueKey].reportValue(value);
+    markUpdated();
 }
 
 // ACCESSORS
@@ -1177,6 +1264,10 @@ inline const bsl::string& StatContext::valueName(int valueIndex) const
 inline const StatValue& StatContext::value(ValueType valueType,
                                            int       valueIndex) const
 {
+    if (d_numSkippedSnapshots) {
+        takeSkippedSnapshots();
+    }
+
     const ValueVec* valueVec = 0;
     switch (valueType) {
     case DMCST_TOTAL_VALUE:
@@ -1373,6 +1464,14 @@ inline StatContextConfiguration& StatContextConfiguration::valueLevel(int size)
     return *this;
 }
 
+inline StatContextConfiguration&
+StatContextConfiguration::valueShards(int numShards)
+{
+    BSLS_ASSERT(!d_valueDefs.empty() && 0 <= numShards);
+    d_valueDefs.back().d_numShards = numShards;
+    return *this;
+}
+
 inline StatContextConfiguration& StatContextConfiguration::preSnapshotCallback(
     const StatContext::SnapshotCallback& preSnapshotCallback)
 {
@@ -29,12 +29,17 @@
 
 // BDE
 #include <bdlb_bitutil.h>
+#include <bdlf_bind.h>
 #include <bsl_iostream.h>
+#include <bsl_memory.h>
 #include <bsl_sstream.h>
 #include <bsl_vector.h>
 #include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
 #include <bslma_testallocator.h>
 #include <bslma_testallocatormonitor.h>
+#include <bslmt_threadutil.h>
+#include <bsls_timeutil.h>
 
 using namespace BloombergLP;
 using namespace bsl;
@@ -58,6 +63,11 @@ using namespace mwcst;
 // [ 4] Usage example with value level
 // [ 4] Test updates
 // [ 5] Usage examples with updates
+// [ 8] Histogram values
+// [ 9] Sharded values
+// [10] Idle subcontexts
+// [-1] Contention of concurrent updates
+// [-2] Snapshot of idle subcontexts
 //-----------------------------------------------------------------------------
 
 //=============================================================================
@@ -1078,6 +1088,479 @@ static void testDatum(bslma::Allocator* allocator)
     ASSERT(datum->datum().isInteger());
 }
 
+static void testHistogramValues(bslma::Allocator* allocator)
+{
+    // ------------------------------------------------------------------------
+    // TEST HISTOGRAM VALUES
+    //
+    // Concerns:
+    //   - The percentiles of a histogram value between two snapshots only
+    //     account for the values reported in between.
+    //   - The histograms of the sub-tables of a table are merged into its
+    //     total value, including the ones of expired sub-tables.
+    //   - A percentile is bounded by the maximum reported value, and the
+    //     maximum Int64 is returned if nothing was reported.
+    // ------------------------------------------------------------------------
+
+    // Computing a percentile uses the default allocator.
+    bslma::DefaultAllocatorGuard guard(allocator);
+
+    const StatValue::SnapshotLocation latest(0, 0);
+    const StatValue::SnapshotLocation previous(0, 1);
+    const StatValue::SnapshotLocation previous2(0, 2);
+    const StatValue::SnapshotLocation initial(0, 4);
+
+    mwcst::StatContext context(
+        mwcst::StatContextConfiguration("Queues", allocator)
+            .isTable(true)
+            .storeExpiredSubcontextValues(true)
+            .value("Time", StatValue::DMCST_HISTOGRAM, 5),
+        allocator);
+
+    bslma::ManagedPtr<mwcst::StatContext> queue1 = context.addSubcontext(
+        mwcst::StatContextConfiguration("queue1", allocator));
+    bslma::ManagedPtr<mwcst::StatContext> queue2 = context.addSubcontext(
+        mwcst::StatContextConfiguration("queue2", allocator));
+
+    PV("Values reported by the sub-tables are merged");
+    for (int i = 1; i <= 100; ++i) {
+        queue1->reportValue(0, i);
+    }
+    queue2->reportValue(0, 1000);
+    context.snapshot();
+
+    // The total values are created by the first snapshot.
+    const StatValue& total = context.value(StatContext::DMCST_TOTAL_VALUE, 0);
+
+    ASSERT_EQUALS(
+        StatUtil::percentile50(direct(*queue1, 0), latest, previous),
+        50);
+    ASSERT_EQUALS(StatUtil::percentile50(total, latest, previous), 51);
+
+    // 100 is counted in the bucket of [100, 101], and 1000 in the one of
+    // [992, 1007].
+    ASSERT_EQUALS(StatUtil::percentile99(total, latest, previous), 101);
+    ASSERT_EQUALS(StatUtil::percentile(total, latest, previous, 100.0),
+                  1000);
+
+    PV("Only the values reported between the snapshots are accounted for");
+    queue1->reportValue(0, 5000);
+    context.snapshot();
+
+    ASSERT_EQUALS(StatUtil::percentile50(total, latest, previous), 5000);
+    ASSERT_EQUALS(StatUtil::percentile50(total, latest, previous2), 51);
+
+    PV("The values of an expired sub-table are kept");
+    queue2.reset();
+    context.snapshot();
+    context.cleanup();
+    context.snapshot();
+
+    ASSERT_EQUALS(StatUtil::percentile50(total, latest, previous), MAX_INT);
+    ASSERT_EQUALS(StatUtil::eventsDifference(total, latest, initial), 102);
+    ASSERT_EQUALS(StatUtil::percentile50(total, latest, initial), 51);
+    ASSERT_EQUALS(StatUtil::percentile99(total, latest, initial), 1007);
+    ASSERT_EQUALS(StatUtil::percentile(total, latest, initial, 100.0), 5000);
+}
+
+/// Adjust the value at the specified `valueIndex` of the specified `context`
+/// by 1, and report 2 to the value at `valueIndex + 1`, the specified
+/// `numIterations` times.
+static void
+updateValues(StatContext* context, int valueIndex, int numIterations)
+{
+    for (int i = 0; i < numIterations; ++i) {
+        context->adjustValue(valueIndex, 1);
+        context->reportValue(valueIndex + 1, 2);
+    }
+}
+
+/// Run the specified `numThreads` threads, created using the specified
+/// `allocator`, each calling `updateValues` with the specified `context`,
+/// `valueIndex` and `numIterations`, and wait for all of them to complete.
+static void runUpdateThreads(StatContext*      context,
+                             int               valueIndex,
+                             int               numIterations,
+                             int               numThreads,
+                             bslma::Allocator* allocator)
+{
+    bsl::vector<bslmt::ThreadUtil::Handle> handles(numThreads, allocator);
+    for (int i = 0; i < numThreads; ++i) {
+        int rc = bslmt::ThreadUtil::createWithAllocator(
+            &handles[i],
+            bdlf::BindUtil::bindS(allocator,
+                                  &updateValues,
+                                  context,
+                                  valueIndex,
+                                  numIterations),
+            allocator);
+        ASSERT_EQUALS(rc, 0);
+    }
+
+    for (int i = 0; i < numThreads; ++i) {
+        bslmt::ThreadUtil::join(handles[i]);
+    }
+}
+
+static void testShardedValues(bslma::Allocator* allocator)
+{
+    // ------------------------------------------------------------------------
+    // TEST SHARDED VALUES
+    //
+    // Concerns:
+    //   - Only the direct values defined with shards are sharded.
+    //   - The updates of a sharded value are accounted for by the next
+    //     snapshot, as if the value was not sharded, except for the min and
+    //     max of a continuous value which only account for the value at
+    //     each snapshot.
+    //   - No update is lost when many threads update a sharded value.
+    // ------------------------------------------------------------------------
+
+    mwcst::StatContext context(
+        mwcst::StatContextConfiguration("Channels", allocator)
+            .isTable(true)
+            .value("Bytes", 5)
+            .valueShards(4)
+            .value("Latency", StatValue::DMCST_DISCRETE, 5)
+            .valueShards(4)
+            .value("Unsharded", 5),
+        allocator);
+
+    bslma::ManagedPtr<mwcst::StatContext> channel = context.addSubcontext(
+        mwcst::StatContextConfiguration("channel", allocator));
+
+    ASSERT_EQUALS(direct(*channel, 0).numShards(), 4);
+    ASSERT_EQUALS(direct(*channel, 1).numShards(), 4);
+    ASSERT_EQUALS(direct(*channel, 2).numShards(), 0);
+
+    PV("Updates are collected by the snapshot");
+    channel->adjustValue(0, 10);
+    channel->adjustValue(0, -3);
+    channel->adjustValue(2, 10);
+    channel->adjustValue(2, -3);
+    channel->reportValue(1, 5);
+    channel->reportValue(1, 1);
+    channel->reportValue(1, 9);
+    context.snapshot();
+
+    // The total values are created by the first snapshot.
+    const StatValue& total = context.value(StatContext::DMCST_TOTAL_VALUE, 0);
+
+    ASSERT_EQUALS(total.numShards(), 0);
+    ASSERT(checkSnapshot(direct(*channel, 0), 0, 0, "7 0 7 1 1"));
+    ASSERT(checkSnapshot(direct(*channel, 2), 0, 0, "7 0 10 1 1"));
+    ASSERT(checkSnapshot(direct(*channel, 1), 0, 0, "1 9 3 15"));
+    ASSERT(checkSnapshot(total, 0, 0, "7 0 7 1 1"));
+
+    channel->adjustValue(0, -10);
+    context.snapshot();
+
+    ASSERT(checkSnapshot(direct(*channel, 0), 0, 0, "-3 -3 7 1 2"));
+    ASSERT_EQUALS(direct(*channel, 1).snapshot(0).events(), 3);
+    ASSERT_EQUALS(direct(*channel, 1).snapshot(0).max(), MIN_INT);
+
+    PV("Concurrent updates are not lost");
+    const int k_NUM_THREADS    = 8;
+    const int k_NUM_ITERATIONS = 10000;
+
+    runUpdateThreads(channel.get(),
+                     0,
+                     k_NUM_ITERATIONS,
+                     k_NUM_THREADS,
+                     allocator);
+    context.snapshot();
+
+    const StatValue::Snapshot& bytes   = total.snapshot(0);
+    const StatValue::Snapshot& latency = direct(*channel, 1).snapshot(0);
+    ASSERT_EQUALS(bytes.value(), k_NUM_THREADS * k_NUM_ITERATIONS - 3);
+    ASSERT_EQUALS(bytes.increments(), k_NUM_THREADS * k_NUM_ITERATIONS + 1);
+    ASSERT_EQUALS(latency.events(), k_NUM_THREADS * k_NUM_ITERATIONS + 3);
+    ASSERT_EQUALS(latency.sum(), 2 * k_NUM_THREADS * k_NUM_ITERATIONS + 15);
+    ASSERT_EQUALS(latency.min(), 2);
+    ASSERT_EQUALS(latency.max(), 2);
+}
+
+static void testContentionPerformance(bslma::Allocator* allocator)
+{
+    // ------------------------------------------------------------------------
+    // CONTENTION OF CONCURRENT UPDATES
+    //
+    // Concerns:
+    //   - Measure the cost of an update of a context when 1 to 32 threads
+    //     update the same continuous and discrete values, with and without
+    //     shards.
+    // ------------------------------------------------------------------------
+
+    const int k_NUM_ITERATIONS = 1000 * 1000;
+    const int k_NUM_SHARDS     = 32;
+
+    for (int sharded = 0; sharded < 2; ++sharded) {
+        for (int numThreads = 1; numThreads <= 32; numThreads *= 2) {
+            mwcst::StatContext context(
+                mwcst::StatContextConfiguration("Channel", allocator)
+                    .value("Bytes", 2)
+                    .valueShards(sharded ? k_NUM_SHARDS : 0)
+                    .value("Latency", StatValue::DMCST_DISCRETE, 2)
+                    .valueShards(sharded ? k_NUM_SHARDS : 0),
+                allocator);
+
+            const bsls::Types::Int64 start = bsls::TimeUtil::getTimer();
+            runUpdateThreads(&context,
+                             0,
+                             k_NUM_ITERATIONS,
+                             numThreads,
+                             allocator);
+            context.snapshot();
+            const bsls::Types::Int64 elapsed = bsls::TimeUtil::getTimer() -
+                                               start;
+
+            ASSERT_EQUALS(direct(context, 0).snapshot(0).value(),
+                          numThreads * k_NUM_ITERATIONS);
+
+            // Each iteration of a thread does 2 updates.
+
+            cout << (sharded ? "sharded" : "unsharded") << ", "
+                 << numThreads << " thread(s): "
+                 << static_cast<double>(elapsed) /
+                        (2.0 * k_NUM_ITERATIONS)
+                 << " ns per update per thread" << endl;
+        }
+    }
+}
+
+/// Do nothing.  Used as the pre-snapshot callback of a context, so that its
+/// snapshots are never skipped.
+static void noOpSnapshotCallback(const StatContext&)
+{
+}
+
+/// Return `true` if the specified `lhs` and `rhs` values have the same
+/// snapshots at all levels, regardless of their times, and `false`
+/// otherwise.
+static bool haveSameSnapshots(const StatValue& lhs, const StatValue& rhs)
+{
+    for (int level = 0; level < lhs.numLevels(); ++level) {
+        for (int index = 0; index < lhs.historySize(level); ++index) {
+            const StatValue::SnapshotLocation location(level, index);
+            const StatValue::Snapshot&        l = lhs.snapshot(location);
+            const StatValue::Snapshot&        r = rhs.snapshot(location);
+            if (l.value() != r.value() || l.min() != r.min() ||
+                l.max() != r.max() || l.increments() != r.increments() ||
+                l.decrements() != r.decrements()) {
+                return false;  // RETURN
+            }
+        }
+    }
+
+    return true;
+}
+
+/// Return `true` if the specified `value` and `schedule` values have the
+/// same snapshot times at all levels, and `false` otherwise.
+static bool haveSameSnapshotTimes(const StatValue& value,
+                                  const StatValue& schedule)
+{
+    for (int level = 0; level < value.numLevels(); ++level) {
+        for (int index = 0; index < value.historySize(level); ++index) {
+            const StatValue::SnapshotLocation location(level, index);
+            if (value.snapshot(location).snapshotTime() !=
+                schedule.snapshot(location).snapshotTime()) {
+                return false;  // RETURN
+            }
+        }
+    }
+
+    return true;
+}
+
+static void testIdleSubcontexts(bslma::Allocator* allocator)
+{
+    // ------------------------------------------------------------------------
+    // TEST IDLE SUBCONTEXTS
+    //
+    // Concerns:
+    //   - The values of the subcontexts of a table whose snapshots were
+    //     skipped have, at all levels, the same snapshots as if they had
+    //     been taken, and so do the total values of the table.
+    //   - The skipped snapshots have the times of the snapshots of the
+    //     table.
+    //   - An update of an idle subcontext, or of one of its subcontexts, is
+    //     accounted for by the next snapshot.
+    //   - The values of an expired subcontext are accounted for.
+    // ------------------------------------------------------------------------
+
+    // Computing a percentile uses the default allocator.
+    bslma::DefaultAllocatorGuard guard(allocator);
+
+    // The snapshots of the subcontexts of 'ref', which have a pre-snapshot
+    // callback, are never skipped.
+
+    StatContextConfiguration config("Queues", allocator);
+    config.isTable(true)
+        .storeExpiredSubcontextValues(true)
+        .value("Bytes", StatValue::DMCST_CONTINUOUS, 3)
+        .valueLevel(2)
+        .valueLevel(2)
+        .value("Latency", StatValue::DMCST_HISTOGRAM, 2)
+        .valueLevel(3);
+
+    StatContext obj(config, allocator);
+    StatContext ref(config, allocator);
+
+    bslma::ManagedPtr<StatContext> queues[2][2];
+    bslma::ManagedPtr<StatContext> apps[2];
+    StatContext*                   contexts[2] = {&obj, &ref};
+    for (int i = 0; i < 2; ++i) {
+        StatContextConfiguration queue1("queue1", allocator);
+        StatContextConfiguration queue2("queue2", allocator);
+        StatContextConfiguration app("app", allocator);
+        if (contexts[i] == &ref) {
+            queue1.preSnapshotCallback(&noOpSnapshotCallback);
+            queue2.preSnapshotCallback(&noOpSnapshotCallback);
+            app.preSnapshotCallback(&noOpSnapshotCallback);
+        }
+
+        queues[i][0] = contexts[i]->addSubcontext(queue1);
+        queues[i][1] = contexts[i]->addSubcontext(queue2);
+        apps[i]      = queues[i][0]->addSubcontext(app);
+    }
+
+    for (int snapshotId = 1; snapshotId <= 60; ++snapshotId) {
+        for (int i = 0; i < 2; ++i) {
+            if (snapshotId % 17 == 1) {
+                queues[i][0]->adjustValue(0, snapshotId);
+            }
+            if (snapshotId % 23 == 5) {
+                apps[i]->reportValue(1, snapshotId);
+            }
+            if (snapshotId == 10) {
+                queues[i][1]->adjustValue(0, -3);
+            }
+            if (snapshotId == 40) {
+                queues[i][1].reset();
+            }
+            contexts[i]->snapshot();
+            contexts[i]->cleanup();
+        }
+
+        if (snapshotId % 13 != 0 && snapshotId != 60) {
+            // Let the snapshots be skipped for a while
+            continue;  // CONTINUE
+        }
+
+        const StatContext::ValueType total = StatContext::DMCST_TOTAL_VALUE;
+        for (int v = 0; v < 2; ++v) {
+            LOOP_ASSERT_EQUALS(
+                snapshotId,
+                haveSameSnapshots(obj.value(total, v), ref.value(total, v)),
+                true);
+            LOOP_ASSERT_EQUALS(
+                snapshotId,
+                haveSameSnapshots(queues[0][0]->value(total, v),
+                                  queues[1][0]->value(total, v)),
+                true);
+            LOOP_ASSERT_EQUALS(snapshotId,
+                               haveSameSnapshots(direct(*apps[0], v),
+                                                 direct(*apps[1], v)),
+                               true);
+            LOOP_ASSERT_EQUALS(snapshotId,
+                               haveSameSnapshotTimes(direct(*apps[0], v),
+                                                     direct(obj, v)),
+                               true);
+            if (queues[0][1]) {
+                LOOP_ASSERT_EQUALS(
+                    snapshotId,
+                    haveSameSnapshots(direct(*queues[0][1], v),
+                                      direct(*queues[1][1], v)),
+                    true);
+            }
+        }
+    }
+
+    PV("An update of an idle subcontext is accounted for");
+    for (int i = 0; i < 2; ++i) {
+        apps[i]->reportValue(1, 1000);
+        contexts[i]->snapshot();
+    }
+
+    const StatValue::SnapshotLocation latest(0, 0);
+    const StatValue::SnapshotLocation previous(0, 1);
+    const bsls::Types::Int64          max = StatUtil::percentile(
+        direct(*apps[1], 1),
+        latest,
+        previous,
+        100.0);
+    ASSERT(1000 <= max);
+    ASSERT_EQUALS(
+        StatUtil::percentile(direct(*apps[0], 1), latest, previous, 100.0),
+        max);
+    ASSERT_EQUALS(StatUtil::percentile(
+                      obj.value(StatContext::DMCST_TOTAL_VALUE, 1),
+                      latest,
+                      previous,
+                      100.0),
+                  max);
+    ASSERT_EQUALS(obj.value(StatContext::DMCST_TOTAL_VALUE, 0)
+                      .snapshot(latest)
+                      .value(),
+                  ref.value(StatContext::DMCST_TOTAL_VALUE, 0)
+                      .snapshot(latest)
+                      .value());
+}
+
+static void testIdleSnapshotPerformance(bslma::Allocator* allocator)
+{
+    // ------------------------------------------------------------------------
+    // SNAPSHOT OF IDLE SUBCONTEXTS
+    //
+    // Concerns:
+    //   - Measure the cost of a snapshot of a table having many
+    //     subcontexts, when all of them are updated, and when only a few
+    //     of them are.
+    // ------------------------------------------------------------------------
+
+    const int k_NUM_SUBCONTEXTS = 10 * 1000;
+    const int k_NUM_SNAPSHOTS   = 100;
+
+    StatContext context(StatContextConfiguration("Queues", allocator)
+                            .isTable(true)
+                            .value("Bytes", 61)
+                            .value("Latency", StatValue::DMCST_DISCRETE, 61),
+                        allocator);
+
+    bsl::vector<bsl::shared_ptr<StatContext> > queues(allocator);
+    queues.reserve(k_NUM_SUBCONTEXTS);
+    for (int i = 0; i < k_NUM_SUBCONTEXTS; ++i) {
+        mwcu::MemOutStream name(allocator);
+        name << "queue" << i;
+        queues.push_back(bsl::shared_ptr<StatContext>(
+            context.addSubcontext(
+                StatContextConfiguration(name.str(), allocator)),
+            allocator));
+    }
+    context.snapshot();
+    context.snapshot();
+
+    const int k_NUM_UPDATED[] = {k_NUM_SUBCONTEXTS, 100, 0};
+    for (int i = 0; i < 3; ++i) {
+        const bsls::Types::Int64 start = bsls::TimeUtil::getTimer();
+        for (int s = 0; s < k_NUM_SNAPSHOTS; ++s) {
+            for (int q = 0; q < k_NUM_UPDATED[i]; ++q) {
+                queues[q]->adjustValue(0, 1);
+                queues[q]->reportValue(1, 2);
+            }
+            context.snapshot();
+        }
+        const bsls::Types::Int64 elapsed = bsls::TimeUtil::getTimer() -
+                                           start;
+
+        cout << k_NUM_UPDATED[i] << " of " << k_NUM_SUBCONTEXTS
+             << " subcontexts updated: "
+             << static_cast<double>(elapsed) / (1000.0 * k_NUM_SNAPSHOTS)
+             << " us per snapshot" << endl;
+    }
+}
+
 //=============================================================================
 //                              MAIN PROGRAM
 //-----------------------------------------------------------------------------
@@ -1118,6 +1601,42 @@ int main(int argc, char** argv)
 
     switch (test) {
     case 0:  // Zero is always the leading case.
+    case 10: {
+        // --------------------------------------------------------------------
+        // TEST IDLE SUBCONTEXTS
+        // --------------------------------------------------------------------
+
+        if (verbose)
+            cout << endl
+                 << "TEST IDLE SUBCONTEXTS" << endl
+                 << "=====================" << endl;
+        testIdleSubcontexts(&ta);
+    } break;
+
+    case 9: {
+        // --------------------------------------------------------------------
+        // TEST SHARDED VALUES
+        // --------------------------------------------------------------------
+
+        if (verbose)
+            cout << endl
+                 << "TEST SHARDED VALUES" << endl
+                 << "===================" << endl;
+        testShardedValues(&ta);
+    } break;
+
+    case 8: {
+        // --------------------------------------------------------------------
+        // TEST HISTOGRAM VALUES
+        // --------------------------------------------------------------------
+
+        if (verbose)
+            cout << endl
+                 << "TEST HISTOGRAM VALUES" << endl
+                 << "=====================" << endl;
+        testHistogramValues(&ta);
+    } break;
+
     case 7: {
         // --------------------------------------------------------------------
         // TEST DATUM
@@ -1192,6 +1711,28 @@ int main(int argc, char** argv)
         usageExample(cout, &ta);
     } break;
 
+    case -1: {
+        // --------------------------------------------------------------------
+        // CONTENTION OF CONCURRENT UPDATES
+        // --------------------------------------------------------------------
+        if (verbose)
+            cout << endl
+                 << "CONTENTION OF CONCURRENT UPDATES" << endl
+                 << "================================" << endl;
+        testContentionPerformance(&ta);
+    } break;
+
+    case -2: {
+        // --------------------------------------------------------------------
+        // SNAPSHOT OF IDLE SUBCONTEXTS
+        // --------------------------------------------------------------------
+        if (verbose)
+            cout << endl
+                 << "SNAPSHOT OF IDLE SUBCONTEXTS" << endl
+                 << "============================" << endl;
+        testIdleSnapshotPerformance(&ta);
+    } break;
+
     default:
         cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
         testStatus = -1;
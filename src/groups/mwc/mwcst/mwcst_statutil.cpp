@@ -343,7 +343,7 @@ bsls::Types::Int64
 StatUtil::events(const StatValue&                   value,
                  const StatValue::SnapshotLocation& snapshot)
 {
-    BSLS_ASSERT(value.type() == StatValue::DMCST_DISCRETE);
+    BSLS_ASSERT(value.type() != StatValue::DMCST_CONTINUOUS);
     return value.snapshot(snapshot).events();
 }
 
@@ -352,7 +352,7 @@ StatUtil::eventsDifference(const StatValue&                   value,
                            const StatValue::SnapshotLocation& firstSnapshot,
                            const StatValue::SnapshotLocation& secondSnapshot)
 {
-    BSLS_ASSERT(value.type() == StatValue::DMCST_DISCRETE);
+    BSLS_ASSERT(value.type() != StatValue::DMCST_CONTINUOUS);
 
     return value.snapshot(firstSnapshot).events() -
            value.snapshot(secondSnapshot).events();
@@ -361,7 +361,7 @@ StatUtil::eventsDifference(const StatValue&                   value,
 bsls::Types::Int64 StatUtil::sum(const StatValue&                   value,
                                  const StatValue::SnapshotLocation& snapshot)
 {
-    BSLS_ASSERT(value.type() == StatValue::DMCST_DISCRETE);
+    BSLS_ASSERT(value.type() != StatValue::DMCST_CONTINUOUS);
     return value.snapshot(snapshot).sum();
 }
 
@@ -370,7 +370,7 @@ StatUtil::sumDifference(const StatValue&                   value,
                         const StatValue::SnapshotLocation& firstSnapshot,
                         const StatValue::SnapshotLocation& secondSnapshot)
 {
-    BSLS_ASSERT(value.type() == StatValue::DMCST_DISCRETE);
+    BSLS_ASSERT(value.type() != StatValue::DMCST_CONTINUOUS);
 
     return value.snapshot(firstSnapshot).sum() -
            value.snapshot(secondSnapshot).sum();
@@ -381,7 +381,7 @@ StatUtil::averagePerEvent(const StatValue&                   value,
                           const StatValue::SnapshotLocation& firstSnapshot,
                           const StatValue::SnapshotLocation& secondSnapshot)
 {
-    BSLS_ASSERT(value.type() == StatValue::DMCST_DISCRETE);
+    BSLS_ASSERT(value.type() != StatValue::DMCST_CONTINUOUS);
 
     bsls::Types::Int64 events = eventsDifference(value,
                                                  firstSnapshot,
@@ -402,7 +402,7 @@ double StatUtil::averagePerEventReal(
     const StatValue::SnapshotLocation& firstSnapshot,
     const StatValue::SnapshotLocation& secondSnapshot)
 {
-    BSLS_ASSERT(value.type() == StatValue::DMCST_DISCRETE);
+    BSLS_ASSERT(value.type() != StatValue::DMCST_CONTINUOUS);
 
     bsls::Types::Int64 events = eventsDifference(value,
                                                  firstSnapshot,
@@ -418,5 +418,62 @@ double StatUtil::averagePerEventReal(
     }
 }
 
+bsls::Types::Int64
+StatUtil::percentile(const StatValue&                   value,
+                     const StatValue::SnapshotLocation& firstSnapshot,
+                     const StatValue::SnapshotLocation& secondSnapshot,
+                     double                             percentile)
+{
+    BSLS_ASSERT(value.type() == StatValue::DMCST_HISTOGRAM);
+    BSLS_ASSERT(firstSnapshot.level() == secondSnapshot.level());
+
+    const int start = bsl::min(firstSnapshot.index(), secondSnapshot.index());
+    const int end   = bsl::max(firstSnapshot.index(), secondSnapshot.index());
+    const StatValue::SnapshotLocation startLoc(firstSnapshot.level(), start);
+    const StatValue::SnapshotLocation endLoc(firstSnapshot.level(), end);
+
+    if (value.snapshot(startLoc).events() == value.snapshot(endLoc).events()) {
+        return bsl::numeric_limits<bsls::Types::Int64>::max();  // RETURN
+    }
+
+    Histogram::Buckets buckets;
+    value.loadHistogram(&buckets, startLoc, endLoc);
+
+    // The highest value of a bucket may be greater than any value actually
+    // reported, so bound the result by the maximum reported value.
+
+    bsls::Types::Int64 max = bsl::numeric_limits<bsls::Types::Int64>::min();
+    for (int i = start; i < end; ++i) {
+        StatValue::SnapshotLocation loc(firstSnapshot.level(), i);
+        max = bsl::max(max, value.snapshot(loc).max());
+    }
+
+    return bsl::min(Histogram::valueAtPercentile(buckets, percentile), max);
+}
+
+bsls::Types::Int64
+StatUtil::percentile50(const StatValue&                   value,
+                       const StatValue::SnapshotLocation& firstSnapshot,
+                       const StatValue::SnapshotLocation& secondSnapshot)
+{
+    return percentile(value, firstSnapshot, secondSnapshot, 50.0);
+}
+
+bsls::Types::Int64
+StatUtil::percentile99(const StatValue&                   value,
+                       const StatValue::SnapshotLocation& firstSnapshot,
+                       const StatValue::SnapshotLocation& secondSnapshot)
+{
+    return percentile(value, firstSnapshot, secondSnapshot, 99.0);
+}
+
+bsls::Types::Int64
+StatUtil::percentile999(const StatValue&                   value,
+                        const StatValue::SnapshotLocation& firstSnapshot,
+                        const StatValue::SnapshotLocation& secondSnapshot)
+{
+    return percentile(value, firstSnapshot, secondSnapshot, 99.9);
+}
+
 }  // close package namespace
 }  // close enterprise namespace
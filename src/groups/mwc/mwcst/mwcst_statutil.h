@@ -211,9 +211,9 @@ struct StatUtil {
     /// returned.
     static bsls::Types::Int64 absoluteMax(const StatValue& value);
 
-    // ** Discrete StatValue functions only           **
-    // ** The behavior is undefined unless            **
-    // ** 'value.type() == StatValue::DMCST_DISCRETE' **
+    // ** Discrete and histogram StatValue functions only **
+    // ** The behavior is undefined unless                 **
+    // ** 'value.type() != StatValue::DMCST_CONTINUOUS'    **
 
     /// Return the total number of events recorded by the
     /// specified `value` up to the specified `snapshot`.
@@ -257,6 +257,49 @@ struct StatUtil {
     averagePerEventReal(const StatValue&                   value,
                         const StatValue::SnapshotLocation& firstSnapshot,
                         const StatValue::SnapshotLocation& secondSnapshot);
+
+    // ** Histogram StatValue functions only            **
+    // ** The behavior is undefined unless              **
+    // ** 'value.type() == StatValue::DMCST_HISTOGRAM'  **
+
+    /// Return the specified `percentile` of the values reported to the
+    /// specified `value` between the specified `firstSnapshot` and the
+    /// specified `secondSnapshot`, with a relative error lower than
+    /// `1 / Histogram::k_NUM_SUB_BUCKETS`.  If nothing was reported, the
+    /// maximum Int64 is returned.  The behavior is undefined unless
+    /// `0 <= percentile <= 100`.
+    static bsls::Types::Int64
+    percentile(const StatValue&                   value,
+               const StatValue::SnapshotLocation& firstSnapshot,
+               const StatValue::SnapshotLocation& secondSnapshot,
+               double                             percentile);
+
+    /// Return the median of the values reported to the specified `value`
+    /// between the specified `firstSnapshot` and the specified
+    /// `secondSnapshot`.  If nothing was reported, the maximum Int64 is
+    /// returned.
+    static bsls::Types::Int64
+    percentile50(const StatValue&                   value,
+                 const StatValue::SnapshotLocation& firstSnapshot,
+                 const StatValue::SnapshotLocation& secondSnapshot);
+
+    /// Return the 99th percentile of the values reported to the specified
+    /// `value` between the specified `firstSnapshot` and the specified
+    /// `secondSnapshot`.  If nothing was reported, the maximum Int64 is
+    /// returned.
+    static bsls::Types::Int64
+    percentile99(const StatValue&                   value,
+                 const StatValue::SnapshotLocation& firstSnapshot,
+                 const StatValue::SnapshotLocation& secondSnapshot);
+
+    /// Return the 99.9th percentile of the values reported to the specified
+    /// `value` between the specified `firstSnapshot` and the specified
+    /// `secondSnapshot`.  If nothing was reported, the maximum Int64 is
+    /// returned.
+    static bsls::Types::Int64
+    percentile999(const StatValue&                   value,
+                  const StatValue::SnapshotLocation& firstSnapshot,
+                  const StatValue::SnapshotLocation& secondSnapshot);
 };
 
 }  // close package namespace
@@ -48,31 +48,92 @@ void StatValue::aggregateLevel(int level, bsls::Types::Int64 snapshotTime)
                     d_levelStartIndices[level + 1];
     d_curSnapshotIndices[level + 1] = (d_curSnapshotIndices[level + 1] + 1) %
                                       levelSize;
-    Snapshot& aggSnapshot = d_history[d_curSnapshotIndices[level + 1] +
-                                      d_levelStartIndices[level + 1]];
+    const int aggIndex = d_curSnapshotIndices[level + 1] +
+                         d_levelStartIndices[level + 1];
+
+    Histogram::Buckets* aggChanges = 0;
+    if (d_type == DMCST_HISTOGRAM) {
+        aggChanges = &d_histogramHistory[aggIndex];
+    }
+    loadAggregate(&d_history[aggIndex], aggChanges, level);
+    d_history[aggIndex].d_snapshotTime = snapshotTime;
+
+    if (d_curSnapshotIndices[level + 1] == 0) {
+        // Advance to the next aggregation level
+        aggregateLevel(level + 1, snapshotTime);
+    }
+}
+
+void StatValue::collectShards()
+{
+    for (size_t i = 0; i < d_shards.size(); ++i) {
+        AtomicValueStats& shard = d_shards[i].d_stats;
+
+        d_currentStats.d_incrementsOrEvents +=
+            shard.d_incrementsOrEvents.swap(0);
+        d_currentStats.d_decrementsOrSum += shard.d_decrementsOrSum.swap(0);
+
+        if (d_type == DMCST_CONTINUOUS) {
+            d_currentStats.d_value += shard.d_value.swap(0);
+        }
+        else {
+            const bsls::Types::Int64 min = shard.d_min.swap(MAX_INT);
+            const bsls::Types::Int64 max = shard.d_max.swap(MIN_INT);
+            if (min < d_currentStats.d_min) {
+                d_currentStats.d_min = min;
+            }
+            if (max > d_currentStats.d_max) {
+                d_currentStats.d_max = max;
+            }
+        }
+    }
+
+    if (d_type == DMCST_CONTINUOUS) {
+        // The intermediate values are unknown, so the min and max only
+        // account for the value at each snapshot.
+
+        updateMinMax(&d_currentStats, d_currentStats.d_value);
+    }
+}
+
+// PRIVATE ACCESSORS
+void StatValue::loadAggregate(Snapshot*           result,
+                              Histogram::Buckets* changes,
+                              int                 level) const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(result);
+    BSLS_ASSERT_SAFE(d_type != DMCST_HISTOGRAM || changes);
 
     // 'd_levelStartIndices[level]' will be the most recent snapshot of the
-    // previous level (being aggregated here) since we call 'aggregateLevel'
-    // when that element has been updated.
-    const Snapshot& firstSnapshot    = d_history[d_levelStartIndices[level]];
-    aggSnapshot.d_value              = firstSnapshot.d_value;
-    aggSnapshot.d_min                = firstSnapshot.d_min;
-    aggSnapshot.d_max                = firstSnapshot.d_max;
-    aggSnapshot.d_incrementsOrEvents = firstSnapshot.d_incrementsOrEvents;
-    aggSnapshot.d_decrementsOrSum    = firstSnapshot.d_decrementsOrSum;
-    aggSnapshot.d_snapshotTime       = snapshotTime;
+    // level being aggregated since we aggregate a level when that element
+    // has been updated.
+    const Snapshot& firstSnapshot = d_history[d_levelStartIndices[level]];
+    result->d_value               = firstSnapshot.d_value;
+    result->d_min                 = firstSnapshot.d_min;
+    result->d_max                 = firstSnapshot.d_max;
+    result->d_incrementsOrEvents  = firstSnapshot.d_incrementsOrEvents;
+    result->d_decrementsOrSum     = firstSnapshot.d_decrementsOrSum;
 
     for (int i = d_levelStartIndices[level] + 1;
          i < d_levelStartIndices[level + 1];
          ++i) {
         const Snapshot& snapshot = d_history[i];
-        aggSnapshot.d_min        = bsl::min(aggSnapshot.d_min, snapshot.d_min);
-        aggSnapshot.d_max        = bsl::max(aggSnapshot.d_max, snapshot.d_max);
+        result->d_min            = bsl::min(result->d_min, snapshot.d_min);
+        result->d_max            = bsl::max(result->d_max, snapshot.d_max);
     }
 
-    if (d_curSnapshotIndices[level + 1] == 0) {
-        // Advance to the next aggregation level
-        aggregateLevel(level + 1, snapshotTime);
+    if (d_type == DMCST_HISTOGRAM) {
+        // The buckets changed by the aggregated snapshot are those changed by
+        // all the snapshots of the aggregated level, since they have all been
+        // taken after the previous aggregation.
+
+        changes->clear();
+        for (int i = d_levelStartIndices[level];
+             i < d_levelStartIndices[level + 1];
+             ++i) {
+            Histogram::merge(changes, d_histogramHistory[i]);
+        }
     }
 }
 
@@ -80,11 +141,15 @@ void StatValue::aggregateLevel(int level, bsls::Types::Int64 snapshotTime)
 StatValue::StatValue(bslma::Allocator* basicAllocator)
 : d_type(DMCST_CONTINUOUS)
 , d_currentStats()
+, d_shards(basicAllocator)
 , d_history(basicAllocator)
 , d_levelStartIndices(basicAllocator)
 , d_curSnapshotIndices(basicAllocator)
 , d_min(0)
 , d_max(0)
+, d_currentHistogram(basicAllocator)
+, d_snapshotHistogram(basicAllocator)
+, d_histogramHistory(basicAllocator)
 {
 }
 
@@ -94,11 +159,15 @@ StatValue::StatValue(const bsl::vector<int>& sizes,
                      bslma::Allocator*       basicAllocator)
 : d_type(type)
 , d_currentStats()
+, d_shards(basicAllocator)
 , d_history(basicAllocator)
 , d_levelStartIndices(basicAllocator)
 , d_curSnapshotIndices(basicAllocator)
 , d_min(0)
 , d_max(0)
+, d_currentHistogram(basicAllocator)
+, d_snapshotHistogram(basicAllocator)
+, d_histogramHistory(basicAllocator)
 {
     init(sizes, type, initTime);
 }
@@ -106,11 +175,15 @@ StatValue::StatValue(const bsl::vector<int>& sizes,
 StatValue::StatValue(const StatValue& other, bslma::Allocator* basicAllocator)
 : d_type(other.d_type)
 , d_currentStats(other.d_currentStats)
+, d_shards(other.d_shards, basicAllocator)
 , d_history(other.d_history, basicAllocator)
 , d_levelStartIndices(other.d_levelStartIndices, basicAllocator)
 , d_curSnapshotIndices(other.d_curSnapshotIndices, basicAllocator)
 , d_min(other.d_min)
 , d_max(other.d_max)
+, d_currentHistogram(other.d_currentHistogram, basicAllocator)
+, d_snapshotHistogram(other.d_snapshotHistogram, basicAllocator)
+, d_histogramHistory(other.d_histogramHistory, basicAllocator)
 {
 }
 
@@ -118,11 +191,15 @@ StatValue::StatValue(const StatValue& other, bslma::Allocator* basicAllocator)
 StatValue& StatValue::operator=(const StatValue& rhs)
 {
     d_currentStats       = rhs.d_currentStats;
+    d_shards             = rhs.d_shards;
     d_history            = rhs.d_history;
     d_levelStartIndices  = rhs.d_levelStartIndices;
     d_curSnapshotIndices = rhs.d_curSnapshotIndices;
     d_min                = rhs.d_min;
     d_max                = rhs.d_max;
+    d_currentHistogram   = rhs.d_currentHistogram;
+    d_snapshotHistogram  = rhs.d_snapshotHistogram;
+    d_histogramHistory   = rhs.d_histogramHistory;
 
     return *this;
 }
@@ -161,6 +238,10 @@ void StatValue::addSnapshot(const StatValue& other)
 
     d_currentStats.d_incrementsOrEvents += otherSnapshot.d_incrementsOrEvents;
     d_currentStats.d_decrementsOrSum += otherSnapshot.d_decrementsOrSum;
+
+    if (d_type == DMCST_HISTOGRAM) {
+        d_currentHistogram.add(other.d_snapshotHistogram);
+    }
 }
 
 void StatValue::setFromUpdate(const mwcstm::StatValueUpdate& update)
@@ -205,6 +286,10 @@ void StatValue::setFromUpdate(const mwcstm::StatValueUpdate& update)
 
 void StatValue::takeSnapshot(bsls::Types::Int64 snapshotTime)
 {
+    if (!d_shards.empty()) {
+        collectShards();
+    }
+
     bsls::Types::Int64 value = d_currentStats.d_value;
     bsls::Types::Int64 incrementsOrEvents;
     bsls::Types::Int64 decrementsOrSum;
@@ -237,6 +322,13 @@ void StatValue::takeSnapshot(bsls::Types::Int64 snapshotTime)
     snapshot.d_decrementsOrSum    = decrementsOrSum;
     snapshot.d_snapshotTime       = snapshotTime;
 
+    if (d_type == DMCST_HISTOGRAM) {
+        Histogram::Buckets& changes =
+            d_histogramHistory[d_curSnapshotIndices[0]];
+        changes.clear();
+        d_currentHistogram.updateSnapshot(&d_snapshotHistogram, &changes);
+    }
+
     if (d_curSnapshotIndices[0] == 0) {
         // We've performed enough snapshots to advance to the next aggregation
         // level
@@ -244,16 +336,102 @@ void StatValue::takeSnapshot(bsls::Types::Int64 snapshotTime)
     }
 }
 
+void StatValue::takeIdleSnapshots(int              numSnapshots,
+                                  const StatValue& schedule)
+{
+    // PRECONDITIONS
+    BSLS_ASSERT(0 <= numSnapshots);
+    BSLS_ASSERT(d_history.size() == schedule.d_history.size());
+
+    // Each level is taken one snapshot each time the level below wraps.
+    // Only the first snapshot taken into a level may aggregate snapshots
+    // taken before the idle ones: once a level has wrapped, it is entirely
+    // rewritten with the idle snapshot before wrapping again, so each of the
+    // next snapshots taken into the level above repeats the idle snapshot
+    // too.  This bounds the work to the size of the history, whatever the
+    // 'numSnapshots'.
+
+    const Snapshot     idle = d_history[d_curSnapshotIndices[0]];
+    Snapshot           first(idle);
+    Histogram::Buckets firstChanges(d_histogramHistory.get_allocator());
+    bsls::Types::Int64 numTaken = numSnapshots;
+
+    for (int level = 0; level < numLevels() && 0 < numTaken; ++level) {
+        const int start = d_levelStartIndices[level];
+        const int size  = historySize(level);
+        int&      index = d_curSnapshotIndices[level];
+
+        // Take the snapshots up to the one wrapping this level.
+
+        const bsls::Types::Int64 untilWrap = size - index;
+        const bsls::Types::Int64 numBefore = bsl::min(numTaken, untilWrap);
+        for (bsls::Types::Int64 i = 0; i < numBefore; ++i) {
+            index                    = (index + 1) % size;
+            d_history[start + index] = (0 == i ? first : idle);
+            if (d_type != DMCST_HISTOGRAM) {
+                continue;  // CONTINUE
+            }
+
+            if (0 == i) {
+                d_histogramHistory[start + index] = firstChanges;
+            }
+            else {
+                d_histogramHistory[start + index].clear();
+            }
+        }
+
+        if (numTaken < untilWrap) {
+            // This level did not wrap
+            break;  // BREAK
+        }
+
+        if (level + 1 < numLevels()) {
+            loadAggregate(&first, &firstChanges, level);
+        }
+
+        // Take the remaining snapshots, which all repeat the idle snapshot.
+
+        const bsls::Types::Int64 remaining = numTaken - untilWrap;
+        const bsls::Types::Int64 numWritten =
+            bsl::min(remaining, static_cast<bsls::Types::Int64>(size));
+        for (bsls::Types::Int64 i = 1; i <= numWritten; ++i) {
+            d_history[start + i % size] = idle;
+            if (d_type == DMCST_HISTOGRAM) {
+                d_histogramHistory[start + i % size].clear();
+            }
+        }
+        index    = static_cast<int>(remaining % size);
+        numTaken = 1 + remaining / size;
+    }
+
+    // The idle snapshots were taken at the same time as the snapshots of
+    // 'schedule'.
+
+    BSLS_ASSERT_SAFE(d_curSnapshotIndices == schedule.d_curSnapshotIndices);
+    for (size_t i = 0; i < d_history.size(); ++i) {
+        d_history[i].d_snapshotTime = schedule.d_history[i].d_snapshotTime;
+    }
+}
+
 void StatValue::clear(bsls::Types::Int64 snapshotTime)
 {
-    d_currentStats.reset(d_type == DMCST_DISCRETE, 0);
+    d_currentStats.reset(d_type != DMCST_CONTINUOUS, 0);
+    for (size_t i = 0; i < d_shards.size(); ++i) {
+        d_shards[i].d_stats.reset(d_type != DMCST_CONTINUOUS, 0);
+    }
     d_curSnapshotIndices.assign(d_curSnapshotIndices.size(), 0);
 
     for (size_t i = 0; i < d_history.size(); ++i) {
-        d_history[i].reset(d_type == DMCST_DISCRETE, snapshotTime);
+        d_history[i].reset(d_type != DMCST_CONTINUOUS, snapshotTime);
+    }
+
+    d_currentHistogram.reset();
+    d_snapshotHistogram.clear();
+    for (size_t i = 0; i < d_histogramHistory.size(); ++i) {
+        d_histogramHistory[i].clear();
     }
 
-    if (d_type == DMCST_DISCRETE) {
+    if (d_type != DMCST_CONTINUOUS) {
         d_min = MAX_INT;
         d_max = MIN_INT;
     }
@@ -265,14 +443,24 @@ void StatValue::clear(bsls::Types::Int64 snapshotTime)
 
 void StatValue::init(const bsl::vector<int>& sizes,
                      Type                    type,
-                     bsls::Types::Int64      snapshotTime)
+                     bsls::Types::Int64      snapshotTime,
+                     int                     numShards)
 {
+    // PRECONDITIONS
+    BSLS_ASSERT(0 <= numShards);
+
     d_type = type;
     d_levelStartIndices.resize(sizes.size() + 1);
     d_curSnapshotIndices.assign(sizes.size(), 0);
-    d_min = (d_type == DMCST_DISCRETE ? MAX_INT : 0);
-    d_max = (d_type == DMCST_DISCRETE ? MIN_INT : 0);
-    d_currentStats.reset(d_type == DMCST_DISCRETE, 0);
+    d_min = (d_type != DMCST_CONTINUOUS ? MAX_INT : 0);
+    d_max = (d_type != DMCST_CONTINUOUS ? MIN_INT : 0);
+    d_currentStats.reset(d_type != DMCST_CONTINUOUS, 0);
+
+    d_shards.clear();
+    d_shards.resize(numShards);
+    for (size_t i = 0; i < d_shards.size(); ++i) {
+        d_shards[i].d_stats.reset(d_type != DMCST_CONTINUOUS, 0);
+    }
 
     int historySize = 0;
     for (size_t i = 0; i < sizes.size(); ++i) {
@@ -285,7 +473,17 @@ void StatValue::init(const bsl::vector<int>& sizes,
     d_history.resize(historySize);
 
     for (size_t i = 0; i < d_history.size(); ++i) {
-        d_history[i].reset(d_type == DMCST_DISCRETE, snapshotTime);
+        d_history[i].reset(d_type != DMCST_CONTINUOUS, snapshotTime);
+    }
+
+    d_snapshotHistogram.clear();
+    d_histogramHistory.clear();
+    if (d_type == DMCST_HISTOGRAM) {
+        d_currentHistogram.init();
+        d_histogramHistory.resize(historySize);
+    }
+    else {
+        d_currentHistogram.release();
     }
 }
 
@@ -299,6 +497,39 @@ void StatValue::syncSnapshotSchedule(const StatValue& other)
 }
 
 // ACCESSORS
+void StatValue::loadHistogram(Histogram::Buckets*     result,
+                              const SnapshotLocation& firstSnapshot,
+                              const SnapshotLocation& secondSnapshot) const
+{
+    // PRECONDITIONS
+    BSLS_ASSERT(result);
+    BSLS_ASSERT(d_type == DMCST_HISTOGRAM);
+    BSLS_ASSERT(firstSnapshot.level() == secondSnapshot.level());
+    BSLS_ASSERT(firstSnapshot.index() <= secondSnapshot.index());
+
+    result->clear();
+
+    // Each snapshot holds the buckets changed since the previous snapshot of
+    // its level, so 'secondSnapshot' itself is excluded.
+
+    SnapshotLocation location(firstSnapshot);
+    for (; location.index() < secondSnapshot.index();
+         location.setIndex(location.index() + 1)) {
+        Histogram::merge(result, d_histogramHistory[historyIndex(location)]);
+    }
+}
+
+bool StatValue::isIdle() const
+{
+    const Snapshot& latest = d_history[d_curSnapshotIndices[0]];
+    if (d_type == DMCST_CONTINUOUS) {
+        return latest.d_min == latest.d_value &&
+               latest.d_max == latest.d_value;  // RETURN
+    }
+
+    return latest.d_min == MAX_INT && latest.d_max == MIN_INT;
+}
+
 bsl::ostream&
 StatValue::print(bsl::ostream& stream, int level, int spacesPerLevel) const
 {
@@ -403,14 +634,14 @@ void StatValueUtil::loadUpdateImp(mwcstm::StatValueUpdate* update,
                 }
             } break;
             case Fields::DMCSTM_EVENTS: {
-                if (StatValue::DMCST_DISCRETE == value.type() &&
+                if (StatValue::DMCST_CONTINUOUS != value.type() &&
                     (full || current.events() != last->events())) {
                     update->fields().push_back(current.events());
                     mask = bdlb::BitUtil::withBitSet(mask, i);
                 }
             } break;
             case Fields::DMCSTM_SUM: {
-                if (StatValue::DMCST_DISCRETE == value.type() &&
+                if (StatValue::DMCST_CONTINUOUS != value.type() &&
                     (full || current.sum() != last->sum())) {
                     update->fields().push_back(current.sum());
                     mask = bdlb::BitUtil::withBitSet(mask, i);
@@ -31,13 +31,42 @@
 // maintains a value and collects statistics about it and changes to it.  It
 // can be asked to calculate a number of statistics over its history.
 //
+// A histogram value ('DMCST_HISTOGRAM') is a discrete value which, in
+// addition, counts the reported values in a 'mwcst::Histogram', so that the
+// percentiles of the values reported between two snapshots can be computed.
+// Its history holds, for each snapshot, the sparse set of buckets whose count
+// changed since the previous snapshot of the same level, so that a value
+// which is not reported to does not grow its history.  Note that the buckets
+// are not part of a 'mwcstm::StatValueUpdate'.
+//
+// A StatValue can optionally be initialized with a number of shards, so that
+// the threads updating it concurrently do not all update the same cache line.
+// Each call to 'adjustValue' or 'reportValue' then only updates the shard
+// selected by the calling thread, and the shards are collected into the
+// current value by 'takeSnapshot'.  Because the current value is not known
+// between two snapshots, the min and max of a sharded continuous value are
+// only those of the values it has at each snapshot, and 'setValue' is not
+// supported.  Note that the events and sum of a discrete value reported to
+// during 'takeSnapshot' may be accounted for in different snapshots.
+//
+// A StatValue which was not updated since its latest snapshot, and whose
+// latest snapshot is idle (see 'isIdle'), can be taken a number of snapshots
+// at once with 'takeIdleSnapshots', at a cost bounded by the size of its
+// history.  This lets 'mwcst::StatContext' skip the snapshots of idle
+// contexts, and take them only when they are needed.
+//
 // You probably should not use this class directly.  Instead, you should use
 // the 'mwcst::StatContext' component.  Refer to the usage examples in the
 // documentation of that component.
 //
 /// Thread Safety
 ///-------------
-// 'adjustValue' and 'setValue' are thread-safe.  All other functions are not.
+// 'adjustValue', 'setValue' and 'reportValue' are thread-safe.  All other
+// functions are not.
+
+#ifndef INCLUDED_MWCST_HISTOGRAM
+#include <mwcst_histogram.h>
+#endif
 
 #ifndef INCLUDED_BSLIM_PRINTER
 #include <bslim_printer.h>
@@ -51,6 +80,14 @@
 #include <bslmf_nestedtraitdeclaration.h>
 #endif
 
+#ifndef INCLUDED_BSLMT_PLATFORM
+#include <bslmt_platform.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_THREADUTIL
+#include <bslmt_threadutil.h>
+#endif
+
 #ifndef INCLUDED_BSLS_ATOMIC
 #include <bsls_atomic.h>
 #endif
@@ -223,7 +260,13 @@ class StatValue {
         /// are added, their set of reported events is simply considered as
         /// a single stream of events.  For example, the max of two added
         /// discrete values will be the max of all the individual maxes.
-        DMCST_DISCRETE
+        DMCST_DISCRETE,
+
+        /// A histogram value is a discrete value additionally counting the
+        /// reported values in a log-linear histogram, from which the
+        /// percentiles of the reported values are computed.  When two
+        /// histogram values are added, their histograms are merged.
+        DMCST_HISTOGRAM
     };
 
   private:
@@ -231,11 +274,24 @@ class StatValue {
     typedef StatValue_Value<bsls::AtomicInt64, bsls::Types::Int64>
         AtomicValueStats;
 
+    /// Stats accumulated since the last snapshot by the threads updating a
+    /// sharded value through the same shard, padded so that two shards
+    /// never share a cache line.
+    struct Shard {
+        // DATA
+        AtomicValueStats d_stats;
+
+        char d_padding[2 * bslmt::Platform::e_CACHE_LINE_SIZE -
+                       sizeof(AtomicValueStats)];
+    };
+
     // DATA
     Type d_type;
 
     AtomicValueStats d_currentStats;
 
+    bsl::vector<Shard> d_shards;  // empty unless sharded
+
     bsl::vector<Snapshot> d_history;  // snapshots
 
     bsl::vector<int> d_levelStartIndices;
@@ -254,13 +310,57 @@ class StatValue {
 
     bsls::Types::Int64 d_max;  // max value since creation
 
+    Histogram d_currentHistogram;
+    // Counts of the values reported
+    // since creation, if histogram
+    // value
+
+    Histogram::Buckets d_snapshotHistogram;
+    // Counts of the values reported
+    // up to the last snapshot, if
+    // histogram value
+
+    bsl::vector<Histogram::Buckets> d_histogramHistory;
+    // Buckets changed by each
+    // snapshot in 'd_history', if
+    // histogram value
+
+    // PRIVATE CLASS METHODS
+
+    /// Update the min and max of the specified `stats` with the specified
+    /// `value`.
+    static void updateMinMax(AtomicValueStats*  stats,
+                             bsls::Types::Int64 value);
+
     // PRIVATE MANIPULATORS
-    void updateMinMax(bsls::Types::Int64 value);
+
+    /// Return the stats of the shard selected by the calling thread.  The
+    /// behavior is undefined unless this StatValue is sharded.
+    AtomicValueStats& currentShard();
+
+    /// Add the stats accumulated by the shards of this StatValue since the
+    /// last snapshot to its current stats, and reset the shards.
+    void collectShards();
 
     /// Aggregate the specified aggregation `level` if there is an
     /// aggregation level above it using the specified `snapshotTime`
     void aggregateLevel(int level, bsls::Types::Int64 snapshotTime);
 
+    // PRIVATE ACCESSORS
+
+    /// Return the index in `d_history` of the snapshot referred to by the
+    /// specified `location`.
+    int historyIndex(const SnapshotLocation& location) const;
+
+    /// Load into the specified `result` the aggregate of the snapshots of
+    /// the specified aggregation `level`, except for its snapshot time,
+    /// and, if this is a histogram value, load into the specified `changes`
+    /// the buckets changed by these snapshots.  The behavior is undefined
+    /// unless the most recent snapshot of `level` is its first one.
+    void loadAggregate(Snapshot*           result,
+                       Histogram::Buckets* changes,
+                       int                 level) const;
+
   public:
     // TRAITS
     BSLMF_NESTED_TRAIT_DECLARATION(StatValue, bslma::UsesBslmaAllocator)
@@ -281,11 +381,12 @@ class StatValue {
     void adjustValue(bsls::Types::Int64 delta);
 
     /// Set the value of this StatValue to the specified `value`.  The
-    /// behavior is undefined unless this is a continuous StatValue.
+    /// behavior is undefined unless this is a continuous StatValue which is
+    /// not sharded.
     void setValue(bsls::Types::Int64 value);
 
     /// Report the specified `value` to this StatValue.  The behavior is
-    /// undefined unless this is a discrete StatValue.
+    /// undefined unless this is a discrete or histogram StatValue.
     void reportValue(bsls::Types::Int64 value);
 
     /// Add the snapshot of the specified `other` StatValue to the current
@@ -299,6 +400,17 @@ class StatValue {
 
     void takeSnapshot(bsls::Types::Int64 snapshotTime);
 
+    /// Take the specified `numSnapshots` snapshots of this StatValue as if
+    /// it had not been updated since its latest snapshot, at the times of
+    /// the corresponding snapshots of the specified `schedule`.  The
+    /// current value is left untouched, so that updates made since the
+    /// latest snapshot are accounted for by the next call to
+    /// `takeSnapshot`.  The behavior is undefined unless `isIdle()`, this
+    /// StatValue's snapshot schedule is synchronized with that of
+    /// `schedule` (see `syncSnapshotSchedule`), and `schedule` took
+    /// `numSnapshots` more snapshots than this StatValue.
+    void takeIdleSnapshots(int numSnapshots, const StatValue& schedule);
+
     /// Clear all history and reset all snapshot's snapshotTime with the
     /// specified `clearTime`
     void clear(bsls::Types::Int64 clearTime);
@@ -308,11 +420,15 @@ class StatValue {
 
     /// (Re)initialize this StatValue to be of the specified `type` with
     /// the specified history `sizes` using the specified `initTime` to
-    /// initialize each snapshot's `snapshotTime`.  The current state is
-    /// lost.
+    /// initialize each snapshot's `snapshotTime`.  Optionally specify a
+    /// `numShards` over which the updates of this StatValue are spread
+    /// until the next snapshot.  If `numShards` is 0, this StatValue is not
+    /// sharded.  The current state is lost.  The behavior is undefined
+    /// unless `0 <= numShards`.
     void init(const bsl::vector<int>& sizes,
               Type                    type,
-              bsls::Types::Int64      initTime);
+              bsls::Types::Int64      initTime,
+              int                     numShards = 0);
 
     /// Sync this StatValue's snapshot schedule with that of the specified
     /// `other` StatValue.  This means that all level 1 and above snapshots
@@ -328,6 +444,17 @@ class StatValue {
     /// Return the type of this StatValue.
     Type type() const;
 
+    /// Return the number of shards of this StatValue, or 0 if it is not
+    /// sharded.
+    int numShards() const;
+
+    /// Return `true` if a snapshot of this StatValue taken without it being
+    /// updated would repeat its latest snapshot, except for the snapshot
+    /// time, and `false` otherwise.  This is the case if the latest
+    /// snapshot did not record any value change or reported value over its
+    /// interval.
+    bool isIdle() const;
+
     /// Return the number of snapshot levels specified at construction.
     int numLevels() const;
 
@@ -342,6 +469,21 @@ class StatValue {
     /// `location.index() <= historySize(location.level())`
     const Snapshot& snapshot(const SnapshotLocation& location) const;
 
+    /// Load into the specified `result` the histogram of the values
+    /// reported to this StatValue after the specified `secondSnapshot` and
+    /// up to the specified `firstSnapshot`, as a sparse set of buckets.
+    /// The behavior is undefined unless this is a histogram StatValue, both
+    /// snapshots are at the same level, and `firstSnapshot` is not older
+    /// than `secondSnapshot`.
+    void loadHistogram(Histogram::Buckets*     result,
+                       const SnapshotLocation& firstSnapshot,
+                       const SnapshotLocation& secondSnapshot) const;
+
+    /// Return the histogram of the values reported to this StatValue up to
+    /// its latest snapshot, as a sparse set of buckets.  The returned
+    /// histogram is empty unless this is a histogram StatValue.
+    const Histogram::Buckets& histogram() const;
+
     /// Return the minimum value of this StatValue since creation.
     bsls::Types::Int64 min() const;
 
@@ -610,30 +752,74 @@ StatValue_SnapshotLocation::print(bsl::ostream& stream,
 // class StatValue
 // ---------------
 
-// PRIVATE MANIPULATORS
-inline void StatValue::updateMinMax(bsls::Types::Int64 value)
+// PRIVATE ACCESSORS
+inline int StatValue::historyIndex(const SnapshotLocation& location) const
+{
+    BSLS_ASSERT(location.level() < numLevels());
+    BSLS_ASSERT(location.index() < historySize(location.level()));
+
+    int snapshotIndex = d_curSnapshotIndices[location.level()];
+
+    int historyIndex = snapshotIndex - location.index();
+    if (historyIndex < 0) {
+        historyIndex += historySize(location.level());
+    }
+
+    return historyIndex + d_levelStartIndices[location.level()];
+}
+
+// PRIVATE CLASS METHODS
+inline void StatValue::updateMinMax(AtomicValueStats*  stats,
+                                    bsls::Types::Int64 value)
 {
-    bsls::Types::Int64 min = d_currentStats.d_min;
+    bsls::Types::Int64 min = stats->d_min;
     while (min > value) {
-        d_currentStats.d_min.testAndSwap(min, value);
-        min = d_currentStats.d_min;
+        stats->d_min.testAndSwap(min, value);
+        min = stats->d_min;
     }
 
-    bsls::Types::Int64 max = d_currentStats.d_max;
+    bsls::Types::Int64 max = stats->d_max;
     while (max < value) {
-        d_currentStats.d_max.testAndSwap(max, value);
-        max = d_currentStats.d_max;
+        stats->d_max.testAndSwap(max, value);
+        max = stats->d_max;
     }
 }
 
+// PRIVATE MANIPULATORS
+inline StatValue::AtomicValueStats& StatValue::currentShard()
+{
+    // PRECONDITIONS
+    BSLS_ASSERT_SAFE(!d_shards.empty());
+
+    // Thread ids are usually aligned addresses, so their high bits are mixed
+    // into the bits selecting the shard.
+
+    const bsls::Types::Uint64 hash = bslmt::ThreadUtil::selfIdAsUint64() *
+                                     0x9E3779B97F4A7C15ULL;
+    return d_shards[static_cast<size_t>(hash >> 32) % d_shards.size()]
+        .d_stats;
+}
+
 // MANIPULATORS
 inline void StatValue::adjustValue(bsls::Types::Int64 delta)
 {
     BSLS_ASSERT(d_type == DMCST_CONTINUOUS);
 
+    if (!d_shards.empty()) {
+        AtomicValueStats& shard = currentShard();
+        shard.d_value.addRelaxed(delta);
+        if (delta > 0) {
+            shard.d_incrementsOrEvents.addRelaxed(1);
+        }
+        else if (delta < 0) {
+            shard.d_decrementsOrSum.addRelaxed(1);
+        }
+        return;  // RETURN
+    }
+
     bsls::Types::Int64 newValue = (d_currentStats.d_value += delta);
 
-    updateMinMax(newValue);
+    updateMinMax(&d_currentStats, newValue);
 
     if (delta > 0) {
         d_currentStats.d_incrementsOrEvents++;
@@ -646,9 +832,10 @@ inline void StatValue::adjustValue(bsls::Types::Int64 delta)
 inline void StatValue::setValue(bsls::Types::Int64 value)
 {
     BSLS_ASSERT(d_type == DMCST_CONTINUOUS);
+    BSLS_ASSERT(d_shards.empty());
 
     bsls::Types::Int64 oldValue = d_currentStats.d_value.swap(value);
-    updateMinMax(value);
+    updateMinMax(&d_currentStats, value);
 
     if (value > oldValue) {
         d_currentStats.d_incrementsOrEvents++;
@@ -660,17 +847,32 @@ inline void StatValue::setValue(bsls::Types::Int64 value)
 
 inline void StatValue::reportValue(bsls::Types::Int64 value)
 {
-    BSLS_ASSERT(d_type == DMCST_DISCRETE);
+    BSLS_ASSERT(d_type != DMCST_CONTINUOUS);
 
-    d_currentStats.d_decrementsOrSum += value;
-    d_currentStats.d_incrementsOrEvents++;
+    if (!d_shards.empty()) {
+        AtomicValueStats& shard = currentShard();
+        shard.d_decrementsOrSum.addRelaxed(value);
+        shard.d_incrementsOrEvents.addRelaxed(1);
+        updateMinMax(&shard, value);
+    }
+    else {
+        d_currentStats.d_decrementsOrSum += value;
+        d_currentStats.d_incrementsOrEvents++;
+        updateMinMax(&d_currentStats, value);
+    }
 
-    updateMinMax(value);
+    if (d_type == DMCST_HISTOGRAM) {
+        d_currentHistogram.record(value);
+    }
 }
 
 inline void StatValue::clearCurrentStats()
 {
-    d_currentStats.reset(d_type == DMCST_DISCRETE, 0);
+    d_currentStats.reset(d_type != DMCST_CONTINUOUS, 0);
+    for (size_t i = 0; i < d_shards.size(); ++i) {
+        d_shards[i].d_stats.reset(d_type != DMCST_CONTINUOUS, 0);
+    }
+    d_currentHistogram.reset();
 }
 
 // ACCESSORS
@@ -679,6 +881,11 @@ inline StatValue::Type StatValue::type() const
     return d_type;
 }
 
+inline int StatValue::numShards() const
+{
+    return static_cast<int>(d_shards.size());
+}
+
 inline int StatValue::numLevels() const
 {
     return static_cast<int>(d_curSnapshotIndices.size());
@@ -696,17 +903,12 @@ inline int StatValue::historySize(int aggregationlevel) const
 inline const StatValue::Snapshot&
 StatValue::snapshot(const SnapshotLocation& location) const
 {
-    BSLS_ASSERT(location.level() < numLevels());
-    BSLS_ASSERT(location.index() < historySize(location.level()));
-
-    int snapshotIndex = d_curSnapshotIndices[location.level()];
-
-    int historyIndex = snapshotIndex - location.index();
-    if (historyIndex < 0) {
-        historyIndex += historySize(location.level());
-    }
+    return d_history[historyIndex(location)];
+}
 
-    return d_history[historyIndex + d_levelStartIndices[location.level()]];
+inline const Histogram::Buckets& StatValue::histogram() const
+{
+    return d_snapshotHistogram;
 }
 
 inline bsls::Types::Int64 StatValue::min() const
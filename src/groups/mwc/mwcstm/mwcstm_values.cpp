@@ -617,6 +617,10 @@ const bdlat_EnumeratorInfo StatValueType::ENUMERATOR_INFO_ARRAY[] = {
     {StatValueType::DMCSTM_DISCRETE,
      "DMCSTM_DISCRETE",
      sizeof("DMCSTM_DISCRETE") - 1,
+     ""},
+    {StatValueType::DMCSTM_HISTOGRAM,
+     "DMCSTM_HISTOGRAM",
+     sizeof("DMCSTM_HISTOGRAM") - 1,
      ""}};
 
 // CLASS METHODS
@@ -626,6 +630,7 @@ int StatValueType::fromInt(StatValueType::Value* result, int number)
     switch (number) {
     case StatValueType::DMCSTM_CONTINUOUS:
     case StatValueType::DMCSTM_DISCRETE:
+    case StatValueType::DMCSTM_HISTOGRAM:
         *result = static_cast<StatValueType::Value>(number);
         return 0;
     default: return -1;
@@ -636,7 +641,7 @@ int StatValueType::fromString(StatValueType::Value* result,
                               const char*           string,
                               int                   stringLength)
 {
-    for (int i = 0; i < 2; ++i) {
+    for (int i = 0; i < 3; ++i) {
         const bdlat_EnumeratorInfo& enumeratorInfo =
             StatValueType::ENUMERATOR_INFO_ARRAY[i];
 
@@ -660,6 +665,9 @@ const char* StatValueType::toString(StatValueType::Value value)
     case DMCSTM_DISCRETE: {
         return "DMCSTM_DISCRETE";
     }
+    case DMCSTM_HISTOGRAM: {
+        return "DMCSTM_HISTOGRAM";
+    }
     }
 
     BSLS_ASSERT(!"invalid enumerator");
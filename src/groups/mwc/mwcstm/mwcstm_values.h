@@ -640,13 +640,17 @@ namespace mwcstm {
 // ===================
 
 /// This type enumerates the different types of stat values, specifically
-/// `CONTINUOUS` and `DISCRETE` values.
+/// `CONTINUOUS`, `DISCRETE` and `HISTOGRAM` values.
 struct StatValueType {
   public:
     // TYPES
-    enum Value { DMCSTM_CONTINUOUS = 0, DMCSTM_DISCRETE = 1 };
+    enum Value {
+        DMCSTM_CONTINUOUS = 0,
+        DMCSTM_DISCRETE   = 1,
+        DMCSTM_HISTOGRAM  = 2
+    };
 
-    enum { NUM_ENUMERATORS = 2 };
+    enum { NUM_ENUMERATORS = 3 };
 
     // CONSTANTS
     static const char CLASS_NAME[];
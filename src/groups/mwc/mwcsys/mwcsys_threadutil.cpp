@@ -33,6 +33,7 @@
 // Linux
 #if defined(BSLS_PLATFORM_OS_LINUX)
 #include <sys/prctl.h>
+#include <time.h>
 #endif
 
 namespace BloombergLP {
@@ -63,7 +64,8 @@ bslmt::ThreadAttributes ThreadUtil::defaultAttributes()
 // -----
 #if defined(BSLS_PLATFORM_OS_LINUX)
 
-const bool ThreadUtil::k_SUPPORT_THREAD_NAME = true;
+const bool ThreadUtil::k_SUPPORT_THREAD_NAME     = true;
+const bool ThreadUtil::k_SUPPORT_THREAD_CPU_TIME = true;
 
 void ThreadUtil::setCurrentThreadName(const bsl::string& value)
 {
@@ -95,11 +97,24 @@ void ThreadUtil::setCurrentThreadNameOnce(const bsl::string& value)
     }
 }
 
+bsls::Types::Int64 ThreadUtil::currentThreadCpuTime()
+{
+    timespec  time;
+    const int rc = clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    if (rc != 0) {
+        return 0;  // RETURN
+    }
+
+    return static_cast<bsls::Types::Int64>(time.tv_sec) * 1000 * 1000 * 1000 +
+           time.tv_nsec;
+}
+
 // UNSUPPORTED_PLATFORMS
 // ---------------------
 #else
 
-const bool ThreadUtil::k_SUPPORT_THREAD_NAME = false;
+const bool ThreadUtil::k_SUPPORT_THREAD_NAME     = false;
+const bool ThreadUtil::k_SUPPORT_THREAD_CPU_TIME = false;
 
 void ThreadUtil::setCurrentThreadName(
     BSLS_ANNOTATION_UNUSED const bsl::string& value)
@@ -115,6 +130,13 @@ void ThreadUtil::setCurrentThreadNameOnce(
     // NOT AVAILABLE
 }
 
+bsls::Types::Int64 ThreadUtil::currentThreadCpuTime()
+{
+    // NOT AVAILABLE
+
+    return 0;
+}
+
 #endif
 
 }  // close package namespace
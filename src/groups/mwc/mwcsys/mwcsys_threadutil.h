@@ -23,9 +23,9 @@
 //  mwcsys::ThreadUtil: utilities related to thread management.
 //
 //@DESCRIPTION: 'mwcsys::ThreadUtil' provide a utility namespace for operations
-// related to thread management, such as naming threads.  Each operation may be
-// platform specific, please refer to the associated function documentation for
-// individual support explanation.
+// related to thread management, such as naming threads or measuring their CPU
+// time.  Each operation may be platform specific, please refer to the
+// associated function documentation for individual support explanation.
 //
 /// NOTE
 ///----
@@ -39,6 +39,7 @@
 // BDE
 #include <bsl_string.h>
 #include <bslmt_threadattributes.h>
+#include <bsls_types.h>
 
 namespace BloombergLP {
 namespace mwcsys {
@@ -55,6 +56,10 @@ struct ThreadUtil {
     /// naming thread.
     static const bool k_SUPPORT_THREAD_NAME;
 
+    /// Boolean constant indicating whether the current platform supports
+    /// measuring the CPU time of a thread.
+    static const bool k_SUPPORT_THREAD_CPU_TIME;
+
     // CLASS METHODS
 
     /// Return `bslmt::ThreadAttributes` object pre-initialized with default
@@ -78,6 +83,15 @@ struct ThreadUtil {
     ///   - this functionality is only supported on LINUX, and the name can
     ///     be up to 15 characters.
     static void setCurrentThreadNameOnce(const bsl::string& value);
+
+    /// Return the CPU time, in nanoseconds, consumed so far by the current
+    /// thread, or 0 if `k_SUPPORT_THREAD_CPU_TIME` is false.  Note that
+    /// only the difference between two values returned to the same thread
+    /// is meaningful.
+    ///
+    /// PLATFORM NOTE:
+    ///   - this functionality is only supported on LINUX.
+    static bsls::Types::Int64 currentThreadCpuTime();
 };
 
 }  // close package namespace